@@ -0,0 +1,158 @@
+/**
+ * This program measures how long it takes to encode a whole LWM2M object as TLV, for objects with
+ * hundreds of instances, using a TLV writer that starts out with a small buffer and grows, and
+ * using a fixed buffer big enough for the whole object.
+ *
+ * The instances are created on the built-in /lwm2m/9 (software package) object.
+ *
+ * Usage: testAssetDataBench [numInstances ...]
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "assetData.h"
+
+
+// Default numbers of instances to measure with.
+static const int DefaultNumInstances[] = { 100, 300, 1000 };
+
+// Number of times the object is encoded for each measurement.
+#define NUM_PASSES 50
+
+// Size of the initial buffer given to the growable writer (the size used by lwm2m.c).
+#define SMALL_BUF_BYTES (256+1)
+
+// Next instance id to create.
+static int NextInstanceId = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of microseconds between two times.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add instances to the object until it has the given number of them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddInstances
+(
+    int numInstances
+)
+{
+    char str[64];
+
+    for (; NextInstanceId < numInstances; NextInstanceId++)
+    {
+        assetData_InstanceDataRef_t instRef;
+
+        LE_ASSERT(assetData_CreateInstanceById("lwm2m", 9, NextInstanceId, &instRef) == LE_OK);
+
+        snprintf(str, sizeof(str), "com.example.package%d", NextInstanceId);
+        LE_ASSERT(assetData_client_SetString(instRef, 0, str) == LE_OK);
+
+        snprintf(str, sizeof(str), "%d.%d.%d", NextInstanceId / 100, NextInstanceId % 100, 7);
+        LE_ASSERT(assetData_client_SetString(instRef, 1, str) == LE_OK);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode the object with the given number of instances, both ways, and print the results.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunBenchmark
+(
+    assetData_AssetDataRef_t assetRef,
+    int numInstances
+)
+{
+    uint8_t smallBuf[SMALL_BUF_BYTES];
+    assetData_TLVWriter_t writer;
+    size_t numBytes = 0;
+    int pass;
+
+    AddInstances(numInstances);
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    for (pass = 0; pass < NUM_PASSES; pass++)
+    {
+        assetData_InitTLVWriter(&writer, smallBuf, sizeof(smallBuf), true);
+        LE_ASSERT(assetData_WriteObjectToTLVWriter(assetRef, -1, &writer) == LE_OK);
+        numBytes = writer.numBytes;
+        assetData_CleanUpTLVWriter(&writer);
+    }
+    uint64_t growUsec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    // Give the fixed buffer some slack, as if it had been sized for the worst case.
+    size_t bigBufNumBytes = numBytes * 2;
+    uint8_t* bigBufPtr = malloc(bigBufNumBytes);
+    LE_ASSERT(bigBufPtr != NULL);
+
+    startTime = le_clk_GetRelativeTime();
+    for (pass = 0; pass < NUM_PASSES; pass++)
+    {
+        size_t bytesWritten;
+        LE_ASSERT(assetData_WriteObjectToTLV(assetRef, -1, bigBufPtr, bigBufNumBytes, &bytesWritten)
+                  == LE_OK);
+        LE_ASSERT(bytesWritten == numBytes);
+    }
+    uint64_t fixedUsec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    free(bigBufPtr);
+
+    printf("%5d instances, %7zu bytes: growable %8.1f us, fixed %8.1f us per object"
+           " (%6.1f ns per instance)\n",
+           numInstances,
+           numBytes,
+           (double)growUsec / NUM_PASSES,
+           (double)fixedUsec / NUM_PASSES,
+           fixedUsec * 1000.0 / (NUM_PASSES * numInstances));
+}
+
+
+COMPONENT_INIT
+{
+    assetData_AssetDataRef_t assetRef;
+    size_t numArgs = le_arg_NumArgs();
+    size_t i;
+
+    assetData_Init();
+
+    LE_ASSERT(assetData_GetAssetRefById("lwm2m", 9, &assetRef) == LE_OK);
+
+    // Instances are only ever added, so the sizes must be measured in increasing order.
+    if (numArgs == 0)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(DefaultNumInstances); i++)
+        {
+            RunBenchmark(assetRef, DefaultNumInstances[i]);
+        }
+    }
+    else
+    {
+        for (i = 0; i < numArgs; i++)
+        {
+            RunBenchmark(assetRef, strtol(le_arg_GetArg(i), NULL, 0));
+        }
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -380,6 +380,73 @@ void RunTest(void)
     LE_TEST( memcmp(tlvBufferOne, tlvBufferTwo, bytesWrittenOne) == 0 );
 
 
+    banner("Write Large Object to TLV Testing");
+    char longName[200];
+    assetData_TLVWriter_t writer;
+
+    memset(longName, 'x', sizeof(longName)-1);
+    longName[sizeof(longName)-1] = 0;
+    LE_TEST( assetData_client_SetString(lwm2mRefZero, 0, longName) == LE_OK );
+    LE_TEST( assetData_client_SetString(lwm2mRefOne, 0, longName) == LE_OK );
+
+    // Too big for a fixed buffer ...
+    LE_TEST( assetData_WriteObjectToTLV(lwm2mAssetRef, -1, tlvBuffer, sizeof(tlvBuffer), &bytesWritten) == LE_OVERFLOW );
+
+    // ... but not for a writer that can grow.
+    assetData_InitTLVWriter(&writer, tlvBuffer, sizeof(tlvBuffer), true);
+    LE_TEST( assetData_WriteObjectToTLVWriter(lwm2mAssetRef, -1, &writer) == LE_OK );
+    LE_TEST( writer.numBytes > sizeof(tlvBuffer) );
+    LE_TEST( writer.bufPtr != tlvBuffer );
+
+    // Each instance is an Object Instance TLV wrapping its field list.
+    size_t offset = 0;
+    int numInstances = 0;
+    while ( offset < writer.numBytes )
+    {
+        uint8_t typeByte = writer.bufPtr[offset];
+        size_t idNumBytes = ( typeByte & 0x20 ) ? 2 : 1;
+        size_t lengthNumBytes = ( typeByte >> 3 ) & 0x03;
+        size_t valueNumBytes = 0;
+        size_t i;
+
+        LE_TEST( ( typeByte >> 6 ) == 0 );
+        for ( i = 0; i < lengthNumBytes; i++ )
+        {
+            valueNumBytes = ( valueNumBytes << 8 ) | writer.bufPtr[offset + 1 + idNumBytes + i];
+        }
+
+        offset += 1 + idNumBytes + lengthNumBytes;
+
+        // Compare with the field list written on its own.
+        assetData_InstanceDataRef_t instRef = ( numInstances == 0 ) ? lwm2mRefZero : lwm2mRefOne;
+        assetData_TLVWriter_t fieldWriter;
+        assetData_InitTLVWriter(&fieldWriter, NULL, 0, true);
+        LE_TEST( assetData_WriteFieldListToTLVWriter(instRef, &fieldWriter) == LE_OK );
+        LE_TEST( fieldWriter.numBytes == valueNumBytes );
+        LE_TEST( memcmp(fieldWriter.bufPtr, writer.bufPtr + offset, valueNumBytes) == 0 );
+        assetData_CleanUpTLVWriter(&fieldWriter);
+
+        offset += valueNumBytes;
+        numInstances++;
+    }
+    LE_TEST( offset == writer.numBytes );
+    LE_TEST( numInstances == 2 );
+
+    assetData_CleanUpTLVWriter(&writer);
+
+
+    banner("Field and Instance Lookup Testing");
+    assetData_InstanceDataRef_t lookupRef;
+    int fieldId;
+
+    LE_TEST( assetData_GetInstanceRefById("lwm2m", 9, 4, &lookupRef) == LE_OK );
+    LE_TEST( lookupRef == lwm2mRefOne );
+    LE_TEST( assetData_GetInstanceRefById("lwm2m", 9, 5, &lookupRef) == LE_NOT_FOUND );
+    LE_TEST( assetData_GetFieldIdFromName(lwm2mRefZero, "Update Result", &fieldId) == LE_OK );
+    LE_TEST( fieldId == 9 );
+    LE_TEST( assetData_GetFieldIdFromName(lwm2mRefZero, "No Such Field", &fieldId) == LE_FAULT );
+
+
     banner("Test Asset list after deleting instances");
     assetData_DeleteInstance(testOneRefZero);
     char listTestThree[] = "</legato/0/0>,"
@@ -416,6 +483,12 @@ void RunTest(void)
     LE_TEST( memcmp(assetList, listTestSix, sizeof(listTestSix)) == 0 );
     LE_TEST( listSize == strlen(listTestSix) );
     LE_TEST( numAssets == 3 );
+
+    // The deleted instance can no longer be found, but the others can.
+    LE_TEST( assetData_GetInstanceRefById("lwm2m", 9, 3, &lookupRef) == LE_NOT_FOUND );
+    LE_TEST( assetData_GetInstanceRefById("lwm2m", 9, 4, &lookupRef) == LE_OK );
+    LE_TEST( assetData_GetFieldIdFromName(lookupRef, "PkgName", &fieldId) == LE_OK );
+    LE_TEST( fieldId == 0 );
 }
 
 
@@ -0,0 +1,376 @@
+/**
+ * This program measures how the time taken by the config tree to look up a node by name grows
+ * with the number of siblings the node has.  For each width, a stem with that many children is
+ * created in a write transaction, then children are read back by name, both at random and always
+ * the last one, (the worst case for a search of the sibling list.)
+ *
+ * Each read is an IPC round trip to the config tree, which costs the same whatever the width, so
+ * it's the growth of the times with the width that shows the cost of the lookup itself.
+ *
+ * It also builds a tree of 100k nodes, (1000 stems of 100 leaves, each leaf holding a short
+ * string,) to measure the memory used per node, and the time taken to read leaves by path, at
+ * random.  The memory is measured as the growth of the config tree's resident set while the tree
+ * is built, so it includes everything the config tree allocates for a node: the node, its name and
+ * its value.  This is done first, before any memory has been freed up by the other measurements,
+ * so it's best done on a freshly started config tree.
+ *
+ * Usage: configBench [maxWidth [numLookups]]
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+
+// Default widest stem to measure.
+#define DEFAULT_MAX_WIDTH 10000
+
+// Default number of lookups timed for each width.
+#define DEFAULT_NUM_LOOKUPS 2000
+
+// Tree that the measurements are made in.
+#define BENCH_TREE "configBench:"
+
+// Number of stems in the big tree.
+#define BIG_TREE_STEMS 1000
+
+// Number of leaves in each stem of the big tree.
+#define BIG_TREE_LEAVES 100
+
+// Name of the config tree's process.
+#define CONFIG_TREE_PROC_NAME "configTree"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of microseconds since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a stem with a given number of children, each holding its own index.
+ *
+ * @return How long it took to create the children, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t CreateStem
+(
+    const char* pathPtr,
+    size_t width
+)
+{
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(pathPtr);
+    char name[LE_CFG_NAME_LEN_BYTES];
+    size_t i;
+
+    for (i = 0; i < width; i++)
+    {
+        snprintf(name, sizeof(name), "child%zu", i);
+        le_cfg_SetInt(iterRef, name, i);
+    }
+
+    le_cfg_CommitTxn(iterRef);
+
+    return ElapsedUsec(startTime);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads children of a stem by name.  If random is false, the last child is read every time.
+ *
+ * @return Average time taken per read, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static double ReadChildren
+(
+    const char* pathPtr,
+    size_t width,
+    size_t numLookups,
+    bool random
+)
+{
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateReadTxn(pathPtr);
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    char name[LE_CFG_NAME_LEN_BYTES];
+    size_t i;
+
+    for (i = 0; i < numLookups; i++)
+    {
+        size_t child = random ? (rand() % width) : (width - 1);
+
+        snprintf(name, sizeof(name), "child%zu", child);
+        LE_ASSERT(le_cfg_GetInt(iterRef, name, -1) == (int32_t)child);
+    }
+
+    uint64_t usec = ElapsedUsec(startTime);
+
+    le_cfg_CancelTxn(iterRef);
+
+    return (double)usec / numLookups;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the config tree's process.
+ *
+ * @return The process's PID, or -1 if it couldn't be found.
+ */
+//--------------------------------------------------------------------------------------------------
+static pid_t FindConfigTree
+(
+    void
+)
+{
+    DIR* dirPtr = opendir("/proc");
+    struct dirent* entryPtr;
+    pid_t pid = -1;
+
+    LE_FATAL_IF(dirPtr == NULL, "Could not open /proc, reason: %m");
+
+    while ((pid == -1) && ((entryPtr = readdir(dirPtr)) != NULL))
+    {
+        char path[PATH_MAX];
+        char name[sizeof(CONFIG_TREE_PROC_NAME) + 1] = "";
+
+        if ((entryPtr->d_name[0] < '1') || (entryPtr->d_name[0] > '9'))
+        {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "/proc/%s/comm", entryPtr->d_name);
+
+        FILE* filePtr = fopen(path, "r");
+
+        if (filePtr == NULL)
+        {
+            continue;
+        }
+
+        if (   (fgets(name, sizeof(name), filePtr) != NULL)
+            && (strcmp(name, CONFIG_TREE_PROC_NAME "\n") == 0))
+        {
+            pid = atoi(entryPtr->d_name);
+        }
+
+        fclose(filePtr);
+    }
+
+    closedir(dirPtr);
+
+    return pid;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the size of a process's resident set.
+ *
+ * @return The size in kilobytes, or 0 if it couldn't be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetResidentKb
+(
+    pid_t pid
+)
+{
+    char path[PATH_MAX];
+    char line[256];
+    size_t sizeKb = 0;
+
+    snprintf(path, sizeof(path), "/proc/%d/status", (int)pid);
+
+    FILE* filePtr = fopen(path, "r");
+
+    if (filePtr == NULL)
+    {
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), filePtr) != NULL)
+    {
+        if (sscanf(line, "VmRSS: %zu kB", &sizeKb) == 1)
+        {
+            break;
+        }
+    }
+
+    fclose(filePtr);
+
+    return sizeKb;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates the big tree, one stem per transaction so that the shadow tree used for each change
+ * stays small.
+ *
+ * @return How long it took to create the tree, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t CreateBigTree
+(
+    const char* pathPtr
+)
+{
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    char name[LE_CFG_NAME_LEN_BYTES];
+    char value[LE_CFG_STR_LEN_BYTES];
+    size_t stem;
+    size_t leaf;
+
+    for (stem = 0; stem < BIG_TREE_STEMS; stem++)
+    {
+        snprintf(name, sizeof(name), "stem%zu", stem);
+
+        le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(pathPtr);
+        le_cfg_GoToNode(iterRef, name);
+
+        for (leaf = 0; leaf < BIG_TREE_LEAVES; leaf++)
+        {
+            snprintf(name, sizeof(name), "leaf%zu", leaf);
+            snprintf(value, sizeof(value), "value %zu", (stem * BIG_TREE_LEAVES) + leaf);
+            le_cfg_SetString(iterRef, name, value);
+        }
+
+        le_cfg_CommitTxn(iterRef);
+    }
+
+    return ElapsedUsec(startTime);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads leaves of the big tree by path, at random.
+ *
+ * @return Average time taken per read, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static double ReadBigTree
+(
+    const char* pathPtr,
+    size_t numLookups
+)
+{
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateReadTxn(pathPtr);
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    char path[LE_CFG_STR_LEN_BYTES];
+    char value[LE_CFG_STR_LEN_BYTES];
+    char expected[LE_CFG_STR_LEN_BYTES];
+    size_t i;
+
+    for (i = 0; i < numLookups; i++)
+    {
+        size_t stem = rand() % BIG_TREE_STEMS;
+        size_t leaf = rand() % BIG_TREE_LEAVES;
+
+        snprintf(path, sizeof(path), "stem%zu/leaf%zu", stem, leaf);
+        snprintf(expected, sizeof(expected), "value %zu", (stem * BIG_TREE_LEAVES) + leaf);
+
+        LE_ASSERT(le_cfg_GetString(iterRef, path, value, sizeof(value), "") == LE_OK);
+        LE_ASSERT(strcmp(value, expected) == 0);
+    }
+
+    uint64_t usec = ElapsedUsec(startTime);
+
+    le_cfg_CancelTxn(iterRef);
+
+    return (double)usec / numLookups;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the big tree and reports the memory used per node, and the time taken to read leaves.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MeasureBigTree
+(
+    size_t numLookups
+)
+{
+    const char* pathPtr = BENCH_TREE "/big";
+    size_t numNodes = BIG_TREE_STEMS * (BIG_TREE_LEAVES + 1);
+    pid_t pid = FindConfigTree();
+
+    le_cfg_QuickDeleteNode(pathPtr);
+
+    size_t startKb = (pid == -1) ? 0 : GetResidentKb(pid);
+    uint64_t createUsec = CreateBigTree(pathPtr);
+    size_t endKb = (pid == -1) ? 0 : GetResidentKb(pid);
+
+    double lookupUsec = ReadBigTree(pathPtr, numLookups);
+
+    printf("%zu node tree (%d stems of %d leaves):\n", numNodes, BIG_TREE_STEMS, BIG_TREE_LEAVES);
+    printf("    create:          %.1f ms\n", createUsec / 1000.0);
+
+    if ((startKb == 0) || (endKb < startKb))
+    {
+        printf("    memory per node: unknown, the config tree's memory use couldn't be read\n");
+    }
+    else
+    {
+        printf("    memory per node: %.1f bytes (config tree grew by %zu kB)\n",
+               ((double)(endKb - startKb) * 1024) / numNodes,
+               endKb - startKb);
+    }
+
+    printf("    random lookup:   %.1f us/op\n", lookupUsec);
+
+    le_cfg_QuickDeleteNode(pathPtr);
+}
+
+
+COMPONENT_INIT
+{
+    size_t maxWidth = DEFAULT_MAX_WIDTH;
+    size_t numLookups = DEFAULT_NUM_LOOKUPS;
+
+    if (le_arg_NumArgs() > 0)
+    {
+        maxWidth = strtoul(le_arg_GetArg(0), NULL, 0);
+    }
+    if (le_arg_NumArgs() > 1)
+    {
+        numLookups = strtoul(le_arg_GetArg(1), NULL, 0);
+    }
+
+    MeasureBigTree(numLookups);
+
+    printf("\n%8s %14s %16s %16s\n", "width", "create (ms)", "random (us/op)", "last (us/op)");
+
+    size_t width;
+
+    for (width = 10; width <= maxWidth; width *= 10)
+    {
+        char path[LE_CFG_STR_LEN_BYTES];
+        snprintf(path, sizeof(path), BENCH_TREE "/wide%zu", width);
+
+        uint64_t createUsec = CreateStem(path, width);
+        double randomUsec = ReadChildren(path, width, numLookups, true);
+        double lastUsec = ReadChildren(path, width, numLookups, false);
+
+        printf("%8zu %14.1f %16.1f %16.1f\n", width, createUsec / 1000.0, randomUsec, lastUsec);
+
+        le_cfg_QuickDeleteNode(path);
+    }
+
+    exit(EXIT_SUCCESS);
+}
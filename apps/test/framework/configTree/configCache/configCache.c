@@ -0,0 +1,152 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that the client-side config cache answers reads from a subtree it has loaded, without
+ * asking the config tree, and that it reads the subtree again after the subtree is changed.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+#include "cfgCache.h"
+
+
+
+
+/// Base path for the test's values.
+#define TEST_PATH "/configCache"
+
+/// Number of times the values are read through the cache.
+#define NUM_READS 100
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer used to wait for the change notification.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t WaitTimer;
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the values of the test subtree through a cached iterator.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckValues
+(
+    int expectedGeneration
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char name[LE_CFG_NAME_LEN_BYTES];
+    char value[LE_CFG_STR_LEN_BYTES];
+    cfgCache_IterRef_t iterRef = cfgCache_CreateReadIter(TEST_PATH);
+
+    LE_ASSERT(cfgCache_GetInt(iterRef, "generation", -1) == expectedGeneration);
+    LE_ASSERT(cfgCache_GetString(iterRef, "name", value, sizeof(value), "") == LE_OK);
+    LE_ASSERT(strcmp(value, "cached") == 0);
+    LE_ASSERT(cfgCache_GetBool(iterRef, "stem/flag", false) == true);
+    LE_ASSERT(cfgCache_NodeExists(iterRef, "stem/missing") == false);
+
+    cfgCache_GoToNode(iterRef, "stem");
+    LE_ASSERT(cfgCache_GoToFirstChild(iterRef) == LE_OK);
+    LE_ASSERT(cfgCache_GetNodeName(iterRef, "", name, sizeof(name)) == LE_OK);
+    LE_ASSERT(strcmp(name, "flag") == 0);
+    LE_ASSERT(cfgCache_GetPath(iterRef, "", value, sizeof(value)) == LE_OK);
+    LE_ASSERT(strcmp(value, TEST_PATH "/stem/flag") == 0);
+    LE_ASSERT(cfgCache_GoToNextSibling(iterRef) == LE_NOT_FOUND);
+
+    cfgCache_DeleteIter(iterRef);
+
+    LE_ASSERT(cfgCache_QuickGetInt(TEST_PATH "/generation", -1) == expectedGeneration);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called until the cache has seen the change to the test subtree.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WaitTimerExpired
+(
+    le_timer_Ref_t timerRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    cfgCache_Stats_t stats;
+
+    cfgCache_GetStats(&stats);
+
+    if (stats.invalidateCount == 0)
+    {
+        return;
+    }
+
+    le_timer_Stop(timerRef);
+
+    LE_INFO("----  Reading the changed subtree.  ------------------------------------------");
+
+    CheckValues(2);
+
+    cfgCache_GetStats(&stats);
+
+    LE_INFO("Cache hits %" PRIu64 ", misses %" PRIu64 ", loads %" PRIu64 ", round trips saved %"
+            PRId64 ".",
+            stats.hitCount,
+            stats.missCount,
+            stats.loadCount,
+            stats.roundTripsSaved);
+
+    LE_FATAL_IF(stats.loadCount != 2, "Subtree loaded %" PRIu64 " times.", stats.loadCount);
+
+    le_cfg_QuickDeleteNode(TEST_PATH);
+
+    LE_INFO("----  Done.  -----------------------------------------------------------------");
+
+    exit(EXIT_SUCCESS);
+}
+
+
+
+
+COMPONENT_INIT
+{
+    cfgCache_Stats_t stats;
+    int i;
+
+    LE_INFO("----  Reading a subtree through the cache.  ----------------------------------");
+
+    le_cfg_QuickDeleteNode(TEST_PATH);
+    le_cfg_QuickSetInt(TEST_PATH "/generation", 1);
+    le_cfg_QuickSetString(TEST_PATH "/name", "cached");
+    le_cfg_QuickSetBool(TEST_PATH "/stem/flag", true);
+
+    for (i = 0; i < NUM_READS; i++)
+    {
+        CheckValues(1);
+    }
+
+    cfgCache_GetStats(&stats);
+
+    LE_FATAL_IF(stats.loadCount != 1, "Subtree loaded %" PRIu64 " times.", stats.loadCount);
+    LE_FATAL_IF(stats.missCount != 1, "%" PRIu64 " cache misses.", stats.missCount);
+
+    LE_INFO("----  Changing the subtree.  -------------------------------------------------");
+
+    // The change handler is called from the event loop, so wait for it there.
+    le_cfg_QuickSetInt(TEST_PATH "/generation", 2);
+
+    WaitTimer = le_timer_Create("configCacheWait");
+    LE_ASSERT(le_timer_SetMsInterval(WaitTimer, 10) == LE_OK);
+    LE_ASSERT(le_timer_SetRepeat(WaitTimer, 0) == LE_OK);
+    LE_ASSERT(le_timer_SetHandler(WaitTimer, WaitTimerExpired) == LE_OK);
+    LE_ASSERT(le_timer_Start(WaitTimer) == LE_OK);
+}
@@ -0,0 +1,144 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that read transactions don't hold up commits, and that each read transaction keeps
+ * seeing the tree as it was when it was created.
+ *
+ * A set of read transactions is kept open, each created after a different number of commits.
+ * Between them, values are changed both with quick sets and with committed write transactions.
+ * If an open read transaction blocked a commit, this single-threaded program would never get its
+ * commit reply, and would be killed by the test script's timeout.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+
+
+
+
+/// Base path for the test's values.
+#define TEST_PATH "/configContention"
+
+/// Number of read transactions that are kept open at the same time.
+#define NUM_READERS 8
+
+/// Number of changes made between creating each read transaction.
+#define NUM_CHANGES_PER_READER 25
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Change the test values to a new generation, half of the time with quick sets and half of the
+ * time in a write transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetGeneration
+(
+    int generation
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((generation % 2) == 0)
+    {
+        le_cfg_QuickSetInt(TEST_PATH "/generation", generation);
+        le_cfg_QuickSetInt(TEST_PATH "/stem/copy", generation);
+    }
+    else
+    {
+        le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(TEST_PATH);
+
+        le_cfg_SetInt(iterRef, "generation", generation);
+        le_cfg_SetInt(iterRef, "stem/copy", generation);
+
+        le_cfg_CommitTxn(iterRef);
+    }
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a read transaction still sees the generation it was created at, in every value.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckReader
+(
+    le_cfg_IteratorRef_t iterRef,
+    int expectedGeneration
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int generation = le_cfg_GetInt(iterRef, "generation", -1);
+    int copy = le_cfg_GetInt(iterRef, "stem/copy", -1);
+
+    LE_FATAL_IF((generation != expectedGeneration) || (copy != expectedGeneration),
+                "Read transaction created at generation %d sees generation %d and copy %d.",
+                expectedGeneration,
+                generation,
+                copy);
+}
+
+
+
+
+COMPONENT_INIT
+{
+    le_cfg_IteratorRef_t readerRefs[NUM_READERS];
+    int readerGenerations[NUM_READERS];
+    int generation = 0;
+    int i;
+    int j;
+
+    LE_INFO("----  Creating read transactions between commits.  ---------------------------");
+
+    le_cfg_QuickDeleteNode(TEST_PATH);
+    SetGeneration(generation);
+
+    for (i = 0; i < NUM_READERS; i++)
+    {
+        readerRefs[i] = le_cfg_CreateReadTxn(TEST_PATH);
+        readerGenerations[i] = generation;
+
+        for (j = 0; j < NUM_CHANGES_PER_READER; j++)
+        {
+            SetGeneration(++generation);
+        }
+
+        LE_FATAL_IF(le_cfg_QuickGetInt(TEST_PATH "/generation", -1) != generation,
+                    "Quick get doesn't see generation %d.",
+                    generation);
+
+        for (j = 0; j <= i; j++)
+        {
+            CheckReader(readerRefs[j], readerGenerations[j]);
+        }
+    }
+
+    LE_INFO("----  Releasing read transactions while still committing.  ------------------");
+
+    // Release them from the middle out, so versions aren't always released oldest first.
+    for (i = 0; i < NUM_READERS; i++)
+    {
+        int index = (i % 2 == 0) ? (NUM_READERS / 2) + (i / 2) : (NUM_READERS / 2) - 1 - (i / 2);
+
+        CheckReader(readerRefs[index], readerGenerations[index]);
+        le_cfg_CancelTxn(readerRefs[index]);
+
+        SetGeneration(++generation);
+    }
+
+    LE_FATAL_IF(le_cfg_QuickGetInt(TEST_PATH "/stem/copy", -1) != generation,
+                "Quick get doesn't see generation %d.",
+                generation);
+
+    le_cfg_QuickDeleteNode(TEST_PATH);
+
+    LE_INFO("----  Done.  -----------------------------------------------------------------");
+
+    exit(EXIT_SUCCESS);
+}
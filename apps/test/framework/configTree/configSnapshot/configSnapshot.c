@@ -0,0 +1,983 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that the tree DB saves trees as binary snapshots and loads them back again, that damaged
+ * snapshots are rejected rather than loaded, and that tree files written in the old text format
+ * are still read, (and replaced by snapshots the next time the tree changes.)  It also checks that
+ * changes made on top of a snapshot are journaled and replayed, that a damaged or stale journal
+ * is thrown away rather than replayed, and that the journal is compacted into a new snapshot once
+ * it grows big enough.
+ *
+ * The tree DB is built into this test.  Each step that uses it runs in a child process of its
+ * own, so that the tree has to be loaded from the filesystem each time, just as it is when the
+ * config tree restarts.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+#include "nodeString.h"
+#include "treeDb.h"
+#include "sysPaths.h"
+#include <sys/wait.h>
+
+
+
+
+/// Name of the tree used by the test.
+#define TREE_NAME "configSnapshotTest"
+
+/// File the tree is exported to in the text format.
+#define TEXT_FILE_PATH CFG_TREE_PATH "/" TREE_NAME ".text"
+
+/// Size of the header at the start of a snapshot file, (followed by the root node's record.)
+#define SNAPSHOT_HEADER_BYTES 24
+
+/// Offset of the byte order marker within the snapshot header.
+#define SNAPSHOT_BYTE_ORDER_OFFSET 12
+
+/// Magic number found at the start of snapshot files.
+#define SNAPSHOT_MAGIC "\x7f" "CFGSNAP"
+
+/// Largest file that can be saved by SaveFile().
+#define MAX_FILE_BYTES (64 * 1024)
+
+/// Number of children given to the wide stem, enough for the stem's children to be indexed.
+#define NUM_WIDE_CHILDREN 40
+
+/// Size the journal can reach before it's compacted, while the snapshot is smaller than this.
+/// (This has to match treeDb.c.)
+#define JOURNAL_MIN_COMPACT_BYTES (64 * 1024)
+
+/// Number of values written by FillJournal(), enough to fill the journal more than once over.
+#define NUM_FILL_VALUES 200
+
+/// Length of each value written by FillJournal().
+#define FILL_VALUE_LEN 500
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A step of the test, run against the tree in a child process.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*Step_t)
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree, freshly loaded from the filesystem.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Contents of a file saved by SaveFile().
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t SavedFile[MAX_FILE_BYTES];
+static size_t SavedFileSize;
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run a step of the test in a child process, and wait for it to finish.  Any check that fails in
+ * the child makes the whole test fail.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunStep
+(
+    const char* namePtr,  ///< [IN] Name of the step, for the log.
+    Step_t stepFunc       ///< [IN] The step to run.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_INFO("----  %s  ----", namePtr);
+
+    pid_t pid = fork();
+    LE_FATAL_IF(pid == -1, "Could not fork, reason: %m");
+
+    if (pid == 0)
+    {
+        nstr_Init();
+        tdb_Init();
+        stepFunc(tdb_GetTree(TREE_NAME));
+        exit(EXIT_SUCCESS);
+    }
+
+    int status;
+
+    LE_ASSERT(waitpid(pid, &status, 0) == pid);
+    LE_FATAL_IF((WIFEXITED(status) == false) || (WEXITSTATUS(status) != EXIT_SUCCESS),
+                "Step '%s' failed, status 0x%x.",
+                namePtr,
+                status);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the path of a file belonging to the test tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetFilePath
+(
+    const char* extensionPtr,  ///< [IN]  The file's extension, (paper, journal, text, etc.)
+    char* pathPtr,             ///< [OUT] Buffer for the path.
+    size_t pathSize            ///< [IN]  Size of the buffer.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(snprintf(pathPtr, pathSize, "%s/%s.%s", CFG_TREE_PATH, TREE_NAME, extensionPtr)
+              < (int)pathSize);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the path of the test tree's current tree file.  After a tree has been written, there is only
+ * ever one of them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetTreeFilePath
+(
+    char* pathPtr,   ///< [OUT] Buffer for the path.
+    size_t pathSize  ///< [IN]  Size of the buffer.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    static const char* revNames[] = { "paper", "rock", "scissors" };
+    int found = 0;
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(revNames); i++)
+    {
+        char filePath[PATH_MAX];
+        GetFilePath(revNames[i], filePath, sizeof(filePath));
+
+        if (access(filePath, F_OK) == 0)
+        {
+            LE_ASSERT(le_utf8_Copy(pathPtr, filePath, pathSize, NULL) == LE_OK);
+            found++;
+        }
+    }
+
+    LE_FATAL_IF(found != 1, "Found %d files for tree '%s'.", found, TREE_NAME);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove all of the test tree's files.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteTreeFiles
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    static const char* extensions[] = { "paper", "rock", "scissors", "journal", "text" };
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(extensions); i++)
+    {
+        char filePath[PATH_MAX];
+        GetFilePath(extensions[i], filePath, sizeof(filePath));
+
+        LE_FATAL_IF((unlink(filePath) != 0) && (errno != ENOENT),
+                    "Could not delete '%s', reason: %m",
+                    filePath);
+    }
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the size of a file.
+ *
+ * @return The size of the file, or -1 if it doesn't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+static off_t GetFileSize
+(
+    const char* pathPtr  ///< [IN] The file.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct stat fileStat;
+
+    if (stat(pathPtr, &fileStat) != 0)
+    {
+        LE_FATAL_IF(errno != ENOENT, "Could not stat '%s', reason: %m", pathPtr);
+        return -1;
+    }
+
+    return fileStat.st_size;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Keep a copy of a file, so that it can be put back by RestoreFile() after it's been damaged.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SaveFile
+(
+    const char* pathPtr  ///< [IN] The file to save.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = open(pathPtr, O_RDONLY);
+    LE_FATAL_IF(fd == -1, "Could not open '%s', reason: %m", pathPtr);
+
+    ssize_t bytesRead = read(fd, SavedFile, sizeof(SavedFile));
+    LE_FATAL_IF((bytesRead <= 0) || (bytesRead == sizeof(SavedFile)),
+                "Could not read '%s', %zd bytes read.",
+                pathPtr,
+                bytesRead);
+
+    SavedFileSize = bytesRead;
+    close(fd);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the copy made by SaveFile() back to a file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestoreFile
+(
+    const char* pathPtr  ///< [IN] The file to write.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = open(pathPtr, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    LE_FATAL_IF(fd == -1, "Could not open '%s', reason: %m", pathPtr);
+
+    LE_ASSERT(write(fd, SavedFile, SavedFileSize) == (ssize_t)SavedFileSize);
+    close(fd);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Overwrite part of a file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PatchFile
+(
+    const char* pathPtr,  ///< [IN] The file to change.
+    off_t offset,         ///< [IN] Where to write.
+    const void* dataPtr,  ///< [IN] What to write there.
+    size_t dataSize       ///< [IN] How much to write.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = open(pathPtr, O_WRONLY);
+    LE_FATAL_IF(fd == -1, "Could not open '%s', reason: %m", pathPtr);
+
+    LE_ASSERT(pwrite(fd, dataPtr, dataSize, offset) == (ssize_t)dataSize);
+    close(fd);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check to see if a file starts with the snapshot magic number.
+ *
+ * @return True if the file is a snapshot.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsSnapshot
+(
+    const char* pathPtr  ///< [IN] The file to check.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char magic[sizeof(SNAPSHOT_MAGIC) - 1];
+
+    int fd = open(pathPtr, O_RDONLY);
+    LE_FATAL_IF(fd == -1, "Could not open '%s', reason: %m", pathPtr);
+
+    bool isSnapshot =    (read(fd, magic, sizeof(magic)) == sizeof(magic))
+                      && (memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0);
+    close(fd);
+
+    return isSnapshot;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a node in a tree, optionally creating it.
+ *
+ * @return The node, or NULL if it doesn't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t GetNode
+(
+    tdb_TreeRef_t treeRef,  ///< [IN] The tree, (or a shadow of it.)
+    const char* pathPtr,    ///< [IN] Path to the node, from the root of the tree.
+    bool create             ///< [IN] Create the node if it doesn't exist yet?
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_pathIter_Ref_t pathRef = le_pathIter_CreateForUnix(pathPtr);
+    tdb_NodeRef_t nodeRef;
+
+    if (create)
+    {
+        nodeRef = tdb_CreateNodePath(tdb_GetRootNode(treeRef), pathRef);
+    }
+    else
+    {
+        nodeRef = tdb_GetNode(tdb_GetRootNode(treeRef), pathRef);
+    }
+
+    le_pathIter_Delete(pathRef);
+
+    return nodeRef;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the string value of a node.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckString
+(
+    tdb_TreeRef_t treeRef,     ///< [IN] The tree.
+    const char* pathPtr,       ///< [IN] Path to the node.
+    const char* expectedPtr    ///< [IN] The value it should have.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char value[LE_CFG_STR_LEN_BYTES];
+    tdb_NodeRef_t nodeRef = GetNode(treeRef, pathPtr, false);
+
+    LE_FATAL_IF(tdb_GetNodeType(nodeRef) != LE_CFG_TYPE_STRING, "'%s' isn't a string.", pathPtr);
+    LE_ASSERT(tdb_GetValueAsString(nodeRef, value, sizeof(value), "") == LE_OK);
+    LE_FATAL_IF(strcmp(value, expectedPtr) != 0,
+                "'%s' is '%s', not '%s'.",
+                pathPtr,
+                value,
+                expectedPtr);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the test values into the tree, all in one change.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteValues
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    tdb_TreeRef_t shadowTreeRef = tdb_ShadowTree(treeRef);
+    int i;
+
+    tdb_SetValueAsString(GetNode(shadowTreeRef, "/name", true), "snapshot");
+    tdb_SetValueAsInt(GetNode(shadowTreeRef, "/count", true), -42);
+    tdb_SetValueAsBool(GetNode(shadowTreeRef, "/enabled", true), true);
+    tdb_SetValueAsFloat(GetNode(shadowTreeRef, "/ratio", true), 0.25);
+    tdb_SetValueAsString(GetNode(shadowTreeRef, "/stem/deep/value", true), "nested");
+
+    for (i = 0; i < NUM_WIDE_CHILDREN; i++)
+    {
+        char path[LE_CFG_STR_LEN_BYTES];
+
+        snprintf(path, sizeof(path), "/wide/child%d", i);
+        tdb_SetValueAsInt(GetNode(shadowTreeRef, path, true), i);
+    }
+
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the tree holds the values written by WriteValues().
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckValues
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int i;
+
+    CheckString(treeRef, "/name", "snapshot");
+    CheckString(treeRef, "/stem/deep/value", "nested");
+
+    LE_ASSERT(tdb_GetNodeType(GetNode(treeRef, "/count", false)) == LE_CFG_TYPE_INT);
+    LE_ASSERT(tdb_GetValueAsInt(GetNode(treeRef, "/count", false), 0) == -42);
+    LE_ASSERT(tdb_GetNodeType(GetNode(treeRef, "/enabled", false)) == LE_CFG_TYPE_BOOL);
+    LE_ASSERT(tdb_GetValueAsBool(GetNode(treeRef, "/enabled", false), false) == true);
+    LE_ASSERT(tdb_GetNodeType(GetNode(treeRef, "/ratio", false)) == LE_CFG_TYPE_FLOAT);
+    LE_ASSERT(tdb_GetValueAsFloat(GetNode(treeRef, "/ratio", false), 0.0) == 0.25);
+    LE_ASSERT(tdb_GetNodeType(GetNode(treeRef, "/stem", false)) == LE_CFG_TYPE_STEM);
+
+    for (i = 0; i < NUM_WIDE_CHILDREN; i++)
+    {
+        char path[LE_CFG_STR_LEN_BYTES];
+
+        snprintf(path, sizeof(path), "/wide/child%d", i);
+        LE_FATAL_IF(tdb_GetValueAsInt(GetNode(treeRef, path, false), -1) != i,
+                    "Wrong value for '%s'.",
+                    path);
+    }
+
+    LE_ASSERT(GetNode(treeRef, "/wide/child", false) == NULL);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the tree came up empty, because its tree file was rejected.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckEmpty
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(tdb_GetFirstChildNode(tdb_GetRootNode(treeRef)) == NULL);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the tree out in the text format, the way the tree files used to be written.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ExportText
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = open(TEXT_FILE_PATH, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    LE_FATAL_IF(fd == -1, "Could not open '%s', reason: %m", TEXT_FILE_PATH);
+
+    LE_ASSERT(tdb_WriteTreeNode(tdb_GetRootNode(treeRef), fd) == LE_OK);
+    close(fd);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Change one value in the tree, on top of the ones written by WriteValues().
+ */
+//--------------------------------------------------------------------------------------------------
+static void ChangeValue
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    tdb_TreeRef_t shadowTreeRef = tdb_ShadowTree(treeRef);
+
+    tdb_SetValueAsString(GetNode(shadowTreeRef, "/migrated", true), "yes");
+
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the tree holds the values written by WriteValues() and ChangeValue().
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckChangedValues
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CheckValues(treeRef);
+    CheckString(treeRef, "/migrated", "yes");
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set a string value in the tree, as a change of its own.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetString
+(
+    tdb_TreeRef_t treeRef,  ///< [IN] The test tree.
+    const char* pathPtr,    ///< [IN] Path to the node.
+    const char* valuePtr    ///< [IN] The value to give it.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    tdb_TreeRef_t shadowTreeRef = tdb_ShadowTree(treeRef);
+
+    tdb_SetValueAsString(GetNode(shadowTreeRef, pathPtr, true), valuePtr);
+
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make the first change to be journaled.
+ */
+//--------------------------------------------------------------------------------------------------
+static void JournalFirst
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    SetString(treeRef, "/journal/first", "1");
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make the second change to be journaled.
+ */
+//--------------------------------------------------------------------------------------------------
+static void JournalSecond
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    SetString(treeRef, "/journal/second", "2");
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that both journaled changes were replayed on top of the snapshot.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckJournaled
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CheckChangedValues(treeRef);
+    CheckString(treeRef, "/journal/first", "1");
+    CheckString(treeRef, "/journal/second", "2");
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that only the first journaled change was replayed, after the second one was torn.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckTorn
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CheckChangedValues(treeRef);
+    CheckString(treeRef, "/journal/first", "1");
+    LE_ASSERT(GetNode(treeRef, "/journal/second", false) == NULL);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rename the node set by the first journaled change.  Renames can't be journaled, so this writes
+ * a new snapshot.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RenameFirst
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    tdb_TreeRef_t shadowTreeRef = tdb_ShadowTree(treeRef);
+
+    LE_ASSERT(tdb_SetNodeName(GetNode(shadowTreeRef, "/journal/first", false), "renamed") == LE_OK);
+
+    tdb_MergeTree(shadowTreeRef);
+    tdb_ReleaseTree(shadowTreeRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the journal that was left over from before the rename wasn't replayed, (which would
+ * have brought back the node under its old name.)
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckStale
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CheckChangedValues(treeRef);
+    CheckString(treeRef, "/journal/renamed", "1");
+    LE_ASSERT(GetNode(treeRef, "/journal/first", false) == NULL);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build one of the values written by FillJournal().
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetFillValue
+(
+    int index,                              ///< [IN]  Which value.
+    char (*pathPtr)[LE_CFG_STR_LEN_BYTES],  ///< [OUT] Path to the value's node.
+    char (*valuePtr)[FILL_VALUE_LEN + 1]    ///< [OUT] The value.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    snprintf(*pathPtr, sizeof(*pathPtr), "/fill/value%d", index);
+
+    memset(*valuePtr, 'a' + (index % 26), FILL_VALUE_LEN);
+    (*valuePtr)[FILL_VALUE_LEN] = '\0';
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make changes until the journal has had to be compacted into a new snapshot, and check that this
+ * happens just as the next change would take the journal past JOURNAL_MIN_COMPACT_BYTES.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillJournal
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char journalPath[PATH_MAX];
+    char treeFilePath[PATH_MAX];
+    char newTreeFilePath[PATH_MAX];
+    off_t journalSize = 0;
+    off_t entrySize = 0;
+    int compactCount = 0;
+    int i;
+
+    GetFilePath("journal", journalPath, sizeof(journalPath));
+    GetTreeFilePath(treeFilePath, sizeof(treeFilePath));
+
+    for (i = 0; i < NUM_FILL_VALUES; i++)
+    {
+        char path[LE_CFG_STR_LEN_BYTES];
+        char value[FILL_VALUE_LEN + 1];
+
+        GetFillValue(i, &path, &value);
+        SetString(treeRef, path, value);
+
+        off_t newJournalSize = GetFileSize(journalPath);
+
+        if (newJournalSize != -1)
+        {
+            entrySize = newJournalSize - journalSize;
+            journalSize = newJournalSize;
+            continue;
+        }
+
+        // The journal was deleted, so this change went into a new snapshot instead.  It must
+        // have been the change that would have taken the journal over the limit.
+        LE_FATAL_IF(   (journalSize > JOURNAL_MIN_COMPACT_BYTES)
+                    || ((journalSize + entrySize) <= JOURNAL_MIN_COMPACT_BYTES),
+                    "Journal compacted at %lld bytes, with %lld byte entries.",
+                    (long long)journalSize,
+                    (long long)entrySize);
+
+        GetTreeFilePath(newTreeFilePath, sizeof(newTreeFilePath));
+        LE_ASSERT(strcmp(newTreeFilePath, treeFilePath) != 0);
+        LE_ASSERT(le_utf8_Copy(treeFilePath, newTreeFilePath, sizeof(treeFilePath), NULL) == LE_OK);
+
+        journalSize = 0;
+        compactCount++;
+    }
+
+    // The new snapshot is bigger than JOURNAL_MIN_COMPACT_BYTES, so the rest of the changes fit in
+    // the journal started after it.
+    LE_ASSERT(compactCount == 1);
+    LE_ASSERT(journalSize > 0);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that all the values written by FillJournal() are there, from the compacted snapshot and
+ * from the journal started after it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckFilled
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The test tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int i;
+
+    CheckStale(treeRef);
+
+    for (i = 0; i < NUM_FILL_VALUES; i++)
+    {
+        char path[LE_CFG_STR_LEN_BYTES];
+        char value[FILL_VALUE_LEN + 1];
+
+        GetFillValue(i, &path, &value);
+        CheckString(treeRef, path, value);
+    }
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Damage the tree file in various ways, and make sure that the tree is never loaded from it.  The
+ * tree file is put back the way it was afterwards.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestDamagedSnapshots
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char treeFilePath[PATH_MAX];
+    GetTreeFilePath(treeFilePath, sizeof(treeFilePath));
+
+    SaveFile(treeFilePath);
+
+    // Cut short, as if the config tree had been stopped while writing it.
+    LE_ASSERT(truncate(treeFilePath, SavedFileSize - 1) == 0);
+    RunStep("Loading a truncated snapshot", CheckEmpty);
+
+    // The root record claims to be a type of node that doesn't exist.
+    uint8_t badType = 0xff;
+    RestoreFile(treeFilePath);
+    PatchFile(treeFilePath, SNAPSHOT_HEADER_BYTES, &badType, sizeof(badType));
+    RunStep("Loading a corrupt snapshot", CheckEmpty);
+
+    // The last node's value has lost its terminator.
+    uint8_t notNull = 'x';
+    LE_ASSERT(SavedFile[SavedFileSize - 1] == '\0');
+    RestoreFile(treeFilePath);
+    PatchFile(treeFilePath, SavedFileSize - 1, &notNull, sizeof(notNull));
+    RunStep("Loading a snapshot with an unterminated value", CheckEmpty);
+
+    // Written by a device with the opposite byte order.
+    uint32_t byteOrder = 0x04030201;
+    RestoreFile(treeFilePath);
+    PatchFile(treeFilePath, SNAPSHOT_BYTE_ORDER_OFFSET, &byteOrder, sizeof(byteOrder));
+    RunStep("Loading a snapshot with the wrong byte order", CheckEmpty);
+
+    RestoreFile(treeFilePath);
+    RunStep("Loading the restored snapshot", CheckValues);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replace the tree file with a text tree file, like the ones written by older versions of the
+ * config tree, and make sure it's loaded and then replaced by a snapshot.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestTextMigration
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char treeFilePath[PATH_MAX];
+    GetTreeFilePath(treeFilePath, sizeof(treeFilePath));
+
+    RunStep("Exporting the tree as text", ExportText);
+    LE_ASSERT(rename(TEXT_FILE_PATH, treeFilePath) == 0);
+    LE_ASSERT(IsSnapshot(treeFilePath) == false);
+
+    RunStep("Loading a text tree file", CheckValues);
+
+    RunStep("Changing the text tree", ChangeValue);
+
+    char newTreeFilePath[PATH_MAX];
+    GetTreeFilePath(newTreeFilePath, sizeof(newTreeFilePath));
+
+    LE_ASSERT(strcmp(newTreeFilePath, treeFilePath) != 0);
+    LE_ASSERT(IsSnapshot(newTreeFilePath) == true);
+
+    RunStep("Loading the migrated tree", CheckChangedValues);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make changes on top of the snapshot, and make sure they're journaled and replayed.  Then damage
+ * the journal, and leave an old journal next to a newer snapshot, and make sure that neither is
+ * replayed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestJournal
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char journalPath[PATH_MAX];
+    char treeFilePath[PATH_MAX];
+    char newTreeFilePath[PATH_MAX];
+
+    GetFilePath("journal", journalPath, sizeof(journalPath));
+    GetTreeFilePath(treeFilePath, sizeof(treeFilePath));
+
+    off_t treeFileSize = GetFileSize(treeFilePath);
+
+    LE_ASSERT(GetFileSize(journalPath) == -1);
+
+    RunStep("Journaling a change", JournalFirst);
+    off_t firstSize = GetFileSize(journalPath);
+
+    RunStep("Journaling another change", JournalSecond);
+    off_t secondSize = GetFileSize(journalPath);
+
+    LE_ASSERT(firstSize > 0);
+    LE_ASSERT(secondSize > firstSize);
+
+    // The snapshot itself is left alone.
+    GetTreeFilePath(newTreeFilePath, sizeof(newTreeFilePath));
+    LE_ASSERT(strcmp(newTreeFilePath, treeFilePath) == 0);
+    LE_ASSERT(GetFileSize(treeFilePath) == treeFileSize);
+
+    RunStep("Replaying the journal", CheckJournaled);
+    LE_ASSERT(GetFileSize(journalPath) == secondSize);
+
+    // Cut the last entry short, as if the config tree had been stopped while appending it.  It's
+    // dropped from the journal when the tree is loaded.
+    LE_ASSERT(truncate(journalPath, secondSize - 1) == 0);
+    RunStep("Replaying a journal with a torn entry", CheckTorn);
+    LE_ASSERT(GetFileSize(journalPath) == firstSize);
+
+    // Put the journal back after a new snapshot has been written.  It no longer applies, and is
+    // thrown away when the tree is loaded.
+    SaveFile(journalPath);
+
+    RunStep("Renaming a journaled node", RenameFirst);
+    LE_ASSERT(GetFileSize(journalPath) == -1);
+
+    GetTreeFilePath(newTreeFilePath, sizeof(newTreeFilePath));
+    LE_ASSERT(strcmp(newTreeFilePath, treeFilePath) != 0);
+
+    RestoreFile(journalPath);
+    RunStep("Loading a tree with a stale journal", CheckStale);
+    LE_ASSERT(GetFileSize(journalPath) == -1);
+
+    RunStep("Filling the journal", FillJournal);
+    RunStep("Loading the compacted tree", CheckFilled);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the tests.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    char treeFilePath[PATH_MAX];
+
+    DeleteTreeFiles();
+
+    RunStep("Loading a tree that doesn't exist", CheckEmpty);
+
+    RunStep("Writing the tree", WriteValues);
+
+    GetTreeFilePath(treeFilePath, sizeof(treeFilePath));
+    LE_ASSERT(IsSnapshot(treeFilePath) == true);
+
+    RunStep("Loading the tree", CheckValues);
+
+    TestDamagedSnapshots();
+    TestTextMigration();
+    TestJournal();
+
+    DeleteTreeFiles();
+
+    LE_INFO("----  All tree snapshot and journal tests passed.  ----");
+    exit(EXIT_SUCCESS);
+}
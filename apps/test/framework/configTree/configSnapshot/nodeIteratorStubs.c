@@ -0,0 +1,100 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stand-ins for the node iterator functions that the tree DB calls.  The snapshot tests work on the
+ * tree DB directly and never create any iterators, so none of these should ever be called.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+#include "treeDb.h"
+#include "treeUser.h"
+#include "nodeIterator.h"
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check to see if the iterator is meant to allow writes.
+ */
+//--------------------------------------------------------------------------------------------------
+bool ni_IsWriteable
+(
+    ni_ConstIteratorRef_t iteratorRef  ///< [IN] Does this iterator represent a write transaction?
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_FATAL("Unexpected iterator %p.", iteratorRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the tree object that this iterator was created on.
+ */
+//--------------------------------------------------------------------------------------------------
+tdb_TreeRef_t ni_GetTree
+(
+    ni_ConstIteratorRef_t iteratorRef  ///< [IN] The iterator object to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_FATAL("Unexpected iterator %p.", iteratorRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the root node of the version of the tree that this iterator sees.
+ */
+//--------------------------------------------------------------------------------------------------
+tdb_NodeRef_t ni_GetRootNode
+(
+    ni_ConstIteratorRef_t iteratorRef  ///< [IN] The iterator object to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_FATAL("Unexpected iterator %p.", iteratorRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move a read iterator onto another version of its tree.
+ */
+//--------------------------------------------------------------------------------------------------
+void ni_MoveToVersion
+(
+    ni_IteratorRef_t iteratorRef,  ///< [IN] The iterator object to update.
+    tdb_NodeRef_t rootNodeRef      ///< [IN] Root node of the version to move to.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_FATAL("Unexpected iterator %p.", iteratorRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call a function for each of the active iterators.  There never are any.
+ */
+//--------------------------------------------------------------------------------------------------
+void ni_ForEachIter
+(
+    itr_ForEachHandler functionPtr,  ///< [IN] The function to call with our matches.
+    void* contextPtr                 ///< [IN] Passed along to the function.
+)
+//--------------------------------------------------------------------------------------------------
+{
+}
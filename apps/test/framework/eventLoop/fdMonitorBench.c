@@ -0,0 +1,197 @@
+/**
+ * This program measures how many fd events per second a thread's event loop can deliver to
+ * FD Monitor handlers, with the thread watching a large number of fds (eventfds).
+ *
+ *  - "all ready": every fd stays readable, so each epoll_wait() returns a full batch of events.
+ *    The handlers do nothing, so this measures the cost of getting events to the handlers.
+ *  - "one ready": the fds pass a token around a ring; each handler reads its own fd and writes
+ *    to the next one, so there is one event per epoll_wait().
+ *
+ * Usage: fdMonitorBench [numFds [numEvents]]
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+
+
+// Default number of fds watched.
+#define DEFAULT_NUM_FDS 1000
+
+// Default number of events delivered in each part of the benchmark.
+#define DEFAULT_NUM_EVENTS 2000000
+
+
+static size_t NumFds = DEFAULT_NUM_FDS;
+static size_t NumEvents = DEFAULT_NUM_EVENTS;
+
+static int* FdsPtr;
+static le_fdMonitor_Ref_t* MonitorsPtr;
+
+static size_t EventCount;
+static le_clk_Time_t StartTime;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of microseconds between two times.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the results for one part of the benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintResults
+(
+    const char* nameStr
+)
+{
+    uint64_t usec = ElapsedUsec(StartTime, le_clk_GetRelativeTime());
+
+    printf("%zu fds, %-9s: %8.1f ns per event, %6.3f M events per second\n",
+           NumFds,
+           nameStr,
+           usec * 1000.0 / EventCount,
+           (double)EventCount / usec);
+    fflush(stdout);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write to an eventfd, making it readable.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Signal
+(
+    int fd
+)
+{
+    uint64_t value = 1;
+
+    LE_ASSERT(write(fd, &value, sizeof(value)) == sizeof(value));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the "one ready" part: pass the token on to the next fd, until enough events have
+ * been delivered.
+ */
+//--------------------------------------------------------------------------------------------------
+static void OneReadyHandler
+(
+    int fd,
+    short events
+)
+{
+    size_t index = (size_t)le_fdMonitor_GetContextPtr();
+    uint64_t value;
+
+    LE_ASSERT(events == POLLIN);
+    LE_ASSERT(read(fd, &value, sizeof(value)) == sizeof(value));
+
+    if (++EventCount == NumEvents)
+    {
+        PrintResults("one ready");
+        exit(EXIT_SUCCESS);
+    }
+
+    Signal(FdsPtr[(index + 1) % NumFds]);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the "all ready" part: leave the fd readable, until enough events have been
+ * delivered.  Then clear all the fds and start the "one ready" part.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AllReadyHandler
+(
+    int fd,
+    short events
+)
+{
+    size_t i;
+    uint64_t value;
+
+    LE_ASSERT(events == POLLIN);
+
+    if (++EventCount < NumEvents)
+    {
+        return;
+    }
+
+    PrintResults("all ready");
+
+    for (i = 0; i < NumFds; i++)
+    {
+        le_fdMonitor_Delete(MonitorsPtr[i]);
+        LE_ASSERT(read(FdsPtr[i], &value, sizeof(value)) == sizeof(value));
+
+        MonitorsPtr[i] = le_fdMonitor_Create("oneReady", FdsPtr[i], OneReadyHandler, POLLIN);
+        le_fdMonitor_SetContextPtr(MonitorsPtr[i], (void*)i);
+    }
+
+    EventCount = 0;
+    StartTime = le_clk_GetRelativeTime();
+    Signal(FdsPtr[0]);
+}
+
+
+COMPONENT_INIT
+{
+    struct rlimit limit;
+    size_t i;
+
+    if (le_arg_NumArgs() > 0)
+    {
+        NumFds = strtoul(le_arg_GetArg(0), NULL, 0);
+    }
+    if (le_arg_NumArgs() > 1)
+    {
+        NumEvents = strtoul(le_arg_GetArg(1), NULL, 0);
+    }
+    LE_ASSERT((NumFds > 0) && (NumEvents > 0));
+
+    // Make sure there are enough fds to go round.
+    LE_ASSERT(getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    if (limit.rlim_cur < NumFds + 64)
+    {
+        limit.rlim_cur = NumFds + 64;
+        LE_FATAL_IF(setrlimit(RLIMIT_NOFILE, &limit) != 0,
+                    "Can't raise the open file limit to %zu (%m).", NumFds + 64);
+    }
+
+    FdsPtr = malloc(NumFds * sizeof(int));
+    MonitorsPtr = malloc(NumFds * sizeof(le_fdMonitor_Ref_t));
+    LE_ASSERT((FdsPtr != NULL) && (MonitorsPtr != NULL));
+
+    for (i = 0; i < NumFds; i++)
+    {
+        FdsPtr[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        LE_ASSERT(FdsPtr[i] >= 0);
+
+        MonitorsPtr[i] = le_fdMonitor_Create("allReady", FdsPtr[i], AllReadyHandler, POLLIN);
+        Signal(FdsPtr[i]);
+    }
+
+    StartTime = le_clk_GetRelativeTime();
+}
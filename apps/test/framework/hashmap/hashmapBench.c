@@ -0,0 +1,198 @@
+/**
+ * This program compares the cost of hashmap operations for a chained map sized for its contents,
+ * a chained map that is far too small, and a dynamic (growable, open-addressing) map that starts
+ * out just as small.
+ *
+ * Usage: hashmapBench [numKeys ...]
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+
+
+// Default numbers of keys to measure with.
+static const size_t DefaultNumKeys[] = { 1000, 10000, 100000 };
+
+// Capacity given for the undersized maps (the watchdog map's size).
+#define SMALL_CAPACITY 31
+
+// Number of lookup passes over all of the keys.
+#define NUM_GET_PASSES 4
+
+// Size of the buffer holding a map's name.
+#define MAX_NAME_BYTES 16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of microseconds between two times.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a map of the given kind.  Maps can't be deleted, so each one gets a name of its own.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t CreateMap
+(
+    const char* kindStr,
+    size_t numKeys
+)
+{
+    static int mapCount = 0;
+    char* nameStr = malloc(MAX_NAME_BYTES);
+    LE_ASSERT(nameStr != NULL);
+    snprintf(nameStr, MAX_NAME_BYTES, "bench%d", mapCount++);
+
+    if (strcmp(kindStr, "sized") == 0)
+    {
+        return le_hashmap_Create(nameStr, numKeys, le_hashmap_HashUInt32, le_hashmap_EqualsUInt32);
+    }
+    else if (strcmp(kindStr, "small") == 0)
+    {
+        return le_hashmap_Create(nameStr,
+                                 SMALL_CAPACITY,
+                                 le_hashmap_HashUInt32,
+                                 le_hashmap_EqualsUInt32);
+    }
+
+    return le_hashmap_CreateDynamic(nameStr,
+                                    SMALL_CAPACITY,
+                                    le_hashmap_HashUInt32,
+                                    le_hashmap_EqualsUInt32);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put, look up, replace and remove the given number of keys in one kind of map, printing how
+ * long each phase took.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunBenchmark
+(
+    const char* kindStr,
+    uint32_t* keysPtr,
+    size_t numKeys
+)
+{
+    le_hashmap_Ref_t map = CreateMap(kindStr, numKeys);
+    size_t i;
+    int pass;
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < numKeys; i++)
+    {
+        LE_ASSERT(le_hashmap_Put(map, &keysPtr[i], &keysPtr[i]) == NULL);
+    }
+    uint64_t putUsec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    // Look the keys up in a different order from the one they were added in.
+    startTime = le_clk_GetRelativeTime();
+    for (pass = 0; pass < NUM_GET_PASSES; pass++)
+    {
+        for (i = 0; i < numKeys; i++)
+        {
+            uint32_t* keyPtr = &keysPtr[(i * 7919) % numKeys];
+            LE_ASSERT(le_hashmap_Get(map, keyPtr) == keyPtr);
+        }
+    }
+    uint64_t getUsec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    // Churn: remove each key and put it straight back, like short-lived safe references.
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < numKeys; i++)
+    {
+        uint32_t* keyPtr = &keysPtr[(i * 7919) % numKeys];
+        LE_ASSERT(le_hashmap_Remove(map, keyPtr) == keyPtr);
+        LE_ASSERT(le_hashmap_Put(map, keyPtr, keyPtr) == NULL);
+    }
+    uint64_t churnUsec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < numKeys; i++)
+    {
+        LE_ASSERT(le_hashmap_Remove(map, &keysPtr[i]) == &keysPtr[i]);
+    }
+    uint64_t removeUsec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    LE_ASSERT(le_hashmap_isEmpty(map));
+
+    printf("%8zu keys, %-7s map: put %9.1f ns, get %9.1f ns, remove+put %9.1f ns,"
+           " remove %9.1f ns\n",
+           numKeys,
+           kindStr,
+           putUsec * 1000.0 / numKeys,
+           getUsec * 1000.0 / (numKeys * NUM_GET_PASSES),
+           churnUsec * 1000.0 / numKeys,
+           removeUsec * 1000.0 / numKeys);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the benchmark for all kinds of map with the given number of keys.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunAll
+(
+    size_t numKeys
+)
+{
+    static const char* const Kinds[] = { "sized", "small", "dynamic" };
+    size_t i;
+
+    uint32_t* keysPtr = malloc(numKeys * sizeof(uint32_t));
+    LE_ASSERT(keysPtr != NULL);
+
+    // Scatter the keys over the whole range, without duplicates.
+    for (i = 0; i < numKeys; i++)
+    {
+        keysPtr[i] = (uint32_t)i * 2654435761u;
+    }
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Kinds); i++)
+    {
+        RunBenchmark(Kinds[i], keysPtr, numKeys);
+    }
+
+    free(keysPtr);
+}
+
+
+COMPONENT_INIT
+{
+    size_t numArgs = le_arg_NumArgs();
+    size_t i;
+
+    if (numArgs == 0)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(DefaultNumKeys); i++)
+        {
+            RunAll(DefaultNumKeys[i]);
+        }
+    }
+    else
+    {
+        for (i = 0; i < numArgs; i++)
+        {
+            RunAll(strtoul(le_arg_GetArg(i), NULL, 0));
+        }
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -20,6 +20,8 @@ size_t le_hashmap_HashCustom(const void* keyPtr);
 bool le_hashmap_EqualsCustom(const void* firstPtr, const void* secondPtr);
 bool itHandler(const void* keyPtr, const void* valuePtr, void* contextPtr);
 void TestIterRemove(le_hashmap_Ref_t map);
+void TestDynamicMap(le_hashmap_Ref_t map);
+void TestDynamicIter(le_hashmap_Ref_t map);
 
 typedef struct Key Key_t;
 struct Key {
@@ -51,7 +53,12 @@ COMPONENT_INIT
     LE_INFO("Creating pointer map");
     le_hashmap_Ref_t map5 = le_hashmap_Create("Map5", 100, &le_hashmap_HashVoidPointer, &le_hashmap_EqualsVoidPointer);
 
-    LE_TEST(map1 && map2 && map3 && map4 && map5);
+    LE_INFO("Creating dynamic maps");
+    le_hashmap_Ref_t map6 = le_hashmap_CreateDynamic("Map6", 1, &le_hashmap_HashUInt32, &le_hashmap_EqualsUInt32);
+    le_hashmap_Ref_t map7 = le_hashmap_CreateDynamic("Map7", 10, &le_hashmap_HashString, &le_hashmap_EqualsString);
+    le_hashmap_Ref_t map8 = le_hashmap_CreateDynamic("Map8", 0, &le_hashmap_HashCustom, &le_hashmap_EqualsCustom);
+
+    LE_TEST(map1 && map2 && map3 && map4 && map5 && map6 && map7 && map8);
 
     TestHashFns();
     TestIntHashMap(map1);
@@ -61,6 +68,11 @@ COMPONENT_INIT
     TestPointerMap(map5);
     TestNewIter();
     TestIterRemove(map1);
+    TestStringHashMap(map7);
+    TestCustomHashMap(map8);
+    TestDynamicMap(map6);
+    TestDynamicIter(map6);
+    TestIterRemove(map6);
 
     LE_INFO("==== Hashmap Tests PASSED ====\n");
 
@@ -428,3 +440,155 @@ void TestIterRemove(le_hashmap_Ref_t map)
     LE_TEST(itercnt == 1000);
     LE_TEST(le_hashmap_Size(map) == 500);
 }
+
+void TestDynamicMap(le_hashmap_Ref_t map)
+{
+    uint32_t iKeys[1000];
+    uint32_t iVals[1000];
+    uint32_t ikey1 = 100;
+    uint32_t ival1 = 100;
+    uint32_t ival2 = 350;
+    int j;
+
+    LE_INFO("*** Running dynamic hashmap tests ***");
+
+    void* rval = insertRetrieve(map, &ikey1, &ival1);
+    LE_TEST(*((uint32_t*) rval) == ival1);
+
+    // Replacing keeps the stored key and returns the old value.
+    LE_TEST(le_hashmap_Put(map, &ikey1, &ival2) == &ival1);
+    LE_TEST((le_hashmap_Get(map, &ikey1) == &ival2) && (le_hashmap_Size(map) == 1));
+    LE_TEST(le_hashmap_GetStoredKey(map, &ikey1) == &ikey1);
+
+    le_hashmap_RemoveAll(map);
+    LE_TEST(le_hashmap_isEmpty(map));
+    LE_TEST(le_hashmap_Get(map, &ikey1) == NULL);
+
+    // The map was created for a single entry, so this has to grow it several times.
+    for (j = 0; j < 1000; j++)
+    {
+        iKeys[j] = j * 2;
+        iVals[j] = j * 4;
+        LE_ASSERT(le_hashmap_Put(map, &iKeys[j], &iVals[j]) == NULL);
+    }
+    LE_TEST(le_hashmap_Size(map) == 1000);
+
+    bool allFound = true;
+    for (j = 0; j < 1000; j++)
+    {
+        uint32_t key = j * 2;
+        uint32_t* valuePtr = le_hashmap_Get(map, &key);
+        allFound = allFound && (valuePtr == &iVals[j]) && le_hashmap_ContainsKey(map, &key);
+    }
+    LE_TEST(allFound);
+    LE_INFO("Collision count = %zu", le_hashmap_CountCollisions(map));
+    LE_TEST(le_hashmap_CountCollisions(map) < 1000);
+
+    // Remove every other key, then check that the rest are still found through the repaired
+    // probe sequences.
+    for (j = 0; j < 1000; j += 2)
+    {
+        LE_ASSERT(le_hashmap_Remove(map, &iKeys[j]) == &iVals[j]);
+    }
+    LE_TEST(le_hashmap_Size(map) == 500);
+
+    allFound = true;
+    for (j = 0; j < 1000; j++)
+    {
+        bool isFound = le_hashmap_ContainsKey(map, &iKeys[j]);
+        allFound = allFound && (isFound == (j % 2 != 0));
+    }
+    LE_TEST(allFound);
+    LE_TEST(le_hashmap_Remove(map, &iKeys[0]) == NULL);
+
+    // Iteration goes in insertion order, forwards and backwards.
+    le_hashmap_It_Ref_t mapIt = le_hashmap_GetIterator(map);
+    LE_TEST(le_hashmap_GetKey(mapIt) == NULL);
+    int itercnt = 0;
+    bool inOrder = true;
+    while (le_hashmap_NextNode(mapIt) == LE_OK)
+    {
+        inOrder = inOrder && (le_hashmap_GetKey(mapIt) == &iKeys[(itercnt * 2) + 1]);
+        itercnt++;
+    }
+    LE_TEST(inOrder && (itercnt == 500));
+    LE_TEST(le_hashmap_GetKey(mapIt) == NULL);
+    while (le_hashmap_PrevNode(mapIt) == LE_OK)
+    {
+        itercnt--;
+        inOrder = inOrder && (le_hashmap_GetValue(mapIt) == &iVals[(itercnt * 2) + 1]);
+    }
+    LE_TEST(inOrder && (itercnt == 0));
+
+    // Node-after iteration follows the same order.
+    uint32_t* keyPtr = NULL;
+    uint32_t* valuePtr = NULL;
+    LE_TEST(le_hashmap_GetFirstNode(map, (void**)&keyPtr, (void**)&valuePtr) == LE_OK);
+    LE_TEST((keyPtr == &iKeys[1]) && (valuePtr == &iVals[1]));
+    LE_TEST(le_hashmap_GetNodeAfter(map, &iKeys[1], (void**)&keyPtr, (void**)&valuePtr) == LE_OK);
+    LE_TEST((keyPtr == &iKeys[3]) && (valuePtr == &iVals[3]));
+    LE_TEST(le_hashmap_GetNodeAfter(map, &iKeys[999], (void**)&keyPtr, NULL) == LE_NOT_FOUND);
+    LE_TEST(le_hashmap_GetNodeAfter(map, &iKeys[0], (void**)&keyPtr, NULL) == LE_BAD_PARAMETER);
+
+    // Removed keys can be put back, into the space left by the removed entries.
+    for (j = 0; j < 1000; j += 2)
+    {
+        LE_ASSERT(le_hashmap_Put(map, &iKeys[j], &iVals[j]) == NULL);
+    }
+    LE_TEST(le_hashmap_Size(map) == 1000);
+
+    le_hashmap_RemoveAll(map);
+    LE_TEST(le_hashmap_Size(map) == 0);
+    mapIt = le_hashmap_GetIterator(map);
+    LE_TEST(le_hashmap_NextNode(mapIt) == LE_NOT_FOUND);
+}
+
+void TestDynamicIter(le_hashmap_Ref_t map)
+{
+    uint32_t iKeys[2000];
+    int visits[2000] = { 0 };
+    int j;
+
+    LE_INFO("*** Running dynamic hashmap iterator tests ***");
+
+    for (j = 0; j < 2000; j++)
+    {
+        iKeys[j] = j;
+    }
+    for (j = 0; j < 100; j++)
+    {
+        le_hashmap_Put(map, &iKeys[j], &iKeys[j]);
+    }
+
+    // Remove the current entry and add new ones while iterating, enough to make the map grow
+    // several times.  Every entry should be visited exactly once, including the added ones.
+    int nextNew = 100;
+    le_hashmap_It_Ref_t mapIt = le_hashmap_GetIterator(map);
+    while (le_hashmap_NextNode(mapIt) == LE_OK)
+    {
+        const uint32_t* keyPtr = le_hashmap_GetKey(mapIt);
+        visits[*keyPtr]++;
+
+        if (*keyPtr % 3 == 0)
+        {
+            le_hashmap_Remove(map, keyPtr);
+            LE_ASSERT(le_hashmap_GetKey(mapIt) == NULL);
+        }
+        if (nextNew < 2000)
+        {
+            le_hashmap_Put(map, &iKeys[nextNew], &iKeys[nextNew]);
+            nextNew++;
+        }
+    }
+
+    bool allVisitedOnce = true;
+    for (j = 0; j < 2000; j++)
+    {
+        allVisitedOnce = allVisitedOnce && (visits[j] == 1);
+    }
+    LE_TEST(allVisitedOnce);
+    LE_TEST(le_hashmap_Size(map) == 2000 - 667);
+
+    le_hashmap_RemoveAll(map);
+    LE_TEST(le_hashmap_isEmpty(map));
+}
@@ -0,0 +1,333 @@
+/**
+ * This program measures how fast the JSON parser gets through a multi-megabyte document, and how
+ * many read system calls it makes doing so, when reading it from a pipe (one byte at a time), from
+ * a regular file (in blocks) and from memory (le_json_ParseBuffer()).
+ *
+ * Usage: jsonBench [docSizeInMegabytes]
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+#include <sys/mman.h>
+
+
+// Default size of the document, in megabytes.
+#define DEFAULT_DOC_MB 4
+
+
+// Ways the document is fed to the parser, in the order they are measured.
+typedef enum
+{
+    MODE_PIPE,
+    MODE_FILE,
+    MODE_BUFFER,
+    NUM_MODES
+}
+Mode_t;
+
+static const char* ModeNames[NUM_MODES] = { "pipe", "file", "buffer" };
+
+static Mode_t Mode;
+
+static char DocPath[] = "/tmp/jsonBenchXXXXXX";
+static size_t DocSize;
+static void* DocPtr;
+
+static int InputFd = -1;
+static pid_t WriterPid = -1;
+
+static le_clk_Time_t StartTime;
+static uint64_t StartReadCalls;
+
+static size_t NumEvents;
+
+static void StartMode(Mode_t mode);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of microseconds between two times.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of read system calls this process has made so far.
+ *
+ * @return The count, or 0 if the kernel doesn't provide it.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetReadCalls
+(
+    void
+)
+{
+    FILE* filePtr = fopen("/proc/self/io", "r");
+    char line[128];
+    uint64_t count = 0;
+
+    if (filePtr == NULL)
+    {
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), filePtr) != NULL)
+    {
+        if (sscanf(line, "syscr: %" SCNu64, &count) == 1)
+        {
+            break;
+        }
+    }
+
+    fclose(filePtr);
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a document made up of an array of records to a temporary file and maps it into memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CreateDoc
+(
+    size_t targetSize
+)
+{
+    int fd = mkstemp(DocPath);
+    LE_ASSERT(fd != -1);
+
+    FILE* filePtr = fdopen(fd, "w");
+    LE_ASSERT(filePtr != NULL);
+
+    size_t size = fprintf(filePtr, "[\n");
+    unsigned int i = 0;
+
+    while (size < targetSize)
+    {
+        size += fprintf(filePtr,
+                        "%s  { \"id\": %u, \"name\": \"item-%u\", \"value\": %u.5,"
+                        " \"tags\": [ \"alpha\", \"beta\" ], \"enabled\": %s, \"owner\": null }",
+                        (i == 0) ? "" : ",\n",
+                        i,
+                        i,
+                        i * 3,
+                        (i % 2) ? "true" : "false");
+        i++;
+    }
+
+    size += fprintf(filePtr, "\n]\n");
+    LE_ASSERT(fclose(filePtr) == 0);
+
+    DocSize = size;
+
+    fd = open(DocPath, O_RDONLY);
+    LE_ASSERT(fd != -1);
+    DocPtr = mmap(NULL, DocSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    LE_ASSERT(DocPtr != MAP_FAILED);
+    close(fd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Forks a process that writes the document into a pipe.
+ *
+ * @return The read end of the pipe.
+ */
+//--------------------------------------------------------------------------------------------------
+static int StartPipeWriter
+(
+    void
+)
+{
+    int fds[2];
+    LE_ASSERT(pipe(fds) == 0);
+
+    WriterPid = fork();
+    LE_ASSERT(WriterPid != -1);
+
+    if (WriterPid == 0)
+    {
+        const char* bytePtr = DocPtr;
+        size_t remaining = DocSize;
+
+        close(fds[0]);
+
+        while (remaining > 0)
+        {
+            ssize_t written = write(fds[1], bytePtr, remaining);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                _exit(EXIT_FAILURE);
+            }
+            bytePtr += written;
+            remaining -= written;
+        }
+
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(fds[1]);
+
+    return fds[0];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints the results for the current mode, then moves on to the next one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FinishMode
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    uint64_t usec = ElapsedUsec(StartTime, le_clk_GetRelativeTime());
+    uint64_t readCalls = GetReadCalls() - StartReadCalls;
+
+    printf("%-8s %9zu bytes %8zu events %9.1f ms %8.2f MB/s %10" PRIu64 " read calls\n",
+           ModeNames[Mode],
+           DocSize,
+           NumEvents,
+           usec / 1000.0,
+           (usec == 0) ? 0.0 : (double)DocSize / usec,
+           readCalls);
+
+    if (InputFd != -1)
+    {
+        close(InputFd);
+        InputFd = -1;
+    }
+    if (WriterPid != -1)
+    {
+        LE_ASSERT(waitpid(WriterPid, NULL, 0) == WriterPid);
+        WriterPid = -1;
+    }
+
+    if (Mode + 1 < NUM_MODES)
+    {
+        StartMode(Mode + 1);
+    }
+    else
+    {
+        munmap(DocPtr, DocSize);
+        unlink(DocPath);
+        exit(EXIT_SUCCESS);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counts parsing events, and finishes the current mode at the end of the document.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EventHandler
+(
+    le_json_Event_t event
+)
+{
+    NumEvents++;
+
+    if (event == LE_JSON_DOC_END)
+    {
+        LE_ASSERT(le_json_GetBytesRead(le_json_GetSession()) == DocSize - 1);
+
+        le_json_Cleanup(le_json_GetSession());
+        le_event_QueueFunction(FinishMode, NULL, NULL);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parsing errors are fatal.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ErrorHandler
+(
+    le_json_Error_t error,
+    const char* msg
+)
+{
+    LE_FATAL("Failed to parse document in %s mode: %s", ModeNames[Mode], msg);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts parsing the document in a given mode.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartMode
+(
+    Mode_t mode
+)
+{
+    Mode = mode;
+    NumEvents = 0;
+
+    StartReadCalls = GetReadCalls();
+    StartTime = le_clk_GetRelativeTime();
+
+    switch (mode)
+    {
+        case MODE_PIPE:
+
+            InputFd = StartPipeWriter();
+            le_json_Parse(InputFd, EventHandler, ErrorHandler, NULL);
+            break;
+
+        case MODE_FILE:
+
+            InputFd = open(DocPath, O_RDONLY);
+            LE_ASSERT(InputFd != -1);
+            le_json_Parse(InputFd, EventHandler, ErrorHandler, NULL);
+            break;
+
+        case MODE_BUFFER:
+
+            le_json_ParseBuffer(DocPtr, DocSize, EventHandler, ErrorHandler, NULL);
+            break;
+
+        case NUM_MODES:
+
+            LE_FATAL("Invalid mode.");
+    }
+}
+
+
+COMPONENT_INIT
+{
+    size_t docMb = DEFAULT_DOC_MB;
+
+    if (le_arg_NumArgs() > 0)
+    {
+        docMb = strtoul(le_arg_GetArg(0), NULL, 0);
+    }
+
+    CreateDoc(docMb * 1024 * 1024);
+
+    StartMode(MODE_PIPE);
+}
@@ -0,0 +1,424 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Automated unit test for the JSON Parsing API.
+ *
+ * Parses the same document, followed by some other data, from a regular file, from a pipe and from
+ * a memory buffer.  Checks that all the events are reported and that the parser doesn't consume
+ * any of the data that follows the document, even though it reads files in blocks.  Also parses
+ * it from a pipe as a stream, starting with data already read, and checks that the data that
+ * follows the document is handed back.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+
+
+/// Number of numbers in the document's array.  Big enough to make the document span several of the
+/// parser's read blocks.
+#define NUM_NUMBERS 2000
+
+/// Data that follows the document in the input stream.
+#define TRAILER "TRAILER"
+
+/// Number of bytes of the document given to le_json_ParseStream() as already read.
+#define STREAM_PREFIX_BYTES 100
+
+
+/// The JSON document followed by the trailer.
+static char Doc[16 * 1024];
+
+/// Length of the JSON document, not including the trailer.
+static size_t DocLen;
+
+
+/// Counts of the events reported for the document being parsed.
+static struct
+{
+    size_t objectStarts;
+    size_t objectEnds;
+    size_t arrayStarts;
+    size_t arrayEnds;
+    size_t members;
+    size_t numbers;
+    double numberSum;
+    size_t strings;
+    size_t trues;
+    size_t falses;
+    size_t nulls;
+    size_t errors;
+}
+Counts;
+
+
+/// Test steps, in the order they are run.
+typedef enum
+{
+    STEP_FILE,
+    STEP_PIPE,
+    STEP_STREAM,
+    STEP_BUFFER,
+    STEP_TRUNCATED_BUFFER,
+    STEP_EARLY_CLEANUP,
+}
+Step_t;
+
+static Step_t Step;
+
+/// File descriptor the document is being read from (-1 if parsing a buffer).
+static int InputFd = -1;
+
+static void StartStep(Step_t step);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the document.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildDoc
+(
+    void
+)
+{
+    size_t len = snprintf(Doc, sizeof(Doc), "{\n  \"name\": \"joe\",\n  \"list\": [");
+    int i;
+
+    for (i = 0; i < NUM_NUMBERS; i++)
+    {
+        len += snprintf(Doc + len, sizeof(Doc) - len, "%s%d", (i == 0) ? "" : ",", i);
+    }
+
+    len += snprintf(Doc + len,
+                    sizeof(Doc) - len,
+                    "],\n  \"flags\": [ true, false, null ],\n  \"empty\": {}\n}");
+    DocLen = len;
+
+    len += snprintf(Doc + len, sizeof(Doc) - len, TRAILER);
+    LE_ASSERT(len < sizeof(Doc) - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that the expected events were reported for the whole document.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckCounts
+(
+    void
+)
+{
+    LE_TEST(Counts.objectStarts == 2);
+    LE_TEST(Counts.objectEnds == 2);
+    LE_TEST(Counts.arrayStarts == 2);
+    LE_TEST(Counts.arrayEnds == 2);
+    LE_TEST(Counts.members == 4);
+    LE_TEST(Counts.numbers == NUM_NUMBERS);
+    LE_TEST(Counts.numberSum == (double)NUM_NUMBERS * (NUM_NUMBERS - 1) / 2);
+    LE_TEST(Counts.strings == 1);
+    LE_TEST(Counts.trues == 1);
+    LE_TEST(Counts.falses == 1);
+    LE_TEST(Counts.nulls == 1);
+    LE_TEST(Counts.errors == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that the data following the document is still waiting to be read from the input fd.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckTrailer
+(
+    void
+)
+{
+    char buffer[sizeof(TRAILER) + 8];
+    ssize_t bytesRead;
+
+    do
+    {
+        bytesRead = read(InputFd, buffer, sizeof(buffer) - 1);
+    }
+    while ((bytesRead == -1) && (errno == EINTR));
+
+    LE_TEST(bytesRead == strlen(TRAILER));
+    if (bytesRead >= 0)
+    {
+        buffer[bytesRead] = '\0';
+        LE_TEST(strcmp(buffer, TRAILER) == 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that the data following the document was handed back by le_json_GetUnparsedData(),
+ * with anything the parser didn't get to still waiting to be read from the input fd.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckStreamTrailer
+(
+    void
+)
+{
+    char buffer[sizeof(TRAILER) + 8];
+    size_t unparsedSize;
+    const void* unparsedPtr = le_json_GetUnparsedData(le_json_GetSession(), &unparsedSize);
+
+    LE_TEST(unparsedSize <= strlen(TRAILER));
+    if (unparsedSize > strlen(TRAILER))
+    {
+        return;
+    }
+    memcpy(buffer, unparsedPtr, unparsedSize);
+
+    ssize_t bytesRead;
+    do
+    {
+        bytesRead = read(InputFd, buffer + unparsedSize, sizeof(buffer) - unparsedSize - 1);
+    }
+    while ((bytesRead == -1) && (errno == EINTR));
+
+    LE_TEST(bytesRead >= 0);
+    if (bytesRead >= 0)
+    {
+        buffer[unparsedSize + bytesRead] = '\0';
+        LE_TEST(strcmp(buffer, TRAILER) == 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves on to the next step.  Queued to the Event Loop so the parsing session can be cleaned up
+ * from inside the handler that finished it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NextStep
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    if (InputFd != -1)
+    {
+        close(InputFd);
+        InputFd = -1;
+    }
+
+    if (Step == STEP_EARLY_CLEANUP)
+    {
+        LE_TEST_EXIT;
+    }
+
+    StartStep(Step + 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finishes the current step.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FinishStep
+(
+    void
+)
+{
+    le_json_Cleanup(le_json_GetSession());
+    le_event_QueueFunction(NextStep, NULL, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counts parsing events.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EventHandler
+(
+    le_json_Event_t event
+)
+{
+    LE_FATAL_IF(Step == STEP_EARLY_CLEANUP, "Event %s reported after cleanup.",
+                le_json_GetEventName(event));
+
+    switch (event)
+    {
+        case LE_JSON_OBJECT_START:
+            Counts.objectStarts++;
+            break;
+
+        case LE_JSON_OBJECT_MEMBER:
+            Counts.members++;
+            break;
+
+        case LE_JSON_OBJECT_END:
+            Counts.objectEnds++;
+            break;
+
+        case LE_JSON_ARRAY_START:
+            Counts.arrayStarts++;
+            break;
+
+        case LE_JSON_ARRAY_END:
+            Counts.arrayEnds++;
+            break;
+
+        case LE_JSON_STRING:
+            LE_TEST(strcmp(le_json_GetString(), "joe") == 0);
+            Counts.strings++;
+            break;
+
+        case LE_JSON_NUMBER:
+            Counts.numberSum += le_json_GetNumber();
+            Counts.numbers++;
+            break;
+
+        case LE_JSON_TRUE:
+            Counts.trues++;
+            break;
+
+        case LE_JSON_FALSE:
+            Counts.falses++;
+            break;
+
+        case LE_JSON_NULL:
+            Counts.nulls++;
+            break;
+
+        case LE_JSON_DOC_END:
+
+            LE_INFO("Step %d: document end after %zu bytes.",
+                    Step,
+                    le_json_GetBytesRead(le_json_GetSession()));
+
+            LE_TEST(Step != STEP_TRUNCATED_BUFFER);
+            CheckCounts();
+            LE_TEST(le_json_GetBytesRead(le_json_GetSession()) == DocLen);
+            if (Step == STEP_STREAM)
+            {
+                CheckStreamTrailer();
+            }
+            else if (InputFd != -1)
+            {
+                CheckTrailer();
+            }
+
+            FinishStep();
+            break;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles parsing errors.  Only expected for the truncated buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ErrorHandler
+(
+    le_json_Error_t error,
+    const char* msg
+)
+{
+    LE_INFO("Step %d: error '%s'.", Step, msg);
+
+    LE_TEST(Step == STEP_TRUNCATED_BUFFER);
+    LE_TEST(error == LE_JSON_READ_ERROR);
+
+    Counts.errors++;
+
+    FinishStep();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts a step.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartStep
+(
+    Step_t step
+)
+{
+    Step = step;
+    memset(&Counts, 0, sizeof(Counts));
+
+    switch (step)
+    {
+        case STEP_FILE:
+        {
+            char path[] = "/tmp/jsonTestXXXXXX";
+            InputFd = mkstemp(path);
+            LE_ASSERT(InputFd != -1);
+            LE_ASSERT(unlink(path) == 0);
+            LE_ASSERT(write(InputFd, Doc, strlen(Doc)) == strlen(Doc));
+            LE_ASSERT(lseek(InputFd, 0, SEEK_SET) == 0);
+
+            le_json_Parse(InputFd, EventHandler, ErrorHandler, NULL);
+            break;
+        }
+
+        case STEP_PIPE:
+        {
+            int fds[2];
+            LE_ASSERT(pipe(fds) == 0);
+            LE_ASSERT(write(fds[1], Doc, strlen(Doc)) == strlen(Doc));
+            close(fds[1]);
+            InputFd = fds[0];
+
+            le_json_Parse(InputFd, EventHandler, ErrorHandler, NULL);
+            break;
+        }
+
+        case STEP_STREAM:
+        {
+            int fds[2];
+            LE_ASSERT(pipe(fds) == 0);
+            size_t restLen = strlen(Doc) - STREAM_PREFIX_BYTES;
+            LE_ASSERT(write(fds[1], Doc + STREAM_PREFIX_BYTES, restLen) == restLen);
+            close(fds[1]);
+            InputFd = fds[0];
+
+            le_json_ParseStream(InputFd,
+                                Doc,
+                                STREAM_PREFIX_BYTES,
+                                EventHandler,
+                                ErrorHandler,
+                                NULL);
+            break;
+        }
+
+        case STEP_BUFFER:
+
+            le_json_ParseBuffer(Doc, strlen(Doc), EventHandler, ErrorHandler, NULL);
+            break;
+
+        case STEP_TRUNCATED_BUFFER:
+
+            le_json_ParseBuffer(Doc, DocLen - 3, EventHandler, ErrorHandler, NULL);
+            break;
+
+        case STEP_EARLY_CLEANUP:
+
+            // No handlers should be called if the session is cleaned up before parsing starts.
+            le_json_Cleanup(le_json_ParseBuffer(Doc, DocLen, EventHandler, ErrorHandler, NULL));
+            le_event_QueueFunction(NextStep, NULL, NULL);
+            break;
+    }
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_INIT;
+
+    BuildDoc();
+
+    StartStep(STEP_FILE);
+}
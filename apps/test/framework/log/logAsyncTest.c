@@ -0,0 +1,314 @@
+/**
+ * Automated test of asynchronous logging (LE_LOG_ASYNC=1).
+ *
+ *  - Re-executes itself with LE_LOG_ASYNC=1 if that isn't already set.
+ *  - Redirects stderr to a temporary file.
+ *  - Several threads log messages using a variety of conversions, overwriting their string
+ *    arguments and errno straight after each call, to check that everything is captured at the
+ *    time of the call.
+ *  - Logs a string that isn't null-terminated, using a '*' precision, from the end of a page
+ *    followed by an inaccessible guard page.
+ *  - Logs a CRITICAL message, which must flush all of the queued messages ahead of it.
+ *  - Reads the file back and checks every message, counting those reported as dropped.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#include "legato.h"
+#include <sys/mman.h>
+
+#define NUM_THREADS 4
+
+// Each thread logs this many messages without pausing (some may be dropped), then this many more
+// with a pause between them (none should be dropped).
+#define NUM_BURST_MSGS  2000
+#define NUM_PACED_MSGS  50
+
+#define NUM_MSGS_PER_THREAD (NUM_BURST_MSGS + NUM_PACED_MSGS)
+
+#define MAX_LINE_BYTES 512
+
+#define LAST_MSG "All worker messages logged."
+
+// Bytes placed right before the guard page, without a null terminator.
+#define GUARD_STR "unterminated"
+
+// Next message index expected from each thread.
+static unsigned int NextIndex[NUM_THREADS];
+
+static int NumDropped;
+static int NumReceived;
+static int NumErrnoMsgs;
+static int NumGuardMsgs;
+static bool LastMsgFound;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logs one test message.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LogTestMsg
+(
+    int threadIndex,
+    unsigned int msgIndex
+)
+{
+    char word[16];
+
+    snprintf(word, sizeof(word), "word%u", msgIndex);
+
+    LE_INFO("thread %d msg %05u str '%s' ll %lld dbl %.2f width '%*d' prec '%.*s' hex %#x %%",
+            threadIndex,
+            msgIndex,
+            word,
+            (long long)msgIndex * 1000000007LL,
+            msgIndex / 4.0,
+            6,
+            threadIndex,
+            3,
+            "abcdef",
+            msgIndex);
+
+    // The message must not be affected by what happens to the argument after the call.
+    memset(word, 'X', sizeof(word) - 1);
+    word[sizeof(word) - 1] = '\0';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Worker thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WorkerMain
+(
+    void* contextPtr
+)
+{
+    int threadIndex = (int)(size_t)contextPtr;
+    unsigned int i;
+
+    for (i = 0; i < NUM_BURST_MSGS; i++)
+    {
+        LogTestMsg(threadIndex, i);
+    }
+
+    for (; i < NUM_MSGS_PER_THREAD; i++)
+    {
+        LogTestMsg(threadIndex, i);
+        usleep(1000);
+    }
+
+    errno = ENOENT;
+    LE_WARN("thread %d errno '%m'", threadIndex);
+    errno = 0;
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks one line of log output.
+ *
+ * Failures are only counted here: with so many lines, reporting each check would flood the
+ * (asynchronous) log.
+ *
+ * @return true if the line is correct.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckLine
+(
+    const char* linePtr
+)
+{
+    int dropped;
+    int threadIndex;
+    unsigned int msgIndex;
+    char expected[MAX_LINE_BYTES];
+
+    const char* msgPtr = strrchr(linePtr, '|');
+    if (msgPtr == NULL)
+    {
+        return false;
+    }
+    msgPtr += 2;
+
+    if (sscanf(msgPtr, "%d log messages were dropped", &dropped) == 1)
+    {
+        NumDropped += dropped;
+        return true;
+    }
+
+    if (sscanf(msgPtr, "thread %d msg %u", &threadIndex, &msgIndex) == 2)
+    {
+        if ((threadIndex < 0) || (threadIndex >= NUM_THREADS) || LastMsgFound)
+        {
+            return false;
+        }
+
+        snprintf(expected, sizeof(expected),
+                 "thread %d msg %05u str 'word%u' ll %lld dbl %.2f width '%6d' prec 'abc'"
+                 " hex %#x %%\n",
+                 threadIndex, msgIndex, msgIndex, (long long)msgIndex * 1000000007LL,
+                 msgIndex / 4.0, threadIndex, msgIndex);
+
+        char threadName[32];
+        snprintf(threadName, sizeof(threadName), " T=worker%d ", threadIndex);
+
+        // Messages from each thread must come out in order.
+        bool isInOrder = (msgIndex >= NextIndex[threadIndex]);
+        NextIndex[threadIndex] = msgIndex + 1;
+        NumReceived++;
+
+        return isInOrder
+               && (strcmp(msgPtr, expected) == 0)
+               && (strstr(linePtr, threadName) != NULL)
+               && (strstr(linePtr, " INFO | ") != NULL)
+               && (strstr(linePtr, " logAsyncTest.c LogTestMsg() ") != NULL);
+    }
+
+    if (sscanf(msgPtr, "thread %d errno", &threadIndex) == 1)
+    {
+        snprintf(expected, sizeof(expected), "thread %d errno '%s'\n",
+                 threadIndex, strerror(ENOENT));
+        NumErrnoMsgs++;
+
+        return (strcmp(msgPtr, expected) == 0) && !LastMsgFound;
+    }
+
+    if (strncmp(msgPtr, "guard ", 6) == 0)
+    {
+        NumGuardMsgs++;
+
+        return (strcmp(msgPtr, "guard '" GUARD_STR "' 'term'\n") == 0) && !LastMsgFound;
+    }
+
+    if (strcmp(msgPtr, LAST_MSG "\n") == 0)
+    {
+        LastMsgFound = true;
+        return true;
+    }
+
+    // Anything else is output from the test itself.
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logs a string that isn't null-terminated, limited by a '*' precision. The string ends right
+ * before an inaccessible page, so reading past it faults.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LogGuardedString
+(
+    void
+)
+{
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+
+    uint8_t* pagesPtr = mmap(NULL, 2 * pageSize, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    LE_ASSERT(pagesPtr != MAP_FAILED);
+    LE_ASSERT(mprotect(pagesPtr + pageSize, pageSize, PROT_NONE) == 0);
+
+    char* strPtr = (char*)pagesPtr + pageSize - (sizeof(GUARD_STR) - 1);
+    memcpy(strPtr, GUARD_STR, sizeof(GUARD_STR) - 1);
+
+    // A negative precision is the same as none, so the second string must be terminated.
+    LE_INFO("guard '%.*s' '%.*s'", (int)(sizeof(GUARD_STR) - 1), strPtr, -1, "term");
+
+    LE_ASSERT(munmap(pagesPtr, 2 * pageSize) == 0);
+}
+
+
+COMPONENT_INIT
+{
+    const char* asyncStr = getenv("LE_LOG_ASYNC");
+
+    if ((asyncStr == NULL) || (strcmp(asyncStr, "1") != 0))
+    {
+        // Asynchronous logging is chosen when the process starts.
+        setenv("LE_LOG_ASYNC", "1", true);
+        execl("/proc/self/exe", le_arg_GetProgramName(), (char*)NULL);
+        LE_FATAL("Failed to re-execute self (%m).");
+    }
+
+    LE_TEST_INIT;
+
+    LE_INFO("======= Test: asynchronous logging ========");
+
+#ifdef LEGATO_EMBEDDED
+    LE_INFO("Log messages go to syslog on target, so they can't be checked here.");
+#else
+    char logPath[] = "/tmp/logAsyncTestXXXXXX";
+    int logFd = mkstemp(logPath);
+    LE_ASSERT(logFd >= 0);
+    unlink(logPath);
+
+    fflush(stderr);
+    int savedStderr = dup(STDERR_FILENO);
+    LE_ASSERT(savedStderr >= 0);
+    LE_ASSERT(dup2(logFd, STDERR_FILENO) == STDERR_FILENO);
+
+    le_thread_Ref_t threads[NUM_THREADS];
+    int i;
+
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        char name[16];
+        snprintf(name, sizeof(name), "worker%d", i);
+        threads[i] = le_thread_Create(name, WorkerMain, (void*)(size_t)i);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        LE_ASSERT(le_thread_Join(threads[i], NULL) == LE_OK);
+    }
+
+    LogGuardedString();
+
+    // Logged synchronously, after everything that is still queued.
+    LE_CRIT(LAST_MSG);
+
+    fflush(stderr);
+    LE_ASSERT(dup2(savedStderr, STDERR_FILENO) == STDERR_FILENO);
+    close(savedStderr);
+
+    FILE* logFilePtr = fdopen(logFd, "r");
+    LE_ASSERT(logFilePtr != NULL);
+    rewind(logFilePtr);
+
+    char line[MAX_LINE_BYTES];
+    int numBadLines = 0;
+    while (fgets(line, sizeof(line), logFilePtr) != NULL)
+    {
+        if (!CheckLine(line))
+        {
+            LE_ERROR("Bad log line: %s", line);
+            numBadLines++;
+        }
+    }
+    fclose(logFilePtr);
+
+    LE_INFO("%d messages received, %d dropped.", NumReceived, NumDropped);
+
+    LE_TEST(numBadLines == 0);
+    LE_TEST(LastMsgFound);
+    LE_TEST(NumReceived + NumDropped == NUM_THREADS * NUM_MSGS_PER_THREAD);
+    LE_TEST(NumErrnoMsgs == NUM_THREADS);
+    LE_TEST(NumGuardMsgs == 1);
+
+    // The paced messages must all have made it.
+    LE_TEST(NumReceived >= NUM_THREADS * NUM_PACED_MSGS);
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        LE_TEST(NextIndex[i] == NUM_MSGS_PER_THREAD);
+    }
+#endif
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,108 @@
+/**
+ * This program measures how long a logging call takes the calling thread, with synchronous
+ * logging and then with asynchronous logging (LE_LOG_ASYNC=1).  Log output goes to /dev/null.
+ *
+ * Messages are logged in bursts small enough to fit in the asynchronous log buffer, with a pause
+ * between bursts (not measured) to let the writer thread catch up, so no messages are dropped.
+ *
+ * Usage: logBench [numBursts]
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+
+
+// Default number of bursts.
+#define DEFAULT_NUM_BURSTS 200
+
+// Messages per burst.
+#define BURST_SIZE 250
+
+// Pause between bursts, in microseconds.
+#define PAUSE_USEC 20000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of microseconds between two times.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log the given number of bursts of messages and return the time spent in the logging calls.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t RunBursts
+(
+    size_t numBursts
+)
+{
+    uint64_t usec = 0;
+    size_t burst;
+    int i;
+
+    for (burst = 0; burst < numBursts; burst++)
+    {
+        le_clk_Time_t startTime = le_clk_GetRelativeTime();
+        for (i = 0; i < BURST_SIZE; i++)
+        {
+            LE_INFO("Burst %zu message %d: value %u, name '%s'.", burst, i, i * 7u, "bench");
+        }
+        usec += ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+        usleep(PAUSE_USEC);
+    }
+
+    return usec;
+}
+
+
+COMPONENT_INIT
+{
+    size_t numBursts = DEFAULT_NUM_BURSTS;
+    const char* asyncStr = getenv("LE_LOG_ASYNC");
+    bool isAsync = ((asyncStr != NULL) && (strcmp(asyncStr, "1") == 0));
+
+    if (le_arg_NumArgs() > 0)
+    {
+        numBursts = strtoul(le_arg_GetArg(0), NULL, 0);
+    }
+
+    int nullFd = open("/dev/null", O_WRONLY);
+    LE_ASSERT(nullFd >= 0);
+    LE_ASSERT(dup2(nullFd, STDERR_FILENO) == STDERR_FILENO);
+    close(nullFd);
+
+    uint64_t usec = RunBursts(numBursts);
+
+    printf("%-12s logging: %8.1f ns per LE_INFO() call\n",
+           isAsync ? "asynchronous" : "synchronous",
+           usec * 1000.0 / (numBursts * BURST_SIZE));
+    fflush(stdout);
+
+    if (!isAsync)
+    {
+        // Asynchronous logging is chosen when the process starts.
+        char numBurstsStr[32];
+        snprintf(numBurstsStr, sizeof(numBurstsStr), "%zu", numBursts);
+        setenv("LE_LOG_ASYNC", "1", true);
+        execl("/proc/self/exe", le_arg_GetProgramName(), numBurstsStr, (char*)NULL);
+        LE_FATAL("Failed to re-execute self (%m).");
+    }
+
+    exit(EXIT_SUCCESS);
+}
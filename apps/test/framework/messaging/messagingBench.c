@@ -0,0 +1,479 @@
+/**
+ * This program measures how many bytes the messaging system sends per system call, and how much
+ * memory each session ties up while a client has indications queued up, for small messages on a
+ * protocol whose largest message is 2 KB (like a watchdog kick on a big API).
+ *
+ * It is run once with every message sending its whole payload buffer (how all messages were sent
+ * before le_msg_SetPayloadSize() existed), and once with every message sending only its used
+ * bytes (like the ifgen-generated stubs do).  Each run is done in a separate process so the memory
+ * pools of one don't skew the other.
+ *
+ * Bytes and system calls are counted by wrapping sendmsg() and sendmmsg().
+ *
+ * Usage: testFwMessaging-Bench [full|packed]
+ *
+ * With no arguments, the bindings are configured by testFwMessaging-Setup and both modes are run.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+#include <dlfcn.h>
+#include <sys/socket.h>
+
+
+#define SERVICE_NAME "messagingBench"
+#define PROTOCOL_ID_STR "testFwMessagingBench"
+
+// Size of the largest message in the protocol.
+#define MAX_MSG_SIZE 2048
+
+#define NUM_SESSIONS 100
+
+// Number of request-response transactions done on each session.
+#define NUM_TXNS_PER_SESSION 20
+
+// Number of indications queued up on each session.
+#define NUM_INDICATIONS_PER_SESSION 20
+
+
+// Commands sent by the client.
+typedef enum
+{
+    CMD_ECHO,               ///< Respond with the same value.
+    CMD_SEND_INDICATIONS    ///< Send NUM_INDICATIONS_PER_SESSION indications, then respond.
+}
+Command_t;
+
+typedef struct
+{
+    uint32_t command;
+    uint32_t value;
+}
+Message_t;
+
+
+// true = send only the used part of the payload buffers.
+static bool IsPacked;
+
+static le_msg_ProtocolRef_t ProtocolRef;
+
+// Posted by the server thread once the service has been advertised.
+static le_sem_Ref_t ServiceReadySemRef;
+
+static le_msg_SessionRef_t Sessions[NUM_SESSIONS];
+
+// Indications that the client is holding on to, as if it hadn't got around to processing them.
+static le_msg_MessageRef_t HeldIndications[NUM_SESSIONS * NUM_INDICATIONS_PER_SESSION];
+static size_t NumHeldIndications;
+
+static size_t StartRss;
+
+// Counts of send system calls, messages and bytes, updated by the sendmsg() and sendmmsg()
+// wrappers (which can be called by any thread).  These are counted before the real system call is
+// made (and uncounted if it fails), so that a response is always counted before the client sees
+// it.
+static uint64_t SendCalls;
+static uint64_t SendMsgs;
+static uint64_t SendBytes;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds to the send counts.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CountSend
+(
+    int64_t calls,
+    int64_t msgs,
+    int64_t bytes
+)
+{
+    __atomic_add_fetch(&SendCalls, calls, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&SendMsgs, msgs, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&SendBytes, bytes, __ATOMIC_RELAXED);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of data bytes in a message header's I/O vector.
+ */
+//--------------------------------------------------------------------------------------------------
+static int64_t GetMsgBytes
+(
+    const struct msghdr* msgPtr
+)
+{
+    int64_t bytes = 0;
+    size_t i;
+
+    for (i = 0; i < msgPtr->msg_iovlen; i++)
+    {
+        bytes += msgPtr->msg_iov[i].iov_len;
+    }
+
+    return bytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wraps sendmsg() to count calls and bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+ssize_t sendmsg
+(
+    int sockfd,
+    const struct msghdr* msgPtr,
+    int flags
+)
+{
+    static ssize_t (*realSendMsg)(int, const struct msghdr*, int);
+
+    if (realSendMsg == NULL)
+    {
+        realSendMsg = dlsym(RTLD_NEXT, "sendmsg");
+        LE_ASSERT(realSendMsg != NULL);
+    }
+
+    int64_t bytes = GetMsgBytes(msgPtr);
+
+    CountSend(1, 1, bytes);
+
+    ssize_t result = realSendMsg(sockfd, msgPtr, flags);
+
+    if (result < 0)
+    {
+        CountSend(-1, -1, -bytes);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wraps sendmmsg() to count calls and bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+int sendmmsg
+(
+    int sockfd,
+    struct mmsghdr* msgVec,
+    unsigned int vlen,
+    int flags
+)
+{
+    static int (*realSendMmsg)(int, struct mmsghdr*, unsigned int, int);
+
+    if (realSendMmsg == NULL)
+    {
+        realSendMmsg = dlsym(RTLD_NEXT, "sendmmsg");
+        LE_ASSERT(realSendMmsg != NULL);
+    }
+
+    int64_t bytes = 0;
+    unsigned int i;
+
+    for (i = 0; i < vlen; i++)
+    {
+        bytes += GetMsgBytes(&msgVec[i].msg_hdr);
+    }
+
+    CountSend(1, vlen, bytes);
+
+    int result = realSendMmsg(sockfd, msgVec, vlen, flags);
+
+    // Uncount the messages that weren't sent.
+    unsigned int numSent = (result > 0) ? result : 0;
+    int64_t unsentBytes = 0;
+
+    for (i = numSent; i < vlen; i++)
+    {
+        unsentBytes += GetMsgBytes(&msgVec[i].msg_hdr);
+    }
+
+    CountSend((numSent == 0) ? -1 : 0, -(int64_t)(vlen - numSent), -unsentBytes);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets this process's resident set size.
+ *
+ * @return The size, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetRss
+(
+    void
+)
+{
+    FILE* filePtr = fopen("/proc/self/statm", "r");
+    unsigned long size;
+    unsigned long resident = 0;
+
+    LE_ASSERT(filePtr != NULL);
+    LE_ASSERT(fscanf(filePtr, "%lu %lu", &size, &resident) == 2);
+    fclose(filePtr);
+
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tells the messaging system how much of a message's payload to send.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetPayloadSize
+(
+    le_msg_MessageRef_t msgRef
+)
+{
+    if (IsPacked)
+    {
+        le_msg_SetPayloadSize(msgRef, sizeof(Message_t));
+    }
+}
+
+
+// ==================================
+//  SERVER
+// ==================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles requests from the client.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ServerRecvHandler
+(
+    le_msg_MessageRef_t msgRef,
+    void* contextPtr
+)
+{
+    Message_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    if (msgPtr->command == CMD_SEND_INDICATIONS)
+    {
+        le_msg_SessionRef_t sessionRef = le_msg_GetSession(msgRef);
+        uint32_t i;
+
+        for (i = 0; i < NUM_INDICATIONS_PER_SESSION; i++)
+        {
+            le_msg_MessageRef_t indRef = le_msg_CreateMsg(sessionRef);
+            Message_t* indPtr = le_msg_GetPayloadPtr(indRef);
+
+            indPtr->command = CMD_SEND_INDICATIONS;
+            indPtr->value = i;
+            SetPayloadSize(indRef);
+            le_msg_Send(indRef);
+        }
+    }
+
+    SetPayloadSize(msgRef);
+    le_msg_Respond(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Server thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ServerThreadMain
+(
+    void* contextPtr
+)
+{
+    le_msg_ServiceRef_t serviceRef = le_msg_CreateService(ProtocolRef, SERVICE_NAME);
+    le_msg_SetServiceRecvHandler(serviceRef, ServerRecvHandler, NULL);
+    le_msg_AdvertiseService(serviceRef);
+
+    le_sem_Post(ServiceReadySemRef);
+
+    le_event_RunLoop();
+}
+
+
+// ==================================
+//  CLIENT
+// ==================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Holds on to the indications received from the server.  Prints the results once all of them
+ * have arrived.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClientRecvHandler
+(
+    le_msg_MessageRef_t msgRef,
+    void* contextPtr
+)
+{
+    LE_ASSERT(NumHeldIndications < NUM_ARRAY_MEMBERS(HeldIndications));
+
+    HeldIndications[NumHeldIndications] = msgRef;
+    NumHeldIndications++;
+
+    if (NumHeldIndications == NUM_ARRAY_MEMBERS(HeldIndications))
+    {
+        size_t rss = GetRss();
+
+        printf("%-8s %8zu bytes RSS per session with %d indications queued\n",
+               IsPacked ? "packed" : "full",
+               (rss - StartRss) / NUM_SESSIONS,
+               NUM_INDICATIONS_PER_SESSION);
+
+        exit(EXIT_SUCCESS);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Does a request-response transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DoTransaction
+(
+    le_msg_SessionRef_t sessionRef,
+    Command_t command,
+    uint32_t value
+)
+{
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionRef);
+    Message_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    msgPtr->command = command;
+    msgPtr->value = value;
+    SetPayloadSize(msgRef);
+
+    le_msg_MessageRef_t rspMsgRef = le_msg_RequestSyncResponse(msgRef);
+    LE_ASSERT(rspMsgRef != NULL);
+
+    msgPtr = le_msg_GetPayloadPtr(rspMsgRef);
+    LE_ASSERT(msgPtr->value == value);
+
+    le_msg_ReleaseMsg(rspMsgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ClientThreadMain
+(
+    void* contextPtr
+)
+{
+    uint32_t i;
+    uint32_t j;
+
+    le_sem_Wait(ServiceReadySemRef);
+
+    StartRss = GetRss();
+
+    for (i = 0; i < NUM_SESSIONS; i++)
+    {
+        Sessions[i] = le_msg_CreateSession(ProtocolRef, SERVICE_NAME);
+        le_msg_SetSessionRecvHandler(Sessions[i], ClientRecvHandler, NULL);
+        le_msg_OpenSessionSync(Sessions[i]);
+    }
+
+    __atomic_store_n(&SendCalls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&SendMsgs, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&SendBytes, 0, __ATOMIC_RELAXED);
+
+    for (j = 0; j < NUM_TXNS_PER_SESSION; j++)
+    {
+        for (i = 0; i < NUM_SESSIONS; i++)
+        {
+            DoTransaction(Sessions[i], CMD_ECHO, j);
+        }
+    }
+
+    uint64_t calls = __atomic_load_n(&SendCalls, __ATOMIC_RELAXED);
+    uint64_t bytes = __atomic_load_n(&SendBytes, __ATOMIC_RELAXED);
+
+    printf("%-8s %8" PRIu64 " msgs %8" PRIu64 " calls %10" PRIu64 " bytes %8.1f bytes/call\n",
+           IsPacked ? "packed" : "full",
+           __atomic_load_n(&SendMsgs, __ATOMIC_RELAXED),
+           calls,
+           bytes,
+           (calls == 0) ? 0.0 : (double)bytes / calls);
+
+    // Have the server queue up indications on every session.  They are held by the receive
+    // handler, which prints the rest of the results once they have all arrived.
+    for (i = 0; i < NUM_SESSIONS; i++)
+    {
+        DoTransaction(Sessions[i], CMD_SEND_INDICATIONS, i);
+    }
+
+    le_event_RunLoop();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs this program again, in a given mode, and waits for it to finish.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunMode
+(
+    const char* mode
+)
+{
+    pid_t pid = fork();
+    LE_ASSERT(pid != -1);
+
+    if (pid == 0)
+    {
+        execl("/proc/self/exe", le_arg_GetProgramName(), mode, (char*)NULL);
+        _exit(EXIT_FAILURE);
+    }
+
+    int status;
+    LE_ASSERT(waitpid(pid, &status, 0) == pid);
+    LE_ASSERT(WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_SUCCESS));
+}
+
+
+COMPONENT_INIT
+{
+    setlinebuf(stdout);
+
+    if (le_arg_NumArgs() == 0)
+    {
+        system("testFwMessaging-Setup");
+
+        RunMode("full");
+        RunMode("packed");
+        exit(EXIT_SUCCESS);
+    }
+
+    const char* mode = le_arg_GetArg(0);
+    if (strcmp(mode, "packed") == 0)
+    {
+        IsPacked = true;
+    }
+    else if (strcmp(mode, "full") != 0)
+    {
+        LE_FATAL("Unknown mode '%s'.", mode);
+    }
+
+    ProtocolRef = le_msg_GetProtocolRef(PROTOCOL_ID_STR, MAX_MSG_SIZE);
+    ServiceReadySemRef = le_sem_Create("ServiceReady", 0);
+
+    le_thread_Start(le_thread_Create("server", ServerThreadMain, NULL));
+    le_thread_Start(le_thread_Create("client", ClientThreadMain, NULL));
+}
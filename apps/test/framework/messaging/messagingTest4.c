@@ -0,0 +1,300 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Automated unit test for the Low-Level Messaging APIs.
+ *
+ * Test 4:
+ *  - Server and client in different threads of the same process, using a protocol with large
+ *    messages that has shared memory enabled.
+ *  - Client does some synchronous requests.  The server's shared memory offer arrives during
+ *    these and is left for the client's event loop to accept.
+ *  - Once the offer has been accepted, client sends a burst of asynchronous requests that is
+ *    too big to fit in the shared memory region, so some payloads go through the socket instead.
+ *  - Client holds on to some of the responses while more traffic passes through shared memory,
+ *    and releases them in reverse order at the end.
+ *  - Server responds to each request, then sends an indication message once all are done.
+ *  - Checks that every payload arrives intact, and that held payloads are not overwritten.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+
+#define SERVICE_INSTANCE_NAME "messagingTest4"
+#define PROTOCOL_ID_STR "testFwMessaging4"
+
+#define PAYLOAD_SIZE (60 * 1024)
+#define SHARED_MEM_THRESHOLD 4096
+#define SHARED_MEM_REGION_SIZE (256 * 1024)
+
+#define NUM_SYNC_REQUESTS 20
+#define NUM_ASYNC_REQUESTS 40
+
+// Seed of the indication message the server sends once all the asynchronous requests are done.
+#define INDICATION_SEED 0xabcd
+
+static le_msg_ProtocolRef_t ProtocolRef;
+
+static int AsyncResponseCount = 0;
+
+// Responses that the client holds on to until the end, and their seeds.
+static le_msg_MessageRef_t HeldResponses[NUM_ASYNC_REQUESTS];
+static uint32_t HeldSeeds[NUM_ASYNC_REQUESTS];
+static int HeldCount = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fills a payload with a pattern derived from a seed value.  The first word is the seed itself.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillPayload
+(
+    le_msg_MessageRef_t msgRef,
+    uint32_t seed
+)
+{
+    uint32_t* wordPtr = le_msg_GetPayloadPtr(msgRef);
+    size_t i;
+
+    wordPtr[0] = seed;
+    for (i = 1; i < PAYLOAD_SIZE / sizeof(uint32_t); i++)
+    {
+        wordPtr[i] = seed * 2654435761u + i;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that a payload holds the pattern for a seed value.
+ *
+ * @return true if it does.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckPayload
+(
+    le_msg_MessageRef_t msgRef,
+    uint32_t seed
+)
+{
+    const uint32_t* wordPtr = le_msg_GetPayloadPtr(msgRef);
+    size_t i;
+
+    if (wordPtr[0] != seed)
+    {
+        LE_ERROR("Payload seed is %u (expected %u).", wordPtr[0], seed);
+        return false;
+    }
+
+    for (i = 1; i < PAYLOAD_SIZE / sizeof(uint32_t); i++)
+    {
+        if (wordPtr[i] != seed * 2654435761u + i)
+        {
+            LE_ERROR("Payload word %zu is %x (seed %u).", i, wordPtr[i], seed);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// ==================================
+//  SERVER
+// ==================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Responds to each request with the pattern for the next seed value.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ServerRecvHandler
+(
+    le_msg_MessageRef_t msgRef,
+    void* contextPtr
+)
+{
+    static int requestCount = 0;
+
+    uint32_t seed = *(uint32_t*)le_msg_GetPayloadPtr(msgRef);
+
+    LE_TEST(seed < NUM_SYNC_REQUESTS + NUM_ASYNC_REQUESTS);
+    LE_TEST(CheckPayload(msgRef, seed));
+
+    le_msg_SessionRef_t sessionRef = le_msg_GetSession(msgRef);
+
+    FillPayload(msgRef, seed + 1000);
+    le_msg_Respond(msgRef);
+
+    requestCount++;
+    if (requestCount == NUM_SYNC_REQUESTS + NUM_ASYNC_REQUESTS)
+    {
+        le_msg_MessageRef_t indMsgRef = le_msg_CreateMsg(sessionRef);
+        FillPayload(indMsgRef, INDICATION_SEED);
+        le_msg_Send(indMsgRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Server thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ServerThreadMain
+(
+    void* contextPtr
+)
+{
+    le_msg_ServiceRef_t serviceRef = le_msg_CreateService(ProtocolRef, SERVICE_INSTANCE_NAME);
+    le_msg_SetServiceRecvHandler(serviceRef, ServerRecvHandler, NULL);
+    le_msg_AdvertiseService(serviceRef);
+
+    le_event_RunLoop();
+}
+
+
+// ==================================
+//  CLIENT
+// ==================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks the indication message the server sends at the end.  This is the end of the test.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClientIndicationRecvHandler
+(
+    le_msg_MessageRef_t msgRef,
+    void* contextPtr
+)
+{
+    LE_TEST(CheckPayload(msgRef, INDICATION_SEED));
+    le_msg_ReleaseMsg(msgRef);
+
+    LE_TEST(AsyncResponseCount == NUM_ASYNC_REQUESTS);
+
+    // Release the held responses newest first.
+    while (HeldCount > 0)
+    {
+        HeldCount--;
+        LE_TEST(CheckPayload(HeldResponses[HeldCount], HeldSeeds[HeldCount] + 1000));
+        le_msg_ReleaseMsg(HeldResponses[HeldCount]);
+    }
+
+    LE_TEST_EXIT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks the response to an asynchronous request.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClientResponseHandler
+(
+    le_msg_MessageRef_t msgRef,
+    void* contextPtr
+)
+{
+    uint32_t seed = (uint32_t)(size_t)contextPtr;
+
+    LE_TEST(msgRef != NULL);
+    if (msgRef != NULL)
+    {
+        LE_TEST(CheckPayload(msgRef, seed + 1000));
+
+        // Hold on to every third response.
+        if ((seed % 3) == 0)
+        {
+            HeldResponses[HeldCount] = msgRef;
+            HeldSeeds[HeldCount] = seed;
+            HeldCount++;
+        }
+        else
+        {
+            le_msg_ReleaseMsg(msgRef);
+        }
+    }
+
+    AsyncResponseCount++;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends the burst of asynchronous requests.  This is queued to the client's event loop behind the
+ * handling of the server's shared memory offer, so the responses can come back through shared
+ * memory.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendAsyncRequests
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    le_msg_SessionRef_t sessionRef = param1Ptr;
+    uint32_t seed;
+
+    for (seed = NUM_SYNC_REQUESTS; seed < NUM_SYNC_REQUESTS + NUM_ASYNC_REQUESTS; seed++)
+    {
+        le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionRef);
+        FillPayload(msgRef, seed);
+
+        le_msg_RequestResponse(msgRef, ClientResponseHandler, (void*)(size_t)seed);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ClientThreadMain
+(
+    void* contextPtr
+)
+{
+    le_msg_SessionRef_t sessionRef = le_msg_CreateSession(ProtocolRef, SERVICE_INSTANCE_NAME);
+    le_msg_SetSessionRecvHandler(sessionRef, ClientIndicationRecvHandler, NULL);
+    le_msg_OpenSessionSync(sessionRef);
+
+    uint32_t seed;
+
+    for (seed = 0; seed < NUM_SYNC_REQUESTS; seed++)
+    {
+        le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionRef);
+        FillPayload(msgRef, seed);
+
+        le_msg_MessageRef_t rspMsgRef = le_msg_RequestSyncResponse(msgRef);
+        LE_TEST(rspMsgRef != NULL);
+        if (rspMsgRef != NULL)
+        {
+            LE_TEST(CheckPayload(rspMsgRef, seed + 1000));
+            le_msg_ReleaseMsg(rspMsgRef);
+        }
+    }
+
+    le_event_QueueFunction(SendAsyncRequests, sessionRef, NULL);
+
+    le_event_RunLoop();
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_INIT;
+
+    LE_INFO("======= Test 4: Large payloads through shared memory ========");
+
+    system("testFwMessaging-Setup");
+
+    ProtocolRef = le_msg_GetProtocolRef(PROTOCOL_ID_STR, PAYLOAD_SIZE);
+    le_msg_EnableSharedMemory(ProtocolRef, SHARED_MEM_THRESHOLD, SHARED_MEM_REGION_SIZE);
+
+    le_thread_Start(le_thread_Create("server", ServerThreadMain, NULL));
+    le_thread_Start(le_thread_Create("client", ClientThreadMain, NULL));
+}
@@ -0,0 +1,199 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Automated stress test for the Service Directory's lookups.
+ *
+ * Test 5:
+ *  - Server thread advertises hundreds of services (all bound to by this user, see
+ *    testFwMessaging-Setup).
+ *  - Client thread opens thousands of sessions, spread across all of those services, one after
+ *    the other.  Each session does one request-response transaction, to check that it got
+ *    connected to the right service, and is then deleted.
+ *  - Reports how long it took to open the sessions.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+
+#define SERVICE_INSTANCE_NAME_PREFIX "messagingTest5-"
+#define PROTOCOL_ID_STR "testFwMessaging5"
+
+// Must match the number of bindings configured by testFwMessaging-Setup.
+#define NUM_SERVICES 200
+
+#define NUM_SESSIONS 3000
+
+#define MAX_SERVICE_NAME_BYTES 32
+
+typedef struct
+{
+    uint32_t serviceIndex;  ///< Index of the service (filled in by the server).
+    uint32_t sessionIndex;  ///< Index of the session (filled in by the client).
+}
+Message_t;
+
+static le_msg_ProtocolRef_t ProtocolRef;
+
+// Posted by the server thread once all the services have been advertised.
+static le_sem_Ref_t ServicesReadySemRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the name of a service.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetServiceName
+(
+    uint32_t serviceIndex,
+    char* nameBuffPtr,
+    size_t nameBuffSize
+)
+{
+    LE_ASSERT(snprintf(nameBuffPtr, nameBuffSize, SERVICE_INSTANCE_NAME_PREFIX "%u", serviceIndex)
+              < nameBuffSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Computes the number of microseconds between two times.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+// ==================================
+//  SERVER
+// ==================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Responds to each request with the index of the service that received it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ServerRecvHandler
+(
+    le_msg_MessageRef_t msgRef,
+    void* contextPtr
+)
+{
+    Message_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    msgPtr->serviceIndex = (uint32_t)(size_t)contextPtr;
+
+    le_msg_Respond(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Server thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ServerThreadMain
+(
+    void* contextPtr
+)
+{
+    uint32_t i;
+
+    for (i = 0; i < NUM_SERVICES; i++)
+    {
+        char name[MAX_SERVICE_NAME_BYTES];
+        GetServiceName(i, name, sizeof(name));
+
+        le_msg_ServiceRef_t serviceRef = le_msg_CreateService(ProtocolRef, name);
+        le_msg_SetServiceRecvHandler(serviceRef, ServerRecvHandler, (void*)(size_t)i);
+        le_msg_AdvertiseService(serviceRef);
+    }
+
+    le_sem_Post(ServicesReadySemRef);
+
+    le_event_RunLoop();
+}
+
+
+// ==================================
+//  CLIENT
+// ==================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ClientThreadMain
+(
+    void* contextPtr
+)
+{
+    le_sem_Wait(ServicesReadySemRef);
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    uint32_t i;
+
+    for (i = 0; i < NUM_SESSIONS; i++)
+    {
+        // Step through the services with a stride, so consecutive sessions hit different ones.
+        uint32_t serviceIndex = (i * 7) % NUM_SERVICES;
+        char name[MAX_SERVICE_NAME_BYTES];
+        GetServiceName(serviceIndex, name, sizeof(name));
+
+        le_msg_SessionRef_t sessionRef = le_msg_CreateSession(ProtocolRef, name);
+        le_msg_OpenSessionSync(sessionRef);
+
+        le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionRef);
+        Message_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+        msgPtr->serviceIndex = UINT32_MAX;
+        msgPtr->sessionIndex = i;
+
+        le_msg_MessageRef_t rspMsgRef = le_msg_RequestSyncResponse(msgRef);
+        LE_TEST(rspMsgRef != NULL);
+        if (rspMsgRef != NULL)
+        {
+            msgPtr = le_msg_GetPayloadPtr(rspMsgRef);
+            LE_TEST(msgPtr->serviceIndex == serviceIndex);
+            LE_TEST(msgPtr->sessionIndex == i);
+            le_msg_ReleaseMsg(rspMsgRef);
+        }
+
+        le_msg_DeleteSession(sessionRef);
+    }
+
+    uint64_t usec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    LE_INFO("Opened %d sessions to %d services in %" PRIu64 " ms (%" PRIu64 " us per session).",
+            NUM_SESSIONS,
+            NUM_SERVICES,
+            usec / 1000,
+            usec / NUM_SESSIONS);
+
+    LE_TEST_EXIT;
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_INIT;
+
+    LE_INFO("======= Test 5: Thousands of sessions to hundreds of services ========");
+
+    system("testFwMessaging-Setup");
+
+    ProtocolRef = le_msg_GetProtocolRef(PROTOCOL_ID_STR, sizeof(Message_t));
+    ServicesReadySemRef = le_sem_Create("ServicesReady", 0);
+
+    le_thread_Start(le_thread_Create("server", ServerThreadMain, NULL));
+    le_thread_Start(le_thread_Create("client", ClientThreadMain, NULL));
+}
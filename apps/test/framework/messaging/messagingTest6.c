@@ -0,0 +1,171 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Automated unit test for the shared memory regions that the messaging system passes large
+ * payloads through.
+ *
+ * Test 6:
+ *  - Creates a region, maps it again as the receiving side would, and writes two payloads into it.
+ *  - Checks that descriptors that don't describe the next slot, or that point outside of it, are
+ *    rejected without disturbing the payloads that are still to be received.
+ *  - Checks that genuine descriptors are accepted once each, and that the payloads are copied out
+ *    intact.
+ *  - Passes many payloads through the region, so it wraps around several times.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "messagingSharedMem.h"
+
+#define REGION_SIZE (64 * 1024)
+
+#define FIRST_PAYLOAD_SIZE 1000
+#define SECOND_PAYLOAD_SIZE 3000
+
+#define NUM_WRAP_PAYLOADS 100
+#define WRAP_PAYLOAD_SIZE 5000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fills a buffer with a pattern that depends on a seed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillPattern
+(
+    uint8_t* bufPtr,
+    size_t size,
+    uint32_t seed
+)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        bufPtr[i] = (uint8_t)(seed + i);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that a buffer holds the pattern for a seed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckPattern
+(
+    const uint8_t* bufPtr,
+    size_t size,
+    uint32_t seed
+)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        if (bufPtr[i] != (uint8_t)(seed + i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+COMPONENT_INIT
+{
+    static uint8_t txBuf[WRAP_PAYLOAD_SIZE];
+    static uint8_t rxBuf[WRAP_PAYLOAD_SIZE];
+    msgShm_RegionRef_t txRef = NULL;
+    msgShm_RegionRef_t rxRef;
+    msgShm_Descriptor_t firstDesc;
+    msgShm_Descriptor_t secondDesc;
+    msgShm_Descriptor_t badDesc;
+    int i;
+
+    LE_TEST_INIT;
+
+    int fd = msgShm_CreateRegion(REGION_SIZE, &txRef);
+    LE_TEST(fd >= 0);
+    if (fd < 0)
+    {
+        LE_TEST_EXIT;
+    }
+
+    rxRef = msgShm_MapRegion(fd);
+    LE_TEST(rxRef != NULL);
+    if (rxRef == NULL)
+    {
+        LE_TEST_EXIT;
+    }
+
+    FillPattern(txBuf, FIRST_PAYLOAD_SIZE, 1);
+    LE_TEST(msgShm_Write(txRef, txBuf, FIRST_PAYLOAD_SIZE, &firstDesc));
+    FillPattern(txBuf, SECOND_PAYLOAD_SIZE, 2);
+    LE_TEST(msgShm_Write(txRef, txBuf, SECOND_PAYLOAD_SIZE, &secondDesc));
+
+    // The second slot can't be received before the first.
+    LE_TEST(msgShm_Read(rxRef, &secondDesc, rxBuf, sizeof(rxBuf)) == LE_FAULT);
+
+    // Pointing at a slot other than the one that ends at endPos.
+    badDesc = firstDesc;
+    badDesc.offset = secondDesc.offset;
+    LE_TEST(msgShm_Read(rxRef, &badDesc, rxBuf, sizeof(rxBuf)) == LE_FAULT);
+
+    // Payload bigger than its slot.
+    badDesc = firstDesc;
+    badDesc.size = FIRST_PAYLOAD_SIZE + 100;
+    LE_TEST(msgShm_Read(rxRef, &badDesc, rxBuf, sizeof(rxBuf)) == LE_FAULT);
+
+    // Offset past the end of the ring buffer.
+    badDesc = firstDesc;
+    badDesc.offset = REGION_SIZE;
+    LE_TEST(msgShm_Read(rxRef, &badDesc, rxBuf, sizeof(rxBuf)) == LE_FAULT);
+
+    // More than a ring buffer's worth ahead.
+    badDesc = firstDesc;
+    badDesc.endPos += 2 * REGION_SIZE;
+    LE_TEST(msgShm_Read(rxRef, &badDesc, rxBuf, sizeof(rxBuf)) == LE_FAULT);
+
+    // Empty payload.
+    badDesc = firstDesc;
+    badDesc.size = 0;
+    LE_TEST(msgShm_Read(rxRef, &badDesc, rxBuf, sizeof(rxBuf)) == LE_FAULT);
+
+    // Payload too big for the receiver's buffer.
+    LE_TEST(msgShm_Read(rxRef, &firstDesc, rxBuf, FIRST_PAYLOAD_SIZE - 1) == LE_FAULT);
+
+    // None of that got in the way of the genuine descriptors, which can only be used once.
+    memset(rxBuf, 0, sizeof(rxBuf));
+    LE_TEST(msgShm_Read(rxRef, &firstDesc, rxBuf, sizeof(rxBuf)) == LE_OK);
+    LE_TEST(CheckPattern(rxBuf, FIRST_PAYLOAD_SIZE, 1));
+    LE_TEST(msgShm_Read(rxRef, &firstDesc, rxBuf, sizeof(rxBuf)) == LE_FAULT);
+
+    memset(rxBuf, 0, sizeof(rxBuf));
+    LE_TEST(msgShm_Read(rxRef, &secondDesc, rxBuf, sizeof(rxBuf)) == LE_OK);
+    LE_TEST(CheckPattern(rxBuf, SECOND_PAYLOAD_SIZE, 2));
+
+    LE_TEST(msgShm_GetMsgCount(txRef) == 2);
+    LE_TEST(msgShm_GetMsgCount(rxRef) == 2);
+
+    // Each payload is received before the next is written, so the space is always given back in
+    // time, including when the end of the ring buffer has to be skipped.
+    for (i = 0; i < NUM_WRAP_PAYLOADS; i++)
+    {
+        msgShm_Descriptor_t desc;
+
+        FillPattern(txBuf, WRAP_PAYLOAD_SIZE, i);
+        LE_TEST(msgShm_Write(txRef, txBuf, WRAP_PAYLOAD_SIZE, &desc));
+
+        memset(rxBuf, 0, sizeof(rxBuf));
+        LE_TEST(msgShm_Read(rxRef, &desc, rxBuf, sizeof(rxBuf)) == LE_OK);
+        LE_TEST(CheckPattern(rxBuf, WRAP_PAYLOAD_SIZE, i));
+    }
+
+    le_mem_Release(rxRef);
+    le_mem_Release(txRef);
+
+    LE_TEST_EXIT;
+}
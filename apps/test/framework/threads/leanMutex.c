@@ -0,0 +1,160 @@
+// -------------------------------------------------------------------------------------------------
+// Implementation of the lean mutex tests.
+//
+// First checks recursion and try-lock behaviour of lean mutexes on the calling thread.  Then
+// starts a number of threads that all hammer on the same two lean mutexes (one recursive, locked
+// in a nested manner, and one non-recursive), each protecting its own counter.  The threads are
+// started with pthread_create() so that they have finished cleaning up their Legato thread data
+// when they signal completion.  If the mutexes work, no increments are lost.
+//
+// Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+// -------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "leanMutex.h"
+
+#define NUM_THREADS 8
+#define NUM_ITERATIONS 20000
+
+/// Counter protected by RecursiveMutexRef.
+static size_t RecursiveCounter = 0;
+
+/// Counter protected by NonRecursiveMutexRef.
+static size_t NonRecursiveCounter = 0;
+
+static le_mutex_Ref_t RecursiveMutexRef;
+static le_mutex_Ref_t NonRecursiveMutexRef;
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Checks locking behaviour that doesn't need other threads.
+ */
+// -------------------------------------------------------------------------------------------------
+static void CheckSingleThread
+(
+    void
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_mutex_Lock(RecursiveMutexRef);
+    LE_FATAL_IF(le_mutex_TryLock(RecursiveMutexRef) != LE_OK,
+                "**** FAILED - Couldn't re-lock a lean recursive mutex.");
+    le_mutex_Lock(RecursiveMutexRef);
+    le_mutex_Unlock(RecursiveMutexRef);
+    le_mutex_Unlock(RecursiveMutexRef);
+    le_mutex_Unlock(RecursiveMutexRef);
+
+    LE_FATAL_IF(le_mutex_TryLock(NonRecursiveMutexRef) != LE_OK,
+                "**** FAILED - Couldn't try-lock an unlocked lean mutex.");
+    LE_FATAL_IF(le_mutex_TryLock(NonRecursiveMutexRef) != LE_WOULD_BLOCK,
+                "**** FAILED - Try-locked a lean non-recursive mutex twice.");
+    le_mutex_Unlock(NonRecursiveMutexRef);
+
+    // A mutex that has been locked and unlocked must be deletable.
+    le_mutex_Ref_t mutexRef = le_mutex_CreateLeanNonRecursive("lean-mutex-delete");
+    le_mutex_Lock(mutexRef);
+    le_mutex_Unlock(mutexRef);
+    le_mutex_Delete(mutexRef);
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Function that gets run by all the threads.
+ *
+ * @return NULL.
+ */
+// -------------------------------------------------------------------------------------------------
+static void* ThreadMain
+(
+    void* completionObjPtr
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_thread_InitLegatoThreadData("leanMutexTest");
+
+    int i;
+
+    for (i = 0; i < NUM_ITERATIONS; i++)
+    {
+        le_mutex_Lock(RecursiveMutexRef);
+        le_mutex_Lock(RecursiveMutexRef);
+        RecursiveCounter++;
+        le_mutex_Unlock(RecursiveMutexRef);
+        le_mutex_Unlock(RecursiveMutexRef);
+
+        le_mutex_Lock(NonRecursiveMutexRef);
+        NonRecursiveCounter++;
+        le_mutex_Unlock(NonRecursiveMutexRef);
+    }
+
+    le_thread_CleanupLegatoThreadData();
+
+    le_mem_Release(completionObjPtr);   // Signal that I'm done.
+
+    return NULL;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Starts the lean mutex tests.
+ *
+ * Increments the reference count on a given memory pool object, then releases it when the test is
+ * complete.
+ */
+// -------------------------------------------------------------------------------------------------
+void lm_Start
+(
+    void* completionObjPtr  ///< [in] Pointer to the object whose reference count is used to signal
+                            ///       the completion of the test.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    RecursiveMutexRef = le_mutex_CreateLeanRecursive("lean-recursive-test");
+    NonRecursiveMutexRef = le_mutex_CreateLeanNonRecursive("lean-non-recursive-test");
+
+    CheckSingleThread();
+
+    int i;
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_t handle;
+
+        le_mem_AddRef(completionObjPtr);
+
+        int result = pthread_create(&handle, NULL, ThreadMain, completionObjPtr);
+        LE_FATAL_IF(result != 0, "pthread_create() failed with errno %m.");
+
+        pthread_detach(handle);
+    }
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Checks the completion status of the lean mutex tests.
+ */
+// -------------------------------------------------------------------------------------------------
+void lm_CheckResults
+(
+    void
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_mutex_Lock(RecursiveMutexRef);
+    le_mutex_Lock(NonRecursiveMutexRef);
+
+    if (   (RecursiveCounter != NUM_THREADS * NUM_ITERATIONS)
+        || (NonRecursiveCounter != NUM_THREADS * NUM_ITERATIONS))
+    {
+        LE_FATAL("**** FAILED - Counter values %zu and %zu should have been %d.",
+                 RecursiveCounter,
+                 NonRecursiveCounter,
+                 NUM_THREADS * NUM_ITERATIONS);
+    }
+
+    le_mutex_Unlock(NonRecursiveMutexRef);
+    le_mutex_Unlock(RecursiveMutexRef);
+}
@@ -0,0 +1,34 @@
+// -------------------------------------------------------------------------------------------------
+// Header file for lean mutex tests.  These functions are called by the main module (main.c).
+//
+// Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+// -------------------------------------------------------------------------------------------------
+
+#ifndef LE_LEAN_MUTEX_TEST_H_INCLUSION_GUARD
+#define LE_LEAN_MUTEX_TEST_H_INCLUSION_GUARD
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Starts the lean mutex tests.
+ *
+ * Increments the reference count on a given memory pool object, then releases it when the test is
+ * complete.
+ */
+// -------------------------------------------------------------------------------------------------
+void lm_Start
+(
+    void* objPtr    ///< [in] Pointer to the object whose reference count is used to signal
+                    ///       the completion of the test.
+);
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Checks the completion status of the lean mutex tests.
+ */
+// -------------------------------------------------------------------------------------------------
+void lm_CheckResults
+(
+    void
+);
+
+#endif // LE_LEAN_MUTEX_TEST_H_INCLUSION_GUARD
@@ -14,6 +14,8 @@
 
 #include "forkJoinMutex.h"
 #include "externalThreadApi.h"
+#include "leanMutex.h"
+#include "workQueue.h"
 
 const char TestNameStr[] = "Thread Test";
 
@@ -37,6 +39,8 @@ static void FinishTest
 
     fjm_CheckResults();
     eta_CheckResults();
+    lm_CheckResults();
+    wq_CheckResults();
 
     LE_INFO("======== MULTI-THREADING TESTS PASSED ========");
     exit(EXIT_SUCCESS);
@@ -62,5 +66,9 @@ COMPONENT_INIT
 
     eta_Start(objPtr);
 
+    lm_Start(objPtr);
+
+    wq_Start(objPtr);
+
     le_mem_Release(objPtr);
 }
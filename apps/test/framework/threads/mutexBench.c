@@ -0,0 +1,186 @@
+/**
+ * This program measures the cost of locking and unlocking a mutex shared by 1 to 8 threads, for
+ * normal mutexes, lean mutexes and plain pthreads mutexes (as a baseline).
+ *
+ * Each thread repeatedly locks the mutex, increments a shared counter and unlocks the mutex.
+ *
+ * Usage: mutexBench [numLocksPerThread]
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+
+
+// Numbers of threads to measure with.
+static const int NumThreads[] = { 1, 2, 4, 8 };
+
+// Default number of lock/unlock pairs done by each thread.
+#define DEFAULT_NUM_LOCKS 200000
+
+// Most threads used at once.
+#define MAX_THREADS 8
+
+
+// Kind of mutex being measured.
+typedef enum
+{
+    KIND_NORMAL,
+    KIND_LEAN,
+    KIND_PTHREAD
+}
+Kind_t;
+
+static const char* const KindNames[] = { "normal", "lean", "pthread" };
+
+static Kind_t Kind;
+static le_mutex_Ref_t MutexRef;
+static pthread_mutex_t PthreadMutex = PTHREAD_MUTEX_INITIALIZER;
+static size_t NumLocks = DEFAULT_NUM_LOCKS;
+static size_t Counter;
+
+// Posted once per thread when all the threads should start locking.
+static le_sem_Ref_t StartSemRef;
+
+// Posted by each thread when it is ready to start.
+static le_sem_Ref_t ReadySemRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of microseconds between two times.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lock, increment and unlock in a loop.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ThreadMain
+(
+    void* contextPtr
+)
+{
+    size_t i;
+
+    le_sem_Post(ReadySemRef);
+    le_sem_Wait(StartSemRef);
+
+    if (Kind == KIND_PTHREAD)
+    {
+        for (i = 0; i < NumLocks; i++)
+        {
+            pthread_mutex_lock(&PthreadMutex);
+            Counter++;
+            pthread_mutex_unlock(&PthreadMutex);
+        }
+    }
+    else
+    {
+        for (i = 0; i < NumLocks; i++)
+        {
+            le_mutex_Lock(MutexRef);
+            Counter++;
+            le_mutex_Unlock(MutexRef);
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the given number of threads against one kind of mutex and print the results.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunBenchmark
+(
+    Kind_t kind,
+    int numThreads
+)
+{
+    le_thread_Ref_t threads[MAX_THREADS];
+    int i;
+
+    Kind = kind;
+    Counter = 0;
+
+    if (kind == KIND_LEAN)
+    {
+        MutexRef = le_mutex_CreateLeanNonRecursive("bench");
+    }
+    else
+    {
+        MutexRef = le_mutex_CreateNonRecursive("bench");
+    }
+
+    for (i = 0; i < numThreads; i++)
+    {
+        threads[i] = le_thread_Create("bench", ThreadMain, NULL);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+    for (i = 0; i < numThreads; i++)
+    {
+        le_sem_Wait(ReadySemRef);
+    }
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < numThreads; i++)
+    {
+        le_sem_Post(StartSemRef);
+    }
+    for (i = 0; i < numThreads; i++)
+    {
+        LE_ASSERT(le_thread_Join(threads[i], NULL) == LE_OK);
+    }
+    uint64_t usec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    LE_ASSERT(Counter == numThreads * NumLocks);
+    le_mutex_Delete(MutexRef);
+
+    printf("%d threads, %-7s mutex: %8.1f ns per lock/unlock, %6.2f M lock/unlock per second\n",
+           numThreads,
+           KindNames[kind],
+           usec * 1000.0 / (numThreads * NumLocks),
+           (double)(numThreads * NumLocks) / usec);
+}
+
+
+COMPONENT_INIT
+{
+    size_t i;
+    Kind_t kind;
+
+    if (le_arg_NumArgs() > 0)
+    {
+        NumLocks = strtoul(le_arg_GetArg(0), NULL, 0);
+    }
+
+    StartSemRef = le_sem_Create("start", 0);
+    ReadySemRef = le_sem_Create("ready", 0);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(NumThreads); i++)
+    {
+        for (kind = KIND_NORMAL; kind <= KIND_PTHREAD; kind++)
+        {
+            RunBenchmark(kind, NumThreads[i]);
+        }
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,187 @@
+// -------------------------------------------------------------------------------------------------
+// Implementation of the work queue tests.
+//
+// First submits a batch of jobs without completion functions to a Work Queue and deletes it
+// straight away, checking that le_workQueue_Delete() waits for all of them to run.  Then submits
+// jobs with completion functions from the main thread.  Each of those jobs submits a few more
+// jobs from its worker thread, which go onto that worker's own deque and get stolen by the
+// others.  The completion functions must all be run by the main thread, and when the last one
+// has run, the Work Queue is deleted and every sub-job must have run too.
+//
+// Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+// -------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "workQueue.h"
+
+#define NUM_WORKERS 4
+#define NUM_JOBS 200
+#define NUM_SUB_JOBS 8
+
+/// Number of jobs run by the Work Queue that is deleted straight away.
+static size_t DeletedQueueJobCount = 0;
+
+/// Number of jobs (not including sub-jobs) run by the main Work Queue.
+static size_t JobCount = 0;
+
+/// Number of sub-jobs run by the main Work Queue.
+static size_t SubJobCount = 0;
+
+/// Number of completion functions run by the main thread.
+static size_t CompletionCount = 0;
+
+/// Set if a job or completion function ran in the wrong thread or got the wrong parameters.
+static bool Failed = false;
+
+static le_workQueue_Ref_t WorkQueueRef;
+static le_thread_Ref_t MainThreadRef;
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Job function that counts how many times it has been run.
+ */
+// -------------------------------------------------------------------------------------------------
+static void CountJob
+(
+    void* counterPtr,
+    void* unusedPtr
+)
+// -------------------------------------------------------------------------------------------------
+{
+    __atomic_add_fetch((size_t*)counterPtr, 1, __ATOMIC_RELAXED);
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Job function for the main Work Queue.  Submits some sub-jobs from the worker thread.
+ */
+// -------------------------------------------------------------------------------------------------
+static void MainJob
+(
+    void* completionObjPtr,
+    void* indexPtr
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (le_thread_GetCurrent() == MainThreadRef)
+    {
+        LE_ERROR("Job %zu ran in the main thread.", (size_t)indexPtr);
+        Failed = true;
+    }
+
+    int i;
+    for (i = 0; i < NUM_SUB_JOBS; i++)
+    {
+        le_workQueue_Submit(WorkQueueRef, CountJob, NULL, &SubJobCount, NULL);
+    }
+
+    __atomic_add_fetch(&JobCount, 1, __ATOMIC_RELAXED);
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Completion function for the main Work Queue's jobs.  When the last one has completed, deletes
+ * the Work Queue and signals that the test is done.
+ */
+// -------------------------------------------------------------------------------------------------
+static void MainJobDone
+(
+    void* completionObjPtr,
+    void* indexPtr
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (le_thread_GetCurrent() != MainThreadRef)
+    {
+        LE_ERROR("Completion of job %zu ran in thread '%s'.",
+                 (size_t)indexPtr,
+                 le_thread_GetMyName());
+        Failed = true;
+    }
+
+    if (++CompletionCount == NUM_JOBS)
+    {
+        le_workQueue_Delete(WorkQueueRef);
+
+        le_mem_Release(completionObjPtr);   // Signal that I'm done.
+    }
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Starts the work queue tests.
+ *
+ * Increments the reference count on a given memory pool object, then releases it when the test is
+ * complete.
+ */
+// -------------------------------------------------------------------------------------------------
+void wq_Start
+(
+    void* completionObjPtr  ///< [in] Pointer to the object whose reference count is used to signal
+                            ///       the completion of the test.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    MainThreadRef = le_thread_GetCurrent();
+
+    // Deleting a Work Queue must wait for the jobs that have been submitted to it.
+    le_workQueue_Ref_t queueRef = le_workQueue_Create("wqDeleteTest", 2);
+    LE_FATAL_IF(le_workQueue_GetNumWorkers(queueRef) != 2,
+                "**** FAILED - Work Queue has %zu workers.",
+                le_workQueue_GetNumWorkers(queueRef));
+
+    int i;
+    for (i = 0; i < NUM_JOBS; i++)
+    {
+        le_workQueue_Submit(queueRef, CountJob, NULL, &DeletedQueueJobCount, NULL);
+    }
+    le_workQueue_Delete(queueRef);
+
+    LE_FATAL_IF(DeletedQueueJobCount != NUM_JOBS,
+                "**** FAILED - Only %zu of %d jobs ran before the Work Queue was deleted.",
+                DeletedQueueJobCount,
+                NUM_JOBS);
+
+    // The rest of the test finishes in the completion functions.
+    WorkQueueRef = le_workQueue_Create("wqTest", NUM_WORKERS);
+
+    le_mem_AddRef(completionObjPtr);
+
+    for (i = 0; i < NUM_JOBS; i++)
+    {
+        le_workQueue_Submit(WorkQueueRef, MainJob, MainJobDone, completionObjPtr, (void*)(size_t)i);
+    }
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Checks the completion status of the work queue tests.
+ */
+// -------------------------------------------------------------------------------------------------
+void wq_CheckResults
+(
+    void
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_FATAL_IF(Failed, "**** FAILED - Work Queue ran a function in the wrong thread.");
+
+    if (   (JobCount != NUM_JOBS)
+        || (CompletionCount != NUM_JOBS)
+        || (SubJobCount != NUM_JOBS * NUM_SUB_JOBS))
+    {
+        LE_FATAL("**** FAILED - %zu jobs, %zu completions and %zu sub-jobs ran"
+                 " (expected %d, %d and %d).",
+                 JobCount,
+                 CompletionCount,
+                 SubJobCount,
+                 NUM_JOBS,
+                 NUM_JOBS,
+                 NUM_JOBS * NUM_SUB_JOBS);
+    }
+}
@@ -0,0 +1,34 @@
+// -------------------------------------------------------------------------------------------------
+// Header file for work queue tests.  These functions are called by the main module (main.c).
+//
+// Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+// -------------------------------------------------------------------------------------------------
+
+#ifndef LE_WORK_QUEUE_TEST_H_INCLUSION_GUARD
+#define LE_WORK_QUEUE_TEST_H_INCLUSION_GUARD
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Starts the work queue tests.
+ *
+ * Increments the reference count on a given memory pool object, then releases it when the test is
+ * complete.
+ */
+// -------------------------------------------------------------------------------------------------
+void wq_Start
+(
+    void* objPtr    ///< [in] Pointer to the object whose reference count is used to signal
+                    ///       the completion of the test.
+);
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Checks the completion status of the work queue tests.
+ */
+// -------------------------------------------------------------------------------------------------
+void wq_CheckResults
+(
+    void
+);
+
+#endif // LE_WORK_QUEUE_TEST_H_INCLUSION_GUARD
@@ -0,0 +1,199 @@
+/**
+ * This program measures how well a Work Queue's throughput scales with its number of workers
+ * (1 to 8), for CPU-bound jobs submitted from the main thread.
+ *
+ * Each job does a fixed amount of arithmetic.  Its completion function runs on the main thread's
+ * event loop, and the time is taken when the last one has run.  The same jobs are first run
+ * directly on the main thread, as a baseline.  Speed-ups are limited by the number of CPUs.
+ *
+ * Usage: workQueueBench [numJobs [numItersPerJob]]
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+
+
+// Numbers of workers to measure with.
+static const size_t NumWorkers[] = { 1, 2, 4, 8 };
+
+// Default number of jobs run for each number of workers.
+#define DEFAULT_NUM_JOBS 20000
+
+// Default number of loop iterations done by each job.
+#define DEFAULT_NUM_ITERS 20000
+
+
+static size_t NumJobs = DEFAULT_NUM_JOBS;
+static size_t NumIters = DEFAULT_NUM_ITERS;
+
+// Index into NumWorkers[] of the current run.
+static size_t RunIndex;
+
+static le_workQueue_Ref_t WorkQueueRef;
+static size_t CompletionCount;
+static le_clk_Time_t StartTime;
+
+// Time taken by the baseline run, in microseconds.
+static uint64_t BaselineUsec;
+
+// Job results are stored here so the compiler can't optimize the jobs away.
+static uint32_t* ResultsPtr;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of microseconds between two times.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the results for one run.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintResults
+(
+    const char* nameStr,
+    uint64_t usec
+)
+{
+    printf("%-10s: %8.1f us per job, %9.0f jobs per second, speed-up %5.2f\n",
+           nameStr,
+           (double)usec / NumJobs,
+           NumJobs * 1000000.0 / usec,
+           (double)BaselineUsec / usec);
+    fflush(stdout);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CPU-bound job: iterate a simple hash function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Job
+(
+    void* indexPtr,
+    void* unusedPtr
+)
+{
+    size_t index = (size_t)indexPtr;
+    uint32_t hash = (uint32_t)index;
+    size_t i;
+
+    for (i = 0; i < NumIters; i++)
+    {
+        hash = (hash ^ (uint32_t)i) * 16777619u;
+    }
+
+    ResultsPtr[index] = hash;
+}
+
+
+static void StartRun(void);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion function: when the last job of a run has completed, print the results and start
+ * the next run.
+ */
+//--------------------------------------------------------------------------------------------------
+static void JobDone
+(
+    void* indexPtr,
+    void* unusedPtr
+)
+{
+    char nameStr[32];
+
+    if (++CompletionCount < NumJobs)
+    {
+        return;
+    }
+
+    snprintf(nameStr, sizeof(nameStr), "%zu workers", NumWorkers[RunIndex]);
+    PrintResults(nameStr, ElapsedUsec(StartTime, le_clk_GetRelativeTime()));
+
+    le_workQueue_Delete(WorkQueueRef);
+
+    if (++RunIndex < NUM_ARRAY_MEMBERS(NumWorkers))
+    {
+        StartRun();
+    }
+    else
+    {
+        exit(EXIT_SUCCESS);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Work Queue with the next number of workers and submit all the jobs to it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartRun
+(
+    void
+)
+{
+    size_t i;
+
+    WorkQueueRef = le_workQueue_Create("bench", NumWorkers[RunIndex]);
+    CompletionCount = 0;
+
+    StartTime = le_clk_GetRelativeTime();
+
+    for (i = 0; i < NumJobs; i++)
+    {
+        le_workQueue_Submit(WorkQueueRef, Job, JobDone, (void*)i, NULL);
+    }
+}
+
+
+COMPONENT_INIT
+{
+    size_t i;
+
+    if (le_arg_NumArgs() > 0)
+    {
+        NumJobs = strtoul(le_arg_GetArg(0), NULL, 0);
+    }
+    if (le_arg_NumArgs() > 1)
+    {
+        NumIters = strtoul(le_arg_GetArg(1), NULL, 0);
+    }
+    LE_ASSERT(NumJobs > 0);
+
+    ResultsPtr = calloc(NumJobs, sizeof(uint32_t));
+    LE_ASSERT(ResultsPtr != NULL);
+
+    printf("%zu jobs of %zu iterations, %ld CPUs online\n",
+           NumJobs,
+           NumIters,
+           sysconf(_SC_NPROCESSORS_ONLN));
+
+    StartTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NumJobs; i++)
+    {
+        Job((void*)i, NULL);
+    }
+    BaselineUsec = ElapsedUsec(StartTime, le_clk_GetRelativeTime());
+    PrintResults("inline", BaselineUsec);
+
+    StartRun();
+}
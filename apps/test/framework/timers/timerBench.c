@@ -0,0 +1,125 @@
+/**
+ * This program measures how the cost of starting and restarting timers scales with the number of
+ * timers that are running on a thread.
+ *
+ * Usage: timerBench [numTimers ...]
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+
+#include "legato.h"
+
+
+// Default numbers of running timers to measure with.
+static const size_t DefaultNumTimers[] = { 10000, 30000, 100000 };
+
+// Number of times each timer is restarted while all the timers are running.
+#define NUM_RESTARTS 4
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of microseconds between two times.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUsec
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start, restart and stop the given number of timers, printing how long each phase took.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunBenchmark
+(
+    size_t numTimers
+)
+{
+    le_timer_Ref_t* timersPtr = malloc(numTimers * sizeof(le_timer_Ref_t));
+    LE_ASSERT(timersPtr != NULL);
+
+    size_t i;
+    int pass;
+
+    // Use long, randomly spread intervals (like per-session keepalives) so none of the timers
+    // expire while the benchmark is running.
+    for (i = 0; i < numTimers; i++)
+    {
+        le_clk_Time_t interval = { 1000 + (rand() % 1000), rand() % 1000000 };
+
+        timersPtr[i] = le_timer_Create("bench");
+        LE_ASSERT(le_timer_SetInterval(timersPtr[i], interval) == LE_OK);
+    }
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < numTimers; i++)
+    {
+        LE_ASSERT(le_timer_Start(timersPtr[i]) == LE_OK);
+    }
+    uint64_t startUsec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    startTime = le_clk_GetRelativeTime();
+    for (pass = 0; pass < NUM_RESTARTS; pass++)
+    {
+        for (i = 0; i < numTimers; i++)
+        {
+            le_timer_Restart(timersPtr[(i * 7919) % numTimers]);
+        }
+    }
+    uint64_t restartUsec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < numTimers; i++)
+    {
+        LE_ASSERT(le_timer_Stop(timersPtr[i]) == LE_OK);
+    }
+    uint64_t stopUsec = ElapsedUsec(startTime, le_clk_GetRelativeTime());
+
+    for (i = 0; i < numTimers; i++)
+    {
+        le_timer_Delete(timersPtr[i]);
+    }
+    free(timersPtr);
+
+    printf("%8zu timers: start %8.3f us/timer, restart %8.3f us/timer, stop %8.3f us/timer\n",
+           numTimers,
+           (double)startUsec / numTimers,
+           (double)restartUsec / (numTimers * NUM_RESTARTS),
+           (double)stopUsec / numTimers);
+}
+
+
+COMPONENT_INIT
+{
+    size_t numArgs = le_arg_NumArgs();
+    size_t i;
+
+    srand(1);
+
+    if (numArgs == 0)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(DefaultNumTimers); i++)
+        {
+            RunBenchmark(DefaultNumTimers[i]);
+        }
+    }
+    else
+    {
+        for (i = 0; i < numArgs; i++)
+        {
+            RunBenchmark(strtoul(le_arg_GetArg(i), NULL, 0));
+        }
+    }
+
+    exit(EXIT_SUCCESS);
+}
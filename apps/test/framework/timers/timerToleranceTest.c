@@ -0,0 +1,188 @@
+/**
+ * Automated test of timer tolerances.
+ *
+ *  - Runs a set of repeating timers with different intervals for a while, first with no
+ *    tolerance and then with a tolerance, checking that every expiry is handled no earlier than
+ *    it is due and no later than its tolerance allows.
+ *  - Checks that the tolerances make the thread wake up less often, and that the wakeup stats
+ *    account for the wakeups that were saved.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#include "legato.h"
+
+// Number is usec ticks for one msec
+#define ONE_MSEC 1000
+
+#define NUM_TIMERS 8
+
+// The timers' intervals are spread out from this, so they rarely expire at the same time.
+#define BASE_INTERVAL_MSEC  40
+#define INTERVAL_STEP_MSEC  7
+
+#define TOLERANCE_MSEC      50
+
+// How long each run lasts.
+#define RUN_MSEC            2000
+
+// How late the expiry handler can be called, on top of the timer's tolerance, because of
+// scheduling delays (see timerTest.c).
+#define LATENESS_MSEC       11
+
+static le_timer_Ref_t Timers[NUM_TIMERS];
+static le_timer_Ref_t EndTimer;
+
+// Tolerance of the current run, in msec.
+static size_t ToleranceMsec;
+
+static le_clk_Time_t StartTime;
+static le_timer_WakeupStats_t StartStats;
+
+static int NumExpiries;
+static int NumEarly;
+static int NumLate;
+
+// Wakeups used by the run without tolerance.
+static uint64_t NumExactWakeups;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a timer expired when it was due, within its tolerance.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TimerExpiryHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    size_t index = (size_t)le_timer_GetContextPtr(timerRef);
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+
+    // StartTime was taken before the timer was started, so it can only seem late, not early.
+    int64_t dueUsec = (int64_t)le_timer_GetExpiryCount(timerRef) *
+                      (BASE_INTERVAL_MSEC + (index * INTERVAL_STEP_MSEC)) * ONE_MSEC;
+    int64_t elapsedUsec = ((int64_t)elapsed.sec * 1000000) + elapsed.usec;
+
+    NumExpiries++;
+
+    if (elapsedUsec < dueUsec)
+    {
+        LE_ERROR("Timer %zu expired %" PRId64 " usec early", index, dueUsec - elapsedUsec);
+        NumEarly++;
+    }
+    else if (elapsedUsec > dueUsec + ((ToleranceMsec + LATENESS_MSEC) * ONE_MSEC))
+    {
+        LE_ERROR("Timer %zu expired %" PRId64 " usec late", index, elapsedUsec - dueUsec);
+        NumLate++;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a run of the timers with the given tolerance.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartRun
+(
+    size_t toleranceMsec
+)
+{
+    size_t i;
+
+    ToleranceMsec = toleranceMsec;
+    NumExpiries = 0;
+    NumEarly = 0;
+    NumLate = 0;
+
+    for (i = 0; i < NUM_TIMERS; i++)
+    {
+        LE_TEST(le_timer_SetMsTolerance(Timers[i], toleranceMsec) == LE_OK);
+    }
+
+    le_timer_GetWakeupStats(&StartStats);
+    StartTime = le_clk_GetRelativeTime();
+
+    for (i = 0; i < NUM_TIMERS; i++)
+    {
+        LE_ASSERT(le_timer_Start(Timers[i]) == LE_OK);
+    }
+    LE_ASSERT(le_timer_Start(EndTimer) == LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop the timers at the end of a run and check the results.  After the run without tolerance,
+ * start the run with tolerance.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndTimerExpiryHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    le_timer_WakeupStats_t stats;
+    size_t i;
+
+    for (i = 0; i < NUM_TIMERS; i++)
+    {
+        LE_ASSERT(le_timer_Stop(Timers[i]) == LE_OK);
+    }
+
+    le_timer_GetWakeupStats(&stats);
+    uint64_t numWakeups = stats.numWakeups - StartStats.numWakeups;
+    uint64_t numSaved = stats.numWakeupsSaved - StartStats.numWakeupsSaved;
+
+    LE_INFO("Tolerance %zu ms: %d expiries in %" PRIu64 " wakeups (%" PRIu64 " saved),"
+            " %d early, %d late",
+            ToleranceMsec, NumExpiries, numWakeups, numSaved, NumEarly, NumLate);
+
+    LE_TEST(NumExpiries > 0);
+    LE_TEST(NumEarly == 0);
+    LE_TEST(NumLate == 0);
+
+    if (ToleranceMsec == 0)
+    {
+        NumExactWakeups = numWakeups;
+        StartRun(TOLERANCE_MSEC);
+    }
+    else
+    {
+        LE_TEST(numSaved > 0);
+        LE_TEST(numWakeups < NumExactWakeups);
+
+        LE_TEST_EXIT;
+    }
+}
+
+
+COMPONENT_INIT
+{
+    size_t i;
+
+    LE_TEST_INIT;
+
+    LE_INFO("======= Test: timer tolerance ========");
+
+    for (i = 0; i < NUM_TIMERS; i++)
+    {
+        Timers[i] = le_timer_Create("tolerance");
+        LE_ASSERT(le_timer_SetMsInterval(Timers[i],
+                                         BASE_INTERVAL_MSEC + (i * INTERVAL_STEP_MSEC)) == LE_OK);
+        LE_ASSERT(le_timer_SetRepeat(Timers[i], 0) == LE_OK);
+        LE_ASSERT(le_timer_SetContextPtr(Timers[i], (void*)i) == LE_OK);
+        LE_ASSERT(le_timer_SetHandler(Timers[i], TimerExpiryHandler) == LE_OK);
+    }
+
+    EndTimer = le_timer_Create("end");
+    LE_ASSERT(le_timer_SetMsInterval(EndTimer, RUN_MSEC) == LE_OK);
+    LE_ASSERT(le_timer_SetHandler(EndTimer, EndTimerExpiryHandler) == LE_OK);
+
+    StartRun(0);
+
+    // The tolerance can't be changed while the timer is running.
+    LE_TEST(le_timer_SetMsTolerance(Timers[0], TOLERANCE_MSEC) == LE_BUSY);
+}
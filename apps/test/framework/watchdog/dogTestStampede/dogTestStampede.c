@@ -0,0 +1,180 @@
+#include "legato.h"
+#include "interfaces.h"
+
+/*
+ * This watchdog test is a stampede: the first process starts hundreds of copies of itself, each
+ * of which is a separate watchdog client that kicks every 50 to 250 ms for 10 seconds, alternating
+ * le_wdog_Kick() and le_wdog_Timeout().  This is a stress test of how the watchdog behaves when it
+ * has to keep track of many watchdogs at once.
+ *
+ * The first copy is a straggler: half way through it stops kicking, and its watchdog must time
+ * out.  None of the others may time out.  The pack members aren't known to the supervisor, so
+ * nothing is done to them when they time out.
+ *
+ * The test takes 1 argument.
+ *
+ *      numClients      How many copies to start
+ *
+ * The copies are started with the arguments "member <index>".
+ */
+
+#define TEST_DURATION_MS    10000
+#define PACK_TIMEOUT_MS     1000
+#define MIN_KICK_PERIOD_MS  50
+#define MAX_KICK_PERIOD_MS  250
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of milliseconds since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t MsSince
+(
+    le_clk_Time_t startTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return ((uint64_t)diff.sec * 1000) + (diff.usec / 1000);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kick the watchdog until the end of the test (or half way through, for the straggler).
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunPackMember
+(
+    int index
+)
+{
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    uint64_t maxKickUsec = 0;
+    uint64_t totalKickUsec = 0;
+    int numKicks = 0;
+    bool isStraggler = (index == 0);
+
+    srand(getpid());
+
+    while (MsSince(startTime) < TEST_DURATION_MS)
+    {
+        if (isStraggler && (MsSince(startTime) >= TEST_DURATION_MS / 2))
+        {
+            LE_INFO("Straggler stopped kicking, expecting a timeout in %d ms", PACK_TIMEOUT_MS);
+            usleep((TEST_DURATION_MS / 2) * 1000);
+            break;
+        }
+
+        le_clk_Time_t kickTime = le_clk_GetRelativeTime();
+        if (numKicks % 2 == 0)
+        {
+            le_wdog_Timeout(PACK_TIMEOUT_MS);
+        }
+        else
+        {
+            le_wdog_Kick();
+        }
+        le_clk_Time_t kickDuration = le_clk_Sub(le_clk_GetRelativeTime(), kickTime);
+        uint64_t kickUsec = ((uint64_t)kickDuration.sec * 1000000) + kickDuration.usec;
+
+        totalKickUsec += kickUsec;
+        if (kickUsec > maxKickUsec)
+        {
+            maxKickUsec = kickUsec;
+        }
+        numKicks++;
+
+        int periodMs = MIN_KICK_PERIOD_MS + (rand() % (MAX_KICK_PERIOD_MS - MIN_KICK_PERIOD_MS));
+        usleep(periodMs * 1000);
+    }
+
+    LE_INFO("Member %d: %d kicks, average %" PRIu64 " usec, max %" PRIu64 " usec",
+            index,
+            numKicks,
+            (numKicks > 0) ? (totalKickUsec / numKicks) : 0,
+            maxKickUsec);
+
+    // Don't leave the watchdog running on the way out.
+    le_wdog_Timeout(LE_WDOG_TIMEOUT_NEVER);
+
+    exit(EXIT_SUCCESS);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the pack and wait for all the members to finish.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunStampede
+(
+    int numClients
+)
+{
+    int i;
+    int numFailed = 0;
+
+    LE_INFO("Starting %d watchdog clients", numClients);
+
+    for (i = 0; i < numClients; i++)
+    {
+        char indexStr[16];
+        snprintf(indexStr, sizeof(indexStr), "%d", i);
+
+        pid_t pid = fork();
+        LE_FATAL_IF(pid == -1, "Failed to fork (%m).");
+
+        if (pid == 0)
+        {
+            execl("/proc/self/exe", le_arg_GetProgramName(), "member", indexStr, (char*)NULL);
+            LE_FATAL("Failed to execute pack member (%m).");
+        }
+    }
+
+    for (i = 0; i < numClients; i++)
+    {
+        int status;
+        pid_t pid = wait(&status);
+        LE_FATAL_IF(pid == -1, "Failed to wait for pack member (%m).");
+
+        if (!WIFEXITED(status) || (WEXITSTATUS(status) != EXIT_SUCCESS))
+        {
+            LE_ERROR("Pack member with pid %d failed (status 0x%x)", pid, status);
+            numFailed++;
+        }
+    }
+
+    if (numFailed == 0)
+    {
+        LE_INFO("PASS");
+    }
+    else
+    {
+        LE_INFO("FAIL: %d pack members failed", numFailed);
+    }
+}
+
+
+COMPONENT_INIT
+{
+    LE_INFO("Watchdog test starting");
+
+    if ((le_arg_NumArgs() == 2) && (strcmp(le_arg_GetArg(0), "member") == 0))
+    {
+        RunPackMember(atoi(le_arg_GetArg(1)));
+    }
+    else
+    {
+        LE_ASSERT(le_arg_NumArgs() == 1);
+
+        // This process is a watchdog client too (the connection is made before we get here), so
+        // keep it from timing out while it waits.
+        le_wdog_Timeout(LE_WDOG_TIMEOUT_NEVER);
+
+        RunStampede(atoi(le_arg_GetArg(0)));
+    }
+
+    exit(EXIT_SUCCESS);
+}
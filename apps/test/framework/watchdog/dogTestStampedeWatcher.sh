@@ -0,0 +1,67 @@
+# dogTestStampedeWatcher
+# This script watches the output of the dogTestStampede.
+# dogTestStampede starts hundreds of watchdog clients which all kick frequently. One of them, the
+# straggler, stops kicking half way through. The test is successful if the straggler's watchdog
+# times out, no other client's watchdog times out, and all of the clients finish.
+# (Due to the granularity of 'date' I leave a second of slack in the comparisons)
+
+TEST_NAME='dogTestStampede'
+
+# Pack members log with their own pids, so match the timeouts on the app's processes by name.
+match_straggler="dogTestStampede\[([0-9]*)\].*Straggler stopped kicking"
+match_timeout="proc ([0-9]*) timed out"
+match_pass="dogTestStampede\[.*\| PASS"
+match_fail="dogTestStampede\[.*\| FAIL"
+
+straggler_pid='XXXXXXXXXXX'
+straggler_time=0
+straggler_timed_out='false'
+
+# Pids of all the clients that have logged, so only their timeouts are counted.
+declare -A member_pids
+
+while read line
+do
+if [[ $line =~ dogTestStampede\[([0-9]*)\] ]]; then
+    member_pids[${BASH_REMATCH[1]}]=1
+fi
+
+if [[ $line =~ $match_straggler ]]; then
+    echo "---$line"
+    straggler_pid=${BASH_REMATCH[1]}
+    straggler_time=$(date +%s)
+fi
+
+if [[ $line =~ $match_timeout ]]; then
+    timeout_pid=${BASH_REMATCH[1]}
+    if [[ $timeout_pid == $straggler_pid ]]; then
+        echo "---$line"
+        if [[ $(($(date +%s)-$straggler_time)) -gt 2 ]]; then
+            echo "--FAIL: straggler timed out late"
+            exit 1
+        fi
+        straggler_timed_out='true'
+    elif [[ ${member_pids[$timeout_pid]} == 1 ]]; then
+        echo "---$line"
+        echo "--FAIL: a client that kept kicking timed out"
+        exit 1
+    fi
+fi
+
+if [[ $line =~ $match_fail ]]; then
+    echo "---$line"
+    echo "--FAIL"
+    exit 1
+fi
+
+if [[ $line =~ $match_pass ]]; then
+    echo "---$line"
+    if [[ $straggler_timed_out == 'true' ]]; then
+        echo "--PASS"
+        exit 0
+    else
+        echo "--FAIL: straggler didn't time out"
+        exit 1
+    fi
+fi
+done
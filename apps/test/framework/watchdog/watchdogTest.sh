@@ -240,6 +240,10 @@ set_test_message dogTestRevertAfterTimeout "Test if watchdog reverts to regular
 launch dogTestRevertAfterTimeout dogTestRevertAfterTimeoutWatcher.sh 120
 sleep 2
 
+set_test_message dogTestStampede "Test that only the straggler times out among hundreds of kicking clients"
+launch dogTestStampede dogTestStampedeWatcher.sh 60
+sleep 2
+
 wait_for_results
 
 cleanup
@@ -497,6 +497,9 @@ TestAHandlerRef_t AddTestAHandler
     _UNLOCK
     _msgBufPtr = PackData( _msgBufPtr, &contextPtr, sizeof(void*) );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
@@ -569,6 +572,9 @@ void RemoveTestAHandler
     le_mem_Release(clientDataPtr);
     _msgBufPtr = PackData( _msgBufPtr, &addHandlerRef, sizeof(TestAHandlerRef_t) );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
@@ -666,6 +672,9 @@ void allParameters
     _msgBufPtr = PackData( _msgBufPtr, &responseNumElements, sizeof(size_t) );
     _msgBufPtr = PackData( _msgBufPtr, &moreNumElements, sizeof(size_t) );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
@@ -727,6 +736,9 @@ void FileTest
     // Pack the input parameters
     le_msg_SetFd(_msgRef, dataFile);
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
@@ -779,6 +791,9 @@ void TriggerTestA
     // Pack the input parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
@@ -901,6 +916,9 @@ BugTestHandlerRef_t AddBugTestHandler
     _UNLOCK
     _msgBufPtr = PackData( _msgBufPtr, &contextPtr, sizeof(void*) );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
@@ -973,6 +991,9 @@ void RemoveBugTestHandler
     le_mem_Release(clientDataPtr);
     _msgBufPtr = PackData( _msgBufPtr, &addHandlerRef, sizeof(BugTestHandlerRef_t) );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
@@ -1111,6 +1132,9 @@ int32_t TestCallback
     _UNLOCK
     _msgBufPtr = PackData( _msgBufPtr, &contextPtr, sizeof(void*) );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
@@ -1167,6 +1191,9 @@ void TriggerCallbackTest
     // Pack the input parameters
     _msgBufPtr = PackData( _msgBufPtr, &data, sizeof(uint32_t) );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
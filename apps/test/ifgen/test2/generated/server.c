@@ -391,6 +391,9 @@ static void AsyncResponse_AddTestAHandler
     // Pack the input parameters
     _msgBufPtr = PackData( _msgBufPtr, &x, sizeof(int32_t) );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send the async response to the client
     LE_DEBUG("Sending message to client session %p : %ti bytes sent",
              serverDataPtr->clientSessionRef,
@@ -453,6 +456,9 @@ static void Handle_AddTestAHandler
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -507,6 +513,9 @@ static void Handle_RemoveTestAHandler
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -577,6 +586,9 @@ static void Handle_allParameters
     _msgBufPtr = PackString( _msgBufPtr, response );
     _msgBufPtr = PackString( _msgBufPtr, more );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -616,6 +628,9 @@ static void Handle_FileTest
     // Pack any "out" parameters
     le_msg_SetFd(_msgRef, dataOut);
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -654,6 +669,9 @@ static void Handle_TriggerTestA
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -687,6 +705,9 @@ static void AsyncResponse_AddBugTestHandler
     // Pack the input parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send the async response to the client
     LE_DEBUG("Sending message to client session %p : %ti bytes sent",
              serverDataPtr->clientSessionRef,
@@ -752,6 +773,9 @@ static void Handle_AddBugTestHandler
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -806,6 +830,9 @@ static void Handle_RemoveBugTestHandler
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -850,6 +877,9 @@ static void AsyncResponse_TestCallback
     _msgBufPtr = PackString( _msgBufPtr, name );
     le_msg_SetFd(_msgRef, dataFile);
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send the async response to the client
     LE_DEBUG("Sending message to client session %p : %ti bytes sent",
              serverDataPtr->clientSessionRef,
@@ -917,6 +947,9 @@ static void Handle_TestCallback
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -956,6 +989,9 @@ static void Handle_TriggerCallbackTest
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
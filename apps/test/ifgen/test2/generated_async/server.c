@@ -391,6 +391,9 @@ static void AsyncResponse_AddTestAHandler
     // Pack the input parameters
     _msgBufPtr = PackData( _msgBufPtr, &x, sizeof(int32_t) );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send the async response to the client
     LE_DEBUG("Sending message to client session %p : %ti bytes sent",
              serverDataPtr->clientSessionRef,
@@ -453,6 +456,9 @@ static void Handle_AddTestAHandler
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -507,6 +513,9 @@ static void Handle_RemoveTestAHandler
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -551,6 +560,9 @@ void allParametersRespond
     _msgBufPtr = PackString( _msgBufPtr, response );
     _msgBufPtr = PackString( _msgBufPtr, more );
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Return the response
     LE_DEBUG("Sending response to client session %p", le_msg_GetSession(_msgRef));
     le_msg_Respond(_msgRef);
@@ -624,6 +636,9 @@ void FileTestRespond
     // Pack any "out" parameters
     le_msg_SetFd(_msgRef, dataOut);
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Return the response
     LE_DEBUG("Sending response to client session %p", le_msg_GetSession(_msgRef));
     le_msg_Respond(_msgRef);
@@ -673,6 +688,9 @@ void TriggerTestARespond
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Return the response
     LE_DEBUG("Sending response to client session %p", le_msg_GetSession(_msgRef));
     le_msg_Respond(_msgRef);
@@ -719,6 +737,9 @@ static void AsyncResponse_AddBugTestHandler
     // Pack the input parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send the async response to the client
     LE_DEBUG("Sending message to client session %p : %ti bytes sent",
              serverDataPtr->clientSessionRef,
@@ -784,6 +805,9 @@ static void Handle_AddBugTestHandler
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -838,6 +862,9 @@ static void Handle_RemoveBugTestHandler
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -882,6 +909,9 @@ static void AsyncResponse_TestCallback
     _msgBufPtr = PackString( _msgBufPtr, name );
     le_msg_SetFd(_msgRef, dataFile);
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send the async response to the client
     LE_DEBUG("Sending message to client session %p : %ti bytes sent",
              serverDataPtr->clientSessionRef,
@@ -949,6 +979,9 @@ static void Handle_TestCallback
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -984,6 +1017,9 @@ void TriggerCallbackTestRespond
     // Pack any "out" parameters
 
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Return the response
     LE_DEBUG("Sending response to client session %p", le_msg_GetSession(_msgRef));
     le_msg_Respond(_msgRef);
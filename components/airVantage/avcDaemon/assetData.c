@@ -101,6 +101,33 @@ typedef struct assetData_AssetData
 AssetData_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key for looking up an instance by id within its asset (InstanceMap), or a field by id within its
+ * instance (FieldMap).
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const void* ownerPtr;        ///< Asset containing the instance, or instance containing the field
+    int id;                      ///< Instance id or field id
+}
+IdKey_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key for looking up a field by name within its instance (FieldMapByName).
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const void* ownerPtr;        ///< Instance containing the field
+    const char* namePtr;         ///< Field name
+}
+NameKey_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Data contained in a single asset instance
@@ -112,6 +139,7 @@ typedef struct le_avdata_AssetInstance
     AssetData_t* assetDataPtr;   ///< Back reference to asset data containing this instance
     le_dls_List_t fieldList;     ///< List of fields for this instance
     le_dls_Link_t link;          ///< For adding to the asset instance list
+    IdKey_t key;                 ///< Key in InstanceMap
 }
 InstanceData_t;
 
@@ -136,6 +164,8 @@ typedef struct
     };
 
     le_dls_Link_t link;          ///< For adding to the field list
+    IdKey_t idKey;               ///< Key in FieldMap
+    NameKey_t nameKey;           ///< Key in FieldMapByName
 }
 FieldData_t;
 
@@ -248,6 +278,30 @@ static le_hashmap_Ref_t AssetMap = NULL;
 static le_hashmap_Ref_t AssetMapByName = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps (asset, instanceId) to an instance of that asset.  Initialized in assetData_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t InstanceMap = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps (instance, fieldId) to a field of that instance.  Initialized in assetData_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t FieldMap = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps (instance, field name) to a field of that instance.  Initialized in assetData_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t FieldMapByName = NULL;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Table mapping data type strings to DataType_t values
@@ -315,6 +369,76 @@ le_result_t FormatString
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash an IdKey_t, for InstanceMap and FieldMap.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HashIdKey
+(
+    const void* keyPtr
+)
+{
+    const IdKey_t* idKeyPtr = keyPtr;
+
+    return ( ((size_t)idKeyPtr->ownerPtr >> 3) * 31 ) + (size_t)idKeyPtr->id;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare two IdKey_t, for InstanceMap and FieldMap.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EqualsIdKey
+(
+    const void* firstKeyPtr,
+    const void* secondKeyPtr
+)
+{
+    const IdKey_t* firstPtr = firstKeyPtr;
+    const IdKey_t* secondPtr = secondKeyPtr;
+
+    return ( firstPtr->ownerPtr == secondPtr->ownerPtr ) && ( firstPtr->id == secondPtr->id );
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash a NameKey_t, for FieldMapByName.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HashNameKey
+(
+    const void* keyPtr
+)
+{
+    const NameKey_t* nameKeyPtr = keyPtr;
+
+    return ( ((size_t)nameKeyPtr->ownerPtr >> 3) * 31 ) +
+           le_hashmap_HashString(nameKeyPtr->namePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare two NameKey_t, for FieldMapByName.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EqualsNameKey
+(
+    const void* firstKeyPtr,
+    const void* secondKeyPtr
+)
+{
+    const NameKey_t* firstPtr = firstKeyPtr;
+    const NameKey_t* secondPtr = secondKeyPtr;
+
+    return ( firstPtr->ownerPtr == secondPtr->ownerPtr ) &&
+           ( strcmp(firstPtr->namePtr, secondPtr->namePtr) == 0 );
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Convert data type string into enumerated type
@@ -976,28 +1100,18 @@ static le_result_t GetInstanceFromAssetData
     InstanceData_t** instanceDataPtrPtr   ///< [OUT]
 )
 {
-    InstanceData_t* assetInstancePtr;
-    le_dls_Link_t* linkPtr;
+    IdKey_t key = { .ownerPtr = assetDataPtr, .id = instanceId };
 
-    // Get the start of the instance list
-    linkPtr = le_dls_Peek(&assetDataPtr->instanceList);
+    *instanceDataPtrPtr = le_hashmap_Get(InstanceMap, &key);
 
-    // Loop through the asset instances
-    while ( linkPtr != NULL )
+    if ( *instanceDataPtrPtr != NULL )
     {
-        assetInstancePtr = CONTAINER_OF(linkPtr, InstanceData_t, link);
-        //LE_PRINT_VALUE("%i", assetInstancePtr->instanceId);
-
-        if ( assetInstancePtr->instanceId == instanceId )
-        {
-            *instanceDataPtrPtr = assetInstancePtr;
-            return LE_OK;
-        }
-
-        linkPtr = le_dls_PeekNext(&assetDataPtr->instanceList, linkPtr);
+        return LE_OK;
+    }
+    else
+    {
+        return LE_NOT_FOUND;
     }
-
-    return LE_NOT_FOUND;
 }
 
 
@@ -1016,29 +1130,60 @@ static le_result_t GetFieldFromInstance
     int fieldId,
     FieldData_t** fieldDataPtrPtr   ///< [OUT]
 )
+{
+    IdKey_t key = { .ownerPtr = instanceDataPtr, .id = fieldId };
+
+    *fieldDataPtrPtr = le_hashmap_Get(FieldMap, &key);
+
+    if ( *fieldDataPtrPtr != NULL )
+    {
+        return LE_OK;
+    }
+    else
+    {
+        return LE_NOT_FOUND;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an instance, and all of its fields, to the lookup maps.  Must be called once the instance
+ * id is set and the field list is complete.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddInstanceToMaps
+(
+    InstanceData_t* instanceDataPtr
+)
 {
     FieldData_t* fieldDataPtr;
-    le_dls_Link_t* fieldLinkPtr;
+    le_dls_Link_t* linkPtr;
 
-    // Get the start of the field list
-    fieldLinkPtr = le_dls_Peek(&instanceDataPtr->fieldList);
+    instanceDataPtr->key.ownerPtr = instanceDataPtr->assetDataPtr;
+    instanceDataPtr->key.id = instanceDataPtr->instanceId;
+    le_hashmap_Put(InstanceMap, &instanceDataPtr->key, instanceDataPtr);
 
-    // Loop through the fields
-    while ( fieldLinkPtr != NULL )
+    linkPtr = le_dls_Peek(&instanceDataPtr->fieldList);
+    while ( linkPtr != NULL )
     {
-        fieldDataPtr = CONTAINER_OF(fieldLinkPtr, FieldData_t, link);
-        //LE_PRINT_VALUE("%i", fieldDataPtr->fieldId);
+        fieldDataPtr = CONTAINER_OF(linkPtr, FieldData_t, link);
 
-        if ( fieldDataPtr->fieldId == fieldId )
+        fieldDataPtr->idKey.ownerPtr = instanceDataPtr;
+        fieldDataPtr->idKey.id = fieldDataPtr->fieldId;
+        le_hashmap_Put(FieldMap, &fieldDataPtr->idKey, fieldDataPtr);
+
+        // If a model has more than one field with the same name, the first one is found by name,
+        // as it was when the field list was searched.
+        fieldDataPtr->nameKey.ownerPtr = instanceDataPtr;
+        fieldDataPtr->nameKey.namePtr = fieldDataPtr->name;
+        if ( ! le_hashmap_ContainsKey(FieldMapByName, &fieldDataPtr->nameKey) )
         {
-            *fieldDataPtrPtr = fieldDataPtr;
-            return LE_OK;
+            le_hashmap_Put(FieldMapByName, &fieldDataPtr->nameKey, fieldDataPtr);
         }
 
-        fieldLinkPtr = le_dls_PeekNext(&instanceDataPtr->fieldList, fieldLinkPtr);
+        linkPtr = le_dls_PeekNext(&instanceDataPtr->fieldList, linkPtr);
     }
-
-    return LE_NOT_FOUND;
 }
 
 
@@ -1792,6 +1937,7 @@ le_result_t assetData_CreateInstanceById
     assetInstPtr->assetDataPtr = assetDataPtr;
 
     le_dls_Queue(&assetDataPtr->instanceList, &assetInstPtr->link);
+    AddInstanceToMaps(assetInstPtr);
 
     // todo: For now, for testing, print it out; add trace support later.
     if ( 0 )
@@ -1900,6 +2046,13 @@ void assetData_DeleteInstance
     {
         fieldDataPtr = CONTAINER_OF(linkPtr, FieldData_t, link);
 
+        // Only remove the field from FieldMapByName if it was the field stored there.
+        le_hashmap_Remove(FieldMap, &fieldDataPtr->idKey);
+        if ( le_hashmap_Get(FieldMapByName, &fieldDataPtr->nameKey) == fieldDataPtr )
+        {
+            le_hashmap_Remove(FieldMapByName, &fieldDataPtr->nameKey);
+        }
+
         // Some field types have allocated data, so release that first
         switch ( fieldDataPtr->type )
         {
@@ -1920,6 +2073,7 @@ void assetData_DeleteInstance
     }
 
     // Remove the instance from the asset instance list
+    le_hashmap_Remove(InstanceMap, &instanceRef->key);
     le_dls_Remove(&instanceRef->assetDataPtr->instanceList, &instanceRef->link);
 
     // Lastly, release the instance data.
@@ -2267,40 +2421,13 @@ le_result_t assetData_GetFieldIdFromName
     int* fieldIdPtr                             ///< [OUT] The field id
 )
 {
-    /*
-     * NOTE:
-     *   The main use for this function is to get the fieldId that is then passed to the various
-     *   assetData_client_Get* functions.  This is not particularly efficient as it requires
-     *   iterating twice through the field list.  One alternative would be to add a new set of
-     *   assetData_client_Get* functions that take a field name instead of field id.
-     *
-     *   For now, assume that the performance is good enough, but if it becomes an issue then
-     *   this second set of functions may need to be added.  Of course, there might also be some
-     *   other alternative solution that has not yet been considered.
-     */
-
-    FieldData_t* fieldDataPtr;
-    le_dls_Link_t* fieldLinkPtr;
-
-    // Get the start of the field list
-    fieldLinkPtr = le_dls_Peek(&instanceRef->fieldList);
-
-    //LE_PRINT_VALUE("%s", instanceRef->assetDataPtr->appName);
-    //LE_PRINT_VALUE("%s", instanceRef->assetDataPtr->assetName);
+    NameKey_t key = { .ownerPtr = instanceRef, .namePtr = fieldNamePtr };
+    FieldData_t* fieldDataPtr = le_hashmap_Get(FieldMapByName, &key);
 
-    // Loop through the fields
-    while ( fieldLinkPtr != NULL )
+    if ( fieldDataPtr != NULL )
     {
-        fieldDataPtr = CONTAINER_OF(fieldLinkPtr, FieldData_t, link);
-        //LE_PRINT_VALUE("%s", fieldDataPtr->name);
-
-        if ( strcmp(fieldDataPtr->name, fieldNamePtr) == 0 )
-        {
-            *fieldIdPtr = fieldDataPtr->fieldId;
-            return LE_OK;
-        }
-
-        fieldLinkPtr = le_dls_PeekNext(&instanceRef->fieldList, fieldLinkPtr);
+        *fieldIdPtr = fieldDataPtr->fieldId;
+        return LE_OK;
     }
 
     return LE_FAULT;
@@ -2992,6 +3119,12 @@ le_result_t assetData_Init
                                        le_hashmap_HashString,
                                        le_hashmap_EqualsString);
 
+    // Create the instance and field lookup maps.  Assets can have many instances, and each
+    // instance can have dozens of fields, so let these maps grow.
+    InstanceMap = le_hashmap_CreateDynamic("InstanceMap", 31, HashIdKey, EqualsIdKey);
+    FieldMap = le_hashmap_CreateDynamic("FieldMap", 127, HashIdKey, EqualsIdKey);
+    FieldMapByName = le_hashmap_CreateDynamic("FieldMapByName", 127, HashNameKey, EqualsNameKey);
+
     // Pre-load the /lwm2m/9 object into the AssetMap; don't actually need to use the assetRef here.
     assetData_AssetDataRef_t lwm2mAssetRef;
 
@@ -3056,7 +3189,112 @@ static void WriteUint(uint8_t* dataPtr, uint32_t value, int numBytes)
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Write a LWM2M TLV header to the given buffer.
+ * Smallest buffer allocated when a growable TLV writer's buffer fills up.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MIN_TLV_ALLOC_NUMBYTES 1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reserve space for the given number of bytes at the end of the TLV writer's output, growing the
+ * output buffer if it is full and the writer allows it.
+ *
+ * @return:
+ *      - Pointer to the reserved space
+ *      - NULL if there is no room
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* ReserveTLVBytes
+(
+    assetData_TLVWriter_t* writerPtr,   ///< [IN] TLV writer
+    size_t numBytes                     ///< [IN] # bytes to reserve
+)
+{
+    if ( numBytes > (writerPtr->bufNumBytes - writerPtr->numBytes) )
+    {
+        if ( !writerPtr->canGrow )
+        {
+            return NULL;
+        }
+
+        // Double the buffer size, so that writing many small TLVs doesn't mean many re-allocs.
+        size_t newNumBytes = writerPtr->bufNumBytes * 2;
+        if ( newNumBytes < writerPtr->numBytes + numBytes )
+        {
+            newNumBytes = writerPtr->numBytes + numBytes;
+        }
+        if ( newNumBytes < MIN_TLV_ALLOC_NUMBYTES )
+        {
+            newNumBytes = MIN_TLV_ALLOC_NUMBYTES;
+        }
+
+        uint8_t* newBufPtr;
+        if ( writerPtr->isAllocated )
+        {
+            newBufPtr = realloc(writerPtr->bufPtr, newNumBytes);
+        }
+        else
+        {
+            // Still using the caller's buffer, so move what has been written so far.
+            newBufPtr = malloc(newNumBytes);
+            if ( (newBufPtr != NULL) && (writerPtr->numBytes > 0) )
+            {
+                memcpy(newBufPtr, writerPtr->bufPtr, writerPtr->numBytes);
+            }
+        }
+
+        if ( newBufPtr == NULL )
+        {
+            LE_ERROR("Can't allocate %zu bytes for TLV data", newNumBytes);
+            return NULL;
+        }
+
+        writerPtr->bufPtr = newBufPtr;
+        writerPtr->bufNumBytes = newNumBytes;
+        writerPtr->isAllocated = true;
+    }
+
+    uint8_t* reservedPtr = writerPtr->bufPtr + writerPtr->numBytes;
+    writerPtr->numBytes += numBytes;
+
+    return reservedPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the size of the LWM2M TLV header for the given id and value size.
+ *
+ * @return:
+ *      - # bytes in the header (2 to 6)
+ *      - 0 if the value is too large to be encoded
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t TLVHeaderNumBytes
+(
+    int id,                             ///< [IN] Object instance or resource id
+    size_t valueNumBytes                ///< [IN] # bytes for TLV value
+)
+{
+    size_t numBytes = ( id > 255 ) ? 3 : 2;
+
+    if ( valueNumBytes < 8 )
+        return numBytes;
+    else if ( valueNumBytes < (1<<8) )
+        return numBytes + 1;
+    else if ( valueNumBytes < (1<<16) )
+        return numBytes + 2;
+    else if ( valueNumBytes < (1<<24) )
+        return numBytes + 3;
+    else
+        return 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a LWM2M TLV header to the TLV writer.
  *
  * @return:
  *      - LE_OK on success
@@ -3068,10 +3306,8 @@ static le_result_t WriteTLVHeader
 (
     TLVTypes_t type,                    ///< [IN] Type of TLV
     int id,                             ///< [IN] Object instance or resource id
-    int valueNumBytes,                  ///< [IN] # bytes for TLV value (written separately)
-    uint8_t* bufPtr,                    ///< [OUT] Buffer for writing the header
-    size_t bufNumBytes,                 ///< [IN] Size of buffer
-    size_t* numBytesWrittenPtr          ///< [OUT] # bytes written to buffer.
+    size_t valueNumBytes,               ///< [IN] # bytes for TLV value (written separately)
+    assetData_TLVWriter_t* writerPtr    ///< [IN] TLV writer
 )
 {
     // Pack the TLV type
@@ -3087,27 +3323,25 @@ static le_result_t WriteTLVHeader
 
     // Determine how length of the value is specified; either directly encoded in typeByte or
     // explicitly given in the header.
-    int lengthFieldNumBytes;
-    if ( valueNumBytes < 8 )
+    size_t headerNumBytes = TLVHeaderNumBytes(id, valueNumBytes);
+    if ( headerNumBytes == 0 )
     {
-        lengthFieldNumBytes = 0x0;
-        typeByte |= ( valueNumBytes );
-    }
-    else if ( valueNumBytes < (1<<8) )
-        lengthFieldNumBytes = 0x1;
-    else if ( valueNumBytes < (1<<16) )
-        lengthFieldNumBytes = 0x2;
-    else if ( valueNumBytes < (1<<24) )
-        lengthFieldNumBytes = 0x3;
-    else
         // Value length is too large
         return LE_FAULT;
+    }
+
+    int lengthFieldNumBytes = headerNumBytes - 1 - idNumBytes;
+    if ( lengthFieldNumBytes == 0 )
+    {
+        typeByte |= ( valueNumBytes );
+    }
 
     typeByte |= lengthFieldNumBytes << 3;
 
     // Header length is one for typeByte, plus size of id and length fields, so can be anywhere
     // from 2 bytes to 6 bytes.
-    if ( (1 + idNumBytes + lengthFieldNumBytes) >  bufNumBytes )
+    uint8_t* bufPtr = ReserveTLVBytes(writerPtr, headerNumBytes);
+    if ( bufPtr == NULL )
         return LE_OVERFLOW;
 
     // Copy the header to the output buffer
@@ -3119,16 +3353,69 @@ static le_result_t WriteTLVHeader
     if ( lengthFieldNumBytes > 0 )
         WriteUint(bufPtr, valueNumBytes, lengthFieldNumBytes);
 
-    // Return the number of bytes written
-    *numBytesWrittenPtr = 1 + idNumBytes + lengthFieldNumBytes;
-
     return LE_OK;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Write a LWM2M Resource TLV to the given buffer.
+ * Get the size of the value of a field, when written as a LWM2M Resource TLV.
+ *
+ * @return # bytes in the value
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t FieldValueNumBytes
+(
+    FieldData_t* fieldDataPtr               ///< [IN] The field
+)
+{
+    switch ( fieldDataPtr->type )
+    {
+        case DATA_TYPE_INT:
+            return 4;
+
+        case DATA_TYPE_BOOL:
+            return 1;
+
+        case DATA_TYPE_STRING:
+            return strlen(fieldDataPtr->strValuePtr);
+
+        case DATA_TYPE_NONE:
+            break;
+    }
+
+    return 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the size of the LWM2M Resource TLV for a field, including the header.
+ *
+ * @return # bytes in the TLV, or 0 if the field has no data.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t FieldTLVNumBytes
+(
+    FieldData_t* fieldDataPtr               ///< [IN] The field
+)
+{
+    if ( fieldDataPtr->type == DATA_TYPE_NONE )
+    {
+        return 0;
+    }
+
+    size_t valueNumBytes = FieldValueNumBytes(fieldDataPtr);
+
+    return TLVHeaderNumBytes(fieldDataPtr->fieldId, valueNumBytes) + valueNumBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a LWM2M Resource TLV to the TLV writer.
+ *
+ * Field read handlers must already have been called, if necessary.
  *
  * @return:
  *      - LE_OK on success
@@ -3140,103 +3427,111 @@ static le_result_t WriteFieldTLV
 (
     assetData_InstanceDataRef_t instRef,    ///< [IN] Asset instance containing field to write
     FieldData_t* fieldDataPtr,              ///< [IN] The field to write to the TLV
-    uint8_t* bufPtr,                        ///< [OUT] Buffer for writing the TLV
-    size_t bufNumBytes,                     ///< [IN] Size of buffer
-    size_t* numBytesWrittenPtr              ///< [OUT] # bytes written to buffer.
+    assetData_TLVWriter_t* writerPtr        ///< [IN] TLV writer
 )
 {
-    le_result_t result = LE_OK;
-    size_t numBytesWritten;
-    int strLength;
+    if ( fieldDataPtr->type == DATA_TYPE_NONE )
+    {
+        LE_ERROR("No data to read");
+        return LE_FAULT;
+    }
 
-    // Provide enough space for max field size, which is 256 bytes for a string, plus max header
-    // size, which is 6 bytes.  Thus will ensure overflow doesn't happen when putting data in
-    // tmpBuffer.  Overflow will be checked when trying to copy to the output buffer in bufPtr.
-    uint8_t tmpBuffer[256+6];
-    uint8_t* tmpBufferPtr = tmpBuffer;
+    size_t valueNumBytes = FieldValueNumBytes(fieldDataPtr);
 
-    // Call any registered handlers to be notified of read
-    CallFieldActionHandlers( instRef, fieldDataPtr->fieldId, ASSET_DATA_ACTION_READ, false );
+    le_result_t result = WriteTLVHeader(TLV_TYPE_RESOURCE,
+                                        fieldDataPtr->fieldId,
+                                        valueNumBytes,
+                                        writerPtr);
+    if ( result != LE_OK )
+    {
+        if ( result == LE_OVERFLOW )
+        {
+            LE_WARN("Overflow: oiid=%i, rid=%i", instRef->instanceId, fieldDataPtr->fieldId);
+        }
+        return result;
+    }
+
+    uint8_t* valuePtr = ReserveTLVBytes(writerPtr, valueNumBytes);
+    if ( valuePtr == NULL )
+    {
+        LE_WARN("Overflow: oiid=%i, rid=%i", instRef->instanceId, fieldDataPtr->fieldId);
+        return LE_OVERFLOW;
+    }
 
     switch ( fieldDataPtr->type )
     {
         case DATA_TYPE_INT:
-            WriteTLVHeader(TLV_TYPE_RESOURCE,
-                           fieldDataPtr->fieldId,
-                           4,
-                           tmpBufferPtr,
-                           sizeof(tmpBuffer),
-                           &numBytesWritten);
-            tmpBufferPtr += numBytesWritten;
-            WriteUint(tmpBufferPtr, fieldDataPtr->intValue, 4);
-
-            numBytesWritten += 4;
+            WriteUint(valuePtr, fieldDataPtr->intValue, 4);
             break;
 
         case DATA_TYPE_BOOL:
-            WriteTLVHeader(TLV_TYPE_RESOURCE,
-                           fieldDataPtr->fieldId,
-                           1,
-                           tmpBufferPtr,
-                           sizeof(tmpBuffer),
-                           &numBytesWritten);
-            tmpBufferPtr += numBytesWritten;
-            WriteUint(tmpBufferPtr, fieldDataPtr->boolValue, 1);
-
-            numBytesWritten += 1;
+            WriteUint(valuePtr, fieldDataPtr->boolValue, 1);
             break;
 
         case DATA_TYPE_STRING:
-            strLength = strlen(fieldDataPtr->strValuePtr);
-
-            WriteTLVHeader(TLV_TYPE_RESOURCE,
-                           fieldDataPtr->fieldId,
-                           strLength,
-                           tmpBufferPtr,
-                           sizeof(tmpBuffer),
-                           &numBytesWritten);
-
-            tmpBufferPtr += numBytesWritten;
-
-            result = le_utf8_Copy((char*)tmpBufferPtr,
-                                  fieldDataPtr->strValuePtr,
-                                  sizeof(tmpBuffer)-numBytesWritten,
-                                  NULL);
-
-            // Assumes no overflow; that will be checked below
-            numBytesWritten += strLength;
+            // The TLV value is not null-terminated.
+            memcpy(valuePtr, fieldDataPtr->strValuePtr, valueNumBytes);
             break;
 
         case DATA_TYPE_NONE:
-            LE_ERROR("No data to read");
-            result = LE_FAULT;
-            *numBytesWrittenPtr = 0;
             break;
     }
 
-    // Successfully got the data, so copy to output buffer, if there is room.
-    if ( result == LE_OK )
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a TLV writer.
+ *
+ * The writer writes into the given buffer.  If it is allowed to grow, the data is moved to a
+ * bigger buffer from the heap when the given buffer is full, and assetData_CleanUpTLVWriter() must
+ * be called when the data is no longer needed.
+ */
+//--------------------------------------------------------------------------------------------------
+void assetData_InitTLVWriter
+(
+    assetData_TLVWriter_t* writerPtr,           ///< [OUT] TLV writer to initialize
+    uint8_t* bufPtr,                            ///< [IN] Initial buffer (can be NULL if size is 0)
+    size_t bufNumBytes,                         ///< [IN] Size of buffer
+    bool canGrow                                ///< [IN] Can the buffer be replaced by a bigger one
+)
+{
+    writerPtr->bufPtr = bufPtr;
+    writerPtr->bufNumBytes = bufNumBytes;
+    writerPtr->numBytes = 0;
+    writerPtr->canGrow = canGrow;
+    writerPtr->isAllocated = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release any buffer that a TLV writer allocated.  The writer must be initialized again before it
+ * is re-used.
+ */
+//--------------------------------------------------------------------------------------------------
+void assetData_CleanUpTLVWriter
+(
+    assetData_TLVWriter_t* writerPtr            ///< [IN] TLV writer
+)
+{
+    if ( writerPtr->isAllocated )
     {
-        if ( numBytesWritten <= bufNumBytes )
-        {
-            memcpy(bufPtr, tmpBuffer, numBytesWritten);
-            *numBytesWrittenPtr = numBytesWritten;
-        }
-        else
-        {
-            LE_WARN("Overflow: oiid=%i, rid=%i", instRef->instanceId, fieldDataPtr->fieldId);
-            *numBytesWrittenPtr = 0;
-            result = LE_OVERFLOW;
-        }
+        free(writerPtr->bufPtr);
     }
 
-    return result;
+    writerPtr->bufPtr = NULL;
+    writerPtr->bufNumBytes = 0;
+    writerPtr->numBytes = 0;
+    writerPtr->isAllocated = false;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Write a list of readable LWM2M Resource TLVs to the given buffer.
+ * Write a list of readable LWM2M Resource TLVs to the TLV writer.
  *
  * @return:
  *      - LE_OK on success
@@ -3244,22 +3539,16 @@ static le_result_t WriteFieldTLV
  *      - LE_FAULT on any other error
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t assetData_WriteFieldListToTLV
+le_result_t assetData_WriteFieldListToTLVWriter
 (
     assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
-    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the TLV list
-    size_t bufNumBytes,                         ///< [IN] Size of buffer
-    size_t* numBytesWrittenPtr                  ///< [OUT] # bytes written to buffer.
+    assetData_TLVWriter_t* writerPtr            ///< [IN] TLV writer
 )
 {
     le_result_t result;
 
-    uint8_t* startBufPtr = bufPtr;
-    uint8_t* endBufPtr = bufPtr+bufNumBytes;
-
     le_dls_Link_t* linkPtr;
     FieldData_t* fieldDataPtr;
-    size_t fieldNumBytesWritten;
 
     // Get the start of the field list
     linkPtr = le_dls_Peek(&instanceRef->fieldList);
@@ -3274,31 +3563,28 @@ le_result_t assetData_WriteFieldListToTLV
         if ( fieldDataPtr->access & ACCESS_WRITE )
         {
             LE_PRINT_VALUE("%i read", fieldDataPtr->fieldId);
-            result = WriteFieldTLV(instanceRef,
-                                   fieldDataPtr,
-                                   startBufPtr,
-                                   endBufPtr-startBufPtr,
-                                   &fieldNumBytesWritten);
 
+            // Call any registered handlers to be notified of read
+            CallFieldActionHandlers( instanceRef, fieldDataPtr->fieldId, ASSET_DATA_ACTION_READ,
+                                     false );
+
+            result = WriteFieldTLV(instanceRef, fieldDataPtr, writerPtr);
             if ( result != LE_OK )
             {
                 return result;
             }
-
-            startBufPtr += fieldNumBytesWritten;
         }
 
         linkPtr = le_dls_PeekNext(&instanceRef->fieldList, linkPtr);
     }
 
-    *numBytesWrittenPtr = startBufPtr - bufPtr;
     return LE_OK;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Write a LWM2M Object Instance TLV to the given buffer.
+ * Write a list of readable LWM2M Resource TLVs to the given buffer.
  *
  * @return:
  *      - LE_OK on success
@@ -3306,33 +3592,72 @@ le_result_t assetData_WriteFieldListToTLV
  *      - LE_FAULT on any other error
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t WriteInstanceToTLV
+le_result_t assetData_WriteFieldListToTLV
 (
     assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
-    int fieldId,                                ///< [IN] Field to write, or -1 for all fields
-    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the object instance
+    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the TLV list
     size_t bufNumBytes,                         ///< [IN] Size of buffer
     size_t* numBytesWrittenPtr                  ///< [OUT] # bytes written to buffer.
 )
+{
+    assetData_TLVWriter_t writer;
+
+    assetData_InitTLVWriter(&writer, bufPtr, bufNumBytes, false);
+
+    le_result_t result = assetData_WriteFieldListToTLVWriter(instanceRef, &writer);
+    if ( result == LE_OK )
+    {
+        *numBytesWrittenPtr = writer.numBytes;
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a LWM2M Object Instance TLV to the TLV writer.
+ *
+ * The size of the instance's fields is worked out first, so that the instance header can be
+ * written ahead of them, straight into the output.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the TLV data could not fit in the buffer
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteInstanceToTLV
+(
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
+    int fieldId,                                ///< [IN] Field to write, or -1 for all fields
+    assetData_TLVWriter_t* writerPtr            ///< [IN] TLV writer
+)
 {
     le_result_t result;
-    FieldData_t* fieldDataPtr;
-    size_t totalNumBytesWritten;
-    size_t numBytesWritten;
-    uint8_t tmpBuffer[256-6];  // leave enough space for maximum header size of 6 bytes
+    FieldData_t* fieldDataPtr = NULL;
+    le_dls_Link_t* linkPtr;
+    size_t valueNumBytes = 0;
 
-    // Need to write the field TLVs first, to know how many bytes will be in the instance TLV.
-    // Either read all the allowable TLVs, or just the one specified.
+    // Either read all the allowable fields, or just the one specified.  Let the read handlers
+    // update the values first, and add up the size of the field TLVs.
     if ( fieldId == -1 )
     {
-        // Read all fields that are allowed and write to the TLV.
-        result = assetData_WriteFieldListToTLV(instanceRef,
-                                               tmpBuffer,
-                                               sizeof(tmpBuffer),
-                                               &totalNumBytesWritten);
-        if ( result != LE_OK )
+        linkPtr = le_dls_Peek(&instanceRef->fieldList);
+        while ( linkPtr != NULL )
         {
-            return result;
+            FieldData_t* listFieldPtr = CONTAINER_OF(linkPtr, FieldData_t, link);
+
+            // The access values are from the client perspective, so we can read whatever fields
+            // the client can write.
+            if ( listFieldPtr->access & ACCESS_WRITE )
+            {
+                CallFieldActionHandlers( instanceRef, listFieldPtr->fieldId,
+                                         ASSET_DATA_ACTION_READ, false );
+                valueNumBytes += FieldTLVNumBytes(listFieldPtr);
+            }
+
+            linkPtr = le_dls_PeekNext(&instanceRef->fieldList, linkPtr);
         }
     }
     else
@@ -3341,46 +3666,62 @@ static le_result_t WriteInstanceToTLV
         if ( result != LE_OK )
             return result;
 
-        WriteFieldTLV(instanceRef,
-                      fieldDataPtr,
-                      tmpBuffer,
-                      sizeof(tmpBuffer),
-                      &totalNumBytesWritten);
+        CallFieldActionHandlers( instanceRef, fieldId, ASSET_DATA_ACTION_READ, false );
+        valueNumBytes = FieldTLVNumBytes(fieldDataPtr);
     }
 
-    // If there is room in the output buffer, write the instance TLV to it.  Ensure that all the
-    // TLV data will fit, plus 6 bytes for header.
-    if ( totalNumBytesWritten + 6 <= bufNumBytes )
+    result = WriteTLVHeader(TLV_TYPE_OBJ_INST, instanceRef->instanceId, valueNumBytes, writerPtr);
+    if ( result != LE_OK )
     {
-        WriteTLVHeader(TLV_TYPE_OBJ_INST,
-                       instanceRef->instanceId,
-                       totalNumBytesWritten,
-                       bufPtr,
-                       bufNumBytes,
-                       &numBytesWritten);
+        if ( result == LE_OVERFLOW )
+        {
+            LE_WARN("Overflow: oiid=%i, rid=%i", instanceRef->instanceId, fieldId);
+        }
+        return result;
+    }
 
-        bufPtr += numBytesWritten;
-        bufNumBytes -= numBytesWritten;
+    size_t startNumBytes = writerPtr->numBytes;
+
+    if ( fieldId == -1 )
+    {
+        linkPtr = le_dls_Peek(&instanceRef->fieldList);
+        while ( linkPtr != NULL )
+        {
+            FieldData_t* listFieldPtr = CONTAINER_OF(linkPtr, FieldData_t, link);
 
-        memcpy(bufPtr, tmpBuffer, totalNumBytesWritten);
-        *numBytesWrittenPtr = numBytesWritten+totalNumBytesWritten;
+            if ( listFieldPtr->access & ACCESS_WRITE )
+            {
+                result = WriteFieldTLV(instanceRef, listFieldPtr, writerPtr);
+                if ( result != LE_OK )
+                    return result;
+            }
 
-        result = LE_OK;
+            linkPtr = le_dls_PeekNext(&instanceRef->fieldList, linkPtr);
+        }
     }
-    else
+    else if ( fieldDataPtr->type != DATA_TYPE_NONE )
     {
-        LE_WARN("Overflow: oiid=%i, rid=%i", instanceRef->instanceId, fieldId);
-        *numBytesWrittenPtr = 0;
-        result = LE_OVERFLOW;
+        result = WriteFieldTLV(instanceRef, fieldDataPtr, writerPtr);
+        if ( result != LE_OK )
+            return result;
     }
 
-    return result;
+    // The read handlers are all called before any field is written, so nothing should have
+    // changed size in the meantime.
+    if ( (writerPtr->numBytes - startNumBytes) != valueNumBytes )
+    {
+        LE_ERROR("Instance %i changed size while being written (%zu != %zu)",
+                 instanceRef->instanceId, writerPtr->numBytes - startNumBytes, valueNumBytes);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Write TLV with all instances of the LWM2M Object to the given buffer.
+ * Write TLV with all instances of the LWM2M Object to the TLV writer.
  *
  * @return:
  *      - LE_OK on success
@@ -3388,26 +3729,17 @@ static le_result_t WriteInstanceToTLV
  *      - LE_FAULT on any other error
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t assetData_WriteObjectToTLV
+le_result_t assetData_WriteObjectToTLVWriter
 (
     assetData_AssetDataRef_t assetRef,          ///< [IN] Asset to use
     int fieldId,                                ///< [IN] Field to write, or -1 for all fields
-    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the header
-    size_t bufNumBytes,                         ///< [IN] Size of buffer
-    size_t* numBytesWrittenPtr                  ///< [OUT] # bytes written to buffer.
+    assetData_TLVWriter_t* writerPtr            ///< [IN] TLV writer
 )
 {
     le_result_t result;
-    size_t numBytesWritten;
     le_dls_Link_t* linkPtr;
     InstanceData_t* instancePtr;
 
-    // total bytes written will be (bufPtr-startBufPtr)
-    uint8_t* startBufPtr = bufPtr;
-
-    // buffer size will be (endBufPtr-bufPtr);
-    uint8_t* endBufPtr = bufPtr+bufNumBytes;
-
     // Get the start of the instance list
     linkPtr = le_dls_Peek(&assetRef->instanceList);
 
@@ -3416,24 +3748,50 @@ le_result_t assetData_WriteObjectToTLV
     {
         instancePtr = CONTAINER_OF(linkPtr, InstanceData_t, link);
 
-        result = WriteInstanceToTLV(instancePtr,
-                                    fieldId,
-                                    bufPtr,
-                                    endBufPtr-bufPtr,
-                                    &numBytesWritten);
+        result = WriteInstanceToTLV(instancePtr, fieldId, writerPtr);
         if ( result != LE_OK )
             return result;
 
-        bufPtr += numBytesWritten;
-
         linkPtr = le_dls_PeekNext(&assetRef->instanceList, linkPtr);
     }
 
-    *numBytesWrittenPtr = bufPtr-startBufPtr;
     return LE_OK;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write TLV with all instances of the LWM2M Object to the given buffer.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the TLV data could not fit in the buffer
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t assetData_WriteObjectToTLV
+(
+    assetData_AssetDataRef_t assetRef,          ///< [IN] Asset to use
+    int fieldId,                                ///< [IN] Field to write, or -1 for all fields
+    uint8_t* bufPtr,                            ///< [OUT] Buffer for writing the header
+    size_t bufNumBytes,                         ///< [IN] Size of buffer
+    size_t* numBytesWrittenPtr                  ///< [OUT] # bytes written to buffer.
+)
+{
+    assetData_TLVWriter_t writer;
+
+    assetData_InitTLVWriter(&writer, bufPtr, bufNumBytes, false);
+
+    le_result_t result = assetData_WriteObjectToTLVWriter(assetRef, fieldId, &writer);
+    if ( result == LE_OK )
+    {
+        *numBytesWrittenPtr = writer.numBytes;
+    }
+
+    return result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Read an integer of the given size and in network byte order from the buffer
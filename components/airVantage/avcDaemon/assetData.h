@@ -847,6 +847,91 @@ LE_SHARED le_result_t assetData_Init
 //--------------------------------------------------------------------------------------------------
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes TLV data straight into an output buffer.  The buffer is given by the caller and, if the
+ * writer is allowed to grow, replaced by a bigger one from the heap when it fills up, so there is
+ * no limit on how much can be written.
+ *
+ * The data written so far is at bufPtr, and is numBytes long.  The other fields are private.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t* bufPtr;        ///< Output buffer
+    size_t bufNumBytes;     ///< Size of the output buffer
+    size_t numBytes;        ///< # bytes written to the output buffer so far
+    bool canGrow;           ///< Can the output buffer be replaced by a bigger one when full?
+    bool isAllocated;       ///< Was the output buffer allocated by the writer?
+}
+assetData_TLVWriter_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a TLV writer.
+ *
+ * The writer writes into the given buffer.  If it is allowed to grow, the data is moved to a
+ * bigger buffer from the heap when the given buffer is full, and assetData_CleanUpTLVWriter() must
+ * be called when the data is no longer needed.
+ */
+//--------------------------------------------------------------------------------------------------
+void assetData_InitTLVWriter
+(
+    assetData_TLVWriter_t* writerPtr,           ///< [OUT] TLV writer to initialize
+    uint8_t* bufPtr,                            ///< [IN] Initial buffer (can be NULL if size is 0)
+    size_t bufNumBytes,                         ///< [IN] Size of buffer
+    bool canGrow                                ///< [IN] Can the buffer be replaced by a bigger one
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release any buffer that a TLV writer allocated.  The writer must be initialized again before it
+ * is re-used.
+ */
+//--------------------------------------------------------------------------------------------------
+void assetData_CleanUpTLVWriter
+(
+    assetData_TLVWriter_t* writerPtr            ///< [IN] TLV writer
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a list of readable LWM2M Resource TLVs to the TLV writer.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the TLV data could not fit in the buffer
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t assetData_WriteFieldListToTLVWriter
+(
+    assetData_InstanceDataRef_t instanceRef,    ///< [IN] Asset instance to use
+    assetData_TLVWriter_t* writerPtr            ///< [IN] TLV writer
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write TLV with all instances of the LWM2M Object to the TLV writer.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the TLV data could not fit in the buffer
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t assetData_WriteObjectToTLVWriter
+(
+    assetData_AssetDataRef_t assetRef,          ///< [IN] Asset to use
+    int fieldId,                                ///< [IN] Field to write, or -1 for all fields
+    assetData_TLVWriter_t* writerPtr            ///< [IN] TLV writer
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Write a list of readable LWM2M Resource TLVs to the given buffer.
@@ -119,11 +119,11 @@ static void OperationHandler
             return;
         }
 
-        result = assetData_WriteObjectToTLV(assetRef,
-                                            resourceId,
-                                            valueData,
-                                            sizeof(valueData),
-                                            &bytesWritten);
+        // Objects can have many instances, so let the TLV data grow beyond valueData if needed.
+        assetData_TLVWriter_t writer;
+        assetData_InitTLVWriter(&writer, valueData, sizeof(valueData), true);
+
+        result = assetData_WriteObjectToTLVWriter(assetRef, resourceId, &writer);
 
         if ( result == LE_OVERFLOW )
             opErr = PA_AVC_OPERR_OBJ_INST_UNAVAIL;
@@ -137,9 +137,11 @@ static void OperationHandler
         else
         {
             // Send the valid response
-            pa_avc_OperationReportSuccess(opRef, valueData, bytesWritten);
+            pa_avc_OperationReportSuccess(opRef, writer.bufPtr, writer.numBytes);
         }
 
+        assetData_CleanUpTLVWriter(&writer);
+
         // TODO: Refactor so I don't need a return here.
         return;
     }
@@ -172,21 +174,37 @@ static void OperationHandler
 
             if ( resourceId == -1 )
             {
-                result = assetData_WriteFieldListToTLV(instRef,
-                                                       valueData,
-                                                       sizeof(valueData),
-                                                       &bytesWritten);
-
-            }
-            else
-            {
-                result = assetData_server_GetValue(instRef,
-                                                   resourceId,
-                                                   (char*)valueData,
-                                                   sizeof(valueData));
-                bytesWritten = strlen((char*)valueData);
+                // The TLV data can grow beyond valueData if the instance has many fields.
+                assetData_TLVWriter_t writer;
+                assetData_InitTLVWriter(&writer, valueData, sizeof(valueData), true);
+
+                result = assetData_WriteFieldListToTLVWriter(instRef, &writer);
+
+                if ( result == LE_OVERFLOW )
+                    opErr = PA_AVC_OPERR_OBJ_INST_UNAVAIL;
+                else if ( result != LE_OK )
+                    opErr = PA_AVC_OPERR_INTERNAL;
+
+                if ( opErr != PA_AVC_OPERR_NO_ERROR )
+                {
+                    pa_avc_OperationReportError(opRef, opErr);
+                }
+                else
+                {
+                    // Send the valid response
+                    pa_avc_OperationReportSuccess(opRef, writer.bufPtr, writer.numBytes);
+                }
+
+                assetData_CleanUpTLVWriter(&writer);
+                return;
             }
 
+            result = assetData_server_GetValue(instRef,
+                                               resourceId,
+                                               (char*)valueData,
+                                               sizeof(valueData));
+            bytesWritten = strlen((char*)valueData);
+
             if ( result == LE_NOT_FOUND )
                 opErr = PA_AVC_OPERR_RESOURCE_UNSUPPORTED;
             else if ( result == LE_OVERFLOW )
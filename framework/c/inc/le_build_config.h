@@ -19,6 +19,12 @@
  * switches to use malloc/free per-block.  This way, tools like valgrind can be used on a Legato
  * executable.
  *
+ * @section bld_cfg_mutex_lean LE_MUTEX_LEAN
+ *
+ * When @c LE_MUTEX_LEAN is defined, le_mutex_CreateRecursive() and le_mutex_CreateNonRecursive()
+ * create @ref c_mutex_lean "lean mutexes", which skip the diagnostic bookkeeping unless they are
+ * contended.
+ *
  * <HR>
  *
  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
@@ -48,4 +54,9 @@
 
 
 
+// Uncomment this define to make all mutexes lean.
+//#define LE_MUTEX_LEAN
+
+
+
 #endif
@@ -20,6 +20,14 @@
  * maximum expected capacity. If a too small size is chosen, there will be an
  * increase in collisions that degrade performance over time.
  *
+ * When the number of entries is hard to predict, use @c le_hashmap_CreateDynamic() instead.
+ * It takes the same parameters, but the size is only a starting point: the map grows as entries
+ * are added, so it never degrades the way an undersized fixed map does.  Dynamic maps store
+ * their entries by value in a single array, which keeps lookups to a couple of cache lines,
+ * and entries don't need to be allocated from a memory pool.  Apart from creation and the
+ * iteration order described in @ref c_hashmap_iterating, both kinds of map are used through the
+ * same functions.  Keys stored in a dynamic map must not be NULL.
+ *
  * All hashmaps have names for diagnostic purposes.
  *
  * @section c_hashmap_insert Adding key-value pairs
@@ -119,6 +127,11 @@
  * le_hashmap_GetKey, and le_hashmap_GetValue will return NULL until either,
  * le_hashmap_NextNode, or le_hashmap_PrevNode are called.
  *
+ * Maps created with le_hashmap_CreateDynamic() are iterated in insertion order, and the
+ * iterator stays valid while items are added and removed, even if the map grows.  Items
+ * added during an iteration are always visited, and removed items are never visited.
+ * le_hashmap_GetFirstNode() and le_hashmap_GetNodeAfter() follow the same order.
+ *
  * For example (assuming a table of string/string):
  *
  * @code
@@ -256,6 +269,23 @@ le_hashmap_Ref_t le_hashmap_Create
     le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] Equality function
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a HashMap that grows as entries are added (see @ref c_hashmap_create).
+ *
+ * @return  Returns a reference to the map.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t le_hashmap_CreateDynamic
+(
+    const char*                nameStr,          ///< [in] Name of the HashMap
+    size_t                     initialCapacity,  ///< [in] Number of entries to allocate up front
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] Hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] Equality function
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add a key-value pair to a HashMap. If the key already exists in the map, the previous value
@@ -22,6 +22,24 @@
  * event-driven manner: As JSON data is received, asynchronous call-back functions are called
  * to deliver parsed information or an error message.
  *
+ * le_json_ParseBuffer() does the same for a JSON document that is already in memory (e.g., a file
+ * that has been mapped using mmap()).  Parsing starts when the calling thread's Event Loop next
+ * runs, and the buffer must not be changed or freed until parsing has stopped.
+ *
+ * When reading from a regular file, the parser reads ahead in blocks, and when parsing stops, it
+ * seeks back so the file position is just after the last byte it parsed.  Other file descriptors
+ * (such as pipes and sockets) are read one byte at a time, so nothing that follows the document
+ * in the stream is consumed by the parser.
+ *
+ * le_json_ParseStream() reads any kind of file descriptor in blocks, up to
+ * @ref LE_JSON_STREAM_BUFFER_BYTES at a time.  Whatever it read past the end of the document is
+ * kept in the parsing session instead of being put back, and can be fetched with
+ * le_json_GetUnparsedData() once parsing has stopped (before calling le_json_Cleanup()).  Data
+ * that was already read from the stream (e.g., left over from an earlier document) can be handed
+ * to le_json_ParseStream(), to be parsed before anything more is read.  Use this to parse a
+ * document that is followed by other data in a pipe or socket, such as the sections of an update
+ * pack.
+ *
  * Parsing stops automatically when the end of the document is reached or an error is encountered.
  *
  * le_json_Cleanup() must be called to release memory resources allocated by the parser.
@@ -79,8 +97,8 @@
  * For diagnostic purposes, le_json_GetEventName() can be called to get a human-readable
  * string containing the name of a given event.
  *
- * To get the number of bytes that have been read by the parser since le_json_Parse() was called,
- * call le_json_GetBytesRead().
+ * To get the number of bytes of the document that have been parsed since le_json_Parse() or
+ * le_json_ParseBuffer() was called, call le_json_GetBytesRead().
  *
  *  @section c_json_example Example
  *
@@ -206,6 +224,15 @@ typedef void (* le_json_ErrorHandler_t)
 typedef struct le_json_ParsingSession* le_json_ParsingSessionRef_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Most bytes that le_json_ParseStream() reads at a time, and so the most data that can be left
+ * unparsed after a document, or handed to le_json_ParseStream() to be parsed first.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LE_JSON_STREAM_BUFFER_BYTES 4096
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Parse a JSON document received via a file descriptor.
@@ -222,6 +249,63 @@ le_json_ParsingSessionRef_t le_json_Parse
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a JSON document that is already in memory.
+ *
+ * @return Reference to the JSON parsing session started by this function call.
+ */
+//--------------------------------------------------------------------------------------------------
+le_json_ParsingSessionRef_t le_json_ParseBuffer
+(
+    const void* bufferPtr,  ///< The JSON document.  Must remain valid until parsing stops.
+    size_t bufferSize,      ///< Size of the JSON document, in bytes.
+    le_json_EventHandler_t  eventHandler,   ///< Function to call when normal parsing events happen.
+    le_json_ErrorHandler_t  errorHandler,   ///< Function to call when errors happen.
+    void* opaquePtr   ///< Opaque pointer to be fetched by handlers using le_json_GetOpaquePtr().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a JSON document received via a file descriptor, reading ahead in blocks whatever type of
+ * file descriptor it is.  Anything read past the end of the document can be fetched with
+ * le_json_GetUnparsedData().
+ *
+ * @return Reference to the JSON parsing session started by this function call.
+ *
+ * @note If more than LE_JSON_STREAM_BUFFER_BYTES of data is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+le_json_ParsingSessionRef_t le_json_ParseStream
+(
+    int fd, ///< File descriptor to read the JSON document from.
+    const void* dataPtr,    ///< Data already read from the fd, to be parsed first (can be NULL).
+    size_t dataSize,        ///< Number of bytes of data at dataPtr.
+    le_json_EventHandler_t  eventHandler,   ///< Function to call when normal parsing events happen.
+    le_json_ErrorHandler_t  errorHandler,   ///< Function to call when errors happen.
+    void* opaquePtr   ///< Opaque pointer to be fetched by handlers using le_json_GetOpaquePtr().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the data that a session started by le_json_ParseStream() read from its file descriptor but
+ * didn't parse, because parsing stopped (at the end of the document, or on an error).
+ *
+ * Can be called from inside the session's own event or error handlers.
+ *
+ * @return Pointer to the unparsed data, valid until le_json_Cleanup() is called.  (Always no data
+ *         for sessions that weren't started by le_json_ParseStream(), or that are still parsing.)
+ */
+//--------------------------------------------------------------------------------------------------
+const void* le_json_GetUnparsedData
+(
+    le_json_ParsingSessionRef_t session,    ///< Parsing session.
+    size_t* sizePtr                         ///< [OUT] Number of bytes of unparsed data.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Stops parsing and cleans up memory allocated by the parser.
@@ -379,7 +463,7 @@ const char* le_json_GetContextName
 
 //--------------------------------------------------------------------------------------------------
 /**
- * @return The number of bytes that have been read from the input stream so far.
+ * @return The number of bytes of the JSON document that have been parsed so far.
  */
 //--------------------------------------------------------------------------------------------------
 size_t le_json_GetBytesRead
@@ -280,6 +280,37 @@ $ export LE_LOG_LEVEL=DEBUG
  * For example,
  * @verbatim
 $ export LE_LOG_TRACE=framework/fdMonitor:framework/logControl
+@endverbatim
+ *
+ * @subsubsection c_log_control_env_async LE_LOG_ASYNC
+ *
+ * Setting @c LE_LOG_ASYNC to @c 1 makes the process log asynchronously.  Instead of formatting
+ * each message and writing it to the log itself, the calling thread copies the message's format
+ * string pointer, arguments, level, timestamp and thread name into an in-memory buffer and
+ * returns.  A writer thread, started by the first such message, formats the messages and writes
+ * them out in batches.  This takes most of the cost of logging off the calling thread and means
+ * it never blocks waiting for the log.
+ *
+ * Some things to be aware of:
+ * - CRITICAL and EMERGENCY messages are still written by the caller, after everything that is
+ *   waiting in the buffer, so nothing is lost when LE_FATAL() or LE_ASSERT() abort the process.
+ *   Messages using a format the writer can't reproduce (e.g., positional arguments or @c %n)
+ *   are handled the same way.
+ * - If the buffer fills up, messages are dropped rather than making the caller wait.  The writer
+ *   then logs how many were dropped.
+ * - Messages still in the buffer are written when the process exits normally, but are lost if
+ *   it is killed by a signal.
+ * - After fork(), the child process logs synchronously.
+ * - Only pointers to the format string, source file name and function name are kept, so they must
+ *   still be valid when the writer thread gets to the message.  The LE_INFO(), LE_DEBUG(), etc.
+ *   macros are fine, as long as the format is a string literal and the code doing the logging is
+ *   not in a library that is unloaded with dlclose() while the process is still running.  Don't
+ *   pass a format string that is built at run-time or held in a buffer that can change or be freed;
+ *   use a literal format such as "%s" instead.
+ *
+ * For example,
+ * @verbatim
+$ export LE_LOG_ASYNC=1
 @endverbatim
  *
  * @subsection c_log_control_functions Programmatic Log Control
@@ -43,6 +43,7 @@
  *  - destructors
  *  - statistics
  *  - multi-threading
+ *  - per-thread caches
  *  - sub-pools (pools that can be deleted).
  *
  * The following sections describe these, beginning with the most basic usage and working up to more
@@ -232,6 +233,9 @@
  *  - Number of currently free objects.
  *  - Number of overflows (times that le_mem_ForceAlloc() had to expand the pool).
  *
+ * For pools with @ref mem_thread_cache enabled, the number of cache hits and misses is also
+ * gathered.
+ *
  * Statistics (and other pool properties) can be checked using functions:
  *  - @c le_mem_GetStats()
  *  - @c le_mem_GetObjectCount()
@@ -295,6 +299,34 @@
  * the data structure, then the mutex must be held by the thread that calls le_mem_Release() to
  * ensure there's no other thread accessing the data structure when the destructor runs.
  *
+ * @section mem_thread_cache Per-Thread Caches
+ *
+ * All pools share a single lock, so threads that allocate and release objects at a high rate
+ * (even from different pools) can end up contending for it.  To avoid this, per-thread caching
+ * can be enabled on a pool using @c le_mem_EnableThreadCache(), passing it the maximum number of
+ * free objects that each thread may keep for itself.
+ *
+ * Each thread then allocates from, and releases into, its own cache of free objects without
+ * taking the lock.  The lock is only taken when a thread's cache runs empty, in which case it is
+ * refilled with a batch of objects from the pool, or when it grows beyond its maximum size, in
+ * which case half of it is returned to the pool.  A thread's cache is returned to the pool when
+ * the thread dies.
+ *
+ * @code
+ * MsgPool = le_mem_CreatePool("Messages", sizeof(Msg_t));
+ * le_mem_ExpandPool(MsgPool, 100);
+ * le_mem_EnableThreadCache(MsgPool, 16);
+ * @endcode
+ *
+ * Things to be aware of when using per-thread caches:
+ *  - Free objects sitting in one thread's cache can't be allocated by other threads, so
+ *    @c le_mem_TryAlloc() and @c le_mem_AssertAlloc() can fail even though the pool still has
+ *    free objects.  Use @c le_mem_ForceAlloc() or size the pool to allow for the caches.
+ *  - Statistics are folded into the pool each time a thread refills or drains its cache, so
+ *    they can lag behind reality by up to the cache size per thread.  The cache hit and miss
+ *    counts reported by @c le_mem_GetStats() can be used to tune the cache size.
+ *  - Caching can't be enabled on sub-pools, and can't be disabled once enabled.
+ *
  * @section mem_pool_sizes Managing Pool Sizes
  *
  * We know it's possible to have pools automatically expand
@@ -445,6 +477,11 @@ typedef struct
     size_t      numOverflows;       ///< Number of times le_mem_ForceAlloc() had to expand the pool.
     uint64_t    numAllocs;          ///< Number of times an object has been allocated from this pool.
     size_t      numFree;            ///< Number of free objects currently available in this pool.
+    size_t      numCached;          ///< Number of the free objects that are held in per-thread
+                                    ///  caches, as of the last time each thread synchronized.
+    uint64_t    numCacheHits;       ///< Number of allocations served from a per-thread cache.
+    uint64_t    numCacheMisses;     ///< Number of allocations that had to refill a per-thread
+                                    ///  cache from the pool.
 }
 le_mem_PoolStats_t;
 
@@ -665,6 +702,29 @@ void le_mem_SetNumObjsToForce
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables per-thread caching of free objects for a pool, or changes the size of the per-thread
+ * caches if caching is already enabled.
+ *
+ * See @ref mem_thread_cache for more information.
+ *
+ * @return
+ *      Nothing.
+ *
+ * @note
+ *      Should be called right after the pool is created, before it's used by other threads.
+ *      Can't be used on sub-pools.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_EnableThreadCache
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] Pool to enable per-thread caching on.
+    size_t              numObjects  ///< [IN] Maximum number of free objects each thread may keep
+                                    ///       in its cache for this pool (must be non-zero).
+);
+
+
 #ifndef LE_MEM_TRACE
     //----------------------------------------------------------------------------------------------
     /**
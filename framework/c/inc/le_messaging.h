@@ -141,6 +141,15 @@
  *     msgPayloadPtr->... = ...; // <-- Populate message payload...
  * @endcode
  *
+ * By default, the whole payload buffer is sent.  If only the start of it has been populated
+ * (e.g., a variable-length message was packed into it), the client can call
+ * le_msg_SetPayloadSize() to have only that many bytes sent.  The receiver sees the rest of its
+ * payload buffer filled with zeros.  The same goes for a server populating a response.
+ *
+ * @code
+ *     le_msg_SetPayloadSize(msgRef, packedSize);
+ * @endcode
+ *
  * If no response is required from the server, the client sends the message using le_msg_Send().
  * At this point, the client has handed off the message to the messaging system, and the messaging
  * system will delete the message automatically once it has finished sending it.
@@ -679,6 +688,10 @@
  * From this, they obtain a protocol reference that they provide to sessions when they create
  * them.
  *
+ * Messages always have a payload buffer big enough for the largest message in the protocol.
+ * Only the part of the payload that was used is sent, so any part of a received message's
+ * payload buffer that wasn't sent is filled with zeros.
+ *
  * @section c_messagingSecurity Security
  *
  * Security is provided in the form of authentication and access control.
@@ -742,6 +755,31 @@
  * @warning DO NOT SEND DIRECTORY FILE DESCRIPTORS.  That can be exploited to break out of chroot()
  *          jails.
  *
+ * @section c_messagingSharedMemory Passing Large Payloads Through Shared Memory
+ *
+ * Normally, every message payload is copied into the kernel by the sender and back out again by
+ * the receiver.  For protocols that carry large payloads (such as audio buffers or big lists),
+ * both the client and the server can call le_msg_EnableSharedMemory() on the protocol to have
+ * large payloads passed through a shared memory region instead.
+ *
+ * @code
+ * protocolRef = le_msg_GetProtocolRef(MY_PROTOCOL_ID, sizeof(myproto_Msg_t));
+ * le_msg_EnableSharedMemory(protocolRef, 4096, 256 * 1024);
+ * @endcode
+ *
+ * When a session is opened, each side that has enabled shared memory for the protocol creates a
+ * region of the given size for the payloads it sends and offers it to the other side.  Once the
+ * other side has accepted the offer, payloads at least as big as the threshold are copied into
+ * that region, and only their location is sent through the socket.  Smaller payloads, and any
+ * payload that doesn't fit in the free space left in the region, are still sent through the
+ * socket, so message order is unaffected.  If only one side enables shared memory, everything
+ * is sent through the socket.
+ *
+ * The receiver copies each payload out of the region into the message's payload buffer as soon
+ * as it arrives, so received messages look the same whichever way their payloads were sent.
+ *
+ * The regions are only accessible to the two processes in the session.
+ *
  * @section c_messagingFutureEnhancements Future Enhancements
  *
  * As an optimization to reduce the number of copies in cases where the sender of a message
@@ -951,6 +989,24 @@ size_t le_msg_GetProtocolMaxMsgSize
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables passing of large message payloads through shared memory for sessions using a given
+ * protocol.  See @ref c_messagingSharedMemory.
+ *
+ * Only affects sessions that are opened after this is called.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_msg_EnableSharedMemory
+(
+    le_msg_ProtocolRef_t protocolRef,   ///< [in] Reference to the protocol.
+    size_t thresholdSize,               ///< [in] Payloads this size or bigger are passed through
+                                        ///       shared memory.
+    size_t regionSize                   ///< [in] Size of the shared memory region used for each
+                                        ///       direction of each session (0 = disable).
+);
+
+
 // =======================================
 //  SESSION FUNCTIONS
 // =======================================
@@ -1313,6 +1369,21 @@ size_t le_msg_GetMaxPayloadSize
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the number of bytes at the start of the message payload buffer that are to be sent.
+ * By default, the whole payload buffer is sent.
+ *
+ * @note The receiver sees the rest of its payload buffer filled with zeros.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_msg_SetPayloadSize
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t              size        ///< [in] Number of payload bytes to send.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the file descriptor to be sent with this message.
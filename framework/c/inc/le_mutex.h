@@ -48,6 +48,21 @@
  * All mutexes have names, required for diagnostic purposes.  See
  * @ref c_mutex_diagnostics below.
  *
+ * @subsection c_mutex_lean Lean Mutexes
+ *
+ * Keeping the diagnostic information up to date adds a noticeable cost to every lock and unlock,
+ * even when no other thread wants the mutex.  For mutexes on hot paths, create a @b lean mutex
+ * instead:
+ *  - @c le_mutex_CreateLeanRecursive() - creates a @b lean, @b recursive mutex.
+ *  - @c le_mutex_CreateLeanNonRecursive() - creates a @b lean, @b non-recursive mutex.
+ *
+ * A lean mutex is locked and unlocked with a single atomic operation when there's no contention.
+ * It only records waiting threads, and which thread holds it, while it is contended, so the
+ * diagnostic tools will only show it when some thread has had to wait for it.  Deadlock
+ * detection, recursion, and the checks on unlocking work the same as for a normal mutex.
+ *
+ * All mutexes can be made lean at build time, see @ref bld_cfg_mutex_lean.
+ *
  * @section c_mutex_locking Using a Mutex
  *
  * Functions for locking and unlocking mutexes:
@@ -69,6 +84,7 @@
  * The command-line diagnostic tool @ref toolsTarget_inspect can be used to list the mutexes
  * that currently exist inside a given process.  The state of each mutex can be
  * seen, including a list of any threads that might be waiting for that mutex.
+ * (@ref c_mutex_lean "Lean mutexes" only appear while they are contended.)
  *
  * <HR>
  *
@@ -123,6 +139,34 @@ le_mutex_Ref_t le_mutex_CreateNonRecursive
     const char* nameStr     ///< [in] Name of the mutex
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Lean, Recursive mutex.  See @ref c_mutex_lean.
+ *
+ * @return  Returns a reference to the mutex.
+ *
+ * @note Terminates the process on failure, no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_mutex_Ref_t le_mutex_CreateLeanRecursive
+(
+    const char* nameStr     ///< [in] Name of the mutex
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Lean, Non-Recursive mutex.  See @ref c_mutex_lean.
+ *
+ * @return  Returns a reference to the mutex.
+ *
+ * @note Terminates the process on failure, no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_mutex_Ref_t le_mutex_CreateLeanNonRecursive
+(
+    const char* nameStr     ///< [in] Name of the mutex
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Delete a mutex.
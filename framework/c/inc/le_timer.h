@@ -22,9 +22,10 @@
  *  - @ref le_timer_SetInterval
  *  - @ref le_timer_SetRepeat
  *  - @ref le_timer_SetContextPtr
+ *  - @ref le_timer_SetTolerance
  *
- * The repeat count defaults to 1, so that the timer is initially a one-shot timer. All the other
- * attributes must be explicitly set.  At a minimum, the interval must be set before the timer can be
+ * The repeat count defaults to 1, so that the timer is initially a one-shot timer.  The tolerance
+ * defaults to zero.  All the other attributes must be explicitly set.  At a minimum, the interval must be set before the timer can be
  * used.  Note that these attributes can only be set if the timer is not currently running; otherwise,
  * an error will be returned.
  *
@@ -50,6 +51,20 @@
  * The number of times that a timer has expired can be retrieved by @ref le_timer_GetExpiryCount. This
  * count is independent of whether there is an expiry handler for the timer.
  *
+ * @section le_timer_tolerance Timer Tolerance
+ *
+ * Every time a timer expires, the thread that started it has to wake up to handle it.  A process
+ * with many timers can therefore wake up many times per second, which costs power on a battery
+ * powered device.  If a timer does not need to expire exactly on time, @ref le_timer_SetTolerance
+ * (or @ref le_timer_SetMsTolerance) can be used to say how late it may expire.  The thread's
+ * timers are then handled together: a wakeup is scheduled for the earliest time that a timer would
+ * become later than its tolerance allows, and every timer that has expired by then is handled
+ * by that one wakeup.  Timers never expire early, and a timer with no tolerance still expires on
+ * time, but may take other timers with it.
+ *
+ * @ref le_timer_GetWakeupStats reports how many wakeups the calling thread has had for its timers,
+ * and how many were saved by the tolerances.
+ *
  * @section le_timer_thread Thread Support
  *
  * A timer should only be used by the thread that created it. It's not safe for a thread to use
@@ -71,6 +86,7 @@
  *     - @ref le_timer_SetHandler
  *     - @ref le_timer_SetInterval
  *     - @ref le_timer_SetRepeat
+ *     - @ref le_timer_SetTolerance
  *     - @ref le_timer_Start
  *     - @ref le_timer_Stop
  *     - @ref le_timer_Restart
@@ -127,6 +143,21 @@ typedef void (*le_timer_ExpiryHandler_t)
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer wakeup statistics for a thread.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t    numWakeups;         ///< Number of times the thread woke up to handle its timers.
+    uint64_t    numWakeupsSaved;    ///< Number of timer expiries that were handled by a wakeup
+                                    ///  for an earlier expiry, and would otherwise have needed
+                                    ///  a wakeup of their own.
+}
+le_timer_WakeupStats_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create the timer object.
@@ -218,6 +249,50 @@ le_result_t le_timer_SetMsInterval
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer tolerance.
+ *
+ * The timer may expire up to this much later than its interval, so that its expiry can be
+ * handled together with other timers' expiries.  The default is zero.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetTolerance
+(
+    le_timer_Ref_t timerRef,     ///< [IN] Set tolerance for this timer object.
+    le_clk_Time_t tolerance      ///< [IN] Timer tolerance.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer tolerance using milliseconds.
+ *
+ * The timer may expire up to this many milliseconds later than its interval, so that its expiry
+ * can be handled together with other timers' expiries.  The default is zero.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetMsTolerance
+(
+    le_timer_Ref_t timerRef,    ///< [IN] Set tolerance for this timer object.
+    size_t tolerance            ///< [IN] Timer tolerance in milliseconds.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set how many times the timer will repeat.
@@ -371,5 +446,19 @@ bool le_timer_IsRunning
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the timer wakeup statistics for the calling thread.
+ *
+ * @return
+ *      Nothing.  Uses output parameter instead.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_timer_GetWakeupStats
+(
+    le_timer_WakeupStats_t* statsPtr    ///< [OUT] Pointer to where the stats will be stored.
+);
+
+
 #endif // LEGATO_TIMER_INCLUDE_GUARD
 
@@ -0,0 +1,185 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @page c_workQueue Work Queue API
+ *
+ * @ref le_workQueue.h "API Reference"
+ *
+ * <HR>
+ *
+ * A thread's event loop can only do one thing at a time, so a CPU-bound job (such as decoding a
+ * large message, parsing a big JSON document or hashing a file) holds up everything else that
+ * thread is supposed to be doing.  A Work Queue runs such jobs on a pool of worker threads
+ * instead, and tells the thread that submitted each job when it has finished.
+ *
+ * @section c_workQueue_create Creating a Work Queue
+ *
+ * le_workQueue_Create() creates a Work Queue and starts its worker threads.  If the number of
+ * workers is given as zero, one worker is started for each online CPU, up to
+ * @ref LE_WORKQUEUE_MAX_WORKERS.  Each worker thread is named after the Work Queue, with its
+ * index appended, so long Work Queue names are shortened to leave room for the index.
+ *
+ * @section c_workQueue_submit Submitting Jobs
+ *
+ * le_workQueue_Submit() submits a job to a Work Queue.  It can be called from any thread,
+ * including the Work Queue's own workers.  The job function is called by one of the workers,
+ * with the two parameters that were passed to le_workQueue_Submit().
+ *
+ * If a completion function is given, then once the job function has returned, the completion
+ * function is queued to the Event Queue of the thread that submitted the job (see
+ * le_event_QueueFunctionToThread()), with the same two parameters.  So, the submitting thread
+ * must be running its Event Loop to find out that its jobs have been done, and the job function
+ * can pass results back by writing them into the objects that the parameters point to.
+ *
+ * @code
+ * static void DecodeJob(void* pduPtr, void* resultPtr)
+ * {
+ *     // Runs on a worker thread.
+ *     Decode(pduPtr, resultPtr);
+ * }
+ *
+ * static void DecodeDone(void* pduPtr, void* resultPtr)
+ * {
+ *     // Runs on the thread that called le_workQueue_Submit().
+ *     Deliver(resultPtr);
+ * }
+ *
+ * le_workQueue_Submit(WorkQueueRef, DecodeJob, DecodeDone, pduPtr, resultPtr);
+ * @endcode
+ *
+ * Each worker has its own queue of jobs.  Jobs submitted by a worker go onto its own queue, and
+ * it takes the most recently submitted one first, so a job that splits its work into smaller
+ * jobs keeps working on data that is still in the CPU's cache.  Jobs submitted by other threads
+ * are spread across the workers' queues in turn.  A worker whose queue is empty takes the oldest
+ * job from another worker's queue (work stealing), so no worker sits idle while there is work to
+ * do.  Jobs can therefore run in any order, and in parallel with each other.
+ *
+ * @warning Worker threads don't run an Event Loop, so job functions must not use timers, FD
+ *          Monitors, IPC or anything else that relies on the calling thread's Event Loop.
+ *          Job functions should also not block for long, as that holds up the worker.
+ *
+ * @section c_workQueue_delete Deleting a Work Queue
+ *
+ * le_workQueue_Delete() waits for all of the jobs that have been submitted to the Work Queue to
+ * finish, then stops its workers and deletes it.  No more jobs may be submitted once
+ * le_workQueue_Delete() has been called, and it must not be called by one of the Work Queue's
+ * own workers.  Completion functions for the last jobs may still be waiting on the submitting
+ * threads' Event Queues when it returns.
+ *
+ * <HR>
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/** @file le_workQueue.h
+ *
+ * Legato @ref c_workQueue include file.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_WORK_QUEUE_INCLUDE_GUARD
+#define LEGATO_WORK_QUEUE_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a Work Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_workQueue* le_workQueue_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of worker threads a Work Queue can have.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LE_WORKQUEUE_MAX_WORKERS 64
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype for job functions.  These are called by one of the Work Queue's worker threads.
+ *
+ * @param param1Ptr First parameter passed to le_workQueue_Submit().
+ * @param param2Ptr Second parameter passed to le_workQueue_Submit().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*le_workQueue_JobFunc_t)
+(
+    void* param1Ptr,
+    void* param2Ptr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Work Queue and start its worker threads.
+ *
+ * @return Reference to the Work Queue.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_workQueue_Ref_t le_workQueue_Create
+(
+    const char* nameStr,        ///< [IN] Name of the Work Queue (used to name its workers).
+    size_t numWorkers           ///< [IN] Number of worker threads (0 = one per online CPU),
+                                ///<      at most LE_WORKQUEUE_MAX_WORKERS.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submit a job to a Work Queue.
+ *
+ * The job function will be called by one of the Work Queue's workers.  When it returns, the
+ * completion function (if not NULL) will be queued to the calling thread's Event Queue.  Both
+ * are passed the same two parameters.
+ *
+ * @note If an invalid Work Queue reference is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_workQueue_Submit
+(
+    le_workQueue_Ref_t queueRef,                ///< [IN] Work Queue to run the job.
+    le_workQueue_JobFunc_t jobFunc,             ///< [IN] Job function.
+    le_event_DeferredFunc_t completionFunc,     ///< [IN] Completion function (can be NULL).
+    void* param1Ptr,                            ///< [IN] First parameter for the functions.
+    void* param2Ptr                             ///< [IN] Second parameter for the functions.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of worker threads a Work Queue has.
+ *
+ * @return The number of workers.
+ *
+ * @note If an invalid Work Queue reference is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t le_workQueue_GetNumWorkers
+(
+    le_workQueue_Ref_t queueRef                 ///< [IN] Work Queue.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for all the jobs submitted to a Work Queue to finish, then stop its workers and delete it.
+ *
+ * @note If an invalid Work Queue reference is given, or this is called by one of the Work Queue's
+ *       own workers, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_workQueue_Delete
+(
+    le_workQueue_Ref_t queueRef                 ///< [IN] Work Queue to delete.
+);
+
+
+#endif // LEGATO_WORK_QUEUE_INCLUDE_GUARD
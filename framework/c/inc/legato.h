@@ -22,6 +22,7 @@
  * @subpage c_hashmap <br>
  * @subpage c_hex <br>
  * @subpage c_json <br>
+ * @subpage c_workQueue <br>
  * @subpage c_logging <br>
  * @subpage c_messaging <br>
  * @subpage c_mutex <br>
@@ -205,6 +206,7 @@ extern "C" {
 #include "le_dir.h"
 #include "le_fileLock.h"
 #include "le_json.h"
+#include "le_workQueue.h"
 
 #ifdef __cplusplus
 }
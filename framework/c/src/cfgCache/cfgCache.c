@@ -0,0 +1,1943 @@
+//--------------------------------------------------------------------------------------------------
+/** @file cfgCache.c
+ *
+ * Client-side cache of config tree subtrees.  See cfgCache.h.
+ *
+ * Each subtree that an iterator has been created on has an Entry, kept in the EntryMap by the
+ * subtree's path.  The Entry holds the subtree's records, (as sent by the config tree, see
+ * nodeRecord.h,) until the subtree's change handler is called.  The records are reference counted,
+ * so the iterators that are reading them keep them alive after they've been dropped from the
+ * Entry.  Entries themselves, (and their change handlers,) are never deleted.
+ *
+ * Nodes are found by walking the records, which are never changed once they've been read.  An
+ * iterator keeps the offset of its current node's record and the node's path relative to the top
+ * of the subtree.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "cfgCache.h"
+#include "../limit.h"
+#include "../configTree/nodeRecord.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Offset used for nodes that don't exist in a subtree.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NO_NODE SIZE_MAX
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deepest a node can be below the top of a subtree.  (Each level takes at least two characters of
+ * a path.)
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_DEPTH (LE_CFG_STR_LEN_BYTES / 2)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The records of a subtree, as read from the config tree.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t size;                            ///< Size of the top node's record, in bytes.
+    uint8_t records[];                      ///< The top node's record, (see nodeRecord.h.)
+}
+Subtree_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sizes of the records that the subtree pools can hold.  Most subtrees are small, but the largest
+ * class has to hold the biggest subtree the config tree will send.
+ */
+//--------------------------------------------------------------------------------------------------
+static const size_t SubtreeClassSizes[] = { 1024, 4096, CFG_MAX_SUBTREE_BYTES };
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of subtree size classes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_SUBTREE_CLASSES NUM_ARRAY_MEMBERS(SubtreeClassSizes)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pools for the subtrees, one for each size class.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t SubtreePools[NUM_SUBTREE_CLASSES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A subtree that iterators have been created on.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char path[LE_CFG_STR_LEN_BYTES];        ///< Normalized path of the subtree's top node.
+    le_cfg_ChangeHandlerRef_t handlerRef;   ///< Change handler registered on the subtree.
+    Subtree_t* subtreePtr;                  ///< The cached records, or NULL if not loaded.
+    bool isUncacheable;                     ///< The subtree is too big to cache, or doesn't
+                                            ///<   exist.  Cleared when it changes.
+}
+Entry_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pool for the entries.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t EntryPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map of the entries, keyed by their paths.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t EntryMap;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A cached read iterator.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct cfgCache_Iter
+{
+    Entry_t* entryPtr;                      ///< The subtree the iterator was created on.
+    Subtree_t* subtreePtr;                  ///< The records being read, or NULL if forwarding.
+    size_t nodeOffset;                      ///< Record of the current node, or NO_NODE.
+    char subPath[LE_CFG_STR_LEN_BYTES];     ///< Path of the current node below the top of the
+                                            ///<   subtree.  Empty at the top.
+    le_cfg_IteratorRef_t cfgIterRef;        ///< Read transaction that calls are forwarded to,
+                                            ///<   once the iterator leaves the cached subtree.
+}
+Iter_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pool for the iterators.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t IterPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The cache's counters.  Hits and misses are worked out from the number of requests sent to the
+ * config tree during each call.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct
+{
+    uint64_t callCount;                     ///< Calls that mirror an le_cfg request.
+    uint64_t requestCount;                  ///< Requests sent to the config tree.
+    uint64_t hitCount;
+    uint64_t missCount;
+    uint64_t loadCount;
+    uint64_t invalidateCount;
+}
+Counters;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count a call at its start.
+ *
+ * @return
+ *      The number of requests sent so far, to be passed to EndCall().
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t BeginCall
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Counters.callCount++;
+
+    return Counters.requestCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count a call as a hit or a miss at its end.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndCall
+(
+    uint64_t startRequestCount              ///< [IN] Value returned by BeginCall().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (Counters.requestCount == startRequestCount)
+    {
+        Counters.hitCount++;
+    }
+    else
+    {
+        Counters.missCount++;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the header of a record.  (Records aren't aligned.)
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetHeader
+(
+    const Subtree_t* subtreePtr,            ///< [IN]  The subtree.
+    size_t offset,                          ///< [IN]  Offset of the record.
+    RecordHeader_t* headerPtr               ///< [OUT] The header.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    memcpy(headerPtr, subtreePtr->records + offset, sizeof(*headerPtr));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the name of a record's node.
+ *
+ * @return
+ *      The null terminated name.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* GetName
+(
+    const Subtree_t* subtreePtr,            ///< [IN] The subtree.
+    size_t offset                           ///< [IN] Offset of the record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (const char*)subtreePtr->records + offset + sizeof(RecordHeader_t);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the offset of a record's data, (its children, or its value.)
+ *
+ * @return
+ *      The offset.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetDataOffset
+(
+    size_t offset,                          ///< [IN] Offset of the record.
+    const RecordHeader_t* headerPtr         ///< [IN] The record's header.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return offset + sizeof(*headerPtr) + headerPtr->nameSize + 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the size of a whole record, including its children.
+ *
+ * @return
+ *      The size, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetRecordSize
+(
+    const RecordHeader_t* headerPtr         ///< [IN] The record's header.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return sizeof(*headerPtr) + headerPtr->nameSize + 1 + headerPtr->dataSize;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a record, (and all of its children,) fits within the given bounds and is well formed.
+ *
+ * @return
+ *      true if the record is good.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CheckRecord
+(
+    const Subtree_t* subtreePtr,            ///< [IN] The subtree.
+    size_t offset,                          ///< [IN] Offset of the record.
+    size_t endOffset                        ///< [IN] Offset the record must end by.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RecordHeader_t header;
+
+    if ((endOffset - offset) < sizeof(header))
+    {
+        return false;
+    }
+
+    GetHeader(subtreePtr, offset, &header);
+
+    if (   (header.nameSize > LE_CFG_NAME_LEN)
+        || (GetRecordSize(&header) > (endOffset - offset))
+        || (GetName(subtreePtr, offset)[header.nameSize] != '\0'))
+    {
+        return false;
+    }
+
+    size_t dataOffset = GetDataOffset(offset, &header);
+    size_t dataEnd = dataOffset + header.dataSize;
+
+    switch (header.type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+            return header.dataSize == 0;
+
+        case LE_CFG_TYPE_STEM:
+            while (dataOffset < dataEnd)
+            {
+                RecordHeader_t childHeader;
+
+                if (CheckRecord(subtreePtr, dataOffset, dataEnd) == false)
+                {
+                    return false;
+                }
+
+                GetHeader(subtreePtr, dataOffset, &childHeader);
+                dataOffset += GetRecordSize(&childHeader);
+            }
+            return true;
+
+        case LE_CFG_TYPE_STRING:
+        case LE_CFG_TYPE_BOOL:
+        case LE_CFG_TYPE_INT:
+        case LE_CFG_TYPE_FLOAT:
+            return    (header.dataSize > 0)
+                   && (subtreePtr->records[dataEnd - 1] == '\0');
+
+        default:
+            return false;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a child of a node by name.
+ *
+ * @return
+ *      Offset of the child's record, or NO_NODE if there's no such child.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t FindChild
+(
+    const Subtree_t* subtreePtr,            ///< [IN] The subtree.
+    size_t offset,                          ///< [IN] Offset of the parent's record, or NO_NODE.
+    const char* namePtr,                    ///< [IN] Name of the child.  (Not null terminated.)
+    size_t nameLen                          ///< [IN] Length of the name.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RecordHeader_t header;
+
+    if (offset == NO_NODE)
+    {
+        return NO_NODE;
+    }
+
+    GetHeader(subtreePtr, offset, &header);
+
+    if (header.type != LE_CFG_TYPE_STEM)
+    {
+        return NO_NODE;
+    }
+
+    size_t childOffset = GetDataOffset(offset, &header);
+    size_t dataEnd = childOffset + header.dataSize;
+
+    while (childOffset < dataEnd)
+    {
+        GetHeader(subtreePtr, childOffset, &header);
+
+        if (   (header.nameSize == nameLen)
+            && (memcmp(GetName(subtreePtr, childOffset), namePtr, nameLen) == 0))
+        {
+            return childOffset;
+        }
+
+        childOffset += GetRecordSize(&header);
+    }
+
+    return NO_NODE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a node in a subtree, given the path of a node below the top of the subtree and a path
+ * relative to that node.  "." and ".." are followed, and nodes that don't exist can be passed
+ * through.
+ *
+ * @return
+ *      true if the node is inside the subtree, (whether it exists or not,) false if the path is
+ *      absolute, leads out of the subtree, or is too long.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool FindNode
+(
+    const Subtree_t* subtreePtr,            ///< [IN]  The subtree.
+    const char* basePathPtr,                ///< [IN]  Path below the top of the subtree.
+    const char* pathPtr,                    ///< [IN]  Path relative to that, or NULL.
+    size_t* offsetPtr,                      ///< [OUT] Offset of the node's record, or NO_NODE.
+    char* subPathPtr                        ///< [OUT] Normalized path of the node below the top of
+                                            ///<       the subtree.  LE_CFG_STR_LEN_BYTES long.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char fullPath[LE_CFG_STR_LEN_BYTES * 2];
+    size_t parentOffsets[MAX_DEPTH];
+    size_t depth = 0;
+    size_t offset = 0;
+    size_t subPathLen = 0;
+
+    if (pathPtr == NULL)
+    {
+        pathPtr = "";
+    }
+
+    if ((pathPtr[0] == '/') || (strchr(pathPtr, ':') != NULL))
+    {
+        return false;
+    }
+
+    snprintf(fullPath, sizeof(fullPath), "%s/%s", basePathPtr, pathPtr);
+    subPathPtr[0] = '\0';
+
+    const char* namePtr = fullPath;
+
+    while (*namePtr != '\0')
+    {
+        size_t nameLen = strcspn(namePtr, "/");
+
+        if ((nameLen == 0) || ((nameLen == 1) && (namePtr[0] == '.')))
+        {
+            // Nothing to do.
+        }
+        else if ((nameLen == 2) && (strncmp(namePtr, "..", 2) == 0))
+        {
+            if (depth == 0)
+            {
+                return false;
+            }
+
+            offset = parentOffsets[--depth];
+
+            char* slashPtr = strrchr(subPathPtr, '/');
+            subPathLen = (slashPtr != NULL) ? (size_t)(slashPtr - subPathPtr) : 0;
+            subPathPtr[subPathLen] = '\0';
+        }
+        else
+        {
+            if (   (nameLen > LE_CFG_NAME_LEN)
+                || (depth == MAX_DEPTH)
+                || ((subPathLen + nameLen + 2) > LE_CFG_STR_LEN_BYTES))
+            {
+                return false;
+            }
+
+            parentOffsets[depth++] = offset;
+            offset = FindChild(subtreePtr, offset, namePtr, nameLen);
+
+            if (subPathLen > 0)
+            {
+                subPathPtr[subPathLen++] = '/';
+            }
+
+            memcpy(subPathPtr + subPathLen, namePtr, nameLen);
+            subPathLen += nameLen;
+            subPathPtr[subPathLen] = '\0';
+        }
+
+        namePtr += nameLen;
+
+        if (*namePtr == '/')
+        {
+            namePtr++;
+        }
+    }
+
+    *offsetPtr = offset;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the type of a node.
+ *
+ * @return
+ *      The type, or LE_CFG_TYPE_DOESNT_EXIST.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_cfg_nodeType_t GetType
+(
+    const Subtree_t* subtreePtr,            ///< [IN] The subtree.
+    size_t offset                           ///< [IN] Offset of the node's record, or NO_NODE.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RecordHeader_t header;
+
+    if (offset == NO_NODE)
+    {
+        return LE_CFG_TYPE_DOESNT_EXIST;
+    }
+
+    GetHeader(subtreePtr, offset, &header);
+
+    return header.type;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the value of a leaf node, as it's stored by the config tree.
+ *
+ * @return
+ *      The null terminated value.  Only valid for string, bool, int and float nodes.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* GetValue
+(
+    const Subtree_t* subtreePtr,            ///< [IN] The subtree.
+    size_t offset                           ///< [IN] Offset of the node's record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RecordHeader_t header;
+
+    GetHeader(subtreePtr, offset, &header);
+
+    return (const char*)subtreePtr->records + GetDataOffset(offset, &header);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a node's value as a string, the same way the config tree does.
+ *
+ * @return
+ *      LE_OK if the value was copied, LE_OVERFLOW if the buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadString
+(
+    const Subtree_t* subtreePtr,            ///< [IN]  The subtree.
+    size_t offset,                          ///< [IN]  Offset of the node's record, or NO_NODE.
+    char* valueBufferPtr,                   ///< [OUT] Buffer to copy the value into.
+    size_t valueBufferSize,                 ///< [IN]  Size of the buffer.
+    const char* defaultValuePtr             ///< [IN]  Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (GetType(subtreePtr, offset))
+    {
+        case LE_CFG_TYPE_STRING:
+        case LE_CFG_TYPE_BOOL:
+        case LE_CFG_TYPE_INT:
+        case LE_CFG_TYPE_FLOAT:
+            return le_utf8_Copy(valueBufferPtr,
+                                GetValue(subtreePtr, offset),
+                                valueBufferSize,
+                                NULL);
+
+        default:
+            return le_utf8_Copy(valueBufferPtr, defaultValuePtr, valueBufferSize, NULL);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a node's value as a float, the same way the config tree does.
+ *
+ * @return
+ *      The value, or the default if the node isn't a float or an int.
+ */
+//--------------------------------------------------------------------------------------------------
+static double ReadFloat
+(
+    const Subtree_t* subtreePtr,            ///< [IN] The subtree.
+    size_t offset,                          ///< [IN] Offset of the node's record, or NO_NODE.
+    double defaultValue                     ///< [IN] Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (GetType(subtreePtr, offset))
+    {
+        case LE_CFG_TYPE_INT:
+            return atoi(GetValue(subtreePtr, offset));
+
+        case LE_CFG_TYPE_FLOAT:
+            return atof(GetValue(subtreePtr, offset));
+
+        default:
+            return defaultValue;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a node's value as an int, the same way the config tree does.  Floats are rounded.
+ *
+ * @return
+ *      The value, or the default if the node isn't an int or a float.
+ */
+//--------------------------------------------------------------------------------------------------
+static int32_t ReadInt
+(
+    const Subtree_t* subtreePtr,            ///< [IN] The subtree.
+    size_t offset,                          ///< [IN] Offset of the node's record, or NO_NODE.
+    int32_t defaultValue                    ///< [IN] Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double value;
+
+    switch (GetType(subtreePtr, offset))
+    {
+        case LE_CFG_TYPE_INT:
+            return atoi(GetValue(subtreePtr, offset));
+
+        case LE_CFG_TYPE_FLOAT:
+            value = ReadFloat(subtreePtr, offset, 0.0);
+            return (int)(value >= 0.0 ? value + 0.5 : value - 0.5);
+
+        default:
+            return defaultValue;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a node's value as a bool, the same way the config tree does.
+ *
+ * @return
+ *      The value, or the default if the node isn't a bool.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReadBool
+(
+    const Subtree_t* subtreePtr,            ///< [IN] The subtree.
+    size_t offset,                          ///< [IN] Offset of the node's record, or NO_NODE.
+    bool defaultValue                       ///< [IN] Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (GetType(subtreePtr, offset) != LE_CFG_TYPE_BOOL)
+    {
+        return defaultValue;
+    }
+
+    return strcmp(GetValue(subtreePtr, offset), "f") != 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read exactly the given number of bytes from a file descriptor.
+ *
+ * @return
+ *      true if all of the bytes were read.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReadAll
+(
+    int fd,                                 ///< [IN]  The file descriptor.
+    void* bufferPtr,                        ///< [OUT] Buffer to read into.
+    size_t size                             ///< [IN]  Number of bytes to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint8_t* bytePtr = bufferPtr;
+
+    while (size > 0)
+    {
+        ssize_t bytesRead = read(fd, bytePtr, size);
+
+        if (bytesRead > 0)
+        {
+            bytePtr += bytesRead;
+            size -= bytesRead;
+        }
+        else if ((bytesRead == -1) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a subtree's records from the file descriptor sent by the config tree, into a subtree from
+ * the smallest pool that will hold them.
+ *
+ * @return
+ *      The subtree, or NULL if it couldn't be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static Subtree_t* ReadSubtree
+(
+    int fd                                  ///< [IN] The file descriptor.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RecordHeader_t header;
+
+    if (ReadAll(fd, &header, sizeof(header)) == false)
+    {
+        LE_ERROR("Failed to read subtree header.");
+        return NULL;
+    }
+
+    size_t size = GetRecordSize(&header);
+    size_t classIndex = 0;
+
+    if (size > CFG_MAX_SUBTREE_BYTES)
+    {
+        LE_ERROR("Subtree of %zu bytes is too big.", size);
+        return NULL;
+    }
+
+    while (SubtreeClassSizes[classIndex] < size)
+    {
+        classIndex++;
+    }
+
+    Subtree_t* subtreePtr = le_mem_ForceAlloc(SubtreePools[classIndex]);
+
+    subtreePtr->size = size;
+    memcpy(subtreePtr->records, &header, sizeof(header));
+
+    if (   (ReadAll(fd, subtreePtr->records + sizeof(header), size - sizeof(header)) == false)
+        || (CheckRecord(subtreePtr, 0, size) == false))
+    {
+        LE_ERROR("Failed to read subtree of %zu bytes.", size);
+        le_mem_Release(subtreePtr);
+        return NULL;
+    }
+
+    return subtreePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop an entry's cached records.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DropEntry
+(
+    Entry_t* entryPtr                       ///< [IN] The entry.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (entryPtr->subtreePtr != NULL)
+    {
+        LE_DEBUG("Dropping cached subtree '%s'.", entryPtr->path);
+
+        le_mem_Release(entryPtr->subtreePtr);
+        entryPtr->subtreePtr = NULL;
+
+        Counters.invalidateCount++;
+    }
+
+    entryPtr->isUncacheable = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called by the config tree when something in a cached subtree changes.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ChangeHandler
+(
+    void* contextPtr                        ///< [IN] The subtree's entry.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    DropEntry(contextPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read an entry's subtree from the config tree.  The change handler is registered first, so no
+ * changes can be missed.  If the subtree can't be cached, the entry is marked as uncacheable.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadEntry
+(
+    Entry_t* entryPtr                       ///< [IN] The entry.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = -1;
+
+    if (entryPtr->handlerRef == NULL)
+    {
+        entryPtr->handlerRef = le_cfg_AddChangeHandler(entryPtr->path, ChangeHandler, entryPtr);
+        Counters.requestCount++;
+    }
+
+    le_result_t result = le_cfg_ReadSubtree(entryPtr->path, &fd);
+    Counters.requestCount++;
+    Counters.loadCount++;
+
+    if (result == LE_OK)
+    {
+        entryPtr->subtreePtr = ReadSubtree(fd);
+    }
+
+    if (fd != -1)
+    {
+        close(fd);
+    }
+
+    if (entryPtr->subtreePtr == NULL)
+    {
+        LE_DEBUG("Subtree '%s' can't be cached, (%s).", entryPtr->path, LE_RESULT_TXT(result));
+        entryPtr->isUncacheable = true;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Normalize a path the same way the config tree does for change handlers, so that the same
+ * subtree always gets the same entry.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NormalizePath
+(
+    const char* pathPtr,                    ///< [IN]  The path.
+    char* normalPathPtr                     ///< [OUT] The normalized path.  LE_CFG_STR_LEN_BYTES
+                                            ///<       long.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_pathIter_Ref_t pathIterRef = le_pathIter_CreateForUnix(pathPtr);
+    le_result_t result = le_pathIter_GetPath(pathIterRef, normalPathPtr, LE_CFG_STR_LEN_BYTES);
+
+    le_pathIter_Delete(pathIterRef);
+
+    LE_FATAL_IF(result != LE_OK, "Config path '%s' is too long.", pathPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a subtree's entry, creating it if there isn't one yet.
+ *
+ * @return
+ *      The entry.
+ */
+//--------------------------------------------------------------------------------------------------
+static Entry_t* GetEntry
+(
+    const char* pathPtr                     ///< [IN] Path of the subtree's top node.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char path[LE_CFG_STR_LEN_BYTES];
+
+    NormalizePath(pathPtr, path);
+
+    Entry_t* entryPtr = le_hashmap_Get(EntryMap, path);
+
+    if (entryPtr == NULL)
+    {
+        entryPtr = le_mem_ForceAlloc(EntryPool);
+
+        LE_ASSERT(le_utf8_Copy(entryPtr->path, path, sizeof(entryPtr->path), NULL) == LE_OK);
+        entryPtr->handlerRef = NULL;
+        entryPtr->subtreePtr = NULL;
+        entryPtr->isUncacheable = false;
+
+        le_hashmap_Put(EntryMap, entryPtr->path, entryPtr);
+    }
+
+    return entryPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a node for a quick read in the cached subtrees.  The subtree nearest the node is used.
+ *
+ * @return
+ *      true if the node is in a cached subtree, (whether it exists or not.)
+ */
+//--------------------------------------------------------------------------------------------------
+static bool FindQuickNode
+(
+    const char* pathPtr,                    ///< [IN]  Path of the node.
+    const Subtree_t** subtreePtrPtr,        ///< [OUT] The subtree the node is in.
+    size_t* offsetPtr                       ///< [OUT] Offset of the node's record, or NO_NODE.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char nodePath[LE_CFG_STR_LEN_BYTES];
+    char entryPath[LE_CFG_STR_LEN_BYTES];
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    Entry_t* entryPtr = NULL;
+
+    NormalizePath(pathPtr, nodePath);
+
+    // Try the node itself, then each of its parents in turn.
+    le_pathIter_Ref_t pathIterRef = le_pathIter_CreateForUnix(nodePath);
+    size_t entryPathLen = strlen(nodePath) + 1;
+
+    while (le_pathIter_GetPath(pathIterRef, entryPath, sizeof(entryPath)) == LE_OK)
+    {
+        // Stop if going up didn't get any closer to the root.
+        if (strlen(entryPath) >= entryPathLen)
+        {
+            break;
+        }
+
+        entryPathLen = strlen(entryPath);
+        entryPtr = le_hashmap_Get(EntryMap, entryPath);
+
+        if (   ((entryPtr != NULL) && (entryPtr->subtreePtr != NULL))
+            || (le_pathIter_Append(pathIterRef, "..") != LE_OK))
+        {
+            break;
+        }
+
+        entryPtr = NULL;
+    }
+
+    le_pathIter_Delete(pathIterRef);
+
+    if ((entryPtr == NULL) || (entryPtr->subtreePtr == NULL))
+    {
+        return false;
+    }
+
+    *subtreePtrPtr = entryPtr->subtreePtr;
+
+    return FindNode(entryPtr->subtreePtr, nodePath + entryPathLen, NULL, offsetPtr, subPath);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a node for an iterator call in the iterator's cached subtree.
+ *
+ * @return
+ *      true if the node is in the subtree, (whether it exists or not.)  false if the call has to be
+ *      forwarded to the config tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool FindIterNode
+(
+    Iter_t* iterPtr,                        ///< [IN]  The iterator.
+    const char* pathPtr,                    ///< [IN]  Path relative to the current node, or NULL.
+    size_t* offsetPtr,                      ///< [OUT] Offset of the node's record, or NO_NODE.
+    char* subPathPtr                        ///< [OUT] Path of the node below the top of the
+                                            ///<       subtree.  LE_CFG_STR_LEN_BYTES long.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_FATAL_IF(iterPtr == NULL, "Iterator reference can not be NULL.");
+
+    if (iterPtr->subtreePtr == NULL)
+    {
+        return false;
+    }
+
+    return FindNode(iterPtr->subtreePtr, iterPtr->subPath, pathPtr, offsetPtr, subPathPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move an iterator onto a read transaction at its current node, if it isn't already, so that a
+ * call can be forwarded to the config tree.  The request the call will make is counted.
+ *
+ * @return
+ *      The read transaction's iterator.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_cfg_IteratorRef_t Forward
+(
+    Iter_t* iterPtr                         ///< [IN] The iterator.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (iterPtr->cfgIterRef == NULL)
+    {
+        iterPtr->cfgIterRef = le_cfg_CreateReadTxn(iterPtr->entryPtr->path);
+        Counters.requestCount++;
+
+        if (iterPtr->subPath[0] != '\0')
+        {
+            le_cfg_GoToNode(iterPtr->cfgIterRef, iterPtr->subPath);
+            Counters.requestCount++;
+        }
+
+        le_mem_Release(iterPtr->subtreePtr);
+        iterPtr->subtreePtr = NULL;
+    }
+
+    Counters.requestCount++;
+
+    return iterPtr->cfgIterRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move an iterator to a node in its cached subtree.
+ *
+ * @return
+ *      false if the node's path would be too long, (and the move has to be forwarded instead.)
+ */
+//--------------------------------------------------------------------------------------------------
+static bool MoveToRecord
+(
+    Iter_t* iterPtr,                        ///< [IN] The iterator.
+    const char* parentPathPtr,              ///< [IN] Path of the node's parent below the top of
+                                            ///<      the subtree.
+    size_t offset                           ///< [IN] Offset of the node's record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char subPath[LE_CFG_STR_LEN_BYTES];
+
+    if (snprintf(subPath,
+                 sizeof(subPath),
+                 "%s%s%s",
+                 parentPathPtr,
+                 (parentPathPtr[0] != '\0') ? "/" : "",
+                 GetName(iterPtr->subtreePtr, offset)) >= (int)sizeof(subPath))
+    {
+        return false;
+    }
+
+    strcpy(iterPtr->subPath, subPath);
+    iterPtr->nodeOffset = offset;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a read iterator on a subtree, reading the subtree into the cache if it isn't there yet.
+ * Like le_cfg_CreateReadTxn().
+ *
+ * @return
+ *      The new iterator.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED cfgCache_IterRef_t cfgCache_CreateReadIter
+(
+    const char* basePathPtr                 ///< [IN] Path of the subtree to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+
+    Entry_t* entryPtr = GetEntry(basePathPtr);
+    Iter_t* iterPtr = le_mem_ForceAlloc(IterPool);
+
+    if ((entryPtr->subtreePtr == NULL) && (entryPtr->isUncacheable == false))
+    {
+        LoadEntry(entryPtr);
+    }
+
+    iterPtr->entryPtr = entryPtr;
+    iterPtr->subtreePtr = entryPtr->subtreePtr;
+    iterPtr->nodeOffset = 0;
+    iterPtr->subPath[0] = '\0';
+    iterPtr->cfgIterRef = NULL;
+
+    if (iterPtr->subtreePtr != NULL)
+    {
+        le_mem_AddRef(iterPtr->subtreePtr);
+    }
+    else
+    {
+        iterPtr->cfgIterRef = le_cfg_CreateReadTxn(entryPtr->path);
+        Counters.requestCount++;
+    }
+
+    EndCall(startRequestCount);
+
+    return iterPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a read iterator.  Like le_cfg_CancelTxn().  The subtree stays in the cache.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void cfgCache_DeleteIter
+(
+    cfgCache_IterRef_t iterRef              ///< [IN] The iterator to delete.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_FATAL_IF(iterRef == NULL, "Iterator reference can not be NULL.");
+
+    uint64_t startRequestCount = BeginCall();
+
+    if (iterRef->cfgIterRef != NULL)
+    {
+        le_cfg_CancelTxn(iterRef->cfgIterRef);
+        Counters.requestCount++;
+    }
+
+    if (iterRef->subtreePtr != NULL)
+    {
+        le_mem_Release(iterRef->subtreePtr);
+    }
+
+    le_mem_Release(iterRef);
+
+    EndCall(startRequestCount);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the iterator to another node.  Like le_cfg_GoToNode().
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void cfgCache_GoToNode
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to move.
+    const char* pathPtr                     ///< [IN] Absolute or relative path to the node.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        strcpy(iterRef->subPath, subPath);
+        iterRef->nodeOffset = offset;
+    }
+    else
+    {
+        le_cfg_GoToNode(Forward(iterRef), pathPtr);
+    }
+
+    EndCall(startRequestCount);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the iterator to the parent of its current node.  Like le_cfg_GoToParent().
+ *
+ * @return
+ *      - LE_OK if the iterator was moved.
+ *      - LE_NOT_FOUND if the current node is the root of the tree.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t cfgCache_GoToParent
+(
+    cfgCache_IterRef_t iterRef              ///< [IN] The iterator to move.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    le_result_t result = LE_OK;
+
+    if (FindIterNode(iterRef, "..", &offset, subPath))
+    {
+        strcpy(iterRef->subPath, subPath);
+        iterRef->nodeOffset = offset;
+    }
+    else
+    {
+        result = le_cfg_GoToParent(Forward(iterRef));
+    }
+
+    EndCall(startRequestCount);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the iterator to the first child of its current node.  Like le_cfg_GoToFirstChild().
+ *
+ * @return
+ *      - LE_OK if the iterator was moved.
+ *      - LE_NOT_FOUND if the current node has no children.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t cfgCache_GoToFirstChild
+(
+    cfgCache_IterRef_t iterRef              ///< [IN] The iterator to move.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_FATAL_IF(iterRef == NULL, "Iterator reference can not be NULL.");
+
+    uint64_t startRequestCount = BeginCall();
+    le_result_t result = LE_NOT_FOUND;
+
+    if (iterRef->subtreePtr == NULL)
+    {
+        result = le_cfg_GoToFirstChild(Forward(iterRef));
+    }
+    else if (GetType(iterRef->subtreePtr, iterRef->nodeOffset) == LE_CFG_TYPE_STEM)
+    {
+        RecordHeader_t header;
+        GetHeader(iterRef->subtreePtr, iterRef->nodeOffset, &header);
+
+        if (header.dataSize > 0)
+        {
+            char parentPath[LE_CFG_STR_LEN_BYTES];
+            strcpy(parentPath, iterRef->subPath);
+
+            if (MoveToRecord(iterRef, parentPath, GetDataOffset(iterRef->nodeOffset, &header)))
+            {
+                result = LE_OK;
+            }
+            else
+            {
+                result = le_cfg_GoToFirstChild(Forward(iterRef));
+            }
+        }
+    }
+
+    EndCall(startRequestCount);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the iterator to the next sibling of its current node.  Like le_cfg_GoToNextSibling().
+ *
+ * @return
+ *      - LE_OK if the iterator was moved.
+ *      - LE_NOT_FOUND if the current node has no more siblings.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t cfgCache_GoToNextSibling
+(
+    cfgCache_IterRef_t iterRef              ///< [IN] The iterator to move.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char parentPath[LE_CFG_STR_LEN_BYTES];
+    size_t parentOffset;
+    le_result_t result = LE_NOT_FOUND;
+
+    // The top node's siblings are outside of the cached subtree.
+    if (FindIterNode(iterRef, "..", &parentOffset, parentPath) == false)
+    {
+        result = le_cfg_GoToNextSibling(Forward(iterRef));
+    }
+    else if (iterRef->nodeOffset != NO_NODE)
+    {
+        RecordHeader_t parentHeader;
+        RecordHeader_t header;
+
+        GetHeader(iterRef->subtreePtr, parentOffset, &parentHeader);
+        GetHeader(iterRef->subtreePtr, iterRef->nodeOffset, &header);
+
+        size_t parentEnd = GetDataOffset(parentOffset, &parentHeader) + parentHeader.dataSize;
+        size_t nextOffset = iterRef->nodeOffset + GetRecordSize(&header);
+
+        if (nextOffset < parentEnd)
+        {
+            if (MoveToRecord(iterRef, parentPath, nextOffset))
+            {
+                result = LE_OK;
+            }
+            else
+            {
+                result = le_cfg_GoToNextSibling(Forward(iterRef));
+            }
+        }
+    }
+
+    EndCall(startRequestCount);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the absolute path of the iterator's current node, or of a node relative to it.  Like
+ * le_cfg_GetPath().
+ *
+ * @return
+ *      - LE_OK if the path was copied.
+ *      - LE_OVERFLOW if the buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t cfgCache_GetPath
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN]  The iterator to read.
+    const char* pathPtr,                    ///< [IN]  Path to the node, relative to the current
+                                            ///<       one.  Empty for the current node.
+    char* pathBufferPtr,                    ///< [OUT] Buffer to copy the path into.
+    size_t pathBufferSize                   ///< [IN]  Size of the buffer, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    le_result_t result;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        // Build the path the way the config tree does: from the root, without the tree name.
+        const char* basePathPtr = strchr(iterRef->entryPtr->path, ':');
+        basePathPtr = (basePathPtr != NULL) ? (basePathPtr + 1) : iterRef->entryPtr->path;
+
+        le_pathIter_Ref_t pathIterRef = le_pathIter_CreateForUnix("/");
+
+        result = le_pathIter_Append(pathIterRef, basePathPtr);
+
+        if (result == LE_OK)
+        {
+            result = le_pathIter_Append(pathIterRef, subPath);
+        }
+
+        if (result == LE_OK)
+        {
+            result = le_pathIter_GetPath(pathIterRef, pathBufferPtr, pathBufferSize);
+        }
+
+        le_pathIter_Delete(pathIterRef);
+    }
+    else
+    {
+        result = le_cfg_GetPath(Forward(iterRef), pathPtr, pathBufferPtr, pathBufferSize);
+    }
+
+    EndCall(startRequestCount);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the type of a node.  Like le_cfg_GetNodeType().
+ *
+ * @return
+ *      The node's type, or LE_CFG_TYPE_DOESNT_EXIST.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_cfg_nodeType_t cfgCache_GetNodeType
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr                     ///< [IN] Path to the node.  Empty for the current node.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    le_cfg_nodeType_t type;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        type = GetType(iterRef->subtreePtr, offset);
+    }
+    else
+    {
+        type = le_cfg_GetNodeType(Forward(iterRef), pathPtr);
+    }
+
+    EndCall(startRequestCount);
+
+    return type;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the name of a node.  Like le_cfg_GetNodeName().
+ *
+ * @return
+ *      - LE_OK if the name was copied.
+ *      - LE_OVERFLOW if the buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t cfgCache_GetNodeName
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN]  The iterator to read.
+    const char* pathPtr,                    ///< [IN]  Path to the node.  Empty for the current
+                                            ///<       node.
+    char* nameBufferPtr,                    ///< [OUT] Buffer to copy the name into.
+    size_t nameBufferSize                   ///< [IN]  Size of the buffer, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    le_result_t result;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        const char* namePtr;
+
+        if (offset != NO_NODE)
+        {
+            namePtr = GetName(iterRef->subtreePtr, offset);
+        }
+        else
+        {
+            // A node that doesn't exist is named by the last part of its path.  (The top node
+            // always exists.)
+            namePtr = strrchr(subPath, '/');
+            namePtr = (namePtr != NULL) ? (namePtr + 1) : subPath;
+        }
+
+        result = le_utf8_Copy(nameBufferPtr, namePtr, nameBufferSize, NULL);
+    }
+    else
+    {
+        result = le_cfg_GetNodeName(Forward(iterRef), pathPtr, nameBufferPtr, nameBufferSize);
+    }
+
+    EndCall(startRequestCount);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a node is empty, (or doesn't exist.)  Like le_cfg_IsEmpty().
+ *
+ * @return
+ *      true if the node is empty or doesn't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED bool cfgCache_IsEmpty
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr                     ///< [IN] Path to the node.  Empty for the current node.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    bool isEmpty;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        le_cfg_nodeType_t type = GetType(iterRef->subtreePtr, offset);
+
+        isEmpty = (type == LE_CFG_TYPE_EMPTY) || (type == LE_CFG_TYPE_DOESNT_EXIST);
+    }
+    else
+    {
+        isEmpty = le_cfg_IsEmpty(Forward(iterRef), pathPtr);
+    }
+
+    EndCall(startRequestCount);
+
+    return isEmpty;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a node exists.  Like le_cfg_NodeExists().
+ *
+ * @return
+ *      true if the node exists.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED bool cfgCache_NodeExists
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr                     ///< [IN] Path to the node.  Empty for the current node.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    bool exists;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        exists = (offset != NO_NODE);
+    }
+    else
+    {
+        exists = le_cfg_NodeExists(Forward(iterRef), pathPtr);
+    }
+
+    EndCall(startRequestCount);
+
+    return exists;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a string value.  Like le_cfg_GetString().
+ *
+ * @return
+ *      - LE_OK if the value, (or the default,) was copied.
+ *      - LE_OVERFLOW if the buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t cfgCache_GetString
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN]  The iterator to read.
+    const char* pathPtr,                    ///< [IN]  Path to the node.  Empty for the current
+                                            ///<       node.
+    char* valueBufferPtr,                   ///< [OUT] Buffer to copy the value into.
+    size_t valueBufferSize,                 ///< [IN]  Size of the buffer, in bytes.
+    const char* defaultValuePtr             ///< [IN]  Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    le_result_t result;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        result = ReadString(iterRef->subtreePtr,
+                            offset,
+                            valueBufferPtr,
+                            valueBufferSize,
+                            defaultValuePtr);
+    }
+    else
+    {
+        result = le_cfg_GetString(Forward(iterRef),
+                                  pathPtr,
+                                  valueBufferPtr,
+                                  valueBufferSize,
+                                  defaultValuePtr);
+    }
+
+    EndCall(startRequestCount);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read an integer value.  Like le_cfg_GetInt(), float values are rounded.
+ *
+ * @return
+ *      The value, or the default if the node isn't an int or a float.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED int32_t cfgCache_GetInt
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr,                    ///< [IN] Path to the node.  Empty for the current node.
+    int32_t defaultValue                    ///< [IN] Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    int32_t value;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        value = ReadInt(iterRef->subtreePtr, offset, defaultValue);
+    }
+    else
+    {
+        value = le_cfg_GetInt(Forward(iterRef), pathPtr, defaultValue);
+    }
+
+    EndCall(startRequestCount);
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a floating point value.  Like le_cfg_GetFloat(), int values are converted.
+ *
+ * @return
+ *      The value, or the default if the node isn't a float or an int.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED double cfgCache_GetFloat
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr,                    ///< [IN] Path to the node.  Empty for the current node.
+    double defaultValue                     ///< [IN] Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    double value;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        value = ReadFloat(iterRef->subtreePtr, offset, defaultValue);
+    }
+    else
+    {
+        value = le_cfg_GetFloat(Forward(iterRef), pathPtr, defaultValue);
+    }
+
+    EndCall(startRequestCount);
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a boolean value.  Like le_cfg_GetBool().
+ *
+ * @return
+ *      The value, or the default if the node isn't a bool.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED bool cfgCache_GetBool
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr,                    ///< [IN] Path to the node.  Empty for the current node.
+    bool defaultValue                       ///< [IN] Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    char subPath[LE_CFG_STR_LEN_BYTES];
+    size_t offset;
+    bool value;
+
+    if (FindIterNode(iterRef, pathPtr, &offset, subPath))
+    {
+        value = ReadBool(iterRef->subtreePtr, offset, defaultValue);
+    }
+    else
+    {
+        value = le_cfg_GetBool(Forward(iterRef), pathPtr, defaultValue);
+    }
+
+    EndCall(startRequestCount);
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a string value without an iterator.  Like le_cfg_QuickGetString(), but answered from the
+ * cache if the node is inside a cached subtree.
+ *
+ * @return
+ *      - LE_OK if the value, (or the default,) was copied.
+ *      - LE_OVERFLOW if the buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t cfgCache_QuickGetString
+(
+    const char* pathPtr,                    ///< [IN]  Path to the node.
+    char* valueBufferPtr,                   ///< [OUT] Buffer to copy the value into.
+    size_t valueBufferSize,                 ///< [IN]  Size of the buffer, in bytes.
+    const char* defaultValuePtr             ///< [IN]  Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    const Subtree_t* subtreePtr;
+    size_t offset;
+    le_result_t result;
+
+    if (FindQuickNode(pathPtr, &subtreePtr, &offset))
+    {
+        result = ReadString(subtreePtr, offset, valueBufferPtr, valueBufferSize, defaultValuePtr);
+    }
+    else
+    {
+        result = le_cfg_QuickGetString(pathPtr, valueBufferPtr, valueBufferSize, defaultValuePtr);
+        Counters.requestCount++;
+    }
+
+    EndCall(startRequestCount);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read an integer value without an iterator.  Like le_cfg_QuickGetInt(), but answered from the
+ * cache if the node is inside a cached subtree.
+ *
+ * @return
+ *      The value, or the default if the node isn't an int or a float.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED int32_t cfgCache_QuickGetInt
+(
+    const char* pathPtr,                    ///< [IN] Path to the node.
+    int32_t defaultValue                    ///< [IN] Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    const Subtree_t* subtreePtr;
+    size_t offset;
+    int32_t value;
+
+    if (FindQuickNode(pathPtr, &subtreePtr, &offset))
+    {
+        value = ReadInt(subtreePtr, offset, defaultValue);
+    }
+    else
+    {
+        value = le_cfg_QuickGetInt(pathPtr, defaultValue);
+        Counters.requestCount++;
+    }
+
+    EndCall(startRequestCount);
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a floating point value without an iterator.  Like le_cfg_QuickGetFloat(), but answered
+ * from the cache if the node is inside a cached subtree.
+ *
+ * @return
+ *      The value, or the default if the node isn't a float or an int.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED double cfgCache_QuickGetFloat
+(
+    const char* pathPtr,                    ///< [IN] Path to the node.
+    double defaultValue                     ///< [IN] Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    const Subtree_t* subtreePtr;
+    size_t offset;
+    double value;
+
+    if (FindQuickNode(pathPtr, &subtreePtr, &offset))
+    {
+        value = ReadFloat(subtreePtr, offset, defaultValue);
+    }
+    else
+    {
+        value = le_cfg_QuickGetFloat(pathPtr, defaultValue);
+        Counters.requestCount++;
+    }
+
+    EndCall(startRequestCount);
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a boolean value without an iterator.  Like le_cfg_QuickGetBool(), but answered from the
+ * cache if the node is inside a cached subtree.
+ *
+ * @return
+ *      The value, or the default if the node isn't a bool.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED bool cfgCache_QuickGetBool
+(
+    const char* pathPtr,                    ///< [IN] Path to the node.
+    bool defaultValue                       ///< [IN] Value to use if the node has none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startRequestCount = BeginCall();
+    const Subtree_t* subtreePtr;
+    size_t offset;
+    bool value;
+
+    if (FindQuickNode(pathPtr, &subtreePtr, &offset))
+    {
+        value = ReadBool(subtreePtr, offset, defaultValue);
+    }
+    else
+    {
+        value = le_cfg_QuickGetBool(pathPtr, defaultValue);
+        Counters.requestCount++;
+    }
+
+    EndCall(startRequestCount);
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether one path is the same as, or inside, another one.
+ *
+ * @return
+ *      true if it is.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsWithin
+(
+    const char* innerPathPtr,               ///< [IN] The path that may be inside.
+    const char* outerPathPtr                ///< [IN] The path that may contain it.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t outerLen = strlen(outerPathPtr);
+
+    if (strncmp(innerPathPtr, outerPathPtr, outerLen) != 0)
+    {
+        return false;
+    }
+
+    return    (outerLen == 0)
+           || (innerPathPtr[outerLen] == '\0')
+           || (innerPathPtr[outerLen] == '/')
+           || (outerPathPtr[outerLen - 1] == '/')
+           || (outerPathPtr[outerLen - 1] == ':');
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop the cached copies of any subtrees that include the given node, or are inside it.  They're
+ * read again the next time an iterator is created on them.  The path has to be given the same
+ * way as the subtrees' paths were, (with or without a tree name.)  An empty path drops them all.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void cfgCache_Invalidate
+(
+    const char* pathPtr                     ///< [IN] Path of the node that has changed.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char path[LE_CFG_STR_LEN_BYTES];
+
+    NormalizePath(pathPtr, path);
+
+    le_hashmap_It_Ref_t iterRef = le_hashmap_GetIterator(EntryMap);
+
+    while (le_hashmap_NextNode(iterRef) == LE_OK)
+    {
+        Entry_t* entryPtr = (Entry_t*)le_hashmap_GetValue(iterRef);
+
+        if (IsWithin(entryPtr->path, path) || IsWithin(path, entryPtr->path))
+        {
+            DropEntry(entryPtr);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the cache's counters.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void cfgCache_GetStats
+(
+    cfgCache_Stats_t* statsPtr              ///< [OUT] The counters.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    statsPtr->hitCount = Counters.hitCount;
+    statsPtr->missCount = Counters.missCount;
+    statsPtr->loadCount = Counters.loadCount;
+    statsPtr->invalidateCount = Counters.invalidateCount;
+    statsPtr->roundTripsSaved = (int64_t)Counters.callCount - (int64_t)Counters.requestCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the cache's pools and entry map.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    size_t i;
+
+    for (i = 0; i < NUM_SUBTREE_CLASSES; i++)
+    {
+        char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES];
+
+        snprintf(poolName, sizeof(poolName), "cfgCacheSubtree%zu", SubtreeClassSizes[i]);
+        SubtreePools[i] = le_mem_CreatePool(poolName, sizeof(Subtree_t) + SubtreeClassSizes[i]);
+    }
+
+    EntryPool = le_mem_CreatePool("cfgCacheEntry", sizeof(Entry_t));
+    IterPool = le_mem_CreatePool("cfgCacheIter", sizeof(Iter_t));
+
+    EntryMap = le_hashmap_CreateDynamic("cfgCacheEntries",
+                                        31,
+                                        le_hashmap_HashString,
+                                        le_hashmap_EqualsString);
+}
@@ -0,0 +1,379 @@
+//--------------------------------------------------------------------------------------------------
+/** @file cfgCache.h
+ *
+ * A client-side cache of config tree subtrees, for programs that read the same parts of the config
+ * tree over and over, (like the Supervisor reading an app's configuration each time it starts the
+ * app.)  Every le_cfg read is a round-trip to the config tree daemon, which adds up quickly when
+ * dozens of values are read for each app.
+ *
+ * A subtree is read from the config tree in one request, (le_cfg_ReadSubtree(),) the first time a
+ * read iterator is created on it.  After that, reads from iterators on that subtree are answered
+ * from the local copy, without any IPC at all.  Quick reads of values inside a cached subtree are
+ * answered from it too.  The functions mirror the le_cfg read functions, and behave the same way.
+ *
+ * A change handler is registered on each cached subtree, and the local copy is dropped as soon as
+ * the config tree reports that something in it has changed.  The next iterator created on it reads
+ * it again.  Iterators that are already open keep reading the copy they started with, so, like a
+ * read transaction, they always see a consistent view of the tree.
+ *
+ * @warning Change notifications are delivered asynchronously, through the event loop of the
+ * thread that uses the cache.  Until the notification has been handled, reads return the old
+ * values, including just after this program has changed them itself.  Call cfgCache_Invalidate()
+ * after writing to a cached subtree to see the change straight away.  Programs that don't run
+ * their event loop regularly should not use the cache.
+ *
+ * Subtrees bigger than CFG_MAX_SUBTREE_BYTES (16 KB) can't be cached.  Iterators on them, and
+ * iterators that move out of their cached subtree, (or are given an absolute path,) transparently
+ * fall back to a regular read transaction.
+ *
+ * The cache must only be used by one thread.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#ifndef LEGATO_CFG_CACHE_INCLUDE_GUARD
+#define LEGATO_CFG_CACHE_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a cached read iterator.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct cfgCache_Iter* cfgCache_IterRef_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counters kept by the cache, (see cfgCache_GetStats().)
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t hitCount;         ///< Calls answered without any request to the config tree.
+    uint64_t missCount;        ///< Calls that needed at least one request to the config tree.
+    uint64_t loadCount;        ///< Requests to read a subtree from the config tree.
+    uint64_t invalidateCount;  ///< Cached subtrees dropped because they changed.
+    int64_t roundTripsSaved;   ///< Requests the calls would have made without the cache, less the
+                               ///<   requests that the cache actually made.
+}
+cfgCache_Stats_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a read iterator on a subtree, reading the subtree into the cache if it isn't there yet.
+ * Like le_cfg_CreateReadTxn().
+ *
+ * @return The new iterator.
+ */
+//--------------------------------------------------------------------------------------------------
+cfgCache_IterRef_t cfgCache_CreateReadIter
+(
+    const char* basePathPtr                 ///< [IN] Path of the subtree to read.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a read iterator.  Like le_cfg_CancelTxn().  The subtree stays in the cache.
+ */
+//--------------------------------------------------------------------------------------------------
+void cfgCache_DeleteIter
+(
+    cfgCache_IterRef_t iterRef              ///< [IN] The iterator to delete.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the iterator to another node.  Like le_cfg_GoToNode().
+ */
+//--------------------------------------------------------------------------------------------------
+void cfgCache_GoToNode
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to move.
+    const char* pathPtr                     ///< [IN] Absolute or relative path to the node.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the iterator to the parent of its current node.  Like le_cfg_GoToParent().
+ *
+ * @return
+ *      - LE_OK if the iterator was moved.
+ *      - LE_NOT_FOUND if the current node is the root of the tree.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cfgCache_GoToParent
+(
+    cfgCache_IterRef_t iterRef              ///< [IN] The iterator to move.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the iterator to the first child of its current node.  Like le_cfg_GoToFirstChild().
+ *
+ * @return
+ *      - LE_OK if the iterator was moved.
+ *      - LE_NOT_FOUND if the current node has no children.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cfgCache_GoToFirstChild
+(
+    cfgCache_IterRef_t iterRef              ///< [IN] The iterator to move.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the iterator to the next sibling of its current node.  Like le_cfg_GoToNextSibling().
+ *
+ * @return
+ *      - LE_OK if the iterator was moved.
+ *      - LE_NOT_FOUND if the current node has no more siblings.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cfgCache_GoToNextSibling
+(
+    cfgCache_IterRef_t iterRef              ///< [IN] The iterator to move.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the absolute path of the iterator's current node, or of a node relative to it.  Like
+ * le_cfg_GetPath().
+ *
+ * @return
+ *      - LE_OK if the path was copied.
+ *      - LE_OVERFLOW if the buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cfgCache_GetPath
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN]  The iterator to read.
+    const char* pathPtr,                    ///< [IN]  Path to the node, relative to the current
+                                            ///<       one.  Empty for the current node.
+    char* pathBufferPtr,                    ///< [OUT] Buffer to copy the path into.
+    size_t pathBufferSize                   ///< [IN]  Size of the buffer, in bytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the type of a node.  Like le_cfg_GetNodeType().
+ *
+ * @return The node's type, or LE_CFG_TYPE_DOESNT_EXIST.
+ */
+//--------------------------------------------------------------------------------------------------
+le_cfg_nodeType_t cfgCache_GetNodeType
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr                     ///< [IN] Path to the node.  Empty for the current node.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the name of a node.  Like le_cfg_GetNodeName().
+ *
+ * @return
+ *      - LE_OK if the name was copied.
+ *      - LE_OVERFLOW if the buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cfgCache_GetNodeName
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN]  The iterator to read.
+    const char* pathPtr,                    ///< [IN]  Path to the node.  Empty for the current
+                                            ///<       node.
+    char* nameBufferPtr,                    ///< [OUT] Buffer to copy the name into.
+    size_t nameBufferSize                   ///< [IN]  Size of the buffer, in bytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a node is empty, (or doesn't exist.)  Like le_cfg_IsEmpty().
+ *
+ * @return true if the node is empty or doesn't exist.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cfgCache_IsEmpty
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr                     ///< [IN] Path to the node.  Empty for the current node.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a node exists.  Like le_cfg_NodeExists().
+ *
+ * @return true if the node exists.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cfgCache_NodeExists
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr                     ///< [IN] Path to the node.  Empty for the current node.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a string value.  Like le_cfg_GetString().
+ *
+ * @return
+ *      - LE_OK if the value, (or the default,) was copied.
+ *      - LE_OVERFLOW if the buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cfgCache_GetString
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN]  The iterator to read.
+    const char* pathPtr,                    ///< [IN]  Path to the node.  Empty for the current
+                                            ///<       node.
+    char* valueBufferPtr,                   ///< [OUT] Buffer to copy the value into.
+    size_t valueBufferSize,                 ///< [IN]  Size of the buffer, in bytes.
+    const char* defaultValuePtr             ///< [IN]  Value to use if the node has none.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read an integer value.  Like le_cfg_GetInt(), float values are rounded.
+ *
+ * @return The value, or the default if the node isn't an int or a float.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t cfgCache_GetInt
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr,                    ///< [IN] Path to the node.  Empty for the current node.
+    int32_t defaultValue                    ///< [IN] Value to use if the node has none.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a floating point value.  Like le_cfg_GetFloat(), int values are converted.
+ *
+ * @return The value, or the default if the node isn't a float or an int.
+ */
+//--------------------------------------------------------------------------------------------------
+double cfgCache_GetFloat
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr,                    ///< [IN] Path to the node.  Empty for the current node.
+    double defaultValue                     ///< [IN] Value to use if the node has none.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a boolean value.  Like le_cfg_GetBool().
+ *
+ * @return The value, or the default if the node isn't a bool.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cfgCache_GetBool
+(
+    cfgCache_IterRef_t iterRef,             ///< [IN] The iterator to read.
+    const char* pathPtr,                    ///< [IN] Path to the node.  Empty for the current node.
+    bool defaultValue                       ///< [IN] Value to use if the node has none.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a string value without an iterator.  Like le_cfg_QuickGetString(), but answered from the
+ * cache if the node is inside a cached subtree.  (Quick reads don't add subtrees to the cache.)
+ *
+ * @return
+ *      - LE_OK if the value, (or the default,) was copied.
+ *      - LE_OVERFLOW if the buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cfgCache_QuickGetString
+(
+    const char* pathPtr,                    ///< [IN]  Path to the node.
+    char* valueBufferPtr,                   ///< [OUT] Buffer to copy the value into.
+    size_t valueBufferSize,                 ///< [IN]  Size of the buffer, in bytes.
+    const char* defaultValuePtr             ///< [IN]  Value to use if the node has none.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read an integer value without an iterator.  Like le_cfg_QuickGetInt(), but answered from the
+ * cache if the node is inside a cached subtree.
+ *
+ * @return The value, or the default if the node isn't an int or a float.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t cfgCache_QuickGetInt
+(
+    const char* pathPtr,                    ///< [IN] Path to the node.
+    int32_t defaultValue                    ///< [IN] Value to use if the node has none.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a floating point value without an iterator.  Like le_cfg_QuickGetFloat(), but answered
+ * from the cache if the node is inside a cached subtree.
+ *
+ * @return The value, or the default if the node isn't a float or an int.
+ */
+//--------------------------------------------------------------------------------------------------
+double cfgCache_QuickGetFloat
+(
+    const char* pathPtr,                    ///< [IN] Path to the node.
+    double defaultValue                     ///< [IN] Value to use if the node has none.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a boolean value without an iterator.  Like le_cfg_QuickGetBool(), but answered from the
+ * cache if the node is inside a cached subtree.
+ *
+ * @return The value, or the default if the node isn't a bool.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cfgCache_QuickGetBool
+(
+    const char* pathPtr,                    ///< [IN] Path to the node.
+    bool defaultValue                       ///< [IN] Value to use if the node has none.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop the cached copies of any subtrees that include the given node, or are inside it.  They're
+ * read again the next time an iterator is created on them.  The path has to be given the same
+ * way as the subtrees' paths were, (with or without a tree name.)  An empty path drops them all.
+ */
+//--------------------------------------------------------------------------------------------------
+void cfgCache_Invalidate
+(
+    const char* pathPtr                     ///< [IN] Path of the node that has changed.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the cache's counters.
+ */
+//--------------------------------------------------------------------------------------------------
+void cfgCache_GetStats
+(
+    cfgCache_Stats_t* statsPtr              ///< [OUT] The counters.
+);
+
+
+#endif  // LEGATO_CFG_CACHE_INCLUDE_GUARD
@@ -13,7 +13,7 @@
 
 #include "legato.h"
 #include "interfaces.h"
-#include "dynamicString.h"
+#include "nodeString.h"
 #include "treeDb.h"
 #include "treeUser.h"
 #include "nodeIterator.h"
@@ -92,7 +92,7 @@ COMPONENT_INIT
     LE_DEBUG("** Config Tree, begin init.");
 
     // Initilize our internal subsystems.
-    dstr_Init();   // Dynamic strings.
+    nstr_Init();   // Node names and values.
     rq_Init();     // Request queue.
     ni_Init();     // Node iterator.
     ti_Init();     // Tree iterator.
@@ -12,7 +12,6 @@
 
 #include "legato.h"
 #include "interfaces.h"
-#include "dynamicString.h"
 #include "treeDb.h"
 #include "treeUser.h"
 #include "treePath.h"
@@ -219,8 +218,8 @@ static tdb_TreeRef_t QuickGetTree
  *         Once the read timeout expires, then all active read iterators on that tree will be
  *         expired and the clients killed.
  *
- *  @note: A tree transaction is global to that tree; a long held read transaction will block other
- *         users write transactions from being comitted.
+ *  @note: A read transaction doesn't block other users write transactions from being comitted.  It
+ *         keeps seeing the tree as it was when it was created.
  *
  *  @return This will return a newly created iterator reference.
  */
@@ -1551,3 +1550,44 @@ void le_cfg_QuickSetBool
                               value);
     }
 }
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a whole subtree in one go.  The records of the node and all of its children are sent back
+ *  through a pipe, (see nodeRecord.h.)
+ *
+ *  \b Responds \b With:
+ *
+ *  This function will respond with one of the following values:
+ *
+ *          - LE_OK            - The subtree can be read from the returned file descriptor.
+ *          - LE_NOT_FOUND     - The node doesn't exist.
+ *          - LE_OVERFLOW      - The subtree is too big to be sent in one go.
+ *          - LE_FAULT         - The subtree could not be sent.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_ReadSubtree
+(
+    le_cfg_ServerCmdRef_t commandRef,  ///< [IN] Reference used to generate a reply for this
+                                       ///<      request.
+    const char* pathPtr                ///< [IN] Path to the top node of the subtree.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Read subtree at \"%s\".", pathPtr);
+
+    tu_UserRef_t userRef = tu_GetCurrentConfigUserInfo();
+    tdb_TreeRef_t treeRef = QuickGetTree(userRef, TU_TREE_READ, pathPtr);
+
+    if (treeRef != NULL)
+    {
+        rq_HandleReadSubtree(le_cfg_GetClientSessionRef(),
+                             commandRef,
+                             userRef,
+                             treeRef,
+                             tp_GetPathOnly(pathPtr));
+    }
+}
@@ -64,6 +64,10 @@ typedef struct Iterator
     bool isTerminated;               ///< Has the iterator been closed due to a fatal error?
 
     le_pathIter_Ref_t pathIterRef;   ///< Path to the iterator's current node.
+    tdb_NodeRef_t rootNodeRef;       ///< Root node of the version of the tree that this iterator
+                                     ///<   sees.  For a read iterator, this can be an older
+                                     ///<   version than the tree's current one.  (See
+                                     ///<   ni_MoveToVersion().)
     tdb_NodeRef_t currentNodeRef;    ///< The current node itself.
 
 
@@ -291,7 +295,8 @@ ni_IteratorRef_t ni_CreateIterator
 
     // Get the root node of the requested tree, or if this is a write iterator...  Get the shadowed
     // root node of the tree.
-    iteratorRef->currentNodeRef = tdb_GetRootNode(iteratorRef->treeRef);
+    iteratorRef->rootNodeRef = tdb_GetRootNode(iteratorRef->treeRef);
+    iteratorRef->currentNodeRef = iteratorRef->rootNodeRef;
     iteratorRef->pathIterRef = le_pathIter_CreateForUnix("/");
 
 
@@ -574,6 +579,50 @@ tdb_TreeRef_t ni_GetTree
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the root node of the version of the tree that this iterator sees.
+ *
+ *  @return A pointer to the root node.
+ */
+//--------------------------------------------------------------------------------------------------
+tdb_NodeRef_t ni_GetRootNode
+(
+    ni_ConstIteratorRef_t iteratorRef  ///< [IN] The iterator object to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(iteratorRef != NULL);
+    return iteratorRef->rootNodeRef;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Move a read iterator onto another version of its tree, (a copy of the version it was on.)  The
+ *  iterator stays on the same path, and its current node becomes the node at that path in the new
+ *  version.
+ */
+//--------------------------------------------------------------------------------------------------
+void ni_MoveToVersion
+(
+    ni_IteratorRef_t iteratorRef,  ///< [IN] The iterator object to update.
+    tdb_NodeRef_t rootNodeRef      ///< [IN] Root node of the version to move to.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(iteratorRef != NULL);
+    LE_ASSERT(iteratorRef->type == NI_READ);
+
+    iteratorRef->rootNodeRef = rootNodeRef;
+    iteratorRef->currentNodeRef = tdb_GetNode(rootNodeRef, iteratorRef->pathIterRef);
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  This function will find all iterators that have active safe refs.  For each found
@@ -630,11 +679,8 @@ le_result_t ni_GoToNode
 
     if (result == LE_OK)
     {
-        tdb_TreeRef_t treeRef = iteratorRef->treeRef;
-
-        iteratorRef->currentNodeRef = tdb_GetNode(tdb_GetRootNode(treeRef),
+        iteratorRef->currentNodeRef = tdb_GetNode(iteratorRef->rootNodeRef,
                                                   iteratorRef->pathIterRef);
-
     }
 
     return result;
@@ -668,7 +714,7 @@ tdb_NodeRef_t ni_GetNode
         return NULL;
     }
 
-    tdb_NodeRef_t nodeRef = tdb_GetNode(tdb_GetRootNode(iteratorRef->treeRef), newPathRef);
+    tdb_NodeRef_t nodeRef = tdb_GetNode(iteratorRef->rootNodeRef, newPathRef);
 
     le_pathIter_Delete(newPathRef);
 
@@ -704,12 +750,11 @@ tdb_NodeRef_t ni_TryCreateNode
 
     // Attempt to find the node in the tree.  If not found attempt to create the new node in the
     // tree.
-    tdb_NodeRef_t rootNodeRef = tdb_GetRootNode(iteratorRef->treeRef);
-    tdb_NodeRef_t nodeRef = tdb_GetNode(rootNodeRef, newPathRef);
+    tdb_NodeRef_t nodeRef = tdb_GetNode(iteratorRef->rootNodeRef, newPathRef);
 
     if (nodeRef == NULL)
     {
-        nodeRef = tdb_CreateNodePath(rootNodeRef, newPathRef);
+        nodeRef = tdb_CreateNodePath(iteratorRef->rootNodeRef, newPathRef);
     }
 
     le_pathIter_Delete(newPathRef);
@@ -236,6 +236,37 @@ tdb_TreeRef_t ni_GetTree
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the root node of the version of the tree that this iterator sees.
+ *
+ *  @return A pointer to the root node.
+ */
+//--------------------------------------------------------------------------------------------------
+tdb_NodeRef_t ni_GetRootNode
+(
+    ni_ConstIteratorRef_t iteratorRef  ///< [IN] The iterator object to read.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Move a read iterator onto another version of its tree, (a copy of the version it was on.)  The
+ *  iterator stays on the same path, and its current node becomes the node at that path in the new
+ *  version.
+ */
+//--------------------------------------------------------------------------------------------------
+void ni_MoveToVersion
+(
+    ni_IteratorRef_t iteratorRef,  ///< [IN] The iterator object to update.
+    tdb_NodeRef_t rootNodeRef      ///< [IN] Root node of the version to move to.
+);
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  This function will find all iterators that have active safe refs.  For each found
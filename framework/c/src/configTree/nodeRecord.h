@@ -0,0 +1,55 @@
+// -------------------------------------------------------------------------------------------------
+/**
+ *  @file nodeRecord.h
+ *
+ *  Binary format of the node records that the config tree writes into its snapshot files, and
+ *  that it sends to clients that read a whole subtree at once, (see le_cfg_ReadSubtree().)
+ *
+ *  A record is a RecordHeader_t, followed by the node's name, (with a null terminator,) then by
+ *  the node's data.  For a stem the data is its children's records, one after another.  For other
+ *  types of node it's the node's value as a null terminated string, (just as it's kept by the tree
+ *  itself: "t" or "f" for a bool, decimal text for an int or a float.)  Empty nodes have no data.
+ *
+ *  Records are not aligned, so headers must be copied out before they're used.  They're in the
+ *  byte order of the device that wrote them.
+ *
+ *  Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+// -------------------------------------------------------------------------------------------------
+
+#ifndef CFG_NODE_RECORD_INCLUDE_GUARD
+#define CFG_NODE_RECORD_INCLUDE_GUARD
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Header of a node record.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct RecordHeader
+{
+    uint8_t type;        ///< The le_cfg_nodeType_t of the node.
+    uint8_t reserved;    ///< Always zero.
+    uint16_t nameSize;   ///< Length of the node's name, not including the terminator.  The root
+                         ///<   node's name is empty.
+    uint32_t dataSize;   ///< Size of the node's data, in bytes.
+}
+RecordHeader_t;
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Largest subtree, (the size of its top node's record,) that will be sent to a client in one go.
+ *  Bigger subtrees have to be read through a read transaction.
+ */
+// -------------------------------------------------------------------------------------------------
+#define CFG_MAX_SUBTREE_BYTES (16 * 1024)
+
+
+
+
+#endif
@@ -0,0 +1,417 @@
+// -------------------------------------------------------------------------------------------------
+/**
+ *  @file nodeString.c
+ *
+ *  Storage for the names and values of the config tree's nodes.  See nodeString.h.
+ *
+ *  Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+// -------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+#include "limit.h"
+#include "nodeString.h"
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  The string object.  The text follows the header in the same block.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct Nstr
+{
+    uint32_t hash;      ///< Hash of the text if this is a name, (see HashName().)  Zero otherwise.
+    uint16_t length;    ///< Number of bytes in the text, not including the null terminator.
+    bool isName;        ///< True if this string is in the name table.
+    char text[];        ///< The null terminated text itself.
+}
+Nstr_t;
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Sizes of the string objects, (including their headers,) in each of the size class pools.  Most
+ *  node names and values are short, so the small classes are closely spaced.  The largest class
+ *  holds the longest value that the config tree allows.
+ */
+//--------------------------------------------------------------------------------------------------
+static const size_t ClassSizes[] =
+{
+    16, 24, 32, 48, 64, 96, 128, 256, sizeof(Nstr_t) + LE_CFG_STR_LEN_BYTES
+};
+
+
+/// Number of size classes.
+#define NUM_CLASSES NUM_ARRAY_MEMBERS(ClassSizes)
+
+
+/// The size class pools.
+static le_mem_PoolRef_t ClassPools[NUM_CLASSES];
+
+
+/// Name of the size class pools.  The object size of the class is appended.
+#define CFG_NSTR_POOL_NAME "nodeString"
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Table of the interned names, keyed by their text.  Names are only referenced by the table, (not
+ *  counted,) so they are removed from it when the last node using them releases them.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t NameTableRef = NULL;
+
+
+/// Name of the name table.
+#define CFG_NAME_TABLE_NAME "nodeNameTable"
+
+
+/// Number of names the name table starts out with room for.  It grows as needed.
+#define CFG_NAME_TABLE_INITIAL_SIZE 1024
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Compute the hash of a node name.  (This is the 32-bit FNV-1a hash, which is quick to compute for
+ *  short strings like node names.)
+ *
+ *  @return The hash value.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t HashName
+(
+    const char* namePtr  ///< [IN] The name to hash.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t hash = 2166136261u;
+
+    while (*namePtr != '\0')
+    {
+        hash ^= (uint8_t)*namePtr;
+        hash *= 16777619u;
+        namePtr++;
+    }
+
+    return hash;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Allocate a string object from the smallest size class that will hold the given text, and copy
+ *  the text into it.  Text that doesn't fit in the largest class is truncated.
+ *
+ *  @return The new string object.
+ */
+//--------------------------------------------------------------------------------------------------
+static nstr_Ref_t NewString
+(
+    const char* textPtr,  ///< [IN] The text for the string.
+    bool isName           ///< [IN] Will the new string be a name?
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t length = strnlen(textPtr, LE_CFG_STR_LEN_BYTES);
+    size_t classIndex = 0;
+
+    while (   (classIndex < (NUM_CLASSES - 1))
+           && (ClassSizes[classIndex] < (sizeof(Nstr_t) + length + 1)))
+    {
+        classIndex++;
+    }
+
+    nstr_Ref_t strRef = le_mem_ForceAlloc(ClassPools[classIndex]);
+    size_t bytesCopied = 0;
+
+    if (le_utf8_Copy(strRef->text,
+                     textPtr,
+                     ClassSizes[classIndex] - sizeof(Nstr_t),
+                     &bytesCopied) == LE_OVERFLOW)
+    {
+        LE_WARN("String of %zu bytes or more truncated to %zu bytes.", length, bytesCopied);
+    }
+
+    strRef->length = bytesCopied;
+    strRef->isName = isName;
+    strRef->hash = isName ? HashName(strRef->text) : 0;
+
+    return strRef;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Called when the last reference to a string is released.  Names are removed from the name table.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StringDestructor
+(
+    void* objectPtr  ///< [IN] The string being freed.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    nstr_Ref_t strRef = objectPtr;
+
+    if (strRef->isName)
+    {
+        LE_ASSERT(le_hashmap_Remove(NameTableRef, strRef->text) == strRef);
+    }
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Init the node string module and the internal memory resources it depends on.
+ */
+//--------------------------------------------------------------------------------------------------
+void nstr_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t i;
+
+    for (i = 0; i < NUM_CLASSES; i++)
+    {
+        char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES];
+
+        snprintf(poolName, sizeof(poolName), CFG_NSTR_POOL_NAME "%zu", ClassSizes[i]);
+
+        ClassPools[i] = le_mem_CreatePool(poolName, ClassSizes[i]);
+        le_mem_SetDestructor(ClassPools[i], StringDestructor);
+    }
+
+    NameTableRef = le_hashmap_CreateDynamic(CFG_NAME_TABLE_NAME,
+                                            CFG_NAME_TABLE_INITIAL_SIZE,
+                                            le_hashmap_HashString,
+                                            le_hashmap_EqualsString);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the interned string for a node name, adding it to the name table if it isn't there yet.
+ *  The caller gets a new reference to the string, which must be released with nstr_Release().
+ *
+ *  @return Reference to the name string.
+ */
+//--------------------------------------------------------------------------------------------------
+nstr_Ref_t nstr_GetName
+(
+    const char* namePtr  ///< [IN] The name to look up.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(namePtr != NULL);
+
+    nstr_Ref_t strRef = le_hashmap_Get(NameTableRef, namePtr);
+
+    if (strRef != NULL)
+    {
+        le_mem_AddRef(strRef);
+        return strRef;
+    }
+
+    strRef = NewString(namePtr, true);
+    le_hashmap_Put(NameTableRef, strRef->text, strRef);
+
+    return strRef;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Look for a node name in the name table, without adding it.  No reference is taken, so the
+ *  string is only good for comparing with the names of existing nodes.
+ *
+ *  @return Reference to the name string, or NULL if no node currently has that name.
+ */
+//--------------------------------------------------------------------------------------------------
+nstr_Ref_t nstr_FindName
+(
+    const char* namePtr  ///< [IN] The name to look up.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(namePtr != NULL);
+
+    return le_hashmap_Get(NameTableRef, namePtr);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Create a new value string, copied from a C-string.  Values longer than LE_CFG_STR_LEN bytes are
+ *  truncated.
+ *
+ *  @return Reference to the new string.
+ */
+//--------------------------------------------------------------------------------------------------
+nstr_Ref_t nstr_NewValue
+(
+    const char* valuePtr  ///< [IN] The value to copy.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(valuePtr != NULL);
+
+    return NewString(valuePtr, false);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Take another reference to a string.
+ */
+//--------------------------------------------------------------------------------------------------
+void nstr_AddRef
+(
+    nstr_Ref_t strRef  ///< [IN] The string to reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(strRef != NULL);
+
+    le_mem_AddRef(strRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Release a reference to a string.  The string is freed, (and a name is removed from the name
+ *  table,) when its last reference is released.
+ */
+//--------------------------------------------------------------------------------------------------
+void nstr_Release
+(
+    nstr_Ref_t strRef  ///< [IN] The string to release.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(strRef != NULL);
+
+    le_mem_Release(strRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the text of a string.  The pointer is valid for as long as the reference is held.
+ *
+ *  @return Pointer to the null terminated text.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* nstr_GetText
+(
+    nstr_Ref_t strRef  ///< [IN] The string to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(strRef != NULL);
+
+    return strRef->text;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the length of a string.
+ *
+ *  @return The number of bytes in the string, not including the null terminator.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t nstr_GetLength
+(
+    nstr_Ref_t strRef  ///< [IN] The string to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(strRef != NULL);
+
+    return strRef->length;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the hash of a node name.  (This is the 32-bit FNV-1a hash, which is quick to compute for
+ *  short strings like node names.)  It's computed once, when the name is added to the name table.
+ *
+ *  @return The hash value, or zero if the string is a value rather than a name.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t nstr_GetHash
+(
+    nstr_Ref_t strRef  ///< [IN] The name to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(strRef != NULL);
+
+    return strRef->hash;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Copy the contents of a string into a regular C-style string.
+ *
+ *  @return LE_OK if the string fit properly within the bounds of the supplied string buffer.
+ *          LE_OVERFLOW if the string had to be truncated during the copy.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t nstr_CopyToCstr
+(
+    char* destStrPtr,     ///< [OUT] The destination string buffer.
+    size_t destStrMax,    ///< [IN]  The maximum string the buffer can handle.
+    nstr_Ref_t strRef     ///< [IN]  The string to copy to said buffer.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(strRef != NULL);
+    LE_ASSERT(destStrMax > 0);
+
+    // The whole string fits, so there's no need to look for a character boundary to stop at.
+    if (strRef->length < destStrMax)
+    {
+        memcpy(destStrPtr, strRef->text, strRef->length + 1);
+        return LE_OK;
+    }
+
+    return le_utf8_Copy(destStrPtr, strRef->text, destStrMax, NULL);
+}
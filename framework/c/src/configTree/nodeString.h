@@ -0,0 +1,188 @@
+// -------------------------------------------------------------------------------------------------
+/**
+ *  @file nodeString.h
+ *
+ *  Storage for the names and values of the config tree's nodes.
+ *
+ *  Each string is kept in one contiguous, length-prefixed block, allocated from the smallest of a
+ *  set of size class pools that it fits in.  Strings are reference counted and never changed once
+ *  created, so a node that needs the same string as another one, (a shadow node being merged, or a
+ *  copy of a node,) just takes another reference to it.
+ *
+ *  Names are also interned: there is only ever one string object for any given name, shared by all
+ *  of the nodes that have that name, in every tree and shadow tree.  So two names can be compared
+ *  by comparing their references, and a name that isn't in the table can't belong to any node.
+ *
+ *  Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+// -------------------------------------------------------------------------------------------------
+
+#ifndef CFG_NODE_STRING_INCLUDE_GUARD
+#define CFG_NODE_STRING_INCLUDE_GUARD
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Reference to a node name or value string.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct Nstr* nstr_Ref_t;
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Init the node string module and the internal memory resources it depends on.
+ */
+//--------------------------------------------------------------------------------------------------
+void nstr_Init
+(
+    void
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the interned string for a node name, adding it to the name table if it isn't there yet.
+ *  The caller gets a new reference to the string, which must be released with nstr_Release().
+ *
+ *  @return Reference to the name string.
+ */
+//--------------------------------------------------------------------------------------------------
+nstr_Ref_t nstr_GetName
+(
+    const char* namePtr  ///< [IN] The name to look up.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Look for a node name in the name table, without adding it.  No reference is taken, so the
+ *  string is only good for comparing with the names of existing nodes.
+ *
+ *  @return Reference to the name string, or NULL if no node currently has that name.
+ */
+//--------------------------------------------------------------------------------------------------
+nstr_Ref_t nstr_FindName
+(
+    const char* namePtr  ///< [IN] The name to look up.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Create a new value string, copied from a C-string.  Values longer than LE_CFG_STR_LEN bytes are
+ *  truncated.
+ *
+ *  @return Reference to the new string.
+ */
+//--------------------------------------------------------------------------------------------------
+nstr_Ref_t nstr_NewValue
+(
+    const char* valuePtr  ///< [IN] The value to copy.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Take another reference to a string.
+ */
+//--------------------------------------------------------------------------------------------------
+void nstr_AddRef
+(
+    nstr_Ref_t strRef  ///< [IN] The string to reference.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Release a reference to a string.  The string is freed, (and a name is removed from the name
+ *  table,) when its last reference is released.
+ */
+//--------------------------------------------------------------------------------------------------
+void nstr_Release
+(
+    nstr_Ref_t strRef  ///< [IN] The string to release.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the text of a string.  The pointer is valid for as long as the reference is held.
+ *
+ *  @return Pointer to the null terminated text.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* nstr_GetText
+(
+    nstr_Ref_t strRef  ///< [IN] The string to read.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the length of a string.
+ *
+ *  @return The number of bytes in the string, not including the null terminator.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t nstr_GetLength
+(
+    nstr_Ref_t strRef  ///< [IN] The string to read.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the hash of a node name.  (This is the 32-bit FNV-1a hash, which is quick to compute for
+ *  short strings like node names.)  It's computed once, when the name is added to the name table.
+ *
+ *  @return The hash value, or zero if the string is a value rather than a name.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t nstr_GetHash
+(
+    nstr_Ref_t strRef  ///< [IN] The name to read.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Copy the contents of a string into a regular C-style string.
+ *
+ *  @return LE_OK if the string fit properly within the bounds of the supplied string buffer.
+ *          LE_OVERFLOW if the string had to be truncated during the copy.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t nstr_CopyToCstr
+(
+    char* destStrPtr,     ///< [OUT] The destination string buffer.
+    size_t destStrMax,    ///< [IN]  The maximum string the buffer can handle.
+    nstr_Ref_t strRef     ///< [IN]  The string to copy to said buffer.
+);
+
+
+
+
+#endif
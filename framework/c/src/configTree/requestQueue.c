@@ -43,7 +43,6 @@ typedef enum
     RQ_INVALID,
 
     RQ_CREATE_WRITE_TXN,
-    RQ_COMMIT_WRITE_TXN,
     RQ_CREATE_READ_TXN,
     RQ_DELETE_TXN,
 
@@ -84,12 +83,6 @@ typedef struct UpdateRequest
         }
         createTxn;                               ///< Create new transaction info.
 
-        struct
-        {
-            ni_IteratorRef_t iteratorRef;        ///< Ptr to the iterator to commit.
-        }
-        commitTxn;
-
         struct
         {
             ni_IteratorRef_t iteratorRef;        ///< Ptr to the iterator to commit.
@@ -329,16 +322,6 @@ static void ProcessRequestQueue
                                               requestPtr->data.createTxn.pathPtr);
                     break;
 
-                case RQ_COMMIT_WRITE_TXN:
-                    LE_DEBUG("Committing deferred write txn for user %u (%s) on tree '%s'.",
-                             tu_GetUserId(requestPtr->userRef),
-                             tu_GetUserName(requestPtr->userRef),
-                             tdb_GetTreeName(requestPtr->treeRef));
-
-                    rq_HandleCommitTxnRequest(requestPtr->commandRef,
-                                              requestPtr->data.commitTxn.iteratorRef);
-                    break;
-
                case RQ_CREATE_READ_TXN:
                     LE_DEBUG("Starting deferred read txn for user %u (%s) on tree '%s'.",
                              tu_GetUserId(requestPtr->userRef),
@@ -471,14 +454,9 @@ static bool CanQuickSet
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // If there are active readers or writers on the tree then a quick write should be defered.
-    if (   (tdb_HasActiveReaders(treeRef) == false)
-        && (tdb_GetActiveWriteIter(treeRef) == NULL))
-    {
-        return true;
-    }
-
-    return false;
+    // If there's an active writer on the tree then a quick write should be defered.  Readers
+    // don't matter, they keep seeing the tree as it was when they started.
+    return tdb_GetActiveWriteIter(treeRef) == NULL;
 }
 
 
@@ -571,16 +549,10 @@ void rq_HandleCreateTxnRequest
 )
 //--------------------------------------------------------------------------------------------------
 {
-    ni_IteratorRef_t writeIteratorRef = tdb_GetActiveWriteIter(treeRef);
-
-    if (   (iterType == NI_READ)
-        && (writeIteratorRef != NULL)
-        && (ni_IsClosed(writeIteratorRef)))
-    {
-        QueueCreateTxnRequest(userRef, treeRef, sessionRef, commandRef, iterType, pathPtr);
-    }
-    else if (   (iterType == NI_WRITE)
-             && (writeIteratorRef != NULL))
+    // Only one write transaction can be open on a tree at a time.  Read transactions can always
+    // be started, as commits never have to wait for them.
+    if (   (iterType == NI_WRITE)
+        && (tdb_GetActiveWriteIter(treeRef) != NULL))
     {
         QueueCreateTxnRequest(userRef, treeRef, sessionRef, commandRef, iterType, pathPtr);
     }
@@ -623,34 +595,23 @@ void rq_HandleCommitTxnRequest
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (ni_IsWriteable(iteratorRef) == false)
-    {
-        // Kill the iterator but do not try to comit it.
-        ni_Release(iteratorRef);
+    // Grab the tree's request queue now, the iterator (and its shadow tree) won't be around after
+    // it's been released.
+    le_sls_List_t* requestQueuePtr = tdb_GetRequestQueue(ni_GetTree(iteratorRef));
 
-        le_cfg_CommitTxnRespond(commandRef);
-        ProcessRequestQueue(tdb_GetRequestQueue(ni_GetTree(iteratorRef)), NULL);
-    }
-    else if (tdb_HasActiveReaders(ni_GetTree(iteratorRef)) == false)
+    // Commits never wait for readers, they keep seeing the tree as it was when they started.  So
+    // the changes can be merged right away.
+    if (ni_IsWriteable(iteratorRef))
     {
         ni_Close(iteratorRef);
         ni_Commit(iteratorRef);
-        ni_Release(iteratorRef);
-
-        le_cfg_CommitTxnRespond(commandRef);
-        ProcessRequestQueue(tdb_GetRequestQueue(ni_GetTree(iteratorRef)), NULL);
     }
-    else
-    {
-        UpdateRequest_t* requestPtr = NewRequestBlock(RQ_COMMIT_WRITE_TXN,
-                                                      ni_GetUser(iteratorRef),
-                                                      ni_GetTree(iteratorRef),
-                                                      ni_GetSession(iteratorRef),
-                                                      commandRef);
 
-        requestPtr->data.commitTxn.iteratorRef = iteratorRef;
-        QueueRequest(tdb_GetRequestQueue(ni_GetTree(iteratorRef)), requestPtr);
-    }
+    // If this wasn't a write transaction, the iterator is just killed without being committed.
+    ni_Release(iteratorRef);
+
+    le_cfg_CommitTxnRespond(commandRef);
+    ProcessRequestQueue(requestQueuePtr, NULL);
 }
 
 
@@ -1133,3 +1094,66 @@ void rq_HandleQuickSetBool
         le_cfg_QuickSetBoolRespond(commandRef);
     }
 }
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Send a whole subtree to the client in one go.  The subtree's record is written into a pipe, and
+ *  the read end of the pipe is sent back with the response.
+ */
+// -------------------------------------------------------------------------------------------------
+void rq_HandleReadSubtree
+(
+    le_msg_SessionRef_t sessionRef,    ///< [IN] The session this request occured on.
+    le_cfg_ServerCmdRef_t commandRef,  ///< [IN] This handle is used to generate the reply for this
+                                       ///<      message.
+    tu_UserRef_t userRef,              ///< [IN] The user that's requesting the action.
+    tdb_TreeRef_t treeRef,             ///< [IN] The tree that we're peforming the action on.
+    const char* pathPtr                ///< [IN] The path to the top node of the subtree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ni_IteratorRef_t iteratorRef = ni_CreateIterator(sessionRef,
+                                                     userRef,
+                                                     treeRef,
+                                                     NI_READ,
+                                                     pathPtr);
+
+    tdb_NodeRef_t nodeRef = ni_GetNode(iteratorRef, NULL);
+    le_result_t result = LE_NOT_FOUND;
+    int fds[2] = { -1, -1 };
+
+    if (   (nodeRef != NULL)
+        && (tdb_GetNodeType(nodeRef) != LE_CFG_TYPE_DOESNT_EXIST))
+    {
+        // The whole record is written before the response is sent, so the daemon must never wait
+        // on the pipe.  A subtree is always smaller than a pipe's buffer, but if the write would
+        // block anyway, it fails instead and the client can fall back to a read transaction.
+        if (pipe(fds) == -1)
+        {
+            LE_ERROR("Could not create pipe for subtree, reason: %m");
+            result = LE_FAULT;
+        }
+        else
+        {
+            fcntl(fds[1], F_SETFL, O_NONBLOCK);
+
+            result = tdb_WriteNodeRecord(nodeRef, fds[1]);
+
+            if (result != LE_OK)
+            {
+                close(fds[0]);
+                fds[0] = -1;
+            }
+
+            close(fds[1]);
+        }
+    }
+
+    // The messaging system closes our copy of the read end once it's been sent.
+    le_cfg_ReadSubtreeRespond(commandRef, result, fds[0]);
+
+    ni_Release(iteratorRef);
+}
@@ -281,4 +281,23 @@ void rq_HandleQuickSetBool
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Send a whole subtree to the client in one go.  The subtree's record is written into a pipe, and
+ *  the read end of the pipe is sent back with the response.
+ */
+// -------------------------------------------------------------------------------------------------
+void rq_HandleReadSubtree
+(
+    le_msg_SessionRef_t sessionRef,    ///< [IN] The session this request occured on.
+    le_cfg_ServerCmdRef_t commandRef,  ///< [IN] This handle is used to generate the reply for this
+                                       ///<      message.
+    tu_UserRef_t userRef,              ///< [IN] The user that's requesting the action.
+    tdb_TreeRef_t treeRef,             ///< [IN] The tree that we're peforming the action on.
+    const char* pathPtr                ///< [IN] The path to the top node of the subtree.
+);
+
+
+
+
 #endif
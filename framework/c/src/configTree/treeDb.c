@@ -24,6 +24,8 @@
                                   +--> Write Iterator Reference
                                   |
                                   +--> Read Iterator Count
+                                  |
+                                  +--> Version List --*--> Version --> Node
 
 @endverbatim
  *
@@ -32,7 +34,8 @@
  *
  *  Each Tree object has a single "root" Node.
  *
- *  Each Node can have either a value or a list of child Nodes.
+ *  Each Node can have either a value or a list of child Nodes.  Nodes with a lot of children also
+ *  keep a hash index of them, so that a child can be found by name quickly, (see ChildIndex_t.)
  *
  *  When a write transaction is started for a Tree, the iterator reference for that transaction
  *  is recorded in the Tree object.  When the transaction is committed or cancelled, that reference
@@ -42,9 +45,24 @@
  *  incremented.  When it ends, the count is decremented.
  *
  *  When client requests are received that cannot be processed immediately, because of the state
- *  of the tree the request is for (e.g., if a write transaction commit request is received while
- *  there are read transactions in progress on the tree), then the request is queued onto the tree's
- *  Request Queue.
+ *  of the tree the request is for (e.g., if a write transaction is requested while another write
+ *  transaction is in progress on the tree), then the request is queued onto the tree's Request
+ *  Queue.
+ *
+ *  <b>Read Versions:</b>
+ *
+ *  Read transactions don't hold up commits.  Each read iterator keeps the root node of the
+ *  version of the tree that it's reading, which starts out as the tree's current root node.  When
+ *  a write transaction is committed while there are readers on the current version, the current
+ *  version is copied first, and those readers are moved onto the copy, (at the same path they
+ *  were on.)  The copy is kept on the tree's Version List, and the changes are then merged into
+ *  the tree as usual.  So, a reader always sees the tree exactly as it was when its transaction
+ *  started, however many commits happen while it's open.
+ *
+ *  A Version counts the readers that are on it, and is released along with its nodes once the
+ *  last of them is gone.  Copying a version doesn't load anything from the tree's snapshot;
+ *  children that are still in the snapshot are shared by the copy.  A commit made while no one is
+ *  reading the tree doesn't copy anything.
  *
  *  <b>Shadow Trees:</b>
  *
@@ -120,6 +138,30 @@
  *  in order to have a handler registed for it.  In fact, a handler will be called when a node is
  *  deleted and when it is recreated.
  *
+ *  <b>Tree Files:</b>
+ *
+ *  Each tree is saved in a file named after the tree and one of three revisions, (paper, rock and
+ *  scissors.)  When a new revision is written, the previous revision's file is deleted.
+ *
+ *  The files are binary "snapshots" (see SnapshotHeader_t and RecordHeader_t.)  Each node is
+ *  stored as a record holding its name and either its value or its children's records, so a
+ *  whole subtree takes up one contiguous range of the file.  When a tree is loaded, the file is
+ *  mapped into memory and only the root node is created.  The children of a stem node are created
+ *  from the snapshot the first time they're accessed.  When a new revision is written, the
+ *  children of stems that haven't been loaded are copied over from the old snapshot as they are.
+ *
+ *  Small changes don't rewrite the whole snapshot.  Instead, each merge appends an entry to the
+ *  tree's journal file, (named after the tree with a "journal" extension,) holding the path and new
+ *  record of each node that was changed, (see JournalHeader_t and JournalEntryHeader_t.)  When
+ *  a tree is loaded, the entries in its journal are replayed on top of the snapshot.  Once the
+ *  journal grows bigger than the snapshot, (or a change is too big to journal,) a new snapshot
+ *  revision is written and the journal is deleted.  Entries carry a checksum, so an entry that was
+ *  only partly written when the system went down is dropped, along with anything after it.
+ *
+ *  Files written in the older text format are still loaded, and are replaced by a snapshot the
+ *  next time the tree is changed.  The text format is also still used by tdb_ReadTreeNode() and
+ *  tdb_WriteTreeNode() for importing and exporting trees.
+ *
  *  Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
  *  Use of this work is subject to license.
  */
@@ -128,12 +170,14 @@
 #include "legato.h"
 #include "limit.h"
 #include "interfaces.h"
-#include "dynamicString.h"
+#include "nodeString.h"
+#include "nodeRecord.h"
 #include "treePath.h"
 #include "treeDb.h"
 #include "treeUser.h"
 #include "nodeIterator.h"
 #include "sysPaths.h"
+#include <sys/mman.h>
 
 
 
@@ -243,6 +287,182 @@ NodeFlags_t;
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Header found at the start of a binary tree snapshot file.  It's followed by the record for the
+ *  tree's root node, (see nodeRecord.h.)
+ *
+ *  Snapshots are written in the device's own byte order, as they're only ever read back by the
+ *  config tree on the same device.  The text format is used to move trees between devices.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct SnapshotHeader
+{
+    char magic[8];       ///< Always SNAPSHOT_MAGIC.  A text tree file can never start with this.
+    uint32_t version;    ///< Version of the snapshot format, SNAPSHOT_VERSION.
+    uint32_t byteOrder;  ///< SNAPSHOT_BYTE_ORDER, as stored by the device that wrote the file.
+    uint64_t rootSize;   ///< Size of the root node's record, in bytes.
+}
+SnapshotHeader_t;
+
+
+/// Magic number found at the start of snapshot files.
+#define SNAPSHOT_MAGIC "\x7f" "CFGSNAP"
+
+/// Current version of the snapshot format.
+#define SNAPSHOT_VERSION 1
+
+/// Used to detect snapshots that were written with a different byte order.
+#define SNAPSHOT_BYTE_ORDER 0x01020304
+
+/// Size of the buffer used when writing snapshots.  A subtree sent to a client has to fit in it.
+#define SNAPSHOT_WRITE_BUFFER_BYTES CFG_MAX_SUBTREE_BYTES
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  A tree snapshot file that has been mapped into memory.  Each stem node whose children haven't
+ *  been loaded yet holds a reference to the snapshot, and the file is unmapped once the last of
+ *  these references is released.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct Snapshot
+{
+    const uint8_t* basePtr;  ///< Start of the mapped file.
+    size_t size;             ///< Size of the mapped file, in bytes.
+}
+Snapshot_t;
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Buffers the output while a snapshot file is being written.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct SnapshotWriter
+{
+    int descriptor;        ///< The file being written, or -1 if the data must fit in the buffer.
+    le_result_t result;    ///< LE_OK until a write fails, then LE_IO_ERROR, (or LE_OVERFLOW if
+                           ///<   there's no file and the buffer filled up.)
+    off_t flushedSize;     ///< Number of bytes that have been written out to the file so far.
+    size_t bufferedSize;   ///< Number of bytes in the buffer, waiting to be written.
+    uint8_t buffer[SNAPSHOT_WRITE_BUFFER_BYTES];  ///< The output buffer.
+}
+SnapshotWriter_t;
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Header found at the start of a tree's journal file.  It's followed by the journal's entries,
+ *  each of which is a JournalEntryHeader_t followed by the changes made in one merge.
+ *
+ *  A journal only applies to the tree file it was started for.  If the tree file has since been
+ *  replaced, the journal is thrown away.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct JournalHeader
+{
+    char magic[8];       ///< Always JOURNAL_MAGIC.
+    uint32_t version;    ///< Version of the journal format, JOURNAL_VERSION.
+    uint32_t byteOrder;  ///< SNAPSHOT_BYTE_ORDER, as stored by the device that wrote the file.
+    uint32_t revisionId; ///< Revision of the tree file the journal applies to.
+    uint32_t reserved;   ///< Always zero.
+    uint64_t baseSize;   ///< Size of the tree file the journal applies to.
+}
+JournalHeader_t;
+
+
+/// Magic number found at the start of journal files.
+#define JOURNAL_MAGIC "\x7f" "CFGJRNL"
+
+/// Current version of the journal format.
+#define JOURNAL_VERSION 1
+
+/// A journal is always allowed to grow to this size before it's compacted into a new snapshot, even
+/// if the snapshot itself is smaller.
+#define JOURNAL_MIN_COMPACT_BYTES (64 * 1024)
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Header of an entry in a journal.  The header is followed by the entry's changes, each of which
+ *  is a JournalChange_t.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct JournalEntryHeader
+{
+    uint32_t size;       ///< Size of the changes that follow, in bytes.
+    uint32_t checksum;   ///< Checksum of the changes that follow.  See JournalChecksum().
+}
+JournalEntryHeader_t;
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  A change recorded in a journal entry.  The header is followed by the path of the changed node,
+ *  as the name of each node on the way down from the root, each with a null terminator.  (The root
+ *  node's path is empty.)  A JOURNAL_REPLACE change is then followed by the node's new record, in
+ *  the same format as a snapshot's records.
+ *
+ *  Like snapshot records, changes are not aligned within the file.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct JournalChange
+{
+    uint8_t type;        ///< JOURNAL_DELETE or JOURNAL_REPLACE.
+    uint8_t reserved;    ///< Always zero.
+    uint16_t pathSize;   ///< Size of the path, in bytes.
+}
+JournalChange_t;
+
+
+/// The node was deleted.
+#define JOURNAL_DELETE 1
+
+/// The node, (and all of its children,) was replaced by, or created from, the record that follows.
+#define JOURNAL_REPLACE 2
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Hash index of a stem node's children, so that a child can be found by name without searching
+ *  through all of its siblings.  Only stems with more than CHILD_INDEX_THRESHOLD children get one.
+ *
+ *  The index is an open addressed table, using linear probing, of pointers to the child nodes.
+ *  Each child's slot is found from the hash of its name, which is kept in the child node.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct ChildIndex
+{
+    size_t slotCount;        ///< Number of slots in the table.  Always a power of two.
+    size_t usedCount;        ///< Number of slots that hold a child.
+    tdb_NodeRef_t slots[];   ///< The table itself.  Unused slots are NULL.
+}
+ChildIndex_t;
+
+
+/// Stems are given a child index once a search has had to look through more than this many
+/// children.  Below that, searching the sibling list is just as fast.
+#define CHILD_INDEX_THRESHOLD 16
+
+/// Size of a new child index.  It's doubled whenever it gets more than half full.
+#define CHILD_INDEX_MIN_SLOTS 64
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  The Node object structure.
@@ -258,25 +478,55 @@ typedef struct Node
     tdb_NodeRef_t shadowRef;         ///< If this node is shadowing another then the pointer to
                                      ///<   that shadowed node is here.
 
-    dstr_Ref_t nameRef;              ///< The name of this node.
+    nstr_Ref_t nameRef;              ///< The name of this node, (interned.)
+    uint32_t nameHash;               ///< Hash of the node's name, (which for a shadow node may
+                                     ///<   be the name of the original node.)  See
+                                     ///<   nstr_GetHash().
 
     le_dls_Link_t siblingList;       ///< The linked list of node siblings.  All of the nodes
                                      ///<   in this list have the same parent node.
 
     union
     {
-        dstr_Ref_t valueRef;         ///< The value of the node.  This is only valid if the
-                                     ///<   node is not a stem.
+        nstr_Ref_t valueRef;         ///< The value of the node.  This is only valid if the
+                                     ///<   node is not a stem.  Values are never changed in
+                                     ///<   place, so they can be shared between nodes.
 
         le_dls_List_t children;      ///< The linked list of children belonging to this node.
     }
     info;                            ///< The actual inforation that this node stores.
+
+    Snapshot_t* snapshotPtr;         ///< If not NULL then this is a stem whose children have not
+                                     ///<   been loaded yet.  They're still in this snapshot.
+    uint32_t childrenOffset;         ///< Offset of the children's records in the snapshot.
+    uint32_t childrenSize;           ///< Size of the children's records, in bytes.
+
+    ChildIndex_t* indexPtr;          ///< If not NULL then this is a stem with enough children to
+                                     ///<   have them indexed by name.
 }
 Node_t;
 
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  An older version of a tree, kept for the read transactions that were open on the tree when a
+ *  write transaction was committed to it.  The version's nodes are a copy of the tree as it was
+ *  just before the commit, and they're released when the last of its readers goes away.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct Version
+{
+    le_dls_Link_t link;         ///< Used to link onto the tree's list of older versions.
+    Node_t* rootNodeRef;        ///< The root node of this version.
+    size_t readCount;           ///< Count of the read iterators that are on this version.
+}
+Version_t;
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Structure used to keep track of the trees loaded in the configTree daemon.
@@ -297,10 +547,19 @@ typedef struct Tree
                                           ///<   0 - Unknonwn.
                                           ///<   1, 2, 3 is one of the rock, paper, scissors revs.
 
+    off_t snapshotSize;                   ///< Size of the current revision's tree file, or 0 if
+                                          ///<   it isn't a snapshot.  Changes are only journaled
+                                          ///<   on top of a snapshot.
+    off_t journalSize;                    ///< Size of the tree's journal file, 0 if it has none.
+
     Node_t* rootNodeRef;                  ///< The root node of this tree.
 
     ssize_t activeReadCount;              ///< Count of reads that are currently active on
                                           ///<   this tree.
+    size_t currentReadCount;              ///< How many of those reads are on the current version
+                                          ///<   of the tree, (rootNodeRef.)
+    le_dls_List_t versionList;            ///< Older versions of the tree that are still being
+                                          ///<   read, (see Version_t.)
     ni_IteratorRef_t activeWriteIterRef;  ///< The parent write iterator that's active on
                                           ///<   this tree.  NULL if there are no writes
                                           ///<   pending.
@@ -388,6 +647,27 @@ static le_mem_PoolRef_t RegistrationPool = NULL;
 
 
 
+/// Pool of mapped snapshot objects.
+static le_mem_PoolRef_t SnapshotPool = NULL;
+
+/// Name of the snapshot pool.
+#define CFG_SNAPSHOT_POOL_NAME "SnapshotPool"
+
+
+
+/// Pool of older tree versions.
+static le_mem_PoolRef_t VersionPool = NULL;
+
+/// Name of the version pool.
+#define CFG_VERSION_POOL_NAME "VersionPool"
+
+
+/// Used to write snapshots and to build journal entries.  (Only one is ever being written at a
+/// time.)
+static SnapshotWriter_t Writer;
+
+
+
 
 // -------------------------------------------------------------------------------------------------
 /**
@@ -542,6 +822,56 @@ static void ClearDeletedFlag
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Get the name of a node.  If this is a shadow node whose name hasn't been changed, then this is
+ *  the name of the original node.
+ *
+ *  @return The name of the node, or NULL if the node doesn't have one.
+ */
+// -------------------------------------------------------------------------------------------------
+static nstr_Ref_t GetNameRef
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to read.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (   (IsShadow(nodeRef))
+        && (nodeRef->nameRef == NULL)
+        && (nodeRef->shadowRef != NULL))
+    {
+        return nodeRef->shadowRef->nameRef;
+    }
+
+    return nodeRef->nameRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check a node's name.  Names are interned, so this is just a matter of comparing references.  The
+ *  hashes are compared first, so that a shadow node with a different name is rejected without
+ *  having to look at its original node.
+ *
+ *  @return True if the node has the given name.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool IsNamed
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node to check.
+    nstr_Ref_t nameRef      ///< [IN] The interned name to look for.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    return    (nodeRef->nameHash == nstr_GetHash(nameRef))
+           && (GetNameRef(nodeRef) == nameRef);
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Allocate a new node and fill out it's default information.
@@ -563,8 +893,13 @@ static tdb_NodeRef_t NewNode
     ClearFlags(newNodeRef);
     newNodeRef->shadowRef = NULL;
     newNodeRef->nameRef = NULL;
+    newNodeRef->nameHash = 0;
     newNodeRef->siblingList = LE_DLS_LINK_INIT;
     memset(&newNodeRef->info, 0, sizeof(newNodeRef->info));
+    newNodeRef->snapshotPtr = NULL;
+    newNodeRef->childrenOffset = 0;
+    newNodeRef->childrenSize = 0;
+    newNodeRef->indexPtr = NULL;
 
     return newNodeRef;
 }
@@ -574,63 +909,67 @@ static tdb_NodeRef_t NewNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  The node destructor function.  This will take care of freeing a node's string values and any
- *  children it may have.  Called automaticly by the memory system when a node is released.
+ *  Put a child node into its parent's child index.  The index must have a free slot.
  */
 // -------------------------------------------------------------------------------------------------
-static void NodeDestructor
+static void InsertIntoIndex
 (
-    void* objectPtr  ///< [IN] The generic object to free.
+    ChildIndex_t* indexPtr,  ///< [IN] The index to update.
+    tdb_NodeRef_t childRef   ///< [IN] The child to add to it.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_NodeRef_t nodeRef = (tdb_NodeRef_t)objectPtr;
+    size_t mask = indexPtr->slotCount - 1;
+    size_t slot = childRef->nameHash & mask;
 
-    if (nodeRef->nameRef)
+    while (indexPtr->slots[slot] != NULL)
     {
-        dstr_Release(nodeRef->nameRef);
+        slot = (slot + 1) & mask;
     }
 
-    switch (nodeRef->type)
-    {
-        case LE_CFG_TYPE_EMPTY:
-        case LE_CFG_TYPE_DOESNT_EXIST:
-            // Nothing to do here.
-            break;
+    indexPtr->slots[slot] = childRef;
+    indexPtr->usedCount++;
+}
 
-        case LE_CFG_TYPE_STRING:
-        case LE_CFG_TYPE_BOOL:
-        case LE_CFG_TYPE_INT:
-        case LE_CFG_TYPE_FLOAT:
-            if (nodeRef->info.valueRef)
-            {
-                dstr_Release(nodeRef->info.valueRef);
-            }
-            break;
 
-        case LE_CFG_TYPE_STEM:
-            {
-                tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
 
-                while (childRef != NULL)
-                {
-                    tdb_NodeRef_t nextChildRef = tdb_GetNextSiblingNode(childRef);
 
-                    le_mem_Release(childRef);
-                    childRef = nextChildRef;
-                }
-            }
-            break;
-    }
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Create, (or re-create,) the child index of a stem node from its current list of children.  The
+ *  index is sized to stay less than half full.
+ */
+// -------------------------------------------------------------------------------------------------
+static void BuildChildIndex
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The stem node to index the children of.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    size_t childCount = le_dls_NumLinks(&nodeRef->info.children);
+    size_t slotCount = CHILD_INDEX_MIN_SLOTS;
 
-    if (nodeRef->parentRef != NULL)
+    while (slotCount < (childCount + 1) * 2)
     {
-        LE_ASSERT(nodeRef->parentRef->type == LE_CFG_TYPE_STEM);
-        LE_ASSERT(le_dls_IsEmpty(&nodeRef->parentRef->info.children) == false);
-        LE_ASSERT(le_dls_IsInList(&nodeRef->parentRef->info.children, &nodeRef->siblingList));
+        slotCount *= 2;
+    }
 
-        le_dls_Remove(&nodeRef->parentRef->info.children, &nodeRef->siblingList);
+    // The size of the table varies, so it can't come from a memory pool.
+    ChildIndex_t* indexPtr = calloc(1, sizeof(ChildIndex_t) + (slotCount * sizeof(tdb_NodeRef_t)));
+    LE_ASSERT(indexPtr != NULL);
+
+    indexPtr->slotCount = slotCount;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&nodeRef->info.children);
+
+    while (linkPtr != NULL)
+    {
+        InsertIntoIndex(indexPtr, CONTAINER_OF(linkPtr, Node_t, siblingList));
+        linkPtr = le_dls_PeekNext(&nodeRef->info.children, linkPtr);
     }
+
+    free(nodeRef->indexPtr);
+    nodeRef->indexPtr = indexPtr;
 }
 
 
@@ -638,40 +977,17 @@ static void NodeDestructor
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Allocate a new node from our pool, and turn it into a shadow of an existing node.
- *
- *  @return A new node that shadows the existing node.
+ *  Free a stem node's child index, if it has one.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t NewShadowNode
+static void DeleteChildIndex
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The node to shadow.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to update.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Allocate a new blank node.
-    tdb_NodeRef_t newShadowRef = NewNode();
-
-    // Turn it into a shadow of the original node.  It's possible for nodeRef to be NULL.  We could
-    // be creating a shadow node for which no original exists.  Which is the case when creating a
-    // new path that didn't exist in the original tree.
-    if (nodeRef != NULL)
-    {
-        newShadowRef->type = nodeRef->type;
-        newShadowRef->flags = nodeRef->flags;
-        newShadowRef->shadowRef = nodeRef;
-
-        // Now, if the parent node, (if there is a parent node,) is marked as deleted, then do the
-        // same with this new node.
-        if (   (nodeRef->parentRef != NULL)
-            && (IsDeleted(nodeRef->parentRef)))
-        {
-            SetDeletedFlag(newShadowRef);
-        }
-    }
-
-    SetShadowFlag(newShadowRef);
-    return newShadowRef;
+    free(nodeRef->indexPtr);
+    nodeRef->indexPtr = NULL;
 }
 
 
@@ -679,48 +995,35 @@ static tdb_NodeRef_t NewShadowNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Create a new node and insert it into the given node's children collection.
- *
- *  @return The newly create node, already inserted into the supplied node's child collection.
+ *  Add a node to its parent's child index, if the parent has one.  This is done when a node is
+ *  added to its parent's list of children, and again after the node has been renamed.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t NewChildNode
+static void IndexChild
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The node to be given with a new child.
+    tdb_NodeRef_t childRef  ///< [IN] The child node, already in its parent's list of children.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If the node is currently empty, then turn it into a stem.
-    if (nodeRef->type == LE_CFG_TYPE_EMPTY)
+    tdb_NodeRef_t parentRef = childRef->parentRef;
+
+    if (   (parentRef == NULL)
+        || (parentRef->indexPtr == NULL))
     {
-        nodeRef->type = LE_CFG_TYPE_STEM;
+        return;
     }
 
-    LE_ASSERT(nodeRef->type == LE_CFG_TYPE_STEM);
-
-    // Create a new node.  Then set it's parent to the given node
-    tdb_NodeRef_t newRef = NewNode();
-
-    newRef->parentRef = nodeRef;
-    newRef->type = LE_CFG_TYPE_EMPTY;
+    ChildIndex_t* indexPtr = parentRef->indexPtr;
 
-    // Get the new node to inheret the parent's shadow and deletion flags.
-    if (IsShadow(nodeRef))
+    if (((indexPtr->usedCount + 1) * 2) > indexPtr->slotCount)
     {
-        SetShadowFlag(newRef);
-        SetDeletedFlag(newRef);
+        // Rebuilding the index from the parent's list picks up this child too.
+        BuildChildIndex(parentRef);
     }
-
-    if (IsDeleted(nodeRef))
+    else
     {
-        SetDeletedFlag(newRef);
+        InsertIntoIndex(indexPtr, childRef);
     }
-
-    // Now make sure to add the new child node to the end of the parents collection.
-    le_dls_Queue(&nodeRef->info.children, &newRef->siblingList);
-
-    // Finally return the newly created node to the caller.
-    return newRef;
 }
 
 
@@ -728,59 +1031,60 @@ static tdb_NodeRef_t NewChildNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Called to shadow a node's collection of children.
+ *  Take a node out of its parent's child index, if the parent has one.  This is done when a node is
+ *  removed from its parent's list of children, and before the node is renamed.
  */
 // -------------------------------------------------------------------------------------------------
-static void ShadowChildren
+static void UnindexChild
 (
-    tdb_NodeRef_t shadowParentRef  ///< [IN] The node we're shadowing the children of.
+    tdb_NodeRef_t childRef  ///< [IN] The child node.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If the parent node isn't a stem then there isn't much else to do here.
-    if (shadowParentRef->type != LE_CFG_TYPE_STEM)
-    {
-        return;
-    }
+    tdb_NodeRef_t parentRef = childRef->parentRef;
 
-    // Does this node have any children currently?  If yes, then we don't need to do anything else.
-    if (le_dls_IsEmpty(&shadowParentRef->info.children) == false)
+    if (   (parentRef == NULL)
+        || (parentRef->indexPtr == NULL))
     {
         return;
     }
 
-    // Has this node been modified?  If so, then the shadow children may have been cleared from
-    // this collection.
-    if (IsModified(shadowParentRef) == true)
+    ChildIndex_t* indexPtr = parentRef->indexPtr;
+    size_t mask = indexPtr->slotCount - 1;
+    size_t slot = childRef->nameHash & mask;
+
+    while (indexPtr->slots[slot] != childRef)
     {
-        return;
+        LE_ASSERT(indexPtr->slots[slot] != NULL);
+        slot = (slot + 1) & mask;
     }
 
-    // This node has no shadow children.  So what we do now is check the original node... Does it
-    // have any children?  If it does, we simply recreate the whole collection now.  (We do not
-    // recurse into the grandchildren though.)  Doing this now makes life simpler, instead of doing
-    // this piecemeal and possibly out of order.
-    tdb_NodeRef_t originalRef = shadowParentRef->shadowRef;
+    // Close the gap left behind by moving back any of the following nodes that wouldn't be found
+    // otherwise, that is, any whose hash doesn't place them after the gap.
+    size_t nextSlot = slot;
 
-    if (   (originalRef == NULL)
-        || (originalRef->type != LE_CFG_TYPE_STEM))
+    for (;;)
     {
-        return;
-    }
+        nextSlot = (nextSlot + 1) & mask;
 
-    // Simply iterate through the original collection and add a new shadow child to our own
-    // collection.
-    tdb_NodeRef_t originalChildRef = tdb_GetFirstChildNode(originalRef);
+        tdb_NodeRef_t nextRef = indexPtr->slots[nextSlot];
 
-    while (originalChildRef != NULL)
-    {
-        tdb_NodeRef_t newShadowRef = NewShadowNode(originalChildRef);
-        newShadowRef->parentRef = shadowParentRef;
+        if (nextRef == NULL)
+        {
+            break;
+        }
 
-        le_dls_Queue(&shadowParentRef->info.children, &newShadowRef->siblingList);
+        size_t homeSlot = nextRef->nameHash & mask;
 
-        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
+        if (((nextSlot - homeSlot) & mask) >= ((nextSlot - slot) & mask))
+        {
+            indexPtr->slots[slot] = nextRef;
+            slot = nextSlot;
+        }
     }
+
+    indexPtr->slots[slot] = NULL;
+    indexPtr->usedCount--;
 }
 
 
@@ -788,24 +1092,39 @@ static void ShadowChildren
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Search up through a node tree until we find the root node.
+ *  Add a node to the end of a stem node's list of children.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t GetRootParentNode
+static void AddChild
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] Find the greatest grand parent of this node.
+    tdb_NodeRef_t parentRef,  ///< [IN] The stem node.
+    tdb_NodeRef_t childRef    ///< [IN] The new child, with its parentRef already set.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_NodeRef_t parentRef = NULL;
+    le_dls_Queue(&parentRef->info.children, &childRef->siblingList);
+    IndexChild(childRef);
+}
 
-    while (nodeRef != NULL)
-    {
-        parentRef = nodeRef;
-        nodeRef = tdb_GetNodeParent(nodeRef);
-    }
 
-    return parentRef;
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  The snapshot destructor function.  Unmaps the snapshot file once no more nodes need to be loaded
+ *  from it.
+ */
+// -------------------------------------------------------------------------------------------------
+static void SnapshotDestructor
+(
+    void* objectPtr  ///< [IN] The generic object to free.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    Snapshot_t* snapshotPtr = (Snapshot_t*)objectPtr;
+
+    LE_DEBUG("** Unmapping %zu byte tree snapshot.", snapshotPtr->size);
+    LE_ASSERT(munmap((void*)snapshotPtr->basePtr, snapshotPtr->size) == 0);
 }
 
 
@@ -813,53 +1132,53 @@ static tdb_NodeRef_t GetRootParentNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Called to look for a named child in a given node's child collection.
+ *  Fill out an empty node from its record in a snapshot.  If the node is a stem, its children are
+ *  left in the snapshot until they're needed.
  *
- *  @return Reference to the found child node, or NULL if a node was not found.
+ *  @return The offset of the record that follows this one.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t GetNamedChild
+static uint32_t LoadRecord
 (
-    tdb_NodeRef_t nodeRef,  ///< [IN] The node to search.
-    const char* nameRef     ///< [IN] The name we're searching for.
+    tdb_NodeRef_t nodeRef,    ///< [IN] The node to fill out.
+    Snapshot_t* snapshotPtr,  ///< [IN] The snapshot to read from.  It has already been validated.
+    uint32_t offset           ///< [IN] Offset of the node's record in the snapshot.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Is this one of the "special" names?
-    if (strcmp(nameRef, ".") == 0)
-    {
-        return nodeRef;
-    }
+    RecordHeader_t header;
+    memcpy(&header, snapshotPtr->basePtr + offset, sizeof(header));
 
-    if (strcmp(nameRef, "..") == 0)
-    {
-        return nodeRef->parentRef;
-    }
+    const char* namePtr = (const char*)snapshotPtr->basePtr + offset + sizeof(header);
+    uint32_t dataOffset = offset + sizeof(header) + header.nameSize + 1;
 
-    // If the current node isn't a stem, then this node can't have any children.
-    if (nodeRef->type != LE_CFG_TYPE_STEM)
+    if (header.nameSize > 0)
     {
-        return NULL;
+        nodeRef->nameRef = nstr_GetName(namePtr);
+        nodeRef->nameHash = nstr_GetHash(nodeRef->nameRef);
     }
 
-    // Search the child list for a node with the given name.
-    tdb_NodeRef_t currentRef = tdb_GetFirstChildNode(nodeRef);
-    char currentNameRef[LE_CFG_NAME_LEN_BYTES] = "";
+    nodeRef->type = header.type;
 
-    while (currentRef != NULL)
+    switch (nodeRef->type)
     {
-        tdb_GetNodeName(currentRef, currentNameRef, sizeof(currentNameRef));
+        case LE_CFG_TYPE_EMPTY:
+            break;
 
-        if (strncmp(currentNameRef, nameRef, sizeof(currentNameRef)) == 0)
-        {
-            return currentRef;
-        }
+        case LE_CFG_TYPE_STEM:
+            le_mem_AddRef(snapshotPtr);
+            nodeRef->snapshotPtr = snapshotPtr;
+            nodeRef->childrenOffset = dataOffset;
+            nodeRef->childrenSize = header.dataSize;
+            break;
 
-        currentRef = tdb_GetNextSiblingNode(currentRef);
+        default:
+            nodeRef->info.valueRef =
+                nstr_NewValue((const char*)snapshotPtr->basePtr + dataOffset);
+            break;
     }
 
-    // Looks like there was no node to return.
-    return NULL;
+    return dataOffset + header.dataSize;
 }
 
 
@@ -867,46 +1186,39 @@ static tdb_NodeRef_t GetNamedChild
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Called to create a named child in a nodes child collection.  However, this function will only
- *  create nodes on shadow trees.
- *
- *  @return Reference to newly created child node, or NULL if it can not be created.
+ *  If the children of a stem node haven't been loaded from its tree's snapshot yet, load them now.
+ *  Their own children are left in the snapshot.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t CreateNamedChild
+static void LoadChildren
 (
-    tdb_NodeRef_t nodeRef,  ///< [IN] The node to search.
-    const char* nameRef     ///< [IN] The name we're searching for.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node whose children are needed.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_NodeRef_t childRef = NULL;
+    Snapshot_t* snapshotPtr = nodeRef->snapshotPtr;
 
-    if (IsShadow(nodeRef) == true)
+    if (snapshotPtr == NULL)
     {
-        // If the node isn't a stem, then convert it into an empty one now.
-        if (   (nodeRef->type != LE_CFG_TYPE_STEM)
-            && (nodeRef->type != LE_CFG_TYPE_EMPTY))
-        {
-            tdb_SetEmpty(nodeRef);
-            nodeRef->type = LE_CFG_TYPE_STEM;
-            nodeRef->info.children = LE_DLS_LIST_INIT;
-        }
+        return;
+    }
 
-        // Create the node, and set it's deleted flag as it hasn't been used for anything yet.
-        childRef = NewChildNode(nodeRef);
-        SetDeletedFlag(childRef);
+    nodeRef->snapshotPtr = NULL;
 
-        // Set the name of the new node, if that fails then the user had given us a bad name for the
-        // new node.  So in that case free the node and return NULL.
-        if (tdb_SetNodeName(childRef, nameRef) != LE_OK)
-        {
-            le_mem_Release(childRef);
-            childRef = NULL;
-        }
+    uint32_t offset = nodeRef->childrenOffset;
+    uint32_t endOffset = offset + nodeRef->childrenSize;
+
+    while (offset < endOffset)
+    {
+        tdb_NodeRef_t childRef = NewNode();
+
+        childRef->parentRef = nodeRef;
+        offset = LoadRecord(childRef, snapshotPtr, offset);
+
+        AddChild(nodeRef, childRef);
     }
 
-    return childRef;
+    le_mem_Release(snapshotPtr);
 }
 
 
@@ -914,34 +1226,37 @@ static tdb_NodeRef_t CreateNamedChild
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check to see if a given node exists within a node's child collection.
- *
- *  @return True if the given node exists within the parent node's collection.  False if not.
+ *  Release all of a stem node's children.  Only the children the node actually has are released,
+ *  children that are still in a snapshot, (or haven't been shadowed yet,) aren't created just to
+ *  be thrown away.
  */
 // -------------------------------------------------------------------------------------------------
-static bool NodeExists
+static void ReleaseChildren
 (
-    tdb_NodeRef_t parentRef,  ///< [IN] The parent node to search.
-    const char* namePtr       ///< [IN] The name to search for.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node whose children are to be released.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_NodeRef_t currentRef = tdb_GetFirstChildNode(parentRef);
-    char currentName[LE_CFG_NAME_LEN_BYTES] = "";
-
-    while (currentRef != NULL)
+    if (nodeRef->snapshotPtr != NULL)
     {
-        tdb_GetNodeName(currentRef, currentName, sizeof(currentName));
+        le_mem_Release(nodeRef->snapshotPtr);
+        nodeRef->snapshotPtr = NULL;
+    }
 
-        if (strncmp(currentName, namePtr, sizeof(currentName)) == 0)
-        {
-            return true;
-        }
+    // Drop the index first, so the children don't have to be taken out of it one by one.
+    DeleteChildIndex(nodeRef);
 
-        currentRef = tdb_GetNextSiblingNode(currentRef);
-    }
+    le_dls_Link_t* linkPtr = le_dls_Peek(&nodeRef->info.children);
 
-    return false;
+    while (linkPtr != NULL)
+    {
+        le_dls_Link_t* nextLinkPtr = le_dls_PeekNext(&nodeRef->info.children, linkPtr);
+
+        // We don't remove the child from the list explicitly, because the destructor will take
+        // care of that for us.
+        le_mem_Release(CONTAINER_OF(linkPtr, Node_t, siblingList));
+        linkPtr = nextLinkPtr;
+    }
 }
 
 
@@ -949,28 +1264,54 @@ static bool NodeExists
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check the given node type and see if it should have a string value.
- *
- *  @return True if the given node could hold a string value.  False if not.
+ *  The node destructor function.  This will take care of freeing a node's string values and any
+ *  children it may have.  Called automaticly by the memory system when a node is released.
  */
 // -------------------------------------------------------------------------------------------------
-static bool IsStringType
+static void NodeDestructor
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The node to read.
+    void* objectPtr  ///< [IN] The generic object to free.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_cfg_nodeType_t type = tdb_GetNodeType(nodeRef);
+    tdb_NodeRef_t nodeRef = (tdb_NodeRef_t)objectPtr;
 
-    if (   (type == LE_CFG_TYPE_STRING)
-        || (type == LE_CFG_TYPE_BOOL)
-        || (type == LE_CFG_TYPE_INT)
-        || (type == LE_CFG_TYPE_FLOAT))
+    if (nodeRef->nameRef)
     {
-        return true;
+        nstr_Release(nodeRef->nameRef);
     }
 
-    return false;
+    switch (nodeRef->type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+        case LE_CFG_TYPE_DOESNT_EXIST:
+            // Nothing to do here.
+            break;
+
+        case LE_CFG_TYPE_STRING:
+        case LE_CFG_TYPE_BOOL:
+        case LE_CFG_TYPE_INT:
+        case LE_CFG_TYPE_FLOAT:
+            if (nodeRef->info.valueRef)
+            {
+                nstr_Release(nodeRef->info.valueRef);
+            }
+            break;
+
+        case LE_CFG_TYPE_STEM:
+            ReleaseChildren(nodeRef);
+            break;
+    }
+
+    if (nodeRef->parentRef != NULL)
+    {
+        LE_ASSERT(nodeRef->parentRef->type == LE_CFG_TYPE_STEM);
+        LE_ASSERT(le_dls_IsEmpty(&nodeRef->parentRef->info.children) == false);
+        LE_ASSERT(le_dls_IsInList(&nodeRef->parentRef->info.children, &nodeRef->siblingList));
+
+        UnindexChild(nodeRef);
+        le_dls_Remove(&nodeRef->parentRef->info.children, &nodeRef->siblingList);
+    }
 }
 
 
@@ -978,34 +1319,41 @@ static bool IsStringType
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  This function will copy a string value from an original tree node into a node that has shadowed
- *  it.
+ *  Allocate a new node from our pool, and turn it into a shadow of an existing node.
+ *
+ *  @return A new node that shadows the existing node.
  */
 // -------------------------------------------------------------------------------------------------
-static void PropagateValue
+static tdb_NodeRef_t NewShadowNode
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The node ref to update.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to shadow.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If the node doesn't even have a ref to an original node, then there's nothing left to do
-    // here.
-    tdb_NodeRef_t shadowRef = nodeRef->shadowRef;
+    // Allocate a new blank node.
+    tdb_NodeRef_t newShadowRef = NewNode();
 
-    if (shadowRef == NULL)
+    // Turn it into a shadow of the original node.  It's possible for nodeRef to be NULL.  We could
+    // be creating a shadow node for which no original exists.  Which is the case when creating a
+    // new path that didn't exist in the original tree.
+    if (nodeRef != NULL)
     {
-        return;
-    }
+        newShadowRef->type = nodeRef->type;
+        newShadowRef->flags = nodeRef->flags;
+        newShadowRef->shadowRef = nodeRef;
+        newShadowRef->nameHash = nodeRef->nameHash;
 
-    // Ok, figure out the type for this node.  If it has a value, and the original
-    if (   (IsStringType(nodeRef) == true)
-        && (IsStringType(shadowRef) == true)
-        && (nodeRef->info.valueRef == NULL)
-        && (shadowRef->info.valueRef != NULL))
-    {
-        // Looks like the value hasn't been propagated or changed yet.  So, do so now.
-        nodeRef->info.valueRef = dstr_NewFromDstr(shadowRef->info.valueRef);
+        // Now, if the parent node, (if there is a parent node,) is marked as deleted, then do the
+        // same with this new node.
+        if (   (nodeRef->parentRef != NULL)
+            && (IsDeleted(nodeRef->parentRef)))
+        {
+            SetDeletedFlag(newShadowRef);
+        }
     }
+
+    SetShadowFlag(newShadowRef);
+    return newShadowRef;
 }
 
 
@@ -1013,116 +1361,51 @@ static void PropagateValue
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Merge a shadow node with the original it represents.
+ *  Create a new node and insert it into the given node's children collection.
+ *
+ *  @return The newly create node, already inserted into the supplied node's child collection.
  */
 // -------------------------------------------------------------------------------------------------
-static void MergeNode
+static tdb_NodeRef_t NewChildNode
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The shadow node to merge.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to be given with a new child.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    LE_ASSERT(nodeRef != NULL);
-
-    // If this shadow node for some reason doesn't have a ref check for an original version of it in
-    // the original tree.  This shadow node may have been destroyed and re-created loosing this
-    // link.
-    if (nodeRef->shadowRef == NULL)
+    // If the node is currently empty, then turn it into a stem.
+    if (nodeRef->type == LE_CFG_TYPE_EMPTY)
     {
-        tdb_NodeRef_t shadowedParentRef = tdb_GetNodeParent(nodeRef)->shadowRef;
+        nodeRef->type = LE_CFG_TYPE_STEM;
+    }
 
-        if (shadowedParentRef != NULL)
-        {
-            char name[LE_CFG_NAME_LEN_BYTES] = "";
-
-            tdb_GetNodeName(nodeRef, name, sizeof(name));
-            nodeRef->shadowRef = GetNamedChild(shadowedParentRef, name);
-        }
-    }
-
-    // If this node has been marked as deleted, then simply drop the original node and move on.
-    if (IsDeleted(nodeRef))
-    {
-        if (   (nodeRef->shadowRef != NULL)
-            && (tdb_GetNodeParent(nodeRef->shadowRef) != NULL))
-        {
-            le_mem_Release(nodeRef->shadowRef);
-        }
-        else
-        {
-            // We delete every node but the root node.  Since this is the root node, we just need
-            // to clear it out.
-            tdb_SetEmpty(nodeRef->shadowRef);
-        }
-
-        return;
-    }
-
-    // If the original node doesn't exist, create it now.
-    tdb_NodeRef_t originalRef = nodeRef->shadowRef;
-
-    if (originalRef == NULL)
-    {
-        LE_ASSERT(nodeRef->parentRef != NULL);
-        LE_ASSERT(nodeRef->parentRef->shadowRef != NULL);
-
-        nodeRef->shadowRef = originalRef = NewChildNode(nodeRef->parentRef->shadowRef);
-    }
+    LE_ASSERT(nodeRef->type == LE_CFG_TYPE_STEM);
 
-    ClearModifiedFlag(originalRef);
+    // Make sure the new node goes after any of the existing children still in the snapshot.
+    LoadChildren(nodeRef);
 
-    // If the name has been changed, then copy it over now.
-    if (dstr_IsNullOrEmpty(nodeRef->nameRef) == false)
-    {
-        if (originalRef->nameRef != NULL)
-        {
-            dstr_Copy(originalRef->nameRef, nodeRef->nameRef);
-        }
-        else
-        {
-            originalRef->nameRef = dstr_NewFromDstr(nodeRef->nameRef);
-        }
-    }
+    // Create a new node.  Then set it's parent to the given node
+    tdb_NodeRef_t newRef = NewNode();
 
-    // Check the types of the original and the shadow nodes.  If the new node has been cleared,
-    // then clear out the original node.  If the types have changed, then clear out the original so
-    // that we can properly populate it again.
-    le_cfg_nodeType_t nodeType = tdb_GetNodeType(nodeRef);
+    newRef->parentRef = nodeRef;
+    newRef->type = LE_CFG_TYPE_EMPTY;
 
-    if (   (nodeType == LE_CFG_TYPE_EMPTY)
-        || (nodeType != originalRef->type))
+    // Get the new node to inheret the parent's shadow and deletion flags.
+    if (IsShadow(nodeRef))
     {
-        tdb_SetEmpty(originalRef);
+        SetShadowFlag(newRef);
+        SetDeletedFlag(newRef);
     }
 
-    // Ok, we know that the node hasn't been deleted.  Check to see if it's considered empty and
-    // that it isn't a stem.  If not, then copy over the string value.
-    if (   (nodeType != LE_CFG_TYPE_EMPTY)
-        && (nodeType != LE_CFG_TYPE_STEM))
+    if (IsDeleted(nodeRef))
     {
-        if (nodeRef->info.valueRef != NULL)
-        {
-            if (originalRef->info.valueRef != NULL)
-            {
-                dstr_Copy(originalRef->info.valueRef, nodeRef->info.valueRef);
-            }
-            else
-            {
-                originalRef->info.valueRef = dstr_NewFromDstr(nodeRef->info.valueRef);
-            }
-
-            // Propigate over the type as that may have changed, like going from an int value to a
-            // bool value.
-
-            originalRef->type = nodeRef->type;
-        }
+        SetDeletedFlag(newRef);
     }
 
-    // Now at this point, if both the original and the shadow node are stems, we'll let the function
-    // InternalMergeTree take care of the children, (if any.)
+    // Now make sure to add the new child node to the end of the parents collection.
+    AddChild(nodeRef, newRef);
 
-    // If the original has been cleared out, we can still just rely on InternalMergeTree to
-    // propigate over the new nodes.
+    // Finally return the newly created node to the caller.
+    return newRef;
 }
 
 
@@ -1130,77 +1413,84 @@ static void MergeNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Called to fire any callbacks registered on the given node path.  If nothing is registered on the
- *  given path, nothing happens.
+ *  Called to shadow a node's collection of children.
  */
 // -------------------------------------------------------------------------------------------------
-static void TriggerCallbacks
+static void ShadowChildren
 (
-    le_pathIter_Ref_t pathRef  ///< [IN] The path to search for callback registrations.
+    tdb_NodeRef_t shadowParentRef  ///< [IN] The node we're shadowing the children of.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Read the path out of the buffer.
-    char pathBuffer[CFG_MAX_PATH_SIZE] = { 0 };
-    if (le_pathIter_GetPath(pathRef, pathBuffer, sizeof(pathBuffer)) != LE_OK)
+    // If the parent node isn't a stem then there isn't much else to do here.
+    if (shadowParentRef->type != LE_CFG_TYPE_STEM)
     {
-        LE_ERROR("Callback path buffer overflow.");
         return;
     }
 
-    // Try to find a registration object for this path.  If one is found, flag it for calling once
-    // the merge is complete.
-    Registration_t* foundRegistrationPtr = le_hashmap_Get(HandlerRegistrationMap, pathBuffer);
+    // Does this node have any children currently?  If yes, then we don't need to do anything else.
+    if (le_dls_IsEmpty(&shadowParentRef->info.children) == false)
+    {
+        return;
+    }
 
-    if (foundRegistrationPtr != NULL)
+    // Has this node been modified?  If so, then the shadow children may have been cleared from
+    // this collection.
+    if (IsModified(shadowParentRef) == true)
     {
-        foundRegistrationPtr->triggered = true;
+        return;
     }
-}
 
+    // This node has no shadow children.  So what we do now is check the original node... Does it
+    // have any children?  If it does, we simply recreate the whole collection now.  (We do not
+    // recurse into the grandchildren though.)  Doing this now makes life simpler, instead of doing
+    // this piecemeal and possibly out of order.
+    tdb_NodeRef_t originalRef = shadowParentRef->shadowRef;
+
+    if (   (originalRef == NULL)
+        || (originalRef->type != LE_CFG_TYPE_STEM))
+    {
+        return;
+    }
+
+    // Simply iterate through the original collection and add a new shadow child to our own
+    // collection.
+    tdb_NodeRef_t originalChildRef = tdb_GetFirstChildNode(originalRef);
+
+    while (originalChildRef != NULL)
+    {
+        tdb_NodeRef_t newShadowRef = NewShadowNode(originalChildRef);
+        newShadowRef->parentRef = shadowParentRef;
+
+        AddChild(shadowParentRef, newShadowRef);
+
+        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
+    }
+}
 
 
 
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Go through all of the registered event callbacks, and fire the call backs for each of the
- *  registrations that has been makred as triggered.
- *
- *  Once this is done, the triggered flag is cleared for next time.
+ *  Search up through a node tree until we find the root node.
  */
 // -------------------------------------------------------------------------------------------------
-static void FireTriggeredCallbacks
+static tdb_NodeRef_t GetRootParentNode
 (
-    void
+    tdb_NodeRef_t nodeRef  ///< [IN] Find the greatest grand parent of this node.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Go through the registration map.
-    le_hashmap_It_Ref_t handlerIterRef = le_hashmap_GetIterator(HandlerRegistrationMap);
+    tdb_NodeRef_t parentRef = NULL;
 
-    while (le_hashmap_NextNode(handlerIterRef) == LE_OK)
+    while (nodeRef != NULL)
     {
-        // For each registration, check to see if it was triggered.
-        Registration_t* registrationPtr = (Registration_t*)le_hashmap_GetValue(handlerIterRef);
-
-        if (registrationPtr->triggered)
-        {
-            // This registration has been triggered, so call all of the handlers attached to it.
-            le_dls_Link_t* linkPtr = le_dls_Peek(&registrationPtr->handlerList);
-
-            while (linkPtr != NULL)
-            {
-                Handler_t* handlerObjectPtr = CONTAINER_OF(linkPtr, Handler_t, link);
-
-                handlerObjectPtr->handlerPtr(handlerObjectPtr->contextPtr);
-                linkPtr = le_dls_PeekNext(&registrationPtr->handlerList, linkPtr);
-            }
-
-            // Now that that's done, clear the triggered flag.
-            registrationPtr->triggered = false;
-        }
+        parentRef = nodeRef;
+        nodeRef = tdb_GetNodeParent(nodeRef);
     }
+
+    return parentRef;
 }
 
 
@@ -1208,39 +1498,65 @@ static void FireTriggeredCallbacks
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check the given node to see if it was renamed.
+ *  Search a node's child collection for a child with the given name.  If the search has to look
+ *  through a lot of children, then the node is given a child index to speed up the next search.
  *
- *  @return True if the node was renamed within this transaction.  False if not.
+ *  @return Reference to the found child node, or NULL if a node was not found.
  */
 // -------------------------------------------------------------------------------------------------
-static bool WasRenamed
+static tdb_NodeRef_t FindChild
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] Check this node to see if it was renamed in this transaction.
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node to search.
+    const char* namePtr     ///< [IN] The name we're searching for.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    if (IsModified(nodeRef) == false)
+    // Make sure that all of the children have been loaded or shadowed first.
+    tdb_NodeRef_t currentRef = tdb_GetFirstChildNode(nodeRef);
+
+    // Every node's name is in the name table, so if the name isn't there then there's no such
+    // child.
+    nstr_Ref_t nameRef = nstr_FindName(namePtr);
+
+    if (nameRef == NULL)
     {
-        // The node wasn't even modified, so it can not have been renamed.
-        return false;
+        return NULL;
     }
 
-    if (nodeRef->shadowRef == NULL)
+    uint32_t nameHash = nstr_GetHash(nameRef);
+    ChildIndex_t* indexPtr = nodeRef->indexPtr;
+
+    if (indexPtr != NULL)
     {
-        // If the node doesn't have a shadow reference, then most likely this is a new node and not
-        // a rename of an existing one.
-        return false;
+        size_t mask = indexPtr->slotCount - 1;
+        size_t slot;
+
+        for (slot = nameHash & mask; indexPtr->slots[slot] != NULL; slot = (slot + 1) & mask)
+        {
+            if (IsNamed(indexPtr->slots[slot], nameRef))
+            {
+                return indexPtr->slots[slot];
+            }
+        }
+
+        return NULL;
     }
 
-    if (nodeRef->nameRef == NULL)
+    size_t searchCount = 0;
+
+    while (   (currentRef != NULL)
+           && (IsNamed(currentRef, nameRef) == false))
     {
-        // The shadow node does not have a local copy of a name, so it can not have been renamed.
-        // It must have been modified for other reasons.
-        return false;
+        searchCount++;
+        currentRef = tdb_GetNextSiblingNode(currentRef);
     }
 
-    // Looks like the node has a new name.
-    return true;
+    if (searchCount > CHILD_INDEX_THRESHOLD)
+    {
+        BuildChildIndex(nodeRef);
+    }
+
+    return currentRef;
 }
 
 
@@ -1248,26 +1564,36 @@ static bool WasRenamed
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check the original non-shadow node to see if it will need to be cleared during the merge.
+ *  Called to look for a named child in a given node's child collection.
  *
- *  @return True if the merge will clear out the original value.  False if not.
+ *  @return Reference to the found child node, or NULL if a node was not found.
  */
 // -------------------------------------------------------------------------------------------------
-static bool OriginalToBeCleared
+static tdb_NodeRef_t GetNamedChild
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The shadow node to check.
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node to search.
+    const char* nameRef     ///< [IN] The name we're searching for.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_cfg_nodeType_t nodeType = tdb_GetNodeType(nodeRef);
+    // Is this one of the "special" names?
+    if (strcmp(nameRef, ".") == 0)
+    {
+        return nodeRef;
+    }
 
-    if (   (nodeType == LE_CFG_TYPE_EMPTY)
-        || (nodeType != tdb_GetNodeType(nodeRef->shadowRef)))
+    if (strcmp(nameRef, "..") == 0)
     {
-        return true;
+        return nodeRef->parentRef;
     }
 
-    return false;
+    // If the current node isn't a stem, then this node can't have any children.
+    if (nodeRef->type != LE_CFG_TYPE_STEM)
+    {
+        return NULL;
+    }
+
+    return FindChild(nodeRef, nameRef);
 }
 
 
@@ -1275,27 +1601,46 @@ static bool OriginalToBeCleared
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Append the name of a node onto the end of a path object.
+ *  Called to create a named child in a nodes child collection.  However, this function will only
+ *  create nodes on shadow trees.
+ *
+ *  @return Reference to newly created child node, or NULL if it can not be created.
  */
 // -------------------------------------------------------------------------------------------------
-static void AppendNodeName
+static tdb_NodeRef_t CreateNamedChild
 (
-    le_pathIter_Ref_t pathRef,  ///< [IN] The path we're appending to.
-    tdb_NodeRef_t nodeRef       ///< [IN] The node we're appending.
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node to search.
+    const char* nameRef     ///< [IN] The name we're searching for.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
+    tdb_NodeRef_t childRef = NULL;
 
-    LE_ASSERT(tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName)) == LE_OK);
-    le_result_t result = le_pathIter_Append(pathRef, nodeName);
+    if (IsShadow(nodeRef) == true)
+    {
+        // If the node isn't a stem, then convert it into an empty one now.
+        if (   (nodeRef->type != LE_CFG_TYPE_STEM)
+            && (nodeRef->type != LE_CFG_TYPE_EMPTY))
+        {
+            tdb_SetEmpty(nodeRef);
+            nodeRef->type = LE_CFG_TYPE_STEM;
+            nodeRef->info.children = LE_DLS_LIST_INIT;
+        }
 
-    LE_WARN_IF(result != LE_OK,
-               "Could not append node '%s' onto the update callback tracking path.  "
-               "Reason: %d, '%s'.",
-               nodeName,
-               result,
-               LE_RESULT_TXT(result));
+        // Create the node, and set it's deleted flag as it hasn't been used for anything yet.
+        childRef = NewChildNode(nodeRef);
+        SetDeletedFlag(childRef);
+
+        // Set the name of the new node, if that fails then the user had given us a bad name for the
+        // new node.  So in that case free the node and return NULL.
+        if (tdb_SetNodeName(childRef, nameRef) != LE_OK)
+        {
+            le_mem_Release(childRef);
+            childRef = NULL;
+        }
+    }
+
+    return childRef;
 }
 
 
@@ -1303,21 +1648,19 @@ static void AppendNodeName
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Create a new config path for the tree name given.
+ *  Check to see if a given node exists within a node's child collection.
  *
- *  @return A new config path, rooted on the given tree.
+ *  @return True if the given node exists within the parent node's collection.  False if not.
  */
 // -------------------------------------------------------------------------------------------------
-static le_pathIter_Ref_t CreateBasePath
+static bool NodeExists
 (
-    const char* treeNamePtr  ///< [IN] The tree name to use for the new path object.
+    tdb_NodeRef_t parentRef,  ///< [IN] The parent node to search.
+    const char* namePtr       ///< [IN] The name to search for.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    char basePath[CFG_MAX_PATH_SIZE] = { 0 };
-
-    snprintf(basePath, sizeof(basePath), "%s:/", treeNamePtr);
-    return le_pathIter_CreateForUnix(basePath);
+    return FindChild(parentRef, namePtr) != NULL;
 }
 
 
@@ -1325,23 +1668,28 @@ static le_pathIter_Ref_t CreateBasePath
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Generate a config path to the given node.
+ *  Check the given node type and see if it should have a string value.
+ *
+ *  @return True if the given node could hold a string value.  False if not.
  */
 // -------------------------------------------------------------------------------------------------
-static void GeneratePath
+static bool IsStringType
 (
-    le_pathIter_Ref_t pathRef,  ///< [IN] The path object we're updating.
-    tdb_NodeRef_t nodeRef       ///< [IN] The node we're creating a path for.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to read.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    if (nodeRef == NULL)
+    le_cfg_nodeType_t type = tdb_GetNodeType(nodeRef);
+
+    if (   (type == LE_CFG_TYPE_STRING)
+        || (type == LE_CFG_TYPE_BOOL)
+        || (type == LE_CFG_TYPE_INT)
+        || (type == LE_CFG_TYPE_FLOAT))
     {
-        return;
+        return true;
     }
 
-    GeneratePath(pathRef, nodeRef->parentRef);
-    AppendNodeName(pathRef, nodeRef);
+    return false;
 }
 
 
@@ -1349,36 +1697,35 @@ static void GeneratePath
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Trigger callbacks for this node and all of it's children.
+ *  This function will copy a string value from an original tree node into a node that has shadowed
+ *  it.
  */
 // -------------------------------------------------------------------------------------------------
-static void FireAllChildren
+static void PropagateValue
 (
-    le_pathIter_Ref_t pathRef,  ///< [IN] Path to the parent of the current node.
-    tdb_NodeRef_t nodeRef       ///< [IN] Node and any children to merge.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node ref to update.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Add this node to the path we're using to find registered callbacks.
-    AppendNodeName(pathRef, nodeRef);
+    // If the node doesn't even have a ref to an original node, then there's nothing left to do
+    // here.
+    tdb_NodeRef_t shadowRef = nodeRef->shadowRef;
 
-    // If the node is a stem then traverse it's children and try to trigger callbacks for them.  If
-    // there are no callbacks registered for those nodes, then nothing will happen.
-    if (nodeRef->type == LE_CFG_TYPE_STEM)
+    if (shadowRef == NULL)
     {
-        tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
-
-        while (childRef != NULL)
-        {
-            FireAllChildren(pathRef, childRef);
-            childRef = tdb_GetNextSiblingNode(childRef);
-        }
+        return;
     }
 
-    // Like with the children, try to do the same for this node.  Then remove this node from the
-    // tracking path.
-    TriggerCallbacks(pathRef);
-    le_pathIter_Truncate(pathRef);
+    // Ok, figure out the type for this node.  If it has a value, and the original
+    if (   (IsStringType(nodeRef) == true)
+        && (IsStringType(shadowRef) == true)
+        && (nodeRef->info.valueRef == NULL)
+        && (shadowRef->info.valueRef != NULL))
+    {
+        // Looks like the value hasn't been propagated or changed yet.  So, do so now.
+        nstr_AddRef(shadowRef->info.valueRef);
+        nodeRef->info.valueRef = shadowRef->info.valueRef;
+    }
 }
 
 
@@ -1386,82 +1733,123 @@ static void FireAllChildren
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check a given shadow node and the original node it's shadowing.  If the original has children
- *  that will be lost because of a merge, then we need to fire callbacks for those nodes that are
- *  about to go away.
- *
- *  The algorithm employed by this function is as follows:
- *
- *      1. Check the original node for the given shadow node.  If it exists and is a stem node,
- *         mark all of the children as deleted.  (This is done with the expectation that the
- *         original tree does not have nodes with the deleted flag set.)
- *
- *      2. Go through the shadow collection, and any shadow children that have links to the original
- *         nodes, clear the deleted flag.  These nodes are still considered "live."
- *
- *      3. Travers the original children one more time.  For any node that is still marked as
- *         deleted we queue up an event handler.  As this node has been removed from the colection
- *         and will be removed as part of the final merge.  The delete flag is also cleared at this
- *         step to ensure that there are no external side effects.
+ *  Merge a shadow node with the original it represents.
  */
 // -------------------------------------------------------------------------------------------------
-static void FireLostChildren
+static void MergeNode
 (
-    le_pathIter_Ref_t pathRef,   ///< [IN] Path to the parent of the current node.
-    tdb_NodeRef_t shadowNodeRef  ///< [IN] Node and any children to merge.
+    tdb_NodeRef_t nodeRef  ///< [IN] The shadow node to merge.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Is the original a stem?  If no, then done.
-    tdb_NodeRef_t originalRef = shadowNodeRef->shadowRef;
+    LE_ASSERT(nodeRef != NULL);
 
-    if (originalRef->type != LE_CFG_TYPE_STEM)
+    // If this shadow node for some reason doesn't have a ref check for an original version of it in
+    // the original tree.  This shadow node may have been destroyed and re-created loosing this
+    // link.
+    if (nodeRef->shadowRef == NULL)
+    {
+        tdb_NodeRef_t shadowedParentRef = tdb_GetNodeParent(nodeRef)->shadowRef;
+
+        if (shadowedParentRef != NULL)
+        {
+            char name[LE_CFG_NAME_LEN_BYTES] = "";
+
+            tdb_GetNodeName(nodeRef, name, sizeof(name));
+            nodeRef->shadowRef = GetNamedChild(shadowedParentRef, name);
+        }
+    }
+
+    // If this node has been marked as deleted, then simply drop the original node and move on.
+    if (IsDeleted(nodeRef))
     {
+        if (   (nodeRef->shadowRef != NULL)
+            && (tdb_GetNodeParent(nodeRef->shadowRef) != NULL))
+        {
+            le_mem_Release(nodeRef->shadowRef);
+        }
+        else
+        {
+            // We delete every node but the root node.  Since this is the root node, we just need
+            // to clear it out.
+            tdb_SetEmpty(nodeRef->shadowRef);
+        }
+
         return;
     }
 
-    // Mark all originals deleted.
-    tdb_NodeRef_t originalChildRef = tdb_GetFirstChildNode(originalRef);
+    // If the original node doesn't exist, create it now.
+    tdb_NodeRef_t originalRef = nodeRef->shadowRef;
 
-    while (originalChildRef != NULL)
+    if (originalRef == NULL)
     {
-        // Children in the original tree shouldn't currently be marked as deleted.
-        LE_ASSERT(IsDeleted(originalChildRef) == false);
+        LE_ASSERT(nodeRef->parentRef != NULL);
+        LE_ASSERT(nodeRef->parentRef->shadowRef != NULL);
 
-        SetDeletedFlag(originalChildRef);
-        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
+        nodeRef->shadowRef = originalRef = NewChildNode(nodeRef->parentRef->shadowRef);
     }
 
-    // Follow through all of the shadow links and unmark deletions.
-    if (shadowNodeRef->type == LE_CFG_TYPE_STEM)
+    // If the name has been changed, then copy it over now.
+    if (   (nodeRef->nameRef != NULL)
+        && (nodeRef->nameRef != originalRef->nameRef))
     {
-        tdb_NodeRef_t shadowChildRef = tdb_GetFirstChildNode(shadowNodeRef);
+        UnindexChild(originalRef);
 
-        while (shadowChildRef != NULL)
+        if (originalRef->nameRef != NULL)
         {
-            if (shadowChildRef->shadowRef != NULL)
-            {
-                ClearDeletedFlag(shadowChildRef->shadowRef);
-            }
-
-            shadowChildRef = tdb_GetNextSiblingNode(shadowChildRef);
+            nstr_Release(originalRef->nameRef);
         }
+
+        nstr_AddRef(nodeRef->nameRef);
+        originalRef->nameRef = nodeRef->nameRef;
+
+        originalRef->nameHash = nodeRef->nameHash;
+        IndexChild(originalRef);
     }
 
-    // Fire on all original nodes still marked.  But also take care to clear the deleted flags here
-    // in order to leave everything as it was.
-    originalChildRef = tdb_GetFirstChildNode(originalRef);
+    // Check the types of the original and the shadow nodes.  If the new node has been cleared,
+    // then clear out the original node.  If the types have changed, then clear out the original so
+    // that we can properly populate it again.
+    le_cfg_nodeType_t nodeType = tdb_GetNodeType(nodeRef);
 
-    while (originalChildRef != NULL)
+    if (   (nodeType == LE_CFG_TYPE_EMPTY)
+        || (nodeType != originalRef->type))
     {
-        if (IsDeleted(originalChildRef) == true)
+        tdb_SetEmpty(originalRef);
+    }
+
+    // Ok, we know that the node hasn't been deleted.  Check to see if it's considered empty and
+    // that it isn't a stem.  If not, then copy over the string value.
+    if (   (nodeType != LE_CFG_TYPE_EMPTY)
+        && (nodeType != LE_CFG_TYPE_STEM))
+    {
+        if (nodeRef->info.valueRef != NULL)
         {
-            FireAllChildren(pathRef, originalChildRef);
-            ClearDeletedFlag(originalChildRef);
-        }
+            nstr_AddRef(nodeRef->info.valueRef);
 
-        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
+            if (originalRef->info.valueRef != NULL)
+            {
+                nstr_Release(originalRef->info.valueRef);
+            }
+
+            originalRef->info.valueRef = nodeRef->info.valueRef;
+
+            // Propigate over the type as that may have changed, like going from an int value to a
+            // bool value.
+
+            originalRef->type = nodeRef->type;
+        }
     }
+
+    // Clearing the original above marks it as modified.  Clear that now, otherwise shadows of the
+    // original would start out modified, and the next merge would empty it out again.
+    ClearModifiedFlag(originalRef);
+
+    // Now at this point, if both the original and the shadow node are stems, we'll let the function
+    // InternalMergeTree take care of the children, (if any.)
+
+    // If the original has been cleared out, we can still just rely on InternalMergeTree to
+    // propigate over the new nodes.
 }
 
 
@@ -1469,93 +1857,117 @@ static void FireLostChildren
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Recursive function to merge a collection of shadow nodes with the original tree.
- *
- *  @return True if the given node or any if it's children have been modified.  False if not.
+ *  Called to fire any callbacks registered on the given node path.  If nothing is registered on the
+ *  given path, nothing happens.
  */
 // -------------------------------------------------------------------------------------------------
-static bool InternalMergeTree
+static void TriggerCallbacks
 (
-    const char* treeNamePtr,    ///< [IN] The name of the tree we're merging.
-    le_pathIter_Ref_t pathRef,  ///< [IN] Path to the parent of hte current node.
-    tdb_NodeRef_t nodeRef,      ///< [IN] Node and any children to merge.
-    bool forceFire              ///< [IN] Should update handlers be fired for this node and all it's
-                                ///<      children, regardless of wether or not this node has been
-                                ///<      directly modified?
+    le_pathIter_Ref_t pathRef  ///< [IN] The path to search for callback registrations.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    bool isModified = IsModified(nodeRef);
-    bool renamed = WasRenamed(nodeRef);
+    // Read the path out of the buffer.
+    char pathBuffer[CFG_MAX_PATH_SIZE] = { 0 };
+    if (le_pathIter_GetPath(pathRef, pathBuffer, sizeof(pathBuffer)) != LE_OK)
+    {
+        LE_ERROR("Callback path buffer overflow.");
+        return;
+    }
 
-    // If this node was renamed, then all children also need to be triggered as well.
-    forceFire = renamed || forceFire;
+    // Try to find a registration object for this path.  If one is found, flag it for calling once
+    // the merge is complete.
+    Registration_t* foundRegistrationPtr = le_hashmap_Get(HandlerRegistrationMap, pathBuffer);
 
-    // If this node has been renamed, marked as deleted or set empty, then all of the children need
-    // notifications fired on the original nodes.
-    if (   (renamed == true)
-        || (IsDeleted(nodeRef) == true)
-        || (OriginalToBeCleared(nodeRef) == true))
+    if (foundRegistrationPtr != NULL)
     {
-        le_pathIter_Ref_t originalPathRef = CreateBasePath(treeNamePtr);
-
-        if (nodeRef->shadowRef != NULL)
-        {
-            GeneratePath(originalPathRef, nodeRef->shadowRef->parentRef);
-            FireAllChildren(originalPathRef, nodeRef->shadowRef);
-        }
-
-        le_pathIter_Delete(originalPathRef);
+        foundRegistrationPtr->triggered = true;
     }
-    else if (   (isModified == true)
-             && (nodeRef->type == LE_CFG_TYPE_STEM))
-    {
-        le_pathIter_Ref_t originalPathRef = CreateBasePath(treeNamePtr);
+}
 
-        GeneratePath(originalPathRef, nodeRef->shadowRef);
-        FireLostChildren(originalPathRef, nodeRef);
 
-        le_pathIter_Delete(originalPathRef);
-    }
 
-    AppendNodeName(pathRef, nodeRef);
 
-    // IF this node is modified, mearge it.  If this node is a stem, then merge it's children.  Keep
-    // track of whether any of those children have been modified as well.
-    if (isModified)
-    {
-        MergeNode(nodeRef);
-    }
 
-    if (   (nodeRef->type == LE_CFG_TYPE_STEM)
-        && (IsDeleted(nodeRef) == false))
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Go through all of the registered event callbacks, and fire the call backs for each of the
+ *  registrations that has been makred as triggered.
+ *
+ *  Once this is done, the triggered flag is cleared for next time.
+ */
+// -------------------------------------------------------------------------------------------------
+static void FireTriggeredCallbacks
+(
+    void
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Go through the registration map.
+    le_hashmap_It_Ref_t handlerIterRef = le_hashmap_GetIterator(HandlerRegistrationMap);
+
+    while (le_hashmap_NextNode(handlerIterRef) == LE_OK)
     {
-        nodeRef = tdb_GetFirstChildNode(nodeRef);
+        // For each registration, check to see if it was triggered.
+        Registration_t* registrationPtr = (Registration_t*)le_hashmap_GetValue(handlerIterRef);
 
-        while (nodeRef != NULL)
+        if (registrationPtr->triggered)
         {
-            tdb_NodeRef_t nextNodeRef = tdb_GetNextSiblingNode(nodeRef);
+            // This registration has been triggered, so call all of the handlers attached to it.
+            le_dls_Link_t* linkPtr = le_dls_Peek(&registrationPtr->handlerList);
 
-            isModified = InternalMergeTree(treeNamePtr, pathRef, nodeRef, forceFire) || isModified;
-            nodeRef = nextNodeRef;
+            while (linkPtr != NULL)
+            {
+                Handler_t* handlerObjectPtr = CONTAINER_OF(linkPtr, Handler_t, link);
+
+                handlerObjectPtr->handlerPtr(handlerObjectPtr->contextPtr);
+                linkPtr = le_dls_PeekNext(&registrationPtr->handlerList, linkPtr);
+            }
+
+            // Now that that's done, clear the triggered flag.
+            registrationPtr->triggered = false;
         }
     }
+}
 
-    // If this node, or any of it's children have been modified.  Try to fire any callbacks that may
-    // be registered.
-    if (isModified || forceFire)
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check the given node to see if it was renamed.
+ *
+ *  @return True if the node was renamed within this transaction.  False if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool WasRenamed
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] Check this node to see if it was renamed in this transaction.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (IsModified(nodeRef) == false)
     {
-        TriggerCallbacks(pathRef);
+        // The node wasn't even modified, so it can not have been renamed.
+        return false;
     }
 
-    // Now remove this node from the tracking path and let our caller know if any modifications have
-    // happened at this level or lower.
-    if (le_pathIter_GoToEnd(pathRef) == LE_OK)
+    if (nodeRef->shadowRef == NULL)
     {
-        le_pathIter_Truncate(pathRef);
+        // If the node doesn't have a shadow reference, then most likely this is a new node and not
+        // a rename of an existing one.
+        return false;
     }
 
-    return isModified;
+    if (nodeRef->nameRef == NULL)
+    {
+        // The shadow node does not have a local copy of a name, so it can not have been renamed.
+        // It must have been modified for other reasons.
+        return false;
+    }
+
+    // Looks like the node has a new name.
+    return true;
 }
 
 
@@ -1563,31 +1975,26 @@ static bool InternalMergeTree
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Create a new tree object and set it to default values.
+ *  Check the original non-shadow node to see if it will need to be cleared during the merge.
  *
- *  @return A ref to the newly created tree object.
+ *  @return True if the merge will clear out the original value.  False if not.
  */
 // -------------------------------------------------------------------------------------------------
-tdb_TreeRef_t NewTree
+static bool OriginalToBeCleared
 (
-    const char* treeNameRef,   ///< [IN] The name of the new tree.
-    tdb_NodeRef_t rootNodeRef  ///< [IN] The root node of this new tree.
+    tdb_NodeRef_t nodeRef  ///< [IN] The shadow node to check.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_TreeRef_t treeRef = le_mem_ForceAlloc(TreePoolRef);
-
-    LE_ASSERT(le_utf8_Copy(treeRef->name, treeNameRef, MAX_TREE_NAME_BYTES, NULL) == LE_OK);
+    le_cfg_nodeType_t nodeType = tdb_GetNodeType(nodeRef);
 
-    treeRef->isDeletePending = false;
-    treeRef->originalTreeRef = NULL;
-    treeRef->revisionId = 0;
-    treeRef->rootNodeRef = (rootNodeRef != NULL) ? rootNodeRef : NewNode();
-    treeRef->activeReadCount = 0;
-    treeRef->activeWriteIterRef = NULL;
-    treeRef->requestList = LE_SLS_LIST_INIT;
+    if (   (nodeType == LE_CFG_TYPE_EMPTY)
+        || (nodeType != tdb_GetNodeType(nodeRef->shadowRef)))
+    {
+        return true;
+    }
 
-    return treeRef;
+    return false;
 }
 
 
@@ -1595,25 +2002,27 @@ tdb_TreeRef_t NewTree
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Destructor called when a tree object is to be freed from memory.
+ *  Append the name of a node onto the end of a path object.
  */
 // -------------------------------------------------------------------------------------------------
-static void TreeDestructor
+static void AppendNodeName
 (
-    void* objectPtr  ///< The memory object to destruct.
+    le_pathIter_Ref_t pathRef,  ///< [IN] The path we're appending to.
+    tdb_NodeRef_t nodeRef       ///< [IN] The node we're appending.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_TreeRef_t treeRef = (tdb_TreeRef_t)objectPtr;
+    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
 
-    // Kill the root node.
-    le_mem_Release(treeRef->rootNodeRef);
-    treeRef->rootNodeRef = NULL;
+    LE_ASSERT(tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName)) == LE_OK);
+    le_result_t result = le_pathIter_Append(pathRef, nodeName);
 
-    // Sanity check, is the tree actually ready to clean up?
-    LE_ASSERT(treeRef->activeReadCount == 0);
-    LE_ASSERT(treeRef->activeWriteIterRef == NULL);
-    LE_ASSERT(le_sls_IsEmpty(&treeRef->requestList) == true);
+    LE_WARN_IF(result != LE_OK,
+               "Could not append node '%s' onto the update callback tracking path.  "
+               "Reason: %d, '%s'.",
+               nodeName,
+               result,
+               LE_RESULT_TXT(result));
 }
 
 
@@ -1621,41 +2030,21 @@ static void TreeDestructor
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Create a path to a tree file with the given revision id.
+ *  Create a new config path for the tree name given.
  *
- *  @return A stringBuffer backed string containing the full path to the tree file.
+ *  @return A new config path, rooted on the given tree.
  */
 // -------------------------------------------------------------------------------------------------
-static void GetTreePath
+static le_pathIter_Ref_t CreateBasePath
 (
-    const char* treeNameRef,  ///< [IN] The name of the tree we're generating a name for.
-    int revisionId,           ///< [IN] Generate a name based on the tree revision.
-    char* pathBuffer,         ///< [IN] Buffer to hold the new path.
-    size_t pathSize           ///< [IN] Size of the path buffer.
+    const char* treeNamePtr  ///< [IN] The tree name to use for the new path object.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // paper    --> rock       1 -> 2
-    // rock     --> scissors   2 -> 3
-    // scissors --> paper      3 -> 1
-
-    static const char* revNames[] = { "paper", "rock", "scissors" };
-    int printSize;
-
-    LE_ASSERT((revisionId >= 1) && (revisionId <= 3));
-
-    printSize = snprintf(pathBuffer,
-                         pathSize,
-                         "%s/%s.%s",
-                         CFG_TREE_PATH,
-                         treeNameRef,
-                         revNames[revisionId - 1]);
+    char basePath[CFG_MAX_PATH_SIZE] = { 0 };
 
-    if (printSize >= pathSize)
-    {
-       LE_ERROR("Unable to store config tree path in buffer");
-       pathBuffer[0] = '\0';
-    }
+    snprintf(basePath, sizeof(basePath), "%s:/", treeNamePtr);
+    return le_pathIter_CreateForUnix(basePath);
 }
 
 
@@ -1663,36 +2052,23 @@ static void GetTreePath
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check to see if a configTree file at the given revision already exists in the filesystem.
- *
- *  @return True if the named file exists, false otherwise.
+ *  Generate a config path to the given node.
  */
 // -------------------------------------------------------------------------------------------------
-static bool TreeFileExists
+static void GeneratePath
 (
-    const char* treeNameRef,  ///< [IN] Name of the tree to check.
-    int revisionId            ///< [IN] The revision of the tree to check against.
+    le_pathIter_Ref_t pathRef,  ///< [IN] The path object we're updating.
+    tdb_NodeRef_t nodeRef       ///< [IN] The node we're creating a path for.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    char fullPath[LE_CFG_STR_LEN_BYTES] = "";
-    GetTreePath(treeNameRef, revisionId, fullPath, sizeof(fullPath));
-
-    // Make sure this part was successful.
-    if (fullPath[0] == '\0')
-    {
-        return false;
-    }
-
-    // Now call into the Linux and ask the file system if the file exists.
-    bool result = false;
-
-    if (access(fullPath, R_OK) != -1)
+    if (nodeRef == NULL)
     {
-        result = true;
+        return;
     }
 
-    return result;
+    GeneratePath(pathRef, nodeRef->parentRef);
+    AppendNodeName(pathRef, nodeRef);
 }
 
 
@@ -1700,48 +2076,168 @@ static bool TreeFileExists
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check the filesystem and get the "valid" version of the file.  That is, if there are two files
- *  for a given tree, we use the older one.  The idea being, if there are two versions of the same
- *  file in the filesystem then it's highly likely there was a system failure during a streaming
- *  operation.  So we abandon the newer file and go with the older more reliable file.
+ *  Trigger callbacks for this node and all of it's children.
  */
 // -------------------------------------------------------------------------------------------------
-static void UpdateRevision
+static void FireAllChildren
 (
-    tdb_TreeRef_t treeRef  ///< [IN] Update the revision for this tree object.
+    le_pathIter_Ref_t pathRef,  ///< [IN] Path to the parent of the current node.
+    tdb_NodeRef_t nodeRef       ///< [IN] Node and any children to merge.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    int newRevision = 0;
+    // Add this node to the path we're using to find registered callbacks.
+    AppendNodeName(pathRef, nodeRef);
 
-    if (TreeFileExists(treeRef->name, 1))
+    // If the node is a stem then traverse it's children and try to trigger callbacks for them.  If
+    // there are no callbacks registered for those nodes, then nothing will happen.
+    if (nodeRef->type == LE_CFG_TYPE_STEM)
     {
-        if (TreeFileExists(treeRef->name, 3))
-        {
-            newRevision = 3;
-        }
-        else
+        tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
+
+        while (childRef != NULL)
         {
-            newRevision = 1;
+            FireAllChildren(pathRef, childRef);
+            childRef = tdb_GetNextSiblingNode(childRef);
         }
     }
-    else if (TreeFileExists(treeRef->name, 3))
+
+    // Like with the children, try to do the same for this node.  Then remove this node from the
+    // tracking path.
+    TriggerCallbacks(pathRef);
+    le_pathIter_Truncate(pathRef);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check a given shadow node and the original node it's shadowing.  If the original has children
+ *  that will be lost because of a merge, then we need to fire callbacks for those nodes that are
+ *  about to go away.
+ *
+ *  The algorithm employed by this function is as follows:
+ *
+ *      1. Check the original node for the given shadow node.  If it exists and is a stem node,
+ *         mark all of the children as deleted.  (This is done with the expectation that the
+ *         original tree does not have nodes with the deleted flag set.)
+ *
+ *      2. Go through the shadow collection, and any shadow children that have links to the original
+ *         nodes, clear the deleted flag.  These nodes are still considered "live."
+ *
+ *      3. Travers the original children one more time.  For any node that is still marked as
+ *         deleted we queue up an event handler.  As this node has been removed from the colection
+ *         and will be removed as part of the final merge.  The delete flag is also cleared at this
+ *         step to ensure that there are no external side effects.
+ */
+// -------------------------------------------------------------------------------------------------
+static void FireLostChildren
+(
+    le_pathIter_Ref_t pathRef,   ///< [IN] Path to the parent of the current node.
+    tdb_NodeRef_t shadowNodeRef  ///< [IN] Node and any children to merge.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Is the original a stem?  If no, then done.
+    tdb_NodeRef_t originalRef = shadowNodeRef->shadowRef;
+
+    if (originalRef->type != LE_CFG_TYPE_STEM)
     {
-        if (TreeFileExists(treeRef->name, 2))
+        return;
+    }
+
+    // Mark all originals deleted.
+    tdb_NodeRef_t originalChildRef = tdb_GetFirstChildNode(originalRef);
+
+    while (originalChildRef != NULL)
+    {
+        // Children in the original tree shouldn't currently be marked as deleted.
+        LE_ASSERT(IsDeleted(originalChildRef) == false);
+
+        SetDeletedFlag(originalChildRef);
+        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
+    }
+
+    // Follow through all of the shadow links and unmark deletions.
+    if (shadowNodeRef->type == LE_CFG_TYPE_STEM)
+    {
+        tdb_NodeRef_t shadowChildRef = tdb_GetFirstChildNode(shadowNodeRef);
+
+        while (shadowChildRef != NULL)
         {
-            newRevision = 2;
+            if (shadowChildRef->shadowRef != NULL)
+            {
+                ClearDeletedFlag(shadowChildRef->shadowRef);
+            }
+
+            shadowChildRef = tdb_GetNextSiblingNode(shadowChildRef);
         }
-        else
+    }
+
+    // Fire on all original nodes still marked.  But also take care to clear the deleted flags here
+    // in order to leave everything as it was.
+    originalChildRef = tdb_GetFirstChildNode(originalRef);
+
+    while (originalChildRef != NULL)
+    {
+        if (IsDeleted(originalChildRef) == true)
         {
-            newRevision = 3;
+            FireAllChildren(pathRef, originalChildRef);
+            ClearDeletedFlag(originalChildRef);
         }
+
+        originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
     }
-    else if (TreeFileExists(treeRef->name, 2))
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write data straight to the snapshot file, bypassing the buffer.
+ */
+// -------------------------------------------------------------------------------------------------
+static void WriteSnapshotFile
+(
+    SnapshotWriter_t* writerPtr,  ///< [IN] The snapshot being written.
+    const void* dataPtr,          ///< [IN] The data to write.
+    size_t dataSize               ///< [IN] The amount of data to write.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    const uint8_t* bytePtr = dataPtr;
+
+    // Without a file, (when building a journal entry,) everything has to fit in the buffer.
+    if (   (writerPtr->descriptor == -1)
+        && (dataSize > 0)
+        && (writerPtr->result == LE_OK))
     {
-        newRevision = 2;
+        writerPtr->result = LE_OVERFLOW;
     }
 
-    treeRef->revisionId = newRevision;
+    while (   (dataSize > 0)
+           && (writerPtr->result == LE_OK))
+    {
+        ssize_t written = write(writerPtr->descriptor, bytePtr, dataSize);
+
+        if (written > 0)
+        {
+            bytePtr += written;
+            dataSize -= written;
+            writerPtr->flushedSize += written;
+        }
+        else if ((written == -1) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            LE_EMERG("Failed to write to config tree file, reason: %m");
+            writerPtr->result = LE_IO_ERROR;
+        }
+    }
 }
 
 
@@ -1749,19 +2245,49 @@ static void UpdateRevision
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Peek into the input stream one character ahead.
+ *  Write out any data waiting in the snapshot writer's buffer.
  */
 // -------------------------------------------------------------------------------------------------
-static signed char PeekChar
+static void FlushSnapshot
 (
-    FILE* filePtr  ///< [IN] The file stream to peek into.
+    SnapshotWriter_t* writerPtr  ///< [IN] The snapshot being written.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    char next = fgetc(filePtr);
-    ungetc(next, filePtr);
+    WriteSnapshotFile(writerPtr, writerPtr->buffer, writerPtr->bufferedSize);
+    writerPtr->bufferedSize = 0;
+}
 
-    return next;
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Add data to the end of the snapshot being written.
+ */
+// -------------------------------------------------------------------------------------------------
+static void AppendSnapshot
+(
+    SnapshotWriter_t* writerPtr,  ///< [IN] The snapshot being written.
+    const void* dataPtr,          ///< [IN] The data to add.
+    size_t dataSize               ///< [IN] The amount of data to add.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if ((writerPtr->bufferedSize + dataSize) > sizeof(writerPtr->buffer))
+    {
+        FlushSnapshot(writerPtr);
+
+        // Big blocks, like the children copied from an old snapshot, go straight to the file.
+        if (dataSize > sizeof(writerPtr->buffer))
+        {
+            WriteSnapshotFile(writerPtr, dataPtr, dataSize);
+            return;
+        }
+    }
+
+    memcpy(writerPtr->buffer + writerPtr->bufferedSize, dataPtr, dataSize);
+    writerPtr->bufferedSize += dataSize;
 }
 
 
@@ -1769,45 +2295,1365 @@ static signed char PeekChar
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Skip any whitespace encountered in the input stream.  Stop skipping once we hit a valid token.
+ *  Get the position the next data appended to a snapshot will be written at.
  *
- *  @return LE_OK if the whitespace is skiped and there is still more file to read.
- *          LE_OUT_OF_RANGE if the end of the file is hit.
+ *  @return The position in the snapshot file.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t SkipWhiteSpace
+static off_t GetSnapshotPosition
 (
-    FILE* filePtr  ///< [IN] The file stream to seek through.
+    SnapshotWriter_t* writerPtr  ///< [IN] The snapshot being written.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    bool done = false;
-    bool isEof = false;
+    return writerPtr->flushedSize + writerPtr->bufferedSize;
+}
 
-    while (done == false)
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Overwrite data that has already been added to a snapshot, (such as a header whose sizes weren't
+ *  known when it was added.)
+ */
+// -------------------------------------------------------------------------------------------------
+static void PatchSnapshot
+(
+    SnapshotWriter_t* writerPtr,  ///< [IN] The snapshot being written.
+    off_t position,               ///< [IN] Position of the data to overwrite.
+    const void* dataPtr,          ///< [IN] The new data.
+    size_t dataSize               ///< [IN] The amount of data to overwrite.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // If the data was split across a flush, flush the rest of it too.
+    if (   (position < writerPtr->flushedSize)
+        && ((position + (off_t)dataSize) > writerPtr->flushedSize))
     {
-        switch (PeekChar(filePtr))
-        {
-            case '\n':
-            case '\r':
-            case '\t':
-            case ' ':
-                // Eat the character.
-                fgetc(filePtr);
-                break;
+        FlushSnapshot(writerPtr);
+    }
 
-            case EOF:
-                done = true;
-                isEof = true;
-                break;
+    if (writerPtr->result != LE_OK)
+    {
+        return;
+    }
 
-            default:
-                done = true;
-                break;
+    if (position >= writerPtr->flushedSize)
+    {
+        memcpy(writerPtr->buffer + (position - writerPtr->flushedSize), dataPtr, dataSize);
+    }
+    else
+    {
+        ssize_t written = -1;
+
+        do
+        {
+            written = pwrite(writerPtr->descriptor, dataPtr, dataSize, position);
+        }
+        while ((written == -1) && (errno == EINTR));
+
+        if (written != (ssize_t)dataSize)
+        {
+            LE_EMERG("Failed to write to config tree file, reason: %m");
+            writerPtr->result = LE_IO_ERROR;
         }
     }
+}
 
-    return isEof == true ? LE_OUT_OF_RANGE : LE_OK;
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Add the record for a node, and the records of all of its children, to a snapshot.
+ */
+// -------------------------------------------------------------------------------------------------
+static void WriteSnapshotRecord
+(
+    SnapshotWriter_t* writerPtr,  ///< [IN] The snapshot being written.
+    tdb_NodeRef_t nodeRef         ///< [IN] The node to write.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    RecordHeader_t header;
+    memset(&header, 0, sizeof(header));
+
+    // Nodes that have been deleted are written as empty nodes, just like in the text format.  So
+    // are stems without any children.
+    le_cfg_nodeType_t type = tdb_GetNodeType(nodeRef);
+    header.type = (type == LE_CFG_TYPE_DOESNT_EXIST) ? LE_CFG_TYPE_EMPTY : type;
+
+    // Names and values are stored contiguously, so they're written straight out of the node.
+    nstr_Ref_t nameRef = GetNameRef(nodeRef);
+    const char* namePtr = (nameRef != NULL) ? nstr_GetText(nameRef) : "";
+    header.nameSize = (nameRef != NULL) ? nstr_GetLength(nameRef) : 0;
+
+    off_t headerPosition = GetSnapshotPosition(writerPtr);
+
+    AppendSnapshot(writerPtr, &header, sizeof(header));
+    AppendSnapshot(writerPtr, namePtr, header.nameSize + 1);
+
+    switch (header.type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+            break;
+
+        case LE_CFG_TYPE_STEM:
+            if (nodeRef->snapshotPtr != NULL)
+            {
+                // The children were never loaded, so they can't have changed.  Copy their records
+                // straight over from the old snapshot.
+                header.dataSize = nodeRef->childrenSize;
+                AppendSnapshot(writerPtr,
+                               nodeRef->snapshotPtr->basePtr + nodeRef->childrenOffset,
+                               nodeRef->childrenSize);
+            }
+            else
+            {
+                off_t dataPosition = GetSnapshotPosition(writerPtr);
+                tdb_NodeRef_t childRef = tdb_GetFirstActiveChildNode(nodeRef);
+
+                // Once a write has failed there's no point in going through the rest of the tree.
+                while (   (childRef != NULL)
+                       && (writerPtr->result == LE_OK))
+                {
+                    WriteSnapshotRecord(writerPtr, childRef);
+                    childRef = tdb_GetNextActiveSiblingNode(childRef);
+                }
+
+                header.dataSize = GetSnapshotPosition(writerPtr) - dataPosition;
+            }
+            break;
+
+        default:
+            header.dataSize = nstr_GetLength(nodeRef->info.valueRef) + 1;
+            AppendSnapshot(writerPtr, nstr_GetText(nodeRef->info.valueRef), header.dataSize);
+            break;
+    }
+
+    PatchSnapshot(writerPtr, headerPosition, &header, sizeof(header));
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Get the snapshot writer ready to write a new file.
+ *
+ *  @return The writer.
+ */
+// -------------------------------------------------------------------------------------------------
+static SnapshotWriter_t* StartSnapshotWriter
+(
+    int descriptor  ///< [IN] The file to write to, or -1 to only fill the writer's buffer.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    Writer.descriptor = descriptor;
+    Writer.result = LE_OK;
+    Writer.flushedSize = 0;
+    Writer.bufferedSize = 0;
+
+    return &Writer;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a whole tree to a snapshot file.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t WriteSnapshot
+(
+    tdb_NodeRef_t rootNodeRef,  ///< [IN] The root node of the tree to write.
+    int descriptor,             ///< [IN] The file to write to.
+    off_t* sizePtr              ///< [OUT] Size of the file written.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    SnapshotWriter_t* writerPtr = StartSnapshotWriter(descriptor);
+
+    SnapshotHeader_t header;
+    memset(&header, 0, sizeof(header));
+
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+
+    AppendSnapshot(writerPtr, &header, sizeof(header));
+    WriteSnapshotRecord(writerPtr, rootNodeRef);
+
+    header.rootSize = GetSnapshotPosition(writerPtr) - sizeof(header);
+
+    PatchSnapshot(writerPtr, 0, &header, sizeof(header));
+    FlushSnapshot(writerPtr);
+
+    *sizePtr = writerPtr->flushedSize;
+
+    return writerPtr->result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Compute the checksum of a journal entry's changes.  (This is the 32-bit FNV-1a hash, the same as
+ *  is used for node names, see nstr_GetHash().)
+ *
+ *  @return The checksum.
+ */
+// -------------------------------------------------------------------------------------------------
+static uint32_t JournalChecksum
+(
+    const uint8_t* dataPtr,  ///< [IN] The entry's changes.
+    size_t dataSize          ///< [IN] Size of the changes, in bytes.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < dataSize; i++)
+    {
+        hash ^= dataPtr[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Start building a journal entry in the snapshot writer's buffer.  The entry's header is filled
+ *  out by FinishJournalEntry(), once all of the changes have been added.
+ *
+ *  @return The writer the entry is being built in.
+ */
+// -------------------------------------------------------------------------------------------------
+static SnapshotWriter_t* StartJournalEntry
+(
+    void
+)
+// -------------------------------------------------------------------------------------------------
+{
+    SnapshotWriter_t* writerPtr = StartSnapshotWriter(-1);
+    JournalEntryHeader_t header;
+
+    memset(&header, 0, sizeof(header));
+    AppendSnapshot(writerPtr, &header, sizeof(header));
+
+    return writerPtr;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Add the names of a node, and of its parents, to a journal entry's path.
+ */
+// -------------------------------------------------------------------------------------------------
+static void AppendJournalPath
+(
+    SnapshotWriter_t* writerPtr,  ///< [IN] The journal entry being built.
+    tdb_NodeRef_t nodeRef         ///< [IN] The node whose path is needed.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // The root node doesn't have a name.
+    if (nodeRef->parentRef == NULL)
+    {
+        return;
+    }
+
+    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
+
+    AppendJournalPath(writerPtr, nodeRef->parentRef);
+
+    LE_ASSERT(tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName)) == LE_OK);
+    AppendSnapshot(writerPtr, nodeName, strlen(nodeName) + 1);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Add a change to the journal entry being built.  For a JOURNAL_REPLACE change, the node's new
+ *  record has to be added once the node has been merged.
+ */
+// -------------------------------------------------------------------------------------------------
+static void AddJournalChange
+(
+    SnapshotWriter_t* writerPtr,  ///< [IN] The journal entry being built.
+    tdb_NodeRef_t nodeRef,        ///< [IN] The shadow node that was changed.
+    uint8_t type                  ///< [IN] JOURNAL_DELETE or JOURNAL_REPLACE.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    JournalChange_t change;
+    memset(&change, 0, sizeof(change));
+
+    change.type = type;
+
+    off_t changePosition = GetSnapshotPosition(writerPtr);
+
+    AppendSnapshot(writerPtr, &change, sizeof(change));
+    AppendJournalPath(writerPtr, nodeRef);
+
+    change.pathSize = GetSnapshotPosition(writerPtr) - changePosition - sizeof(change);
+
+    PatchSnapshot(writerPtr, changePosition, &change, sizeof(change));
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Fill out the header of the journal entry that has been built in the snapshot writer's buffer.
+ *
+ *  @return The size of the whole entry, or 0 if the entry doesn't have any changes.
+ */
+// -------------------------------------------------------------------------------------------------
+static size_t FinishJournalEntry
+(
+    SnapshotWriter_t* writerPtr  ///< [IN] The journal entry being built.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // The writer never flushes when building an entry, so the whole entry is in the buffer.
+    JournalEntryHeader_t header;
+
+    header.size = writerPtr->bufferedSize - sizeof(header);
+
+    if (header.size == 0)
+    {
+        return 0;
+    }
+
+    header.checksum = JournalChecksum(writerPtr->buffer + sizeof(header), header.size);
+    PatchSnapshot(writerPtr, 0, &header, sizeof(header));
+
+    return writerPtr->bufferedSize;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Recursive function to merge a collection of shadow nodes with the original tree.
+ *
+ *  @return True if the given node or any if it's children have been modified.  False if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool InternalMergeTree
+(
+    const char* treeNamePtr,    ///< [IN] The name of the tree we're merging.
+    le_pathIter_Ref_t pathRef,  ///< [IN] Path to the parent of hte current node.
+    tdb_NodeRef_t nodeRef,      ///< [IN] Node and any children to merge.
+    bool forceFire,             ///< [IN] Should update handlers be fired for this node and all it's
+                                ///<      children, regardless of wether or not this node has been
+                                ///<      directly modified?
+    SnapshotWriter_t* journalPtr  ///< [IN] Journal entry to record the changes in, or NULL if
+                                  ///<      they're already covered by the entry for a parent.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    bool isModified = IsModified(nodeRef);
+    bool renamed = WasRenamed(nodeRef);
+    bool isJournaled = (journalPtr != NULL) && (isModified == true);
+
+    // If nothing ever looked at the children of an unmodified shadow stem, then none of them can
+    // have changed.
+    bool childrenUntouched =    (isModified == false)
+                             && (le_dls_IsEmpty(&nodeRef->info.children) == true);
+
+    // If this node was renamed, then all children also need to be triggered as well.
+    forceFire = renamed || forceFire;
+
+    // If this node has been renamed, marked as deleted or set empty, then all of the children need
+    // notifications fired on the original nodes.
+    if (   (renamed == true)
+        || (IsDeleted(nodeRef) == true)
+        || (OriginalToBeCleared(nodeRef) == true))
+    {
+        le_pathIter_Ref_t originalPathRef = CreateBasePath(treeNamePtr);
+
+        if (nodeRef->shadowRef != NULL)
+        {
+            GeneratePath(originalPathRef, nodeRef->shadowRef->parentRef);
+            FireAllChildren(originalPathRef, nodeRef->shadowRef);
+        }
+
+        le_pathIter_Delete(originalPathRef);
+    }
+    else if (   (isModified == true)
+             && (nodeRef->type == LE_CFG_TYPE_STEM))
+    {
+        le_pathIter_Ref_t originalPathRef = CreateBasePath(treeNamePtr);
+
+        GeneratePath(originalPathRef, nodeRef->shadowRef);
+        FireLostChildren(originalPathRef, nodeRef);
+
+        le_pathIter_Delete(originalPathRef);
+    }
+
+    AppendNodeName(pathRef, nodeRef);
+
+    // Journal the change before the merge, while the node's path can still be found.  A node
+    // that's journaled is written out whole, so none of its children need to be.  Renames aren't
+    // journaled, as the node couldn't be found by its new name when the journal is replayed.
+    // Instead, a new snapshot of the whole tree is written.
+    if (isJournaled)
+    {
+        if (renamed)
+        {
+            journalPtr->result = LE_NOT_POSSIBLE;
+        }
+        else
+        {
+            AddJournalChange(journalPtr,
+                             nodeRef,
+                             IsDeleted(nodeRef) ? JOURNAL_DELETE : JOURNAL_REPLACE);
+        }
+    }
+
+    // IF this node is modified, mearge it.  If this node is a stem, then merge it's children.  Keep
+    // track of whether any of those children have been modified as well.
+    if (isModified)
+    {
+        MergeNode(nodeRef);
+    }
+
+    // A replaced node's new record is journaled once its children have been merged as well.
+    tdb_NodeRef_t journalRecordRef = NULL;
+
+    if (   (isJournaled == true)
+        && (journalPtr->result == LE_OK)
+        && (IsDeleted(nodeRef) == false))
+    {
+        journalRecordRef = nodeRef->shadowRef;
+    }
+
+    // Skip the children if none of them can have changed, rather than shadowing them, (and loading
+    // the originals from the snapshot,) just to find that out.
+    if (   (nodeRef->type == LE_CFG_TYPE_STEM)
+        && (IsDeleted(nodeRef) == false)
+        && (   (childrenUntouched == false)
+            || (forceFire == true)))
+    {
+        nodeRef = tdb_GetFirstChildNode(nodeRef);
+
+        while (nodeRef != NULL)
+        {
+            tdb_NodeRef_t nextNodeRef = tdb_GetNextSiblingNode(nodeRef);
+
+            isModified = InternalMergeTree(treeNamePtr,
+                                           pathRef,
+                                           nodeRef,
+                                           forceFire,
+                                           isJournaled ? NULL : journalPtr) || isModified;
+            nodeRef = nextNodeRef;
+        }
+    }
+
+    if (journalRecordRef != NULL)
+    {
+        WriteSnapshotRecord(journalPtr, journalRecordRef);
+    }
+
+    // If this node, or any of it's children have been modified.  Try to fire any callbacks that may
+    // be registered.
+    if (isModified || forceFire)
+    {
+        TriggerCallbacks(pathRef);
+    }
+
+    // Now remove this node from the tracking path and let our caller know if any modifications have
+    // happened at this level or lower.
+    if (le_pathIter_GoToEnd(pathRef) == LE_OK)
+    {
+        le_pathIter_Truncate(pathRef);
+    }
+
+    return isModified;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Create a new tree object and set it to default values.
+ *
+ *  @return A ref to the newly created tree object.
+ */
+// -------------------------------------------------------------------------------------------------
+tdb_TreeRef_t NewTree
+(
+    const char* treeNameRef,   ///< [IN] The name of the new tree.
+    tdb_NodeRef_t rootNodeRef  ///< [IN] The root node of this new tree.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_TreeRef_t treeRef = le_mem_ForceAlloc(TreePoolRef);
+
+    LE_ASSERT(le_utf8_Copy(treeRef->name, treeNameRef, MAX_TREE_NAME_BYTES, NULL) == LE_OK);
+
+    treeRef->isDeletePending = false;
+    treeRef->originalTreeRef = NULL;
+    treeRef->revisionId = 0;
+    treeRef->snapshotSize = 0;
+    treeRef->journalSize = 0;
+    treeRef->rootNodeRef = (rootNodeRef != NULL) ? rootNodeRef : NewNode();
+    treeRef->activeReadCount = 0;
+    treeRef->currentReadCount = 0;
+    treeRef->versionList = LE_DLS_LIST_INIT;
+    treeRef->activeWriteIterRef = NULL;
+    treeRef->requestList = LE_SLS_LIST_INIT;
+
+    return treeRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Destructor called when a tree object is to be freed from memory.
+ */
+// -------------------------------------------------------------------------------------------------
+static void TreeDestructor
+(
+    void* objectPtr  ///< The memory object to destruct.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_TreeRef_t treeRef = (tdb_TreeRef_t)objectPtr;
+
+    // Kill the root node.
+    le_mem_Release(treeRef->rootNodeRef);
+    treeRef->rootNodeRef = NULL;
+
+    // Sanity check, is the tree actually ready to clean up?
+    LE_ASSERT(treeRef->activeReadCount == 0);
+    LE_ASSERT(le_dls_IsEmpty(&treeRef->versionList));
+    LE_ASSERT(treeRef->activeWriteIterRef == NULL);
+    LE_ASSERT(le_sls_IsEmpty(&treeRef->requestList) == true);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Create a path to a tree file with the given revision id.
+ *
+ *  @return A stringBuffer backed string containing the full path to the tree file.
+ */
+// -------------------------------------------------------------------------------------------------
+static void GetTreePath
+(
+    const char* treeNameRef,  ///< [IN] The name of the tree we're generating a name for.
+    int revisionId,           ///< [IN] Generate a name based on the tree revision.
+    char* pathBuffer,         ///< [IN] Buffer to hold the new path.
+    size_t pathSize           ///< [IN] Size of the path buffer.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // paper    --> rock       1 -> 2
+    // rock     --> scissors   2 -> 3
+    // scissors --> paper      3 -> 1
+
+    static const char* revNames[] = { "paper", "rock", "scissors" };
+    int printSize;
+
+    LE_ASSERT((revisionId >= 1) && (revisionId <= 3));
+
+    printSize = snprintf(pathBuffer,
+                         pathSize,
+                         "%s/%s.%s",
+                         CFG_TREE_PATH,
+                         treeNameRef,
+                         revNames[revisionId - 1]);
+
+    if (printSize >= pathSize)
+    {
+       LE_ERROR("Unable to store config tree path in buffer");
+       pathBuffer[0] = '\0';
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Create the path to a tree's journal file.
+ */
+// -------------------------------------------------------------------------------------------------
+static void GetJournalPath
+(
+    const char* treeNameRef,  ///< [IN] The name of the tree we're generating a name for.
+    char* pathBuffer,         ///< [IN] Buffer to hold the new path.
+    size_t pathSize           ///< [IN] Size of the path buffer.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    int printSize = snprintf(pathBuffer, pathSize, "%s/%s.journal", CFG_TREE_PATH, treeNameRef);
+
+    if (printSize >= pathSize)
+    {
+       LE_ERROR("Unable to store config tree journal path in buffer");
+       pathBuffer[0] = '\0';
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check to see if a configTree file at the given revision already exists in the filesystem.
+ *
+ *  @return True if the named file exists, false otherwise.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool TreeFileExists
+(
+    const char* treeNameRef,  ///< [IN] Name of the tree to check.
+    int revisionId            ///< [IN] The revision of the tree to check against.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char fullPath[LE_CFG_STR_LEN_BYTES] = "";
+    GetTreePath(treeNameRef, revisionId, fullPath, sizeof(fullPath));
+
+    // Make sure this part was successful.
+    if (fullPath[0] == '\0')
+    {
+        return false;
+    }
+
+    // Now call into the Linux and ask the file system if the file exists.
+    bool result = false;
+
+    if (access(fullPath, R_OK) != -1)
+    {
+        result = true;
+    }
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Call this function to delete a tree file from the filesystem.
+ */
+// -------------------------------------------------------------------------------------------------
+static void DeleteTreeFile
+(
+    const char* filePathPtr  ///< Path to the tree file in question.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
+
+    if (unlink(filePathPtr) != 0)
+    {
+        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check the filesystem and get the "valid" version of the file.  That is, if there are two files
+ *  for a given tree, we use the older one.  The idea being, if there are two versions of the same
+ *  file in the filesystem then it's highly likely there was a system failure during a streaming
+ *  operation.  So we abandon the newer file and go with the older more reliable file.
+ */
+// -------------------------------------------------------------------------------------------------
+static void UpdateRevision
+(
+    tdb_TreeRef_t treeRef  ///< [IN] Update the revision for this tree object.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    int newRevision = 0;
+
+    if (TreeFileExists(treeRef->name, 1))
+    {
+        if (TreeFileExists(treeRef->name, 3))
+        {
+            newRevision = 3;
+        }
+        else
+        {
+            newRevision = 1;
+        }
+    }
+    else if (TreeFileExists(treeRef->name, 3))
+    {
+        if (TreeFileExists(treeRef->name, 2))
+        {
+            newRevision = 2;
+        }
+        else
+        {
+            newRevision = 3;
+        }
+    }
+    else if (TreeFileExists(treeRef->name, 2))
+    {
+        newRevision = 2;
+    }
+
+    treeRef->revisionId = newRevision;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Peek into the input stream one character ahead.
+ */
+// -------------------------------------------------------------------------------------------------
+static signed char PeekChar
+(
+    FILE* filePtr  ///< [IN] The file stream to peek into.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char next = fgetc(filePtr);
+    ungetc(next, filePtr);
+
+    return next;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Skip any whitespace encountered in the input stream.  Stop skipping once we hit a valid token.
+ *
+ *  @return LE_OK if the whitespace is skiped and there is still more file to read.
+ *          LE_OUT_OF_RANGE if the end of the file is hit.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t SkipWhiteSpace
+(
+    FILE* filePtr  ///< [IN] The file stream to seek through.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    bool done = false;
+    bool isEof = false;
+
+    while (done == false)
+    {
+        switch (PeekChar(filePtr))
+        {
+            case '\n':
+            case '\r':
+            case '\t':
+            case ' ':
+                // Eat the character.
+                fgetc(filePtr);
+                break;
+
+            case EOF:
+                done = true;
+                isEof = true;
+                break;
+
+            default:
+                done = true;
+                break;
+        }
+    }
+
+    return isEof == true ? LE_OUT_OF_RANGE : LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a boolean literal from the input file.
+ *
+ *  @return LE_OK if the literal could be read.
+ *          LE_FORMAT_ERROR if the literal could not be read.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool ReadBoolToken
+(
+    FILE* filePtr,     ///< [IN]  The file we're reading from.
+    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    signed char next = fgetc(filePtr);
+
+    if (   (next == 't')
+        || (next == 'f'))
+    {
+        stringPtr[0] = next;
+        stringPtr[1] = 0;
+
+        return LE_OK;
+    }
+
+    return LE_FORMAT_ERROR;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a textual literal from the input file, the read is terminated successfuly if the terminal
+ *  character is found.
+ *
+ *  @return LE_OK if the string is read from the file.
+ *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadTextLiteral
+(
+    FILE* filePtr,        ///< [IN]  The file we're reading from.
+    char* stringPtr,      ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize,    ///< [IN]  How big is the supplied string buffer?
+    signed char terminal  ///< [IN]  The terminal character we're searching for.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    signed char next;
+    size_t count = 0;
+
+    char* oldPtr = stringPtr;
+
+    while ((next = fgetc(filePtr)) != terminal)
+    {
+        if (next == EOF)
+        {
+            LE_ERROR("Missing end specifier, ']' in int value.");
+            return LE_FORMAT_ERROR;
+        }
+
+        if (next == '\\')
+        {
+            next = fgetc(filePtr);
+
+            if (next == EOF)
+            {
+                LE_ERROR("Unexpected EOF after finding \\ character.");
+                return LE_FORMAT_ERROR;
+            }
+        }
+
+        *stringPtr = next;
+
+        ++stringPtr;
+        ++count;
+
+        if (count >= (stringSize - 1))
+        {
+            *stringPtr = 0;
+
+            LE_ERROR("String literal, '%s', too large.  (%zd/%zd)",
+                     oldPtr,
+                     strlen(oldPtr),
+                     stringSize);
+
+            return LE_FORMAT_ERROR;
+        }
+    }
+
+    *stringPtr = 0;
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read an integer token string from the file.
+ *
+ *  @return LE_OK if the string is read from the file.
+ *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadIntToken
+(
+    FILE* filePtr,     ///< [IN]  The file we're reading from.
+    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, ']');
+
+    // TODO: Validate the int string.
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a floating point token string from the file.
+ *
+ *  @return LE_OK if the string is read from the file.
+ *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadFloatToken
+(
+    FILE* filePtr,     ///< [IN]  The file we're reading from.
+    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, ')');
+
+    // TODO: Validate the float string.
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a string from the config tree file.
+ *
+ *  @return LE_OK if the string is read from the file.
+ *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadStringToken
+(
+    FILE* filePtr,     ///< [IN]  The file we're reading from.
+    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, '"');
+
+    // TODO: Validate the literal string.
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a token from the input stream.
+ *
+ *  @return LE_OK if a token could be read.  LE_OUT_OF_RANGE if the end of the stream is reached
+ *          before a token could be finished.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadToken
+(
+    FILE* filePtr,         ///< [IN]  The file we're reading from.
+    char* stringPtr,       ///< [OUT] String buffer to hold the token we've read.
+    size_t stringSize,     ///< [IN]  How big is the supplied string buffer?
+    TokenType_t* typePtr   ///< [OUT] The type of token read from the file.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    *stringPtr = 0;
+
+    if (SkipWhiteSpace(filePtr) != LE_OK)
+    {
+        return LE_OUT_OF_RANGE;
+    }
+
+    signed char next;
+
+    while ((next = fgetc(filePtr)) != EOF)
+    {
+        switch (next)
+        {
+            case '~':
+                *typePtr = TT_EMPTY_VALUE;
+                return LE_OK;
+
+            case '!':
+                *typePtr = TT_BOOL_VALUE;
+                return ReadBoolToken(filePtr, stringPtr, stringSize);
+
+            case '[':
+                *typePtr = TT_INT_VALUE;
+                return ReadIntToken(filePtr, stringPtr, stringSize);
+
+            case '(':
+                *typePtr = TT_FLOAT_VALUE;
+                return ReadFloatToken(filePtr, stringPtr, stringSize);
+
+            case '\"':
+                *typePtr = TT_STRING_VALUE;
+                return ReadStringToken(filePtr, stringPtr, stringSize);
+
+            case '{':
+                *typePtr = TT_OPEN_GROUP;
+                return LE_OK;
+
+            case '}':
+                *typePtr = TT_CLOSE_GROUP;
+                return LE_OK;
+
+            default:
+                LE_ERROR("Unexpected character in input stream.");
+                return LE_FORMAT_ERROR;
+        }
+    }
+
+    return LE_OUT_OF_RANGE;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write data to the output stream.  This function will record any faults to the system log.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t WriteFile
+(
+    FILE* filePtr,        ///< [IN] The file being written to.
+    const void* dataPtr,  ///< [IN] The data being written to the file.
+    size_t dataSize       ///< [IN] The amount of data being written.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    ssize_t written = fwrite(dataPtr, 1, dataSize, filePtr);
+
+    if (ferror(filePtr) != 0)
+    {
+        LE_EMERG("Failed to write to config tree file.");
+        return LE_IO_ERROR;
+    }
+
+    if (written < dataSize)
+    {
+        LE_EMERG("Data truncated while writing to configuration file.");
+        return LE_IO_ERROR;
+    }
+
+    return LE_OK;
+}
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a string token to the output stream.  This function will write the string and escape all
+ *  control characters as it does so.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t WriteStringValue
+(
+    FILE* filePtr,         ///< [IN] The file to write to.
+    char startChar,        ///< [IN] The delimiter to use.
+    char endChar,          ///< [IN] The closing delimiter to use.
+    const char* stringPtr  ///< [IN] The actual string to write.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_result_t result = LE_OK;
+
+    result = WriteFile(filePtr, &startChar, 1);
+
+    while (   (*stringPtr != 0)
+           && (result == LE_OK))
+    {
+        if (   (*stringPtr == '\"')
+            || (*stringPtr == '\\'))
+        {
+            result = WriteFile(filePtr, "\\", 1);
+        }
+
+        if (result == LE_OK)
+        {
+            result = WriteFile(filePtr, stringPtr, 1);
+        }
+
+        stringPtr++;
+    }
+
+    if (result == LE_OK)
+    {
+        char strBuffer[2] = { endChar, ' ' };
+        result = WriteFile(filePtr, strBuffer, sizeof(strBuffer));
+    }
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a node value from the given file.  If the value is a collection, then read in those nodes
+ *  too.
+ *
+ *  @return LE_OK if the read is successful.
+ *          LE_FORMAT_ERROR if parse errors are encountered.
+ *          LE_NOT_FOUND if the end of file is reached.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t InternalReadNode
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node we're reading a value for.
+    FILE* filePtr,          ///< [IN] The file we're reading the value from.
+    size_t pathLen          ///< [IN] The length of the path including nodeRef.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    static char stringBuffer[LE_CFG_STR_LEN_BYTES] = "";
+
+    TokenType_t tokenType;
+
+    // Try to read this node's value.
+    if (ReadToken(filePtr, stringBuffer, sizeof(stringBuffer), &tokenType) != LE_OK)
+    {
+        LE_ERROR("Unexpected EOF or bad token in file.");
+        return LE_FORMAT_ERROR;
+    }
+
+    tdb_SetEmpty(nodeRef);
+
+    switch (tokenType)
+    {
+        case TT_BOOL_VALUE:
+            tdb_SetValueAsString(nodeRef, stringBuffer);
+            nodeRef->type = LE_CFG_TYPE_BOOL;
+            break;
+
+        case TT_INT_VALUE:
+            tdb_SetValueAsString(nodeRef, stringBuffer);
+            nodeRef->type = LE_CFG_TYPE_INT;
+            break;
+
+        case TT_FLOAT_VALUE:
+            tdb_SetValueAsString(nodeRef, stringBuffer);
+            nodeRef->type = LE_CFG_TYPE_FLOAT;
+            break;
+
+        case TT_STRING_VALUE:
+            tdb_SetValueAsString(nodeRef, stringBuffer);
+            break;
+
+        case TT_EMPTY_VALUE:
+            // The node has already been cleared, so there's nothing left to do but make sure that
+            // the node exists.
+            ClearDeletedFlag(nodeRef);
+            break;
+
+        case TT_OPEN_GROUP:
+            while (tokenType != TT_CLOSE_GROUP)
+            {
+                if (ReadToken(filePtr, stringBuffer, sizeof(stringBuffer), &tokenType) != LE_OK)
+                {
+                    LE_ERROR("Unexpected EOF or bad token in file while looking for '}'.");
+                    return LE_FORMAT_ERROR;
+                }
+
+                if (tokenType == TT_STRING_VALUE)
+                {
+                    size_t strLen = le_utf8_NumBytes(stringBuffer);
+                    size_t newPathLen = pathLen + 1 + strLen;
+
+                    if (newPathLen > LE_CFG_STR_LEN)
+                    {
+                        LE_ERROR("New path length for node '%s' is too long.  %zu of %zu bytes.",
+                                 stringBuffer,
+                                 strLen,
+                                 (size_t)LE_CFG_STR_LEN);
+
+                        return LE_FORMAT_ERROR;
+                    }
+
+                    tdb_NodeRef_t childRef = GetNamedChild(nodeRef, stringBuffer);
+
+                    if (childRef == NULL)
+                    {
+                        childRef = NewChildNode(nodeRef);
+                        if (tdb_SetNodeName(childRef, stringBuffer) != LE_OK)
+                        {
+                            LE_ERROR("Bad node name, '%s'.", stringBuffer);
+                            return LE_FORMAT_ERROR;
+                        }
+
+                        LE_DEBUG("New node, %s", stringBuffer);
+                    }
+
+                    tdb_EnsureExists(childRef);
+
+                    le_result_t result = InternalReadNode(childRef, filePtr, newPathLen);
+
+                    if (result != LE_OK)
+                    {
+                        return result;
+                    }
+                }
+                else if (tokenType == TT_CLOSE_GROUP)
+                {
+                    break;
+                }
+                else
+                {
+                    LE_ERROR("Unexpected token in found while looking for '}'.");
+                    return LE_FORMAT_ERROR;
+                }
+            }
+            break;
+
+        case TT_CLOSE_GROUP:
+        default:
+            LE_ERROR("Unexpected token found.");
+            return LE_FORMAT_ERROR;
+    }
+
+    if (IsShadow(nodeRef) == false)
+    {
+        ClearModifiedFlag(nodeRef);
+    }
+    else
+    {
+        SetModifiedFlag(nodeRef);
+    }
+
+    tdb_EnsureExists(nodeRef);
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Serialize a tree node and it's children to a file in the filesystem.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t InternalWriteNode
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] The node being written.
+    FILE* filePtr           ///< [IN] The file being written to.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // If there is no node to write, or if the node is marked as having been deleted...  Then write
+    // a blank node.
+    if (   (nodeRef == NULL)
+        || (IsDeleted(nodeRef) == true))
+    {
+        return WriteFile(filePtr, "~ ", 2);
+    }
+
+    // Get the node's value as a string.
+    static char stringBuffer[LE_CFG_STR_LEN_BYTES] = "";
+    le_result_t result = LE_OK;
+
+    tdb_GetValueAsString(nodeRef, stringBuffer, sizeof(stringBuffer), "");
+
+    // Now, depending on the type of node, write out any required format information.
+    switch (nodeRef->type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+        case LE_CFG_TYPE_DOESNT_EXIST:
+            result = WriteFile(filePtr, "~ ", 2);
+            break;
+
+        case LE_CFG_TYPE_BOOL:
+            {
+                const char boolBuffer[3] = { '!', stringBuffer[0], ' ' };
+                result = WriteFile(filePtr, boolBuffer, sizeof(boolBuffer));
+            }
+            break;
+
+        case LE_CFG_TYPE_STRING:
+            result = WriteStringValue(filePtr, '\"', '\"', stringBuffer);
+            break;
+
+        case LE_CFG_TYPE_INT:
+            result = WriteStringValue(filePtr, '[', ']', stringBuffer);
+            break;
+
+        case LE_CFG_TYPE_FLOAT:
+            result = WriteStringValue(filePtr, '(', ')', stringBuffer);
+            break;
+
+        // Looks like this node is a collection, so write out it's child nodes now.
+        case LE_CFG_TYPE_STEM:
+            if ((result = WriteFile(filePtr, "{ ", 2)) == LE_OK)
+            {
+                tdb_NodeRef_t childRef = tdb_GetFirstActiveChildNode(nodeRef);
+
+                while (   (childRef != NULL)
+                       && (result == LE_OK))
+                {
+                    tdb_GetNodeName(childRef, stringBuffer, sizeof(stringBuffer));
+                    result = WriteStringValue(filePtr, '\"', '\"', stringBuffer);
+
+                    if (result == LE_OK)
+                    {
+                        result = InternalWriteNode(childRef, filePtr);
+                    }
+
+                    childRef = tdb_GetNextActiveSiblingNode(childRef);
+                }
+
+                if (result == LE_OK)
+                {
+                    result = WriteFile(filePtr, "} ", 2);
+                }
+            }
+            break;
+    }
+
+    return result;
 }
 
 
@@ -1815,100 +3661,105 @@ static le_result_t SkipWhiteSpace
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a boolean literal from the input file.
+ *  Check that a range of node records in a snapshot is well formed, so that it can be trusted when
+ *  the nodes are loaded later.  Stem nodes' children are checked too.
  *
- *  @return LE_OK if the literal could be read.
- *          LE_FORMAT_ERROR if the literal could not be read.
+ *  @return True if the records are good, false if not.
  */
 // -------------------------------------------------------------------------------------------------
-static bool ReadBoolToken
+static bool ValidateRecords
 (
-    FILE* filePtr,     ///< [IN]  The file we're reading from.
-    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+    const uint8_t* basePtr,  ///< [IN] Start of the snapshot.
+    uint64_t offset,         ///< [IN] Offset of the first record.
+    uint64_t endOffset,      ///< [IN] Offset of the end of the last record.
+    size_t pathLen,          ///< [IN] Length of the path to the records' parent node.
+    bool isRoot              ///< [IN] Is this the root node's record?
 )
 // -------------------------------------------------------------------------------------------------
 {
-    signed char next = fgetc(filePtr);
-
-    if (   (next == 't')
-        || (next == 'f'))
+    while (offset < endOffset)
     {
-        stringPtr[0] = next;
-        stringPtr[1] = 0;
-
-        return LE_OK;
-    }
+        RecordHeader_t header;
 
-    return LE_FORMAT_ERROR;
-}
+        if ((endOffset - offset) < sizeof(header))
+        {
+            return false;
+        }
 
+        memcpy(&header, basePtr + offset, sizeof(header));
+        offset += sizeof(header);
 
+        // Only the root node can have an empty name, and the name must be properly terminated.
+        const char* namePtr = (const char*)basePtr + offset;
 
+        if (   (isRoot != (header.nameSize == 0))
+            || (header.nameSize > LE_CFG_NAME_LEN)
+            || ((endOffset - offset) <= header.nameSize)
+            || (strnlen(namePtr, header.nameSize + 1) != header.nameSize))
+        {
+            return false;
+        }
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Read a textual literal from the input file, the read is terminated successfuly if the terminal
- *  character is found.
- *
- *  @return LE_OK if the string is read from the file.
- *          LE_FORMAT_ERROR if the text fails to be read from the file.
- */
-// -------------------------------------------------------------------------------------------------
-static le_result_t ReadTextLiteral
-(
-    FILE* filePtr,        ///< [IN]  The file we're reading from.
-    char* stringPtr,      ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize,    ///< [IN]  How big is the supplied string buffer?
-    signed char terminal  ///< [IN]  The terminal character we're searching for.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    signed char next;
-    size_t count = 0;
+        offset += header.nameSize + 1;
 
-    char* oldPtr = stringPtr;
+        size_t newPathLen = pathLen + 1 + header.nameSize;
 
-    while ((next = fgetc(filePtr)) != terminal)
-    {
-        if (next == EOF)
+        if (   (newPathLen > LE_CFG_STR_LEN)
+            || ((endOffset - offset) < header.dataSize))
         {
-            LE_ERROR("Missing end specifier, ']' in int value.");
-            return LE_FORMAT_ERROR;
+            return false;
         }
 
-        if (next == '\\')
-        {
-            next = fgetc(filePtr);
+        const char* dataPtr = (const char*)basePtr + offset;
 
-            if (next == EOF)
-            {
-                LE_ERROR("Unexpected EOF after finding \\ character.");
-                return LE_FORMAT_ERROR;
-            }
-        }
+        switch ((le_cfg_nodeType_t)header.type)
+        {
+            case LE_CFG_TYPE_EMPTY:
+                if (header.dataSize != 0)
+                {
+                    return false;
+                }
+                break;
 
-        *stringPtr = next;
+            case LE_CFG_TYPE_STEM:
+                // Stems without any children are stored as empty nodes.
+                if (   (header.dataSize == 0)
+                    || (ValidateRecords(basePtr,
+                                        offset,
+                                        offset + header.dataSize,
+                                        newPathLen,
+                                        false) == false))
+                {
+                    return false;
+                }
+                break;
 
-        ++stringPtr;
-        ++count;
+            case LE_CFG_TYPE_STRING:
+            case LE_CFG_TYPE_BOOL:
+            case LE_CFG_TYPE_INT:
+            case LE_CFG_TYPE_FLOAT:
+                if (   (header.dataSize == 0)
+                    || (header.dataSize > LE_CFG_STR_LEN_BYTES)
+                    || (strnlen(dataPtr, header.dataSize) != (header.dataSize - 1)))
+                {
+                    return false;
+                }
+                break;
 
-        if (count >= (stringSize - 1))
-        {
-            *stringPtr = 0;
+            default:
+                return false;
+        }
 
-            LE_ERROR("String literal, '%s', too large.  (%zd/%zd)",
-                     oldPtr,
-                     strlen(oldPtr),
-                     stringSize);
+        offset += header.dataSize;
 
-            return LE_FORMAT_ERROR;
+        // The root node's record must be the only thing in the file.
+        if (isRoot)
+        {
+            return offset == endOffset;
         }
     }
 
-    *stringPtr = 0;
-
-    return LE_OK;
+    return true;
 }
 
 
@@ -1916,23 +3767,92 @@ static le_result_t ReadTextLiteral
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read an integer token string from the file.
+ *  Load a tree from a snapshot file.  The file is mapped into memory, and only the tree's root node
+ *  is created for now.
  *
- *  @return LE_OK if the string is read from the file.
- *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ *  @return LE_OK if the tree was loaded.
+ *          LE_FORMAT_ERROR if the file isn't a snapshot.  (The file position is left unchanged.)
+ *          LE_FAULT if the file is a snapshot, but it's damaged or can't be used.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t ReadIntToken
+static le_result_t LoadSnapshot
 (
-    FILE* filePtr,     ///< [IN]  The file we're reading from.
-    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+    tdb_TreeRef_t treeRef,  ///< [IN] The tree to load.  Its root node must be empty.
+    int descriptor          ///< [IN] The file to load the tree from.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, ']');
+    SnapshotHeader_t header;
+    ssize_t bytesRead = -1;
 
-    // TODO: Validate the int string.
+    do
+    {
+        bytesRead = pread(descriptor, &header, sizeof(header), 0);
+    }
+    while ((bytesRead == -1) && (errno == EINTR));
+
+    if (   (bytesRead != sizeof(header))
+        || (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0))
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    if (   (header.version != SNAPSHOT_VERSION)
+        || (header.byteOrder != SNAPSHOT_BYTE_ORDER))
+    {
+        LE_ERROR("Unsupported tree snapshot, version %" PRIu32 ", byte order 0x%08" PRIx32 ".",
+                 header.version,
+                 header.byteOrder);
+        return LE_FAULT;
+    }
+
+    struct stat fileStat;
+
+    if (fstat(descriptor, &fileStat) != 0)
+    {
+        LE_ERROR("Could not get the size of the tree snapshot, reason: %m");
+        return LE_FAULT;
+    }
+
+    // Offsets within a snapshot are 32-bit.
+    if (   ((uint64_t)fileStat.st_size > UINT32_MAX)
+        || (header.rootSize != ((uint64_t)fileStat.st_size - sizeof(header))))
+    {
+        LE_ERROR("Tree snapshot has the wrong size, %lld bytes.", (long long)fileStat.st_size);
+        return LE_FAULT;
+    }
+
+    void* basePtr = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    if (basePtr == MAP_FAILED)
+    {
+        LE_ERROR("Could not map the tree snapshot, reason: %m");
+        return LE_FAULT;
+    }
+
+    Snapshot_t* snapshotPtr = le_mem_ForceAlloc(SnapshotPool);
+
+    snapshotPtr->basePtr = basePtr;
+    snapshotPtr->size = fileStat.st_size;
+
+    le_result_t result = LE_FAULT;
+
+    // The path length starts at one, to account for the trailing NULL.
+    if (ValidateRecords(snapshotPtr->basePtr, sizeof(header), snapshotPtr->size, 1, true) == false)
+    {
+        LE_ERROR("Tree snapshot is corrupt.");
+    }
+    else
+    {
+        LoadRecord(treeRef->rootNodeRef, snapshotPtr, sizeof(header));
+        treeRef->snapshotSize = fileStat.st_size;
+        result = LE_OK;
+
+        LE_DEBUG("** Mapped %zu byte snapshot of tree '%s'.", snapshotPtr->size, treeRef->name);
+    }
+
+    // If the root node is a stem, it now holds its own reference to the snapshot.
+    le_mem_Release(snapshotPtr);
 
     return result;
 }
@@ -1942,25 +3862,44 @@ static le_result_t ReadIntToken
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a floating point token string from the file.
+ *  Write data to a journal file, at the given position.
  *
- *  @return LE_OK if the string is read from the file.
- *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ *  @return True if all of the data was written, false if not.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t ReadFloatToken
+static bool WriteJournalFile
 (
-    FILE* filePtr,     ///< [IN]  The file we're reading from.
-    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+    int descriptor,       ///< [IN] The journal file.
+    const void* dataPtr,  ///< [IN] The data to write.
+    size_t dataSize,      ///< [IN] The amount of data to write.
+    off_t position        ///< [IN] Where in the file to write it.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, ')');
+    const uint8_t* bytePtr = dataPtr;
 
-    // TODO: Validate the float string.
+    while (dataSize > 0)
+    {
+        ssize_t written = pwrite(descriptor, bytePtr, dataSize, position);
 
-    return result;
+        if (written > 0)
+        {
+            bytePtr += written;
+            dataSize -= written;
+            position += written;
+        }
+        else if ((written == -1) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            LE_ERROR("Failed to write to config tree journal, reason: %m");
+            return false;
+        }
+    }
+
+    return true;
 }
 
 
@@ -1968,25 +3907,23 @@ static le_result_t ReadFloatToken
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a string from the config tree file.
- *
- *  @return LE_OK if the string is read from the file.
- *          LE_FORMAT_ERROR if the text fails to be read from the file.
+ *  Delete a tree's journal file, if it has one.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t ReadStringToken
+static void DeleteJournal
 (
-    FILE* filePtr,     ///< [IN]  The file we're reading from.
-    char* stringPtr,   ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize  ///< [IN]  How big is the supplied string buffer?
+    tdb_TreeRef_t treeRef  ///< [IN] The tree whose journal is to be deleted.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_result_t result = ReadTextLiteral(filePtr, stringPtr, stringSize, '"');
-
-    // TODO: Validate the literal string.
+    if (treeRef->journalSize != 0)
+    {
+        char filePath[LE_CFG_STR_LEN_BYTES] = "";
+        GetJournalPath(treeRef->name, filePath, sizeof(filePath));
 
-    return result;
+        DeleteTreeFile(filePath);
+        treeRef->journalSize = 0;
+    }
 }
 
 
@@ -1994,153 +3931,212 @@ static le_result_t ReadStringToken
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a token from the input stream.
+ *  Append the journal entry that was built in the snapshot writer's buffer to a tree's journal,
+ *  starting the journal if the tree doesn't have one yet.
  *
- *  @return LE_OK if a token could be read.  LE_OUT_OF_RANGE if the end of the stream is reached
- *          before a token could be finished.
+ *  @return LE_OK if the entry was appended, (or there was nothing to append.)
+ *          LE_OUT_OF_RANGE if the journal has grown big enough that it's time for a new snapshot.
+ *          Otherwise the reason the entry couldn't be built or appended.  The caller should write
+ *          a new snapshot of the whole tree instead.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t ReadToken
+static le_result_t AppendJournal
 (
-    FILE* filePtr,         ///< [IN]  The file we're reading from.
-    char* stringPtr,       ///< [OUT] String buffer to hold the token we've read.
-    size_t stringSize,     ///< [IN]  How big is the supplied string buffer?
-    TokenType_t* typePtr   ///< [OUT] The type of token read from the file.
+    tdb_TreeRef_t treeRef,        ///< [IN] The tree the changes were merged into.
+    SnapshotWriter_t* writerPtr   ///< [IN] The journal entry that was built during the merge.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    *stringPtr = 0;
+    if (writerPtr->result != LE_OK)
+    {
+        return writerPtr->result;
+    }
 
-    if (SkipWhiteSpace(filePtr) != LE_OK)
+    size_t entrySize = FinishJournalEntry(writerPtr);
+
+    if (entrySize == 0)
     {
-        return LE_OUT_OF_RANGE;
+        return LE_OK;
     }
 
-    signed char next;
+    off_t maxSize = treeRef->snapshotSize;
 
-    while ((next = fgetc(filePtr)) != EOF)
+    if (maxSize < JOURNAL_MIN_COMPACT_BYTES)
     {
-        switch (next)
-        {
-            case '~':
-                *typePtr = TT_EMPTY_VALUE;
-                return LE_OK;
+        maxSize = JOURNAL_MIN_COMPACT_BYTES;
+    }
 
-            case '!':
-                *typePtr = TT_BOOL_VALUE;
-                return ReadBoolToken(filePtr, stringPtr, stringSize);
+    if ((treeRef->journalSize + (off_t)entrySize) > maxSize)
+    {
+        return LE_OUT_OF_RANGE;
+    }
 
-            case '[':
-                *typePtr = TT_INT_VALUE;
-                return ReadIntToken(filePtr, stringPtr, stringSize);
+    char filePath[LE_CFG_STR_LEN_BYTES] = "";
+    GetJournalPath(treeRef->name, filePath, sizeof(filePath));
 
-            case '(':
-                *typePtr = TT_FLOAT_VALUE;
-                return ReadFloatToken(filePtr, stringPtr, stringSize);
+    int flags = O_WRONLY | O_CREAT;
 
-            case '\"':
-                *typePtr = TT_STRING_VALUE;
-                return ReadStringToken(filePtr, stringPtr, stringSize);
+    // Anything left over from an older journal is thrown away when a new one is started.
+    if (treeRef->journalSize == 0)
+    {
+        flags |= O_TRUNC;
+    }
 
-            case '{':
-                *typePtr = TT_OPEN_GROUP;
-                return LE_OK;
+    int fileRef = -1;
 
-            case '}':
-                *typePtr = TT_CLOSE_GROUP;
-                return LE_OK;
+    do
+    {
+        fileRef = open(filePath, flags, S_IRUSR | S_IWUSR);
+    }
+    while (   (fileRef == -1)
+           && (errno == EINTR));
 
-            default:
-                LE_ERROR("Unexpected character in input stream.");
-                return LE_FORMAT_ERROR;
-        }
+    if (fileRef == -1)
+    {
+        LE_ERROR("Failed to open config tree journal '%s' (%m).", filePath);
+        return LE_IO_ERROR;
     }
 
-    return LE_OUT_OF_RANGE;
-}
+    le_result_t result = LE_OK;
 
+    if (treeRef->journalSize == 0)
+    {
+        JournalHeader_t header;
+        memset(&header, 0, sizeof(header));
 
+        memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+        header.version = JOURNAL_VERSION;
+        header.byteOrder = SNAPSHOT_BYTE_ORDER;
+        header.revisionId = treeRef->revisionId;
+        header.baseSize = treeRef->snapshotSize;
 
+        // From here on, the journal file has to be cleaned up if the tree is written out whole.
+        treeRef->journalSize = sizeof(header);
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Write data to the output stream.  This function will record any faults to the system log.
- *
- *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
- */
-// -------------------------------------------------------------------------------------------------
-static le_result_t WriteFile
-(
-    FILE* filePtr,        ///< [IN] The file being written to.
-    const void* dataPtr,  ///< [IN] The data being written to the file.
-    size_t dataSize       ///< [IN] The amount of data being written.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    ssize_t written = fwrite(dataPtr, 1, dataSize, filePtr);
+        if (WriteJournalFile(fileRef, &header, sizeof(header), 0) == false)
+        {
+            result = LE_IO_ERROR;
+        }
+    }
 
-    if (ferror(filePtr) != 0)
+    if (   (result == LE_OK)
+        && (WriteJournalFile(fileRef, writerPtr->buffer, entrySize, treeRef->journalSize) == true))
     {
-        LE_EMERG("Failed to write to config tree file.");
-        return LE_IO_ERROR;
+        treeRef->journalSize += entrySize;
+        LE_DEBUG("** Journaled %zu bytes of changes to tree '%s'.", entrySize, treeRef->name);
+    }
+    else
+    {
+        result = LE_IO_ERROR;
     }
 
-    if (written < dataSize)
+    int retVal = -1;
+
+    do
     {
-        LE_EMERG("Data truncated while writing to configuration file.");
-        return LE_IO_ERROR;
+        retVal = close(fileRef);
     }
+    while ((retVal == -1) && (errno == EINTR));
 
-    return LE_OK;
+    return result;
 }
 
 
 
+
 // -------------------------------------------------------------------------------------------------
 /**
- *  Write a string token to the output stream.  This function will write the string and escape all
- *  control characters as it does so.
+ *  Find the node a journaled change applies to.
  *
- *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ *  @return The node, or NULL if it doesn't exist (or the path is bad.)
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t WriteStringValue
+static tdb_NodeRef_t FindJournalNode
 (
-    FILE* filePtr,         ///< [IN] The file to write to.
-    char startChar,        ///< [IN] The delimiter to use.
-    char endChar,          ///< [IN] The closing delimiter to use.
-    const char* stringPtr  ///< [IN] The actual string to write.
+    tdb_NodeRef_t rootRef,         ///< [IN]  Root node of the tree being loaded.
+    const char* pathPtr,           ///< [IN]  The change's path.  Known to be null terminated.
+    size_t pathSize,               ///< [IN]  Size of the change's path.
+    tdb_NodeRef_t* parentRefPtr,   ///< [OUT] The node's parent, or NULL if it doesn't exist.
+    const char** namePtrPtr,       ///< [OUT] The node's name, (the last name in the path.)
+    size_t* pathLenPtr             ///< [OUT] Length of the path to the node's parent, as counted
+                                   ///<       by ValidateRecords().
 )
 // -------------------------------------------------------------------------------------------------
 {
-    le_result_t result = LE_OK;
+    tdb_NodeRef_t nodeRef = rootRef;
+    size_t offset = 0;
 
-    result = WriteFile(filePtr, &startChar, 1);
+    *parentRefPtr = NULL;
+    *namePtrPtr = "";
+    *pathLenPtr = 1;
 
-    while (   (*stringPtr != 0)
-           && (result == LE_OK))
+    while (offset < pathSize)
     {
-        if (   (*stringPtr == '\"')
-            || (*stringPtr == '\\'))
+        const char* namePtr = pathPtr + offset;
+        size_t nameLen = strlen(namePtr);
+
+        if (   (nameLen == 0)
+            || (nameLen > LE_CFG_NAME_LEN))
         {
-            result = WriteFile(filePtr, "\\", 1);
+            *parentRefPtr = NULL;
+            return NULL;
         }
 
-        if (result == LE_OK)
+        *pathLenPtr += 1 + strlen(*namePtrPtr);
+        *parentRefPtr = nodeRef;
+        *namePtrPtr = namePtr;
+
+        if (   (nodeRef != NULL)
+            && (nodeRef->type == LE_CFG_TYPE_STEM))
         {
-            result = WriteFile(filePtr, stringPtr, 1);
+            nodeRef = FindChild(nodeRef, namePtr);
+        }
+        else
+        {
+            nodeRef = NULL;
         }
 
-        stringPtr++;
+        offset += nameLen + 1;
     }
 
-    if (result == LE_OK)
+    return nodeRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Clear out a node's value or children, and its name, so that it can be replaced with a record
+ *  from a journal.  The node keeps its place in its parent's list of children.
+ */
+// -------------------------------------------------------------------------------------------------
+static void ClearJournalNode
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to clear.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (nodeRef->type == LE_CFG_TYPE_STEM)
     {
-        char strBuffer[2] = { endChar, ' ' };
-        result = WriteFile(filePtr, strBuffer, sizeof(strBuffer));
+        ReleaseChildren(nodeRef);
+        nodeRef->info.children = LE_DLS_LIST_INIT;
+    }
+    else if (   (nodeRef->type != LE_CFG_TYPE_EMPTY)
+             && (nodeRef->info.valueRef != NULL))
+    {
+        nstr_Release(nodeRef->info.valueRef);
+        nodeRef->info.valueRef = NULL;
     }
 
-    return result;
+    // The name in the record is the same, so the node doesn't need to be re-indexed.
+    if (nodeRef->nameRef != NULL)
+    {
+        nstr_Release(nodeRef->nameRef);
+        nodeRef->nameRef = NULL;
+    }
+
+    nodeRef->type = LE_CFG_TYPE_EMPTY;
 }
 
 
@@ -2148,139 +4144,142 @@ static le_result_t WriteStringValue
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Read a node value from the given file.  If the value is a collection, then read in those nodes
- *  too.
+ *  Go through the changes in a journal entry and either check them, or apply them to the tree.  An
+ *  entry is always checked in full before any of it is applied, so the tree is never left with only
+ *  some of an entry's changes.
  *
- *  @return LE_OK if the read is successful.
- *          LE_FORMAT_ERROR if parse errors are encountered.
- *          LE_NOT_FOUND if the end of file is reached.
+ *  @return True if the changes are good, (or were applied,) false if not.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t InternalReadNode
+static bool ReplayJournalEntry
 (
-    tdb_NodeRef_t nodeRef,  ///< [IN] The node we're reading a value for.
-    FILE* filePtr,          ///< [IN] The file we're reading the value from.
-    size_t pathLen          ///< [IN] The length of the path including nodeRef.
+    tdb_NodeRef_t rootRef,    ///< [IN] Root node of the tree being loaded.
+    Snapshot_t* snapshotPtr,  ///< [IN] The journal.
+    uint32_t offset,          ///< [IN] Offset of the entry's first change.
+    uint32_t endOffset,       ///< [IN] Offset of the end of the entry.
+    bool apply                ///< [IN] Apply the changes, (rather than just check them)?
 )
 // -------------------------------------------------------------------------------------------------
 {
-    static char stringBuffer[LE_CFG_STR_LEN_BYTES] = "";
+    const uint8_t* basePtr = snapshotPtr->basePtr;
 
-    TokenType_t tokenType;
-
-    // Try to read this node's value.
-    if (ReadToken(filePtr, stringBuffer, sizeof(stringBuffer), &tokenType) != LE_OK)
+    while (offset < endOffset)
     {
-        LE_ERROR("Unexpected EOF or bad token in file.");
-        return LE_FORMAT_ERROR;
-    }
-
-    tdb_SetEmpty(nodeRef);
+        JournalChange_t change;
 
-    switch (tokenType)
-    {
-        case TT_BOOL_VALUE:
-            tdb_SetValueAsString(nodeRef, stringBuffer);
-            nodeRef->type = LE_CFG_TYPE_BOOL;
-            break;
+        if ((endOffset - offset) < sizeof(change))
+        {
+            return false;
+        }
 
-        case TT_INT_VALUE:
-            tdb_SetValueAsString(nodeRef, stringBuffer);
-            nodeRef->type = LE_CFG_TYPE_INT;
-            break;
+        memcpy(&change, basePtr + offset, sizeof(change));
+        offset += sizeof(change);
 
-        case TT_FLOAT_VALUE:
-            tdb_SetValueAsString(nodeRef, stringBuffer);
-            nodeRef->type = LE_CFG_TYPE_FLOAT;
-            break;
+        const char* pathPtr = (const char*)basePtr + offset;
 
-        case TT_STRING_VALUE:
-            tdb_SetValueAsString(nodeRef, stringBuffer);
-            break;
+        if (   ((endOffset - offset) < change.pathSize)
+            || (   (change.pathSize > 0)
+                && (pathPtr[change.pathSize - 1] != '\0')))
+        {
+            return false;
+        }
 
-        case TT_EMPTY_VALUE:
-            // The node has already been cleared, so there's nothing left to do but make sure that
-            // the node exists.
-            ClearDeletedFlag(nodeRef);
-            break;
+        offset += change.pathSize;
+
+        tdb_NodeRef_t parentRef = NULL;
+        const char* namePtr = NULL;
+        size_t pathLen = 0;
+        tdb_NodeRef_t nodeRef = FindJournalNode(rootRef,
+                                                pathPtr,
+                                                change.pathSize,
+                                                &parentRef,
+                                                &namePtr,
+                                                &pathLen);
+        bool isRoot = (change.pathSize == 0);
+
+        // Nodes are always journaled under parents that already existed, (if the parent was new, it
+        // would have been journaled instead.)
+        if (   (isRoot == false)
+            && (   (parentRef == NULL)
+                || (   (parentRef->type != LE_CFG_TYPE_STEM)
+                    && (parentRef->type != LE_CFG_TYPE_EMPTY))))
+        {
+            return false;
+        }
 
-        case TT_OPEN_GROUP:
-            while (tokenType != TT_CLOSE_GROUP)
-            {
-                if (ReadToken(filePtr, stringBuffer, sizeof(stringBuffer), &tokenType) != LE_OK)
+        switch (change.type)
+        {
+            case JOURNAL_DELETE:
+                if (apply == false)
                 {
-                    LE_ERROR("Unexpected EOF or bad token in file while looking for '}'.");
-                    return LE_FORMAT_ERROR;
+                    break;
                 }
 
-                if (tokenType == TT_STRING_VALUE)
+                if (isRoot)
                 {
-                    size_t strLen = le_utf8_NumBytes(stringBuffer);
-                    size_t newPathLen = pathLen + 1 + strLen;
+                    ClearJournalNode(rootRef);
+                }
+                else if (nodeRef != NULL)
+                {
+                    le_mem_Release(nodeRef);
 
-                    if (newPathLen > LE_CFG_STR_LEN)
+                    // As in a snapshot, a stem without any children left is an empty node.
+                    if (le_dls_IsEmpty(&parentRef->info.children))
                     {
-                        LE_ERROR("New path length for node '%s' is too long.  %zu of %zu bytes.",
-                                 stringBuffer,
-                                 strLen,
-                                 (size_t)LE_CFG_STR_LEN);
-
-                        return LE_FORMAT_ERROR;
+                        DeleteChildIndex(parentRef);
+                        parentRef->type = LE_CFG_TYPE_EMPTY;
                     }
+                }
+                break;
 
-                    tdb_NodeRef_t childRef = GetNamedChild(nodeRef, stringBuffer);
-
-                    if (childRef == NULL)
-                    {
-                        childRef = NewChildNode(nodeRef);
-                        if (tdb_SetNodeName(childRef, stringBuffer) != LE_OK)
-                        {
-                            LE_ERROR("Bad node name, '%s'.", stringBuffer);
-                            return LE_FORMAT_ERROR;
-                        }
+            case JOURNAL_REPLACE:
+            {
+                RecordHeader_t header;
 
-                        LE_DEBUG("New node, %s", stringBuffer);
-                    }
+                if ((endOffset - offset) < sizeof(header))
+                {
+                    return false;
+                }
 
-                    tdb_EnsureExists(childRef);
+                memcpy(&header, basePtr + offset, sizeof(header));
 
-                    le_result_t result = InternalReadNode(childRef, filePtr, newPathLen);
+                uint64_t recordEnd =
+                    (uint64_t)offset + sizeof(header) + header.nameSize + 1 + header.dataSize;
 
-                    if (result != LE_OK)
+                if (apply == false)
+                {
+                    if (   (recordEnd > endOffset)
+                        || (ValidateRecords(basePtr, offset, recordEnd, pathLen, isRoot) == false)
+                        || (strcmp(namePtr, (const char*)basePtr + offset + sizeof(header)) != 0))
                     {
-                        return result;
+                        return false;
                     }
                 }
-                else if (tokenType == TT_CLOSE_GROUP)
+                else if (nodeRef != NULL)
                 {
-                    break;
+                    ClearJournalNode(nodeRef);
+                    LoadRecord(nodeRef, snapshotPtr, offset);
                 }
                 else
                 {
-                    LE_ERROR("Unexpected token in found while looking for '}'.");
-                    return LE_FORMAT_ERROR;
+                    nodeRef = NewChildNode(parentRef);
+
+                    // The new node was indexed without a name.
+                    UnindexChild(nodeRef);
+                    LoadRecord(nodeRef, snapshotPtr, offset);
+                    IndexChild(nodeRef);
                 }
-            }
-            break;
 
-        case TT_CLOSE_GROUP:
-        default:
-            LE_ERROR("Unexpected token found.");
-            return LE_FORMAT_ERROR;
-    }
+                offset = recordEnd;
+                break;
+            }
 
-    if (IsShadow(nodeRef) == false)
-    {
-        ClearModifiedFlag(nodeRef);
-    }
-    else
-    {
-        SetModifiedFlag(nodeRef);
+            default:
+                return false;
+        }
     }
 
-    tdb_EnsureExists(nodeRef);
-
-    return LE_OK;
+    return true;
 }
 
 
@@ -2288,88 +4287,136 @@ static le_result_t InternalReadNode
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Serialize a tree node and it's children to a file in the filesystem.
- *
- *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ *  Replay the changes in a tree's journal, (if it has one,) on top of the tree that was just loaded
+ *  from the tree file.  If the journal doesn't belong to that tree file, it's deleted.  If its last
+ *  entries are damaged, (because the system went down while they were being written,) they're cut
+ *  off.
  */
 // -------------------------------------------------------------------------------------------------
-static le_result_t InternalWriteNode
+static void LoadJournal
 (
-    tdb_NodeRef_t nodeRef,  ///< [IN] The node being written.
-    FILE* filePtr           ///< [IN] The file being written to.
+    tdb_TreeRef_t treeRef  ///< [IN] The tree that was loaded.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If there is no node to write, or if the node is marked as having been deleted...  Then write
-    // a blank node.
-    if (   (nodeRef == NULL)
-        || (IsDeleted(nodeRef) == true))
+    char filePath[LE_CFG_STR_LEN_BYTES] = "";
+    GetJournalPath(treeRef->name, filePath, sizeof(filePath));
+
+    int fileRef = -1;
+
+    do
     {
-        return WriteFile(filePtr, "~ ", 2);
+        fileRef = open(filePath, O_RDWR);
     }
+    while ((fileRef == -1) && (errno == EINTR));
 
-    // Get the node's value as a string.
-    static char stringBuffer[LE_CFG_STR_LEN_BYTES] = "";
-    le_result_t result = LE_OK;
+    if (fileRef == -1)
+    {
+        LE_ERROR_IF(errno != ENOENT, "Could not open config tree journal '%s' (%m).", filePath);
+        return;
+    }
 
-    tdb_GetValueAsString(nodeRef, stringBuffer, sizeof(stringBuffer), "");
+    JournalHeader_t header;
+    struct stat fileStat;
+    ssize_t bytesRead = -1;
 
-    // Now, depending on the type of node, write out any required format information.
-    switch (nodeRef->type)
+    do
     {
-        case LE_CFG_TYPE_EMPTY:
-        case LE_CFG_TYPE_DOESNT_EXIST:
-            result = WriteFile(filePtr, "~ ", 2);
-            break;
+        bytesRead = pread(fileRef, &header, sizeof(header), 0);
+    }
+    while ((bytesRead == -1) && (errno == EINTR));
 
-        case LE_CFG_TYPE_BOOL:
-            {
-                const char boolBuffer[3] = { '!', stringBuffer[0], ' ' };
-                result = WriteFile(filePtr, boolBuffer, sizeof(boolBuffer));
-            }
-            break;
+    void* basePtr = MAP_FAILED;
 
-        case LE_CFG_TYPE_STRING:
-            result = WriteStringValue(filePtr, '\"', '\"', stringBuffer);
-            break;
+    if (   (bytesRead == sizeof(header))
+        && (memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) == 0)
+        && (header.version == JOURNAL_VERSION)
+        && (header.byteOrder == SNAPSHOT_BYTE_ORDER)
+        && (treeRef->snapshotSize != 0)
+        && (header.revisionId == (uint32_t)treeRef->revisionId)
+        && (header.baseSize == (uint64_t)treeRef->snapshotSize)
+        && (fstat(fileRef, &fileStat) == 0)
+        && ((uint64_t)fileStat.st_size <= UINT32_MAX))
+    {
+        basePtr = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileRef, 0);
+        LE_ERROR_IF(basePtr == MAP_FAILED, "Could not map the tree journal, reason: %m");
+    }
 
-        case LE_CFG_TYPE_INT:
-            result = WriteStringValue(filePtr, '[', ']', stringBuffer);
-            break;
+    if (basePtr == MAP_FAILED)
+    {
+        LE_WARN("Discarding config tree journal '%s', it doesn't match the tree file.", filePath);
 
-        case LE_CFG_TYPE_FLOAT:
-            result = WriteStringValue(filePtr, '(', ')', stringBuffer);
-            break;
+        close(fileRef);
+        DeleteTreeFile(filePath);
+        return;
+    }
 
-        // Looks like this node is a collection, so write out it's child nodes now.
-        case LE_CFG_TYPE_STEM:
-            if ((result = WriteFile(filePtr, "{ ", 2)) == LE_OK)
-            {
-                tdb_NodeRef_t childRef = tdb_GetFirstActiveChildNode(nodeRef);
+    // Stems loaded from the journal keep it mapped, just like a snapshot.
+    Snapshot_t* snapshotPtr = le_mem_ForceAlloc(SnapshotPool);
 
-                while (   (childRef != NULL)
-                       && (result == LE_OK))
-                {
-                    tdb_GetNodeName(childRef, stringBuffer, sizeof(stringBuffer));
-                    result = WriteStringValue(filePtr, '\"', '\"', stringBuffer);
+    snapshotPtr->basePtr = basePtr;
+    snapshotPtr->size = fileStat.st_size;
 
-                    if (result == LE_OK)
-                    {
-                        result = InternalWriteNode(childRef, filePtr);
-                    }
+    uint32_t offset = sizeof(header);
+    size_t entryCount = 0;
 
-                    childRef = tdb_GetNextActiveSiblingNode(childRef);
-                }
+    while (offset < snapshotPtr->size)
+    {
+        JournalEntryHeader_t entryHeader;
 
-                if (result == LE_OK)
-                {
-                    result = WriteFile(filePtr, "} ", 2);
-                }
-            }
+        if ((snapshotPtr->size - offset) < sizeof(entryHeader))
+        {
+            break;
+        }
+
+        memcpy(&entryHeader, snapshotPtr->basePtr + offset, sizeof(entryHeader));
+
+        uint32_t dataOffset = offset + sizeof(entryHeader);
+
+        if (   ((snapshotPtr->size - dataOffset) < entryHeader.size)
+            || (JournalChecksum(snapshotPtr->basePtr + dataOffset, entryHeader.size)
+                != entryHeader.checksum)
+            || (ReplayJournalEntry(treeRef->rootNodeRef,
+                                   snapshotPtr,
+                                   dataOffset,
+                                   dataOffset + entryHeader.size,
+                                   false) == false))
+        {
             break;
+        }
+
+        ReplayJournalEntry(treeRef->rootNodeRef,
+                           snapshotPtr,
+                           dataOffset,
+                           dataOffset + entryHeader.size,
+                           true);
+
+        offset = dataOffset + entryHeader.size;
+        entryCount++;
     }
 
-    return result;
+    if (offset < snapshotPtr->size)
+    {
+        LE_WARN("Discarding %zu damaged bytes at the end of config tree journal '%s'.",
+                snapshotPtr->size - offset,
+                filePath);
+
+        LE_ERROR_IF(ftruncate(fileRef, offset) != 0,
+                    "Could not truncate config tree journal, reason: %m");
+    }
+
+    LE_DEBUG("** Replayed %zu journal entries for tree '%s'.", entryCount, treeRef->name);
+
+    treeRef->journalSize = offset;
+    le_mem_Release(snapshotPtr);
+
+    int retVal = -1;
+
+    do
+    {
+        retVal = close(fileRef);
+    }
+    while ((retVal == -1) && (errno == EINTR));
 }
 
 
@@ -2481,11 +4528,22 @@ static void LoadTree
         }
         else
         {
-            if (tdb_ReadTreeNode(treeRef->rootNodeRef, fileRef) == false)
+            le_result_t result = LoadSnapshot(treeRef, fileRef);
+
+            // Files that aren't snapshots were written in the text format by an older version.
+            // They're replaced by snapshots the next time the tree is changed.
+            if (result == LE_FORMAT_ERROR)
+            {
+                LE_DEBUG("** Reading text configuration tree file: %s.", pathPtr);
+                result = tdb_ReadTreeNode(treeRef->rootNodeRef, fileRef) ? LE_OK : LE_FAULT;
+            }
+
+            if (result != LE_OK)
             {
                 LE_ERROR("Could not parse configuration tree file: %s.", pathPtr);
                 le_mem_Release(treeRef->rootNodeRef);
                 treeRef->rootNodeRef = NewNode();
+                treeRef->snapshotSize = 0;
             }
 
             int retVal = -1;
@@ -2497,6 +4555,10 @@ static void LoadTree
             while ((retVal == -1) && (errno == EINTR));
         }
     }
+
+    // Now bring the tree up to date with the changes that have been journaled since the tree file
+    // was written.
+    LoadJournal(treeRef);
 }
 
 
@@ -2587,28 +4649,6 @@ static bool OnHandlerRegistrationCleanup
 
 
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Call this function to delete a tree file from the filesystem.
- */
-// -------------------------------------------------------------------------------------------------
-static void DeleteTreeFile
-(
-    const char* filePathPtr  ///< Path to the tree file in question.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
-
-    if (unlink(filePathPtr) != 0)
-    {
-        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
-    }
-}
-
-
-
-
 // -------------------------------------------------------------------------------------------------
 /**
  *  Find the root node represented by the path ref.
@@ -2730,6 +4770,217 @@ static void CloseFilePtr
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Make a copy of a node of a named tree, along with all of its children.  Children that are still
+ *  in a snapshot aren't loaded, the copy shares the snapshot instead.
+ *
+ *  @return The new copy of the node.
+ */
+// -------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t CopyNode
+(
+    tdb_NodeRef_t nodeRef,    ///< [IN] The node to copy.
+    tdb_NodeRef_t parentRef   ///< [IN] The copy of the node's parent, or NULL for the root.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(IsShadow(nodeRef) == false);
+
+    tdb_NodeRef_t copyRef = NewNode();
+
+    copyRef->parentRef = parentRef;
+    copyRef->type = nodeRef->type;
+    copyRef->flags = nodeRef->flags;
+    copyRef->nameHash = nodeRef->nameHash;
+
+    if (nodeRef->nameRef != NULL)
+    {
+        nstr_AddRef(nodeRef->nameRef);
+        copyRef->nameRef = nodeRef->nameRef;
+    }
+
+    switch (nodeRef->type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+        case LE_CFG_TYPE_DOESNT_EXIST:
+            break;
+
+        case LE_CFG_TYPE_STEM:
+            if (nodeRef->snapshotPtr != NULL)
+            {
+                le_mem_AddRef(nodeRef->snapshotPtr);
+                copyRef->snapshotPtr = nodeRef->snapshotPtr;
+                copyRef->childrenOffset = nodeRef->childrenOffset;
+                copyRef->childrenSize = nodeRef->childrenSize;
+            }
+            else
+            {
+                // The copy's child index, if it needs one, is built the first time it's searched.
+                le_dls_Link_t* linkPtr = le_dls_Peek(&nodeRef->info.children);
+
+                while (linkPtr != NULL)
+                {
+                    tdb_NodeRef_t childRef = CONTAINER_OF(linkPtr, Node_t, siblingList);
+                    tdb_NodeRef_t childCopyRef = CopyNode(childRef, copyRef);
+
+                    le_dls_Queue(&copyRef->info.children, &childCopyRef->siblingList);
+                    linkPtr = le_dls_PeekNext(&nodeRef->info.children, linkPtr);
+                }
+            }
+            break;
+
+        default:
+            if (nodeRef->info.valueRef != NULL)
+            {
+                nstr_AddRef(nodeRef->info.valueRef);
+                copyRef->info.valueRef = nodeRef->info.valueRef;
+            }
+            break;
+    }
+
+    return copyRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Context for MoveReaderToVersion().
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct MoveReadersContext
+{
+    tdb_TreeRef_t treeRef;       ///< The tree that's about to be changed.
+    tdb_NodeRef_t rootNodeRef;   ///< The root node of the copy of its current version.
+    size_t movedCount;           ///< Number of readers moved onto the copy so far.
+}
+MoveReadersContext_t;
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Called for each iterator.  If it's reading the current version of the tree that's about to be
+ *  changed, it's moved onto the copy of that version.
+ */
+// -------------------------------------------------------------------------------------------------
+static void MoveReaderToVersion
+(
+    ni_ConstIteratorRef_t iteratorRef,  ///< [IN] The iterator to check.
+    void* contextPtr                    ///< [IN] The MoveReadersContext_t.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    MoveReadersContext_t* moveContextPtr = contextPtr;
+    tdb_TreeRef_t treeRef = moveContextPtr->treeRef;
+
+    if (   (ni_GetTree(iteratorRef) == treeRef)
+        && (ni_IsWriteable(iteratorRef) == false)
+        && (ni_GetRootNode(iteratorRef) == treeRef->rootNodeRef))
+    {
+        ni_MoveToVersion((ni_IteratorRef_t)iteratorRef, moveContextPtr->rootNodeRef);
+        moveContextPtr->movedCount++;
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Called before a named tree is changed.  If there are read transactions on the tree's current
+ *  version, that version is copied and kept as an older version, and the readers are moved onto
+ *  the copy.  That way the readers keep seeing the tree as it was when they started, and the
+ *  changes can be made right away instead of waiting for the readers to finish.
+ */
+// -------------------------------------------------------------------------------------------------
+static void FreezeCurrentVersion
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The named tree that's about to be changed.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (treeRef->currentReadCount == 0)
+    {
+        return;
+    }
+
+    MoveReadersContext_t context = { treeRef, CopyNode(treeRef->rootNodeRef, NULL), 0 };
+
+    ni_ForEachIter(MoveReaderToVersion, &context);
+    LE_ASSERT(context.movedCount == treeRef->currentReadCount);
+
+    Version_t* versionPtr = le_mem_ForceAlloc(VersionPool);
+
+    versionPtr->link = LE_DLS_LINK_INIT;
+    versionPtr->rootNodeRef = context.rootNodeRef;
+    versionPtr->readCount = treeRef->currentReadCount;
+
+    le_dls_Queue(&treeRef->versionList, &versionPtr->link);
+    treeRef->currentReadCount = 0;
+
+    LE_DEBUG("Tree '%s' changed under %zu reader(s), %zu older version(s) now kept.",
+             treeRef->name,
+             versionPtr->readCount,
+             le_dls_NumLinks(&treeRef->versionList));
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Called when a read iterator is removed from a named tree.  Drops the iterator from the count of
+ *  readers of the version it was on.  If that was an older version and this was its last reader,
+ *  the version is released.
+ */
+// -------------------------------------------------------------------------------------------------
+static void ReleaseReader
+(
+    tdb_TreeRef_t treeRef,     ///< [IN] The named tree.
+    tdb_NodeRef_t rootNodeRef  ///< [IN] Root node of the version the iterator was on.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (rootNodeRef == treeRef->rootNodeRef)
+    {
+        LE_ASSERT(treeRef->currentReadCount > 0);
+        treeRef->currentReadCount--;
+        return;
+    }
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&treeRef->versionList);
+
+    while (linkPtr != NULL)
+    {
+        Version_t* versionPtr = CONTAINER_OF(linkPtr, Version_t, link);
+
+        if (versionPtr->rootNodeRef == rootNodeRef)
+        {
+            LE_ASSERT(versionPtr->readCount > 0);
+
+            if (--versionPtr->readCount == 0)
+            {
+                le_dls_Remove(&treeRef->versionList, &versionPtr->link);
+                le_mem_Release(versionPtr->rootNodeRef);
+                le_mem_Release(versionPtr);
+            }
+
+            return;
+        }
+
+        linkPtr = le_dls_PeekNext(&treeRef->versionList, linkPtr);
+    }
+
+    LE_FATAL("Read iterator on unknown version of tree '%s'.", treeRef->name);
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Initialize the tree DB subsystem, and automaticly load the system tree from the filesystem.
@@ -2776,6 +5027,11 @@ void tdb_Init
     HandlerPool = le_mem_CreatePool(CFG_HANDLER_POOL_NAME, sizeof(Handler_t));
     RegistrationPool = le_mem_CreatePool(CFG_REGISTRATION_POOL_NAME, sizeof(Registration_t));
 
+    SnapshotPool = le_mem_CreatePool(CFG_SNAPSHOT_POOL_NAME, sizeof(Snapshot_t));
+    le_mem_SetDestructor(SnapshotPool, SnapshotDestructor);
+
+    VersionPool = le_mem_CreatePool(CFG_VERSION_POOL_NAME, sizeof(Version_t));
+
     // Preload the system tree.
     tdb_GetTree("system");
 }
@@ -2850,6 +5106,8 @@ void tdb_DeleteTree
             }
         }
 
+        DeleteJournal(treeRef);
+
         LE_ASSERT(le_hashmap_Remove(TreeCollectionRef, treeRef->name) == treeRef);
         le_mem_Release(treeRef);
     }
@@ -3029,7 +5287,11 @@ void tdb_RegisterIterator
     }
     else
     {
+        // A new reader always starts on the current version of the tree.
+        LE_ASSERT(ni_GetRootNode(iteratorRef) == treeRef->rootNodeRef);
+
         treeRef->activeReadCount++;
+        treeRef->currentReadCount++;
     }
 }
 
@@ -3069,6 +5331,8 @@ void tdb_UnregisterIterator
     }
     else
     {
+        ReleaseReader(treeRef, ni_GetRootNode(iteratorRef));
+
         treeRef->activeReadCount--;
         LE_ASSERT(treeRef->activeReadCount >= 0);
     }
@@ -3111,7 +5375,10 @@ le_sls_List_t* tdb_GetRequestQueue
 // -------------------------------------------------------------------------------------------------
 /**
  *  Merge a shadow tree into the original tree it was created from.  Once the change is merged the
- *  updated tree is serialized to the filesystem.
+ *  updated tree is serialized to the filesystem, either by appending the changes to the tree's
+ *  journal, or by writing a new snapshot of the whole tree.
+ *
+ *  Read transactions that are open on the original tree keep seeing it as it was before the merge.
  */
 // -------------------------------------------------------------------------------------------------
 void tdb_MergeTree
@@ -3120,19 +5387,44 @@ void tdb_MergeTree
 )
 // -------------------------------------------------------------------------------------------------
 {
+    tdb_TreeRef_t originalTreeRef = shadowTreeRef->originalTreeRef;
+
+    // Readers of the tree don't hold up the commit, they're given a copy of the tree as it is now.
+    FreezeCurrentVersion(originalTreeRef);
+
+    // Changes can only be journaled on top of a snapshot.
+    SnapshotWriter_t* journalPtr = NULL;
+
+    if (originalTreeRef->snapshotSize != 0)
+    {
+        journalPtr = StartJournalEntry();
+    }
+
     // Get our shadow tree's root node and merge it's changes into the real tree.  Create a path
     // iterator to track the merge and allow for update handlers to be called.
     tdb_NodeRef_t nodeRef = shadowTreeRef->rootNodeRef;
-    le_pathIter_Ref_t pathRef = CreateBasePath(shadowTreeRef->originalTreeRef->name);
+    le_pathIter_Ref_t pathRef = CreateBasePath(originalTreeRef->name);
 
-    InternalMergeTree(shadowTreeRef->originalTreeRef->name, pathRef, nodeRef, false);
+    InternalMergeTree(originalTreeRef->name, pathRef, nodeRef, false, journalPtr);
     le_pathIter_Delete(pathRef);
 
     // Now, go through and call the triggered callbacks.
     FireTriggeredCallbacks();
 
+    if (journalPtr != NULL)
+    {
+        le_result_t journalResult = AppendJournal(originalTreeRef, journalPtr);
+
+        if (journalResult == LE_OK)
+        {
+            return;
+        }
+
+        LE_DEBUG("Changes not journaled (%s), writing a new snapshot of the tree.",
+                 LE_RESULT_TXT(journalResult));
+    }
+
     // Now increment revision of the tree and open a tree file for writing.
-    tdb_TreeRef_t originalTreeRef = shadowTreeRef->originalTreeRef;
     int oldId = originalTreeRef->revisionId;
 
     IncrementRevision(originalTreeRef);
@@ -3142,6 +5434,13 @@ void tdb_MergeTree
 
     LE_DEBUG("Changes merged, now attempting to serialize the tree to '%s'.", filePath);
 
+    // Snapshots stay mapped while nodes are being loaded from them, so a tree file must never be
+    // changed in place.  If an old file was left behind at this revision, remove it first.
+    if (TreeFileExists(originalTreeRef->name, originalTreeRef->revisionId))
+    {
+        DeleteTreeFile(filePath);
+    }
+
     int fileRef = -1;
 
     do
@@ -3156,11 +5455,14 @@ void tdb_MergeTree
         LE_EMERG("Failed to open config file '%s' (%m).", filePath);
         LE_EMERG("Changes have been merged in memory, however they could not be committed to the "
                  "filesystem!!");
+        originalTreeRef->snapshotSize = 0;
         return;
     }
 
-    // We have a tree file to write to, so stream the new tree to it then close the output file.
-    le_result_t writeResult = tdb_WriteTreeNode(originalTreeRef->rootNodeRef, fileRef);
+    // We have a tree file to write to, so write a snapshot of the tree to it then close the output
+    // file.
+    off_t fileSize = 0;
+    le_result_t writeResult = WriteSnapshot(originalTreeRef->rootNodeRef, fileRef, &fileSize);
     int retVal = -1;
 
     do
@@ -3172,7 +5474,7 @@ void tdb_MergeTree
     LE_EMERG_IF(retVal == -1, "An error occurred while closing the tree file: %s", strerror(errno));
 
 
-    // Finally remove the old version of the tree file, if there is one.
+    // Finally remove the old version of the tree file, if there is one, along with its journal.
     if (writeResult == LE_OK)
     {
         if (   (oldId != 0)
@@ -3181,12 +5483,17 @@ void tdb_MergeTree
             GetTreePath(originalTreeRef->name, oldId, filePath, sizeof(filePath));
             DeleteTreeFile(filePath);
         }
+
+        DeleteJournal(originalTreeRef);
+        originalTreeRef->snapshotSize = fileSize;
     }
     else
     {
-        // The write failed, delete the new file we attempted to create.
+        // The write failed, delete the new file we attempted to create.  Nothing more can be
+        // journaled until a new snapshot has been written.
         LE_EMERG("The attempt to write to the config tree file, '%s,' failed.", filePath);
         DeleteTreeFile(filePath);
+        originalTreeRef->snapshotSize = 0;
     }
 }
 
@@ -3319,6 +5626,56 @@ le_result_t tdb_WriteTreeNode
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write the binary record of a node and all of its children, (see nodeRecord.h,) to a file
+ *  descriptor in one go.  The record is built up in memory first, so nothing is written if the
+ *  subtree is too big.  Deleted nodes are written as empty nodes.
+ *
+ *  The descriptor can be non-blocking, (like a pipe to a client,) as long as it has room for the
+ *  whole record.
+ *
+ *  @return LE_OK if the record was written.
+ *          LE_OVERFLOW if the record would be bigger than CFG_MAX_SUBTREE_BYTES.
+ *          LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_WriteNodeRecord
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] Write the contents of this node to a file descriptor.
+    int descriptor          ///< [IN] The file descriptor to write to.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    SnapshotWriter_t* writerPtr = StartSnapshotWriter(-1);
+
+    WriteSnapshotRecord(writerPtr, nodeRef);
+
+    if (writerPtr->result != LE_OK)
+    {
+        return writerPtr->result;
+    }
+
+    ssize_t written = -1;
+
+    do
+    {
+        written = write(descriptor, writerPtr->buffer, writerPtr->bufferedSize);
+    }
+    while ((written == -1) && (errno == EINTR));
+
+    if (written != (ssize_t)writerPtr->bufferedSize)
+    {
+        LE_ERROR("Failed to write node record of %zu bytes, reason: %m", writerPtr->bufferedSize);
+        return LE_IO_ERROR;
+    }
+
+    return LE_OK;
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Given a base node and a path, find another node in the tree.
@@ -3482,19 +5839,12 @@ le_result_t tdb_GetNodeName
     // NULL.  The reason that the name may be NULL is because the client never changed the name of
     // the node.  So, we just get the name from the original node, saving memory.  However, nodes
     // like the root node of a tree also do not have names.
-    dstr_Ref_t nameRef = nodeRef->nameRef;
-
-    if (   (IsShadow(nodeRef))
-        && (nodeRef->nameRef == NULL)
-        && (nodeRef->shadowRef != NULL))
-    {
-        nameRef = nodeRef->shadowRef->nameRef;
-    }
+    nstr_Ref_t nameRef = GetNameRef(nodeRef);
 
     // If the node has a name, copy it into the user buffer now.
     if (nameRef != NULL)
     {
-        return dstr_CopyToCstr(stringPtr, maxSize, nameRef, NULL);
+        return nstr_CopyToCstr(stringPtr, maxSize, nameRef);
     }
 
     return LE_OK;
@@ -3551,15 +5901,20 @@ le_result_t tdb_SetNodeName
     }
 
     // Copy over the new name.  Note that we don't care if this node is a shadow node.  Coping over
-    // the name is taken care of as part of the merge process.
-    if (nodeRef->nameRef == NULL)
-    {
-        nodeRef->nameRef = dstr_NewFromCstr(stringPtr);
-    }
-    else
+    // the name is taken care of as part of the merge process.  The node has to be re-indexed under
+    // its new name.
+    UnindexChild(nodeRef);
+
+    nstr_Ref_t oldNameRef = nodeRef->nameRef;
+
+    nodeRef->nameRef = nstr_GetName(stringPtr);
+    nodeRef->nameHash = nstr_GetHash(nodeRef->nameRef);
+
+    if (oldNameRef != NULL)
     {
-        dstr_CopyFromCstr(nodeRef->nameRef, stringPtr);
+        nstr_Release(oldNameRef);
     }
+    IndexChild(nodeRef);
 
     // If this is a shadow node and this is the change that modified it, then try to get it's
     // children now.  This is done so that later when this node is merged the merge code doesn't end
@@ -3608,8 +5963,21 @@ le_cfg_nodeType_t tdb_GetNodeType
         return LE_CFG_TYPE_DOESNT_EXIST;
     }
 
-    // If the node is a stem but has no children, then treat the node as empty.
+    // An unmodified shadow stem whose children haven't been shadowed yet has the same children as
+    // the original node.  So ask the original, rather than shadowing all of them just to find out.
+    if (   (nodeRef->type == LE_CFG_TYPE_STEM)
+        && (IsShadow(nodeRef))
+        && (IsModified(nodeRef) == false)
+        && (nodeRef->shadowRef != NULL)
+        && (le_dls_IsEmpty(&nodeRef->info.children) == true))
+    {
+        return tdb_GetNodeType(nodeRef->shadowRef);
+    }
+
+    // If the node is a stem but has no children, then treat the node as empty.  (Stems that still
+    // have their children in a snapshot always have some, so don't bother loading them.)
     if (   (nodeRef->type == LE_CFG_TYPE_STEM)
+        && (nodeRef->snapshotPtr == NULL)
         && (tdb_GetFirstActiveChildNode(nodeRef) == NULL))
     {
         return LE_CFG_TYPE_EMPTY;
@@ -3686,24 +6054,13 @@ void tdb_SetEmpty
     // If this is a stem node, then go through and clear out the children.
     if (nodeRef->type == LE_CFG_TYPE_STEM)
     {
-        tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
-
-        while (childRef != NULL)
-        {
-            tdb_NodeRef_t nextChildRef = tdb_GetNextSiblingNode(childRef);
-
-            // We don't remove the child from the list explicitly, because the destructor will take
-            // care of that for us.
-            le_mem_Release(childRef);
-            childRef = nextChildRef;
-        }
-
+        ReleaseChildren(nodeRef);
         nodeRef->info.children = LE_DLS_LIST_INIT;
     }
     else if (nodeRef->info.valueRef)
     {
         // It's a string value, so free it now.
-        dstr_Release(nodeRef->info.valueRef);
+        nstr_Release(nodeRef->info.valueRef);
         nodeRef->info.valueRef = NULL;
     }
 
@@ -3795,6 +6152,8 @@ tdb_NodeRef_t tdb_GetFirstChildNode
 {
     LE_ASSERT(nodeRef != NULL);
 
+    LoadChildren(nodeRef);
+
     // Is this the type of node that has children?
     if (   (   (nodeRef->type != LE_CFG_TYPE_STEM)
             || (le_dls_IsEmpty(&nodeRef->info.children) == true))
@@ -3952,13 +6311,13 @@ le_result_t tdb_GetValueAsString
         if (IsShadow(nodeRef))
         {
             LE_ASSERT(nodeRef->shadowRef != NULL);
-            return dstr_CopyToCstr(stringPtr, maxSize, nodeRef->shadowRef->info.valueRef, NULL);
+            return nstr_CopyToCstr(stringPtr, maxSize, nodeRef->shadowRef->info.valueRef);
         }
 
         return LE_OK;
     }
 
-    return dstr_CopyToCstr(stringPtr, maxSize, nodeRef->info.valueRef, NULL);
+    return nstr_CopyToCstr(stringPtr, maxSize, nodeRef->info.valueRef);
 }
 
 
@@ -3990,15 +6349,13 @@ void tdb_SetValueAsString
     // Mark this as a string node, and copy over the value.
     nodeRef->type = LE_CFG_TYPE_STRING;
 
-    if (nodeRef->info.valueRef == NULL)
+    if (nodeRef->info.valueRef != NULL)
     {
-        nodeRef->info.valueRef = dstr_NewFromCstr(stringPtr);
-    }
-    else
-    {
-        dstr_CopyFromCstr(nodeRef->info.valueRef, stringPtr);
+        nstr_Release(nodeRef->info.valueRef);
     }
 
+    nodeRef->info.valueRef = nstr_NewValue(stringPtr);
+
     // Make sure the system knows this node has been modified so that it can be included for merging
     // into the original tree.  Also, make sure that this node and it's parents are not marked as
     // having been deleted.
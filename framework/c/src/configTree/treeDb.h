@@ -229,6 +229,8 @@ le_sls_List_t* tdb_GetRequestQueue
 /**
  *  Merge a shadow tree into the original tree it was created from.  Once the change is merged the
  *  updated tree is serialized to the filesystem.
+ *
+ *  Read transactions that are open on the original tree keep seeing it as it was before the merge.
  */
 // -------------------------------------------------------------------------------------------------
 void tdb_MergeTree
@@ -287,6 +289,29 @@ le_result_t tdb_WriteTreeNode
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write the binary record of a node and all of its children, (see nodeRecord.h,) to a file
+ *  descriptor in one go.  The record is built up in memory first, so nothing is written if the
+ *  subtree is too big.  Deleted nodes are written as empty nodes.
+ *
+ *  The descriptor can be non-blocking, (like a pipe to a client,) as long as it has room for the
+ *  whole record.
+ *
+ *  @return LE_OK if the record was written.
+ *          LE_OVERFLOW if the record would be bigger than CFG_MAX_SUBTREE_BYTES.
+ *          LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_WriteNodeRecord
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] Write the contents of this node to a file descriptor.
+    int descriptor          ///< [IN] The file descriptor to write to.
+);
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Given a base node and a path, find another node in the tree.
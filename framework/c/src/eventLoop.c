@@ -65,20 +65,29 @@
  * Included in the set of file descriptors that are being monitored by epoll is an eventfd
  * (see 'man eventfd') monitored in "level-triggered" mode.
  *
- * Whenever an Event Report is added to the Event Queue for a thread, the number 1 is written to
- * that thread's eventfd.  When Event Reports are popped off a thread's Event Queue, that thread's
- * eventfd is read to decrement it.  As long as the eventfd's value is greater than 0, epoll_wait()
- * will return immediately, reporting that there is something to read from that fd.
+ * Whenever an Event Report is added to a thread's empty Event Queue, the number 1 is written to
+ * that thread's eventfd.  Reports added to a queue that is already non-empty don't write to the
+ * eventfd, because the thread has already been woken up.  When a thread takes the last Event
+ * Report off its Event Queue, it reads its eventfd to reset it to zero.  Both are done with the
+ * Mutex locked, so the eventfd is readable if and only if the Event Queue is not empty, and
+ * epoll_wait() will return immediately as long as there is something on the Event Queue.
  *
  * The Event Loop is an infinite loop that calls epoll_wait() and then responds to any fd events
- * that epoll_wait() reports.  If epoll_wait() reports an event on the eventfd, then an Event Report
- * is popped off the Event Queue and processed.  If epoll_wait() reports an event on any other fd,
- * FD Event Reports are created and pushed onto Event Queues according to what handlers are
- * registered for those events.  All pending Event Reports are processed until the Event Queue is
- * empty before returning to epoll_wait().  (NOTE: This choice was made to save system call
- * overhead in times of heavy load.  Unfortunately, it also means that if event handlers always add
- * new events to the queue, then epoll_wait() will never be called and therefore fd events will
- * never be detected.)
+ * that epoll_wait() reports.  If epoll_wait() reports an event on the eventfd, the whole Event
+ * Queue is moved onto the thread's Dispatch Queue in a single critical section, and the reports
+ * in that batch are processed until the Dispatch Queue is empty.  (NOTE: This choice was made to
+ * save system call and locking overhead in times of heavy load.)  Then, for each event that
+ * epoll_wait() reported on any other fd, the FD Monitor module calls the fd's handler function
+ * directly, without queueing anything or locking the Mutex (see fdMonitor.c), before returning to
+ * epoll_wait().  Any Event Reports that the handlers add to the Event Queue while a batch is
+ * being processed will wait until the next batch, so handlers that keep re-queueing events can't
+ * prevent fd events from being detected.
+ *
+ * The handlers for the Publish-Subscribe Event Reports in a batch are looked up in groups of
+ * up to MAX_HANDLERS_RESOLVED_PER_LOCK per critical section, rather than locking the Mutex
+ * once per report.  If a handler function removes one of its thread's handlers or changes the
+ * context pointer of one of them, the remaining reports in the group are looked up again, so
+ * a report never gets delivered to a handler that has been removed.
  *
  * ----
  *
@@ -119,6 +128,10 @@
 /// @todo Make this configurable.
 #define DEFAULT_REPORT_POOL_SIZE 1
 
+/// The maximum number of free report objects that each thread keeps cached for itself, for both
+/// the Queued Function Report Pool and the per-Event-ID Report Pools.
+#define REPORT_POOL_THREAD_CACHE_SIZE 8
+
 /// The default number of objects in the process-wide Handler Pool, from which all Handler objects
 /// are allocated.
 /// @todo Make this configurable.
@@ -129,6 +142,10 @@
 /// @todo Make this configurable.
 #define DEFAULT_EVENT_POOL_SIZE 5
 
+/// Maximum number of Publish-Subscribe Event Reports on a thread's Dispatch Queue whose handlers
+/// are looked up in a single critical section.
+#define MAX_HANDLERS_RESOLVED_PER_LOCK 16
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -305,6 +322,23 @@ QueuedFunctionReport_t;
 static le_mem_PoolRef_t QueuedFunctionPool;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Information copied out of a Handler object so that the handler can be called for a
+ * Publish-Subscribe Event Report after the Mutex has been unlocked.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_event_LayeredHandlerFunc_t   firstLayerFunc; ///< First-layer handler function, or NULL if
+                                                    ///  the handler has been removed (or the
+                                                    ///  report is a Queued Function).
+    void*                           secondLayerFunc;///< Second-layer handler function.
+    void*                           contextPtr;     ///< The handler's context pointer.
+}
+ResolvedHandler_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The Safe Reference Map to be used to create Safe References to use as Event IDs.
@@ -445,6 +479,7 @@ static Event_t* CreateEvent
     eventPtr->reportPoolRef = le_mem_CreatePool(poolNameStr,
                                               offsetof(PubSubEventReport_t, payload) + payloadSize);
     le_mem_ExpandPool(eventPtr->reportPoolRef, DEFAULT_REPORT_POOL_SIZE);
+    le_mem_EnableThreadCache(eventPtr->reportPoolRef, REPORT_POOL_THREAD_CACHE_SIZE);
 
     // Up until now, we have not accessed anything that is available to anyone else; except for
     // the EventPool, but that is thread-safe.  But, now we need to touch the Safe Reference Map
@@ -480,6 +515,11 @@ static void DeleteHandler
     le_dls_Remove(&handlerPtr->eventPtr->handlerList, &handlerPtr->eventLink);
     le_dls_Remove(&handlerPtr->threadRecPtr->handlerList, &handlerPtr->threadLink);
     le_ref_DeleteRef(HandlerRefMap, handlerPtr->safeRef);
+
+    // Handlers are only ever deleted by the thread that owns them, so this tells that thread's
+    // Event Loop that any handlers it has already looked up for its Dispatch Queue may be stale.
+    handlerPtr->threadRecPtr->handlerChangeCount++;
+
     le_mem_Release(handlerPtr);
 }
 
@@ -488,7 +528,7 @@ static void DeleteHandler
 /**
  * Write to a thread's Event File Descriptor.  This increments it by one.
  *
- * This must be done exactly once for each Event Report pushed onto the thread's Event Queue.
+ * This must be done exactly once each time the thread's Event Queue goes from empty to non-empty.
  */
 //--------------------------------------------------------------------------------------------------
 static void WriteEventFd
@@ -525,10 +565,13 @@ static void WriteEventFd
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read a thread's Event File Descriptor.  This fetches the value of the Event FD (which is
- * the number of event reports on the Event Queue) and resets the Event FD value to zero.
+ * Read a thread's Event File Descriptor.  This fetches the value of the Event FD and resets the
+ * Event FD value to zero.
+ *
+ * This must be done exactly once each time the thread's Event Queue goes from non-empty to empty.
  *
- * @return The number of Event Reports on the thread's Event Queue.
+ * @return The value of the Event FD (the number of times the Event Queue became non-empty since
+ *         it was last read).
  */
 //--------------------------------------------------------------------------------------------------
 static uint64_t ReadEventFd
@@ -564,34 +607,85 @@ static uint64_t ReadEventFd
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Process one event report from the calling thread's Event Queue.
- **/
+ * Add an Event Report to the end of a thread's Event Queue, waking up the thread if the queue
+ * was empty.
+ *
+ * @warning Assumes the mutex is locked and the thread is protected from cancellation.
+ */
 //--------------------------------------------------------------------------------------------------
-static void ProcessOneEventReport
+static void QueueReport
 (
-    event_PerThreadRec_t* perThreadRecPtr   ///< [in] Ptr to the calling thread's per-thread record.
+    event_PerThreadRec_t*   perThreadRecPtr,    ///< [in] Pointer to the thread's event data record.
+    Report_t*               reportObjPtr        ///< [in] Pointer to the report to be queued.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_sls_Link_t* linkPtr;
-    Report_t* reportObjPtr;
-    Handler_t* handlerPtr;
+    bool wasEmpty = le_sls_IsEmpty(&perThreadRecPtr->eventQueue);
 
-    int oldState = Lock();
+    le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->link);
 
-    // Pop an Event Report off the head of the Event Queue (inside a critical section).
-    linkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue);
+    // If the thread already has something on its Event Queue, its eventfd is already readable,
+    // so the system call can be skipped.
+    if (wasEmpty)
+    {
+        WriteEventFd(perThreadRecPtr);
+    }
+}
 
-    Unlock(oldState);
 
-    if (linkPtr == NULL)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up the handler for an Event Report and copy out of it what is needed to call it.
+ *
+ * @warning Assumes that the Mutex lock is already held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ResolveHandler
+(
+    Report_t*           reportObjPtr,   ///< [in] Pointer to the Event Report.
+    ResolvedHandler_t*  resolvedPtr     ///< [out] Where the handler information is to be stored.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resolvedPtr->firstLayerFunc = NULL;
+
+    // Queued Functions don't have a handler.
+    if (reportObjPtr->type == LE_EVENT_REPORT_QUEUED_FUNC)
     {
         return;
     }
 
-    // Convert the link pointer into a pointer to the Report base class.
-    reportObjPtr = CONTAINER_OF(linkPtr, Report_t, link);
+    PubSubEventReport_t* pubSubReportPtr = CONTAINER_OF(reportObjPtr,
+                                                        PubSubEventReport_t,
+                                                        baseClass);
+
+    // Get a pointer to the Handler object for this Event Report; unless it has been removed.
+    Handler_t* handlerPtr = le_ref_Lookup(HandlerRefMap, pubSubReportPtr->handlerRef);
+    if (handlerPtr != NULL)
+    {
+        resolvedPtr->firstLayerFunc = handlerPtr->firstLayerFunc;
+        resolvedPtr->secondLayerFunc = handlerPtr->secondLayerFunc;
+        resolvedPtr->contextPtr = handlerPtr->contextPtr;
+    }
+}
+
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process an Event Report that has been taken off the calling thread's Event Queue, and release
+ * it when done.
+ *
+ * @warning Assumes the Mutex is NOT locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DispatchReport
+(
+    event_PerThreadRec_t*   perThreadRecPtr,///< [in] Ptr to the calling thread's per-thread record.
+    Report_t*               reportObjPtr,   ///< [in] Pointer to the Event Report.
+    const ResolvedHandler_t* resolvedPtr    ///< [in] Handler info from ResolveHandler().
+)
+//--------------------------------------------------------------------------------------------------
+{
     // If it's a queued function report,
     if (reportObjPtr->type == LE_EVENT_REPORT_QUEUED_FUNC)
     {
@@ -612,15 +706,9 @@ static void ProcessOneEventReport
         PubSubEventReport_t* pubSubReportPtr;
         pubSubReportPtr = CONTAINER_OF(reportObjPtr, PubSubEventReport_t, baseClass);
 
-        oldState = Lock();
-
-        // Get a pointer to the Handler object for this Event Report; unless it has been removed.
-        handlerPtr = le_ref_Lookup(HandlerRefMap, pubSubReportPtr->handlerRef);
-        if (handlerPtr == NULL)
+        if (resolvedPtr->firstLayerFunc == NULL)
         {
             // The handler has been removed, so this report should be discarded.
-            Unlock(oldState);
-
             // If its payload is a pointer to a reference-counted memory pool object,
             // then that has to be released.
             if (reportObjPtr->type == LE_EVENT_REPORT_COUNTED_REF)
@@ -630,12 +718,9 @@ static void ProcessOneEventReport
         }
         else
         {
-            // The handler still exists, so grab the info we need from it and call
-            // the first-layer handler function.
-            perThreadRecPtr->contextPtr = handlerPtr->contextPtr;
-
-            le_event_LayeredHandlerFunc_t firstLayerFunc = handlerPtr->firstLayerFunc;
-            void* secondLayerFunc = handlerPtr->secondLayerFunc;
+            // The handler still existed when it was looked up, so call the first-layer
+            // handler function.
+            perThreadRecPtr->contextPtr = resolvedPtr->contextPtr;
 
             // If it's a reference-counted report, then the payload is a pointer to the
             // report.  Otherwise, the report itself is in the payload.
@@ -649,15 +734,10 @@ static void ProcessOneEventReport
                 reportPtr = pubSubReportPtr->payload;
             }
 
-            Unlock(oldState);  // Unlock the mutex before calling the handler function.
-                               // Don't access the Handler object anymore after this.
-
-            firstLayerFunc(reportPtr, secondLayerFunc);
+            resolvedPtr->firstLayerFunc(reportPtr, resolvedPtr->secondLayerFunc);
         }
     }
 
-    // NOTE: The Mutex should be unlocked by this point.
-
     // We are done with this report.
     le_mem_Release(reportObjPtr);
 }
@@ -665,7 +745,57 @@ static void ProcessOneEventReport
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Process Event Reports from the calling thread's Event Queue until the queue is empty.
+ * Process one event report from the calling thread's Event Queue.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ProcessOneEventReport
+(
+    event_PerThreadRec_t* perThreadRecPtr   ///< [in] Ptr to the calling thread's per-thread record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* linkPtr;
+    Report_t* reportObjPtr;
+    ResolvedHandler_t resolved;
+
+    int oldState = Lock();
+
+    // Pop an Event Report off the head of the Event Queue (inside a critical section).
+    linkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue);
+
+    if (linkPtr == NULL)
+    {
+        Unlock(oldState);
+        return;
+    }
+
+    // If that emptied the Event Queue, reset the eventfd so epoll stops telling us about it until
+    // more are added.
+    if (le_sls_IsEmpty(&perThreadRecPtr->eventQueue))
+    {
+        (void)ReadEventFd(perThreadRecPtr);
+    }
+
+    // Convert the link pointer into a pointer to the Report base class.
+    reportObjPtr = CONTAINER_OF(linkPtr, Report_t, link);
+
+    ResolveHandler(reportObjPtr, &resolved);
+
+    Unlock(oldState);  // Unlock the mutex before calling the handler function.
+
+    DispatchReport(perThreadRecPtr, reportObjPtr, &resolved);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process all the Event Reports that are on the calling thread's Event Queue.
+ *
+ * The whole Event Queue is moved onto the thread's Dispatch Queue in one critical section,
+ * and the handlers for the reports are looked up in groups, so the Mutex is not locked once
+ * per report.  The Dispatch Queue is kept in the per-thread record (rather than on the stack)
+ * so the reports still on it get cleaned up by event_DestructThread() if a handler causes the
+ * thread to exit.
  */
 //--------------------------------------------------------------------------------------------------
 static void ProcessEventReports
@@ -674,17 +804,95 @@ static void ProcessEventReports
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Read the eventfd to fetch the number of Reports on the Event Queue and reset the count
-    // to zero.
-    uint64_t numReports = ReadEventFd(perThreadRecPtr);
+    ResolvedHandler_t resolvedList[MAX_HANDLERS_RESOLVED_PER_LOCK];
+
+    int oldState = Lock();
 
     // Process only those event reports that are already on the queue.  Anything reported by the
     // event handlers will have to wait until next time ProcessEventReports() is called.
     // This approach ensures that event handlers that re-queue events to the event
     // queue don't cause fd events to be starved.
-    for (; numReports > 0; numReports--)
+    if (!le_sls_IsEmpty(&perThreadRecPtr->eventQueue))
+    {
+        perThreadRecPtr->dispatchQueue = perThreadRecPtr->eventQueue;
+        perThreadRecPtr->eventQueue = LE_SLS_LIST_INIT;
+
+        // The Event Queue is empty now, so reset the eventfd.
+        (void)ReadEventFd(perThreadRecPtr);
+    }
+
+    while (!le_sls_IsEmpty(&perThreadRecPtr->dispatchQueue))
     {
-        ProcessOneEventReport(perThreadRecPtr);
+        // Look up the handlers for the reports at the head of the Dispatch Queue while we have
+        // the Mutex locked.
+        size_t numResolved = 0;
+        le_sls_Link_t* linkPtr = le_sls_Peek(&perThreadRecPtr->dispatchQueue);
+        while ((linkPtr != NULL) && (numResolved < NUM_ARRAY_MEMBERS(resolvedList)))
+        {
+            ResolveHandler(CONTAINER_OF(linkPtr, Report_t, link), &resolvedList[numResolved]);
+            numResolved++;
+
+            linkPtr = le_sls_PeekNext(&perThreadRecPtr->dispatchQueue, linkPtr);
+        }
+
+        // Only this thread changes its own handler change count, so it can be checked
+        // without locking the Mutex.
+        size_t changeCount = perThreadRecPtr->handlerChangeCount;
+
+        Unlock(oldState);  // Unlock the mutex before calling the handler functions.
+
+        size_t i;
+        for (i = 0; i < numResolved; i++)
+        {
+            linkPtr = le_sls_Pop(&perThreadRecPtr->dispatchQueue);
+
+            DispatchReport(perThreadRecPtr,
+                           CONTAINER_OF(linkPtr, Report_t, link),
+                           &resolvedList[i]);
+
+            // If the handler removed or changed any of this thread's handlers, the handlers
+            // looked up for the rest of the group could be stale, so look them up again.
+            if (perThreadRecPtr->handlerChangeCount != changeCount)
+            {
+                break;
+            }
+        }
+
+        oldState = Lock();
+    }
+
+    Unlock(oldState);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discard all the Event Reports on a queue without processing them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DiscardReports
+(
+    le_sls_List_t* queuePtr ///< [in] The queue to be emptied.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* linkPtr;
+
+    while (NULL != (linkPtr = le_sls_Pop(queuePtr)))
+    {
+        Report_t* reportPtr = CONTAINER_OF(linkPtr, Report_t, link);
+
+        // If it is carrying a pointer to a reference-counted object from a memory pool,
+        // release that thing first.
+        if (reportPtr->type == LE_EVENT_REPORT_COUNTED_REF)
+        {
+            PubSubEventReport_t* pubSubReportPtr = CONTAINER_OF(reportPtr,
+                                                                PubSubEventReport_t,
+                                                                baseClass);
+            le_mem_Release(pubSubReportPtr->payload[0]);
+        }
+
+        le_mem_Release(reportPtr);
     }
 }
 
@@ -740,11 +948,9 @@ static void QueueFunction
     reportPtr->param1Ptr = param1Ptr;
     reportPtr->param2Ptr = param2Ptr;
 
-    // Queue it to the Event Queue.
-    le_sls_Queue(&perThreadRecPtr->eventQueue, &reportPtr->baseClass.link);
-
-    // Write to the eventfd to notify the Event Loop that there is something on the queue.
-    WriteEventFd(perThreadRecPtr);
+    // Queue it to the Event Queue.  This notifies the Event Loop if it wasn't already aware that
+    // there is something on the queue.
+    QueueReport(perThreadRecPtr, &reportPtr->baseClass);
 }
 
 
@@ -789,6 +995,7 @@ void event_Init
     /// @todo Make this configurable.
     QueuedFunctionPool = le_mem_CreatePool("QueuedFunction", sizeof(QueuedFunctionReport_t));
     le_mem_ExpandPool(QueuedFunctionPool, DEFAULT_QUEUED_FUNCTION_POOL_SIZE);
+    le_mem_EnableThreadCache(QueuedFunctionPool, REPORT_POOL_THREAD_CACHE_SIZE);
 
     // Create the Handler Pool from which all Handler objects are to be allocated.
     /// @todo Make this configurable.
@@ -839,6 +1046,7 @@ void event_InitThread
 
     // Initialize the various thread-specific lists and queues.
     recPtr->eventQueue = LE_SLS_LIST_INIT;
+    recPtr->dispatchQueue = LE_SLS_LIST_INIT;
     recPtr->handlerList = LE_DLS_LIST_INIT;
     recPtr->fdMonitorList = LE_DLS_LIST_INIT;
 
@@ -856,7 +1064,7 @@ void event_InitThread
     struct epoll_event ev;
     memset(&ev, 0, sizeof(ev));
     ev.events = EPOLLIN | EPOLLWAKEUP;
-    ev.data.ptr = NULL;     // This being set to NULL is what tells the main event loop that this
+    ev.data.u64 = 0;        // This being set to zero is what tells the main event loop that this
                             // is the Event Queue FD, rather than another FD that is being
                             // monitored.
     if (epoll_ctl(recPtr->epollFd, EPOLL_CTL_ADD, recPtr->eventQueueFd, &ev) == -1)
@@ -868,6 +1076,7 @@ void event_InitThread
 
     // Set the context pointer to NULL for safety's sake.
     recPtr->contextPtr = NULL;
+    recPtr->handlerChangeCount = 0;
 
     // Initialize the FD Monitor module's thread-specific stuff.
     fdMon_InitThread(recPtr);
@@ -916,7 +1125,6 @@ void event_DestructThread
 {
     event_PerThreadRec_t* perThreadRecPtr = thread_GetEventRecPtr();
     le_dls_Link_t* doubleLinkPtr;
-    le_sls_Link_t* singleLinkPtr;
 
     // Some other thread could be accessing the Event List or structures under it, and we need
     // to access those to remove all of this thread's Handlers from all Events objects'
@@ -945,23 +1153,10 @@ void event_DestructThread
     // Delete all the FD Monitors for this thread.
     fdMon_DestructThread(perThreadRecPtr);
 
-    // Discard everything on the Event Queue.
-    while (NULL != (singleLinkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue)))
-    {
-        Report_t* reportPtr = CONTAINER_OF(singleLinkPtr, Report_t, link);
-
-        // If it is carrying a pointer to a reference-counted object from a memory pool,
-        // release that thing first.
-        if (reportPtr->type == LE_EVENT_REPORT_COUNTED_REF)
-        {
-            PubSubEventReport_t* pubSubReportPtr = CONTAINER_OF(reportPtr,
-                                                                PubSubEventReport_t,
-                                                                baseClass);
-            le_mem_Release(pubSubReportPtr->payload[0]);
-        }
-
-        le_mem_Release(reportPtr);
-    }
+    // Discard anything left undispatched on the Dispatch Queue (if a handler function caused
+    // the thread to exit) and everything on the Event Queue.
+    DiscardReports(&perThreadRecPtr->dispatchQueue);
+    DiscardReports(&perThreadRecPtr->eventQueue);
 
     // Close the epoll file descriptor.
     fd_Close(perThreadRecPtr->epollFd);
@@ -1221,11 +1416,10 @@ void le_event_Report
         reportObjPtr->handlerRef = handlerPtr->safeRef;
         memset(reportObjPtr->payload, 0, eventPtr->payloadSize);
         memcpy(reportObjPtr->payload, payloadPtr, payloadSize);
-        le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
 
-        // Increment the eventfd for the handler's thread's Event Queue.
-        // This will wake up the thread and tell it that it has something on its Event Queue.
-        WriteEventFd(perThreadRecPtr);
+        // This will wake up the thread and tell it that it has something on its Event Queue,
+        // unless it has already been told.
+        QueueReport(perThreadRecPtr, &reportObjPtr->baseClass);
 
         linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
     }
@@ -1282,11 +1476,10 @@ void le_event_ReportWithRefCounting
         reportObjPtr->handlerRef = handlerPtr->safeRef;
         reportObjPtr->payload[0] = objectPtr;
         le_mem_AddRef(objectPtr);
-        le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
 
-        // Increment the eventfd for the handler's thread's Event Queue.
-        // This will wake up the thread and tell it that it has something on its Event Queue.
-        WriteEventFd(perThreadRecPtr);
+        // This will wake up the thread and tell it that it has something on its Event Queue,
+        // unless it has already been told.
+        QueueReport(perThreadRecPtr, &reportObjPtr->baseClass);
 
         linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
     }
@@ -1323,6 +1516,13 @@ void le_event_SetContextPtr
 
     handlerPtr->contextPtr = contextPtr;
 
+    // If the handler belongs to the calling thread, let its Event Loop know that handlers it has
+    // already looked up may be stale.  (Only the owning thread is allowed to touch the count.)
+    if (handlerPtr->threadRecPtr == thread_GetEventRecPtr())
+    {
+        handlerPtr->threadRecPtr->handlerChangeCount++;
+    }
+
     Unlock(oldState);
 }
 
@@ -1441,25 +1641,32 @@ void le_event_RunLoop
             // Check if someone has cancelled the thread and terminate the thread now, if so.
             pthread_testcancel();
 
-            // For each fd event reported by epoll_wait(), if it is any file descriptor other
-            // than the eventfd (which is used to indicate that there is something on the
-            // Event Queue), queue an Event Report to the Event Queue for that fd.
+            // If the eventfd (which is used to indicate that there is something on the Event
+            // Queue) is one of the fds reported by epoll_wait(), process all the Event Reports on
+            // the Event Queue first, as they were queued before these fd events were reported.
+            // The value registered with epoll_ctl(2) for the eventfd is zero.
             for (i = 0; i < result; i++)
             {
-                // Get the pointer that we registered with epoll_ctl(2) along with this fd.
-                // The value of this pointer will either be NULL or a Safe Reference for an
-                // FD Monitor object.  If it is NULL, then the Event Queue's eventfd is the
-                // fd that experienced the event.
-                void* safeRef = epollEventList[i].data.ptr;
-
-                if (safeRef != NULL)
+                if (epollEventList[i].data.u64 == 0)
                 {
-                    fdMon_Report(safeRef, epollEventList[i].events);
+                    ProcessEventReports(perThreadRecPtr);
+                    break;
                 }
             }
 
-            // Process all the Event Reports on the Event Queue.
-            ProcessEventReports(perThreadRecPtr);
+            // For each fd event reported by epoll_wait() on any other file descriptor, call the
+            // FD Monitor's handler straight away.  The value registered with epoll_ctl(2) for
+            // the fd is a handle that the FD Monitor module can check, in case an earlier
+            // handler in this batch has deleted the FD Monitor.
+            for (i = 0; i < result; i++)
+            {
+                uint64_t handle = epollEventList[i].data.u64;
+
+                if (handle != 0)
+                {
+                    fdMon_Dispatch(perThreadRecPtr, handle, epollEventList[i].events);
+                }
+            }
         }
         // Otherwise, if an epoll_wait() reported an error, hopefully it's just an interruption
         // by a signal (EINTR).  Anything else is a fatal error.
@@ -1548,15 +1755,15 @@ le_result_t le_event_ServiceLoop
         // Event Queue), queue an Event Report to the Event Queue for that fd.
         for (i = 0; i < result; i++)
         {
-            // Get the pointer that we registered with epoll_ctl(2) along with this fd.
-            // The value of this pointer will either be NULL or a Safe Reference for an
-            // FD Monitor object.  If it is NULL, then the Event Queue's eventfd is the
-            // fd that experienced the event, which we will deal with later in this function.
-            void* safeRef = epollEventList[i].data.ptr;
+            // Get the value that we registered with epoll_ctl(2) along with this fd.
+            // This will either be zero or a handle for an FD Monitor object.  If it is zero,
+            // then the Event Queue's eventfd is the fd that experienced the event, which we will
+            // deal with later in this function.
+            uint64_t handle = epollEventList[i].data.u64;
 
-            if (safeRef != NULL)
+            if (handle != 0)
             {
-                fdMon_Report(safeRef, epollEventList[i].events);
+                fdMon_Report(perThreadRecPtr, handle, epollEventList[i].events);
             }
         }
     }
@@ -1584,23 +1791,13 @@ le_result_t le_event_ServiceLoop
         return LE_WOULD_BLOCK;
     }
 
-    // Read the eventfd to reset it to zero so epoll stops telling us about it until more
-    // are added.
-    (void)ReadEventFd(perThreadRecPtr);
+    // If there is something on the Event Queue, process one thing.  This resets the eventfd
+    // if it empties the Event Queue, so epoll stops telling us about it until more are added.
+    ProcessOneEventReport(perThreadRecPtr); // This function assumes the mutex is NOT locked.
 
-    // If there is something on the Event Queue, process one thing.
+    // The caller needs to know if there is more stuff waiting on the Event Queue.
     int oldState = Lock();
 
-    if (!le_sls_IsEmpty(&perThreadRecPtr->eventQueue))
-    {
-        Unlock(oldState);
-
-        ProcessOneEventReport(perThreadRecPtr); // This function assumes the mutex is NOT locked.
-
-        oldState = Lock();
-    }
-
-    // The caller needs to know if there is more stuff waiting on the Event Queue.
     le_result_t returnCode = LE_OK;
     if (le_sls_IsEmpty(&perThreadRecPtr->eventQueue))
     {
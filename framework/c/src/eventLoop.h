@@ -38,6 +38,26 @@ typedef enum
 event_LoopState_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Slot in a thread's FD Monitor Table.
+ *
+ * The FD Monitor module gives epoll(7) a handle made up of a slot's index and generation number
+ * for each fd, so the Event Loop can call the fd's handler straight from the batch of events
+ * returned by epoll_wait().  The generation number changes whenever the slot is freed, so events
+ * that were already reported for a deleted FD Monitor can be recognized and discarded.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void*       monitorPtr;         ///< FD Monitor in this slot, or NULL if the slot is free.
+    uint32_t    generation;         ///< Incremented whenever the slot is freed.
+    uint32_t    nextFreeIndex;      ///< If the slot is free, index of the next free slot + 1
+                                    ///  (0 if this is the last free slot).
+}
+event_FdMonitorSlot_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Event Loop's per-thread record.
@@ -52,11 +72,18 @@ event_LoopState_t;
 typedef struct
 {
     le_sls_List_t       eventQueue;         ///< The thread's event queue.
+    le_sls_List_t       dispatchQueue;      ///< Batch of reports taken off the event queue that
+                                            ///  are waiting to be dispatched by the thread.
     le_dls_List_t       handlerList;        ///< List of handlers registered with this thread.
     le_dls_List_t       fdMonitorList;      ///< List of FD Monitors created by this thread.
+    event_FdMonitorSlot_t* fdMonitorTable;  ///< FD Monitors created by this thread, by slot.
+    uint32_t            fdMonitorTableSize; ///< Number of slots in the FD Monitor Table.
+    uint32_t            fdMonitorFreeIndex; ///< Index of the first free slot + 1 (0 if none).
     int                 epollFd;            ///< epoll(7) file descriptor.
     int                 eventQueueFd;       ///< eventfd(2) file descriptor for the Event Queue.
     void*               contextPtr;         ///< Context pointer from last Handler called.
+    size_t              handlerChangeCount; ///< Incremented whenever this thread removes one of
+                                            ///  its handlers or changes a handler's context.
     event_LoopState_t   state;              ///< Current state of the event loop.
 }
 event_PerThreadRec_t;
@@ -8,14 +8,27 @@
  *
  * FD Monitor objects are allocated from the FD Monitor Pool and are kept on the FD Monitor List.
  *
+ *  - <b> FD Monitor Table </b> - One per thread.  An array of slots, each holding a pointer to
+ *                  one of the thread's FD Monitors (or NULL) and a generation number.
+ *
  * @section fdMonitor_Algorithm     Algorithm
  *
- * When a file descriptor event is detected by the Event Loop, fdMon_Report() is called with
- * the FD Monitor Reference (a safe reference) and a bit map containing the events that were
- * detected.  fdMon_Report() queues a function call (DispatchToHandler()) to the calling thread.
- * When that function gets called, it does a look-up of the safe reference.  If it finds an
- * FD Monitor object matching that reference (it could have been deleted in the meantime), then
- * it calls its registered handler function for that event.
+ * When an FD Monitor is created, it is given a free slot in its thread's FD Monitor Table, and the
+ * slot's index and generation number are combined into a handle that is registered with epoll(7)
+ * along with the fd.  When the FD Monitor is deleted, the slot's generation number is incremented
+ * and the slot is freed.
+ *
+ * When a file descriptor event is detected by the Event Loop, fdMon_Dispatch() is called with
+ * the handle and a bit map containing the events that were detected.  If the handle's slot still
+ * holds an FD Monitor with the same generation number (it could have been deleted by another
+ * handler called for the same batch of events), then its registered handler function is called
+ * straight away.  Only the thread that owns the table ever uses it, so no locking is needed.
+ *
+ * le_event_ServiceLoop() instead calls fdMon_Report(), which looks up the handle in the same way
+ * and queues a function call (DispatchToHandler()) to the calling thread with the FD Monitor
+ * Reference (a safe reference).  When that function gets called, it does a look-up of the safe
+ * reference.  If it finds an FD Monitor object matching that reference (it could have been deleted
+ * in the meantime), then it calls its registered handler function for that event.
  *
  * The reason it was decided not to use Publish-Subscribe Events for this feature is that Event IDs
  * can't be deleted, and yet FD Monitors can.
@@ -32,7 +45,7 @@
  * @section fdMonitor_Threads Threads
  *
  * Only the thread that creates an FD Monitor is allowed to perform operations on that FD Monitor,
- * including deleting the FD Monitor.
+ * including deleting the FD Monitor.  The FD Monitor Table belongs to that thread too.
  *
  * The Safe Reference Map is shared between threads, though, so any access to it must be protected
  * from races.
@@ -58,6 +71,10 @@
 /// @todo Make this configurable.
 #define DEFAULT_FD_MONITOR_POOL_SIZE 10
 
+/// Number of slots in a thread's FD Monitor Table when it is first allocated.  The table doubles
+/// in size whenever it fills up.
+#define MIN_FD_MONITOR_TABLE_SIZE 16
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -86,6 +103,7 @@ typedef struct FdMonitor
     uint32_t                epollEvents;        ///< epoll(7) flags for events being monitored.
     bool                    isAlwaysReady;      ///< Don't use epoll(7).  Treat as always ready.
     le_fdMonitor_Ref_t safeRef;            ///< Safe Reference for this object.
+    uint64_t                handle;             ///< Handle registered with epoll(7) for this fd.
     event_PerThreadRec_t*   threadRecPtr;       ///< Ptr to per-thread data for monitoring thread.
 
     le_fdMonitor_HandlerFunc_t  handlerFunc;    ///< Handler function.
@@ -300,6 +318,108 @@ static const char* GetPollEventsText
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put an FD Monitor into a free slot in its thread's FD Monitor Table, growing the table if it is
+ * full.
+ *
+ * @return The handle to register with epoll(7) for the FD Monitor's fd (never zero).
+ **/
+//--------------------------------------------------------------------------------------------------
+static uint64_t AllocSlot
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Ptr to the calling thread's per-thread record.
+    FdMonitor_t* fdMonitorPtr               ///< [in] The FD Monitor.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (perThreadRecPtr->fdMonitorFreeIndex == 0)
+    {
+        uint32_t oldSize = perThreadRecPtr->fdMonitorTableSize;
+        uint32_t newSize = (oldSize == 0) ? MIN_FD_MONITOR_TABLE_SIZE : (oldSize * 2);
+        uint32_t i;
+
+        perThreadRecPtr->fdMonitorTable = realloc(perThreadRecPtr->fdMonitorTable,
+                                                  newSize * sizeof(event_FdMonitorSlot_t));
+        LE_ASSERT(perThreadRecPtr->fdMonitorTable != NULL);
+
+        // Chain the new slots onto the free list, in order.
+        for (i = oldSize; i < newSize; i++)
+        {
+            perThreadRecPtr->fdMonitorTable[i].monitorPtr = NULL;
+            perThreadRecPtr->fdMonitorTable[i].generation = 0;
+            perThreadRecPtr->fdMonitorTable[i].nextFreeIndex = (i + 1 < newSize) ? (i + 2) : 0;
+        }
+
+        perThreadRecPtr->fdMonitorTableSize = newSize;
+        perThreadRecPtr->fdMonitorFreeIndex = oldSize + 1;
+    }
+
+    uint32_t index = perThreadRecPtr->fdMonitorFreeIndex - 1;
+    event_FdMonitorSlot_t* slotPtr = &perThreadRecPtr->fdMonitorTable[index];
+
+    perThreadRecPtr->fdMonitorFreeIndex = slotPtr->nextFreeIndex;
+    slotPtr->monitorPtr = fdMonitorPtr;
+
+    return ((uint64_t)slotPtr->generation << 32) | (index + 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take an FD Monitor out of its slot in its thread's FD Monitor Table.  The slot gets a new
+ * generation number, so any events already reported with the old handle will be discarded.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void FreeSlot
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Ptr to the calling thread's per-thread record.
+    uint64_t handle                         ///< [in] The FD Monitor's handle.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t index = (uint32_t)handle - 1;
+    event_FdMonitorSlot_t* slotPtr = &perThreadRecPtr->fdMonitorTable[index];
+
+    slotPtr->monitorPtr = NULL;
+    slotPtr->generation++;
+    slotPtr->nextFreeIndex = perThreadRecPtr->fdMonitorFreeIndex;
+    perThreadRecPtr->fdMonitorFreeIndex = index + 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up the FD Monitor for a handle that was registered with epoll(7).
+ *
+ * @return Pointer to the FD Monitor, or NULL if it has been deleted.
+ **/
+//--------------------------------------------------------------------------------------------------
+static FdMonitor_t* LookupHandle
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Ptr to the calling thread's per-thread record.
+    uint64_t handle                         ///< [in] The handle.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t index = (uint32_t)handle - 1;
+
+    if (index >= perThreadRecPtr->fdMonitorTableSize)
+    {
+        return NULL;
+    }
+
+    event_FdMonitorSlot_t* slotPtr = &perThreadRecPtr->fdMonitorTable[index];
+
+    if (slotPtr->generation != (uint32_t)(handle >> 32))
+    {
+        return NULL;
+    }
+
+    return slotPtr->monitorPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Tell epoll(7) to stop monitoring an FD Monitor object's fd.
@@ -362,8 +482,9 @@ static void DeleteFdMonitor
 
     LE_ASSERT(perThreadRecPtr == fdMonitorPtr->threadRecPtr);
 
-    // Remove the FD Monitor from the thread's FD Monitor List.
+    // Remove the FD Monitor from the thread's FD Monitor List and FD Monitor Table.
     le_dls_Remove(&perThreadRecPtr->fdMonitorList, &fdMonitorPtr->link);
+    FreeSlot(perThreadRecPtr, fdMonitorPtr->handle);
 
     LOCK
 
@@ -382,35 +503,44 @@ static void DeleteFdMonitor
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Dispatch an FD Event to the appropriate registered handler function.
+ * Dispatch an FD Event to the appropriate registered handler function (queued function).
  */
 //--------------------------------------------------------------------------------------------------
 static void DispatchToHandler
 (
     void* param1Ptr,    ///< FD Monitor safe reference.
     void* param2Ptr     ///< epoll() event flags.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a call to DispatchToHandler() for an FD Monitor to the calling thread's Event Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueDispatch
+(
+    le_fdMonitor_Ref_t  safeRef,    ///< [in] Safe Reference for the FD Monitor object for the fd.
+    uint32_t    eventFlags          ///< [in] OR'd together epoll(7) event flags.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    uint32_t epollEventFlags = (uint32_t)(size_t)param2Ptr;
-
-    LOCK
-
-    // Get a pointer to the FD Monitor object for this fd.
-    FdMonitor_t* fdMonitorPtr = le_ref_Lookup(FdMonitorRefMap, param1Ptr);
-
-    UNLOCK
-
-    // If the FD Monitor object has been deleted, we can just ignore this.
-    if (fdMonitorPtr == NULL)
-    {
-        TRACE("Discarding events for non-existent FD Monitor %p.", param1Ptr);
-        return;
-    }
+    le_event_QueueFunction(DispatchToHandler, safeRef, (void*)(ssize_t)eventFlags);
+}
 
-    // Sanity check: The FD monitor must belong to the current thread.
-    LE_ASSERT(thread_GetEventRecPtr() == fdMonitorPtr->threadRecPtr);
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call an FD Monitor's registered handler function for a set of FD Events.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CallHandler
+(
+    FdMonitor_t* fdMonitorPtr,  ///< [in] The FD Monitor, which belongs to the calling thread.
+    uint32_t epollEventFlags    ///< [in] epoll() event flags.
+)
+//--------------------------------------------------------------------------------------------------
+{
     // Mask out any events that have been disabled since epoll_wait() reported these events to us.
     epollEventFlags &= (fdMonitorPtr->epollEvents | EPOLLERR | EPOLLHUP | EPOLLRDHUP);
 
@@ -421,7 +551,7 @@ static void DispatchToHandler
         //       we will only end up in here if both POLLIN and POLLOUT are disabled, in which case
         //       returning now will prevent re-queuing of DispatchToHandler(), which is what we
         //       want.  When either POLLIN or POLLOUT are re-enabled, le_fdMonitor_Enable() will
-        //       call fdMon_Report() to get things going again.
+        //       call QueueDispatch() to get things going again.
         return;
     }
 
@@ -460,7 +590,7 @@ static void DispatchToHandler
     // when one of them is re-enabled.
     if ((fdMonitorPtr->isAlwaysReady) && (fdMonitorPtr->epollEvents & (EPOLLIN | EPOLLOUT)))
     {
-        fdMon_Report(fdMonitorPtr->safeRef, fdMonitorPtr->epollEvents & (EPOLLIN | EPOLLOUT));
+        QueueDispatch(fdMonitorPtr->safeRef, fdMonitorPtr->epollEvents & (EPOLLIN | EPOLLOUT));
     }
 
     // Release our reference.  We don't need the Monitor object anymore.
@@ -468,6 +598,41 @@ static void DispatchToHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dispatch an FD Event to the appropriate registered handler function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DispatchToHandler
+(
+    void* param1Ptr,    ///< FD Monitor safe reference.
+    void* param2Ptr     ///< epoll() event flags.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t epollEventFlags = (uint32_t)(size_t)param2Ptr;
+
+    LOCK
+
+    // Get a pointer to the FD Monitor object for this fd.
+    FdMonitor_t* fdMonitorPtr = le_ref_Lookup(FdMonitorRefMap, param1Ptr);
+
+    UNLOCK
+
+    // If the FD Monitor object has been deleted, we can just ignore this.
+    if (fdMonitorPtr == NULL)
+    {
+        TRACE("Discarding events for non-existent FD Monitor %p.", param1Ptr);
+        return;
+    }
+
+    // Sanity check: The FD monitor must belong to the current thread.
+    LE_ASSERT(thread_GetEventRecPtr() == fdMonitorPtr->threadRecPtr);
+
+    CallHandler(fdMonitorPtr, epollEventFlags);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Update the epoll(7) FD for a given FD Monitor object.
@@ -487,7 +652,7 @@ static void UpdateEpollFd
     struct epoll_event ev;
     memset(&ev, 0, sizeof(ev));
     ev.events = monitorPtr->epollEvents;
-    ev.data.ptr = monitorPtr->safeRef;
+    ev.data.u64 = monitorPtr->handle;
 
     int epollFd = monitorPtr->threadRecPtr->epollFd;
 
@@ -563,6 +728,39 @@ void fdMon_InitThread
 //--------------------------------------------------------------------------------------------------
 {
     perThreadRecPtr->fdMonitorList = LE_DLS_LIST_INIT;
+    perThreadRecPtr->fdMonitorTable = NULL;
+    perThreadRecPtr->fdMonitorTableSize = 0;
+    perThreadRecPtr->fdMonitorFreeIndex = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dispatch FD Events.
+ *
+ * This is called by the Event Loop for each event that epoll_wait() reports on a file descriptor
+ * that is being monitored.  It calls the FD Monitor's handler function straight away, unless the
+ * FD Monitor has been deleted since epoll_wait() reported the event.
+ */
+//--------------------------------------------------------------------------------------------------
+void fdMon_Dispatch
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Ptr to the calling thread's per-thread record.
+    uint64_t    handle,         ///< [in] Handle given to epoll(7) for the FD Monitor for the fd.
+    uint32_t    eventFlags      ///< [in] OR'd together event flags from epoll_wait().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    FdMonitor_t* fdMonitorPtr = LookupHandle(perThreadRecPtr, handle);
+
+    // If the FD Monitor object has been deleted, we can just ignore this.
+    if (fdMonitorPtr == NULL)
+    {
+        TRACE("Discarding events for non-existent FD Monitor (handle %" PRIx64 ").", handle);
+        return;
+    }
+
+    CallHandler(fdMonitorPtr, eventFlags);
 }
 
 
@@ -570,18 +768,28 @@ void fdMon_InitThread
 /**
  * Report FD Events.
  *
- * This is called by the Event Loop when it detects events on a file descriptor that is being
- * monitored.
+ * This is called by le_event_ServiceLoop() for each event that epoll_wait() reports on a file
+ * descriptor that is being monitored.  It queues a call to the FD Monitor's handler function to
+ * the calling thread's Event Queue.
  */
 //--------------------------------------------------------------------------------------------------
 void fdMon_Report
 (
-    void*       safeRef,        ///< [in] Safe Reference for the FD Monitor object for the fd.
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Ptr to the calling thread's per-thread record.
+    uint64_t    handle,         ///< [in] Handle given to epoll(7) for the FD Monitor for the fd.
     uint32_t    eventFlags      ///< [in] OR'd together event flags from epoll_wait().
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_event_QueueFunction(DispatchToHandler, safeRef, (void*)(ssize_t)eventFlags);
+    FdMonitor_t* fdMonitorPtr = LookupHandle(perThreadRecPtr, handle);
+
+    if (fdMonitorPtr == NULL)
+    {
+        TRACE("Discarding events for non-existent FD Monitor (handle %" PRIx64 ").", handle);
+        return;
+    }
+
+    QueueDispatch(fdMonitorPtr->safeRef, eventFlags);
 }
 
 
@@ -605,6 +813,11 @@ void fdMon_DestructThread
         FdMonitor_t* fdMonitorPtr = CONTAINER_OF(linkPtr, FdMonitor_t, link);
         DeleteFdMonitor(fdMonitorPtr);
     }
+
+    free(perThreadRecPtr->fdMonitorTable);
+    perThreadRecPtr->fdMonitorTable = NULL;
+    perThreadRecPtr->fdMonitorTableSize = 0;
+    perThreadRecPtr->fdMonitorFreeIndex = 0;
 }
 
 
@@ -677,14 +890,15 @@ le_fdMonitor_Ref_t le_fdMonitor_Create
     // Create a safe reference for the object.
     fdMonitorPtr->safeRef = le_ref_CreateRef(FdMonitorRefMap, fdMonitorPtr);
 
-    // Add it to the thread's FD Monitor list.
+    // Add it to the thread's FD Monitor list and FD Monitor Table.
     le_dls_Queue(&perThreadRecPtr->fdMonitorList, &fdMonitorPtr->link);
+    fdMonitorPtr->handle = AllocSlot(perThreadRecPtr, fdMonitorPtr);
 
     // Tell epoll(7) to start monitoring this fd.
     struct epoll_event ev;
     memset(&ev, 0, sizeof(ev));
     ev.events = fdMonitorPtr->epollEvents;
-    ev.data.ptr = fdMonitorPtr->safeRef;
+    ev.data.u64 = fdMonitorPtr->handle;
     if (epoll_ctl(perThreadRecPtr->epollFd, EPOLL_CTL_ADD, fd, &ev) == -1)
     {
         if (errno == EPERM)
@@ -696,7 +910,7 @@ le_fdMonitor_Ref_t le_fdMonitor_Create
             uint32_t epollEvents = fdMonitorPtr->epollEvents & (EPOLLIN | EPOLLOUT);
             if (epollEvents != 0)
             {
-                fdMon_Report(fdMonitorPtr->safeRef, epollEvents);
+                QueueDispatch(fdMonitorPtr->safeRef, epollEvents);
             }
         }
         else
@@ -775,7 +989,7 @@ void le_fdMonitor_Enable
         if ((handlerMonitorPtr == NULL) || (handlerMonitorPtr->safeRef == monitorRef))
         {
             // Queue up DispatchToHandler() for this fd.
-            fdMon_Report(monitorRef, epollEvents & (EPOLLIN | EPOLLOUT));
+            QueueDispatch(monitorRef, epollEvents & (EPOLLIN | EPOLLOUT));
         }
     }
 
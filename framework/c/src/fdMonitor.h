@@ -53,17 +53,36 @@ void fdMon_InitThread
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dispatch FD Events.
+ *
+ * This is called by the Event Loop for each event that epoll_wait() reports on a file descriptor
+ * that is being monitored.  It calls the FD Monitor's handler function straight away, unless the
+ * FD Monitor has been deleted since epoll_wait() reported the event.
+ */
+//--------------------------------------------------------------------------------------------------
+void fdMon_Dispatch
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Ptr to the calling thread's per-thread record.
+    uint64_t    handle,         ///< [in] Handle given to epoll(7) for the FD Monitor for the fd.
+    uint32_t    eventFlags      ///< [in] OR'd together event flags from epoll_wait().
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Report FD Events.
  *
- * This is called by the Event Loop when it detects events on a file descriptor that is being
- * monitored.
+ * This is called by le_event_ServiceLoop() for each event that epoll_wait() reports on a file
+ * descriptor that is being monitored.  It queues a call to the FD Monitor's handler function to
+ * the calling thread's Event Queue.
  */
 //--------------------------------------------------------------------------------------------------
 void fdMon_Report
 (
-    void*       safeRef,        ///< [in] Safe Reference for the FD Monitor object for the fd.
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Ptr to the calling thread's per-thread record.
+    uint64_t    handle,         ///< [in] Handle given to epoll(7) for the FD Monitor for the fd.
     uint32_t    eventFlags      ///< [in] OR'd together event flags from epoll_wait().
 );
 
@@ -10,6 +10,7 @@
 //--------------------------------------------------------------------------------------------------
 
 #include <sys/sendfile.h>
+#include <linux/fs.h>
 #include "legato.h"
 #include "smack.h"
 #include "fileDescriptor.h"
@@ -373,7 +374,8 @@ static le_result_t StatPath
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Copy a file.
+ * Copy a file.  If the file system supports it, the copy shares the original's data blocks until
+ * one of them is modified (a "reflink").
  *
  * @return - LE_OK if the copy was successful.
  *         - LE_NOT_PERMITTED if either the source or destination paths are not files or could not
@@ -453,6 +455,14 @@ le_result_t file_Copy
     result = LE_OK;
     off_t fileOffset = 0;
 
+#ifdef FICLONE
+    // If the file system supports it, share the source's data blocks (copy-on-write) instead.
+    if (ioctl(writeFd, FICLONE, readFd) == 0)
+    {
+        sizeWritten = sourceStatus.st_size;
+    }
+#endif
+
     while (sizeWritten < sourceStatus.st_size)
     {
         ssize_t nextWritten = sendfile(writeFd,
@@ -480,20 +490,52 @@ le_result_t file_Copy
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Copy a batch of files recursively from one directory into another.
+ * Check whether a path (relative to the top of a tree) is in a list of paths.
  *
- * @return - LE_OK if the copy was successful.
+ * @return true if it is.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsInPathList
+(
+    const char* pathPtr,                ///< [IN] Relative path.
+    const char* const* pathListPtr      ///< [IN] NULL-terminated list of paths (or NULL).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (pathListPtr != NULL)
+    {
+        for (; *pathListPtr != NULL; pathListPtr++)
+        {
+            if (strcmp(pathPtr, *pathListPtr) == 0)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Recreate a directory tree, either copying the files or hard linking to them.
+ *
+ * @return - LE_OK if successful.
  *         - LE_NOT_PERMITTED if either the source or destination paths are not files or could not
  *           be opened.
  *         - LE_IO_ERROR if an IO error occurs during the copy operation.
  *         - LE_NOT_FOUND if source file or the destination directory does not exist.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t file_CopyRecursive
+static le_result_t CopyTree
 (
-    const char* sourcePathPtr,  ///< [IN] Copy recursively from this path...
-    const char* destPathPtr,    ///< [IN] To this path.
-    const char* smackLabelPtr   ///< [IN] If not NULL, the file will have this smack label set.
+    const char* sourcePathPtr,      ///< [IN] Copy recursively from this path...
+    const char* destPathPtr,        ///< [IN] To this path.
+    const char* smackLabelPtr,      ///< [IN] If not NULL, copied files will have this smack label.
+    bool linkFiles,                 ///< [IN] true = hard link to the files instead of copying them.
+    const char* const* copyDirsPtr  ///< [IN] If linking, directories (relative to the source
+                                    ///<      path) to copy the files of anyway.  NULL-terminated.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -546,6 +588,9 @@ le_result_t file_CopyRecursive
     // Iterate through the directory and copy the files to the destination.
     size_t sourcePathLen = strlen(sourcePathPtr);
 
+    // Level in the tree of the directory being copied instead of linked (0 = none).
+    short copyLevel = 0;
+
     char* pathArrayPtr[] = { (char*)sourcePathPtr, NULL };
     FTS* ftsPtr = fts_open(pathArrayPtr, FTS_PHYSICAL, NULL);
 
@@ -579,15 +624,36 @@ le_result_t file_CopyRecursive
                         result = LE_NOT_PERMITTED;
                         goto cleanup;
                     }
+
+                    if (   linkFiles
+                        && (copyLevel == 0)
+                        && IsInPathList(entPtr->fts_path + sourcePathLen + 1, copyDirsPtr))
+                    {
+                        copyLevel = entPtr->fts_level;
+                    }
                 }
                 break;
 
             // Directory visited in reverse order.
             case FTS_DP:
-                // Nothing to do here.
+                if (entPtr->fts_level == copyLevel)
+                {
+                    copyLevel = 0;
+                }
                 break;
 
             case FTS_F:
+                if (linkFiles && (copyLevel == 0))
+                {
+                    if (link(entPtr->fts_path, newPath) == 0)
+                    {
+                        break;
+                    }
+
+                    // Can't link (e.g., on another file system), so copy it instead.
+                    LE_DEBUG("Copying '%s' instead of linking to it (%m).", entPtr->fts_path);
+                }
+
                 result = file_Copy(entPtr->fts_path, newPath, smackLabelPtr);
                 if (result != LE_OK)
                 {
@@ -660,6 +726,58 @@ le_result_t file_CopyRecursive
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy a batch of files recursively from one directory into another.
+ *
+ * @return - LE_OK if the copy was successful.
+ *         - LE_NOT_PERMITTED if either the source or destination paths are not files or could not
+ *           be opened.
+ *         - LE_IO_ERROR if an IO error occurs during the copy operation.
+ *         - LE_NOT_FOUND if source file or the destination directory does not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t file_CopyRecursive
+(
+    const char* sourcePathPtr,  ///< [IN] Copy recursively from this path...
+    const char* destPathPtr,    ///< [IN] To this path.
+    const char* smackLabelPtr   ///< [IN] If not NULL, the file will have this smack label set.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return CopyTree(sourcePathPtr, destPathPtr, smackLabelPtr, false, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Recreate a directory tree in another directory, with hard links to the original files instead
+ * of copies of them.  Directories and symlinks are recreated.  Files that can't be linked to
+ * (e.g., because they are on another file system) are copied.
+ *
+ * Files that get modified in place must not be linked to, or the changes would show up in both
+ * trees, so directories holding such files can be given to have their files copied instead.
+ *
+ * @return - LE_OK if successful.
+ *         - LE_NOT_PERMITTED if either the source or destination paths are not files or could not
+ *           be opened, or if new links or copies could not be created.
+ *         - LE_IO_ERROR if an IO error occurs.
+ *         - LE_NOT_FOUND if source file or the destination directory does not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t file_LinkRecursive
+(
+    const char* sourcePathPtr,      ///< [IN] Recreate the tree at this path...
+    const char* destPathPtr,        ///< [IN] At this path.
+    const char* const* copyDirsPtr  ///< [IN] Directories (relative to the source path) whose files
+                                    ///<      are copied instead.  NULL-terminated, or NULL.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return CopyTree(sourcePathPtr, destPathPtr, NULL, true, copyDirsPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Rename a file or directory.
@@ -126,6 +126,28 @@ le_result_t file_CopyRecursive
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Recreate a directory tree in another directory, with hard links to the original files instead
+ * of copies of them.  Directories and symlinks are recreated.  Files that can't be linked to are
+ * copied, as are the files in the given directories.
+ *
+ * @return - LE_OK if successful.
+ *         - LE_NOT_PERMITTED if either the source or destination paths are not files or could not
+ *           be opened, or if new links or copies could not be created.
+ *         - LE_IO_ERROR if an IO error occurs.
+ *         - LE_NOT_FOUND if source file or the destination directory does not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t file_LinkRecursive
+(
+    const char* sourcePathPtr,      ///< [IN] Recreate the tree at this path...
+    const char* destPathPtr,        ///< [IN] At this path.
+    const char* const* copyDirsPtr  ///< [IN] Directories (relative to the source path) whose files
+                                    ///<      are copied instead.  NULL-terminated, or NULL.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Rename a file or directory.
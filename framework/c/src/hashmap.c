@@ -32,6 +32,41 @@ struct Entry {
     le_dls_Link_t entryListLink;
 };
 
+/**
+ * An entry in the dense entry array of a dynamic (open-addressing) map. Entries are kept in
+ * insertion order; a removed entry has its keyPtr set to NULL until the array is compacted.
+ */
+typedef struct
+{
+    const void* keyPtr;
+    size_t hash;
+    const void* valuePtr;
+}
+DynamicEntry_t;
+
+/**
+ * A slot in the linear-probing index of a dynamic map. The index only holds the position of the
+ * entry and the low bits of its hash, so that probing stays within a few cache lines and most
+ * mismatches are rejected without touching the entry array.
+ */
+typedef struct
+{
+    uint32_t entryIndex;
+    uint32_t hashTag;
+}
+Slot_t;
+
+/**
+ * Value of Slot_t.entryIndex for an unused slot. (All bits set, so a slot array can be emptied
+ * with memset.)
+ */
+#define EMPTY_SLOT UINT32_MAX
+
+/**
+ * Smallest slot count used by a dynamic map.
+ */
+#define MIN_DYNAMIC_SLOT_COUNT 8
+
 /**
  * A hashmap iterator
  */
@@ -59,6 +94,10 @@ typedef struct le_hashmap {
     const char* nameStr;
     HashmapIt_t* iteratorPtr;
     le_log_TraceRef_t traceRef;
+    Slot_t* slotsPtr;            ///< Probing index (bucketCount slots), or NULL if chained map.
+    DynamicEntry_t* entriesPtr;  ///< Dense entry array of a dynamic map.
+    size_t numEntries;           ///< Entries used in entriesPtr, including removed ones.
+    size_t entryCapacity;        ///< Entries that fit before the map must grow (3/4 of slots).
 }
 Hashmap_t;
 
@@ -180,6 +219,371 @@ static inline bool EqualKeys
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the index of the slot that a given hash would ideally occupy in a dynamic map.
+ *
+ * @return  The home slot index.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t HomeSlot
+(
+    Hashmap_t* mapPtr,  ///< [in] The dynamic map.
+    size_t hash         ///< [in] The hash (or its hash tag).
+)
+{
+    return CalculateIndex(mapPtr->bucketCount, (uint32_t)hash);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up the slot holding a key in a dynamic map.
+ *
+ * @return  The slot index, or -1 if the key is not in the map.
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t DynFindSlot
+(
+    Hashmap_t* mapPtr,      ///< [in] The dynamic map.
+    const void* keyPtr,     ///< [in] The key to look for.
+    size_t hash             ///< [in] The hash of the key, from HashKey().
+)
+{
+    size_t mask = mapPtr->bucketCount - 1;
+    size_t i = HomeSlot(mapPtr, hash);
+
+    // The index is never full, so an empty slot always ends the probe sequence.
+    while (mapPtr->slotsPtr[i].entryIndex != EMPTY_SLOT)
+    {
+        if (mapPtr->slotsPtr[i].hashTag == (uint32_t)hash)
+        {
+            DynamicEntry_t* entryPtr = &mapPtr->entriesPtr[mapPtr->slotsPtr[i].entryIndex];
+
+            if (EqualKeys(entryPtr->keyPtr, entryPtr->hash, keyPtr, hash, mapPtr->equalsFuncPtr))
+            {
+                return i;
+            }
+        }
+        i = (i + 1) & mask;
+    }
+
+    return -1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records an entry in the first free slot of its probe sequence. The key must not already be
+ * in the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DynInsertSlot
+(
+    Hashmap_t* mapPtr,      ///< [in] The dynamic map.
+    size_t entryIndex,      ///< [in] Position of the entry in the entry array.
+    size_t hash             ///< [in] The hash of the entry's key.
+)
+{
+    size_t mask = mapPtr->bucketCount - 1;
+    size_t i = HomeSlot(mapPtr, hash);
+
+    while (mapPtr->slotsPtr[i].entryIndex != EMPTY_SLOT)
+    {
+        i = (i + 1) & mask;
+    }
+
+    mapPtr->slotsPtr[i].entryIndex = entryIndex;
+    mapPtr->slotsPtr[i].hashTag = (uint32_t)hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates the slot and entry arrays of a dynamic map for a given slot count. The slots are
+ * all left empty.  Any previous slot array is freed; the entry array is resized in place so
+ * that existing entries are kept.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DynAllocArrays
+(
+    Hashmap_t* mapPtr,      ///< [in] The dynamic map.
+    size_t slotCount        ///< [in] New number of slots (a power of two).
+)
+{
+    LE_ASSERT(slotCount <= ((size_t)EMPTY_SLOT / 2));
+
+    free(mapPtr->slotsPtr);
+    mapPtr->slotsPtr = malloc(slotCount * sizeof(Slot_t));
+    LE_ASSERT(mapPtr->slotsPtr);
+    memset(mapPtr->slotsPtr, 0xFF, slotCount * sizeof(Slot_t));
+
+    mapPtr->bucketCount = slotCount;
+    mapPtr->entryCapacity = slotCount * 3 / 4;
+
+    mapPtr->entriesPtr = realloc(mapPtr->entriesPtr,
+                                 mapPtr->entryCapacity * sizeof(DynamicEntry_t));
+    LE_ASSERT(mapPtr->entriesPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Makes room for at least one more entry in a dynamic map, by squeezing the removed entries out
+ * of the entry array and, if that would not free up enough space, doubling the slot count.
+ * The index is then rebuilt from the compacted entries.
+ *
+ * Entries keep their relative (insertion) order, and the map's iterator is moved along with
+ * its current entry, so an iteration in progress is not disturbed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DynGrow
+(
+    Hashmap_t* mapPtr       ///< [in] The dynamic map.
+)
+{
+    HashmapIt_t* itPtr = mapPtr->iteratorPtr;
+    size_t oldSlotCount = mapPtr->bucketCount;
+    size_t slotCount = oldSlotCount;
+
+    // Only keep the current size if compaction alone gives back at least a quarter of the room.
+    if ((mapPtr->numEntries - mapPtr->size) < (mapPtr->entryCapacity / 4))
+    {
+        slotCount *= 2;
+    }
+
+    // Compact the entries, keeping their order.
+    size_t i;
+    size_t liveCount = 0;
+    int32_t newCurrentIndex = itPtr->currentIndex;
+
+    for (i = 0; i < mapPtr->numEntries; i++)
+    {
+        bool isLive = (mapPtr->entriesPtr[i].keyPtr != NULL);
+
+        if ((int32_t)i == itPtr->currentIndex)
+        {
+            // If the iterator is on a removed entry, park it just before the next live one.
+            newCurrentIndex = (isLive ? (int32_t)liveCount : (int32_t)liveCount - 1);
+        }
+        if (isLive)
+        {
+            mapPtr->entriesPtr[liveCount++] = mapPtr->entriesPtr[i];
+        }
+    }
+    if (itPtr->currentIndex >= (int32_t)mapPtr->numEntries)
+    {
+        newCurrentIndex = (int32_t)liveCount;
+    }
+    itPtr->currentIndex = newCurrentIndex;
+    mapPtr->numEntries = liveCount;
+
+    // Rebuild the index.
+    if (slotCount == oldSlotCount)
+    {
+        memset(mapPtr->slotsPtr, 0xFF, slotCount * sizeof(Slot_t));
+    }
+    else
+    {
+        DynAllocArrays(mapPtr, slotCount);
+    }
+
+    for (i = 0; i < liveCount; i++)
+    {
+        DynInsertSlot(mapPtr, i, mapPtr->entriesPtr[i].hash);
+    }
+
+    HASHMAP_TRACE(
+        mapPtr,
+        "Hashmap %s: Resized from %zu to %zu slots for %zu entries",
+        mapPtr->nameStr,
+        oldSlotCount,
+        slotCount,
+        liveCount
+    );
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds or replaces a key-value pair in a dynamic map.
+ *
+ * @return  NULL for a new entry or a pointer to the old value if it is replaced.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* DynPut
+(
+    Hashmap_t* mapPtr,      ///< [in] The dynamic map.
+    const void* keyPtr,     ///< [in] Pointer to the key to be stored.
+    const void* valuePtr    ///< [in] Pointer to the value to be stored.
+)
+{
+    // A NULL key pointer marks a removed entry.
+    LE_ASSERT(keyPtr != NULL);
+
+    size_t hash = HashKey(mapPtr, keyPtr);
+    ssize_t slot = DynFindSlot(mapPtr, keyPtr, hash);
+
+    if (slot >= 0)
+    {
+        DynamicEntry_t* entryPtr = &mapPtr->entriesPtr[mapPtr->slotsPtr[slot].entryIndex];
+        const void* oldValue = entryPtr->valuePtr;
+        entryPtr->valuePtr = valuePtr;
+
+        HASHMAP_TRACE(
+            mapPtr,
+            "Hashmap %s: Replaced entry in slot %zd. Total map size now %zu",
+            mapPtr->nameStr,
+            slot,
+            mapPtr->size
+        );
+
+        return (void*)oldValue;
+    }
+
+    if (mapPtr->numEntries == mapPtr->entryCapacity)
+    {
+        DynGrow(mapPtr);
+    }
+
+    size_t entryIndex = mapPtr->numEntries++;
+    mapPtr->entriesPtr[entryIndex].keyPtr = keyPtr;
+    mapPtr->entriesPtr[entryIndex].hash = hash;
+    mapPtr->entriesPtr[entryIndex].valuePtr = valuePtr;
+    DynInsertSlot(mapPtr, entryIndex, hash);
+    mapPtr->size++;
+
+    HASHMAP_TRACE(
+        mapPtr,
+        "Hashmap %s: Added entry %zu. Total map size now %zu",
+        mapPtr->nameStr,
+        entryIndex,
+        mapPtr->size
+    );
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up the entry for a key in a dynamic map.
+ *
+ * @return  Pointer to the entry, or NULL if the key is not in the map.
+ */
+//--------------------------------------------------------------------------------------------------
+static DynamicEntry_t* DynGetEntry
+(
+    Hashmap_t* mapPtr,      ///< [in] The dynamic map.
+    const void* keyPtr      ///< [in] Pointer to the key to look for.
+)
+{
+    ssize_t slot = DynFindSlot(mapPtr, keyPtr, HashKey(mapPtr, keyPtr));
+
+    if (slot < 0)
+    {
+        HASHMAP_TRACE(mapPtr, "Hashmap %s: Key not found", mapPtr->nameStr);
+        return NULL;
+    }
+
+    return &mapPtr->entriesPtr[mapPtr->slotsPtr[slot].entryIndex];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a key from a dynamic map. The index is repaired by shifting the rest of the probe
+ * run back (no tombstones), and the entry is marked as removed in the entry array.
+ *
+ * @return  Pointer to the value, or NULL if the key is not in the map.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* DynRemove
+(
+    Hashmap_t* mapPtr,      ///< [in] The dynamic map.
+    const void* keyPtr      ///< [in] Pointer to the key to remove.
+)
+{
+    size_t hash = HashKey(mapPtr, keyPtr);
+    ssize_t slot = DynFindSlot(mapPtr, keyPtr, hash);
+
+    if (slot < 0)
+    {
+        HASHMAP_TRACE(mapPtr, "Hashmap %s: Key not found", mapPtr->nameStr);
+        return NULL;
+    }
+
+    uint32_t entryIndex = mapPtr->slotsPtr[slot].entryIndex;
+    DynamicEntry_t* entryPtr = &mapPtr->entriesPtr[entryIndex];
+    void* value = (void*)(entryPtr->valuePtr);
+
+    entryPtr->keyPtr = NULL;
+    entryPtr->valuePtr = NULL;
+    mapPtr->size--;
+
+    // If the iterator is on this entry, it stays there but can't be read until it is moved.
+    if (mapPtr->iteratorPtr->currentIndex == (int32_t)entryIndex)
+    {
+        mapPtr->iteratorPtr->isValueValid = false;
+    }
+
+    // Backward-shift deletion: pull later members of the probe run into the hole as long as
+    // that doesn't move them in front of their home slot.
+    size_t mask = mapPtr->bucketCount - 1;
+    size_t hole = slot;
+    size_t i = (hole + 1) & mask;
+
+    while (mapPtr->slotsPtr[i].entryIndex != EMPTY_SLOT)
+    {
+        size_t home = HomeSlot(mapPtr, mapPtr->slotsPtr[i].hashTag);
+
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            mapPtr->slotsPtr[hole] = mapPtr->slotsPtr[i];
+            hole = i;
+        }
+        i = (i + 1) & mask;
+    }
+    mapPtr->slotsPtr[hole].entryIndex = EMPTY_SLOT;
+
+    // Drop removed entries off the end of the array straight away, so that a map used as a
+    // stack of recent items doesn't need compacting.  The iterator's own position is kept, so
+    // that an entry added after it will still be reached by le_hashmap_NextNode().
+    while (   (mapPtr->numEntries > 0)
+           && (mapPtr->entriesPtr[mapPtr->numEntries - 1].keyPtr == NULL)
+           && ((int32_t)mapPtr->numEntries - 1 != mapPtr->iteratorPtr->currentIndex))
+    {
+        mapPtr->numEntries--;
+    }
+
+    HASHMAP_TRACE(mapPtr, "Hashmap %s: Removing key from map", mapPtr->nameStr);
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the next live entry of a dynamic map at or after a given position in the entry array.
+ *
+ * @return  The entry index, or numEntries if there is none.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t DynNextLive
+(
+    Hashmap_t* mapPtr,      ///< [in] The dynamic map.
+    size_t index            ///< [in] Position to start searching at.
+)
+{
+    while ((index < mapPtr->numEntries) && (mapPtr->entriesPtr[index].keyPtr == NULL))
+    {
+        index++;
+    }
+
+    return index;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create a HashMap
@@ -205,6 +609,10 @@ le_hashmap_Ref_t le_hashmap_Create
     LE_ASSERT(mapRef);
 
     mapRef->traceRef = NULL;
+    mapRef->slotsPtr = NULL;
+    mapRef->entriesPtr = NULL;
+    mapRef->numEntries = 0;
+    mapRef->entryCapacity = 0;
 
     /**
      * 0.75 load factor. We have more buckets than expected keys as we want
@@ -260,6 +668,55 @@ le_hashmap_Ref_t le_hashmap_Create
     return mapRef;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a HashMap that grows as entries are added.
+ *
+ * The map uses open addressing: entries are stored by value in a single array, in insertion
+ * order, and found through a compact linear-probing index.  When the array fills up, removed
+ * entries are squeezed out and, if that isn't enough, the index doubles in size.
+ *
+ * @return  Returns a reference to the map.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t le_hashmap_CreateDynamic
+(
+    const char*                nameStr,          ///< [in] Name of the HashMap
+    size_t                     initialCapacity,  ///< [in] Number of entries to allocate up front
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
+)
+{
+    LE_ASSERT(hashFunc);
+    LE_ASSERT(equalsFunc);
+
+    // It is ok to use malloc here as we will not be destroying the map
+    le_hashmap_Ref_t mapRef = calloc(1, sizeof(Hashmap_t));
+    LE_ASSERT(mapRef);
+
+    mapRef->iteratorPtr = calloc(1, sizeof(HashmapIt_t));
+    LE_ASSERT(mapRef->iteratorPtr);
+    mapRef->iteratorPtr->theMapPtr = mapRef;
+    mapRef->iteratorPtr->currentIndex = -1;
+    mapRef->iteratorPtr->isValueValid = true;
+
+    // Same 0.75 load factor as the chained maps, but here it is kept as the map grows.
+    size_t slotCount = MIN_DYNAMIC_SLOT_COUNT;
+    while (slotCount * 3 / 4 < initialCapacity)
+    {
+        slotCount <<= 1;
+    }
+    DynAllocArrays(mapRef, slotCount);
+
+    mapRef->hashFuncPtr = hashFunc;
+    mapRef->equalsFuncPtr = equalsFunc;
+    mapRef->nameStr = nameStr;
+
+    return mapRef;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add a key-value pair to a HashMap. If the key already exists in the map then the previous value
@@ -277,6 +734,11 @@ void* le_hashmap_Put
     const void* valuePtr       ///< [in] Pointer to the value to be stored
 )
 {
+    if (mapRef->slotsPtr != NULL)
+    {
+        return DynPut(mapRef, keyPtr, valuePtr);
+    }
+
     size_t hash = HashKey(mapRef, keyPtr);
     size_t index = CalculateIndex(mapRef->bucketCount, hash);
 
@@ -386,6 +848,12 @@ void* le_hashmap_Get
     const void* keyPtr         ///< [in] Pointer to the key to be retrieved
 )
 {
+    if (mapRef->slotsPtr != NULL)
+    {
+        DynamicEntry_t* entryPtr = DynGetEntry(mapRef, keyPtr);
+        return (entryPtr == NULL) ? NULL : (void*)(entryPtr->valuePtr);
+    }
+
     size_t hash = HashKey(mapRef, keyPtr);
     size_t index = CalculateIndex(mapRef->bucketCount, hash);
     HASHMAP_TRACE(
@@ -448,6 +916,12 @@ void* le_hashmap_GetStoredKey
     const void* keyPtr         ///< [in] Pointer to the key to be retrieved.
 )
 {
+    if (mapRef->slotsPtr != NULL)
+    {
+        DynamicEntry_t* entryPtr = DynGetEntry(mapRef, keyPtr);
+        return (entryPtr == NULL) ? NULL : (void*)(entryPtr->keyPtr);
+    }
+
     size_t hash = HashKey(mapRef, keyPtr);
     size_t index = CalculateIndex(mapRef->bucketCount, hash);
     HASHMAP_TRACE(
@@ -513,6 +987,11 @@ void* le_hashmap_Remove
    const void* keyPtr       ///< [in] Pointer to the key to be removed
 )
 {
+    if (mapRef->slotsPtr != NULL)
+    {
+        return DynRemove(mapRef, keyPtr);
+    }
+
     int hash = HashKey(mapRef, keyPtr);
     size_t index = CalculateIndex(mapRef->bucketCount, hash);
 
@@ -617,6 +1096,11 @@ bool le_hashmap_ContainsKey
     const void* keyPtr        ///< [in] Pointer to the key to be searched for
 )
 {
+    if (mapRef->slotsPtr != NULL)
+    {
+        return (DynGetEntry(mapRef, keyPtr) != NULL);
+    }
+
     int hash = HashKey(mapRef, keyPtr);
     size_t index = CalculateIndex(mapRef->bucketCount, hash);
 
@@ -681,6 +1165,17 @@ void le_hashmap_RemoveAll
     mapRef->iteratorPtr->currentLinkPtr = NULL;
     mapRef->iteratorPtr->currentEntryPtr = NULL;
 
+    if (mapRef->slotsPtr != NULL)
+    {
+        // Keep the capacity the map has grown to.
+        memset(mapRef->slotsPtr, 0xFF, mapRef->bucketCount * sizeof(Slot_t));
+        mapRef->numEntries = 0;
+        mapRef->size = 0;
+
+        HASHMAP_TRACE(mapRef, "Hashmap %s: All entries deleted from map", mapRef->nameStr);
+        return;
+    }
+
     uint32_t i;
     for (i = 0; i < mapRef->bucketCount; i++) {
         le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[i]);
@@ -722,6 +1217,21 @@ void le_hashmap_ForEach
     void* context                            ///< [in] Pointer to a context to be supplied to the callback
 )
 {
+    if (mapRef->slotsPtr != NULL)
+    {
+        size_t index;
+        for (index = DynNextLive(mapRef, 0);
+             index < mapRef->numEntries;
+             index = DynNextLive(mapRef, index + 1))
+        {
+            DynamicEntry_t* entryPtr = &mapRef->entriesPtr[index];
+            if (!forEachFn(entryPtr->keyPtr, entryPtr->valuePtr, context)) {
+                return;
+            }
+        }
+        return;
+    }
+
     uint32_t i;
     for (i = 0; i < mapRef->bucketCount; i++) {
         le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[i]);
@@ -786,6 +1296,24 @@ le_result_t le_hashmap_NextNode
         return LE_NOT_FOUND;
     }
 
+    Hashmap_t* mapPtr = iteratorRef->theMapPtr;
+    if (mapPtr->slotsPtr != NULL)
+    {
+        // Walk the entry array in insertion order.  This is unaffected by the map growing, and
+        // reaches entries added after the iterator's current position.
+        size_t index = DynNextLive(mapPtr, iteratorRef->currentIndex + 1);
+
+        if (index < mapPtr->numEntries)
+        {
+            iteratorRef->currentIndex = index;
+            return LE_OK;
+        }
+
+        iteratorRef->currentIndex = mapPtr->numEntries;
+        iteratorRef->isValueValid = false;
+        return LE_NOT_FOUND;
+    }
+
     le_dls_Link_t* theLinkPtr = NULL;
 
     // -1 indicates the iterator is new
@@ -870,6 +1398,29 @@ le_result_t le_hashmap_PrevNode
         return LE_NOT_FOUND;
     }
 
+    Hashmap_t* mapPtr = iteratorRef->theMapPtr;
+    if (mapPtr->slotsPtr != NULL)
+    {
+        int32_t index = iteratorRef->currentIndex - 1;
+
+        if (index >= (int32_t)mapPtr->numEntries)
+        {
+            index = mapPtr->numEntries - 1;
+        }
+        while ((index >= 0) && (mapPtr->entriesPtr[index].keyPtr == NULL))
+        {
+            index--;
+        }
+
+        iteratorRef->currentIndex = index;
+        if (index < 0)
+        {
+            iteratorRef->isValueValid = false;
+            return LE_NOT_FOUND;
+        }
+        return LE_OK;
+    }
+
     le_dls_Link_t* theLinkPtr = le_dls_PeekPrev(iteratorRef->currentListPtr,
                                                 iteratorRef->currentLinkPtr);
 
@@ -937,6 +1488,11 @@ void const * le_hashmap_GetKey
 {
     if (!iteratorRef->isValueValid || (iteratorRef->currentIndex == -1)) return NULL;
 
+    if (iteratorRef->theMapPtr->slotsPtr != NULL)
+    {
+        return iteratorRef->theMapPtr->entriesPtr[iteratorRef->currentIndex].keyPtr;
+    }
+
     return iteratorRef->currentEntryPtr->keyPtr;
 }
 
@@ -955,6 +1511,11 @@ void const * le_hashmap_GetValue
 {
     if (!iteratorRef->isValueValid || (iteratorRef->currentIndex == -1)) return NULL;
 
+    if (iteratorRef->theMapPtr->slotsPtr != NULL)
+    {
+        return iteratorRef->theMapPtr->entriesPtr[iteratorRef->currentIndex].valuePtr;
+    }
+
     return iteratorRef->currentEntryPtr->valuePtr;
 }
 
@@ -991,6 +1552,17 @@ le_result_t le_hashmap_GetFirstNode
         return LE_BAD_PARAMETER;
     }
 
+    if (mapRef->slotsPtr != NULL)
+    {
+        DynamicEntry_t* entryPtr = &mapRef->entriesPtr[DynNextLive(mapRef, 0)];
+        *firstKeyPtr = (void *)entryPtr->keyPtr;
+        if (NULL != firstValuePtr)
+        {
+            *firstValuePtr = (void *)entryPtr->valuePtr;
+        }
+        return LE_OK;
+    }
+
     // Find the first list head
     size_t index = 0;
     for (
@@ -1044,6 +1616,28 @@ le_result_t le_hashmap_GetNodeAfter
         return LE_BAD_PARAMETER;
     }
 
+    if (mapRef->slotsPtr != NULL)
+    {
+        DynamicEntry_t* entryPtr = DynGetEntry(mapRef, keyPtr);
+        if (entryPtr == NULL)
+        {
+            return LE_BAD_PARAMETER;
+        }
+
+        size_t index = DynNextLive(mapRef, (entryPtr - mapRef->entriesPtr) + 1);
+        if (index >= mapRef->numEntries)
+        {
+            return LE_NOT_FOUND;
+        }
+
+        *nextKeyPtr = (void *)mapRef->entriesPtr[index].keyPtr;
+        if (NULL != nextValuePtr)
+        {
+            *nextValuePtr = (void *)mapRef->entriesPtr[index].valuePtr;
+        }
+        return LE_OK;
+    }
+
     // Find the node pointed to by the key
     size_t hash = HashKey(mapRef, keyPtr);
     size_t index = CalculateIndex(mapRef->bucketCount, hash);
@@ -1141,6 +1735,21 @@ size_t le_hashmap_CountCollisions
 )
 {
     size_t i, collCount = 0;
+
+    // For a dynamic map, count the entries that had to be stored away from their home slot.
+    if (mapRef->slotsPtr != NULL)
+    {
+        for (i = 0; i < mapRef->bucketCount; i++)
+        {
+            if (   (mapRef->slotsPtr[i].entryIndex != EMPTY_SLOT)
+                && (HomeSlot(mapRef, mapRef->slotsPtr[i].hashTag) != i))
+            {
+                collCount++;
+            }
+        }
+        return collCount;
+    }
+
     for (i = 0; i < mapRef->bucketCount; i++) {
         if (mapRef->chainLengthPtr[i] > 1) {
             collCount += mapRef->chainLengthPtr[i] - 1;
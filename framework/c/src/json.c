@@ -13,6 +13,9 @@
 /// including the null terminator.
 #define MAX_STRING_BYTES 1024
 
+/// Maximum number of bytes read from the file descriptor at a time (when reading ahead is allowed).
+#define READ_BUFFER_BYTES LE_JSON_STREAM_BUFFER_BYTES
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -54,9 +57,19 @@ typedef struct le_json_ParsingSession
     size_t numBytes;                ///< # of bytes of content in the buffer.
     double number;                  ///< Value of last number parsed.
 
-    int fd;                         ///< File descriptor to read the JSON document from.
+    int fd;                         ///< File descriptor to read the JSON document from
+                                    ///  (-1 if parsing a buffer).
     le_fdMonitor_Ref_t fdMonitor;   ///< File Descriptor Monitor used to monitor the fd.
-    size_t bytesRead;               ///< # of bytes read from the file descriptor.
+    bool canReadAhead;              ///< true = fd can be read more than one byte at a time.
+    bool keepsUnparsed;             ///< true = data read past where parsing stops is kept for
+                                    ///  le_json_GetUnparsedData(), not sought back over.
+    bool isBufferQueued;            ///< true = waiting for ParseBufferData() or ParseStreamData()
+                                    ///  to be called.
+    char readBuffer[READ_BUFFER_BYTES]; ///< Buffer into which data is read from the fd.
+    const char* dataPtr;            ///< Data waiting to be parsed (readBuffer or client's buffer).
+    size_t dataSize;                ///< # of bytes of data at dataPtr.
+    size_t dataPos;                 ///< # of bytes at dataPtr that have been parsed.
+    size_t bytesRead;               ///< # of bytes of the document parsed so far.
     size_t line;                    ///< Line number of the JSON document (starts at 1).
 
     le_json_ErrorHandler_t errorHandler; ///< Function to call when errors happen.
@@ -130,8 +143,34 @@ static void StopParsing
     if (NotStopped(parserPtr))
     {
         parserPtr->next = EXPECT_NOTHING;
-        le_fdMonitor_Delete(parserPtr->fdMonitor);
-        parserPtr->fdMonitor = NULL;
+
+        if (parserPtr->fdMonitor != NULL)
+        {
+            le_fdMonitor_Delete(parserPtr->fdMonitor);
+            parserPtr->fdMonitor = NULL;
+        }
+
+        if (parserPtr->keepsUnparsed)
+        {
+            // Leave anything that was read past the point where parsing stopped for the client.
+            return;
+        }
+
+        if (parserPtr->fd != -1)
+        {
+            // Put back anything that was read past the point where parsing stopped, so the file
+            // position is left just after the last byte parsed, the same as it would be if the
+            // document had been read one byte at a time.
+            size_t unparsedBytes = parserPtr->dataSize - parserPtr->dataPos;
+            if (   (unparsedBytes > 0)
+                && (lseek(parserPtr->fd, -(off_t)unparsedBytes, SEEK_CUR) == -1) )
+            {
+                LE_WARN("Failed to seek back over %zu unparsed bytes (%m).", unparsedBytes);
+            }
+        }
+
+        parserPtr->dataSize = 0;
+        parserPtr->dataPos = 0;
     }
 }
 
@@ -613,7 +652,7 @@ static void ParseString
     if (c == '"')
     {
         // It's not string terminating if it is escaped.
-        if ((parserPtr->bytesRead == 0) || (parserPtr->buffer[parserPtr->bytesRead - 1] != '\\'))
+        if ((parserPtr->numBytes == 0) || (parserPtr->buffer[parserPtr->numBytes - 1] != '\\'))
         {
             // Make we have a valid UTF-8 string.
             if (!le_utf8_IsFormatCorrect(parserPtr->buffer))
@@ -851,6 +890,34 @@ static void ProcessChar
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Processes the data waiting to be parsed until it has all been parsed or parsing stops.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessData
+(
+    Parser_t* parserPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (NotStopped(parserPtr) && (parserPtr->dataPos < parserPtr->dataSize))
+    {
+        char c = parserPtr->dataPtr[parserPtr->dataPos];
+
+        // Count the byte as parsed before processing it, so that if parsing stops during
+        // processing, StopParsing() knows this byte was used.
+        parserPtr->dataPos++;
+        parserPtr->bytesRead++;
+        if (c == '\n')
+        {
+            parserPtr->line++;
+        }
+        ProcessChar(parserPtr, c);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Read data from the JSON document file descriptor and process it.
@@ -863,13 +930,22 @@ static void ReadData
 )
 //--------------------------------------------------------------------------------------------------
 {
+    // If the fd is a file, or the client fetches what's left over with le_json_GetUnparsedData(),
+    // read as much as will fit in the buffer, because anything left unparsed isn't lost.
+    // Otherwise, whatever follows the document (e.g., an update pack's payload) could be lost, so
+    // only one byte can be read at a time.
+    size_t bytesToRead = (parserPtr->canReadAhead ? sizeof(parserPtr->readBuffer) : 1);
+
+    // Finish off any data that's already in the buffer (given to le_json_ParseStream()) before
+    // reading over it.
+    ProcessData(parserPtr);
+
     while (NotStopped(parserPtr))
     {
-        char c;
         ssize_t bytesRead;
         do
         {
-            bytesRead = read(fd, &c, 1);
+            bytesRead = read(fd, parserPtr->readBuffer, bytesToRead);
         }
         while ((bytesRead == -1) && (errno == EINTR));
 
@@ -914,17 +990,93 @@ static void ReadData
         }
         else
         {
-            parserPtr->bytesRead++;
-            if (c == '\n')
-            {
-                parserPtr->line++;
-            }
-            ProcessChar(parserPtr, c);
+            parserPtr->dataSize = bytesRead;
+            parserPtr->dataPos = 0;
+            ProcessData(parserPtr);
         }
     }
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function queued to the Event Loop by le_json_ParseBuffer() to parse the client's buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ParseBufferData
+(
+    void* param1Ptr,    ///< Pointer to the Parser object.
+    void* param2Ptr     ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Parser_t* parserPtr = param1Ptr;
+
+    parserPtr->isBufferQueued = false;
+
+    // If the client called le_json_Cleanup() before this got a chance to run, releasing the
+    // client's reference to the parser object was left to us.
+    if (!NotStopped(parserPtr))
+    {
+        le_mem_Release(parserPtr);
+        return;
+    }
+
+    // Increment the reference count on the Parser object so it won't go away until we are done
+    // with it, even if the client calls le_json_Cleanup() for this parser.
+    le_mem_AddRef(parserPtr);
+
+    ProcessData(parserPtr);
+
+    if (NotStopped(parserPtr))
+    {
+        // The document has been truncated.
+        Error(parserPtr, LE_JSON_READ_ERROR, "Unexpected end of buffer.");
+    }
+
+    // We are finished with the parser object now.
+    le_mem_Release(parserPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function queued to the Event Loop by le_json_ParseStream() to parse the data it was given, in
+ * case the file descriptor doesn't become readable until that data has been parsed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ParseStreamData
+(
+    void* param1Ptr,    ///< Pointer to the Parser object.
+    void* param2Ptr     ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Parser_t* parserPtr = param1Ptr;
+
+    parserPtr->isBufferQueued = false;
+
+    // If the client called le_json_Cleanup() before this got a chance to run, releasing the
+    // client's reference to the parser object was left to us.
+    if (!NotStopped(parserPtr))
+    {
+        le_mem_Release(parserPtr);
+        return;
+    }
+
+    // Increment the reference count on the Parser object so it won't go away until we are done
+    // with it, even if the client calls le_json_Cleanup() for this parser.
+    le_mem_AddRef(parserPtr);
+
+    // If the fd was read first, this has already been done.  Otherwise, the rest of the document
+    // is read when the fd becomes readable.
+    ProcessData(parserPtr);
+
+    // We are finished with the parser object now.
+    le_mem_Release(parserPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Event handler that gets called when an event occurs on a monitored file descriptor.
@@ -975,29 +1127,33 @@ static void FdEventHandler
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Parse a JSON document received via a file descriptor.
+ * Creates a Parser object with the members that don't depend on where the document comes from
+ * initialized.
  *
- * @return Reference to the JSON parsing session started by this function call.
+ * @return Pointer to the Parser object.
  */
 //--------------------------------------------------------------------------------------------------
-le_json_ParsingSessionRef_t le_json_Parse
+static Parser_t* CreateParser
 (
-    int fd, ///< File descriptor to read the JSON document from.
     le_json_EventHandler_t  eventHandler,   ///< Function to call when normal parsing events happen.
     le_json_ErrorHandler_t  errorHandler,   ///< Function to call when errors happen.
     void* opaquePtr   ///< Opaque pointer to be fetched by handlers using le_json_GetOpaquePtr().
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Create a Parser.
     Parser_t* parserPtr = le_mem_ForceAlloc(ParserPool);
 
     parserPtr->next = EXPECT_OBJECT_OR_ARRAY;
     parserPtr->numBytes = 0;
 
-    parserPtr->fd = fd;
-    parserPtr->fdMonitor = le_fdMonitor_Create("le_json", fd, FdEventHandler, POLLIN);
-    le_fdMonitor_SetContextPtr(parserPtr->fdMonitor, parserPtr);
+    parserPtr->fd = -1;
+    parserPtr->fdMonitor = NULL;
+    parserPtr->canReadAhead = false;
+    parserPtr->keepsUnparsed = false;
+    parserPtr->isBufferQueued = false;
+    parserPtr->dataPtr = parserPtr->readBuffer;
+    parserPtr->dataSize = 0;
+    parserPtr->dataPos = 0;
     parserPtr->bytesRead = 0;
     parserPtr->line = 1;
 
@@ -1016,6 +1172,147 @@ le_json_ParsingSessionRef_t le_json_Parse
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a JSON document received via a file descriptor.
+ *
+ * @return Reference to the JSON parsing session started by this function call.
+ */
+//--------------------------------------------------------------------------------------------------
+le_json_ParsingSessionRef_t le_json_Parse
+(
+    int fd, ///< File descriptor to read the JSON document from.
+    le_json_EventHandler_t  eventHandler,   ///< Function to call when normal parsing events happen.
+    le_json_ErrorHandler_t  errorHandler,   ///< Function to call when errors happen.
+    void* opaquePtr   ///< Opaque pointer to be fetched by handlers using le_json_GetOpaquePtr().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Parser_t* parserPtr = CreateParser(eventHandler, errorHandler, opaquePtr);
+
+    // Only regular files and block devices can be sought back on after reading too far.
+    struct stat st;
+    parserPtr->canReadAhead = (   (fstat(fd, &st) == 0)
+                               && (S_ISREG(st.st_mode) || S_ISBLK(st.st_mode)) );
+
+    parserPtr->fd = fd;
+    parserPtr->fdMonitor = le_fdMonitor_Create("le_json", fd, FdEventHandler, POLLIN);
+    le_fdMonitor_SetContextPtr(parserPtr->fdMonitor, parserPtr);
+
+    return parserPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a JSON document that is already in memory.
+ *
+ * @return Reference to the JSON parsing session started by this function call.
+ */
+//--------------------------------------------------------------------------------------------------
+le_json_ParsingSessionRef_t le_json_ParseBuffer
+(
+    const void* bufferPtr,  ///< The JSON document.  Must remain valid until parsing stops.
+    size_t bufferSize,      ///< Size of the JSON document, in bytes.
+    le_json_EventHandler_t  eventHandler,   ///< Function to call when normal parsing events happen.
+    le_json_ErrorHandler_t  errorHandler,   ///< Function to call when errors happen.
+    void* opaquePtr   ///< Opaque pointer to be fetched by handlers using le_json_GetOpaquePtr().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Parser_t* parserPtr = CreateParser(eventHandler, errorHandler, opaquePtr);
+
+    parserPtr->dataPtr = bufferPtr;
+    parserPtr->dataSize = bufferSize;
+
+    // Parse from the Event Loop, the same as for a file descriptor, so the handlers are never
+    // called before the client has the session reference.
+    parserPtr->isBufferQueued = true;
+    le_event_QueueFunction(ParseBufferData, parserPtr, NULL);
+
+    return parserPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a JSON document received via a file descriptor, reading ahead in blocks whatever type of
+ * file descriptor it is.  Anything read past the end of the document can be fetched with
+ * le_json_GetUnparsedData().
+ *
+ * @return Reference to the JSON parsing session started by this function call.
+ *
+ * @note If more than LE_JSON_STREAM_BUFFER_BYTES of data is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+le_json_ParsingSessionRef_t le_json_ParseStream
+(
+    int fd, ///< File descriptor to read the JSON document from.
+    const void* dataPtr,    ///< Data already read from the fd, to be parsed first (can be NULL).
+    size_t dataSize,        ///< Number of bytes of data at dataPtr.
+    le_json_EventHandler_t  eventHandler,   ///< Function to call when normal parsing events happen.
+    le_json_ErrorHandler_t  errorHandler,   ///< Function to call when errors happen.
+    void* opaquePtr   ///< Opaque pointer to be fetched by handlers using le_json_GetOpaquePtr().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_FATAL_IF(dataSize > READ_BUFFER_BYTES,
+                "%zu bytes of data given to JSON parser (max %d).",
+                dataSize,
+                READ_BUFFER_BYTES);
+
+    Parser_t* parserPtr = CreateParser(eventHandler, errorHandler, opaquePtr);
+
+    parserPtr->canReadAhead = true;
+    parserPtr->keepsUnparsed = true;
+
+    parserPtr->fd = fd;
+    parserPtr->fdMonitor = le_fdMonitor_Create("le_json", fd, FdEventHandler, POLLIN);
+    le_fdMonitor_SetContextPtr(parserPtr->fdMonitor, parserPtr);
+
+    if (dataSize > 0)
+    {
+        memcpy(parserPtr->readBuffer, dataPtr, dataSize);
+        parserPtr->dataSize = dataSize;
+
+        parserPtr->isBufferQueued = true;
+        le_event_QueueFunction(ParseStreamData, parserPtr, NULL);
+    }
+
+    return parserPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the data that a session started by le_json_ParseStream() read from its file descriptor but
+ * didn't parse, because parsing stopped (at the end of the document, or on an error).
+ *
+ * Can be called from inside the session's own event or error handlers.
+ *
+ * @return Pointer to the unparsed data, valid until le_json_Cleanup() is called.  (Always no data
+ *         for sessions that weren't started by le_json_ParseStream(), or that are still parsing.)
+ */
+//--------------------------------------------------------------------------------------------------
+const void* le_json_GetUnparsedData
+(
+    le_json_ParsingSessionRef_t session,    ///< Parsing session.
+    size_t* sizePtr                         ///< [OUT] Number of bytes of unparsed data.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (NotStopped(session) || !session->keepsUnparsed)
+    {
+        *sizePtr = 0;
+        return NULL;
+    }
+
+    *sizePtr = session->dataSize - session->dataPos;
+
+    return session->dataPtr + session->dataPos;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Stops parsing and cleans up memory allocated by the parser.
@@ -1031,8 +1328,12 @@ void le_json_Cleanup
 {
     StopParsing(session);
 
-    // Release the client's reference to the parser object.
-    le_mem_Release(session);
+    // Release the client's reference to the parser object, unless a buffer is still waiting to be
+    // parsed, in which case ParseBufferData() will release it when it runs.
+    if (!session->isBufferQueued)
+    {
+        le_mem_Release(session);
+    }
 }
 
 
@@ -1302,7 +1603,7 @@ const char* le_json_GetContextName
 
 //--------------------------------------------------------------------------------------------------
 /**
- * @return The number of bytes that have been read from the input stream so far.
+ * @return The number of bytes of the JSON document that have been parsed so far.
  */
 //--------------------------------------------------------------------------------------------------
 size_t le_json_GetBytesRead
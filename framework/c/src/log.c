@@ -8,6 +8,7 @@
  */
 
 #include "legato.h"
+#include <linux/futex.h>
 #include "log.h"
 #include "logDaemon/logDaemon.h"
 #include "limit.h"
@@ -180,6 +181,184 @@ static inline void Unlock
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the asynchronous log record ring, in bytes.  Must be a power of two.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ASYNC_RING_BYTES        65536
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Most bytes of captured arguments a single asynchronous log record can carry.  Messages whose
+ * arguments don't fit are logged synchronously instead.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ASYNC_MAX_ARG_BYTES     512
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Longest conversion specification (e.g., "%-08.3lld") that can be logged asynchronously.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ASYNC_MAX_SPEC_LEN      16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flag set in a record's commit word when the record is only padding up to the end of the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECORD_PADDING          0x80000000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Types of argument that can be captured from a log message's variable argument list.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    ARG_NONE,           ///< Conversion without an argument (%m).
+    ARG_INT,
+    ARG_LONG,
+    ARG_LONG_LONG,
+    ARG_INTMAX,
+    ARG_SIZE,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,
+    ARG_LONG_DOUBLE,
+    ARG_POINTER,
+    ARG_STRING          ///< Copied into the record as a 16-bit length, the bytes and a null char.
+}
+ArgType_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A parsed printf conversion specification.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    ArgType_t   type;           ///< Type of the converted argument.
+    int         numStars;       ///< Number of int arguments given for width and precision ('*').
+    bool        precisionStar;  ///< true if the precision is given by the last '*' argument.
+    int         precision;      ///< Precision, or -1 if none (filled in from its argument if '*').
+    const char* endPtr;         ///< The character after the conversion specifier.
+}
+ConvSpec_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of a log record in the asynchronous ring.  It is followed by the thread name (including
+ * its null terminator) and then the captured arguments.
+ *
+ * Everything the writer thread needs that can change or disappear after the logging call returns
+ * (thread name, strings, errno) is copied into the record.  The format string, file name, function
+ * name, session and trace keyword must all stay valid until the record has been written (see
+ * @ref c_log_control_env_async), so only their pointers are kept.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t            commit;             ///< Record size once it is complete, 0 until then.
+                                            ///  RECORD_PADDING is set for padding records.
+    uint16_t            argBytes;           ///< Number of bytes of captured arguments.
+    uint8_t             threadNameBytes;    ///< Size of the thread name, including the null char.
+    int                 savedErrno;         ///< errno at the time of the call (for %m).
+    le_log_Level_t      level;              ///< Severity level, or -1 for a trace.
+    unsigned int        lineNumber;         ///< Line number that logged the message.
+    time_t              timestamp;          ///< When the message was logged.
+    le_log_TraceRef_t   traceRef;           ///< Trace reference, or NULL if not a trace.
+    Session_t*          sessionPtr;         ///< Log session.
+    const char*         filenamePtr;        ///< Source file that logged the message.
+    const char*         functionNamePtr;    ///< Function that logged the message.
+    const char*         formatPtr;          ///< The user message format.
+}
+AsyncRecord_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * true if messages below CRITICAL are handed to the writer thread instead of being formatted and
+ * written by the caller.  Set from the LE_LOG_ASYNC environment variable at start-up.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AsyncEnabled = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The asynchronous log record ring.  NULL if asynchronous logging is not in use.
+ *
+ * Producers (logging threads) reserve space by advancing RingHead with a compare-and-swap, fill in
+ * their record and then set its commit word.  The writer thread consumes complete records in
+ * order from RingTail, zeroing each one before advancing RingTail, so that free space always
+ * reads as zero and an unwritten record can be recognized by its commit word.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* RingPtr;
+static uint64_t RingHead;   ///< Total bytes ever reserved by producers.
+static uint64_t RingTail;   ///< Total bytes ever consumed by the writer.
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages discarded because the ring was full.  Reported by the writer.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t DroppedCount;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * How long the writer thread lets records accumulate after being woken up, so that it runs once
+ * per batch of messages rather than once per message.  It is woken early if the ring gets half
+ * full.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ASYNC_BATCH_NSEC        5000000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * States of the writer thread, kept in the WriterWaiting futex word.
+ */
+//--------------------------------------------------------------------------------------------------
+#define WRITER_RUNNING          0   ///< Draining the ring.
+#define WRITER_IDLE             1   ///< Asleep until the next record.
+#define WRITER_BATCHING         2   ///< Asleep until the batch time is up or the ring is half full.
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Futex word holding the state of the writer thread (WRITER_RUNNING, etc.).
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t WriterWaiting;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * true once the writer thread has been started (it is started by the first asynchronous message).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool WriterStarted;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Serializes consumers of the ring: the writer thread and threads flushing it before logging
+ * synchronously.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t DrainMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a new Keyword Object for a given session.
@@ -443,6 +622,38 @@ static void ReadLevelFromEnv
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables asynchronous logging if the environment asks for it.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ReadAsyncFromEnv
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* envStrPtr = getenv("LE_LOG_ASYNC");
+
+    if ((envStrPtr == NULL) || (strcmp(envStrPtr, "0") == 0))
+    {
+        return;
+    }
+
+    if (strcmp(envStrPtr, "1") != 0)
+    {
+        LE_ERROR("LE_LOG_ASYNC environment variable has invalid value '%s'.", envStrPtr);
+        return;
+    }
+
+    // The ring must start out zeroed (see RingPtr).
+    RingPtr = calloc(1, ASYNC_RING_BYTES);
+    LE_ASSERT(RingPtr != NULL);
+
+    AsyncEnabled = true;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Loads the default list of enabled trace keywords from the environment, if present.
@@ -751,6 +962,7 @@ void log_Init
 
     // Load the default log level filter and output destination settings from the environment.
     ReadLevelFromEnv();
+    ReadAsyncFromEnv();
 
     // Create the keyword memory pool.
     KeywordMemPool = le_mem_CreatePool("TraceKeys", sizeof(KeywordObj_t));
@@ -1019,67 +1231,54 @@ static int ConvertToSyslogLevel
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Builds the log message and sends it to the logging system.
+ * Gets the string that identifies a message's level in the log: the severity level string, or
+ * the trace keyword for a trace message.
  */
 //--------------------------------------------------------------------------------------------------
-void _le_log_Send
+static const char* GetLevelStr
 (
-    const le_log_Level_t level,         // The severity level. Set to -1 if this is a Trace log.
-    const le_log_TraceRef_t traceRef,   // The Trace reference. Set to NULL if this is not a Trace log.
-    le_log_SessionRef_t logSession,     // The log session.
-    const char* filenamePtr,            // The name of the source file that logged the message.
-    const char* functionNamePtr,        // The name of the function that logged the message.
-    const unsigned int lineNumber,      // The line number in the source file that logged the message.
-    const char* formatPtr, ...          // The user message format and options.
+    le_log_Level_t level,               ///< [IN] The severity level, or -1 for a trace.
+    le_log_TraceRef_t traceRef          ///< [IN] The trace reference, or NULL if not a trace.
 )
 {
-    // Save the current errno to be used in the log message because some of the system calls below
-    // may change errno.
-    int savedErrno = errno;
-
-    // If the logging function was called from code that doesn't have a log session reference,
-    if (logSession == NULL)
-    {
-        // Use the default log session.
-        logSession = &DefaultLogSession;
-
-        // Check that the message's log level is actually higher than the default filtering
-        // level, since the logging macros probably weren't provided with a valid pointer
-        // to a filtering level.
-        if ((level < logSession->level) && (level != (le_log_Level_t)-1))
-        {
-            return;
-        }
-    }
-
-    // Get either the log level or the trace keyword.
-    const char* levelPtr;
-
     if ( (level <= LOG_DEBUG) && (level >= LOG_EMERG) )
     {
         // Use the severity level.
-        levelPtr = SeverityStr[level];
+        return SeverityStr[level];
     }
-    else
-    {
-        // NOTE: The reference is actually a pointer to the isEnabled flag inside the
-        //       keyword object.
-        KeywordObj_t* keywordObjPtr = CONTAINER_OF(traceRef, KeywordObj_t, isEnabled);
 
-        // Add the trace keyword.
-        levelPtr = keywordObjPtr->keyword;
-    }
+    // NOTE: The reference is actually a pointer to the isEnabled flag inside the
+    //       keyword object.
+    KeywordObj_t* keywordObjPtr = CONTAINER_OF(traceRef, KeywordObj_t, isEnabled);
 
-    // Get the component name.
-    // NOTE: The component name won't change, so it's safe to read this without locking the mutex.
-    const char* compNamePtr = logSession->componentNamePtr;
+    // Use the trace keyword.
+    return keywordObjPtr->keyword;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a formatted user message, with its header, to the log.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteMsg
+(
+    le_log_Level_t level,               ///< [IN] The severity level, or -1 for a trace.
+    le_log_TraceRef_t traceRef,         ///< [IN] The trace reference, or NULL if not a trace.
+    const char* compNamePtr,            ///< [IN] Component name.
+    const char* threadNamePtr,          ///< [IN] Name of the thread that logged the message.
+    const char* filenamePtr,            ///< [IN] Source file that logged the message.
+    const char* functionNamePtr,        ///< [IN] Function that logged the message.
+    unsigned int lineNumber,            ///< [IN] Line number that logged the message.
+    time_t timestamp,                   ///< [IN] When the message was logged.
+    const char* msgPtr                  ///< [IN] The user message.
+)
+{
+    const char* levelPtr = GetLevelStr(level, traceRef);
 
     // Get the file name.
     char* baseFileNamePtr = le_path_GetBasenamePtr((char*)filenamePtr, "/");
 
-    // Get the thread name.
-    const char* threadNamePtr = le_thread_GetMyName();
-
     // Get the process name.
     const char* procNamePtr = le_arg_GetProgramName();
     if (procNamePtr == NULL)
@@ -1087,36 +1286,22 @@ void _le_log_Send
         procNamePtr = "n/a";
     }
 
-    // Get the user message.
-    char msg[MAX_MSG_SIZE] = "";
-
-    va_list varParams;
-    va_start(varParams, formatPtr);
-
-    // Reset the errno to ensure that we report the proper errno value.
-    errno = savedErrno;
-
-    // Don't need to check the return value because if there is an error we can't do anything about
-    // it.  If there was a truncation then that'll just show up in the logs.
-    vsnprintf(msg, sizeof(msg), formatPtr, varParams);
-
-    va_end(varParams);
-
     // If running on an embedded target, write the message out to the log.
 #ifdef LEGATO_EMBEDDED
 
+    (void)timestamp;
+
     syslog(ConvertToSyslogLevel(level), "%s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
            levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr, baseFileNamePtr,
-           functionNamePtr, lineNumber, msg);
+           functionNamePtr, lineNumber, msgPtr);
 
     // If running on a PC, write the message to standard error with a timestamp added.
 #else
 
-    time_t now;
     char timeStamp[26] = "";
     char* timeStampPtr = timeStamp;
 
-    if ( (time(&now) != ((time_t)-1)) && (ctime_r(&now, timeStamp) != NULL) )
+    if ( (timestamp != ((time_t)-1)) && (ctime_r(&timestamp, timeStamp) != NULL) )
     {
         // Tue Jan 14 18:01:56 2014
         // 0123456789012345678901234
@@ -1126,7 +1311,7 @@ void _le_log_Send
 
     fprintf(stderr, "%s : %s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
             timeStampPtr, levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr,
-            baseFileNamePtr, functionNamePtr, lineNumber, msg);
+            baseFileNamePtr, functionNamePtr, lineNumber, msgPtr);
 
 #endif
 }
@@ -1134,78 +1319,943 @@ void _le_log_Send
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get a null-terminated, printable string representing an le_result_t value.
- *
- * For example, LE_RESULT_TXT(LE_NOT_PERMITTED) would return a pointer to a string containing
- * "LE_NOT_PERMITTED".
+ * Parses one printf conversion specification.
  *
- * "(unknown)" will be returned if the value given is out of range.
+ * Positional arguments, wide characters and strings, %n and anything else unusual are not
+ * supported.  Messages using them are logged synchronously.
  *
- * @return A pointer to a string constant.
+ * @return  true if the specification is supported.
  */
 //--------------------------------------------------------------------------------------------------
-const char* _le_log_GetResultCodeString
+static bool ParseConvSpec
 (
-    le_result_t resultCode  ///< [in] The result code value to be translated.
+    const char* specPtr,        ///< [IN] The specification, starting at its '%'.
+    ConvSpec_t* convPtr         ///< [OUT] The parsed specification.
 )
 {
-    switch (resultCode)
+    const char* charPtr = specPtr + 1;
+
+    convPtr->numStars = 0;
+    convPtr->precisionStar = false;
+    convPtr->precision = -1;
+
+    // Flags.
+    charPtr += strspn(charPtr, "-+ #0'");
+
+    // Field width.
+    if (*charPtr == '*')
     {
-        case LE_OK:
-            return "LE_OK";
-        case LE_NOT_FOUND:
-            return "LE_NOT_FOUND";
-        case LE_NOT_POSSIBLE:
-            return "LE_NOT_POSSIBLE";
-        case LE_OUT_OF_RANGE:
-            return "LE_OUT_OF_RANGE";
-        case LE_NO_MEMORY:
-            return "LE_NO_MEMORY";
-        case LE_NOT_PERMITTED:
-            return "LE_NOT_PERMITTED";
-        case LE_FAULT:
-            return "LE_FAULT";
-        case LE_COMM_ERROR:
-            return "LE_COMM_ERROR";
-        case LE_TIMEOUT:
-            return "LE_TIMEOUT";
-        case LE_OVERFLOW:
-            return "LE_OVERFLOW";
-        case LE_UNDERFLOW:
-            return "LE_UNDERFLOW";
-        case LE_WOULD_BLOCK:
-            return "LE_WOULD_BLOCK";
-        case LE_DEADLOCK:
-            return "LE_DEADLOCK";
-        case LE_FORMAT_ERROR:
-            return "LE_FORMAT_ERROR";
-        case LE_DUPLICATE:
-            return "LE_DUPLICATE";
-        case LE_BAD_PARAMETER:
-            return "LE_BAD_PARAMETER";
-        case LE_CLOSED:
-            return "LE_CLOSED";
-        case LE_BUSY:
-            return "LE_BUSY";
-        case LE_UNSUPPORTED:
-            return "LE_UNSUPPORTED";
-        case LE_IO_ERROR:
-            return "LE_IO_ERROR";
-        case LE_NOT_IMPLEMENTED:
-            return "LE_NOT_IMPLEMENTED";
-        case LE_UNAVAILABLE:
-            return "LE_UNAVAILABLE";
-        case LE_TERMINATED:
-            return "LE_TERMINATED";
+        convPtr->numStars++;
+        charPtr++;
+    }
+    else
+    {
+        while (isdigit((unsigned char)*charPtr))
+        {
+            charPtr++;
+        }
     }
-    LE_ERROR("Result code %d out of range.", resultCode);
-    return "(unknown)";
-}
 
+    // Positional arguments ("%1$d") can't be captured in order.
+    if (*charPtr == '$')
+    {
+        return false;
+    }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Gets a reference to a trace keyword's settings.
+    // Precision.
+    if (*charPtr == '.')
+    {
+        charPtr++;
+
+        if (*charPtr == '*')
+        {
+            convPtr->numStars++;
+            convPtr->precisionStar = true;
+            charPtr++;
+        }
+        else
+        {
+            convPtr->precision = 0;
+
+            while (isdigit((unsigned char)*charPtr))
+            {
+                convPtr->precision = (convPtr->precision * 10) + (*charPtr - '0');
+                charPtr++;
+            }
+        }
+    }
+
+    // Length modifier.
+    char length = '\0';
+
+    switch (*charPtr)
+    {
+        case 'h':
+        case 'l':
+            length = *charPtr++;
+            if (*charPtr == length)
+            {
+                // "hh" is promoted to int like "h", "ll" is stored as 'q'.
+                length = (length == 'l') ? 'q' : 'h';
+                charPtr++;
+            }
+            break;
+
+        case 'q':
+        case 'L':
+        case 'j':
+        case 'z':
+        case 't':
+            length = *charPtr++;
+            break;
+    }
+
+    // Conversion specifier.
+    switch (*charPtr)
+    {
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            switch (length)
+            {
+                case 'l':
+                    convPtr->type = ARG_LONG;
+                    break;
+                case 'q':
+                case 'L':
+                    convPtr->type = ARG_LONG_LONG;
+                    break;
+                case 'j':
+                    convPtr->type = ARG_INTMAX;
+                    break;
+                case 'z':
+                    convPtr->type = ARG_SIZE;
+                    break;
+                case 't':
+                    convPtr->type = ARG_PTRDIFF;
+                    break;
+                default:
+                    convPtr->type = ARG_INT;
+                    break;
+            }
+            break;
+
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            convPtr->type = (length == 'L') ? ARG_LONG_DOUBLE : ARG_DOUBLE;
+            break;
+
+        case 'c':
+            convPtr->type = ARG_INT;
+            if (length != '\0')
+            {
+                return false;
+            }
+            break;
+
+        case 's':
+            convPtr->type = ARG_STRING;
+            if (length != '\0')
+            {
+                return false;
+            }
+            break;
+
+        case 'p':
+            convPtr->type = ARG_POINTER;
+            break;
+
+        case 'm':
+            convPtr->type = ARG_NONE;
+            break;
+
+        default:
+            return false;
+    }
+
+    convPtr->endPtr = charPtr + 1;
+
+    return ((convPtr->endPtr - specPtr) <= ASYNC_MAX_SPEC_LEN);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a value to a buffer of captured arguments.
+ *
+ * @return  false if it doesn't fit.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool PutArg
+(
+    uint8_t* bufPtr,            ///< [IN] Argument buffer.
+    size_t bufSize,             ///< [IN] Size of the argument buffer.
+    size_t* lenPtr,             ///< [IN/OUT] Number of bytes used in the buffer.
+    const void* valuePtr,       ///< [IN] The value.
+    size_t valueSize            ///< [IN] Size of the value.
+)
+{
+    if ((*lenPtr + valueSize) > bufSize)
+    {
+        return false;
+    }
+
+    memcpy(bufPtr + *lenPtr, valuePtr, valueSize);
+    *lenPtr += valueSize;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies the arguments of a log message into a buffer, so that it can be formatted later.
+ * Strings are copied, truncated to the most that could appear in the message.
+ *
+ * @return  The number of bytes of arguments, or -1 if the message can't be captured (unsupported
+ *          conversion or not enough room).
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t CaptureArgs
+(
+    const char* formatPtr,      ///< [IN] The user message format.
+    va_list varParams,          ///< [IN] The arguments.
+    uint8_t* bufPtr,            ///< [OUT] Buffer to copy the arguments into.
+    size_t bufSize              ///< [IN] Size of the buffer.
+)
+{
+    size_t len = 0;
+    const char* charPtr = strchr(formatPtr, '%');
+
+    while (charPtr != NULL)
+    {
+        ConvSpec_t conv;
+
+        if (charPtr[1] == '%')
+        {
+            charPtr = strchr(charPtr + 2, '%');
+            continue;
+        }
+
+        if (!ParseConvSpec(charPtr, &conv))
+        {
+            return -1;
+        }
+
+        int i;
+        for (i = 0; i < conv.numStars; i++)
+        {
+            int star = va_arg(varParams, int);
+
+            if (!PutArg(bufPtr, bufSize, &len, &star, sizeof(star)))
+            {
+                return -1;
+            }
+
+            // A negative precision argument is taken as if the precision were omitted.
+            if (conv.precisionStar && (i == (conv.numStars - 1)))
+            {
+                conv.precision = (star < 0) ? -1 : star;
+            }
+        }
+
+        bool fits = true;
+
+        switch (conv.type)
+        {
+#define CAPTURE(type) \
+            { type value = va_arg(varParams, type); \
+              fits = PutArg(bufPtr, bufSize, &len, &value, sizeof(value)); } \
+            break
+
+            case ARG_NONE:
+                break;
+            case ARG_INT:
+                CAPTURE(int);
+            case ARG_LONG:
+                CAPTURE(long);
+            case ARG_LONG_LONG:
+                CAPTURE(long long);
+            case ARG_INTMAX:
+                CAPTURE(intmax_t);
+            case ARG_SIZE:
+                CAPTURE(size_t);
+            case ARG_PTRDIFF:
+                CAPTURE(ptrdiff_t);
+            case ARG_DOUBLE:
+                CAPTURE(double);
+            case ARG_LONG_DOUBLE:
+                CAPTURE(long double);
+            case ARG_POINTER:
+                CAPTURE(void*);
+
+#undef CAPTURE
+
+            case ARG_STRING:
+            {
+                const char* strPtr = va_arg(varParams, const char*);
+
+                if (strPtr == NULL)
+                {
+                    strPtr = "(null)";
+                }
+
+                // Only the part that can end up in the message needs to be copied, and the
+                // precision may be limiting a string that isn't null-terminated.
+                size_t maxLen = MAX_MSG_SIZE - 1;
+                if ((conv.precision >= 0) && (conv.precision < maxLen))
+                {
+                    maxLen = conv.precision;
+                }
+                uint16_t strLen = strnlen(strPtr, maxLen);
+
+                fits = PutArg(bufPtr, bufSize, &len, &strLen, sizeof(strLen))
+                       && PutArg(bufPtr, bufSize, &len, strPtr, strLen)
+                       && PutArg(bufPtr, bufSize, &len, "", 1);
+                break;
+            }
+        }
+
+        if (!fits)
+        {
+            return -1;
+        }
+
+        charPtr = strchr(conv.endPtr, '%');
+    }
+
+    return len;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Formats the user message of an asynchronous log record from its format string and captured
+ * arguments.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FormatRecord
+(
+    const AsyncRecord_t* recPtr,    ///< [IN] The record.
+    const uint8_t* argsPtr,         ///< [IN] The record's captured arguments.
+    char* msgPtr,                   ///< [OUT] Buffer for the message.
+    size_t msgSize                  ///< [IN] Size of the message buffer.
+)
+{
+    const char* charPtr = recPtr->formatPtr;
+    size_t len = 0;
+    size_t argOffset = 0;
+
+    // Fetches the next captured argument of a given type.
+#define NEXT_ARG(type) \
+    ({ type value; memcpy(&value, argsPtr + argOffset, sizeof(value)); \
+       argOffset += sizeof(value); value; })
+
+    while ((*charPtr != '\0') && (len < (msgSize - 1)))
+    {
+        if (*charPtr != '%')
+        {
+            msgPtr[len++] = *charPtr++;
+            continue;
+        }
+
+        if (charPtr[1] == '%')
+        {
+            msgPtr[len++] = '%';
+            charPtr += 2;
+            continue;
+        }
+
+        // The format was already parsed successfully when the arguments were captured.
+        ConvSpec_t conv;
+        LE_ASSERT(ParseConvSpec(charPtr, &conv));
+
+        // Rebuild the specification with any '*' replaced by its captured value.
+        char spec[ASYNC_MAX_SPEC_LEN + (2 * 12)];
+        size_t specLen = 0;
+
+        for (; charPtr < conv.endPtr; charPtr++)
+        {
+            if (*charPtr == '*')
+            {
+                int star = NEXT_ARG(int);
+
+                // A negative precision means no precision, which can only be written by leaving
+                // it out. (A negative width reads back as the '-' flag, as it should.)
+                if ((star < 0) && (charPtr[-1] == '.'))
+                {
+                    specLen--;
+                    continue;
+                }
+
+                specLen += snprintf(spec + specLen, sizeof(spec) - specLen, "%d", star);
+            }
+            else
+            {
+                spec[specLen++] = *charPtr;
+            }
+        }
+        spec[specLen] = '\0';
+
+        char* outPtr = msgPtr + len;
+        size_t outSize = msgSize - len;
+        int n = 0;
+
+        switch (conv.type)
+        {
+            case ARG_NONE:
+                errno = recPtr->savedErrno;
+                n = snprintf(outPtr, outSize, "%m");
+                break;
+            case ARG_INT:
+                n = snprintf(outPtr, outSize, spec, NEXT_ARG(int));
+                break;
+            case ARG_LONG:
+                n = snprintf(outPtr, outSize, spec, NEXT_ARG(long));
+                break;
+            case ARG_LONG_LONG:
+                n = snprintf(outPtr, outSize, spec, NEXT_ARG(long long));
+                break;
+            case ARG_INTMAX:
+                n = snprintf(outPtr, outSize, spec, NEXT_ARG(intmax_t));
+                break;
+            case ARG_SIZE:
+                n = snprintf(outPtr, outSize, spec, NEXT_ARG(size_t));
+                break;
+            case ARG_PTRDIFF:
+                n = snprintf(outPtr, outSize, spec, NEXT_ARG(ptrdiff_t));
+                break;
+            case ARG_DOUBLE:
+                n = snprintf(outPtr, outSize, spec, NEXT_ARG(double));
+                break;
+            case ARG_LONG_DOUBLE:
+                n = snprintf(outPtr, outSize, spec, NEXT_ARG(long double));
+                break;
+            case ARG_POINTER:
+                n = snprintf(outPtr, outSize, spec, NEXT_ARG(void*));
+                break;
+            case ARG_STRING:
+            {
+                uint16_t strLen = NEXT_ARG(uint16_t);
+                n = snprintf(outPtr, outSize, spec, (const char*)(argsPtr + argOffset));
+                argOffset += strLen + 1;
+                break;
+            }
+        }
+
+#undef NEXT_ARG
+
+        if (n > 0)
+        {
+            // On truncation, snprintf() returns the length the output would have had.
+            len += ((size_t)n < outSize) ? (size_t)n : (outSize - 1);
+        }
+    }
+
+    msgPtr[len] = '\0';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wakes up the writer thread if it is idle, or if it is batching and the ring is half full.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void WakeWriter
+(
+    size_t usedBytes        ///< [IN] Number of bytes in use in the ring.
+)
+{
+    uint32_t state = __atomic_load_n(&WriterWaiting, __ATOMIC_SEQ_CST);
+
+    if ((state == WRITER_RUNNING) ||
+        ((state == WRITER_BATCHING) && (usedBytes <= (ASYNC_RING_BYTES / 2))))
+    {
+        return;
+    }
+
+    if (__atomic_exchange_n(&WriterWaiting, WRITER_RUNNING, __ATOMIC_SEQ_CST) != WRITER_RUNNING)
+    {
+        syscall(SYS_futex, &WriterWaiting, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Formats and writes all the complete records at the front of the ring, in order, and reports
+ * any messages that were dropped.
+ *
+ * @warning Assumes that DrainMutex is locked by the caller.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DrainRing
+(
+    void
+)
+{
+    uint64_t tail = __atomic_load_n(&RingTail, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        AsyncRecord_t* recPtr = (AsyncRecord_t*)(RingPtr + (tail & (ASYNC_RING_BYTES - 1)));
+        uint32_t commit = __atomic_load_n(&recPtr->commit, __ATOMIC_ACQUIRE);
+
+        if (commit == 0)
+        {
+            break;
+        }
+
+        size_t recSize = commit & ~RECORD_PADDING;
+
+        if ((commit & RECORD_PADDING) == 0)
+        {
+            char msg[MAX_MSG_SIZE];
+            const char* threadNamePtr = (const char*)(recPtr + 1);
+
+            FormatRecord(recPtr, (uint8_t*)threadNamePtr + recPtr->threadNameBytes,
+                         msg, sizeof(msg));
+
+            WriteMsg(recPtr->level, recPtr->traceRef, recPtr->sessionPtr->componentNamePtr,
+                     threadNamePtr, recPtr->filenamePtr, recPtr->functionNamePtr,
+                     recPtr->lineNumber, recPtr->timestamp, msg);
+        }
+
+        // Free space must read as zero (see RingPtr).
+        memset(recPtr, 0, recSize);
+
+        tail += recSize;
+        __atomic_store_n(&RingTail, tail, __ATOMIC_RELEASE);
+    }
+
+    uint32_t dropped = __atomic_exchange_n(&DroppedCount, 0, __ATOMIC_RELAXED);
+
+    if (dropped != 0)
+    {
+        char msg[MAX_MSG_SIZE];
+        snprintf(msg, sizeof(msg), "%" PRIu32 " log messages were dropped (log buffer full).",
+                 dropped);
+        log_LogGenericMsg(LE_LOG_WARN, le_arg_GetProgramName(), getpid(), msg);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes out everything that is waiting in the ring.  Used to keep messages in order before
+ * something is logged synchronously, and at exit.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushRing
+(
+    void
+)
+{
+    if (RingPtr != NULL)
+    {
+        LE_ASSERT(pthread_mutex_lock(&DrainMutex) == 0);
+        DrainRing();
+        LE_ASSERT(pthread_mutex_unlock(&DrainMutex) == 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function of the writer thread, which formats and writes asynchronous log records.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WriterThreadMain
+(
+    void* contextPtr    ///< Not used.
+)
+{
+    // Leave signal handling to the process's other threads.
+    sigset_t sigSet;
+    sigfillset(&sigSet);
+    pthread_sigmask(SIG_BLOCK, &sigSet, NULL);
+
+    for (;;)
+    {
+        LE_ASSERT(pthread_mutex_lock(&DrainMutex) == 0);
+        DrainRing();
+
+        // Announce that we're going to sleep, then check again for a record that was completed
+        // before a producer could see the announcement.  The producer side of this handshake is
+        // in WakeWriter().
+        __atomic_store_n(&WriterWaiting, WRITER_IDLE, __ATOMIC_SEQ_CST);
+
+        AsyncRecord_t* recPtr = (AsyncRecord_t*)(RingPtr +
+                                    (__atomic_load_n(&RingTail, __ATOMIC_RELAXED)
+                                     & (ASYNC_RING_BYTES - 1)));
+        bool isEmpty = (__atomic_load_n(&recPtr->commit, __ATOMIC_SEQ_CST) == 0);
+
+        LE_ASSERT(pthread_mutex_unlock(&DrainMutex) == 0);
+
+        if (isEmpty)
+        {
+            // EINTR and EAGAIN (already woken) are both fine; we just drain again.
+            syscall(SYS_futex, &WriterWaiting, FUTEX_WAIT_PRIVATE, WRITER_IDLE, NULL, NULL, 0);
+
+            // Woken by the first new record.  Give the producers a chance to add more to it.
+            static const struct timespec batchTime = { .tv_sec = 0, .tv_nsec = ASYNC_BATCH_NSEC };
+            __atomic_store_n(&WriterWaiting, WRITER_BATCHING, __ATOMIC_SEQ_CST);
+            syscall(SYS_futex, &WriterWaiting, FUTEX_WAIT_PRIVATE, WRITER_BATCHING, &batchTime,
+                    NULL, 0);
+        }
+
+        __atomic_store_n(&WriterWaiting, WRITER_RUNNING, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler run in the child process after a fork().  The writer thread doesn't exist in the child,
+ * and most children exec() soon anyway (which would lose anything left in the ring), so the child
+ * logs synchronously.  The records still in the ring belong to the parent, which will write them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AsyncChildAfterFork
+(
+    void
+)
+{
+    AsyncEnabled = false;
+    RingPtr = NULL;
+    pthread_mutex_init(&DrainMutex, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts the writer thread, if that hasn't been done yet.  If it can't be started, falls back
+ * to synchronous logging.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartWriter
+(
+    void
+)
+{
+    bool expected = false;
+
+    if (__atomic_compare_exchange_n(&WriterStarted, &expected, true, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+        pthread_t thread;
+        pthread_attr_t attr;
+
+        LE_ASSERT(pthread_attr_init(&attr) == 0);
+        LE_ASSERT(pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED) == 0);
+
+        if (pthread_create(&thread, &attr, WriterThreadMain, NULL) != 0)
+        {
+            AsyncEnabled = false;
+        }
+        else
+        {
+            atexit(FlushRing);
+            pthread_atfork(NULL, NULL, AsyncChildAfterFork);
+        }
+
+        pthread_attr_destroy(&attr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reserves space for a record in the ring.
+ *
+ * @return  Pointer to the record, or NULL if the ring is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static AsyncRecord_t* ReserveRecord
+(
+    size_t recSize,     ///< [IN] Size of the record (a multiple of 8 bytes).
+    size_t* usedPtr     ///< [OUT] Number of bytes in use in the ring, including the new record.
+)
+{
+    uint64_t head = __atomic_load_n(&RingHead, __ATOMIC_RELAXED);
+    size_t offset;
+    size_t needed;
+
+    do
+    {
+        uint64_t tail = __atomic_load_n(&RingTail, __ATOMIC_ACQUIRE);
+
+        offset = head & (ASYNC_RING_BYTES - 1);
+        needed = recSize;
+
+        // A record doesn't wrap around; the rest of the ring gets padded instead.
+        if ((offset + recSize) > ASYNC_RING_BYTES)
+        {
+            needed += ASYNC_RING_BYTES - offset;
+        }
+
+        *usedPtr = head + needed - tail;
+
+        if (*usedPtr > ASYNC_RING_BYTES)
+        {
+            return NULL;
+        }
+    }
+    while (!__atomic_compare_exchange_n(&RingHead, &head, head + needed, true,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    if (needed != recSize)
+    {
+        AsyncRecord_t* padPtr = (AsyncRecord_t*)(RingPtr + offset);
+        __atomic_store_n(&padPtr->commit,
+                         (uint32_t)(ASYNC_RING_BYTES - offset) | RECORD_PADDING,
+                         __ATOMIC_SEQ_CST);
+        offset = 0;
+    }
+
+    return (AsyncRecord_t*)(RingPtr + offset);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hands a log message over to the writer thread.
+ *
+ * @return  false if the message's format isn't supported or its arguments are too large, in which
+ *          case it must be logged synchronously.  Messages dropped because the ring is full count
+ *          as sent.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendAsync
+(
+    le_log_Level_t level,
+    le_log_TraceRef_t traceRef,
+    Session_t* sessionPtr,
+    const char* filenamePtr,
+    const char* functionNamePtr,
+    unsigned int lineNumber,
+    int savedErrno,
+    const char* formatPtr,
+    va_list varParams
+)
+{
+    uint8_t args[ASYNC_MAX_ARG_BYTES];
+    ssize_t argBytes = CaptureArgs(formatPtr, varParams, args, sizeof(args));
+
+    if (argBytes < 0)
+    {
+        return false;
+    }
+
+    if (!WriterStarted)
+    {
+        StartWriter();
+    }
+
+    const char* threadNamePtr = le_thread_GetMyName();
+    size_t threadNameBytes = strnlen(threadNamePtr, LIMIT_MAX_THREAD_NAME_LEN) + 1;
+    size_t recSize = (sizeof(AsyncRecord_t) + threadNameBytes + argBytes + 7) & ~(size_t)7;
+
+    size_t usedBytes;
+    AsyncRecord_t* recPtr = ReserveRecord(recSize, &usedBytes);
+
+    if (recPtr == NULL)
+    {
+        __atomic_fetch_add(&DroppedCount, 1, __ATOMIC_RELAXED);
+        WakeWriter(usedBytes);
+        return true;
+    }
+
+    recPtr->argBytes = argBytes;
+    recPtr->threadNameBytes = threadNameBytes;
+    recPtr->savedErrno = savedErrno;
+    recPtr->level = level;
+    recPtr->lineNumber = lineNumber;
+    recPtr->timestamp = time(NULL);
+    recPtr->traceRef = traceRef;
+    recPtr->sessionPtr = sessionPtr;
+    recPtr->filenamePtr = filenamePtr;
+    recPtr->functionNamePtr = functionNamePtr;
+    recPtr->formatPtr = formatPtr;
+
+    char* dataPtr = (char*)(recPtr + 1);
+    memcpy(dataPtr, threadNamePtr, threadNameBytes - 1);
+    dataPtr[threadNameBytes - 1] = '\0';
+    memcpy(dataPtr + threadNameBytes, args, argBytes);
+
+    __atomic_store_n(&recPtr->commit, (uint32_t)recSize, __ATOMIC_SEQ_CST);
+
+    WakeWriter(usedBytes);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the log message and sends it to the logging system.
+ *
+ * When asynchronous logging is enabled, messages below CRITICAL are normally just recorded in the
+ * ring for the writer thread.  Anything logged synchronously first flushes the ring, so that
+ * messages from the same thread stay in order and nothing is lost when LE_FATAL() aborts.
+ */
+//--------------------------------------------------------------------------------------------------
+void _le_log_Send
+(
+    const le_log_Level_t level,         // The severity level. Set to -1 if this is a Trace log.
+    const le_log_TraceRef_t traceRef,   // The Trace reference. Set to NULL if this is not a Trace log.
+    le_log_SessionRef_t logSession,     // The log session.
+    const char* filenamePtr,            // The name of the source file that logged the message.
+    const char* functionNamePtr,        // The name of the function that logged the message.
+    const unsigned int lineNumber,      // The line number in the source file that logged the message.
+    const char* formatPtr, ...          // The user message format and options.
+)
+{
+    // Save the current errno to be used in the log message because some of the system calls below
+    // may change errno.
+    int savedErrno = errno;
+
+    // If the logging function was called from code that doesn't have a log session reference,
+    if (logSession == NULL)
+    {
+        // Use the default log session.
+        logSession = &DefaultLogSession;
+
+        // Check that the message's log level is actually higher than the default filtering
+        // level, since the logging macros probably weren't provided with a valid pointer
+        // to a filtering level.
+        if ((level < logSession->level) && (level != (le_log_Level_t)-1))
+        {
+            return;
+        }
+    }
+
+    va_list varParams;
+    va_start(varParams, formatPtr);
+
+    if (AsyncEnabled)
+    {
+        if ((level == (le_log_Level_t)-1) || (level < LE_LOG_CRIT))
+        {
+            va_list asyncParams;
+            va_copy(asyncParams, varParams);
+            bool isSent = SendAsync(level, traceRef, logSession, filenamePtr, functionNamePtr,
+                                    lineNumber, savedErrno, formatPtr, asyncParams);
+            va_end(asyncParams);
+
+            if (isSent)
+            {
+                va_end(varParams);
+                return;
+            }
+        }
+
+        FlushRing();
+    }
+
+    // Get the user message.
+    char msg[MAX_MSG_SIZE] = "";
+
+    // Reset the errno to ensure that we report the proper errno value.
+    errno = savedErrno;
+
+    // Don't need to check the return value because if there is an error we can't do anything about
+    // it.  If there was a truncation then that'll just show up in the logs.
+    vsnprintf(msg, sizeof(msg), formatPtr, varParams);
+
+    va_end(varParams);
+
+    // NOTE: The component name won't change, so it's safe to read this without locking the mutex.
+    WriteMsg(level, traceRef, logSession->componentNamePtr, le_thread_GetMyName(), filenamePtr,
+             functionNamePtr, lineNumber, time(NULL), msg);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a null-terminated, printable string representing an le_result_t value.
+ *
+ * For example, LE_RESULT_TXT(LE_NOT_PERMITTED) would return a pointer to a string containing
+ * "LE_NOT_PERMITTED".
+ *
+ * "(unknown)" will be returned if the value given is out of range.
+ *
+ * @return A pointer to a string constant.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* _le_log_GetResultCodeString
+(
+    le_result_t resultCode  ///< [in] The result code value to be translated.
+)
+{
+    switch (resultCode)
+    {
+        case LE_OK:
+            return "LE_OK";
+        case LE_NOT_FOUND:
+            return "LE_NOT_FOUND";
+        case LE_NOT_POSSIBLE:
+            return "LE_NOT_POSSIBLE";
+        case LE_OUT_OF_RANGE:
+            return "LE_OUT_OF_RANGE";
+        case LE_NO_MEMORY:
+            return "LE_NO_MEMORY";
+        case LE_NOT_PERMITTED:
+            return "LE_NOT_PERMITTED";
+        case LE_FAULT:
+            return "LE_FAULT";
+        case LE_COMM_ERROR:
+            return "LE_COMM_ERROR";
+        case LE_TIMEOUT:
+            return "LE_TIMEOUT";
+        case LE_OVERFLOW:
+            return "LE_OVERFLOW";
+        case LE_UNDERFLOW:
+            return "LE_UNDERFLOW";
+        case LE_WOULD_BLOCK:
+            return "LE_WOULD_BLOCK";
+        case LE_DEADLOCK:
+            return "LE_DEADLOCK";
+        case LE_FORMAT_ERROR:
+            return "LE_FORMAT_ERROR";
+        case LE_DUPLICATE:
+            return "LE_DUPLICATE";
+        case LE_BAD_PARAMETER:
+            return "LE_BAD_PARAMETER";
+        case LE_CLOSED:
+            return "LE_CLOSED";
+        case LE_BUSY:
+            return "LE_BUSY";
+        case LE_UNSUPPORTED:
+            return "LE_UNSUPPORTED";
+        case LE_IO_ERROR:
+            return "LE_IO_ERROR";
+        case LE_NOT_IMPLEMENTED:
+            return "LE_NOT_IMPLEMENTED";
+        case LE_UNAVAILABLE:
+            return "LE_UNAVAILABLE";
+        case LE_TERMINATED:
+            return "LE_TERMINATED";
+    }
+    LE_ERROR("Result code %d out of range.", resultCode);
+    return "(unknown)";
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a reference to a trace keyword's settings.
  *
  * @return  The trace reference.
  **/
@@ -1319,3 +2369,71 @@ void log_LogGenericMsg
 #endif
 
 }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logs a batch of generic messages from the same process, all with the same severity level.
+ * Equivalent to calling log_LogGenericMsg() for each of them, but cheaper.
+ */
+//--------------------------------------------------------------------------------------------------
+void log_LogGenericMsgs
+(
+    le_log_Level_t level,           ///< [IN] Severity level.
+    const char* procNamePtr,        ///< [IN] Process name.
+    pid_t pid,                      ///< [IN] PID of the process.
+    const char* const* msgPtrs,     ///< [IN] Messages.
+    size_t numMsgs                  ///< [IN] Number of messages.
+)
+{
+    size_t i;
+
+#ifdef LEGATO_EMBEDDED
+
+    // Each message has to be a separate syslog record.
+    for (i = 0; i < numMsgs; i++)
+    {
+        syslog(ConvertToSyslogLevel(level), "%s | %s[%d] | %s\n",
+               SeverityStr[level], procNamePtr, pid, msgPtrs[i]);
+    }
+
+#else
+
+    time_t now;
+    char timeStamp[26] = "";
+    char* timeStampPtr = timeStamp;
+
+    if ( (time(&now) != ((time_t)-1)) && (ctime_r(&now, timeStamp) != NULL) )
+    {
+        timeStampPtr = timeStamp + 4; // Skip day of week.
+        timeStamp[19] = '\0';  // Exclude the year.
+    }
+
+    // Standard error isn't buffered, so gather the lines up and write them out together.
+    char buff[4096];
+    size_t len = 0;
+
+    for (i = 0; i < numMsgs; i++)
+    {
+        int n = snprintf(buff + len, sizeof(buff) - len, "%s : %s | %s[%d] | %s\n",
+                         timeStampPtr, SeverityStr[level], procNamePtr, pid, msgPtrs[i]);
+
+        if ((n >= 0) && ((size_t)n < (sizeof(buff) - len)))
+        {
+            len += n;
+        }
+        else
+        {
+            // Doesn't fit.  Write out what we have, then this line on its own.
+            fwrite(buff, 1, len, stderr);
+            len = 0;
+
+            fprintf(stderr, "%s : %s | %s[%d] | %s\n",
+                    timeStampPtr, SeverityStr[level], procNamePtr, pid, msgPtrs[i]);
+        }
+    }
+
+    fwrite(buff, 1, len, stderr);
+
+#endif
+}
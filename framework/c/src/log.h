@@ -164,4 +164,20 @@ void log_LogGenericMsg
     const char* msgPtr          ///< [IN] Message.
 );
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logs a batch of generic messages from the same process, all with the same severity level.
+ * Equivalent to calling log_LogGenericMsg() for each of them, but cheaper.
+ */
+//--------------------------------------------------------------------------------------------------
+void log_LogGenericMsgs
+(
+    le_log_Level_t level,           ///< [IN] Severity level.
+    const char* procNamePtr,        ///< [IN] Process name.
+    pid_t pid,                      ///< [IN] PID of the process.
+    const char* const* msgPtrs,     ///< [IN] Messages.
+    size_t numMsgs                  ///< [IN] Number of messages.
+);
+
 #endif // LOG_INCLUDE_GUARD
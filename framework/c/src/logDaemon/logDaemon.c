@@ -301,6 +301,120 @@ static le_mem_PoolRef_t TracePoolRef;
                                 - LIMIT_MAX_COMPONENT_NAME_LEN )
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of log messages.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_MSG_SIZE            256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer that app stdout/stderr output is read into.  A single read picks up many
+ * small writes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FD_READ_BUFF_BYTES      4096
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Most reads done from one fd each time it becomes readable, so that a chatty app can't keep the
+ * daemon from serving the other fds.  (An fd that has been hung up is read until it is empty.)
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_READS_PER_EVENT     4
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of lines gathered up and written to the log together.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LINE_BATCH_SIZE         32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Longest time, in milliseconds, that output without a trailing newline (a prompt, progress
+ * output, or an app's last words before it hangs) is held back waiting for the rest of its line.
+ * After that it's logged as a line of its own.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PARTIAL_LINE_FLUSH_MS   100
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rate limit on lines of stdout/stderr output logged for an app: lines per second sustained, and
+ * the most that can be logged in one burst.  Lines over the limit are dropped and counted.
+ *
+ * @todo Make this configurable.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FD_LOG_LINES_PER_SEC    200
+#define FD_LOG_BURST_LINES      1000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the window that apps' recent log throughput is measured over, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define THROUGHPUT_WINDOW_MS    1000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimated maximum number of apps with stdout/stderr output.  Used for sizing the app log
+ * statistics pool and map.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_EXPECTED_APPS 16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Statistics and rate limit state for the stdout/stderr output of all processes in an app.
+ * These are kept for as long as the daemon runs, so they can be reported by the log tool.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char            appName[LIMIT_MAX_APP_NAME_BYTES];  ///< App name (key in AppLogStatsMapRef).
+    uint64_t        numLines;           ///< Lines logged.
+    uint64_t        numBytes;           ///< Bytes logged (not counting the newlines).
+    uint64_t        numDropped;         ///< Lines dropped by the rate limit.
+    uint32_t        unreportedDropped;  ///< Lines dropped since this was last logged.
+    le_clk_Time_t   dropReportTime;     ///< When dropped lines were last logged.
+    uint64_t        rateTokens;         ///< Rate limit bucket, in thousandths of a line.
+    le_clk_Time_t   refillTime;         ///< When the bucket was last refilled.
+    le_clk_Time_t   windowStartTime;    ///< Start of the current throughput window.
+    uint32_t        windowLines;        ///< Lines logged in the current throughput window.
+    uint32_t        windowBytes;        ///< Bytes logged in the current throughput window.
+    uint32_t        linesPerSec;        ///< Lines per second in the last complete window.
+    uint32_t        bytesPerSec;        ///< Bytes per second in the last complete window.
+}
+AppLogStats_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for app log statistics objects.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t AppLogStatsPoolRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * App log statistics, keyed by app name.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t AppLogStatsMapRef;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * File descriptor logging object.
@@ -315,10 +429,27 @@ typedef struct
     int             pid;                                    ///< PID of the process.
     le_log_Level_t  level;                                  ///< Log level.
     le_fdMonitor_Ref_t monitorRef;                          ///< Monitor object.
+    AppLogStats_t*  statsPtr;                               ///< The app's log statistics.
+    le_timer_Ref_t  flushTimerRef;                          ///< Flushes a pending partial line.
+    size_t          lineLen;                                ///< Length of the partial line.
+    char            line[MAX_MSG_SIZE];                     ///< Partial line (no newline yet).
 }
 FdLog_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lines read from an fd, waiting to be written to the log together.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* msgPtrs[LINE_BATCH_SIZE];   ///< The lines (null-terminated).
+    size_t      numMsgs;                    ///< Number of lines.
+}
+LineBatch_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Pool for file descriptor logging objects.
@@ -329,10 +460,10 @@ static le_mem_PoolRef_t FdLogPoolRef;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Maximum length of log messages.
+ * Buffer that app stdout/stderr output is read into.
  */
 //--------------------------------------------------------------------------------------------------
-#define MAX_MSG_SIZE            256
+static char FdReadBuff[FD_READ_BUFF_BYTES];
 
 
 
@@ -951,8 +1082,8 @@ static bool ParseCmdPacket
     }
     packetPtr++;
 
-    // The "list" command has no parameters.
-    if (commandCode == LOG_CMD_LIST_COMPONENTS)
+    // The "list" and "stats" commands have no parameters.
+    if ((commandCode == LOG_CMD_LIST_COMPONENTS) || (commandCode == LOG_CMD_GET_STATS))
     {
         return true;
     }
@@ -2402,6 +2533,96 @@ static void GenerateList
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Computes the number of milliseconds from one time to a later one.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedMs
+(
+    le_clk_Time_t startTime,
+    le_clk_Time_t endTime
+)
+{
+    if (le_clk_GreaterThan(startTime, endTime))
+    {
+        return 0;
+    }
+
+    le_clk_Time_t diff = le_clk_Sub(endTime, startTime);
+
+    return ((uint64_t)diff.sec * 1000) + (diff.usec / 1000);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Computes an app's throughput over the current window, and starts a new window, if the current
+ * window is over.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateThroughput
+(
+    AppLogStats_t* statsPtr,    ///< [IN] The app's log statistics.
+    le_clk_Time_t now           ///< [IN] Current (relative) time.
+)
+{
+    uint64_t windowMs = ElapsedMs(statsPtr->windowStartTime, now);
+
+    if (windowMs >= THROUGHPUT_WINDOW_MS)
+    {
+        statsPtr->linesPerSec = (uint32_t)(((uint64_t)statsPtr->windowLines * 1000) / windowMs);
+        statsPtr->bytesPerSec = (uint32_t)(((uint64_t)statsPtr->windowBytes * 1000) / windowMs);
+        statsPtr->windowLines = 0;
+        statsPtr->windowBytes = 0;
+        statsPtr->windowStartTime = now;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends the log control tool the statistics for the stdout/stderr output of each app, one line
+ * per app.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void GenerateStats
+(
+    le_msg_SessionRef_t ipcSessionRef   ///< [IN] Log control tool's current IPC session.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    le_hashmap_It_Ref_t iteratorRef = le_hashmap_GetIterator(AppLogStatsMapRef);
+
+    while (le_hashmap_NextNode(iteratorRef) == LE_OK)
+    {
+        AppLogStats_t* statsPtr = (AppLogStats_t*)le_hashmap_GetValue(iteratorRef);
+        char message[LIMIT_MAX_APP_NAME_BYTES + 160];
+
+        // Finish the throughput window if it's over, in case the app has gone quiet.
+        UpdateThroughput(statsPtr, now);
+        if (ElapsedMs(statsPtr->windowStartTime, now) >= 2 * THROUGHPUT_WINDOW_MS)
+        {
+            statsPtr->linesPerSec = 0;
+            statsPtr->bytesPerSec = 0;
+        }
+
+        snprintf(message, sizeof(message),
+                 "%s: %" PRIu64 " lines (%" PRIu32 "/s), %" PRIu64 " bytes (%" PRIu32 "/s),"
+                 " %" PRIu64 " lines dropped",
+                 statsPtr->appName,
+                 statsPtr->numLines,
+                 statsPtr->linesPerSec,
+                 statsPtr->numBytes,
+                 statsPtr->bytesPerSec,
+                 statsPtr->numDropped);
+
+        SendToLogTool(ipcSessionRef, message);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Clears the settings for a given process name out of the data structures.
@@ -2495,6 +2716,7 @@ static void ClientMsgReceiveHandler
             case LOG_CMD_DISABLE_TRACE:
             case LOG_CMD_LIST_COMPONENTS:
             case LOG_CMD_FORGET_PROCESS:
+            case LOG_CMD_GET_STATS:
 
                 LE_ERROR("Client attempted to issue a log control command (%c)!", command);
 
@@ -2582,6 +2804,12 @@ static void ControlToolMsgReceiveHandler
 
                 break;
 
+            case LOG_CMD_GET_STATS:
+
+                GenerateStats(ipcSessionRef);
+
+                break;
+
             default:
 
                 LE_ERROR("Unknown command byte '%c' received from log control tool.", command);
@@ -2598,7 +2826,258 @@ static void ControlToolMsgReceiveHandler
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Deletes the fd log object and monitor.  Closes the associated fd.
+ * Gets the log statistics for an app, creating them if the app doesn't have any yet.
+ *
+ * @return Pointer to the app's log statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+static AppLogStats_t* GetAppLogStats
+(
+    const char* appNamePtr      ///< [IN] Name of the application.
+)
+{
+    AppLogStats_t* statsPtr = le_hashmap_Get(AppLogStatsMapRef, appNamePtr);
+
+    if (statsPtr == NULL)
+    {
+        statsPtr = le_mem_ForceAlloc(AppLogStatsPoolRef);
+        memset(statsPtr, 0, sizeof(*statsPtr));
+
+        LE_ASSERT(le_utf8_Copy(statsPtr->appName, appNamePtr, sizeof(statsPtr->appName), NULL)
+                  == LE_OK);
+
+        statsPtr->rateTokens = (uint64_t)FD_LOG_BURST_LINES * 1000;
+        statsPtr->refillTime = le_clk_GetRelativeTime();
+        statsPtr->windowStartTime = statsPtr->refillTime;
+
+        le_hashmap_Put(AppLogStatsMapRef, statsPtr->appName, statsPtr);
+    }
+
+    return statsPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes out the lines gathered up in a batch and empties the batch.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushLineBatch
+(
+    FdLog_t* fdLogPtr,          ///< [IN] Fd log object the lines were read from.
+    LineBatch_t* batchPtr       ///< [IN] The batch.
+)
+{
+    if (batchPtr->numMsgs > 0)
+    {
+        // TODO: Don't log the app name for now so that it matches all the other log formats.  Add
+        //       the app name to all log messages at the same time.
+        log_LogGenericMsgs(fdLogPtr->level,
+                           fdLogPtr->procName,
+                           fdLogPtr->pid,
+                           batchPtr->msgPtrs,
+                           batchPtr->numMsgs);
+
+        batchPtr->numMsgs = 0;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logs a notice saying how many lines of an app's output were dropped since the last notice, if
+ * any were.  Lines already in the batch are written out first, to keep the log in order.
+ *
+ * While output is being dropped, this should be called at most once per THROUGHPUT_WINDOW_MS, so
+ * that an app that is over its rate limit doesn't get a notice between every line that gets
+ * through.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportDroppedLines
+(
+    FdLog_t* fdLogPtr,          ///< [IN] Fd log object.
+    LineBatch_t* batchPtr       ///< [IN] Batch of lines waiting to be written.
+)
+{
+    AppLogStats_t* statsPtr = fdLogPtr->statsPtr;
+
+    if (statsPtr->unreportedDropped > 0)
+    {
+        char notice[MAX_MSG_SIZE];
+
+        FlushLineBatch(fdLogPtr, batchPtr);
+
+        snprintf(notice, sizeof(notice),
+                 "%" PRIu32 " lines of output from app '%s' were dropped (over %d lines/s).",
+                 statsPtr->unreportedDropped, statsPtr->appName, FD_LOG_LINES_PER_SEC);
+        log_LogGenericMsg(LE_LOG_WARN, fdLogPtr->procName, fdLogPtr->pid, notice);
+
+        statsPtr->unreportedDropped = 0;
+        statsPtr->dropReportTime = le_clk_GetRelativeTime();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a complete line of output to the batch, if the app's rate limit allows it.  Otherwise the
+ * line is counted as dropped.
+ *
+ * The line must stay where it is until the batch is written out.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddLine
+(
+    FdLog_t* fdLogPtr,          ///< [IN] Fd log object the line was read from.
+    LineBatch_t* batchPtr,      ///< [IN] Batch to add the line to.
+    const char* linePtr,        ///< [IN] The line (null-terminated, without the newline).
+    size_t lineLen              ///< [IN] Length of the line.
+)
+{
+    AppLogStats_t* statsPtr = fdLogPtr->statsPtr;
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    // Refill the rate limit bucket for the time that has passed.
+    uint64_t maxTokens = (uint64_t)FD_LOG_BURST_LINES * 1000;
+    statsPtr->rateTokens += ElapsedMs(statsPtr->refillTime, now) * FD_LOG_LINES_PER_SEC;
+    if (statsPtr->rateTokens > maxTokens)
+    {
+        statsPtr->rateTokens = maxTokens;
+    }
+    statsPtr->refillTime = now;
+
+    if (statsPtr->rateTokens < 1000)
+    {
+        statsPtr->numDropped++;
+        statsPtr->unreportedDropped++;
+        return;
+    }
+    statsPtr->rateTokens -= 1000;
+
+    if (ElapsedMs(statsPtr->dropReportTime, now) >= THROUGHPUT_WINDOW_MS)
+    {
+        ReportDroppedLines(fdLogPtr, batchPtr);
+    }
+
+    UpdateThroughput(statsPtr, now);
+    statsPtr->numLines++;
+    statsPtr->numBytes += lineLen;
+    statsPtr->windowLines++;
+    statsPtr->windowBytes += lineLen;
+
+    batchPtr->msgPtrs[batchPtr->numMsgs++] = linePtr;
+    if (batchPtr->numMsgs == LINE_BATCH_SIZE)
+    {
+        FlushLineBatch(fdLogPtr, batchPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logs the partial line being assembled for an fd (if there is one) as a line of its own.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushPartialLine
+(
+    FdLog_t* fdLogPtr,          ///< [IN] Fd log object.
+    LineBatch_t* batchPtr       ///< [IN] Batch of lines waiting to be written.
+)
+{
+    if (fdLogPtr->lineLen > 0)
+    {
+        fdLogPtr->line[fdLogPtr->lineLen] = '\0';
+        AddLine(fdLogPtr, batchPtr, fdLogPtr->line, fdLogPtr->lineLen);
+
+        // The line buffer is about to be reused.
+        FlushLineBatch(fdLogPtr, batchPtr);
+        fdLogPtr->lineLen = 0;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Called when a partial line has been waiting for the rest of its line for too long.  Logs it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PartialLineTimerExpired
+(
+    le_timer_Ref_t timerRef     ///< [IN] The fd log object's flush timer.
+)
+{
+    FdLog_t* fdLogPtr = le_timer_GetContextPtr(timerRef);
+    LineBatch_t batch = { .numMsgs = 0 };
+
+    FlushPartialLine(fdLogPtr, &batch);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Splits data read from an fd into lines and adds them to the batch.  Complete lines are logged
+ * straight from the read buffer (which is modified).  A line that is split across reads, or that
+ * is too long for one log message, is assembled in the fd log object's line buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessFdData
+(
+    FdLog_t* fdLogPtr,          ///< [IN] Fd log object the data was read from.
+    LineBatch_t* batchPtr,      ///< [IN] Batch to add the lines to.
+    char* buffPtr,              ///< [IN] The data.
+    size_t len                  ///< [IN] Number of bytes of data.
+)
+{
+    while (len > 0)
+    {
+        char* newlinePtr = memchr(buffPtr, '\n', len);
+        size_t segmentLen = (newlinePtr != NULL) ? (size_t)(newlinePtr - buffPtr) : len;
+
+        if ((newlinePtr != NULL) && (fdLogPtr->lineLen == 0) && (segmentLen < MAX_MSG_SIZE))
+        {
+            // A whole line.
+            *newlinePtr = '\0';
+            AddLine(fdLogPtr, batchPtr, buffPtr, segmentLen);
+        }
+        else
+        {
+            size_t space = (MAX_MSG_SIZE - 1) - fdLogPtr->lineLen;
+
+            if (segmentLen > space)
+            {
+                // Too long for one log message, so log as much as fits and carry on.
+                memcpy(fdLogPtr->line + fdLogPtr->lineLen, buffPtr, space);
+                fdLogPtr->lineLen += space;
+                FlushPartialLine(fdLogPtr, batchPtr);
+
+                buffPtr += space;
+                len -= space;
+                continue;
+            }
+
+            memcpy(fdLogPtr->line + fdLogPtr->lineLen, buffPtr, segmentLen);
+            fdLogPtr->lineLen += segmentLen;
+
+            if (newlinePtr != NULL)
+            {
+                FlushPartialLine(fdLogPtr, batchPtr);
+            }
+        }
+
+        if (newlinePtr != NULL)
+        {
+            segmentLen++;
+        }
+        buffPtr += segmentLen;
+        len -= segmentLen;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes the fd log object and monitor.  Closes the associated fd.  Any unfinished line of
+ * output is logged first.
  */
 //--------------------------------------------------------------------------------------------------
 static void DeleteFdLog
@@ -2607,6 +3086,13 @@ static void DeleteFdLog
     FdLog_t* fdLogPtr           ///< [IN] Fd log object to delete.
 )
 {
+    LineBatch_t batch = { .numMsgs = 0 };
+
+    FlushPartialLine(fdLogPtr, &batch);
+    ReportDroppedLines(fdLogPtr, &batch);
+
+    le_timer_Delete(fdLogPtr->flushTimerRef);
+
     // Delete the fd monitor.
     le_fdMonitor_Delete(fdLogPtr->monitorRef);
 
@@ -2620,7 +3106,10 @@ static void DeleteFdLog
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Logs message received from the fd.
+ * Logs messages received from the fd.
+ *
+ * Reads as much as is available (up to a limit, so other fds get a turn), splits it into lines
+ * and writes the lines to the log in batches.
  */
 //--------------------------------------------------------------------------------------------------
 static void LogFdMessages
@@ -2630,35 +3119,69 @@ static void LogFdMessages
 )
 {
     FdLog_t* fdLogPtr = le_fdMonitor_GetContextPtr();
+    bool isHungUp = ((events & (POLLRDHUP | POLLHUP)) != 0);
 
     if (events & POLLIN)
     {
-        // Read the data from the fd.
-        char msg[MAX_MSG_SIZE] = {'\0'};
-
-        int c;
+        LineBatch_t batch = { .numMsgs = 0 };
+        int numReads = 0;
 
-        do
+        // Once the other end has gone away, read everything that's left.
+        while (isHungUp || (numReads < MAX_READS_PER_EVENT))
         {
-            c = read(fd, msg, sizeof(msg));
-        }
-        while ( (c == -1) && (errno == EINTR) );
+            ssize_t c;
 
-        if (c == -1)
-        {
-            LE_ERROR("Could not read fd log message for app/process '%s/%s[%d]'.  %m.",
-                     fdLogPtr->appName, fdLogPtr->procName, fdLogPtr->pid);
+            do
+            {
+                c = read(fd, FdReadBuff, sizeof(FdReadBuff));
+            }
+            while ( (c == -1) && (errno == EINTR) );
+
+            if (c > 0)
+            {
+                ProcessFdData(fdLogPtr, &batch, FdReadBuff, c);
+
+                // The lines in the batch point into the read buffer.
+                FlushLineBatch(fdLogPtr, &batch);
 
-            DeleteFdLog(fd, fdLogPtr);
+                numReads++;
+                if ((size_t)c < sizeof(FdReadBuff))
+                {
+                    // That's all there is for now.
+                    break;
+                }
+            }
+            else if (c == 0)
+            {
+                // End of file.
+                break;
+            }
+            else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                break;
+            }
+            else
+            {
+                LE_ERROR("Could not read fd log message for app/process '%s/%s[%d]'.  %m.",
+                         fdLogPtr->appName, fdLogPtr->procName, fdLogPtr->pid);
+
+                DeleteFdLog(fd, fdLogPtr);
+                return;
+            }
         }
 
-        // Log the data.
-        // TODO: Don't log the app name for now so that it matches all the other log formats.  Add
-        //       the app name to all log messages at the same time.
-        log_LogGenericMsg(fdLogPtr->level, fdLogPtr->procName, fdLogPtr->pid, msg);
+        // Don't hold on to the start of a line indefinitely waiting for its newline.
+        if (fdLogPtr->lineLen == 0)
+        {
+            le_timer_Stop(fdLogPtr->flushTimerRef);
+        }
+        else if (!le_timer_IsRunning(fdLogPtr->flushTimerRef))
+        {
+            le_timer_Start(fdLogPtr->flushTimerRef);
+        }
     }
 
-    if ( (events & POLLRDHUP) || (events & POLLERR) || (events & POLLHUP) )
+    if ( isHungUp || (events & POLLERR) )
     {
         LE_DEBUG("Error on app/proc '%s/%s' log fd, events=%d.  Cannot log from this fd.",
                 fdLogPtr->appName, fdLogPtr->procName, events);
@@ -2698,6 +3221,16 @@ static void CreateFdLogMonitor
 
     fdLogPtr->level = logLevel;
     fdLogPtr->pid = pid;
+    fdLogPtr->statsPtr = GetAppLogStats(fdLogPtr->appName);
+    fdLogPtr->lineLen = 0;
+
+    fdLogPtr->flushTimerRef = le_timer_Create(monitorNamePtr);
+    LE_ASSERT(le_timer_SetMsInterval(fdLogPtr->flushTimerRef, PARTIAL_LINE_FLUSH_MS) == LE_OK);
+    LE_ASSERT(le_timer_SetHandler(fdLogPtr->flushTimerRef, PartialLineTimerExpired) == LE_OK);
+    LE_ASSERT(le_timer_SetContextPtr(fdLogPtr->flushTimerRef, fdLogPtr) == LE_OK);
+
+    // Reads must not block when the fd has been drained.
+    fd_SetNonBlocking(fd);
 
     // Create the fd monitor.
     fdLogPtr->monitorRef = le_fdMonitor_Create(monitorNamePtr, fd, LogFdMessages, 0);
@@ -2800,6 +3333,7 @@ COMPONENT_INIT
     LogSessionPoolRef = le_mem_CreatePool("LogSession", sizeof(LogSession_t));
     TracePoolRef = le_mem_CreatePool("Traces", sizeof(Trace_t));
     FdLogPoolRef = le_mem_CreatePool("FdLogs", sizeof(FdLog_t));
+    AppLogStatsPoolRef = le_mem_CreatePool("AppLogStats", sizeof(AppLogStats_t));
 
     // Tune the pools' initial sizes to reduce warnings in the log at start-up.
     // TODO: Make this configurable.
@@ -2810,20 +3344,25 @@ COMPONENT_INIT
     le_mem_ExpandPool(LogSessionPoolRef, MAX_EXPECTED_COMPONENTS);
     le_mem_ExpandPool(TracePoolRef, MAX_EXPECTED_TRACES);
     le_mem_ExpandPool(FdLogPoolRef, MAX_EXPECTED_PROCESSES * 2); // Generally 2 fds per process (stderr, stdout).
-
-    // Create the hash maps.
-    ProcessNameMapRef = le_hashmap_Create("ProcessName",
-                                          MAX_EXPECTED_PROCESSES,
-                                          le_hashmap_HashString,
-                                          le_hashmap_EqualsString);
-    IpcSessionMapRef  = le_hashmap_Create("IPCSession",
-                                          MAX_EXPECTED_PROCESSES,
-                                          IpcSessionHash,
-                                          IpcSessionEquals);
-    ProcessIdMapRef   = le_hashmap_Create("ProcessID",
-                                          MAX_EXPECTED_PROCESSES,
-                                          ProcessIdHash,
-                                          ProcessIdEquals);
+    le_mem_ExpandPool(AppLogStatsPoolRef, MAX_EXPECTED_APPS);
+
+    // Create the hash maps.  These grow with the number of processes actually running.
+    ProcessNameMapRef = le_hashmap_CreateDynamic("ProcessName",
+                                                 MAX_EXPECTED_PROCESSES,
+                                                 le_hashmap_HashString,
+                                                 le_hashmap_EqualsString);
+    IpcSessionMapRef  = le_hashmap_CreateDynamic("IPCSession",
+                                                 MAX_EXPECTED_PROCESSES,
+                                                 IpcSessionHash,
+                                                 IpcSessionEquals);
+    ProcessIdMapRef   = le_hashmap_CreateDynamic("ProcessID",
+                                                 MAX_EXPECTED_PROCESSES,
+                                                 ProcessIdHash,
+                                                 ProcessIdEquals);
+    AppLogStatsMapRef = le_hashmap_CreateDynamic("AppLogStats",
+                                                 MAX_EXPECTED_APPS,
+                                                 le_hashmap_HashString,
+                                                 le_hashmap_EqualsString);
 
     // Get a reference to the Log Control Protocol identification.
     le_msg_ProtocolRef_t protocolRef = le_msg_GetProtocolRef(LOG_CONTROL_PROTOCOL_ID,
@@ -103,6 +103,7 @@
 //--------------------------------------------------------------------------------------------------
 #define LOG_CMD_LIST_COMPONENTS         'c' // No ProcessName, ComponentName, or CommandData
 #define LOG_CMD_FORGET_PROCESS          'x' // No ComponentName or CommandData
+#define LOG_CMD_GET_STATS               's' // No ProcessName, ComponentName, or CommandData
 
 
 // =======================================================
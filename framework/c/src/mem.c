@@ -30,6 +30,20 @@
  * delete a sub-pool while there are still blocks allocated from it.  The sub-pool itself is then
  * removed from the list of pools and released back into the pool of sub-pools.
  *
+ * PER-THREAD CACHES
+ * =================
+ *
+ * A pool can be given per-thread caches using le_mem_EnableThreadCache().  Each thread that
+ * allocates from or releases to such a pool gets its own small stack of free blocks (its "cache")
+ * for that pool, which it can pop from and push onto without locking the mutex.  The mutex is only
+ * taken when a thread's cache runs empty (it is then refilled with a batch of blocks from the
+ * pool's free list) or grows beyond the configured size (half of it is then drained back into the
+ * pool's free list).  Statistics gathered while working out of a cache are folded into the pool's
+ * statistics at those same points, so the pool object is still the only place they are read from.
+ *
+ * Reference counts on blocks from cached pools are updated using atomic operations, because the
+ * mutex is not held when they are changed.
+ *
  * GUARD BANDS
  * ===========
  *
@@ -63,6 +77,9 @@
 /// @todo Make this configurable.
 #define DEFAULT_SUB_POOLS_POOL_SIZE     8
 
+/// The default number of Thread Cache objects in the Thread Caches Pool.
+#define DEFAULT_THREAD_CACHES_POOL_SIZE 8
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -110,6 +127,29 @@ typedef struct
 MemBlock_t;
 
 
+#ifndef LE_MEM_VALGRIND
+//--------------------------------------------------------------------------------------------------
+/**
+ * A thread's cache of free blocks for a pool that has per-thread caching enabled.
+ *
+ * Only the thread that owns the cache ever touches it, except for the counters, which are folded
+ * into the pool (with the mutex locked) whenever the thread refills or drains its cache.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct ThreadCache
+{
+    struct ThreadCache* nextPtr;    ///< The thread's next cache (for another pool).
+    MemPool_t*      poolPtr;        ///< The pool that this cache holds blocks for.
+    le_sls_List_t   freeList;       ///< List of free blocks held by this thread.
+    size_t          numFree;        ///< Number of blocks on the free list.
+    uint64_t        numAllocs;      ///< Allocations from this cache since the last sync.
+    uint64_t        numHits;        ///< Allocations that didn't need a refill since the last sync.
+    uint64_t        numReleases;    ///< Releases into this cache since the last sync.
+}
+ThreadCache_t;
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Local list of all memory pools created with le_mem_CreatePool and le_mem_CreateSubPool
@@ -136,6 +176,25 @@ static size_t* ListOfPoolsChgCntRef = &ListOfPoolsChgCnt;
 static le_mem_PoolRef_t SubPoolsPool;
 
 
+#ifndef LE_MEM_VALGRIND
+//--------------------------------------------------------------------------------------------------
+/**
+ * Local memory pool that is used for allocating per-thread caches.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ThreadCachePool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key used to find the first of the calling thread's caches.  A thread's caches are chained
+ * together through their nextPtr, most recently used first.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_key_t ThreadCacheKey;
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Pthreads fast mutex used to protect data structures in this module from multithreading races.
@@ -309,6 +368,10 @@ static void InitPool
     pool->numBlocksInUse = 0;
     pool->maxNumBlocksUsed = 0;
     pool->numBlocksToForce = DEFAULT_NUM_BLOCKS_TO_FORCE;
+    pool->cacheSize = 0;
+    pool->numBlocksCached = 0;
+    pool->numCacheHits = 0;
+    pool->numCacheMisses = 0;
 
     #ifdef LE_MEM_TRACE
         pool->memTrace = NULL;
@@ -439,6 +502,295 @@ static void InitBlock
 #endif
 
 
+#ifndef LE_MEM_VALGRIND
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Folds the statistics that a thread has gathered in its cache into the pool's statistics.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void SyncThreadCache
+    (
+        ThreadCache_t* cachePtr     ///< [IN] The thread's cache.
+    )
+    {
+        MemPool_t* poolPtr = cachePtr->poolPtr;
+
+        poolPtr->numAllocations += cachePtr->numAllocs;
+        poolPtr->numCacheHits += cachePtr->numHits;
+
+        // Blocks allocated from the cache moved from "cached" to "in use", and blocks released
+        // into the cache moved the other way.  Note that a block allocated by one thread may be
+        // released into another thread's cache, so these can be transiently out of step until
+        // both threads have synced.
+        poolPtr->numBlocksInUse += cachePtr->numAllocs;
+        poolPtr->numBlocksInUse -= cachePtr->numReleases;
+        poolPtr->numBlocksCached -= cachePtr->numAllocs;
+        poolPtr->numBlocksCached += cachePtr->numReleases;
+
+        if (   (poolPtr->numBlocksInUse <= poolPtr->totalBlocks)
+            && (poolPtr->numBlocksInUse > poolPtr->maxNumBlocksUsed)  )
+        {
+            poolPtr->maxNumBlocksUsed = poolPtr->numBlocksInUse;
+        }
+
+        cachePtr->numAllocs = 0;
+        cachePtr->numHits = 0;
+        cachePtr->numReleases = 0;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Moves a batch of free blocks from the pool's free list into a thread's cache.  Moves fewer
+     * (possibly none) if the pool's free list doesn't have enough blocks.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void RefillThreadCache
+    (
+        ThreadCache_t* cachePtr     ///< [IN] The thread's cache.
+    )
+    {
+        MemPool_t* poolPtr = cachePtr->poolPtr;
+        size_t batchSize = (poolPtr->cacheSize + 1) / 2;
+        size_t i;
+
+        for (i = 0; i < batchSize; i++)
+        {
+            le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(poolPtr->freeList));
+
+            if (blockLinkPtr == NULL)
+            {
+                break;
+            }
+
+            le_sls_Stack(&(cachePtr->freeList), blockLinkPtr);
+        }
+
+        cachePtr->numFree += i;
+        poolPtr->numBlocksCached += i;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Moves free blocks from a thread's cache back onto the pool's free list.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void DrainThreadCache
+    (
+        ThreadCache_t* cachePtr,    ///< [IN] The thread's cache.
+        size_t numBlocks            ///< [IN] The number of blocks to move back to the pool.
+    )
+    {
+        MemPool_t* poolPtr = cachePtr->poolPtr;
+        size_t i;
+
+        for (i = 0; i < numBlocks; i++)
+        {
+            le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(cachePtr->freeList));
+
+            LE_ASSERT(blockLinkPtr != NULL);
+
+            le_sls_Stack(&(poolPtr->freeList), blockLinkPtr);
+        }
+
+        cachePtr->numFree -= numBlocks;
+        poolPtr->numBlocksCached -= numBlocks;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Destructor for a thread's list of caches.  Called by pthreads when the thread dies.  Returns
+     * all the cached blocks to their pools.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void ThreadCacheDestructor
+    (
+        void* objPtr    ///< [IN] Pointer to the thread's first cache.
+    )
+    {
+        ThreadCache_t* cachePtr = objPtr;
+
+        while (cachePtr != NULL)
+        {
+            ThreadCache_t* nextPtr = cachePtr->nextPtr;
+
+            Lock();
+            SyncThreadCache(cachePtr);
+            DrainThreadCache(cachePtr, cachePtr->numFree);
+            Unlock();
+
+            le_mem_Release(cachePtr);
+
+            cachePtr = nextPtr;
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Gets the calling thread's cache for a given pool, creating it if the thread doesn't have one
+     * yet.  The cache is moved to the front of the thread's list so that the pools a thread uses
+     * most are found first.
+     *
+     * @return Pointer to the cache.
+     */
+    //----------------------------------------------------------------------------------------------
+    static ThreadCache_t* GetThreadCache
+    (
+        MemPool_t* poolPtr      ///< [IN] The pool (must have per-thread caching enabled).
+    )
+    {
+        ThreadCache_t* firstPtr = pthread_getspecific(ThreadCacheKey);
+
+        if ((firstPtr != NULL) && (firstPtr->poolPtr == poolPtr))
+        {
+            return firstPtr;
+        }
+
+        ThreadCache_t* prevPtr = firstPtr;
+        ThreadCache_t* cachePtr = NULL;
+
+        while (prevPtr != NULL)
+        {
+            if ((prevPtr->nextPtr != NULL) && (prevPtr->nextPtr->poolPtr == poolPtr))
+            {
+                cachePtr = prevPtr->nextPtr;
+                prevPtr->nextPtr = cachePtr->nextPtr;
+                break;
+            }
+
+            prevPtr = prevPtr->nextPtr;
+        }
+
+        if (cachePtr == NULL)
+        {
+            cachePtr = le_mem_ForceAlloc(ThreadCachePool);
+
+            cachePtr->poolPtr = poolPtr;
+            cachePtr->freeList = LE_SLS_LIST_INIT;
+            cachePtr->numFree = 0;
+            cachePtr->numAllocs = 0;
+            cachePtr->numHits = 0;
+            cachePtr->numReleases = 0;
+        }
+
+        cachePtr->nextPtr = firstPtr;
+        LE_ASSERT(pthread_setspecific(ThreadCacheKey, cachePtr) == 0);
+
+        return cachePtr;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Allocates a block from the calling thread's cache for a given pool, refilling the cache
+     * from the pool if it is empty.
+     *
+     * @return Pointer to the block, or NULL if neither the cache nor the pool has any free blocks.
+     */
+    //----------------------------------------------------------------------------------------------
+    static MemBlock_t* AllocFromThreadCache
+    (
+        MemPool_t* poolPtr      ///< [IN] The pool (must have per-thread caching enabled).
+    )
+    {
+        ThreadCache_t* cachePtr = GetThreadCache(poolPtr);
+
+        le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(cachePtr->freeList));
+
+        if (blockLinkPtr == NULL)
+        {
+            Lock();
+
+            poolPtr->numCacheMisses++;
+            SyncThreadCache(cachePtr);
+            RefillThreadCache(cachePtr);
+
+            Unlock();
+
+            blockLinkPtr = le_sls_Pop(&(cachePtr->freeList));
+
+            if (blockLinkPtr == NULL)
+            {
+                return NULL;
+            }
+        }
+        else
+        {
+            cachePtr->numHits++;
+        }
+
+        cachePtr->numFree--;
+        cachePtr->numAllocs++;
+
+        return CONTAINER_OF(blockLinkPtr, MemBlock_t, link);
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Releases a block from a pool that has per-thread caching enabled.  If this was the last
+     * reference, the block is destructed and put into the calling thread's cache, and the cache
+     * is drained back into the pool if it has grown too large.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void ReleaseToThreadCache
+    (
+        MemBlock_t* blockPtr,   ///< [IN] The block to release.
+        void*       objPtr      ///< [IN] Pointer to the user object in the block.
+    )
+    {
+        MemPool_t* poolPtr = blockPtr->poolPtr;
+
+        size_t oldRefCount = __atomic_fetch_sub(&(blockPtr->refCount), 1, __ATOMIC_ACQ_REL);
+
+        if (oldRefCount > 1)
+        {
+            return;
+        }
+
+        if (oldRefCount == 0)
+        {
+            LE_EMERG("Releasing free block.");
+            LE_FATAL("Free block released from pool %p (%s).", poolPtr, poolPtr->name);
+        }
+
+        // The mutex isn't held here, so the destructor is free to use the memory pool API.
+        if (poolPtr->destructor)
+        {
+            poolPtr->destructor(objPtr);
+        }
+
+        ThreadCache_t* cachePtr = GetThreadCache(poolPtr);
+
+        le_sls_Stack(&(cachePtr->freeList), &(blockPtr->link));
+        cachePtr->numFree++;
+        cachePtr->numReleases++;
+
+        if (cachePtr->numFree > poolPtr->cacheSize)
+        {
+            Lock();
+
+            SyncThreadCache(cachePtr);
+            DrainThreadCache(cachePtr, cachePtr->numFree - (poolPtr->cacheSize / 2));
+
+            Unlock();
+        }
+    }
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Log an error message if there is another pool with the same name as a given pool.
@@ -490,6 +842,13 @@ void mem_Init
     SubPoolsPool = le_mem_CreatePool("SubPools", sizeof(MemPool_t));
     le_mem_ExpandPool(SubPoolsPool, DEFAULT_SUB_POOLS_POOL_SIZE);
 
+    #ifndef LE_MEM_VALGRIND
+        // Create a memory pool for all per-thread caches.
+        ThreadCachePool = le_mem_CreatePool("ThreadCaches", sizeof(ThreadCache_t));
+        le_mem_ExpandPool(ThreadCachePool, DEFAULT_THREAD_CACHES_POOL_SIZE);
+        LE_ASSERT(pthread_key_create(&ThreadCacheKey, ThreadCacheDestructor) == 0);
+    #endif
+
     // Pass the list of mem pools to the Inspect tool.
     spy_SetListOfPools(&ListOfPools);
 
@@ -711,6 +1070,29 @@ void* le_mem_TryAlloc
     MemBlock_t* blockPtr = NULL;
     void* userPtr = NULL;
 
+    #ifndef LE_MEM_VALGRIND
+        // Pools with per-thread caching enabled are allocated from without locking the mutex.
+        // The pool's statistics are updated when the thread's cache is next synchronized.
+        if (pool->cacheSize != 0)
+        {
+            blockPtr = AllocFromThreadCache(pool);
+
+            if (blockPtr == NULL)
+            {
+                return NULL;
+            }
+
+            blockPtr->refCount = 1;
+
+            #ifdef USE_GUARD_BAND
+                CheckGuardBands(blockPtr);
+                return blockPtr->data + GUARD_BAND_SIZE;
+            #else
+                return blockPtr->data;
+            #endif
+        }
+    #endif
+
     Lock();
 
     #ifndef LE_MEM_VALGRIND
@@ -855,6 +1237,37 @@ void le_mem_SetNumObjsToForce
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables per-thread caching of free objects for a pool, or changes the size of the per-thread
+ * caches if caching is already enabled.
+ *
+ * @return
+ *      Nothing.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_EnableThreadCache
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] The pool.
+    size_t              numObjects  ///< [IN] The maximum number of free objects each thread may
+                                    ///       keep in its cache for this pool (must be non-zero).
+)
+{
+    LE_ASSERT(pool != NULL);
+    LE_ASSERT(numObjects != 0);
+
+    #ifndef LE_MEM_VALGRIND
+        LE_FATAL_IF(pool->superPoolPtr != NULL,
+                    "Per-thread caching can't be enabled on sub-pool '%s'.",
+                    pool->name);
+
+        Lock();
+        pool->cacheSize = numObjects;
+        Unlock();
+    #endif
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Releases an object.  If the object's reference count has reached zero, it will be destructed
@@ -890,6 +1303,14 @@ void le_mem_Release
         CheckGuardBands(blockPtr);
     #endif
 
+    #ifndef LE_MEM_VALGRIND
+        if (blockPtr->poolPtr->cacheSize != 0)
+        {
+            ReleaseToThreadCache(blockPtr, objPtr);
+            return;
+        }
+    #endif
+
     Lock();
 
     switch (blockPtr->refCount)
@@ -970,6 +1391,15 @@ void le_mem_AddRef
         CheckGuardBands(memBlockPtr);
     #endif
 
+    #ifndef LE_MEM_VALGRIND
+        // Reference counts of blocks from cached pools are changed without holding the mutex.
+        if (memBlockPtr->poolPtr->cacheSize != 0)
+        {
+            LE_ASSERT(__atomic_fetch_add(&(memBlockPtr->refCount), 1, __ATOMIC_RELAXED) != 0);
+            return;
+        }
+    #endif
+
     Lock();
 
     LE_ASSERT(memBlockPtr->refCount != 0);
@@ -1022,11 +1452,31 @@ void le_mem_GetStats
 
     Lock();
 
+    // For cached pools, the in-use count can transiently wrap below zero when a block is released
+    // into one thread's cache before the thread that allocated it has synchronized with the pool.
+    size_t numBlocksInUse = pool->numBlocksInUse;
+
+    if (numBlocksInUse > pool->totalBlocks)
+    {
+        numBlocksInUse = 0;
+    }
+
+    // The cached count can wrap in the same way.
+    size_t numBlocksCached = pool->numBlocksCached;
+
+    if (numBlocksCached > pool->totalBlocks)
+    {
+        numBlocksCached = 0;
+    }
+
     statsPtr->numAllocs = pool->numAllocations;
     statsPtr->numOverflows = pool->numOverflows;
-    statsPtr->numFree = pool->totalBlocks - pool->numBlocksInUse;
-    statsPtr->numBlocksInUse = pool->numBlocksInUse;
+    statsPtr->numFree = pool->totalBlocks - numBlocksInUse;
+    statsPtr->numBlocksInUse = numBlocksInUse;
+    statsPtr->numCached = numBlocksCached;
     statsPtr->maxNumBlocksUsed = pool->maxNumBlocksUsed;
+    statsPtr->numCacheHits = pool->numCacheHits;
+    statsPtr->numCacheMisses = pool->numCacheMisses;
 
     Unlock();
 }
@@ -1050,6 +1500,8 @@ void le_mem_ResetStats
     Lock();
     pool->numAllocations = 0;
     pool->numOverflows = 0;
+    pool->numCacheHits = 0;
+    pool->numCacheMisses = 0;
     Unlock();
 }
 
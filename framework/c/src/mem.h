@@ -40,6 +40,13 @@ typedef struct le_mem_Pool
     size_t maxNumBlocksUsed;            ///< Maximum number of allocated blocks at any one time.
     size_t numBlocksToForce;            ///< Number of blocks that is added when Force Alloc
                                         ///  expands the pool.
+    size_t cacheSize;                   ///< Max number of free blocks kept in each thread's cache
+                                        ///  for this pool (0 = per-thread caching disabled).
+    size_t numBlocksCached;             ///< Number of free blocks held in per-thread caches, as of
+                                        ///  the last time a thread synchronized with the pool.
+    uint64_t numCacheHits;              ///< Number of allocations served from a thread's cache.
+    uint64_t numCacheMisses;            ///< Number of allocations that had to refill a thread's
+                                        ///  cache from the pool's free list.
     #ifdef LE_MEM_TRACE
         le_log_TraceRef_t memTrace;     ///< If tracing is enabled, keeps track of a trace object
                                         ///  for this pool.
@@ -53,6 +53,23 @@
  * exhausted and attempts to send a message return EAGAIN or EWOULDBLOCK, the Message object is
  * placed on a queue for that socket (in the Session object) and the messaging system waits for
  * notification from the Event Loop that the socket has become clear-to-send before trying again.
+ * Any messages sent on that session in the meantime are added to the queue without trying to
+ * send them, and when the socket becomes writeable the queue is drained in batches using one
+ * sendmmsg() system call per batch.  Likewise, received messages are read using recvmmsg(),
+ * which picks up as many messages as are already waiting (up to a batch limit) in one system
+ * call.  Each Session object counts the messages sent and received and the system calls used
+ * to do so, and these counts are traced (using the "messaging" trace keyword) when the session
+ * closes.
+ *
+ * If shared memory has been enabled for a protocol (see le_msg_EnableSharedMemory()), each side
+ * of a session offers the other a memfd-backed region (see messagingSharedMem.h) when the session
+ * opens, using control messages that carry reserved (even-numbered) transaction IDs.  Once the
+ * other side has accepted, payloads above the protocol's threshold are copied into a slot in that
+ * region and only a small descriptor holding the slot's offset is sent through the socket.  If the
+ * region is full, the payload is sent through the socket as usual.  The receiver checks each
+ * descriptor against the slots it has already received, and copies the payload out into the
+ * message's payload buffer before giving the slot back, so the sender can't change a payload
+ * while it is being unpacked.
  *
  * Another potential deadlock occurs when two threads are sending messages to each other.
  * If they both send a lot of messages to each other, they can both get blocked waiting for the
@@ -117,6 +134,7 @@ void msg_Init
 {
     msgProto_Init();
     msgMessage_Init();
+    msgShm_Init();
     msgInterface_Init();
     msgSession_Init();
 }
@@ -67,6 +67,82 @@ static void MessageDestructor
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a Message object from a Session's Protocol's Message Pool.  Only the bufferSize member
+ * is initialized.
+ *
+ * @return  Pointer to the Message object.
+ */
+//--------------------------------------------------------------------------------------------------
+static Message_t* AllocMessage
+(
+    le_msg_SessionRef_t sessionRef  ///< [in] Reference to the session.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_msg_ProtocolRef_t protocolRef = le_msg_GetSessionProtocol(sessionRef);
+    Message_t* msgPtr = msgProto_AllocMessage(protocolRef);
+
+    msgPtr->bufferSize = le_msg_GetProtocolMaxMsgSize(protocolRef);
+
+    return msgPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the members of a new Message object, other than its payload.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitMessage
+(
+    Message_t* msgPtr,
+    le_msg_SessionRef_t sessionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgPtr->link = LE_DLS_LINK_INIT;
+    msgPtr->sessionRef = sessionRef;
+    le_mem_AddRef(sessionRef);  // Message object holds a reference to the Session object.
+
+    msgInterface_Type_t interfaceType = msgSession_GetInterfaceType(sessionRef);
+    switch (interfaceType)
+    {
+        case LE_MSG_INTERFACE_CLIENT:
+            msgPtr->clientServer.client.completionCallback = NULL;
+            msgPtr->clientServer.client.contextPtr = NULL;
+            break;
+
+        case LE_MSG_INTERFACE_SERVER:
+            msgPtr->clientServer.server.responseFd = -1;
+            break;
+
+        default:
+            LE_FATAL("Unhandled interface type (%d).", interfaceType);
+    }
+
+    msgPtr->fd = -1;
+    msgPtr->txnId = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of payload bytes that were received, given the number of bytes received from
+ * the socket (which includes the transaction ID).
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t ReceivedPayloadSize
+(
+    size_t byteCount
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (byteCount > sizeof(void*)) ? (byteCount - sizeof(void*)) : 0;
+}
+
+
 // =======================================
 //  PROTECTED (INTER-MODULE) FUNCTIONS
 // =======================================
@@ -118,10 +194,65 @@ le_mem_PoolRef_t msgMessage_CreatePool
 
     le_mem_ExpandPool(poolRef, 10); /// @todo Make this configurable.
 
+    // Messages are often created on one thread and released on another (e.g., the IPC thread),
+    // so keep a few free ones per thread to avoid contending on the memory pool lock.
+    le_mem_EnableThreadCache(poolRef, 4); /// @todo Make this configurable.
+
     return poolRef;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Message object to receive a message into.  This is like le_msg_CreateMsg(), except
+ * that the payload buffer isn't cleared.  msgMessage_FinishReceive() must be called once a
+ * message has been received into it.
+ *
+ * @return  The message reference.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t msgMessage_CreateRxMsg
+(
+    le_msg_SessionRef_t sessionRef  ///< [in] Reference to the session.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Message_t* msgPtr = AllocMessage(sessionRef);
+
+    InitMessage(msgPtr, sessionRef);
+    msgPtr->payloadSize = 0;
+
+    return msgPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finishes receiving a message, once any payload that was passed through shared memory has been
+ * copied into it.  Clears the part of the payload buffer that wasn't received into, so the
+ * receiver always sees a full-sized payload buffer, with whatever wasn't sent filled with zeros.
+ * (The generated unpack code relies on this, because it doesn't check the payload size.)
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_FinishReceive
+(
+    le_msg_MessageRef_t msgRef      ///< [in] The received message.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    memset((uint8_t*)msgRef->payload + msgRef->payloadSize,
+           0,
+           msgRef->bufferSize - msgRef->payloadSize);
+
+    // On the server side, the response is built in the same buffer, and is sent in full unless
+    // the server says how much of it is used.
+    if (msgSession_GetInterfaceType(msgRef->sessionRef) == LE_MSG_INTERFACE_SERVER)
+    {
+        msgRef->payloadSize = msgRef->bufferSize;
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Send a single message over a connected socket.
@@ -142,27 +273,12 @@ le_result_t msgMessage_Send
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // If this is a response message,
-    if (le_msg_NeedsResponse(msgPtr))
-    {
-        // If there was an fd that was received from the client but not fetched from the message
-        // generate a warning and close that fd.
-        if (msgPtr->fd >= 0)
-        {
-            LE_WARN("File descriptor not retrieved from message received from client.");
-            fd_Close(msgPtr->fd);
-        }
-
-        // Move the responseFd to the normal fd position in the message object.
-        msgPtr->fd = msgPtr->clientServer.server.responseFd;
-        msgPtr->clientServer.server.responseFd = -1;
-    }
-
     // The first bytes come from our transaction ID and the rest (if any)
-    // from our Message object's payload section, which comes right after the transaction ID.
+    // from the used part of our Message object's payload section, which comes right after the
+    // transaction ID.
     return unixSocket_SendMsg(  socketFd,
                                 &msgPtr->txnId,
-                                sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgPtr),
+                                sizeof(msgPtr->txnId) + msgPtr->payloadSize,
                                 msgPtr->fd,
                                 false   ); // Don't send process credentials.
 }
@@ -188,12 +304,13 @@ le_result_t msgMessage_Receive
 {
     // Receive the first bytes into our transaction ID and the rest (if any)
     // into our Message object's payload section.
-    size_t byteCount = sizeof(msgRef->txnId) + le_msg_GetMaxPayloadSize(msgRef);
+    size_t byteCount = sizeof(msgRef->txnId) + msgRef->bufferSize;
     le_result_t result = unixSocket_ReceiveMsg( socketFd,
                                                 &msgRef->txnId,
                                                 &byteCount,
                                                 &msgRef->fd,
                                                 NULL    );  // Don't receive credentials.
+    msgRef->payloadSize = ReceivedPayloadSize(byteCount);
     if (msgSession_GetInterfaceType(msgRef->sessionRef) == LE_MSG_INTERFACE_SERVER)
     {
         msgRef->clientServer.server.responseFd = -1;
@@ -203,6 +320,225 @@ le_result_t msgMessage_Receive
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a batch of messages over a connected socket using a single system call.
+ *
+ * Fewer messages than requested may be sent, in which case the caller should call again to
+ * send the rest.
+ *
+ * If a shared memory region is given, payloads that are at least as big as the protocol's
+ * shared memory threshold are copied into it (if there is room) and only a descriptor is sent
+ * through the socket in their place.
+ *
+ * @return
+ * - LE_OK if at least one message was sent (check *numSentPtr).
+ * - LE_NO_MEMORY if the socket doesn't have enough send buffer space available right now.
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_SendBatch
+(
+    int                 socketFd,   ///< [IN] Connected socket's file descriptor.
+    le_msg_MessageRef_t msgList[],  ///< [IN] The Messages to be sent.
+    size_t              numMsgs,    ///< [IN] Number of Messages (1 to UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t*             numSentPtr, ///< [OUT] Number of Messages from the start of the list that
+                                    ///        were sent.
+    msgShm_RegionRef_t  shmRef      ///< [IN] Shared memory region to pass large payloads through
+                                    ///       (NULL = send everything through the socket).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    unixSocket_BatchMsg_t batch[UNIXSOCKET_MAX_BATCH_MSGS];
+    // Transaction ID followed by descriptor, laid out the same way as a received Message object's
+    // transaction ID and payload.
+    uint8_t shmMsg[UNIXSOCKET_MAX_BATCH_MSGS][sizeof(void*) + sizeof(msgShm_Descriptor_t)];
+    uint64_t shmStartPos[UNIXSOCKET_MAX_BATCH_MSGS];
+    bool isShm[UNIXSOCKET_MAX_BATCH_MSGS];
+    size_t shmThreshold = 0;
+    size_t i;
+
+    LE_ASSERT(numMsgs <= NUM_ARRAY_MEMBERS(batch));
+
+    if (shmRef != NULL)
+    {
+        shmThreshold = msgProto_GetSharedMemThreshold(
+                                                le_msg_GetSessionProtocol(msgList[0]->sessionRef));
+    }
+
+    // The first bytes of each come from the transaction ID and the rest (if any)
+    // from the Message object's payload section, which comes right after the transaction ID.
+    for (i = 0; i < numMsgs; i++)
+    {
+        size_t payloadSize = msgList[i]->payloadSize;
+
+        isShm[i] = false;
+
+        // Messages used internally by the messaging system are always sent through the socket.
+        if (   (shmRef != NULL)
+            && (payloadSize >= shmThreshold)
+            && !msgMessage_IsControlMsg(msgList[i]) )
+        {
+            msgShm_Descriptor_t desc;
+
+            shmStartPos[i] = msgShm_GetHead(shmRef);
+            isShm[i] = msgShm_Write(shmRef, msgList[i]->payload, payloadSize, &desc);
+
+            if (isShm[i])
+            {
+                void* txnId = MSG_TXN_ID_SHM_PAYLOAD;
+
+                desc.txnId = msgList[i]->txnId;
+                memcpy(shmMsg[i], &txnId, sizeof(txnId));
+                memcpy(shmMsg[i] + sizeof(txnId), &desc, sizeof(desc));
+
+                batch[i].dataPtr = shmMsg[i];
+                batch[i].dataSize = sizeof(shmMsg[i]);
+            }
+        }
+
+        if (!isShm[i])
+        {
+            batch[i].dataPtr = &msgList[i]->txnId;
+            batch[i].dataSize = sizeof(msgList[i]->txnId) + payloadSize;
+        }
+
+        batch[i].fd = msgList[i]->fd;
+    }
+
+    le_result_t result = unixSocket_SendMsgBatch(socketFd, batch, numMsgs, numSentPtr);
+
+    if (shmRef != NULL)
+    {
+        size_t numSent = (result == LE_OK) ? *numSentPtr : 0;
+
+        for (i = numSent; i < numMsgs; i++)
+        {
+            if (isShm[i])
+            {
+                // Free the slots used by this payload and all the ones after it. They will be
+                // written again when they are sent.
+                size_t numUnsent = 0;
+                size_t j;
+
+                for (j = i; j < numMsgs; j++)
+                {
+                    numUnsent += isShm[j];
+                }
+
+                msgShm_Rewind(shmRef, shmStartPos[i], numUnsent);
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a received message's payload out of shared memory into its payload buffer, replacing
+ * the descriptor that was received in its place.
+ *
+ * @return
+ * - LE_OK if successful.
+ * - LE_FAULT if the descriptor is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_UnpackSharedMem
+(
+    le_msg_MessageRef_t msgRef,     ///< [IN] Message with transaction ID MSG_TXN_ID_SHM_PAYLOAD.
+    msgShm_RegionRef_t  shmRef      ///< [IN] Shared memory region received from the sender.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgShm_Descriptor_t desc;
+
+    if (msgRef->payloadSize < sizeof(desc))
+    {
+        return LE_FAULT;
+    }
+
+    memcpy(&desc, msgRef->payload, sizeof(desc));
+
+    le_result_t result = msgShm_Read(shmRef, &desc, msgRef->payload, msgRef->bufferSize);
+
+    if (result == LE_OK)
+    {
+        msgRef->txnId = desc.txnId;
+        msgRef->payloadSize = desc.size;
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive a batch of messages from a connected socket using a single system call.
+ *
+ * Waits for the first message like msgMessage_Receive() would, then receives as many more as
+ * have already arrived, up to the number of Message objects provided.
+ *
+ * @return
+ * - LE_OK if at least one message was received (check *numMsgsPtr and resultList).
+ * - LE_WOULD_BLOCK if there's nothing there to receive and the socket is set non-blocking.
+ * - LE_CLOSED if the connection has closed.
+ * - LE_FAULT if an error was encountered.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_ReceiveBatch
+(
+    int                 socketFd,   ///< [IN] The socket's file descriptor.
+    le_msg_MessageRef_t msgList[],  ///< [IN] Message objects to store the received messages in.
+    le_result_t         resultList[],///< [OUT] Result for each Message object that was received
+                                    ///     into (LE_OK, LE_NO_MEMORY if truncated, or LE_CLOSED).
+    size_t*             numMsgsPtr  ///< [IN+OUT] Number of Message objects in the list
+                                    ///     (1 to UNIXSOCKET_MAX_BATCH_MSGS).  Updated to the
+                                    ///     number of messages received.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    unixSocket_BatchMsg_t batch[UNIXSOCKET_MAX_BATCH_MSGS];
+    size_t numMsgs = *numMsgsPtr;
+    size_t i;
+
+    LE_ASSERT(numMsgs <= NUM_ARRAY_MEMBERS(batch));
+
+    *numMsgsPtr = 0;
+
+    // Receive the first bytes of each into the transaction ID and the rest (if any)
+    // into the Message object's payload section.
+    for (i = 0; i < numMsgs; i++)
+    {
+        batch[i].dataPtr = &msgList[i]->txnId;
+        batch[i].dataSize = sizeof(msgList[i]->txnId) + msgList[i]->bufferSize;
+    }
+
+    le_result_t result = unixSocket_ReceiveMsgBatch(socketFd, batch, numMsgs, numMsgsPtr);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    for (i = 0; i < *numMsgsPtr; i++)
+    {
+        msgList[i]->fd = batch[i].fd;
+        msgList[i]->payloadSize = ReceivedPayloadSize(batch[i].dataSize);
+        resultList[i] = batch[i].result;
+
+        if (msgSession_GetInterfaceType(msgList[i]->sessionRef) == LE_MSG_INTERFACE_SERVER)
+        {
+            msgList[i]->clientServer.server.responseFd = -1;
+        }
+    }
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Call the completion callback function for a given message, if it has one.
@@ -245,35 +581,15 @@ le_msg_MessageRef_t le_msg_CreateMsg
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Get a reference to the Session's Protocol and ask the Protocol to allocate a Message
-    // object from its Message Pool.
-    le_msg_ProtocolRef_t protocolRef = le_msg_GetSessionProtocol(sessionRef);
-    Message_t* msgPtr = msgProto_AllocMessage(protocolRef);
+    // Allocate a Message object from the Session's Protocol's Message Pool.
+    Message_t* msgPtr = AllocMessage(sessionRef);
 
     // Initialize the Message object's data members.
-    msgPtr->link = LE_DLS_LINK_INIT;
-    msgPtr->sessionRef = sessionRef;
-    le_mem_AddRef(sessionRef);  // Message object holds a reference to the Session object.
-
-    msgInterface_Type_t interfaceType = msgSession_GetInterfaceType(sessionRef);
-    switch (interfaceType)
-    {
-        case LE_MSG_INTERFACE_CLIENT:
-            msgPtr->clientServer.client.completionCallback = NULL;
-            msgPtr->clientServer.client.contextPtr = NULL;
-            break;
+    InitMessage(msgPtr, sessionRef);
 
-        case LE_MSG_INTERFACE_SERVER:
-            msgPtr->clientServer.server.responseFd = -1;
-            break;
-
-        default:
-            LE_FATAL("Unhandled interface type (%d).", interfaceType);
-    }
-
-    msgPtr->fd = -1;
-    msgPtr->txnId = 0;
-    memset(msgPtr->payload, 0, le_msg_GetProtocolMaxMsgSize(protocolRef));
+    // Unless told otherwise, the whole payload buffer gets sent.
+    msgPtr->payloadSize = msgPtr->bufferSize;
+    memset(msgPtr->payload, 0, msgPtr->bufferSize);
 
     return msgPtr;
 }
@@ -368,7 +684,31 @@ size_t le_msg_GetMaxPayloadSize
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return le_msg_GetProtocolMaxMsgSize(le_msg_GetSessionProtocol(msgRef->sessionRef));
+    return msgRef->bufferSize;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the number of bytes at the start of the message payload buffer that are to be sent.
+ * By default, the whole payload buffer is sent.
+ *
+ * @note The receiver sees the rest of its payload buffer filled with zeros.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_msg_SetPayloadSize
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t              size        ///< [in] Number of payload bytes to send.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_FATAL_IF(size > msgRef->bufferSize,
+                "Payload size %zu is larger than the payload buffer (%zu bytes).",
+                size,
+                msgRef->bufferSize);
+
+    msgRef->payloadSize = size;
 }
 
 
@@ -562,6 +902,20 @@ void le_msg_Respond
     LE_FATAL_IF(!le_msg_NeedsResponse(msgRef),
                 "Attempt to respond to a message that doesn't need a response.");
 
+    // If there was an fd that was received from the client but not fetched from the message
+    // generate a warning and close that fd.
+    if (msgRef->fd >= 0)
+    {
+        LE_WARN("File descriptor not retrieved from message received from client.");
+        fd_Close(msgRef->fd);
+    }
+
+    // Move the responseFd to the normal fd position in the message object.
+    // NOTE: This is done here rather than when the message is sent, because a message may have
+    //       to be sent more than once if the socket's send buffer fills up.
+    msgRef->fd = msgRef->clientServer.server.responseFd;
+    msgRef->clientServer.server.responseFd = -1;
+
     // Send the response message.
     msgSession_SendMessage(msgRef->sessionRef, msgRef);
 }
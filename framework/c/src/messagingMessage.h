@@ -8,6 +8,8 @@
 #ifndef LEGATO_MESSAGING_MESSAGE_H_INCLUDE_GUARD
 #define LEGATO_MESSAGING_MESSAGE_H_INCLUDE_GUARD
 
+#include "messagingSharedMem.h"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Represents a message.
@@ -41,12 +43,27 @@ typedef struct le_msg_Message
     clientServer;
 
     int                         fd;         ///< File descriptor to send or received (-1 = no fd)
+    size_t                      bufferSize; ///< Size of the payload buffer, in bytes.
+    size_t                      payloadSize;///< Number of payload bytes to be sent, or received.
     void*                       txnId;      ///< Safe reference value used as a transaction ID.
     void*                       payload[0]; ///< Variable-length payload buffer appears at the end.
 }
 Message_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Transaction IDs reserved for messages that are used internally by the messaging system.
+ *
+ * Transaction IDs are Safe References, which are always odd, so even non-zero values are free
+ * to be used for this.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSG_TXN_ID_SHM_OFFER    ((void*)2)  ///< Offers a shared memory region (sent as the fd).
+#define MSG_TXN_ID_SHM_ACCEPT   ((void*)4)  ///< Accepts the other side's shared memory region.
+#define MSG_TXN_ID_SHM_PAYLOAD  ((void*)6)  ///< Payload is a msgShm_Descriptor_t.
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initializes this module.  This must be called only once at start-up, before any other functions
@@ -73,6 +90,34 @@ le_mem_PoolRef_t msgMessage_CreatePool
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Message object to receive a message into.  This is like le_msg_CreateMsg(), except
+ * that the payload buffer isn't cleared.  msgMessage_FinishReceive() must be called once a
+ * message has been received into it.
+ *
+ * @return  The message reference.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t msgMessage_CreateRxMsg
+(
+    le_msg_SessionRef_t sessionRef  ///< [in] Reference to the session.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finishes receiving a message, once any payload that was passed through shared memory has been
+ * copied into it.  Clears the part of the payload buffer that wasn't received into, so the
+ * receiver always sees a full-sized payload buffer, with whatever wasn't sent filled with zeros.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_FinishReceive
+(
+    le_msg_MessageRef_t msgRef      ///< [in] The received message.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Send a single message over a connected socket.
@@ -108,6 +153,75 @@ le_result_t msgMessage_Receive
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a batch of messages over a connected socket using a single system call.
+ *
+ * Fewer messages than requested may be sent, in which case the caller should call again to
+ * send the rest.
+ *
+ * @return
+ * - LE_OK if at least one message was sent (check *numSentPtr).
+ * - LE_NO_MEMORY if the socket doesn't have enough send buffer space available right now.
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_SendBatch
+(
+    int                 socketFd,   ///< [IN] Connected socket's file descriptor.
+    le_msg_MessageRef_t msgList[],  ///< [IN] The Messages to be sent.
+    size_t              numMsgs,    ///< [IN] Number of Messages (1 to UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t*             numSentPtr, ///< [OUT] Number of Messages from the start of the list that
+                                    ///        were sent.
+    msgShm_RegionRef_t  shmRef      ///< [IN] Shared memory region to pass large payloads through
+                                    ///       (NULL = send everything through the socket).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a received message's payload out of shared memory into its payload buffer, replacing
+ * the descriptor that was received in its place.
+ *
+ * @return
+ * - LE_OK if successful.
+ * - LE_FAULT if the descriptor is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_UnpackSharedMem
+(
+    le_msg_MessageRef_t msgRef,     ///< [IN] Message with transaction ID MSG_TXN_ID_SHM_PAYLOAD.
+    msgShm_RegionRef_t  shmRef      ///< [IN] Shared memory region received from the sender.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive a batch of messages from a connected socket using a single system call.
+ *
+ * Waits for the first message like msgMessage_Receive() would, then receives as many more as
+ * have already arrived, up to the number of Message objects provided.
+ *
+ * @return
+ * - LE_OK if at least one message was received (check *numMsgsPtr and resultList).
+ * - LE_WOULD_BLOCK if there's nothing there to receive and the socket is set non-blocking.
+ * - LE_CLOSED if the connection has closed.
+ * - LE_FAULT if an error was encountered.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_ReceiveBatch
+(
+    int                 socketFd,   ///< [IN] The socket's file descriptor.
+    le_msg_MessageRef_t msgList[],  ///< [IN] Message objects to store the received messages in.
+    le_result_t         resultList[],///< [OUT] Result for each Message object that was received
+                                    ///     into (LE_OK, LE_NO_MEMORY if truncated, or LE_CLOSED).
+    size_t*             numMsgsPtr  ///< [IN+OUT] Number of Message objects in the list
+                                    ///     (1 to UNIXSOCKET_MAX_BATCH_MSGS).  Updated to the
+                                    ///     number of messages received.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets a pointer to the queue link inside a Message object.
@@ -175,6 +289,23 @@ static inline void* msgMessage_GetTxnId
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a message is one that is used internally by the messaging system.
+ *
+ * @return true if the message's transaction ID is one of the reserved MSG_TXN_ID_ values.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool msgMessage_IsControlMsg
+(
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return ((msgRef->txnId != NULL) && ((((uintptr_t)msgRef->txnId) & 1) == 0));
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Call the completion callback function for a given message.
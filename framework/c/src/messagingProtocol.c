@@ -13,6 +13,7 @@
 #include "unixSocket.h"
 #include "serviceDirectory/serviceDirectoryProtocol.h"
 #include "messagingMessage.h"
+#include "messagingSharedMem.h"
 
 // =======================================
 //  PRIVATE DATA
@@ -41,6 +42,10 @@ typedef struct le_msg_Protocol
     char id[LIMIT_MAX_PROTOCOL_ID_BYTES];   ///< Unique identifier for the protocol.
     size_t maxPayloadSize;                  ///< Max payload size (in bytes) in this protocol.
     le_mem_PoolRef_t messagePoolRef;        ///< Pool of Message objects.
+    size_t sharedMemThreshold;              ///< Payloads this big or bigger are sent through
+                                            ///  shared memory, if the peer agrees.
+    size_t sharedMemRegionSize;             ///< Size of each session's shared memory regions
+                                            ///  (0 = shared memory disabled).
 }
 Protocol_t;
 
@@ -124,6 +129,8 @@ static Protocol_t* CreateProtocol
 
     protocolPtr->link = LE_SLS_LINK_INIT;
     protocolPtr->maxPayloadSize = largestMsgSize;
+    protocolPtr->sharedMemThreshold = 0;
+    protocolPtr->sharedMemRegionSize = 0;
     if (le_utf8_Copy(protocolPtr->id, protocolId, sizeof(protocolPtr->id), NULL) == LE_OVERFLOW)
     {
         LE_CRIT("Protocol identifier truncated from '%s' to '%s'.", protocolId, protocolPtr->id);
@@ -180,6 +187,40 @@ le_msg_MessageRef_t msgProto_AllocMessage
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the smallest payload size that a given Protocol sends through shared memory.
+ *
+ * @return The size, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t msgProto_GetSharedMemThreshold
+(
+    le_msg_ProtocolRef_t protocolRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return protocolRef->sharedMemThreshold;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of the shared memory region to be created for each session of a given Protocol.
+ *
+ * @return The size, in bytes, or 0 if shared memory is not enabled for the Protocol.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t msgProto_GetSharedMemRegionSize
+(
+    le_msg_ProtocolRef_t protocolRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return protocolRef->sharedMemRegionSize;
+}
+
+
 // =======================================
 //  PUBLIC API FUNCTIONS
 // =======================================
@@ -247,3 +288,33 @@ size_t le_msg_GetProtocolMaxMsgSize
 {
     return protocolRef->maxPayloadSize;
 }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables passing of large message payloads through shared memory for sessions using a given
+ * protocol.  See @ref c_messagingSharedMemory.
+ *
+ * Only affects sessions that are opened after this is called.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_msg_EnableSharedMemory
+(
+    le_msg_ProtocolRef_t protocolRef,   ///< [in] Reference to the protocol.
+    size_t thresholdSize,               ///< [in] Payloads this size or bigger are passed through
+                                        ///       shared memory.
+    size_t regionSize                   ///< [in] Size of the shared memory region used for each
+                                        ///       direction of each session (0 = disable).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // The payload's place in shared memory is sent through the socket in the payload section of
+    // the message, so smaller payloads can't be passed through shared memory.
+    if (thresholdSize < sizeof(msgShm_Descriptor_t))
+    {
+        thresholdSize = sizeof(msgShm_Descriptor_t);
+    }
+
+    protocolRef->sharedMemThreshold = thresholdSize;
+    protocolRef->sharedMemRegionSize = regionSize;
+}
@@ -33,4 +33,30 @@ le_msg_MessageRef_t msgProto_AllocMessage
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the smallest payload size that a given Protocol sends through shared memory.
+ *
+ * @return The size, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t msgProto_GetSharedMemThreshold
+(
+    le_msg_ProtocolRef_t protocolRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of the shared memory region to be created for each session of a given Protocol.
+ *
+ * @return The size, in bytes, or 0 if shared memory is not enabled for the Protocol.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t msgProto_GetSharedMemRegionSize
+(
+    le_msg_ProtocolRef_t protocolRef
+);
+
+
 #endif // MESSAGING_PROTOCOL_H_INCLUDE_GUARD
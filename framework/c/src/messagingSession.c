@@ -30,6 +30,12 @@
 #define MAX_EXPECTED_TXNS 32
 
 
+//--------------------------------------------------------------------------------------------------
+/// The maximum number of messages to receive from a session's socket before processing them.
+//--------------------------------------------------------------------------------------------------
+#define MAX_MSGS_RECEIVED_PER_EVENT (4 * UNIXSOCKET_MAX_BATCH_MSGS)
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Mutex used to protect data structures in this module from multi-threaded race conditions.
@@ -93,6 +99,9 @@ typedef struct le_msg_Session
     int                             socketFd;       ///< File descriptor for the connected socket.
     le_thread_Ref_t                 threadRef;      ///< The thread that handles this session.
     le_fdMonitor_Ref_t              fdMonitorRef;   ///< File descriptor monitor for the socket.
+    bool                            isWaitingToSend;///< true = the socket's send buffer is full
+                                                    ///  and the FD Monitor has been asked to
+                                                    ///  report when it becomes writeable.
     le_msg_InterfaceRef_t           interfaceRef;   ///< The interface being accessed.
 
     le_dls_List_t                   txnList;        ///< List of request messages that have been
@@ -110,6 +119,19 @@ typedef struct le_msg_Session
     void*                           openContextPtr; ///< Open handler's context pointer.
     le_msg_SessionEventHandler_t    closeHandler;   ///< Close handler function.
     void*                           closeContextPtr;///< Close handler's context pointer.
+
+    uint64_t                        txMsgCount;     ///< Number of messages sent.
+    uint64_t                        txCallCount;    ///< Number of send system calls made.
+    uint64_t                        rxMsgCount;     ///< Number of messages received.
+    uint64_t                        rxCallCount;    ///< Number of receive system calls that got
+                                                    ///  at least one message.
+
+    msgShm_RegionRef_t              txShmRef;       ///< Shared memory region for sending large
+                                                    ///  payloads (NULL until offered).
+    bool                            isTxShmAccepted;///< true = the other side has accepted
+                                                    ///  txShmRef.
+    msgShm_RegionRef_t              rxShmRef;       ///< Shared memory region for receiving large
+                                                    ///  payloads (NULL until offered).
 }
 Session_t;
 
@@ -130,6 +152,8 @@ static le_ref_MapRef_t TxnMapRef;
 // =======================================
 
 static void AttemptOpen(Session_t* sessionPtr);
+static void SendFromTransmitQueue(Session_t* sessionPtr);
+static void HandleControlMessage(Session_t* sessionPtr, le_msg_MessageRef_t msgRef);
 
 
 //--------------------------------------------------------------------------------------------------
@@ -187,23 +211,35 @@ static le_msg_MessageRef_t PopTransmitQueue
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Puts a message back onto the head of the Transmit Queue.
+ * Gets the messages at the head of the Transmit Queue without removing them from the queue.
+ *
+ * @return The number of messages fetched (0 if the queue is empty).
  *
  * @note    This is used on both the client side and the server side.
  */
 //--------------------------------------------------------------------------------------------------
-static void UnPopTransmitQueue
+static size_t PeekTransmitQueue
 (
-    Session_t* sessionPtr,
-    le_msg_MessageRef_t msgRef
+    Session_t*          sessionPtr,
+    le_msg_MessageRef_t msgList[],  ///< [OUT] Array to store the message references in.
+    size_t              maxMsgs     ///< [IN] Maximum number of messages to fetch.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = msgMessage_GetQueueLinkPtr(msgRef);
+    size_t numMsgs = 0;
 
     LOCK
-    le_dls_Stack(&sessionPtr->transmitQueue, linkPtr);
+    le_dls_Link_t* linkPtr = le_dls_Peek(&sessionPtr->transmitQueue);
+    while ((linkPtr != NULL) && (numMsgs < maxMsgs))
+    {
+        msgList[numMsgs] = msgMessage_GetMessageContainingLink(linkPtr);
+        numMsgs++;
+
+        linkPtr = le_dls_PeekNext(&sessionPtr->transmitQueue, linkPtr);
+    }
     UNLOCK
+
+    return numMsgs;
 }
 
 
@@ -419,7 +455,7 @@ static void PurgeTransmitQueue
         {
             // If the message is part of a transaction, that transaction is now terminated
             // and its transaction ID needs to be deleted.
-            if ( (msgMessage_GetTxnId(msgRef) != NULL) )
+            if ( (msgMessage_GetTxnId(msgRef) != NULL) && !msgMessage_IsControlMsg(msgRef) )
             {
                 DeleteTxnId(msgRef);
             }
@@ -451,6 +487,13 @@ static void PurgeReceiveQueue
 
     while (NULL != (msgRef = PopReceiveQueue(sessionPtr)))
     {
+        // Clear the transaction ID of any message used internally by the messaging system, so the
+        // server side doesn't think it is releasing a request without responding to it.
+        if (msgMessage_IsControlMsg(msgRef))
+        {
+            msgMessage_SetTxnId(msgRef, 0);
+        }
+
         le_msg_ReleaseMsg(msgRef);
     }
 }
@@ -478,6 +521,7 @@ static Session_t* CreateSession
     sessionPtr->threadRef = le_thread_GetCurrent();
     sessionPtr->socketFd = -1;
     sessionPtr->fdMonitorRef = NULL;
+    sessionPtr->isWaitingToSend = false;
 
     sessionPtr->txnList = LE_DLS_LIST_INIT;
     sessionPtr->transmitQueue = LE_DLS_LIST_INIT;
@@ -491,6 +535,15 @@ static Session_t* CreateSession
     sessionPtr->closeHandler = NULL;
     sessionPtr->closeContextPtr = NULL;
 
+    sessionPtr->txMsgCount = 0;
+    sessionPtr->txCallCount = 0;
+    sessionPtr->rxMsgCount = 0;
+    sessionPtr->rxCallCount = 0;
+
+    sessionPtr->txShmRef = NULL;
+    sessionPtr->isTxShmAccepted = false;
+    sessionPtr->rxShmRef = NULL;
+
     sessionPtr->interfaceRef = interfaceRef;
 
     msgInterface_AddSession(interfaceRef, sessionPtr);
@@ -514,6 +567,17 @@ static void CloseSession
 {
     sessionPtr->state = LE_MSG_SESSION_STATE_CLOSED;
 
+    TRACE("Session with service (%s) closing. Sent %" PRIu64 " msgs in %" PRIu64 " calls"
+          " (%" PRIu64 " through shared memory); received %" PRIu64 " msgs in %" PRIu64 " calls"
+          " (%" PRIu64 " through shared memory).",
+          le_msg_GetInterfaceName(sessionPtr->interfaceRef),
+          sessionPtr->txMsgCount,
+          sessionPtr->txCallCount,
+          msgShm_GetMsgCount(sessionPtr->txShmRef),
+          sessionPtr->rxMsgCount,
+          sessionPtr->rxCallCount,
+          msgShm_GetMsgCount(sessionPtr->rxShmRef));
+
     // Always notify the server on close.
     if (sessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_SERVER)
     {
@@ -527,6 +591,7 @@ static void CloseSession
     {
         le_fdMonitor_Delete(sessionPtr->fdMonitorRef);
         sessionPtr->fdMonitorRef = NULL;
+        sessionPtr->isWaitingToSend = false;
     }
     fd_Close(sessionPtr->socketFd);
     sessionPtr->socketFd = -1;
@@ -539,6 +604,18 @@ static void CloseSession
     }
     PurgeTransmitQueue(sessionPtr);
     PurgeReceiveQueue(sessionPtr);
+
+    if (sessionPtr->txShmRef != NULL)
+    {
+        le_mem_Release(sessionPtr->txShmRef);
+        sessionPtr->txShmRef = NULL;
+    }
+    sessionPtr->isTxShmAccepted = false;
+    if (sessionPtr->rxShmRef != NULL)
+    {
+        le_mem_Release(sessionPtr->rxShmRef);
+        sessionPtr->rxShmRef = NULL;
+    }
 }
 
 
@@ -634,7 +711,11 @@ static void EnableWriteabilityNotification
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_fdMonitor_Enable(sessionPtr->fdMonitorRef, POLLOUT);
+    if (!sessionPtr->isWaitingToSend)
+    {
+        le_fdMonitor_Enable(sessionPtr->fdMonitorRef, POLLOUT);
+        sessionPtr->isWaitingToSend = true;
+    }
 }
 
 
@@ -650,7 +731,12 @@ static inline void DisableWriteabilityNotification
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_fdMonitor_Disable(sessionPtr->fdMonitorRef, POLLOUT);
+    // Skip the system call needed to update the FD Monitor if it isn't reporting writeability.
+    if (sessionPtr->isWaitingToSend)
+    {
+        le_fdMonitor_Disable(sessionPtr->fdMonitorRef, POLLOUT);
+        sessionPtr->isWaitingToSend = false;
+    }
 }
 
 
@@ -840,7 +926,11 @@ static void ProcessReceivedMessages
     {
         le_msg_MessageRef_t msgRef = msgMessage_GetMessageContainingLink(linkPtr);
 
-        if (sessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_CLIENT)
+        if (msgMessage_IsControlMsg(msgRef))
+        {
+            HandleControlMessage(sessionPtr, msgRef);
+        }
+        else if (sessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_CLIENT)
         {
             ProcessMessageFromServer(sessionPtr, msgRef);
         }
@@ -941,9 +1031,223 @@ static void ClientSocketError
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the shared memory region that large payloads should be sent through.
+ *
+ * @return The region, or NULL if the other side hasn't accepted one.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline msgShm_RegionRef_t GetTxShm
+(
+    Session_t* sessionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (sessionPtr->isTxShmAccepted ? sessionPtr->txShmRef : NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends one of the messages used internally by the messaging system to the other side.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendControlMessage
+(
+    Session_t*  sessionPtr,
+    void*       txnId,      ///< [IN] One of the MSG_TXN_ID_ values.
+    int         fd          ///< [IN] File descriptor to send with it (-1 = none).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionPtr);
+
+    // These have no payload.
+    le_msg_SetPayloadSize(msgRef, 0);
+
+    // NOTE: The fd must be set before the transaction ID, or the server side would think it is
+    //       being set on a response.
+    if (fd >= 0)
+    {
+        le_msg_SetFd(msgRef, fd);
+    }
+    msgMessage_SetTxnId(msgRef, txnId);
+
+    PushTransmitQueue(sessionPtr, msgRef);
+
+    if (!sessionPtr->isWaitingToSend)
+    {
+        SendFromTransmitQueue(sessionPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Offers the other side a shared memory region to receive large payloads through, if shared
+ * memory is enabled for the session's protocol and a region hasn't already been offered.
+ *
+ * @note    This is used on both the client side and the server side.  The client offers as soon
+ *          as the session opens, and the server offers when it accepts the client's offer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void OfferSharedMem
+(
+    Session_t* sessionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t regionSize = msgProto_GetSharedMemRegionSize(le_msg_GetSessionProtocol(sessionPtr));
+
+    if ((regionSize == 0) || (sessionPtr->txShmRef != NULL))
+    {
+        return;
+    }
+
+    int fd = msgShm_CreateRegion(regionSize, &sessionPtr->txShmRef);
+    if (fd >= 0)
+    {
+        SendControlMessage(sessionPtr, MSG_TXN_ID_SHM_OFFER, fd);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles a shared memory region offered by the other side.  If shared memory is enabled for the
+ * session's protocol, the region is mapped, the offer is accepted and a region is offered back.
+ * Otherwise, the offer is ignored, and the other side keeps sending everything through the socket.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AcceptSharedMemOffer
+(
+    Session_t*          sessionPtr,
+    le_msg_MessageRef_t msgRef      ///< [IN] The offer message.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = le_msg_GetFd(msgRef);
+
+    if (msgProto_GetSharedMemRegionSize(le_msg_GetSessionProtocol(sessionPtr)) == 0)
+    {
+        if (fd >= 0)
+        {
+            fd_Close(fd);
+        }
+    }
+    else if ((fd < 0) || (sessionPtr->rxShmRef != NULL))
+    {
+        LE_ERROR("Ignoring invalid shared memory offer on session with service (%s).",
+                 le_msg_GetInterfaceName(sessionPtr->interfaceRef));
+
+        if (fd >= 0)
+        {
+            fd_Close(fd);
+        }
+    }
+    else
+    {
+        sessionPtr->rxShmRef = msgShm_MapRegion(fd);
+
+        if (sessionPtr->rxShmRef != NULL)
+        {
+            SendControlMessage(sessionPtr, MSG_TXN_ID_SHM_ACCEPT, -1);
+
+            OfferSharedMem(sessionPtr);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles and releases a message used internally by the messaging system to set up shared memory.
+ *
+ * @note    This is only called from the Event Loop, never in the middle of a synchronous
+ *          transaction, because it can send messages and map a shared memory region.
+ */
+//--------------------------------------------------------------------------------------------------
+static void HandleControlMessage
+(
+    Session_t*          sessionPtr,
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    void* txnId = msgMessage_GetTxnId(msgRef);
+
+    if (txnId == MSG_TXN_ID_SHM_OFFER)
+    {
+        AcceptSharedMemOffer(sessionPtr, msgRef);
+    }
+    else if (txnId == MSG_TXN_ID_SHM_ACCEPT)
+    {
+        sessionPtr->isTxShmAccepted = (sessionPtr->txShmRef != NULL);
+    }
+    else
+    {
+        LE_ERROR("Discarding message with unknown transaction ID %p.", txnId);
+    }
+
+    // Clear the transaction ID so the server side doesn't think it is releasing a request
+    // without responding to it.
+    msgMessage_SetTxnId(msgRef, 0);
+    le_msg_ReleaseMsg(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finishes receiving a message.  Payloads that were passed through shared memory are copied out
+ * of it.  Other messages used internally by the messaging system are left as they are, to be
+ * handled by HandleControlMessage() when the Receive Queue is processed.
+ *
+ * @return The message to be queued, or NULL if it has been released.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_msg_MessageRef_t UnpackReceivedMessage
+(
+    Session_t*          sessionPtr,
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (!msgMessage_IsControlMsg(msgRef))
+    {
+        msgMessage_FinishReceive(msgRef);
+        return msgRef;
+    }
+
+    if (msgMessage_GetTxnId(msgRef) != MSG_TXN_ID_SHM_PAYLOAD)
+    {
+        return msgRef;
+    }
+
+    if (   (sessionPtr->rxShmRef != NULL)
+        && (msgMessage_UnpackSharedMem(msgRef, sessionPtr->rxShmRef) == LE_OK) )
+    {
+        msgMessage_FinishReceive(msgRef);
+        return msgRef;
+    }
+
+    LE_ERROR("Discarding message with invalid shared memory payload from service (%s).",
+             le_msg_GetInterfaceName(sessionPtr->interfaceRef));
+
+    msgMessage_SetTxnId(msgRef, 0);
+    le_msg_ReleaseMsg(msgRef);
+
+    return NULL;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Receive messages from the socket and put them on the Receive Queue.
+ *
+ * Messages are received in batches, using one system call per batch.  The batch size starts at
+ * one message (so a lone message doesn't cost any more than it used to) and doubles each time a
+ * batch is filled, up to UNIXSOCKET_MAX_BATCH_MSGS.
  */
 //--------------------------------------------------------------------------------------------------
 static void ReceiveMessages
@@ -952,25 +1256,84 @@ static void ReceiveMessages
 )
 //--------------------------------------------------------------------------------------------------
 {
+    le_msg_MessageRef_t msgList[UNIXSOCKET_MAX_BATCH_MSGS];
+    le_result_t resultList[UNIXSOCKET_MAX_BATCH_MSGS];
+    size_t numAllocated = 0;
+    size_t batchSize = 1;
+    size_t totalReceived = 0;
+    size_t i;
+
     for (;;)
     {
-        // Create a Message object.
-        le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionPtr);
+        // Create enough Message objects to receive a full batch into.
+        while (numAllocated < batchSize)
+        {
+            msgList[numAllocated] = msgMessage_CreateRxMsg(sessionPtr);
+            numAllocated++;
+        }
 
-        // Receive from the socket into the Message object.
-        le_result_t result = msgMessage_Receive(sessionPtr->socketFd, msgRef);
+        // Receive from the socket into the Message objects.
+        size_t numReceived = batchSize;
+        le_result_t result = msgMessage_ReceiveBatch(sessionPtr->socketFd,
+                                                     msgList,
+                                                     resultList,
+                                                     &numReceived);
+        if (result != LE_OK)
+        {
+            // Nothing left to receive from the socket.  We are done.
+            break;
+        }
 
-        if (result == LE_OK)
+        sessionPtr->rxCallCount++;
+        sessionPtr->rxMsgCount += numReceived;
+
+        bool closed = false;
+        for (i = 0; i < numReceived; i++)
         {
-            // Received something.  Push it onto the Receive Queue for later processing.
-            PushReceiveQueue(sessionPtr, msgRef);
+            if (resultList[i] == LE_OK)
+            {
+                // Received something.  Push it onto the Receive Queue for later processing.
+                le_msg_MessageRef_t msgRef = UnpackReceivedMessage(sessionPtr, msgList[i]);
+                if (msgRef != NULL)
+                {
+                    PushReceiveQueue(sessionPtr, msgRef);
+                }
+            }
+            else
+            {
+                le_msg_ReleaseMsg(msgList[i]);
+                closed = closed || (resultList[i] == LE_CLOSED);
+            }
         }
-        else
+
+        // Move the unused Message objects to the front of the list for the next batch.
+        numAllocated -= numReceived;
+        memmove(msgList, msgList + numReceived, numAllocated * sizeof(msgList[0]));
+
+        // If the batch wasn't filled, then there was nothing left in the socket.
+        // Also stop once a few full batches have been received, so the messages get processed
+        // (and released) before more are received.  Otherwise, a sender that can keep up with
+        // us would have us receiving forever, with the Receive Queue growing all the while.
+        // Anything left in the socket will be reported by the FD Monitor again.
+        totalReceived += numReceived;
+        if (   closed
+            || (numReceived < batchSize)
+            || (totalReceived >= MAX_MSGS_RECEIVED_PER_EVENT) )
         {
-            // Nothing left to receive from the socket.  We are done.
-            le_msg_ReleaseMsg(msgRef);
             break;
         }
+
+        batchSize *= 2;
+        if (batchSize > NUM_ARRAY_MEMBERS(msgList))
+        {
+            batchSize = NUM_ARRAY_MEMBERS(msgList);
+        }
+    }
+
+    // Release the Message objects that didn't get used.
+    for (i = 0; i < numAllocated; i++)
+    {
+        le_msg_ReleaseMsg(msgList[i]);
     }
 }
 
@@ -1021,10 +1384,60 @@ static void ServerSocketError
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finish with a message that has been sent and removed from the session's Transmit Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FinishSentMessage
+(
+    Session_t*          sessionPtr,
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (sessionPtr->interfaceRef->interfaceType)
+    {
+        // If this is the client side of the session,
+        case LE_MSG_INTERFACE_CLIENT:
+            // If a response is expected from the other side later, then put this
+            // message on the Transaction List.
+            if ((msgMessage_GetTxnId(msgRef) != 0) && !msgMessage_IsControlMsg(msgRef))
+            {
+                AddToTxnList(sessionPtr, msgRef);
+            }
+            // Otherwise, release it.
+            else
+            {
+                le_msg_ReleaseMsg(msgRef);
+            }
+
+            break;
+
+        // If this is the server side of the session,
+        case LE_MSG_INTERFACE_SERVER:
+            // Release the message, but first clear out the transaction ID so that
+            // the message knows that it is not being deleted without a reponse message
+            // being sent if one was expected.
+            msgMessage_SetTxnId(msgRef, 0);
+            le_msg_ReleaseMsg(msgRef);
+
+            break;
+
+        default:
+            LE_FATAL("Unhandled interface type (%d)",
+                     sessionPtr->interfaceRef->interfaceType);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Send messages from a session's Transmit Queue until either the socket becomes full or there
  * are no more messages waiting on the queue.
+ *
+ * Up to UNIXSOCKET_MAX_BATCH_MSGS messages are sent per system call.  Messages stay on the
+ * Transmit Queue until they have actually been sent.
  */
 //--------------------------------------------------------------------------------------------------
 static void SendFromTransmitQueue
@@ -1033,11 +1446,13 @@ static void SendFromTransmitQueue
 )
 //--------------------------------------------------------------------------------------------------
 {
+    le_msg_MessageRef_t msgList[UNIXSOCKET_MAX_BATCH_MSGS];
+
     for (;;)
     {
-        le_msg_MessageRef_t msgRef = PopTransmitQueue(sessionPtr);
+        size_t numMsgs = PeekTransmitQueue(sessionPtr, msgList, NUM_ARRAY_MEMBERS(msgList));
 
-        if (msgRef == NULL)
+        if (numMsgs == 0)
         {
             // Since the Transmit Queue is empty, tell the FD Monitor that we don't need to be
             // notified about writeability anymore.
@@ -1045,51 +1460,36 @@ static void SendFromTransmitQueue
             break;
         }
 
-        le_result_t result = msgMessage_Send(sessionPtr->socketFd, msgRef);
+        size_t numSent = 0;
+        le_result_t result = msgMessage_SendBatch(sessionPtr->socketFd,
+                                                  msgList,
+                                                  numMsgs,
+                                                  &numSent,
+                                                  GetTxShm(sessionPtr));
 
         switch (result)
         {
             case LE_OK:
-                switch (sessionPtr->interfaceRef->interfaceType)
+            {
+                sessionPtr->txCallCount++;
+                sessionPtr->txMsgCount += numSent;
+
+                size_t i;
+                for (i = 0; i < numSent; i++)
                 {
-                    // If this is the client side of the session,
-                    case LE_MSG_INTERFACE_CLIENT:
-                        // If a response is expected from the other side later, then put this
-                        // message on the Transaction List.
-                        if (msgMessage_GetTxnId(msgRef) != 0)
-                        {
-                            AddToTxnList(sessionPtr, msgRef);
-                        }
-                        // Otherwise, release it.
-                        else
-                        {
-                            le_msg_ReleaseMsg(msgRef);
-                        }
-
-                        break;
-
-                    // If this is the server side of the session,
-                    case LE_MSG_INTERFACE_SERVER:
-                        // Release the message, but first clear out the transaction ID so that
-                        // the message knows that it is not being deleted without a reponse message
-                        // being sent if one was expected.
-                        msgMessage_SetTxnId(msgRef, 0);
-                        le_msg_ReleaseMsg(msgRef);
-
-                        break;
-
-                    default:
-                        LE_FATAL("Unhandled interface type (%d)",
-                                 sessionPtr->interfaceRef->interfaceType);
+                    le_msg_MessageRef_t msgRef = PopTransmitQueue(sessionPtr);
+                    LE_ASSERT(msgRef == msgList[i]);
+
+                    FinishSentMessage(sessionPtr, msgRef);
                 }
 
-                break;  // Continue to loop around and send another.
+                break;  // Continue to loop around and send more.
+            }
 
             case LE_NO_MEMORY:
-                // Have to wait for the socket to become writeable.  Put the message back on
-                // the head of the queue and ask the FD Monitor to tell us when the socket becomes
+                // Have to wait for the socket to become writeable.  The messages are still on
+                // the Transmit Queue, so ask the FD Monitor to tell us when the socket becomes
                 // writeable again.
-                UnPopTransmitQueue(sessionPtr, msgRef);
                 EnableWriteabilityNotification(sessionPtr);
 
                 return;
@@ -1097,10 +1497,8 @@ static void SendFromTransmitQueue
             case LE_COMM_ERROR:
                 // In this case, we expect a handler function to be called by the FD Monitor,
                 // so we don't need to handle this case here.  However, we must stop
-                // trying to transmit now.  Stick the current message back on the Transmit Queue
-                // so it gets cleaned up with the others when the session closes.
-                UnPopTransmitQueue(sessionPtr, msgRef);
-
+                // trying to transmit now.  The messages are left on the Transmit Queue so they
+                // get cleaned up with the others when the session closes.
                 return;
 
             default:
@@ -1140,6 +1538,8 @@ static void ClientSocketReadable
             {
                 sessionPtr->state = LE_MSG_SESSION_STATE_OPEN;
 
+                OfferSharedMem(sessionPtr);
+
                 // Call the client's completion callback.
                 sessionPtr->openHandler(sessionPtr, sessionPtr->openContextPtr);
             }
@@ -1324,6 +1724,7 @@ static void StartSocketMonitoring
                                                    sessionPtr->socketFd,
                                                    handlerFunc,
                                                    POLLIN);
+    sessionPtr->isWaitingToSend = false;
 
     le_fdMonitor_SetContextPtr(sessionPtr->fdMonitorRef, sessionPtr);
 }
@@ -1476,6 +1877,8 @@ static le_result_t AttemptOpenSync
                 StartSocketMonitoring(sessionPtr, ClientSocketEventHandler);
 
                 sessionPtr->state = LE_MSG_SESSION_STATE_OPEN;
+
+                OfferSharedMem(sessionPtr);
             }
             else
             {
@@ -1632,8 +2035,13 @@ void msgSession_SendMessage
         // Put the message on the Transmit Queue.
         PushTransmitQueue(sessionRef, messageRef);
 
-        // Try to send something from the Transmit Queue.
-        SendFromTransmitQueue(sessionRef);
+        // Try to send something from the Transmit Queue, unless the socket is already known to
+        // be full, in which case the message will be sent with the others in the queue when the
+        // socket becomes writeable.
+        if (!sessionRef->isWaitingToSend)
+        {
+            SendFromTransmitQueue(sessionRef);
+        }
     }
 }
 
@@ -1666,8 +2074,12 @@ void msgSession_RequestResponse
     // Put the message on the Transmit Queue.
     PushTransmitQueue(sessionRef, msgRef);
 
-    // Try to send something from the Transmit Queue.
-    SendFromTransmitQueue(sessionRef);
+    // Try to send something from the Transmit Queue, unless the socket is already known to
+    // be full.
+    if (!sessionRef->isWaitingToSend)
+    {
+        SendFromTransmitQueue(sessionRef);
+    }
 }
 
 
@@ -1698,7 +2110,13 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     fd_SetBlocking(sessionRef->socketFd);
 
     // Send the Request Message.
-    msgMessage_Send(sessionRef->socketFd, msgRef);
+    size_t numSent;
+    if (msgMessage_SendBatch(sessionRef->socketFd, &msgRef, 1, &numSent, GetTxShm(sessionRef))
+        == LE_OK)
+    {
+        sessionRef->txCallCount++;
+        sessionRef->txMsgCount++;
+    }
 
     // While we have not yet received the response we are waiting for, keep
     // receiving messages.  Any that we receive that don't match the transaction ID
@@ -1706,7 +2124,7 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     // function call.
     for (;;)
     {
-        rxMsgRef = le_msg_CreateMsg(sessionRef);
+        rxMsgRef = msgMessage_CreateRxMsg(sessionRef);
 
         le_result_t result = msgMessage_Receive(sessionRef->socketFd, rxMsgRef);
 
@@ -1719,13 +2137,23 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
             break;
         }
 
+        sessionRef->rxCallCount++;
+        sessionRef->rxMsgCount++;
+
+        rxMsgRef = UnpackReceivedMessage(sessionRef, rxMsgRef);
+        if (rxMsgRef == NULL)
+        {
+            continue;
+        }
+
         if (msgMessage_GetTxnId(rxMsgRef) == msgMessage_GetTxnId(msgRef))
         {
             // Got the synchronous response we were waiting for.
             break;
         }
 
-        // Got some other message that we weren't waiting for.
+        // Got some other message that we weren't waiting for.  This includes shared memory
+        // offers, which are not accepted in the middle of this transaction.
 
         // If the Receive Queue is empty, queue up a function call on the Event Queue so that
         // the Event Loop will kick start processing of the Receive Queue later.
@@ -0,0 +1,508 @@
+/** @file messagingSharedMem.c
+ *
+ * @ref c_messaging implementation's "Shared Memory" module implementation.
+ *
+ * The regions are memfd-backed, so they have no name in the file system and are only accessible
+ * to processes that have been given the file descriptor.  The creator seals the region's size so
+ * that the receiver can't be made to fault by the sender shrinking the region after it has been
+ * mapped.
+ *
+ * The sender never trusts the tail value written by the receiver and the receiver never trusts
+ * the descriptors sent by the sender, so a misbehaving peer can only corrupt the payloads of its
+ * own session.  Payloads are copied out of the region before they are unpacked, because the
+ * sender can still write to a slot after it has sent the descriptor for it.
+ *
+ * See @ref messaging.c for an overview of the @ref c_messaging implementation.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#include "legato.h"
+#include "messagingSharedMem.h"
+#include "fileDescriptor.h"
+#include <sys/mman.h>
+
+// These are missing from older C library headers.
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC         0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING   0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS         1033
+#define F_GET_SEALS         1034
+#define F_SEAL_SEAL         0x0001
+#define F_SEAL_SHRINK       0x0002
+#define F_SEAL_GROW         0x0004
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header at the start of each shared memory region.  Padded to a cache line so the tail, which is
+ * written by the receiver, doesn't share a cache line with the payloads written by the sender.
+ */
+//--------------------------------------------------------------------------------------------------
+struct msgShm_Header
+{
+    uint64_t tail;      ///< Ring position up to which the receiver has released its slots.
+    uint8_t  reserved[56];
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Payloads are placed on boundaries of this many bytes in the ring buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PAYLOAD_ALIGNMENT 8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * One side's view of a shared memory region.
+ */
+//--------------------------------------------------------------------------------------------------
+struct msgShm_Region
+{
+    struct msgShm_Header*   headerPtr;  ///< Start of the mapping.
+    uint8_t*                dataPtr;    ///< Start of the ring buffer area.
+    size_t                  mapSize;    ///< Size of the mapping, in bytes.
+    size_t                  dataSize;   ///< Size of the ring buffer area, in bytes.
+    uint64_t                head;       ///< Ring position that the next payload will be written
+                                        ///  at.  (Sending side only.)
+    uint64_t                msgCount;   ///< Number of payloads passed through the region.
+    uint64_t                rxPos;      ///< End position of the last slot received.  (Receiving
+                                        ///  side only.)
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which Region objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t RegionPoolRef;
+
+
+// =======================================
+//  PRIVATE FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Destructor function for Region objects.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RegionDestructor
+(
+    void* objPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct msgShm_Region* regionPtr = objPtr;
+
+    LE_ASSERT(munmap(regionPtr->headerPtr, regionPtr->mapSize) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates an anonymous, sealable memory file.
+ *
+ * @return The file descriptor, or -1 on failure (errno is set).
+ */
+//--------------------------------------------------------------------------------------------------
+static int CreateMemFd
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+#ifdef SYS_memfd_create
+    return syscall(SYS_memfd_create, "le_msg", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps a shared memory region and creates a Region object for it.
+ *
+ * @return The Region object, or NULL if the mmap() failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct msgShm_Region* Map
+(
+    int     fd,
+    size_t  mapSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    void* basePtr = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (basePtr == MAP_FAILED)
+    {
+        LE_ERROR("Failed to map %zu byte shared memory region (%m).", mapSize);
+        return NULL;
+    }
+
+    struct msgShm_Region* regionPtr = le_mem_ForceAlloc(RegionPoolRef);
+
+    regionPtr->headerPtr = basePtr;
+    regionPtr->dataPtr = (uint8_t*)basePtr + sizeof(struct msgShm_Header);
+    regionPtr->mapSize = mapSize;
+    regionPtr->dataSize = mapSize - sizeof(struct msgShm_Header);
+    regionPtr->head = 0;
+    regionPtr->msgCount = 0;
+    regionPtr->rxPos = 0;
+
+    return regionPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of bytes of ring buffer that a payload's slot takes up.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t SlotSize
+(
+    size_t payloadSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (payloadSize + PAYLOAD_ALIGNMENT - 1) & ~((size_t)PAYLOAD_ALIGNMENT - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks a received descriptor against a region, and moves the region's received position past
+ * its slot if it is valid.
+ *
+ * @return true if the descriptor is valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Receive
+(
+    struct msgShm_Region*       regionPtr,
+    const msgShm_Descriptor_t*  descPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t dataSize = regionPtr->dataSize;
+    size_t slotSize = SlotSize(descPtr->size);
+
+    // Slots are received in the order they were written, and no more than a ring buffer's worth
+    // can be in use at once.
+    if (   (slotSize == 0)
+        || (descPtr->endPos <= regionPtr->rxPos)
+        || ((descPtr->endPos - regionPtr->rxPos) > dataSize)
+        || ((descPtr->endPos - regionPtr->rxPos) < slotSize) )
+    {
+        return false;
+    }
+
+    // The payload must be in the slot that ends at endPos.  That slot starts where the last slot
+    // received ended, unless it wouldn't have fit before the end of the ring buffer, in which
+    // case it starts at the beginning of the ring buffer.
+    uint64_t startPos = descPtr->endPos - slotSize;
+    size_t rxOffset = regionPtr->rxPos % dataSize;
+
+    if (startPos != regionPtr->rxPos)
+    {
+        if (   ((rxOffset + slotSize) <= dataSize)
+            || ((startPos - regionPtr->rxPos) != (dataSize - rxOffset)) )
+        {
+            return false;
+        }
+    }
+
+    if (   ((startPos % dataSize) != descPtr->offset)
+        || ((descPtr->offset + slotSize) > dataSize) )
+    {
+        return false;
+    }
+
+    regionPtr->rxPos = descPtr->endPos;
+    regionPtr->msgCount++;
+
+    return true;
+}
+
+
+// =======================================
+//  PROTECTED (INTER-MODULE) FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes this module.  This must be called only once at start-up, before any other functions
+ * in this module are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RegionPoolRef = le_mem_CreatePool("MsgShmRegion", sizeof(struct msgShm_Region));
+    le_mem_SetDestructor(RegionPoolRef, RegionDestructor);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a new shared memory region for sending payloads through and maps it into this process.
+ *
+ * @return The file descriptor to be passed to the receiving side, or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int msgShm_CreateRegion
+(
+    size_t              size,           ///< [IN] Requested size of the region, in bytes.
+    msgShm_RegionRef_t* regionRefPtr    ///< [OUT] The new region.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t mapSize = ((size + sizeof(struct msgShm_Header) + pageSize - 1) / pageSize) * pageSize;
+
+    // Payload offsets are sent as 32-bit values.
+    if (mapSize > UINT32_MAX)
+    {
+        mapSize = (UINT32_MAX / pageSize) * pageSize;
+    }
+
+    int fd = CreateMemFd();
+    if (fd < 0)
+    {
+        LE_WARN("Can't create shared memory region (%m). Large payloads will use the socket.");
+        return -1;
+    }
+
+    if (ftruncate(fd, mapSize) != 0)
+    {
+        LE_ERROR("Failed to size shared memory region to %zu bytes (%m).", mapSize);
+        fd_Close(fd);
+        return -1;
+    }
+
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0)
+    {
+        LE_ERROR("Failed to seal shared memory region (%m).");
+        fd_Close(fd);
+        return -1;
+    }
+
+    *regionRefPtr = Map(fd, mapSize);
+    if (*regionRefPtr == NULL)
+    {
+        fd_Close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps a shared memory region received from the sending side into this process.
+ *
+ * The file descriptor is closed, whether successful or not.
+ *
+ * @return The region, or NULL if the file descriptor is not a usable shared memory region.
+ */
+//--------------------------------------------------------------------------------------------------
+msgShm_RegionRef_t msgShm_MapRegion
+(
+    int fd  ///< [IN] File descriptor of the shared memory region.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgShm_RegionRef_t regionRef = NULL;
+    struct stat st;
+
+    // Only accept regions whose size can't change while we have them mapped, or the sender
+    // could make us fault by shrinking it.
+    int seals = fcntl(fd, F_GET_SEALS);
+
+    if ((seals < 0) || !(seals & F_SEAL_SHRINK))
+    {
+        LE_ERROR("Shared memory region is not sealed against shrinking.");
+    }
+    else if (fstat(fd, &st) != 0)
+    {
+        LE_ERROR("Failed to stat shared memory region (%m).");
+    }
+    else if (   (st.st_size <= (off_t)sizeof(struct msgShm_Header))
+             || ((uint64_t)st.st_size > UINT32_MAX) )
+    {
+        LE_ERROR("Shared memory region has bad size (%lld bytes).", (long long)st.st_size);
+    }
+    else
+    {
+        regionRef = Map(fd, st.st_size);
+    }
+
+    fd_Close(fd);
+
+    return regionRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of payloads that have been passed through a region.
+ *
+ * @return The count (0 if regionRef is NULL).
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t msgShm_GetMsgCount
+(
+    msgShm_RegionRef_t regionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (regionRef != NULL) ? regionRef->msgCount : 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a payload into a new slot at the head of a region's ring buffer.  (Sending side only.)
+ *
+ * Each payload is stored contiguously.  If there isn't room for it before the end of the ring
+ * buffer, the space up to the end is skipped and it is placed at the start instead.
+ *
+ * @return true if successful, false if there isn't enough free space in the ring buffer right now.
+ */
+//--------------------------------------------------------------------------------------------------
+bool msgShm_Write
+(
+    msgShm_RegionRef_t      regionRef,  ///< [IN] The region to write into.
+    const void*             payloadPtr, ///< [IN] The payload.
+    size_t                  size,       ///< [IN] Size of the payload, in bytes.
+    msgShm_Descriptor_t*    descPtr     ///< [OUT] Filled in with the payload's location.
+                                        ///        (The caller fills in the txnId.)
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t dataSize = regionRef->dataSize;
+    size_t allocSize = SlotSize(size);
+
+    if ((allocSize == 0) || (allocSize > dataSize))
+    {
+        return false;
+    }
+
+    uint64_t tail = __atomic_load_n(&regionRef->headerPtr->tail, __ATOMIC_ACQUIRE);
+    uint64_t pos = regionRef->head;
+
+    // The receiver is not trusted to keep the tail within the part of the ring that is in use.
+    // If it hasn't, stop using the region.
+    if ((pos - tail) > dataSize)
+    {
+        return false;
+    }
+
+    size_t offset = pos % dataSize;
+    if ((offset + allocSize) > dataSize)
+    {
+        pos += dataSize - offset;
+        offset = 0;
+    }
+
+    if ((pos + allocSize - tail) > dataSize)
+    {
+        return false;
+    }
+
+    memcpy(regionRef->dataPtr + offset, payloadPtr, size);
+
+    descPtr->offset = offset;
+    descPtr->size = size;
+    descPtr->endPos = pos + allocSize;
+
+    regionRef->head = descPtr->endPos;
+    regionRef->msgCount++;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the position of the head of a region's ring buffer.  (Sending side only.)
+ *
+ * @return The position, which can be passed to msgShm_Rewind().
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t msgShm_GetHead
+(
+    msgShm_RegionRef_t regionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return regionRef->head;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gives back the slots of payloads that were written but never sent.  (Sending side only.)
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Rewind
+(
+    msgShm_RegionRef_t  regionRef,
+    uint64_t            pos,        ///< [IN] Value the head had before the first unsent payload
+                                    ///       was written.
+    size_t              numUnsent   ///< [IN] Number of unsent payloads.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    regionRef->head = pos;
+    regionRef->msgCount -= numUnsent;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a received payload out of its slot and gives the slot back to the sender.  (Receiving
+ * side only.)
+ *
+ * The descriptor must describe the slot that follows the last one received, and the payload must
+ * fit within that slot.
+ *
+ * @return
+ * - LE_OK if successful.
+ * - LE_FAULT if the descriptor is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgShm_Read
+(
+    msgShm_RegionRef_t          regionRef,  ///< [IN] The region the payload was received in.
+    const msgShm_Descriptor_t*  descPtr,    ///< [IN] The payload's location.
+    void*                       bufPtr,     ///< [OUT] Buffer to copy the payload into.
+    size_t                      bufSize     ///< [IN] Size of the buffer, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((descPtr->size > bufSize) || !Receive(regionRef, descPtr))
+    {
+        return LE_FAULT;
+    }
+
+    memcpy(bufPtr, regionRef->dataPtr + descPtr->offset, descPtr->size);
+
+    __atomic_store_n(&regionRef->headerPtr->tail, descPtr->endPos, __ATOMIC_RELEASE);
+
+    return LE_OK;
+}
@@ -0,0 +1,170 @@
+/** @file messagingSharedMem.h
+ *
+ * @ref c_messaging implementation's "Shared Memory" module's inter-module interface definitions.
+ *
+ * Large message payloads can be passed through a shared memory region instead of being copied
+ * through the session's socket.  Each direction of a session has its own region, which is
+ * created by the sending side and passed to the receiving side as a file descriptor.  The data
+ * area of the region is used as a ring buffer of slots, with the sender writing each payload into
+ * a new slot at the head, and only a descriptor holding the slot's offset is sent through the
+ * socket.  So the socket still determines the message order.
+ *
+ * The receiver copies each payload out of its slot before it is used, then gives the slot back
+ * by moving the tail (which the sender reads to find out how much space is free) past it.  So
+ * the sender can't change a payload while the receiver is checking or using it.
+ *
+ * Use le_mem_Release() to unmap a region.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#ifndef LEGATO_MESSAGING_SHARED_MEM_H_INCLUDE_GUARD
+#define LEGATO_MESSAGING_SHARED_MEM_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a shared memory region, as seen by one side of a session.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct msgShm_Region* msgShm_RegionRef_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Describes a payload that has been written into a slot in a shared memory region.  This is sent
+ * through the socket in place of the payload.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void*       txnId;      ///< The message's transaction ID.
+    uint32_t    offset;     ///< Offset of the payload from the start of the ring buffer area.
+    uint32_t    size;       ///< Size of the payload, in bytes.
+    uint64_t    endPos;     ///< Ring position just past the end of the slot.  Identifies the slot
+                            ///  and is where the tail moves to once the slot is released.
+}
+msgShm_Descriptor_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes this module.  This must be called only once at start-up, before any other functions
+ * in this module are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a new shared memory region for sending payloads through and maps it into this process.
+ *
+ * @return The file descriptor to be passed to the receiving side, or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int msgShm_CreateRegion
+(
+    size_t              size,           ///< [IN] Requested size of the region, in bytes.
+    msgShm_RegionRef_t* regionRefPtr    ///< [OUT] The new region.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps a shared memory region received from the sending side into this process.
+ *
+ * The file descriptor is closed, whether successful or not.
+ *
+ * @return The region, or NULL if the file descriptor is not a usable shared memory region.
+ */
+//--------------------------------------------------------------------------------------------------
+msgShm_RegionRef_t msgShm_MapRegion
+(
+    int fd  ///< [IN] File descriptor of the shared memory region.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of payloads that have been passed through a region.
+ *
+ * @return The count (0 if regionRef is NULL).
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t msgShm_GetMsgCount
+(
+    msgShm_RegionRef_t regionRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a payload into a new slot at the head of a region's ring buffer.  (Sending side only.)
+ *
+ * @return true if successful, false if there isn't enough free space in the ring buffer right now.
+ */
+//--------------------------------------------------------------------------------------------------
+bool msgShm_Write
+(
+    msgShm_RegionRef_t      regionRef,  ///< [IN] The region to write into.
+    const void*             payloadPtr, ///< [IN] The payload.
+    size_t                  size,       ///< [IN] Size of the payload, in bytes.
+    msgShm_Descriptor_t*    descPtr     ///< [OUT] Filled in with the payload's location.
+                                        ///        (The caller fills in the txnId.)
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the position of the head of a region's ring buffer.  (Sending side only.)
+ *
+ * @return The position, which can be passed to msgShm_Rewind().
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t msgShm_GetHead
+(
+    msgShm_RegionRef_t regionRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gives back the slots of payloads that were written but never sent.  (Sending side only.)
+ */
+//--------------------------------------------------------------------------------------------------
+void msgShm_Rewind
+(
+    msgShm_RegionRef_t  regionRef,
+    uint64_t            pos,        ///< [IN] Value the head had before the first unsent payload
+                                    ///       was written.
+    size_t              numUnsent   ///< [IN] Number of unsent payloads.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a received payload out of its slot and gives the slot back to the sender.  (Receiving
+ * side only.)
+ *
+ * The descriptor must describe the slot that follows the last one received, and the payload must
+ * fit within that slot.
+ *
+ * @return
+ * - LE_OK if successful.
+ * - LE_FAULT if the descriptor is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgShm_Read
+(
+    msgShm_RegionRef_t          regionRef,  ///< [IN] The region the payload was received in.
+    const msgShm_Descriptor_t*  descPtr,    ///< [IN] The payload's location.
+    void*                       bufPtr,     ///< [OUT] Buffer to copy the payload into.
+    size_t                      bufSize     ///< [IN] Size of the buffer, in bytes.
+);
+
+
+#endif // LEGATO_MESSAGING_SHARED_MEM_H_INCLUDE_GUARD
@@ -28,10 +28,20 @@
  *  -# What type of mutex is a given mutex? (recursive?)
  *    - Stored in each Mutex object as a boolean flag.
  *
+ * Keeping all that up to date costs two extra lock/unlock pairs and several list updates on
+ * every lock, even when nobody else wants the mutex.  <b> Lean </b> mutexes avoid that: they are
+ * locked with an atomic compare-and-swap on a futex word, and only record the thread on the
+ * waiting list, and the mutex on the holder's locked mutexes list, when the lock is contended.
+ * So the diagnostic tools still see who is waiting for a lean mutex and who holds it in that
+ * case, but not while it is being locked and unlocked without contention.  The futex word
+ * follows the usual three-state protocol (unlocked, locked, locked with waiters), so an unlock
+ * only makes a system call when some thread may be sleeping on the mutex.
+ *
  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
  */
 
 #include "legato.h"
+#include <linux/futex.h>
 #include "limit.h"
 #include "mutex.h"
 #include "thread.h"
@@ -86,6 +96,29 @@ static le_dls_List_t MutexList = LE_DLS_LIST_INIT;
 static pthread_mutex_t MutexListMutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether le_mutex_CreateRecursive() and le_mutex_CreateNonRecursive() create lean mutexes.
+ * See @ref bld_cfg_mutex_lean.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifdef LE_MUTEX_LEAN
+#define LEAN_BY_DEFAULT true
+#else
+#define LEAN_BY_DEFAULT false
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lean mutex futex word values.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LEAN_UNLOCKED   0   ///< Not locked.
+#define LEAN_LOCKED     1   ///< Locked, no other thread waiting.
+#define LEAN_CONTENDED  2   ///< Locked, and other threads may be waiting.
+
+
 // ==============================
 //  PRIVATE FUNCTIONS
 // ==============================
@@ -115,10 +148,11 @@ static pthread_mutex_t MutexListMutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
  * @note Terminates the process on failure, so no need to check the return value for errors.
  */
 //--------------------------------------------------------------------------------------------------
-le_mutex_Ref_t CreateMutex
+static le_mutex_Ref_t CreateMutex
 (
     const char* nameStr,
-    bool        isRecursive
+    bool        isRecursive,
+    bool        isLean
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -131,6 +165,9 @@ le_mutex_Ref_t CreateMutex
     pthread_mutex_init(&mutexPtr->waitingListMutex, NULL);  // Default attributes = Fast mutex.
     mutexPtr->isRecursive = isRecursive;
     mutexPtr->lockCount = 0;
+    mutexPtr->isLean = isLean;
+    mutexPtr->isTracked = false;
+    mutexPtr->futexWord = LEAN_UNLOCKED;
     if (le_utf8_Copy(mutexPtr->name, nameStr, sizeof(mutexPtr->name), NULL) == LE_OVERFLOW)
     {
         LE_WARN("Mutex name '%s' truncated to '%s'.", nameStr, mutexPtr->name);
@@ -234,7 +271,8 @@ static void MarkLocked
     le_dls_Stack(&perThreadRecPtr->lockedMutexList, &mutexPtr->lockedByThreadLink);
 
     // Record the current thread in the Mutex object as the thread that currently holds the lock.
-    mutexPtr->lockingThreadRef = le_thread_GetCurrent();
+    // NOTE: Lean mutexes read this without holding the lock, hence the atomic store.
+    __atomic_store_n(&mutexPtr->lockingThreadRef, le_thread_GetCurrent(), __ATOMIC_RELAXED);
 }
 
 
@@ -263,7 +301,182 @@ static void MarkUnlocked
     le_dls_Remove(&perThreadRecPtr->lockedMutexList, &mutexPtr->lockedByThreadLink);
 
     // Record in the Mutex object that no thread currently holds the lock.
-    mutexPtr->lockingThreadRef = NULL;
+    __atomic_store_n(&mutexPtr->lockingThreadRef, NULL, __ATOMIC_RELAXED);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Performs a futex operation on a lean mutex's futex word.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void Futex
+(
+    Mutex_t*    mutexPtr,   ///< [in] Pointer to the lean Mutex object.
+    int         op,         ///< [in] FUTEX_WAIT_PRIVATE or FUTEX_WAKE_PRIVATE.
+    uint32_t    val         ///< [in] Expected futex word value (wait) or threads to wake (wake).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // EAGAIN (the word changed before we slept) and EINTR are both handled by the caller
+    // re-checking the futex word.
+    syscall(SYS_futex, &mutexPtr->futexWord, op, val, NULL, NULL, 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tries to lock a lean mutex that the calling thread doesn't already hold, without blocking.
+ *
+ * @return  true if the lock was taken.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool LeanTryAcquire
+(
+    Mutex_t* mutexPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t expected = LEAN_UNLOCKED;
+
+    return __atomic_compare_exchange_n(&mutexPtr->futexWord,
+                                       &expected,
+                                       LEAN_LOCKED,
+                                       false,
+                                       __ATOMIC_ACQUIRE,
+                                       __ATOMIC_RELAXED);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether the calling thread already holds a lean mutex.  If so, the lock count is
+ * incremented (recursive mutex) or the deadlock is reported (non-recursive mutex).
+ *
+ * Another thread can change lockingThreadRef at any time, but never to or from the calling
+ * thread's own reference, so comparing against that is safe without holding the lock.
+ *
+ * @return  true if the calling thread already held the mutex.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool LeanRelock
+(
+    Mutex_t*        mutexPtr,
+    le_thread_Ref_t currentThread
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (__atomic_load_n(&mutexPtr->lockingThreadRef, __ATOMIC_RELAXED) != currentThread)
+    {
+        return false;
+    }
+
+    if (!mutexPtr->isRecursive)
+    {
+        LE_FATAL("DEADLOCK DETECTED! Thread '%s' attempting to re-lock mutex '%s'.",
+                 le_thread_GetMyName(),
+                 mutexPtr->name);
+    }
+
+    mutexPtr->lockCount++;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records the calling thread as the holder of a lean mutex it has just taken without contention.
+ * Only the holding thread is recorded; the thread's locked mutexes list is left alone.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void LeanMarkLocked
+(
+    Mutex_t*        mutexPtr,
+    le_thread_Ref_t currentThread
+)
+//--------------------------------------------------------------------------------------------------
+{
+    mutexPtr->lockCount = 1;
+    __atomic_store_n(&mutexPtr->lockingThreadRef, currentThread, __ATOMIC_RELAXED);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Locks a lean mutex.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LeanLock
+(
+    Mutex_t* mutexPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_thread_Ref_t currentThread = le_thread_GetCurrent();
+
+    if (LeanRelock(mutexPtr, currentThread))
+    {
+        return;
+    }
+
+    // Fast path: nobody holds the lock.
+    if (LeanTryAcquire(mutexPtr))
+    {
+        LeanMarkLocked(mutexPtr, currentThread);
+        return;
+    }
+
+    // Slow path: this thread is going to wait, so make that visible to the diagnostic tools.
+    mutex_ThreadRec_t* perThreadRecPtr = thread_GetMutexRecPtr();
+
+    AddToWaitingList(mutexPtr, perThreadRecPtr);
+
+    // Mark the mutex contended, so that the holder wakes someone up when it unlocks.  Whoever
+    // gets the lock this way leaves it marked contended, as other threads may still be waiting.
+    uint32_t state = __atomic_exchange_n(&mutexPtr->futexWord, LEAN_CONTENDED, __ATOMIC_ACQUIRE);
+    while (state != LEAN_UNLOCKED)
+    {
+        Futex(mutexPtr, FUTEX_WAIT_PRIVATE, LEAN_CONTENDED);
+        state = __atomic_exchange_n(&mutexPtr->futexWord, LEAN_CONTENDED, __ATOMIC_ACQUIRE);
+    }
+
+    RemoveFromWaitingList(mutexPtr, perThreadRecPtr);
+
+    // A contended mutex is worth showing as held, so track it like a normal mutex until unlock.
+    mutexPtr->lockCount = 1;
+    mutexPtr->isTracked = true;
+    MarkLocked(perThreadRecPtr, mutexPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases the lock on a lean mutex whose lock count has just dropped to zero.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LeanUnlock
+(
+    Mutex_t* mutexPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (mutexPtr->isTracked)
+    {
+        mutexPtr->isTracked = false;
+        MarkUnlocked(mutexPtr);
+    }
+    else
+    {
+        __atomic_store_n(&mutexPtr->lockingThreadRef, NULL, __ATOMIC_RELAXED);
+    }
+
+    // Only make a system call if another thread may be waiting.
+    if (__atomic_fetch_sub(&mutexPtr->futexWord, 1, __ATOMIC_RELEASE) != LEAN_LOCKED)
+    {
+        __atomic_store_n(&mutexPtr->futexWord, LEAN_UNLOCKED, __ATOMIC_RELEASE);
+        Futex(mutexPtr, FUTEX_WAKE_PRIVATE, 1);
+    }
 }
 
 
@@ -371,7 +584,7 @@ le_mutex_Ref_t le_mutex_CreateRecursive
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return CreateMutex(nameStr, true);
+    return CreateMutex(nameStr, true, LEAN_BY_DEFAULT);
 }
 
 
@@ -390,7 +603,45 @@ le_mutex_Ref_t le_mutex_CreateNonRecursive
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return CreateMutex(nameStr, false);
+    return CreateMutex(nameStr, false, LEAN_BY_DEFAULT);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Lean, Recursive mutex
+ *
+ * @return  Returns a reference to the mutex.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_mutex_Ref_t le_mutex_CreateLeanRecursive
+(
+    const char* nameStr     ///< [in] Name of the mutex
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return CreateMutex(nameStr, true, true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Lean, Non-Recursive mutex
+ *
+ * @return  Returns a reference to the mutex.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_mutex_Ref_t le_mutex_CreateLeanNonRecursive
+(
+    const char* nameStr     ///< [in] Name of the mutex
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return CreateMutex(nameStr, false, true);
 }
 
 
@@ -410,6 +661,23 @@ void le_mutex_Delete
     le_dls_Remove(&MutexList, &mutexRef->mutexListLink);
     UNLOCK_MUTEX_LIST();
 
+    if (mutexRef->isLean)
+    {
+        if (mutexRef->futexWord != LEAN_UNLOCKED)
+        {
+            char threadName[LIMIT_MAX_THREAD_NAME_BYTES];
+            le_thread_GetName(mutexRef->lockingThreadRef, threadName, sizeof(threadName));
+            LE_FATAL(   "Mutex '%s' deleted while still locked by thread '%s'!",
+                        mutexRef->name,
+                        threadName  );
+        }
+
+        // The pthreads mutex is never used by a lean mutex, so it can't be locked.
+        pthread_mutex_destroy(&mutexRef->mutex);
+        le_mem_Release(mutexRef);
+        return;
+    }
+
     if (mutexRef->lockingThreadRef != NULL)
 
     // Destroy the pthreads mutex.
@@ -440,6 +708,12 @@ void le_mutex_Lock
 {
     int result;
 
+    if (mutexRef->isLean)
+    {
+        LeanLock(mutexRef);
+        return;
+    }
+
     mutex_ThreadRec_t* perThreadRecPtr = thread_GetMutexRecPtr();
 
     AddToWaitingList(mutexRef, perThreadRecPtr);
@@ -501,6 +775,28 @@ le_result_t le_mutex_TryLock
 )
 //--------------------------------------------------------------------------------------------------
 {
+    if (mutexRef->isLean)
+    {
+        le_thread_Ref_t currentThread = le_thread_GetCurrent();
+
+        // A non-recursive mutex that this thread already holds is just busy, like a pthreads
+        // error-checking mutex would report.
+        if ((!mutexRef->isRecursive) && (mutexRef->lockingThreadRef == currentThread))
+        {
+            return LE_WOULD_BLOCK;
+        }
+        if (LeanRelock(mutexRef, currentThread))
+        {
+            return LE_OK;
+        }
+        if (!LeanTryAcquire(mutexRef))
+        {
+            return LE_WOULD_BLOCK;
+        }
+        LeanMarkLocked(mutexRef, currentThread);
+        return LE_OK;
+    }
+
     int result = pthread_mutex_trylock(&mutexRef->mutex);
 
     if (result == 0)
@@ -573,6 +869,15 @@ void le_mutex_Unlock
     //       updated by anyone who doesn't hold the lock on the mutex.
     mutexRef->lockCount--;
 
+    if (mutexRef->isLean)
+    {
+        if (mutexRef->lockCount == 0)
+        {
+            LeanUnlock(mutexRef);
+        }
+        return;
+    }
+
     // If we have now reached a lock count of zero, the mutex is about to be unlocked, so
     // Update the data structures to reflect that the current thread no longer holds the
     // mutex.
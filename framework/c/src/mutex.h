@@ -27,6 +27,9 @@ typedef struct le_mutex
     bool                isRecursive;        ///< true if recursive, false otherwise.
     int                 lockCount;      ///< Number of lock calls not yet matched by unlock calls.
     pthread_mutex_t     mutex;          ///< Pthreads mutex that does the real work. :)
+    bool                isLean;         ///< true if locked through futexWord instead of mutex.
+    bool                isTracked;      ///< Lean mutex: on the holder's locked mutexes list.
+    uint32_t            futexWord;      ///< Lean mutex: 0 = unlocked, 1 = locked, 2 = contended.
     char                name[MAX_NAME_BYTES]; ///< The name of the mutex (UTF8 string).
 }
 Mutex_t;
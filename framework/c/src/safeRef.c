@@ -153,11 +153,12 @@ le_ref_MapRef_t le_ref_CreateMap
     ///       get by undetected.
     mapPtr->nextRefNum = 0x10000001; // Use only odd numbers.
 
-    mapPtr->referenceMap = le_hashmap_Create(mapPtr->name,
-                                             maxRefs,
-                                             hashSafeRef,
-                                             equalsSafeRef
-                                            );
+    // maxRefs is often a guess, so use a map that grows rather than one that degrades.
+    mapPtr->referenceMap = le_hashmap_CreateDynamic(mapPtr->name,
+                                                    maxRefs,
+                                                    hashSafeRef,
+                                                    equalsSafeRef
+                                                   );
 
     return mapPtr;
 }
@@ -70,7 +70,7 @@ User List ------> User --+---> Name               |        |        |
 @endverbatim
  *
  * The User object represents a single user account.  It has a unique ID which is used as the key
- * to find it in the User List.  Each User also has
+ * to find it in the User Map (a hash map that indexes the User List).  Each User also has
  *  - list of bindings from a client-side interface name to a server's user name and service name.
  *  - list of services that it offers, and
  *  - list of client connections that are waiting for a binding to be created for them.
@@ -98,21 +98,26 @@ User List ------> User --+---> Name               |        |        |
  * Each Binding object and Connection object holds a reference count on a User object.  A User
  * object will be deleted when all associated Binding objects and Connection objects are deleted.
  *
+ * So that opening a session doesn't require walking lists, Binding objects are also indexed by
+ * (client User, client interface name) in the Binding Map, and Server Connection objects that
+ * are on a Service List are also indexed by (server User, service name) in the Service Map.
+ * The lists are still kept, because they are what the 'sdir' tool walks to list things.
+ *
  *
  * @section sd_theoryOfOperation Theory of Operation
  *
  * When a client connects and makes a request to open a service, the client's UID is looked up in
- * the User List.  The client User's Binding List is searched for the interface name provided by
- * the client.  If a matching Binding object is not found, the Client Connection object is added
- * to the User object's Unbound Clients List.  If a matching Binding object is found, it will
- * specify the server User object and service name.  The server's User's Service List will be
+ * the User Map.  The client User's binding of the interface name provided by the client is
+ * looked up in the Binding Map.  If a matching Binding object is not found, the Client Connection
+ * object is added to the User object's Unbound Clients List.  If a matching Binding object is
+ * found, it will specify the server User object and service name.  The Service Map will be
  * searched for a matching Server Connection object.  If no matching Server Connection can be
  * found, the Client Connection is added to the Binding object's Waiting Clients List.
  *
- * When a server connects and advertises a service, the server UID is looked-up in the User List.
- * The service name is then searched for in the Service List for that User.  If a Server Connection
- * object is not found for that service name on that User, the new one is is added to the list.
- * Otherwise, the new server connection is dropped.
+ * When a server connects and advertises a service, the server UID is looked-up in the User Map.
+ * The service name is then looked up in the Service Map for that User.  If a Server Connection
+ * object is not found for that service name on that User, the new one is is added to the User's
+ * Service List and to the Service Map.  Otherwise, the new server connection is dropped.
  *
  * When a new Server Connection is added to a Service List, all users' Binding Lists are
  * searched for matching bindings, and if any that match have non-empty Waiting Clients Lists,
@@ -220,6 +225,15 @@ User List ------> User --+---> Name               |        |        |
 #define MAX_CONNECT_REQUEST_BACKLOG 100
 
 
+//--------------------------------------------------------------------------------------------------
+/// The number of users, services and bindings that the lookup maps are sized for.  The maps will
+/// still work if these are exceeded, but lookups will slow down as the hash chains grow.
+//--------------------------------------------------------------------------------------------------
+#define MAX_EXPECTED_USERS      64
+#define MAX_EXPECTED_SERVICES   256
+#define MAX_EXPECTED_BINDINGS   512
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Represents a user.  Objects of this type are allocated from the User Pool and are kept on the
@@ -250,6 +264,27 @@ static le_mem_PoolRef_t UserPoolRef;
 static le_dls_List_t UserList = LE_DLS_LIST_INIT;
 
 
+//--------------------------------------------------------------------------------------------------
+/// The User Map, in which all User objects are indexed by their Unix user ID.
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t UserMapRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key used to look up interfaces that belong to a particular user in the Service Map and the
+ * Binding Map.  Objects that are in those maps hold their own copy of their key, and the name
+ * points into that object.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const User_t*      userPtr;     ///< Ptr to the User object that owns the interface.
+    const char*        name;        ///< Interface name.
+}
+InterfaceKey_t;
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -265,6 +300,7 @@ typedef struct
     User_t*                     userPtr;        ///< Pointer to the User object for the client uid.
     pid_t                       pid;            ///< Process ID of client process.
     svcdir_InterfaceDetails_t   interface;      ///< IPC interface details.
+    InterfaceKey_t              key;            ///< Key in the Service Map, if on Service List.
 }
 ServerConnection_t;
 
@@ -275,6 +311,13 @@ ServerConnection_t;
 static le_mem_PoolRef_t ServerConnectionPoolRef;
 
 
+//--------------------------------------------------------------------------------------------------
+/// The Service Map, in which all Server Connection objects that are on a User's Service List are
+/// indexed by (server User, service name).
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t ServiceMapRef;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Represents a binding from a user's client interface to a service.  Objects of this type are
@@ -290,6 +333,7 @@ typedef struct
     char                serverInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES];///< Service name
     ServerConnection_t* serverConnectionPtr;///< Ptr to Server Connection (NULL if service unavail.)
     le_dls_List_t       waitingClientsList; ///< List of Client Connections waiting for the service.
+    InterfaceKey_t      key;                ///< Key in the Binding Map.
 }
 Binding_t;
 
@@ -300,6 +344,13 @@ Binding_t;
 static le_mem_PoolRef_t BindingPoolRef;
 
 
+//--------------------------------------------------------------------------------------------------
+/// The Binding Map, in which all Binding objects are indexed by (client User, client interface
+/// name).
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t BindingMapRef;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Enumeration of the different states that a client connection can be in.
@@ -370,6 +421,47 @@ static le_fdMonitor_Ref_t ServerSocketMonitorRef;
 // =======================================
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key hash function for the Service Map and the Binding Map.
+ *
+ * @return  The hash value for an interface key.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t ComputeInterfaceKeyHash
+(
+    const void* keyPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const InterfaceKey_t* interfaceKeyPtr = keyPtr;
+
+    // Many users tend to offer or use interfaces with the same names (e.g., "le_cfg"), so mix the
+    // user ID into the hash to keep those from all landing in the same bucket.
+    return (le_hashmap_HashString(interfaceKeyPtr->name) * 31) + interfaceKeyPtr->userPtr->uid;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key equality comparison function for the Service Map and the Binding Map.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AreInterfaceKeysTheSame
+(
+    const void* firstKeyPtr,
+    const void* secondKeyPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const InterfaceKey_t* firstInterfaceKeyPtr = firstKeyPtr;
+    const InterfaceKey_t* secondInterfaceKeyPtr = secondKeyPtr;
+
+    return (   (firstInterfaceKeyPtr->userPtr == secondInterfaceKeyPtr->userPtr)
+            && le_hashmap_EqualsString(firstInterfaceKeyPtr->name, secondInterfaceKeyPtr->name) );
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a User object for a given Unix user ID.
@@ -399,8 +491,9 @@ static User_t* CreateUser
     userPtr->serviceList = LE_DLS_LIST_INIT;
     userPtr->unboundClientsList = LE_DLS_LIST_INIT;
 
-    // Add it to the User List.
+    // Add it to the User List and the User Map.
     le_dls_Queue(&UserList, &userPtr->link);
+    le_hashmap_Put(UserMapRef, &userPtr->uid, userPtr);
 
     return userPtr;
 }
@@ -408,7 +501,7 @@ static User_t* CreateUser
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches the User List for a particular Unix user ID.  If found, increments the reference count
+ * Looks up a particular Unix user ID in the User Map.  If found, increments the reference count
  * on that object.  If not found, creates a new User object.
  *
  * @return Pointer to the User object.
@@ -420,19 +513,12 @@ static User_t* GetUser
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&UserList);
+    User_t* userPtr = le_hashmap_Get(UserMapRef, &uid);
 
-    while (linkPtr != NULL)
+    if (userPtr != NULL)
     {
-        User_t* userPtr = CONTAINER_OF(linkPtr, User_t, link);
-
-        if (userPtr->uid == uid)
-        {
-            le_mem_AddRef(userPtr);
-            return userPtr;
-        }
-
-        linkPtr = le_dls_PeekNext(&UserList, linkPtr);
+        le_mem_AddRef(userPtr);
+        return userPtr;
     }
 
     return CreateUser(uid);
@@ -453,14 +539,16 @@ static void UserDestructor
 {
     User_t* userPtr = objPtr;
 
-    // Remove the User object from the User List.
+    // Remove the User object from the User List and the User Map.
     le_dls_Remove(&UserList, &userPtr->link);
+    le_hashmap_Remove(UserMapRef, &userPtr->uid);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches a (client) User's Binding List for a particular client-side interface name.
+ * Looks up a (client) User's binding of a particular client-side interface name in the
+ * Binding Map.
  *
  * @return Pointer to the Binding object or NULL if not found.
  **/
@@ -472,21 +560,9 @@ static Binding_t* FindBinding
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&userPtr->bindingList);
-
-    while (linkPtr != NULL)
-    {
-        Binding_t* bindingPtr = CONTAINER_OF(linkPtr, Binding_t, link);
-
-        if (strcmp(bindingPtr->clientInterfaceName, interfaceName) == 0)
-        {
-            return bindingPtr;
-        }
-
-        linkPtr = le_dls_PeekNext(&userPtr->bindingList, linkPtr);
-    }
+    InterfaceKey_t key = { .userPtr = userPtr, .name = interfaceName };
 
-    return NULL;
+    return le_hashmap_Get(BindingMapRef, &key);
 }
 
 
@@ -597,7 +673,7 @@ static le_result_t ReceiveMessage
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches a User's Service List for a particular service name.
+ * Looks up a service offered by a User in the Service Map.
  *
  * @return Pointer to the Server Connection object for the matching service.
  **/
@@ -609,21 +685,9 @@ static ServerConnection_t* FindService
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&userPtr->serviceList);
+    InterfaceKey_t key = { .userPtr = userPtr, .name = serviceName };
 
-    while (linkPtr != NULL)
-    {
-        ServerConnection_t* serverConnectionPtr = CONTAINER_OF(linkPtr, ServerConnection_t, link);
-
-        if (strcmp(serverConnectionPtr->interface.interfaceName, serviceName) == 0)
-        {
-            return serverConnectionPtr;
-        }
-
-        linkPtr = le_dls_PeekNext(&userPtr->serviceList, linkPtr);
-    }
-
-    return NULL;
+    return le_hashmap_Get(ServiceMapRef, &key);
 }
 
 
@@ -917,8 +981,11 @@ static void CreateBinding
     bindingPtr->serverConnectionPtr = NULL;
     bindingPtr->waitingClientsList = LE_DLS_LIST_INIT;
 
-    // Add the Binding to the client User's Binding List.
+    // Add the Binding to the client User's Binding List and the Binding Map.
     le_dls_Queue(&bindingPtr->clientUserPtr->bindingList, &bindingPtr->link);
+    bindingPtr->key.userPtr = bindingPtr->clientUserPtr;
+    bindingPtr->key.name = bindingPtr->clientInterfaceName;
+    le_hashmap_Put(BindingMapRef, &bindingPtr->key, bindingPtr);
 
     // Look for a server serving the binding's destination service.
     bindingPtr->serverConnectionPtr = FindService(bindingPtr->serverUserPtr, serverInterfaceName);
@@ -1066,8 +1133,11 @@ static void ProcessAdvertisementFromServer
     // connection to the service list.
     else
     {
-        // Add the object to the User's Service List.
+        // Add the object to the User's Service List and the Service Map.
         le_dls_Queue(&connectionPtr->userPtr->serviceList, &connectionPtr->link);
+        connectionPtr->key.userPtr = connectionPtr->userPtr;
+        connectionPtr->key.name = connectionPtr->interface.interfaceName;
+        le_hashmap_Put(ServiceMapRef, &connectionPtr->key, connectionPtr);
 
         LE_DEBUG("Server (uid %u '%s', pid %d) now serving service '%s' (%s).",
                  connectionPtr->userPtr->uid,
@@ -1506,7 +1576,12 @@ static void ServerReadHandler
     bool alreadyReceivedServiceId = (connectionPtr->interface.interfaceName[0] != '\0');
 
     // Receive the service identity from the server.
-    result = ReceiveMessage(fd, &(connectionPtr->interface), sizeof(connectionPtr->interface));
+    // NOTE: Once the service identity has been received, the connection may be in the Service Map,
+    //       keyed by the service name, so anything else received must not overwrite it.
+    svcdir_InterfaceDetails_t extraData;
+    svcdir_InterfaceDetails_t* bufferPtr = (alreadyReceivedServiceId ? &extraData
+                                                                     : &(connectionPtr->interface));
+    result = ReceiveMessage(fd, bufferPtr, sizeof(*bufferPtr));
 
     // If the connection has closed or there is simply nothing left to be received
     // from the socket,
@@ -1671,12 +1746,14 @@ static void ServerConnectionDestructor
                  connectionPtr->interface.interfaceName,
                  connectionPtr->interface.protocolId);
 
-        // Remove the Server Connection from the User's Service List, if it has been added.
+        // Remove the Server Connection from the User's Service List and the Service Map, if it
+        // has been added.
         // NOTE: If the connection is rejected because of a bad or duplicate advertisement,
         //       then the connection will not have made it into the user's list of services.
         if (le_dls_IsInList(&connectionPtr->userPtr->serviceList, &connectionPtr->link))
         {
             le_dls_Remove(&connectionPtr->userPtr->serviceList, &connectionPtr->link);
+            le_hashmap_Remove(ServiceMapRef, &connectionPtr->key);
         }
     }
 
@@ -1767,8 +1844,9 @@ static void BindingDestructor
 {
     Binding_t* bindingPtr = objPtr;
 
-    // Remove the Binding object from the User's Binding List.
+    // Remove the Binding object from the User's Binding List and the Binding Map.
     le_dls_Remove(&bindingPtr->clientUserPtr->bindingList, &bindingPtr->link);
+    le_hashmap_Remove(BindingMapRef, &bindingPtr->key);
 
     // While the list of waiting clients is not empty, pop one off and process it.
     le_dls_Link_t* linkPtr;
@@ -2567,6 +2645,20 @@ COMPONENT_INIT
     le_mem_SetDestructor(UserPoolRef, UserDestructor);
     le_mem_SetDestructor(BindingPoolRef, BindingDestructor);
 
+    // Create the lookup maps.
+    UserMapRef = le_hashmap_Create("Users",
+                                   MAX_EXPECTED_USERS,
+                                   le_hashmap_HashUInt32,
+                                   le_hashmap_EqualsUInt32);
+    ServiceMapRef = le_hashmap_Create("Services",
+                                      MAX_EXPECTED_SERVICES,
+                                      ComputeInterfaceKeyHash,
+                                      AreInterfaceKeysTheSame);
+    BindingMapRef = le_hashmap_Create("Bindings",
+                                      MAX_EXPECTED_BINDINGS,
+                                      ComputeInterfaceKeyHash,
+                                      AreInterfaceKeysTheSame);
+
     // Create built-in, hard-coded bindings.
     CreateHardCodedBindings();
 
@@ -20,6 +20,11 @@
 
 #define DEFAULT_POOL_NAME "Default Timer Pool"
 #define DEFAULT_POOL_INITIAL_SIZE 1
+#define DEFAULT_POOL_THREAD_CACHE_SIZE 4
+
+/// Number of timers a thread's active timer heap can hold when it is first allocated.  The heap
+/// doubles in size whenever it fills up.
+#define MIN_HEAP_CAPACITY 16
 
 
 //--------------------------------------------------------------------------------------------------
@@ -104,7 +109,10 @@ static void InitTimer
     timerPtr->interval = initTime;
     timerPtr->repeatCount = 1;
     timerPtr->contextPtr = NULL;
+    timerPtr->tolerance = initTime;
     timerPtr->link = LE_DLS_LINK_INIT;
+    timerPtr->heapIndex = 0;
+    timerPtr->startCount = 0;
     timerPtr->isActive = false;
     timerPtr->expiryTime = initTime;
     timerPtr->expiryCount = 0;
@@ -113,51 +121,196 @@ static void InitTimer
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add the timer record to the given list, sorted according to the timer value
+ * Check whether a timer in the active timer heap should expire before another.  Timers with the
+ * same expiry time expire in the order they were started.
+ *
+ * @return
+ *      - true if timer A expires before timer B
+ *      - false otherwise
  */
 //--------------------------------------------------------------------------------------------------
-static void AddToTimerList
+static inline bool ExpiresBefore
 (
-    le_dls_List_t* listPtr,               ///< [IN] The list to add to.
-    Timer_t* newTimerPtr                  ///< [IN] The timer to add
+    Timer_t* timerAPtr,                   ///< [IN] Timer A
+    Timer_t* timerBPtr                    ///< [IN] Timer B
 )
 {
-    Timer_t* timerPtr;
-    le_dls_Link_t* linkPtr;
+    if (timerAPtr->expiryTime.sec != timerBPtr->expiryTime.sec)
+    {
+        return (timerAPtr->expiryTime.sec < timerBPtr->expiryTime.sec);
+    }
 
-    if ( newTimerPtr->isActive )
+    if (timerAPtr->expiryTime.usec != timerBPtr->expiryTime.usec)
     {
-        LE_ERROR("Timer '%s' is already active", newTimerPtr->name);
-        return;
+        return (timerAPtr->expiryTime.usec < timerBPtr->expiryTime.usec);
     }
 
-    // Get the start of the list
-    linkPtr = le_dls_Peek(listPtr);
+    return (timerAPtr->startCount < timerBPtr->startCount);
+}
 
-    // Find the timer whose expiry time is greater than the new timer.
-    while ( linkPtr != NULL )
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a timer into the given slot of the active timer heap.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void SetHeapSlot
+(
+    timer_ThreadRec_t* threadRecPtr,      ///< [IN] The thread's timer record.
+    size_t index,                         ///< [IN] The slot in the heap.
+    Timer_t* timerPtr                     ///< [IN] The timer to put there.
+)
+{
+    threadRecPtr->heapPtr[index] = timerPtr;
+    timerPtr->heapIndex = index;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move a timer up the active timer heap until its parent expires before it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SiftUp
+(
+    timer_ThreadRec_t* threadRecPtr,      ///< [IN] The thread's timer record.
+    size_t index                          ///< [IN] The slot of the timer to move.
+)
+{
+    Timer_t* timerPtr = threadRecPtr->heapPtr[index];
+
+    while (index > 0)
     {
-        timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
+        size_t parentIndex = (index - 1) / 2;
+        Timer_t* parentPtr = threadRecPtr->heapPtr[parentIndex];
 
-        if ( le_clk_GreaterThan(timerPtr->expiryTime, newTimerPtr->expiryTime) )
+        if ( ! ExpiresBefore(timerPtr, parentPtr) )
+        {
             break;
+        }
 
-        linkPtr = le_dls_PeekNext(listPtr, linkPtr);
+        SetHeapSlot(threadRecPtr, index, parentPtr);
+        index = parentIndex;
+    }
+
+    SetHeapSlot(threadRecPtr, index, timerPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move a timer down the active timer heap until both of its children expire after it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SiftDown
+(
+    timer_ThreadRec_t* threadRecPtr,      ///< [IN] The thread's timer record.
+    size_t index                          ///< [IN] The slot of the timer to move.
+)
+{
+    Timer_t* timerPtr = threadRecPtr->heapPtr[index];
+    size_t heapSize = threadRecPtr->heapSize;
+
+    for (;;)
+    {
+        size_t childIndex = (2 * index) + 1;
+
+        if (childIndex >= heapSize)
+        {
+            break;
+        }
+
+        // Pick the child that expires first.
+        if ( ((childIndex + 1) < heapSize) &&
+             ExpiresBefore(threadRecPtr->heapPtr[childIndex + 1], threadRecPtr->heapPtr[childIndex]) )
+        {
+            childIndex++;
+        }
+
+        if ( ! ExpiresBefore(threadRecPtr->heapPtr[childIndex], timerPtr) )
+        {
+            break;
+        }
+
+        SetHeapSlot(threadRecPtr, index, threadRecPtr->heapPtr[childIndex]);
+        index = childIndex;
+    }
+
+    SetHeapSlot(threadRecPtr, index, timerPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take a timer out of the active timer heap and take it off the active list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveFromHeap
+(
+    timer_ThreadRec_t* threadRecPtr,      ///< [IN] The thread's timer record.
+    Timer_t* timerPtr                     ///< [IN] The timer to remove
+)
+{
+    size_t index = timerPtr->heapIndex;
+
+    LE_ASSERT( (index < threadRecPtr->heapSize) && (threadRecPtr->heapPtr[index] == timerPtr) );
+
+    // Fill the hole with the last timer in the heap, and then move that timer up or down to
+    // where it belongs.
+    threadRecPtr->heapSize--;
+    if (index < threadRecPtr->heapSize)
+    {
+        SetHeapSlot(threadRecPtr, index, threadRecPtr->heapPtr[threadRecPtr->heapSize]);
+        SiftUp(threadRecPtr, index);
+        SiftDown(threadRecPtr, threadRecPtr->heapPtr[index]->heapIndex);
     }
 
     ListOfTimersChgCnt++;
-    if (linkPtr == NULL)
+    le_dls_Remove(&threadRecPtr->activeTimerList, &timerPtr->link);
+
+    // The timer is no longer on the active list
+    timerPtr->isActive = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the timer record to the given thread's active timers, ordered according to the timer value.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToTimerList
+(
+    timer_ThreadRec_t* threadRecPtr,      ///< [IN] The thread's timer record.
+    Timer_t* newTimerPtr                  ///< [IN] The timer to add
+)
+{
+    if ( newTimerPtr->isActive )
     {
-        // The list is either empty, or the new timer has the largest expiry time.
-        // In either case, add the new timer to the end of the list.
-        le_dls_Queue(listPtr, &newTimerPtr->link);
+        LE_ERROR("Timer '%s' is already active", newTimerPtr->name);
+        return;
     }
-    else
+
+    // Grow the heap if it is full.
+    if (threadRecPtr->heapSize == threadRecPtr->heapCapacity)
     {
-        // Found a timer with larger expiry time; insert the new timer before it.
-        le_dls_AddBefore(listPtr, linkPtr, &newTimerPtr->link);
+        size_t newCapacity = (threadRecPtr->heapCapacity == 0) ? MIN_HEAP_CAPACITY
+                                                               : (threadRecPtr->heapCapacity * 2);
+
+        threadRecPtr->heapPtr = realloc(threadRecPtr->heapPtr, newCapacity * sizeof(Timer_t*));
+        LE_ASSERT(threadRecPtr->heapPtr != NULL);
+
+        threadRecPtr->heapCapacity = newCapacity;
     }
 
+    newTimerPtr->startCount = threadRecPtr->startCount++;
+
+    SetHeapSlot(threadRecPtr, threadRecPtr->heapSize, newTimerPtr);
+    threadRecPtr->heapSize++;
+    SiftUp(threadRecPtr, newTimerPtr->heapIndex);
+
+    ListOfTimersChgCnt++;
+    le_dls_Queue(&threadRecPtr->activeTimerList, &newTimerPtr->link);
+
     // The new timer is now on the active list
     newTimerPtr->isActive = true;
 }
@@ -165,24 +318,21 @@ static void AddToTimerList
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Peek at the first timer from the given timer list
+ * Peek at the first timer from the given thread's active timers
  *
  * @return:
- *      - pointer to the first timer on the list
- *      - NULL if the list is empty
+ *      - pointer to the timer that expires first
+ *      - NULL if there are no active timers
  */
 //--------------------------------------------------------------------------------------------------
 static Timer_t* PeekFromTimerList
 (
-    le_dls_List_t* listPtr              ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] The thread's timer record.
 )
 {
-    le_dls_Link_t* linkPtr;
-
-    linkPtr = le_dls_Peek(listPtr);
-    if (linkPtr != NULL)
+    if (threadRecPtr->heapSize > 0)
     {
-        return ( CONTAINER_OF(linkPtr, Timer_t, link) );
+        return threadRecPtr->heapPtr[0];
     }
     return NULL;
 }
@@ -190,48 +340,40 @@ static Timer_t* PeekFromTimerList
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Pop the first timer from the given timer list
+ * Pop the first timer from the given thread's active timers
  *
  * @return:
- *      - pointer to the first timer on the list
- *      - NULL if the list is empty
+ *      - pointer to the timer that expires first
+ *      - NULL if there are no active timers
  */
 //--------------------------------------------------------------------------------------------------
 static Timer_t* PopFromTimerList
 (
-    le_dls_List_t* listPtr              ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] The thread's timer record.
 )
 {
-    le_dls_Link_t* linkPtr;
-    Timer_t* timerPtr;
+    Timer_t* timerPtr = PeekFromTimerList(threadRecPtr);
 
-    linkPtr = le_dls_Pop(listPtr);
-    if (linkPtr != NULL)
+    if (timerPtr != NULL)
     {
-        ListOfTimersChgCnt++;
-        timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
-
-        // The timer is no longer on the active list
-        timerPtr->isActive = false;
-
-        return timerPtr;
+        RemoveFromHeap(threadRecPtr, timerPtr);
     }
-    return NULL;
+    return timerPtr;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Remove the timer from the given timer list
+ * Remove the timer from the given thread's active timers
  *
  * @return
  *      - LE_OK on success
- *      - LE_FAULT if the timer was not in the list
+ *      - LE_FAULT if the timer was not active
  */
 //--------------------------------------------------------------------------------------------------
 static le_result_t RemoveFromTimerList
 (
-    le_dls_List_t* listPtr,             ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr,    ///< [IN] The thread's timer record.
     Timer_t* timerPtr                   ///< [IN] The timer to remove
 )
 {
@@ -240,15 +382,90 @@ static le_result_t RemoveFromTimerList
         return LE_FAULT;
     }
 
-    // Remove the timer from the active list
-    timerPtr->isActive = false;
-    ListOfTimersChgCnt++;
-    le_dls_Remove(listPtr, &timerPtr->link);
+    RemoveFromHeap(threadRecPtr, timerPtr);
 
     return LE_OK;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the latest time a timer can expire at without exceeding its tolerance.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline le_clk_Time_t GetDeadline
+(
+    Timer_t* timerPtr                   ///< [IN] The timer
+)
+{
+    return le_clk_Add(timerPtr->expiryTime, timerPtr->tolerance);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lower the wakeup time to the deadline of any timer in the given sub-heap that has an earlier
+ * deadline.
+ *
+ * Only timers that expire before the wakeup time can have an earlier deadline, and the timers
+ * below a timer in the heap all expire after it, so the search stops at the first timer on each
+ * branch that expires at or after the wakeup time.  Without tolerances, that is the first timer
+ * looked at.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LowerWakeupTime
+(
+    timer_ThreadRec_t* threadRecPtr,    ///< [IN] The thread's timer record.
+    size_t index,                       ///< [IN] The slot of the top of the sub-heap.
+    le_clk_Time_t* wakeupTimePtr        ///< [IN/OUT] The wakeup time.
+)
+{
+    while (index < threadRecPtr->heapSize)
+    {
+        Timer_t* timerPtr = threadRecPtr->heapPtr[index];
+
+        if ( ! le_clk_GreaterThan(*wakeupTimePtr, timerPtr->expiryTime) )
+        {
+            return;
+        }
+
+        le_clk_Time_t deadline = GetDeadline(timerPtr);
+        if ( le_clk_GreaterThan(*wakeupTimePtr, deadline) )
+        {
+            *wakeupTimePtr = deadline;
+        }
+
+        // Search the left branch, and carry on down the right one.
+        LowerWakeupTime(threadRecPtr, (2 * index) + 1, wakeupTimePtr);
+        index = (2 * index) + 2;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Work out when the timerFD has to expire next.  This is the earliest deadline of the running
+ * timers, which is the latest time that none of them will be late.  Every timer that expires
+ * before then is handled by that one wakeup.
+ *
+ * @return
+ *      The wakeup time.  The heap must not be empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t GetWakeupTime
+(
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] The thread's timer record.
+)
+{
+    le_clk_Time_t wakeupTime = GetDeadline(threadRecPtr->heapPtr[0]);
+
+    LowerWakeupTime(threadRecPtr, 1, &wakeupTime);
+    LowerWakeupTime(threadRecPtr, 2, &wakeupTime);
+
+    return wakeupTime;
+}
+
+
 #if 0
 //--------------------------------------------------------------------------------------------------
 /**
@@ -298,17 +515,16 @@ static void PrintTimerList
 //--------------------------------------------------------------------------------------------------
 static void RestartTimerFD
 (
-    Timer_t* timerPtr      ///< [IN] (Re)start this timer object
+    le_clk_Time_t wakeupTime    ///< [IN] Time at which the timerFD should expire
 )
 {
     timer_ThreadRec_t* threadRecPtr = thread_GetTimerRecPtr();
     struct itimerspec timerInterval;
 
-    // Set the timer to expire at the expiry time of the given timer
-    // todo: confirm that this will still work if expiryTime is in the past, as there is a small
-    //       window that this could happen.
-    timerInterval.it_value.tv_sec = timerPtr->expiryTime.sec;
-    timerInterval.it_value.tv_nsec = timerPtr->expiryTime.usec * 1000;
+    // Set the timer to expire at the wakeup time.  If this is already in the past, the timerFD
+    // expires straight away.
+    timerInterval.it_value.tv_sec = wakeupTime.sec;
+    timerInterval.it_value.tv_nsec = wakeupTime.usec * 1000;
 
     // The timerFD does not repeat
     timerInterval.it_interval.tv_sec = 0;
@@ -321,10 +537,12 @@ static void RestartTimerFD
         LE_FATAL("timerfd_settime() failed with errno = %d (%m)", errno);
     }
 
-    TRACE("timer '%s' started", timerPtr->name);
+    TRACE("timerFD=%i started for %ld.%06ld",
+          threadRecPtr->timerFD, (long)wakeupTime.sec, (long)wakeupTime.usec);
 
-    // Store the timer for future reference
-    threadRecPtr->firstTimerPtr = timerPtr;
+    // Store the wakeup time for future reference
+    threadRecPtr->isTimerFdRunning = true;
+    threadRecPtr->wakeupTime = wakeupTime;
 }
 
 
@@ -357,7 +575,38 @@ static void StopTimerFD
     TRACE("timerFD=%i stopped", threadRecPtr->timerFD);
 
     // There is no active timer
-    threadRecPtr->firstTimerPtr = NULL;
+    threadRecPtr->isTimerFdRunning = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bring the timerFD up to date with the running timers: (re)start it if its wakeup time is no
+ * longer right, or stop it if there are no running timers left.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateTimerFD
+(
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] The thread's timer record.
+)
+{
+    if (PeekFromTimerList(threadRecPtr) == NULL)
+    {
+        if (threadRecPtr->isTimerFdRunning)
+        {
+            StopTimerFD();
+        }
+        return;
+    }
+
+    le_clk_Time_t wakeupTime = GetWakeupTime(threadRecPtr);
+
+    if ( ( ! threadRecPtr->isTimerFdRunning ) ||
+         le_clk_GreaterThan(threadRecPtr->wakeupTime, wakeupTime) ||
+         le_clk_GreaterThan(wakeupTime, threadRecPtr->wakeupTime) )
+    {
+        RestartTimerFD(wakeupTime);
+    }
 }
 
 
@@ -394,7 +643,7 @@ static void ProcessExpiredTimer
         expiredTimer->expiryTime = le_clk_Add(expiredTimer->expiryTime, expiredTimer->interval);
 
         // Add the timer back to the timer list
-        AddToTimerList(&threadRecPtr->activeTimerList, expiredTimer);
+        AddToTimerList(threadRecPtr, expiredTimer);
         //PrintTimerList(&threadRecPtr->activeTimerList);
     }
 
@@ -421,6 +670,8 @@ static void TimerFdHandler
     ssize_t numBytes;
     timer_ThreadRec_t* threadRecPtr = thread_GetTimerRecPtr();
     Timer_t* firstTimerPtr;
+    le_clk_Time_t lastExpiryTime = { 0, 0 };
+    size_t numExpired = 0;
 
     LE_ASSERT((events & ~POLLIN) == 0);
 
@@ -446,49 +697,37 @@ static void TimerFdHandler
     LE_ERROR_IF(numBytes != 8, "On TimerFD read, unexpected numBytes=%zd", numBytes);
     LE_ERROR_IF(expiry != 1,  "On TimerFD read, unexpected expiry=%u", (unsigned int)expiry);
 
-    // Pop off the first timer from the active list, and make sure it is the expected timer.
-    firstTimerPtr = PopFromTimerList(&threadRecPtr->activeTimerList);
-    LE_ASSERT( threadRecPtr->firstTimerPtr == firstTimerPtr );
-
-    // Need to reset the expected timer, in case processing the current timer will cause the same
-    // timer to be started again, and put back at the start of the active list. This is necessary
-    // since the timerFD is no longer running, so there is no timer associated with it.
-    threadRecPtr->firstTimerPtr = NULL;
+    // The timerFD is no longer running, so there is no wakeup associated with it.  This has to be
+    // cleared before any expiry handlers are called, in case they start or stop timers.
+    threadRecPtr->isTimerFdRunning = false;
+    threadRecPtr->numWakeups++;
 
-    // It is the expected timer so process it.
-    ProcessExpiredTimer(firstTimerPtr);
-
-    // Check if there are any other timers that have since expired, pop them off the
-    // list and process them.
-    firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+    // Process every timer that has expired by now.  As timers can expire late, up to their
+    // tolerance, these can have different expiry times; each different expiry time after the
+    // first would have needed a wakeup of its own.
+    firstTimerPtr = PeekFromTimerList(threadRecPtr);
     while ( firstTimerPtr != NULL &&
-            le_clk_GreaterThan(le_clk_GetRelativeTime(), firstTimerPtr->expiryTime) )
+            ! le_clk_GreaterThan(firstTimerPtr->expiryTime, le_clk_GetRelativeTime()) )
     {
+        if ( (numExpired > 0) && le_clk_GreaterThan(firstTimerPtr->expiryTime, lastExpiryTime) )
+        {
+            threadRecPtr->numWakeupsSaved++;
+        }
+        lastExpiryTime = firstTimerPtr->expiryTime;
+        numExpired++;
+
         // Pop off the timer and process it
-        firstTimerPtr = PopFromTimerList(&threadRecPtr->activeTimerList);
+        firstTimerPtr = PopFromTimerList(threadRecPtr);
         ProcessExpiredTimer(firstTimerPtr);
 
         // Try the next timer on the list
-        firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
-    }
-
-    // While processing expired timers in the above loop, it is possible that a timer was started,
-    // put in the active list, and expired before the loop completed. If the active list is empty,
-    // but the timerFD is still running, then we need to stop it.
-    if ( (firstTimerPtr == NULL) && ( threadRecPtr->firstTimerPtr != NULL ) )
-    {
-        StopTimerFD();
+        firstTimerPtr = PeekFromTimerList(threadRecPtr);
     }
 
-    // If the next timer on the active list exists, then if the timerFD is not running, or it is
-    // running a timer that is no longer at the beginning of the active list, then (re)start the
-    // timerFD.  The timerFD could be running here, if the expiry handler started a new timer,
-    // although it might no longer be at the beginning of the list, if we had multiple timers
-    // expire, and one of them is a repetitive timer.
-    if ( (firstTimerPtr != NULL) && ( threadRecPtr->firstTimerPtr != firstTimerPtr ) )
-    {
-        RestartTimerFD(firstTimerPtr);
-    }
+    // While processing expired timers in the above loop, expiry handlers may have started or
+    // stopped timers, and repeating timers have been put back on the heap, so work out the next
+    // wakeup from what is left.
+    UpdateTimerFD(threadRecPtr);
 }
 
 // =============================================
@@ -514,6 +753,7 @@ void timer_Init
 
     TimerMemPoolRef = le_mem_CreatePool(DEFAULT_POOL_NAME, sizeof(Timer_t));
     le_mem_ExpandPool(TimerMemPoolRef, DEFAULT_POOL_INITIAL_SIZE);
+    le_mem_EnableThreadCache(TimerMemPoolRef, DEFAULT_POOL_THREAD_CACHE_SIZE);
 
     // Assume CLOCK_MONOTONIC is supported both by timerfd and clock routines.
     // Then, query O/S to see if we could use CLOCK_BOOTTIME/_ALARM.
@@ -573,7 +813,14 @@ void timer_InitThread
 
     recPtr->timerFD = -1;
     recPtr->activeTimerList = LE_DLS_LIST_INIT;
-    recPtr->firstTimerPtr = NULL;
+    recPtr->heapPtr = NULL;
+    recPtr->heapSize = 0;
+    recPtr->heapCapacity = 0;
+    recPtr->startCount = 0;
+    recPtr->isTimerFdRunning = false;
+    recPtr->wakeupTime = (le_clk_Time_t){ 0, 0 };
+    recPtr->numWakeups = 0;
+    recPtr->numWakeupsSaved = 0;
 }
 
 
@@ -626,6 +873,12 @@ void timer_DestructThread
 
         le_mem_Release(timerPtr);
     }
+
+    // Release the timer heap
+    free(threadRecPtr->heapPtr);
+    threadRecPtr->heapPtr = NULL;
+    threadRecPtr->heapSize = 0;
+    threadRecPtr->heapCapacity = 0;
 }
 
 // =============================================
@@ -781,6 +1034,75 @@ le_result_t le_timer_SetMsInterval
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer tolerance
+ *
+ * The timer may expire up to this much later than its interval, so that its expiry can be
+ * handled together with other timers' expiries.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetTolerance
+(
+    le_timer_Ref_t timerRef,     ///< [IN] Set tolerance for this timer object
+    le_clk_Time_t tolerance      ///< [IN] Timer tolerance
+)
+{
+    LE_ASSERT(timerRef != NULL);
+
+    if ( timerRef->isActive )
+    {
+        return LE_BUSY;
+    }
+
+    timerRef->tolerance = tolerance;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer tolerance using milliseconds.
+ *
+ * The timer may expire up to this many milliseconds later than its interval.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetMsTolerance
+(
+    le_timer_Ref_t timerRef,    ///< [IN] Set tolerance for this timer object.
+    size_t tolerance            ///< [IN] Timer tolerance in milliseconds.
+)
+{
+    LE_ASSERT(timerRef != NULL);
+
+    if ( timerRef->isActive )
+    {
+        return LE_BUSY;
+    }
+
+    time_t seconds = tolerance / 1000;
+    timerRef->tolerance.sec = seconds;
+    timerRef->tolerance.usec = (tolerance - (seconds * 1000)) * 1000;
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set how many times the timer will repeat
@@ -928,7 +1250,6 @@ le_result_t le_timer_Start
     TRACE("Starting timer '%s'", timerRef->name);
 
     timer_ThreadRec_t* threadRecPtr = thread_GetTimerRecPtr();
-    Timer_t* firstTimerPtr;
 
     // todo: verify that the minimum number of fields have been appropriately initialized
 
@@ -951,7 +1272,7 @@ le_result_t le_timer_Start
             LE_FATAL("timerfd_create() failed with errno = %d (%m)", errno);
 
         LE_PRINT_VALUE("%i", threadRecPtr->timerFD);
-        threadRecPtr->firstTimerPtr = NULL;
+        threadRecPtr->isTimerFdRunning = false;
 
         // Register the timerFD with the event loop.
         // It will not be triggered until the timer is actually started
@@ -961,18 +1282,17 @@ le_result_t le_timer_Start
     // Add the timer to the timer list. This is the only place we reset the expiry count.
     timerRef->expiryCount = 0;
     timerRef->expiryTime = le_clk_Add(le_clk_GetRelativeTime(), timerRef->interval);
-    AddToTimerList(&threadRecPtr->activeTimerList, timerRef);
+    AddToTimerList(threadRecPtr, timerRef);
     //PrintTimerList(&threadRecPtr->activeTimerList);
 
-    // Get the first timer from the active list. This is needed to determine whether the timerFD
-    // needs to be restarted, in case the new timer was put at the beginning of the list.
-    firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+    // The timerFD is already set to expire at the earliest deadline of the other timers, so it
+    // only has to be (re)started if it is not running, or the new timer's deadline is earlier.
+    le_clk_Time_t deadline = GetDeadline(timerRef);
 
-    // If the timerFD is not running, or it is running a timer that is no longer at the beginning
-    // of the active list, then (re)start the timerFD.
-    if ( threadRecPtr->firstTimerPtr != firstTimerPtr )
+    if ( ( ! threadRecPtr->isTimerFdRunning ) ||
+         le_clk_GreaterThan(threadRecPtr->wakeupTime, deadline) )
     {
-        RestartTimerFD(firstTimerPtr);
+        RestartTimerFD(deadline);
     }
 
     return LE_OK;
@@ -1007,30 +1327,19 @@ le_result_t le_timer_Stop
 
     // Timer is valid and active; proceed with stopping it.
     le_result_t result;
-    Timer_t* firstTimerPtr;
 
     timer_ThreadRec_t* threadRecPtr = thread_GetTimerRecPtr();
 
-    result = RemoveFromTimerList(&threadRecPtr->activeTimerList, timerRef);
+    result = RemoveFromTimerList(threadRecPtr, timerRef);
     if (result == LE_OK)
     {
-        // If the timer was at the start of the active list, then restart the timerFD using the next
-        // timer on the active list, if any.  Otherwise, stop the timerFD.
-        if (timerRef == threadRecPtr->firstTimerPtr)
+        // If the timerFD was set for this timer's deadline, then work out the wakeup time again
+        // from the remaining timers, if any.  Otherwise, the wakeup time is still right.
+        if ( threadRecPtr->isTimerFdRunning &&
+             ! le_clk_GreaterThan(GetDeadline(timerRef), threadRecPtr->wakeupTime) )
         {
-            TRACE("Stopping the first active timer");
-            threadRecPtr->firstTimerPtr = NULL;
-
-            firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
-            if (firstTimerPtr != NULL)
-            {
-                RestartTimerFD(firstTimerPtr);
-            }
-            else
-            {
-                StopTimerFD();
-
-            }
+            TRACE("Stopping the timer that the timerFD was set for");
+            UpdateTimerFD(threadRecPtr);
         }
     }
 
@@ -1082,3 +1391,21 @@ bool le_timer_IsRunning
     return timerRef->isActive;
 }
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetch the timer wakeup statistics for the calling thread.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_timer_GetWakeupStats
+(
+    le_timer_WakeupStats_t* statsPtr    ///< [OUT] Pointer to where the stats will be stored.
+)
+{
+    LE_ASSERT(statsPtr != NULL);
+
+    timer_ThreadRec_t* threadRecPtr = thread_GetTimerRecPtr();
+
+    statsPtr->numWakeups = threadRecPtr->numWakeups;
+    statsPtr->numWakeupsSaved = threadRecPtr->numWakeupsSaved;
+}
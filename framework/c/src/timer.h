@@ -25,9 +25,14 @@ typedef struct le_timer
     le_clk_Time_t interval;                  ///< Interval
     uint32_t repeatCount;                    ///< Number of times the timer will repeat
     void* contextPtr;                        ///< Context for timer expiry
+    le_clk_Time_t tolerance;                 ///< How late the timer may expire, so that its
+                                             ///  expiry can share a wakeup with other timers
 
     // Internal State
     le_dls_Link_t link;                      ///< For adding to the timer list
+    size_t heapIndex;                        ///< Position in the thread's active timer heap
+    uint64_t startCount;                     ///< Thread's start counter value when the timer was
+                                             ///  last added, to keep equal expiry times in order.
     bool isActive;                           ///< Is the timer active/running?
     le_clk_Time_t expiryTime;                ///< Time at which the timer should expire
     uint32_t expiryCount;                    ///< Number of times the counter has expired
@@ -50,11 +55,20 @@ typedef struct
 {
     int timerFD;                        ///< System timer used by the thread.
     le_dls_List_t activeTimerList;      ///< Linked list of running legato timers for this thread
-    le_timer_Ref_t firstTimerPtr;       ///< Pointer to the timer on the active list that is
-                                        ///  associated with the currently running timerFD,
-                                        ///  or NULL if there are no timers on the active list.
-                                        ///  This is normally the first timer on the list.
-
+                                        ///  (unordered; used to list the timers for inspection).
+    le_timer_Ref_t* heapPtr;            ///< Binary min-heap of the running timers, ordered by
+                                        ///  expiry time.  The first timer expires first.
+    size_t heapSize;                    ///< Number of timers in the heap.
+    size_t heapCapacity;                ///< Number of timers the heap array can hold.
+    uint64_t startCount;                ///< Number of timers added to the heap by this thread.
+    bool isTimerFdRunning;              ///< Is the timerFD armed?
+    le_clk_Time_t wakeupTime;           ///< Time the timerFD is armed to expire at.  This is the
+                                        ///  earliest expiry time plus tolerance of the timers on
+                                        ///  the heap, so that every timer that expires before
+                                        ///  then is handled by the same wakeup.
+    uint64_t numWakeups;                ///< Number of timerFD wakeups handled by this thread.
+    uint64_t numWakeupsSaved;           ///< Number of timer expiries that would have needed a
+                                        ///  timerFD wakeup of their own without tolerances.
 }
 timer_ThreadRec_t;
 
@@ -715,6 +715,260 @@ le_result_t unixSocket_ReceiveDataMsg
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a batch of messages, each containing a data payload and an optional file descriptor,
+ * through a connected Unix domain datagram or sequenced-packet socket using a single system call.
+ *
+ * Fewer messages than requested may be sent (e.g., if the socket's send buffer fills up part way
+ * through the batch).  The caller should call again to send the rest.
+ *
+ * @return
+ * - LE_OK if at least one message was sent (check *numSentPtr).
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ * - LE_NO_MEMORY if the send socket is set to non-blocking and it doesn't have enough buffer
+ *                  space to send right now. Wait for the "writeable" event on the file descriptor.
+ *
+ * @warning DO NOT SEND DIRECTORY FILE DESCRIPTORS.  That can be exploited to break out of chroot()
+ *          jails.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_SendMsgBatch
+(
+    int localSocketFd,              ///< [IN] fd of the local socket that will be used to send.
+    unixSocket_BatchMsg_t* msgList, ///< [IN] Array of messages to be sent.
+    size_t numMsgs,                 ///< [IN] Number of messages in the array
+                                    ///       (1 to UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t* numSentPtr              ///< [OUT] Number of messages from the start of the array that
+                                    ///        were sent.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Ancillary data (control message) buffers, aligned the way the CMSG macros expect.
+    union
+    {
+        char            buff[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr  align;
+    }
+    cmsgBuffers[UNIXSOCKET_MAX_BATCH_MSGS];
+
+    struct mmsghdr msgHeaders[UNIXSOCKET_MAX_BATCH_MSGS];   // Message headers for sendmmsg().
+    struct iovec ioVectors[UNIXSOCKET_MAX_BATCH_MSGS];      // I/O vectors for the data payloads.
+
+    size_t i;
+
+    LE_ASSERT((numMsgs > 0) && (numMsgs <= UNIXSOCKET_MAX_BATCH_MSGS));
+
+    *numSentPtr = 0;
+
+    memset(msgHeaders, 0, numMsgs * sizeof(msgHeaders[0]));
+
+    for (i = 0; i < numMsgs; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        // If we are sending a data payload,
+        if ((msgList[i].dataPtr != NULL) && (msgList[i].dataSize > 0))
+        {
+            ioVectors[i].iov_base = msgList[i].dataPtr;
+            ioVectors[i].iov_len = msgList[i].dataSize;
+            msgHeaderPtr->msg_iov = &ioVectors[i];
+            msgHeaderPtr->msg_iovlen = 1;
+        }
+
+        // If we are sending a file descriptor, put it in an SCM_RIGHTS control message.
+        if (msgList[i].fd >= 0)
+        {
+            msgHeaderPtr->msg_control = cmsgBuffers[i].buff;
+            msgHeaderPtr->msg_controllen = sizeof(cmsgBuffers[i].buff);
+
+            struct cmsghdr* cmsgHeaderPtr = CMSG_FIRSTHDR(msgHeaderPtr);
+            cmsgHeaderPtr->cmsg_level = SOL_SOCKET;
+            cmsgHeaderPtr->cmsg_type = SCM_RIGHTS;
+            cmsgHeaderPtr->cmsg_len = CMSG_LEN(sizeof(int));
+            *((int*)CMSG_DATA(cmsgHeaderPtr)) = msgList[i].fd;
+
+            msgHeaderPtr->msg_controllen = cmsgHeaderPtr->cmsg_len;
+
+            LE_DEBUG("Sending fd %d.", msgList[i].fd);
+        }
+    }
+
+    // Now send the messages (retry if interrupted by a signal).
+    int numSent;
+    do
+    {
+        numSent = sendmmsg(localSocketFd, msgHeaders, numMsgs, 0);
+    }
+    while ((numSent < 0) && (errno == EINTR));
+
+    if (numSent < 0)
+    {
+        switch (errno)
+        {
+            case EAGAIN:  // Same as EWOULDBLOCK
+                return LE_NO_MEMORY;
+
+            case ENOTCONN:
+            case ECONNRESET:
+            case EPIPE:
+                LE_WARN("sendmmsg() failed with errno %d (%m).", errno);
+                return LE_COMM_ERROR;
+
+            default:
+                LE_ERROR("sendmmsg() failed with errno %d (%m).", errno);
+                return LE_FAULT;
+        }
+    }
+
+    for (i = 0; i < (size_t)numSent; i++)
+    {
+        if (msgHeaders[i].msg_len < msgList[i].dataSize)
+        {
+            LE_ERROR("The last %zu data bytes (of %zu total) were discarded by sendmmsg()!",
+                     msgList[i].dataSize - msgHeaders[i].msg_len,
+                     msgList[i].dataSize);
+            return LE_FAULT;
+        }
+    }
+
+    *numSentPtr = numSent;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receives a batch of messages through a connected Unix domain datagram or sequenced-packet
+ * socket using a single system call.
+ *
+ * Waits for the first message like unixSocket_ReceiveMsg() would, then receives as many more as
+ * are already waiting, up to the number of messages in the array.
+ *
+ * Any credentials received are discarded.
+ *
+ * @return
+ * - LE_OK if at least one message was received (check *numReceivedPtr and each message's result).
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_ReceiveMsgBatch
+(
+    int localSocketFd,              ///< [IN] fd of local socket that will be used to receive.
+    unixSocket_BatchMsg_t* msgList, ///< [IN+OUT] Array of buffers to receive messages into.
+    size_t numMsgs,                 ///< [IN] Number of buffers in the array
+                                    ///       (1 to UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t* numReceivedPtr          ///< [OUT] Number of messages received into the array.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Ancillary data (control message) buffers, aligned the way the CMSG macros expect.
+    union
+    {
+        char            buff[CMSG_BUFF_SIZE];
+        struct cmsghdr  align;
+    }
+    cmsgBuffers[UNIXSOCKET_MAX_BATCH_MSGS];
+
+    struct mmsghdr msgHeaders[UNIXSOCKET_MAX_BATCH_MSGS];   // Message headers for recvmmsg().
+    struct iovec ioVectors[UNIXSOCKET_MAX_BATCH_MSGS];      // I/O vectors for the data payloads.
+
+    size_t i;
+
+    LE_ASSERT((numMsgs > 0) && (numMsgs <= UNIXSOCKET_MAX_BATCH_MSGS));
+
+    *numReceivedPtr = 0;
+
+    memset(msgHeaders, 0, numMsgs * sizeof(msgHeaders[0]));
+
+    for (i = 0; i < numMsgs; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        msgHeaderPtr->msg_control = cmsgBuffers[i].buff;
+        msgHeaderPtr->msg_controllen = sizeof(cmsgBuffers[i].buff);
+
+        if ((msgList[i].dataPtr != NULL) && (msgList[i].dataSize > 0))
+        {
+            ioVectors[i].iov_base = msgList[i].dataPtr;
+            ioVectors[i].iov_len = msgList[i].dataSize;
+            msgHeaderPtr->msg_iov = &ioVectors[i];
+            msgHeaderPtr->msg_iovlen = 1;
+        }
+    }
+
+    // Keep trying to receive until we don't get interrupted by a signal.
+    // MSG_WAITFORONE makes recvmmsg() stop waiting once it has received the first message, so
+    // this only picks up the extra messages that have already arrived.
+    int numReceived;
+    do
+    {
+        numReceived = recvmmsg(localSocketFd, msgHeaders, numMsgs, MSG_WAITFORONE, NULL);
+    }
+    while ((numReceived < 0) && (errno == EINTR));
+
+    // If we failed, process the error and return.
+    if (numReceived < 0)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return LE_WOULD_BLOCK;
+        }
+        else if (errno == ECONNRESET)
+        {
+            return LE_CLOSED;
+        }
+        else
+        {
+            LE_ERROR("recvmmsg() failed with errno %d (%m).", errno);
+            return LE_FAULT;
+        }
+    }
+
+    for (i = 0; i < (size_t)numReceived; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        msgList[i].fd = -1;
+        msgList[i].result = LE_OK;
+
+        // If we received any ancillary data messages (control messages), extract what we want
+        // from them.
+        if (msgHeaderPtr->msg_controllen > 0)
+        {
+            ExtractAncillaryData(msgHeaderPtr, &msgList[i].fd, NULL);
+        }
+        // If we didn't receive any ancillary data, and the message is empty,
+        // then the socket must have closed.
+        else if (msgHeaders[i].msg_len == 0)
+        {
+            msgList[i].result = LE_CLOSED;
+        }
+
+        // Check if ancillary data was discarded.
+        if ((msgHeaderPtr->msg_flags & MSG_CTRUNC) != 0)
+        {
+            LE_WARN("Ancillary data was discarded because it couldn't fit in our buffer.");
+        }
+
+        // Set the received data count and check that the message fit into the buffer provided.
+        msgList[i].dataSize = msgHeaders[i].msg_len;
+        if ((msgHeaderPtr->msg_flags & MSG_TRUNC) != 0)
+        {
+            msgList[i].result = LE_NO_MEMORY;
+        }
+    }
+
+    *numReceivedPtr = numReceived;
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the socket error state code (SO_ERROR).
@@ -518,6 +518,94 @@ le_result_t unixSocket_ReceiveDataMsg
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of messages that can be passed to unixSocket_SendMsgBatch() or
+ * unixSocket_ReceiveMsgBatch() in one call.
+ */
+//--------------------------------------------------------------------------------------------------
+#define UNIXSOCKET_MAX_BATCH_MSGS 16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * One message in a batch of messages sent using unixSocket_SendMsgBatch() or received using
+ * unixSocket_ReceiveMsgBatch().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void*       dataPtr;    ///< [IN] Ptr to the data payload to be sent, or to the buffer that the
+                            ///       received data payload will be put in.
+    size_t      dataSize;   ///< [IN+OUT] Number of bytes of data payload to be sent, or the size of
+                            ///     the receive buffer.  When receiving, this will be updated to
+                            ///     the number of bytes of data received.
+    int         fd;         ///< [IN+OUT] File descriptor to be sent (-1 if no FD to send), or the
+                            ///     file descriptor received (-1 if no fd was received).
+    le_result_t result;     ///< [OUT] Receive only.  LE_OK if successful, LE_NO_MEMORY if more data
+                            ///     was received than could fit in the buffer, or LE_CLOSED if
+                            ///     the connection closed.
+}
+unixSocket_BatchMsg_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a batch of messages, each containing a data payload and an optional file descriptor,
+ * through a connected Unix domain datagram or sequenced-packet socket using a single system call.
+ *
+ * Fewer messages than requested may be sent (e.g., if the socket's send buffer fills up part way
+ * through the batch).  The caller should call again to send the rest.
+ *
+ * @return
+ * - LE_OK if at least one message was sent (check *numSentPtr).
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ * - LE_NO_MEMORY if the send socket is set to non-blocking and it doesn't have enough buffer
+ *                  space to send right now. Wait for the "writeable" event on the file descriptor.
+ *
+ * @warning DO NOT SEND DIRECTORY FILE DESCRIPTORS.  That can be exploited to break out of chroot()
+ *          jails.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_SendMsgBatch
+(
+    int localSocketFd,              ///< [IN] fd of the local socket that will be used to send.
+    unixSocket_BatchMsg_t* msgList, ///< [IN] Array of messages to be sent.
+    size_t numMsgs,                 ///< [IN] Number of messages in the array
+                                    ///       (1 to UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t* numSentPtr              ///< [OUT] Number of messages from the start of the array that
+                                    ///        were sent.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receives a batch of messages through a connected Unix domain datagram or sequenced-packet
+ * socket using a single system call.
+ *
+ * Waits for the first message like unixSocket_ReceiveMsg() would, then receives as many more as
+ * are already waiting, up to the number of messages in the array.
+ *
+ * Any credentials received are discarded.
+ *
+ * @return
+ * - LE_OK if at least one message was received (check *numReceivedPtr and each message's result).
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_ReceiveMsgBatch
+(
+    int localSocketFd,              ///< [IN] fd of local socket that will be used to receive.
+    unixSocket_BatchMsg_t* msgList, ///< [IN+OUT] Array of buffers to receive messages into.
+    size_t numMsgs,                 ///< [IN] Number of buffers in the array
+                                    ///       (1 to UNIXSOCKET_MAX_BATCH_MSGS).
+    size_t* numReceivedPtr          ///< [OUT] Number of messages received into the array.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the socket error state code (SO_ERROR).
@@ -1159,11 +1159,17 @@ le_result_t system_Snapshot
         return LE_OK;
     }
 
-    // Copy the current system to the work dir.
+    // Recreate the current system in the work dir.  Nothing in the current system is changed in
+    // place except for the config and apps' writeable files (everything else is replaced by
+    // writing a new file and renaming it over the old one), so the snapshot can share the rest of
+    // the current system's files through hard links.
+    static const char* const copiedDirs[] = { "config", "appsWriteable", NULL };
+
     int currentIndex = system_Index();
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
 
     system_PrepUnpackDir();
-    if (file_CopyRecursive(CurrentSystemPath, system_UnpackPath, NULL) != LE_OK)
+    if (file_LinkRecursive(CurrentSystemPath, system_UnpackPath, copiedDirs) != LE_OK)
     {
         return LE_FAULT;
     }
@@ -1179,8 +1185,11 @@ le_result_t system_Snapshot
     // Increment the index of the current system.
     SetIndex("current", currentIndex + 1);
 
-    LE_INFO("Snapshot taken of system index %d.  Current system index is now %d.",
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    LE_INFO("Snapshot taken of system index %d in %ld ms.  Current system index is now %d.",
             currentIndex,
+            (long)((elapsed.sec * 1000) + (elapsed.usec / 1000)),
             currentIndex + 1);
 
     return LE_OK;
@@ -67,6 +67,34 @@ static size_t PayloadBytesCopied;
 /// Percentage complete on current task.
 static unsigned int PercentDone;
 
+/// Size of the buffer used to copy or discard payload bytes when they can't be spliced.
+#define COPY_BUFFER_BYTES (64 * 1024)
+
+/// Buffer used to copy or discard payload bytes when they can't be spliced.
+static char CopyBuffer[COPY_BUFFER_BYTES];
+
+/// Size requested for the pipe into the unpack pipeline, so more data moves per wake-up.
+#define PIPELINE_PIPE_BYTES (256 * 1024)
+
+/// true if payload bytes are being moved into the pipeline using splice() (no copy to user space).
+static bool IsSplicing;
+
+/// Bytes the JSON parser read from the input stream past the end of a JSON header.  These come
+/// before anything still in the input stream, and are used up before reading it again.
+static char PendingData[LE_JSON_STREAM_BUFFER_BYTES];
+
+/// # of bytes in PendingData.
+static size_t PendingSize;
+
+/// # of bytes in PendingData that have been used up.
+static size_t PendingPos;
+
+/// When the update started.
+static le_clk_Time_t UpdateStartTime;
+
+/// When the current phase of the update (unpacking or applying a section) started.
+static le_clk_Time_t PhaseStartTime;
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -120,6 +148,23 @@ State = STATE_IDLE;
 static le_json_ParsingSessionRef_t ParsingSession = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the number of milliseconds since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static unsigned int MsSince
+(
+    le_clk_Time_t startTime
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_clk_Time_t diff = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return (unsigned int)((diff.sec * 1000) + (diff.usec / 1000));
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Delete the FD Monitor object.
@@ -153,6 +198,9 @@ static void Reset
     // Reset the state machine.
     State = STATE_IDLE;
 
+    PendingSize = 0;
+    PendingPos = 0;
+
     // Stop JSON parsing.
     if (ParsingSession != NULL)
     {
@@ -296,12 +344,18 @@ static void JsonErrorHandler
                 PercentDone = 0;
                 ReportProgress();
 
+                PhaseStartTime = le_clk_GetRelativeTime();
+
                 if (system_FinishUpdate() != LE_OK)
                 {
                     HandleInternalError();
                 }
                 else
                 {
+                    LE_INFO("System update finished in %u ms.  Update took %u ms in total.",
+                            MsSince(PhaseStartTime),
+                            MsSince(UpdateStartTime));
+
                     // Report successful completion back to the client and terminate the update.
                     ProgressFunc(UPDATE_UNPACK_STATUS_SYSTEM_UPDATED, 100);
                     Reset();
@@ -312,6 +366,8 @@ static void JsonErrorHandler
             // to find any JSON data, it's time to report completion of the update.
             else if (Type == TYPE_APP_CHANGE)
             {
+                LE_INFO("Update took %u ms in total.", MsSince(UpdateStartTime));
+
                 // Report successful completion back to the client and terminate the update.
                 ProgressFunc(UPDATE_UNPACK_STATUS_APP_UPDATED, 100);
                 Reset();
@@ -343,8 +399,80 @@ static void StartParsing
     // Set the state
     State = STATE_PARSING_JSON;
 
-    // Start the parser (and wait for callbacks).
-    ParsingSession = le_json_Parse(InputFd, JsonEventHandler, JsonErrorHandler, NULL);
+    // Start the parser (and wait for callbacks), giving it anything it read past the end of
+    // the previous section's payload last time.
+    ParsingSession = le_json_ParseStream(InputFd,
+                                         PendingData + PendingPos,
+                                         PendingSize - PendingPos,
+                                         JsonEventHandler,
+                                         JsonErrorHandler,
+                                         NULL);
+    PendingSize = 0;
+    PendingPos = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take bytes that the JSON parser read past the end of a JSON header, to use as payload.
+ *
+ * @return The number of bytes taken (0 if there are none left).
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t TakePendingBytes
+(
+    size_t maxBytes,            ///< [IN] Most bytes to take.
+    const char** dataPtrPtr     ///< [OUT] Set to point to the bytes taken.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t byteCount = PendingSize - PendingPos;
+    if (byteCount > maxBytes)
+    {
+        byteCount = maxBytes;
+    }
+
+    *dataPtrPtr = PendingData + PendingPos;
+    PendingPos += byteCount;
+
+    return byteCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write all of a buffer to a file descriptor, retrying if interrupted by a signal.
+ *
+ * @return LE_OK if successful, LE_FAULT if not (with errno set).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteAll
+(
+    int fd,
+    const char* dataPtr,
+    size_t byteCount
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t bytesWritten = 0;
+
+    while (bytesWritten < byteCount)
+    {
+        ssize_t writeResult = write(fd, dataPtr + bytesWritten, byteCount - bytesWritten);
+
+        // If some bytes were written, remember how many bytes, so we don't try to write the
+        // same bytes again if we have more to write.
+        if (writeResult > 0)
+        {
+            bytesWritten += writeResult;
+        }
+        else if ((writeResult == -1) && (errno != EINTR))
+        {
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
 }
 
 
@@ -363,6 +491,8 @@ static void UntarDone
     pipeline_Delete(Pipeline);
     Pipeline = NULL;
 
+    LE_INFO("Payload of %zu bytes unpacked in %u ms.", PayloadSize, MsSince(PhaseStartTime));
+
     if (!WIFEXITED(status) || (WEXITSTATUS(status) != EXIT_SUCCESS))
     {
         if (WIFEXITED(status))
@@ -382,6 +512,8 @@ static void UntarDone
         return;
     }
 
+    PhaseStartTime = le_clk_GetRelativeTime();
+
     // If this update pack contains changes to individual apps,
     if (Type == TYPE_APP_CHANGE)
     {
@@ -391,6 +523,8 @@ static void UntarDone
             return;
         }
 
+        LE_INFO("App '%s' installed in %u ms.", AppName, MsSince(PhaseStartTime));
+
         PercentDone = 100;
         ReportProgress();
     }
@@ -406,6 +540,8 @@ static void UntarDone
         if (strcmp(Command, "updateSystem") == 0)
         {
             system_RemoveUnusedApps();
+
+            LE_INFO("Unused apps removed in %u ms.", MsSince(PhaseStartTime));
         }
         // After the unpack of one of the apps, we rename the app to the appropriate location
         // and copy over any writeable files that may have been inherited from an earlier version
@@ -427,6 +563,8 @@ static void UntarDone
                 HandleInternalError();
                 return;
             }
+
+            LE_INFO("App '%s' set up in %u ms.", AppName, MsSince(PhaseStartTime));
         }
     }
 
@@ -450,6 +588,8 @@ static void SkipForwardDone
     PercentDone = 100;
     ReportProgress();
 
+    PhaseStartTime = le_clk_GetRelativeTime();
+
     // Even if we skip the payload we still need to process the install.
     if (Type == TYPE_APP_CHANGE)
     {
@@ -471,6 +611,8 @@ static void SkipForwardDone
         }
     }
 
+    LE_INFO("App '%s' set up in %u ms.", AppName, MsSince(PhaseStartTime));
+
     // There could be more after this payload, so look for another JSON header.
     StartParsing();
 }
@@ -478,38 +620,102 @@ static void SkipForwardDone
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Copy bytes from the input fd to the pipeline's input fd until the input fd's read buffer is
- * empty or we have copied all the payload bytes.
+ * Move some payload bytes from the input fd to the pipeline's input fd.  Uses splice() to move
+ * them inside the kernel if possible, and falls back to reading them into a buffer and writing
+ * them out again if the input fd doesn't support that.
+ *
+ * @return The number of bytes read from the input fd, 0 at end of file, or -1 on error (with errno
+ *         set).
  */
 //--------------------------------------------------------------------------------------------------
-static void CopyBytesToPipeline
+static ssize_t MoveBytesToPipeline
 (
-    void
+    size_t maxBytes ///< Most bytes to move.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    char buffer[1024];
+    ssize_t result;
 
-    // Keep copying as much as we can until we've copied all the payload.
-    while (PayloadBytesCopied < PayloadSize)
+    // Bytes the JSON parser read past the end of the header come first.
+    const char* pendingPtr;
+    size_t pendingCount = TakePendingBytes(maxBytes, &pendingPtr);
+    if (pendingCount > 0)
     {
-        // Compute the number of bytes to read.
-        size_t bytesToRead = PayloadSize - PayloadBytesCopied;
-        if (bytesToRead > sizeof(buffer))
+        if (WriteAll(PipelineFd, pendingPtr, pendingCount) != LE_OK)
         {
-            bytesToRead = sizeof(buffer);
+            LE_ERROR("Failed to write to output stream (%m)");
+            errno = EIO;
+            return -1;
         }
 
-        // Read the bytes, retrying if interrupted by a signal.
-        ssize_t readResult;
+        return pendingCount;
+    }
+
+    if (IsSplicing)
+    {
         do
         {
-            readResult = read(InputFd, buffer, bytesToRead);
+            result = splice(InputFd, NULL, PipelineFd, NULL, maxBytes, SPLICE_F_MOVE);
         }
-        while ((readResult == -1) && (errno == EINTR));
+        while ((result == -1) && (errno == EINTR));
+
+        if ((result != -1) || ((errno != EINVAL) && (errno != ENOSYS)))
+        {
+            return result;
+        }
+
+        LE_DEBUG("Input stream can't be spliced.  Copying through a buffer.");
+        IsSplicing = false;
+    }
+
+    if (maxBytes > sizeof(CopyBuffer))
+    {
+        maxBytes = sizeof(CopyBuffer);
+    }
+
+    // Read the bytes, retrying if interrupted by a signal.
+    do
+    {
+        result = read(InputFd, CopyBuffer, maxBytes);
+    }
+    while ((result == -1) && (errno == EINTR));
+
+    if (result <= 0)
+    {
+        return result;
+    }
+
+    // Write the bytes that we read.
+    if (WriteAll(PipelineFd, CopyBuffer, result) != LE_OK)
+    {
+        LE_ERROR("Failed to write to output stream (%m)");
+        errno = EIO;
+        return -1;
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy bytes from the input fd to the pipeline's input fd until the input fd's read buffer is
+ * empty or we have copied all the payload bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CopyBytesToPipeline
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Keep copying as much as we can until we've copied all the payload.
+    while (PayloadBytesCopied < PayloadSize)
+    {
+        ssize_t result = MoveBytesToPipeline(PayloadSize - PayloadBytesCopied);
 
         // Handle errors
-        if (readResult == -1)
+        if (result == -1)
         {
             // EWOULDBLOCK indicates that there are currently no more bytes available to be
             // read from the fd, but more will probably become available later.
@@ -520,12 +726,12 @@ static void CopyBytesToPipeline
                 break;
             }
 
-            LE_ERROR("Failed to read from input stream (%m).");
+            LE_ERROR("Failed to copy from input stream (%m).");
             goto error;
         }
 
         // Handle end of file.
-        if (readResult == 0)
+        if (result == 0)
         {
             LE_ERROR("Unexpected early end of input after %zu bytes of %zu.",
                      PayloadBytesCopied,
@@ -533,43 +739,23 @@ static void CopyBytesToPipeline
             goto error;
         }
 
-        // Write the bytes that we read.
-        ssize_t bytesWritten = 0;
-        ssize_t writeResult;
-        do
-        {
-            writeResult = write(PipelineFd, buffer + bytesWritten, readResult - bytesWritten);
-
-            // If some bytes were written, remember how many bytes, so we don't try to write the
-            // same bytes again if we have more to write.
-            if (writeResult > 0)
-            {
-                bytesWritten += writeResult;
-            }
-        }
-        while (   ((writeResult == -1) && (errno == EINTR)) // Retry if interrupted by a signal
-               || ((writeResult != -1) && (bytesWritten < readResult))  ); // Continue if not done
-
-        // Check for errors.
-        if (writeResult == -1)
-        {
-            LE_ERROR("Failed to write to output stream (%m)");
-            goto error;
-        }
-
-        // Update the static progress variables and report progress to the client.
-        PayloadBytesCopied += readResult;
-        PercentDone = (100 * PayloadBytesCopied) / PayloadSize;
-        ReportProgress();
+        PayloadBytesCopied += result;
     }
 
+    // Update the static progress variables and report progress to the client, once for
+    // everything that was copied this time around.
+    PercentDone = (100 * PayloadBytesCopied) / PayloadSize;
+    ReportProgress();
+
     // If we have copied all the payload bytes to the pipeline's input, then we can stop
     // monitoring the input fd now, close the pipeline input write pipe, and wait for the pipeline
     // completion callback (UntarDone()).
-    LE_INFO("Payload copied: %zu/%zu", PayloadBytesCopied, PayloadSize);
     LE_ASSERT(PayloadBytesCopied <= PayloadSize);
     if (PayloadBytesCopied == PayloadSize)
     {
+        LE_INFO("Payload copied: %zu/%zu in %u ms", PayloadBytesCopied, PayloadSize,
+                MsSince(PhaseStartTime));
+
         DeleteFdMonitor();
         fd_Close(PipelineFd);
         PipelineFd = -1;
@@ -594,23 +780,21 @@ static void DiscardPayloadBytes
 )
 //--------------------------------------------------------------------------------------------------
 {
-    char buffer[1024];
-
     // Keep reading as much as we can until we've read all the payload.
     while (PayloadBytesCopied < PayloadSize)
     {
         // Compute the number of bytes to read.
         size_t bytesToRead = PayloadSize - PayloadBytesCopied;
-        if (bytesToRead > sizeof(buffer))
+        if (bytesToRead > sizeof(CopyBuffer))
         {
-            bytesToRead = sizeof(buffer);
+            bytesToRead = sizeof(CopyBuffer);
         }
 
         // Read the bytes, retrying if interrupted by a signal.
         ssize_t readResult;
         do
         {
-            readResult = read(InputFd, buffer, bytesToRead);
+            readResult = read(InputFd, CopyBuffer, bytesToRead);
         }
         while ((readResult == -1) && (errno == EINTR));
 
@@ -628,20 +812,34 @@ static void DiscardPayloadBytes
 
             LE_ERROR("Failed to read from input stream (%m).");
             HandleInternalError();
+            return;
+        }
+
+        // Handle end of file.
+        if (readResult == 0)
+        {
+            LE_ERROR("Unexpected early end of input after %zu bytes of %zu.",
+                     PayloadBytesCopied,
+                     PayloadSize);
+            HandleInternalError();
+            return;
         }
 
-        // Update the static progress variables and report progress to the client.
         PayloadBytesCopied += readResult;
-        PercentDone = (100 * PayloadBytesCopied) / PayloadSize;
-        ReportProgress();
     }
 
+    // Update the static progress variables and report progress to the client.
+    PercentDone = (100 * PayloadBytesCopied) / PayloadSize;
+    ReportProgress();
+
     // If we have read all the payload bytes, then we can stop monitoring the input fd for now
     // and wrap up this app.
-    LE_INFO("Payload discarded: %zu/%zu", PayloadBytesCopied, PayloadSize);
     LE_ASSERT(PayloadBytesCopied <= PayloadSize);
     if (PayloadBytesCopied == PayloadSize)
     {
+        LE_INFO("Payload discarded: %zu/%zu in %u ms", PayloadBytesCopied, PayloadSize,
+                MsSince(PhaseStartTime));
+
         DeleteFdMonitor();
         SkipForwardDone();
     }
@@ -722,6 +920,7 @@ static void StartUntar
     State = STATE_UNPACKING_PAYLOAD;
 
     PayloadBytesCopied = 0;
+    PhaseStartTime = le_clk_GetRelativeTime();
 
     // Create a pipeline: PipelineFd -> tar
     Pipeline = pipeline_Create();
@@ -729,10 +928,22 @@ static void StartUntar
     pipeline_Append(Pipeline, Untar, (void*)dirPath);
     pipeline_Start(Pipeline, UntarDone);
 
+    // A bigger pipe lets more of the payload through per wake-up.  This is just an optimization,
+    // so it doesn't matter if it fails.
+    if (fcntl(PipelineFd, F_SETPIPE_SZ, PIPELINE_PIPE_BYTES) == -1)
+    {
+        LE_DEBUG("Couldn't enlarge unpack pipe (%m).");
+    }
+    IsSplicing = true;
+
     fd_SetNonBlocking(InputFd);
 
     // Create FD Monitor for the Input FD.
     InputFdMonitor = le_fdMonitor_Create("unpack", InputFd, InputFdEventHandler, POLLIN);
+
+    // Copy whatever is available now, starting with anything the JSON parser read past the end
+    // of the header, because the input may never become readable again if it's all been read.
+    CopyBytesToPipeline();
 }
 
 
@@ -749,12 +960,161 @@ static void StartSkipForward
 {
     State = STATE_SKIPPING_PAYLOAD;
 
-    PayloadBytesCopied = 0;
+    PhaseStartTime = le_clk_GetRelativeTime();
+
+    // Skip the bytes the JSON parser already read past the end of the header first.
+    const char* pendingPtr;
+    PayloadBytesCopied = TakePendingBytes(PayloadSize, &pendingPtr);
+
+    // If the input is a file, just seek past the rest of the payload.
+    size_t bytesLeft = PayloadSize - PayloadBytesCopied;
+    off_t offset = lseek(InputFd, 0, SEEK_CUR);
+    struct stat inputStat;
+
+    if (   (bytesLeft > 0)
+        && (offset != (off_t)-1)
+        && (fstat(InputFd, &inputStat) == 0)
+        && S_ISREG(inputStat.st_mode)
+        && (inputStat.st_size - offset >= (off_t)bytesLeft)
+        && (lseek(InputFd, bytesLeft, SEEK_CUR) != (off_t)-1) )
+    {
+        PayloadBytesCopied = PayloadSize;
+    }
 
     fd_SetNonBlocking(InputFd);
 
     // Create FD Monitor for the Input FD.
     InputFdMonitor = le_fdMonitor_Create("skip", InputFd, InputFdEventHandler, POLLIN);
+
+    // Discard whatever is available now.  If the whole payload has already been skipped, this
+    // finishes the skip, because the input may never become readable again.
+    DiscardPayloadBytes();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function that runs in the firmware feed pipeline's process.  Writes the bytes the JSON parser
+ * read past the end of the header, followed by the rest of the input stream, to stdout.
+ **/
+//--------------------------------------------------------------------------------------------------
+static int FeedFirmware
+(
+    void* param
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Close all open file descriptors except for stdin, stdout, and stderr.
+    fd_CloseAllNonStd();
+
+    // stdin shares the input stream's file status flags, which may have been made non-blocking.
+    fd_SetBlocking(STDIN_FILENO);
+
+    const char* pendingPtr;
+    size_t pendingCount = TakePendingBytes(PendingSize, &pendingPtr);
+
+    if (WriteAll(STDOUT_FILENO, pendingPtr, pendingCount) != LE_OK)
+    {
+        return EXIT_FAILURE;
+    }
+
+    for (;;)
+    {
+        ssize_t readResult;
+        do
+        {
+            readResult = read(STDIN_FILENO, CopyBuffer, sizeof(CopyBuffer));
+        }
+        while ((readResult == -1) && (errno == EINTR));
+
+        if (readResult <= 0)
+        {
+            return (readResult == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+
+        if (WriteAll(STDOUT_FILENO, CopyBuffer, readResult) != LE_OK)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion callback for the firmware feed pipeline.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FeedFirmwareDone
+(
+    pipeline_Ref_t pipeline,
+    int status
+)
+//--------------------------------------------------------------------------------------------------
+{
+    pipeline_Delete(Pipeline);
+    Pipeline = NULL;
+
+    if (!WIFEXITED(status) || (WEXITSTATUS(status) != EXIT_SUCCESS))
+    {
+        if (WIFEXITED(status))
+        {
+            LE_ERROR("Firmware feed pipeline failed with exit code: %d", WEXITSTATUS(status));
+        }
+        else if (WIFSIGNALED(status))
+        {
+            LE_ERROR("Firmware feed pipeline killed by signal: %d", WTERMSIG(status));
+        }
+        else
+        {
+            LE_ERROR("Firmware feed pipeline died for unknown reason (status: %d)", status);
+        }
+
+        HandleInternalError();
+        return;
+    }
+
+    LE_DEBUG("Firmware feed finished.");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a file descriptor that the firmware payload can be read from.  This is the input stream
+ * itself unless the JSON parser read part of the payload, in which case the input stream is moved
+ * back to the start of the payload if possible, or fed through a pipeline process if not.
+ *
+ * @return The file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static int GetFirmwareFd
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t pendingCount = PendingSize - PendingPos;
+
+    if (pendingCount == 0)
+    {
+        return InputFd;
+    }
+
+    if (lseek(InputFd, -(off_t)pendingCount, SEEK_CUR) != (off_t)-1)
+    {
+        PendingSize = 0;
+        PendingPos = 0;
+        return InputFd;
+    }
+
+    // Create a pipeline: InputFd -> FeedFirmware -> firmware update service
+    Pipeline = pipeline_Create();
+    pipeline_SetInput(Pipeline, InputFd);
+    pipeline_Append(Pipeline, FeedFirmware, NULL);
+    int firmwareFd = pipeline_CreateOutputPipe(Pipeline);
+    pipeline_Start(Pipeline, FeedFirmwareDone);
+
+    return firmwareFd;
 }
 
 
@@ -775,7 +1135,7 @@ static void StartFirmwareUpdate
 
     LE_INFO("Starting firmware update.");
 
-    if ( le_fwupdate_Download(InputFd) == LE_OK )
+    if ( le_fwupdate_Download(GetFirmwareFd()) == LE_OK )
     {
         LE_INFO("Firmware update download successful. Waiting for modem to reset.");
 
@@ -928,12 +1288,16 @@ static void JsonDone
             PercentDone = 0;
             ReportProgress();
 
+            PhaseStartTime = le_clk_GetRelativeTime();
+
             if (app_RemoveIndividual(AppName) != LE_OK)
             {
                 HandleInternalError();
                 return;
             }
 
+            LE_INFO("App '%s' removed in %u ms.", AppName, MsSince(PhaseStartTime));
+
             PercentDone = 100;
             ReportProgress();
 
@@ -1149,10 +1513,25 @@ static void JsonEventHandler
             break;
 
         case LE_JSON_DOC_END:
+        {
+            // Keep anything the parser read past the end of the header.  It's the start of the
+            // payload (or of the next header).
+            size_t unparsedSize;
+            const void* unparsedPtr = le_json_GetUnparsedData(ParsingSession, &unparsedSize);
+            if (unparsedSize > 0)
+            {
+                memcpy(PendingData, unparsedPtr, unparsedSize);
+            }
+            PendingSize = unparsedSize;
+            PendingPos = 0;
+
+            le_json_Cleanup(ParsingSession);
+            ParsingSession = NULL;
 
             // Confirm we have everything we need and move to the APPLYING state.
             JsonDone();
             break;
+        }
 
         case LE_JSON_OBJECT_MEMBER:
         {
@@ -1223,6 +1602,7 @@ void updateUnpack_Start
     InputFd = fd;
     ProgressFunc = progressFunc;
     PercentDone = 0;
+    UpdateStartTime = le_clk_GetRelativeTime();
 
     ProgressFunc(UPDATE_UNPACK_STATUS_UNPACKING, 0);
 
@@ -31,14 +31,21 @@
  *
  *
  * Algorithm
- * When a process kicks us, if we have no timer for it we will:
- *    create a timer,
- *    add it to our timer list and
- *    set it running with the appropriate time out (for now, that configured for the app).
- * If the timer times out before the next kick then the watchdog will
+ * When a process kicks us, if we have no watchdog for it we will:
+ *    create a watchdog and
+ *    add it to our watchdog container.
+ * The kick then just records the watchdog's new deadline (the time of the kick plus the
+ * appropriate time out, for now that configured for the app).
+ * A single sweep timer is kept running until the earliest deadline of all the watchdogs.  A kick
+ * only touches that timer if its new deadline is earlier than the one the timer is set for, which
+ * is rare since kicks normally push deadlines later.  When the sweep timer expires, all of the
+ * watchdogs are checked, and for each one whose deadline has passed the watchdog will
  *    attempt to alert the supervisor that the app has timed out.
  *          The supervisor can then apply the configured fault action.
- *    delist the timer and dispose of it.
+ *    delist the watchdog and dispose of it.
+ * The sweep timer is then set for the earliest remaining deadline.  If the watchdog with the
+ * earliest deadline was kicked in the meantime, the sweep finds nothing expired and simply moves
+ * the timer on.
  *
  * Analysis
  *
@@ -139,13 +146,17 @@ typedef struct
     pid_t procId;                       ///< The unique value by which to find this watchdog
     uid_t appId;                        ///< The id of the app it belongs to
     le_clk_Time_t kickTimeoutInterval;  ///< Default timeout for this watchdog
-    le_timer_Ref_t timer;               ///< The timer this watchdog uses
+    le_clk_Time_t deadline;             ///< Relative time at which this watchdog expires
+    bool isArmed;                       ///< false if the watchdog is set to never expire
 }
 WatchdogObj_t;
 
 static le_mem_PoolRef_t WatchdogPool;           ///< The memory pool the watchdogs will come from
 static le_hashmap_Ref_t WatchdogRefsContainer;  ///< The container we use to keep track of wdogs
 
+static le_timer_Ref_t SweepTimer;               ///< Expires at (or before) the earliest deadline
+static le_clk_Time_t SweepTime;                 ///< When SweepTimer expires, if it is running
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Remove the watchdog from our container, free the timer it contains and then free the storage
@@ -161,8 +172,8 @@ static void DeleteWatchdog
     if (deadDogPtr != NULL)
     {
         // All good. The dog was in the hash
+        // If this dog had the earliest deadline, the sweep timer will just find nothing to do.
         LE_DEBUG("Cleaning up watchdog resources for %d", deadDogPtr->procId);
-        le_timer_Delete(deadDogPtr->timer);
         le_mem_Release(deadDogPtr);
     }
     else
@@ -227,7 +238,7 @@ static WatchdogObj_t* LookupClientWatchdogPtrById
 
 //--------------------------------------------------------------------------------------------------
 /**
- * The handler for all time outs. No registered application wants to see us get here.
+ * Deal with a watchdog that has timed out. No registered application wants to see us get here.
  * Arrival here means that some process has failed to service its watchdog and therefore,
  * we need to tattle to the supervisor who, if the app still exists, will deal with it
  * in the manner proscribed in the book of config.
@@ -236,32 +247,90 @@ static WatchdogObj_t* LookupClientWatchdogPtrById
 //--------------------------------------------------------------------------------------------------
 static void WatchdogHandleExpiry
 (
-    le_timer_Ref_t timerRef ///< [IN] The reference to the expired timer
+    WatchdogObj_t* expiredDogPtr ///< [IN] The watchdog that has timed out
 )
 {
     char appName[LIMIT_MAX_APP_NAME_BYTES];
-    pid_t procId = (intptr_t)le_timer_GetContextPtr(timerRef);
-    WatchdogObj_t* expiredDog = LookupClientWatchdogPtrById(procId);
-    if (expiredDog != NULL)
+    pid_t procId = expiredDogPtr->procId;
+    uid_t appId = expiredDogPtr->appId;
+
+    if (LE_OK == user_GetAppName(appId, appName, sizeof(appName) ))
+    {
+        LE_CRIT("app %s, proc %d timed out", appName, procId);
+    }
+    else
+    {
+        LE_CRIT("app %d, proc %d timed out", appId, procId);
+    }
+
+    DeleteWatchdog(procId);
+    le_sup_wdog_WatchdogTimedOut(appId, procId);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the sweep timer to expire at the given time, or straight away if that time has passed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartSweepTimer
+(
+    le_clk_Time_t sweepTime,    ///< [IN] Relative time at which to sweep
+    le_clk_Time_t now           ///< [IN] Current relative time
+)
+{
+    le_clk_Time_t interval = { 0, 0 };
+
+    if (le_clk_GreaterThan(sweepTime, now))
+    {
+        interval = le_clk_Sub(sweepTime, now);
+    }
+
+    le_timer_Stop(SweepTimer);
+    LE_ASSERT(LE_OK == le_timer_SetInterval(SweepTimer, interval));
+    LE_ASSERT(LE_OK == le_timer_Start(SweepTimer));
+    SweepTime = sweepTime;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the sweep timer. Deals with every watchdog whose deadline has passed, then sets the
+ * sweep timer for the earliest remaining deadline.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SweepWatchdogs
+(
+    le_timer_Ref_t timerRef ///< [IN] The sweep timer
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    le_clk_Time_t nextSweepTime = { 0, 0 };
+    bool isSweepNeeded = false;
+
+    // Dynamic hashmap iterators stay valid while the current item is removed.
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(WatchdogRefsContainer);
+    while (LE_OK == le_hashmap_NextNode(iter))
     {
-        uid_t appId = expiredDog->appId;
+        WatchdogObj_t* dogPtr = (WatchdogObj_t*)le_hashmap_GetValue(iter);
 
+        if (!dogPtr->isArmed)
+        {
+            continue;
+        }
 
-        if (LE_OK == user_GetAppName(appId, appName, sizeof(appName) ))
+        if (!le_clk_GreaterThan(dogPtr->deadline, now))
         {
-            LE_CRIT("app %s, proc %d timed out", appName, procId);
+            WatchdogHandleExpiry(dogPtr);
         }
-        else
+        else if (!isSweepNeeded || le_clk_GreaterThan(nextSweepTime, dogPtr->deadline))
         {
-            LE_CRIT("app %d, proc %d timed out", appId, procId);
+            nextSweepTime = dogPtr->deadline;
+            isSweepNeeded = true;
         }
-
-        DeleteWatchdog(procId);
-        le_sup_wdog_WatchdogTimedOut(appId, procId);
     }
-    else
+
+    if (isSweepNeeded)
     {
-        LE_CRIT("Processing watchdog timeout for proc %d but watchdog already freed.", procId);
+        StartSweepTimer(nextSweepTime, now);
     }
 }
 
@@ -432,7 +501,7 @@ static le_clk_Time_t GetConfigKickTimeoutInterval
  * Allocate a new watchdog object and "construct" it.
  *
  * @return
- *      A pointer to a new Watchdog object containing an initialized timer
+ *      A pointer to a new Watchdog object that is not armed yet
  */
 //--------------------------------------------------------------------------------------------------
 static WatchdogObj_t* CreateNewWatchdog
@@ -441,18 +510,12 @@ static WatchdogObj_t* CreateNewWatchdog
     uid_t appId       ///< the user id of the client
 )
 {
-    char timerName[LIMIT_MAX_TIMER_NAME_BYTES];
-
     LE_DEBUG("Making a new dog");
     WatchdogObj_t* newDogPtr = le_mem_ForceAlloc(WatchdogPool);
     newDogPtr->procId = clientPid;
     newDogPtr->appId = appId;
     newDogPtr->kickTimeoutInterval = GetConfigKickTimeoutInterval(clientPid, appId);
-    LE_ASSERT(0 <= snprintf(timerName, sizeof(timerName), "wdog_u%d:p%d", clientPid, appId));
-    newDogPtr->timer = le_timer_Create(timerName);
-    _Static_assert (sizeof(pid_t) <= sizeof(intptr_t), "pid_t is truncated by cast to void*");
-    LE_ASSERT(LE_OK == le_timer_SetContextPtr(newDogPtr->timer, (void*)((intptr_t)clientPid)));
-    LE_ASSERT(LE_OK == le_timer_SetHandler(newDogPtr->timer, WatchdogHandleExpiry));
+    newDogPtr->isArmed = false;
     return newDogPtr;
 }
 
@@ -507,7 +570,6 @@ static void ResetClientWatchdog
     WatchdogObj_t* watchDogPtr = GetClientWatchdogPtr();
     if (watchDogPtr != NULL)
     {
-        le_timer_Stop(watchDogPtr->timer);
         if (timeout == TIMEOUT_KICK)
         {
             timeoutValue = watchDogPtr->kickTimeoutInterval;
@@ -519,13 +581,21 @@ static void ResetClientWatchdog
 
         if (timeout != LE_WDOG_TIMEOUT_NEVER)
         {
-            // timer should be stopped here so this should never fail
-            // testing
-            LE_ASSERT(LE_OK == le_timer_SetInterval(watchDogPtr->timer, timeoutValue));
-            le_timer_Start(watchDogPtr->timer);
+            le_clk_Time_t now = le_clk_GetRelativeTime();
+
+            watchDogPtr->deadline = le_clk_Add(now, timeoutValue);
+            watchDogPtr->isArmed = true;
+
+            // Only move the sweep timer if this deadline comes before the next sweep.
+            if (!le_timer_IsRunning(SweepTimer) ||
+                le_clk_GreaterThan(SweepTime, watchDogPtr->deadline))
+            {
+                StartSweepTimer(watchDogPtr->deadline, now);
+            }
         }
         else
         {
+            watchDogPtr->isArmed = false;
             LE_DEBUG("Timeout set to NEVER!");
         }
     }
@@ -603,13 +673,16 @@ static le_result_t InitializeTimerContainer
 )
 {
     WatchdogPool = le_mem_CreatePool("WatchdogPool", sizeof(WatchdogObj_t));
-    WatchdogRefsContainer = le_hashmap_Create(
+    WatchdogRefsContainer = le_hashmap_CreateDynamic(
                          "wdog_watchdogRefsContainer",
                          LE_WDOG_HASTABLE_WIDTH,
                          le_hashmap_HashUInt32,
                          le_hashmap_EqualsUInt32
                        );
     LE_ASSERT(WatchdogRefsContainer != NULL);
+
+    SweepTimer = le_timer_Create("wdog_sweep");
+    LE_ASSERT(LE_OK == le_timer_SetHandler(SweepTimer, SweepWatchdogs));
     return LE_OK;
 }
 
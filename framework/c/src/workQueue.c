@@ -0,0 +1,486 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file workQueue.c Implementation of the @ref c_workQueue.
+ *
+ * Each Work Queue has an array of pointers to Worker objects, one per worker thread.  Each Worker
+ * has its own deque (doubly-linked list) of Job objects, protected by its own (lean) mutex, so
+ * workers that are busy with their own jobs don't contend with each other.
+ *
+ * - Jobs submitted by a worker are pushed onto the tail of that worker's deque.
+ * - Jobs submitted by any other thread are pushed onto the tail of the workers' deques in turn.
+ * - A worker takes jobs from the tail of its own deque (newest first).  When that is empty, it
+ *   steals from the head of the other workers' deques (oldest first).
+ *
+ * The Work Queue's semaphore counts the jobs that are waiting to be taken, so idle workers sleep
+ * on it.  Every post follows a push, so a worker woken by the semaphore almost always finds a
+ * job; if another worker got there first, it yields and looks again.
+ *
+ * To shut a Work Queue down, le_workQueue_Delete() waits for the count of pending (submitted but
+ * not yet finished) jobs to drop to zero, then posts one extra "stop" token per worker.  A worker
+ * that finds no job after being woken exits if the Work Queue is stopping and nothing is pending.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "workQueue.h"
+#include "limit.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/// Number of Job objects each thread may keep in its Job Pool cache.
+//--------------------------------------------------------------------------------------------------
+#define JOB_POOL_THREAD_CACHE_SIZE 16
+
+
+//--------------------------------------------------------------------------------------------------
+/// Longest suffix ("-" and the worker's index) appended to a Work Queue's name to name a worker.
+/// (Two digits are enough for LE_WORKQUEUE_MAX_WORKERS.)
+//--------------------------------------------------------------------------------------------------
+#define WORKER_SUFFIX_LEN 3
+
+
+//--------------------------------------------------------------------------------------------------
+/// Size of a Work Queue's name, leaving room in the workers' thread names for the suffix.
+//--------------------------------------------------------------------------------------------------
+#define WORK_QUEUE_NAME_BYTES (LIMIT_MAX_THREAD_NAME_BYTES - WORKER_SUFFIX_LEN)
+
+
+//--------------------------------------------------------------------------------------------------
+/// Job class
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;                     ///< Used to link onto a Worker's deque.
+    le_workQueue_JobFunc_t jobFunc;         ///< Job function.
+    le_event_DeferredFunc_t completionFunc; ///< Completion function (could be NULL).
+    le_thread_Ref_t submitterRef;           ///< Thread to run the completion function in.
+    void* param1Ptr;                        ///< First parameter for the functions.
+    void* param2Ptr;                        ///< Second parameter for the functions.
+}
+Job_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/// Worker class
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_mutex_Ref_t mutexRef;                ///< Protects the deque.
+    le_dls_List_t deque;                    ///< Jobs waiting to be taken (oldest at the head).
+    struct le_workQueue* queuePtr;          ///< Work Queue this worker belongs to.
+    size_t index;                           ///< Index of this worker in the Work Queue's array.
+    le_thread_Ref_t threadRef;              ///< Worker thread.
+}
+Worker_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/// Work Queue class
+//--------------------------------------------------------------------------------------------------
+typedef struct le_workQueue
+{
+    char name[WORK_QUEUE_NAME_BYTES];       ///< Name of the Work Queue.
+    size_t numWorkers;                      ///< Number of entries in the workers array.
+    Worker_t* workerPtrs[LE_WORKQUEUE_MAX_WORKERS]; ///< Array of Workers.
+    le_sem_Ref_t jobSemRef;                 ///< Counts jobs waiting to be taken, and stop tokens.
+    le_sem_Ref_t idleSemRef;                ///< Posted when the last pending job finishes.
+    size_t nextWorker;                      ///< Next worker to give an outside job to.
+    size_t numPending;                      ///< Jobs submitted but not yet finished.
+    bool isStopping;                        ///< true once le_workQueue_Delete() has been called.
+}
+WorkQueue_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/// Job memory pool.
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t JobPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/// Work Queue memory pool.
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t WorkQueuePool;
+
+
+//--------------------------------------------------------------------------------------------------
+/// Worker memory pool.
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t WorkerPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/// Thread-local data key for the calling thread's Worker object (NULL if not a worker).
+//--------------------------------------------------------------------------------------------------
+static pthread_key_t WorkerPtrKey;
+
+
+/// Lock a Worker's deque.
+#define LOCK_WORKER(workerPtr)      le_mutex_Lock((workerPtr)->mutexRef)
+
+/// Unlock a Worker's deque.
+#define UNLOCK_WORKER(workerPtr)    le_mutex_Unlock((workerPtr)->mutexRef)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Work Queue module.
+ *
+ * This should be called by liblegato's init.c module at start-up.
+ */
+//--------------------------------------------------------------------------------------------------
+void workQueue_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    JobPool = le_mem_CreatePool("WorkQueueJob", sizeof(Job_t));
+    le_mem_EnableThreadCache(JobPool, JOB_POOL_THREAD_CACHE_SIZE);
+
+    WorkQueuePool = le_mem_CreatePool("WorkQueue", sizeof(WorkQueue_t));
+    WorkerPool = le_mem_CreatePool("WorkQueueWorker", sizeof(Worker_t));
+
+    LE_ASSERT(pthread_key_create(&WorkerPtrKey, NULL) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a job onto the tail of a Worker's deque.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PushJob
+(
+    Worker_t* workerPtr,
+    Job_t* jobPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LOCK_WORKER(workerPtr);
+    le_dls_Queue(&workerPtr->deque, &jobPtr->link);
+    UNLOCK_WORKER(workerPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take a job for a Worker to run: the newest job on its own deque, or failing that, the oldest
+ * job on one of the other Workers' deques.
+ *
+ * @return Pointer to the Job, or NULL if all the deques are empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static Job_t* TakeJob
+(
+    Worker_t* workerPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    WorkQueue_t* queuePtr = workerPtr->queuePtr;
+    le_dls_Link_t* linkPtr;
+    size_t i;
+
+    LOCK_WORKER(workerPtr);
+    linkPtr = le_dls_PopTail(&workerPtr->deque);
+    UNLOCK_WORKER(workerPtr);
+
+    // Start with the next worker along, so thieves spread out rather than all hitting worker 0.
+    for (i = 1; (linkPtr == NULL) && (i < queuePtr->numWorkers); i++)
+    {
+        Worker_t* victimPtr = queuePtr->workerPtrs[(workerPtr->index + i) % queuePtr->numWorkers];
+
+        LOCK_WORKER(victimPtr);
+        linkPtr = le_dls_Pop(&victimPtr->deque);
+        UNLOCK_WORKER(victimPtr);
+    }
+
+    if (linkPtr == NULL)
+    {
+        return NULL;
+    }
+
+    return CONTAINER_OF(linkPtr, Job_t, link);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run a job, queue its completion function to the thread that submitted it, and release it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunJob
+(
+    WorkQueue_t* queuePtr,
+    Job_t* jobPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    jobPtr->jobFunc(jobPtr->param1Ptr, jobPtr->param2Ptr);
+
+    if (jobPtr->completionFunc != NULL)
+    {
+        le_event_QueueFunctionToThread(jobPtr->submitterRef,
+                                       jobPtr->completionFunc,
+                                       jobPtr->param1Ptr,
+                                       jobPtr->param2Ptr);
+    }
+
+    le_mem_Release(jobPtr);
+
+    // If this was the last pending job and le_workQueue_Delete() is waiting for it, wake it up.
+    if ((__atomic_sub_fetch(&queuePtr->numPending, 1, __ATOMIC_SEQ_CST) == 0) &&
+        __atomic_load_n(&queuePtr->isStopping, __ATOMIC_SEQ_CST))
+    {
+        le_sem_Post(queuePtr->idleSemRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Worker thread main function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WorkerMain
+(
+    void* contextPtr        ///< Pointer to the Worker object.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Worker_t* workerPtr = contextPtr;
+    WorkQueue_t* queuePtr = workerPtr->queuePtr;
+
+    LE_ASSERT(pthread_setspecific(WorkerPtrKey, workerPtr) == 0);
+
+    for (;;)
+    {
+        le_sem_Wait(queuePtr->jobSemRef);
+
+        Job_t* jobPtr;
+        while ((jobPtr = TakeJob(workerPtr)) == NULL)
+        {
+            // Once nothing is pending, the only tokens left are the stop tokens.
+            if (__atomic_load_n(&queuePtr->isStopping, __ATOMIC_SEQ_CST) &&
+                (__atomic_load_n(&queuePtr->numPending, __ATOMIC_SEQ_CST) == 0))
+            {
+                return NULL;
+            }
+
+            // Another worker took the job this token was posted for, and there's another one
+            // on its way (it's pushed before its token is posted).
+            sched_yield();
+        }
+
+        RunJob(queuePtr, jobPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a Work Queue and start its worker threads.
+ *
+ * @return Reference to the Work Queue.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_workQueue_Ref_t le_workQueue_Create
+(
+    const char* nameStr,        ///< [IN] Name of the Work Queue (used to name its workers).
+    size_t numWorkers           ///< [IN] Number of worker threads (0 = one per online CPU).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t i;
+
+    if (numWorkers == 0)
+    {
+        long numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+        numWorkers = (numCpus > 0) ? (size_t)numCpus : 1;
+
+        if (numWorkers > LE_WORKQUEUE_MAX_WORKERS)
+        {
+            numWorkers = LE_WORKQUEUE_MAX_WORKERS;
+        }
+    }
+
+    LE_FATAL_IF(numWorkers > LE_WORKQUEUE_MAX_WORKERS,
+                "Work Queue '%s' can't have %zu workers (max %d).",
+                nameStr,
+                numWorkers,
+                LE_WORKQUEUE_MAX_WORKERS);
+
+    WorkQueue_t* queuePtr = le_mem_ForceAlloc(WorkQueuePool);
+
+    memset(queuePtr, 0, sizeof(*queuePtr));
+    LE_WARN_IF(le_utf8_Copy(queuePtr->name, nameStr, sizeof(queuePtr->name), NULL) == LE_OVERFLOW,
+               "Work Queue name '%s' truncated to '%s'.",
+               nameStr,
+               queuePtr->name);
+    queuePtr->numWorkers = numWorkers;
+    queuePtr->jobSemRef = le_sem_Create(queuePtr->name, 0);
+    queuePtr->idleSemRef = le_sem_Create(queuePtr->name, 0);
+
+    for (i = 0; i < numWorkers; i++)
+    {
+        Worker_t* workerPtr = le_mem_ForceAlloc(WorkerPool);
+        char threadName[LIMIT_MAX_THREAD_NAME_BYTES];
+
+        LE_ASSERT(snprintf(threadName, sizeof(threadName), "%s-%zu", queuePtr->name, i)
+                  < (int)sizeof(threadName));
+
+        workerPtr->mutexRef = le_mutex_CreateLeanNonRecursive(threadName);
+        workerPtr->deque = LE_DLS_LIST_INIT;
+        workerPtr->queuePtr = queuePtr;
+        workerPtr->index = i;
+        queuePtr->workerPtrs[i] = workerPtr;
+
+        workerPtr->threadRef = le_thread_Create(threadName, WorkerMain, workerPtr);
+        le_thread_SetJoinable(workerPtr->threadRef);
+    }
+
+    // Only start the workers once they're all set up, as they may steal from each other.
+    for (i = 0; i < numWorkers; i++)
+    {
+        le_thread_Start(queuePtr->workerPtrs[i]->threadRef);
+    }
+
+    return queuePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submit a job to a Work Queue.
+ *
+ * The job function will be called by one of the Work Queue's workers.  When it returns, the
+ * completion function (if not NULL) will be queued to the calling thread's Event Queue.  Both
+ * are passed the same two parameters.
+ *
+ * @note If an invalid Work Queue reference is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_workQueue_Submit
+(
+    le_workQueue_Ref_t queueRef,                ///< [IN] Work Queue to run the job.
+    le_workQueue_JobFunc_t jobFunc,             ///< [IN] Job function.
+    le_event_DeferredFunc_t completionFunc,     ///< [IN] Completion function (can be NULL).
+    void* param1Ptr,                            ///< [IN] First parameter for the functions.
+    void* param2Ptr                             ///< [IN] Second parameter for the functions.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(queueRef != NULL);
+    LE_ASSERT(jobFunc != NULL);
+
+    Worker_t* workerPtr = pthread_getspecific(WorkerPtrKey);
+
+    // Jobs may only be submitted after le_workQueue_Delete() by the Work Queue's own jobs.
+    LE_FATAL_IF(__atomic_load_n(&queueRef->isStopping, __ATOMIC_SEQ_CST) &&
+                ((workerPtr == NULL) || (workerPtr->queuePtr != queueRef)),
+                "Job submitted to Work Queue '%s' after it was deleted.",
+                queueRef->name);
+
+    Job_t* jobPtr = le_mem_ForceAlloc(JobPool);
+
+    jobPtr->link = LE_DLS_LINK_INIT;
+    jobPtr->jobFunc = jobFunc;
+    jobPtr->completionFunc = completionFunc;
+    jobPtr->submitterRef = (completionFunc != NULL) ? le_thread_GetCurrent() : NULL;
+    jobPtr->param1Ptr = param1Ptr;
+    jobPtr->param2Ptr = param2Ptr;
+
+    __atomic_add_fetch(&queueRef->numPending, 1, __ATOMIC_SEQ_CST);
+
+    if ((workerPtr == NULL) || (workerPtr->queuePtr != queueRef))
+    {
+        size_t index = __atomic_fetch_add(&queueRef->nextWorker, 1, __ATOMIC_RELAXED);
+
+        workerPtr = queueRef->workerPtrs[index % queueRef->numWorkers];
+    }
+
+    PushJob(workerPtr, jobPtr);
+
+    le_sem_Post(queueRef->jobSemRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of worker threads a Work Queue has.
+ *
+ * @return The number of workers.
+ *
+ * @note If an invalid Work Queue reference is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t le_workQueue_GetNumWorkers
+(
+    le_workQueue_Ref_t queueRef                 ///< [IN] Work Queue.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(queueRef != NULL);
+
+    return queueRef->numWorkers;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for all the jobs submitted to a Work Queue to finish, then stop its workers and delete it.
+ *
+ * @note If an invalid Work Queue reference is given, or this is called by one of the Work Queue's
+ *       own workers, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_workQueue_Delete
+(
+    le_workQueue_Ref_t queueRef                 ///< [IN] Work Queue to delete.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Worker_t* workerPtr = pthread_getspecific(WorkerPtrKey);
+    size_t i;
+
+    LE_ASSERT(queueRef != NULL);
+    LE_FATAL_IF((workerPtr != NULL) && (workerPtr->queuePtr == queueRef),
+                "Work Queue '%s' deleted by one of its own workers.",
+                queueRef->name);
+
+    // Either the last job to finish sees isStopping and posts idleSem, or this sees that nothing
+    // is pending (or both, in which case idleSem is posted but never waited on).
+    __atomic_store_n(&queueRef->isStopping, true, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queueRef->numPending, __ATOMIC_SEQ_CST) != 0)
+    {
+        le_sem_Wait(queueRef->idleSemRef);
+    }
+
+    for (i = 0; i < queueRef->numWorkers; i++)
+    {
+        le_sem_Post(queueRef->jobSemRef);
+    }
+
+    for (i = 0; i < queueRef->numWorkers; i++)
+    {
+        LE_ASSERT(le_thread_Join(queueRef->workerPtrs[i]->threadRef, NULL) == LE_OK);
+    }
+
+    // Workers that are still running can steal from the ones that have exited, so don't delete
+    // any of the Workers until they have all been joined.
+    for (i = 0; i < queueRef->numWorkers; i++)
+    {
+        le_mutex_Delete(queueRef->workerPtrs[i]->mutexRef);
+        le_mem_Release(queueRef->workerPtrs[i]);
+    }
+
+    le_sem_Delete(queueRef->jobSemRef);
+    le_sem_Delete(queueRef->idleSemRef);
+    le_mem_Release(queueRef);
+}
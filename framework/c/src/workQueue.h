@@ -0,0 +1,26 @@
+//--------------------------------------------------------------------------------------------------
+/** @file workQueue.h
+ *
+ * Work Queue module's intra-framework header file.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_SRC_WORK_QUEUE_H_INCLUDE_GUARD
+#define LEGATO_SRC_WORK_QUEUE_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Work Queue module.
+ *
+ * This function must be called exactly once at process start-up, before any other Work Queue
+ * functions are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void workQueue_Init
+(
+    void
+);
+
+#endif // LEGATO_SRC_WORK_QUEUE_H_INCLUDE_GUARD
@@ -31,6 +31,10 @@ colourObj_t;
 #define FORCE_SIZE          3
 #define NUM_EXPAND_SUB_POOL 2
 #define NUM_ALLOC_SUPER_POOL    1
+#define CACHE_POOL_SIZE     20
+#define CACHE_SIZE          4
+#define NUM_CACHE_THREADS   4
+#define NUM_CACHE_ALLOCS    10000
 
 static unsigned int NumRelease = 0;
 static unsigned int ReleaseId;
@@ -46,6 +50,102 @@ static void IdDestructor(void* objPtr)
 }
 
 
+static le_mem_PoolRef_t CachePool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread that hammers a pool with per-thread caching enabled.  Every other object is handed off
+ * to be released by the next iteration so that allocations and releases interleave.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* CacheThreadMain(void* contextPtr)
+{
+    idObj_t* heldPtr = NULL;
+    unsigned int i;
+
+    for (i = 0; i < NUM_CACHE_ALLOCS; i++)
+    {
+        idObj_t* objPtr = le_mem_ForceAlloc(CachePool);
+        objPtr->id = i;
+
+        le_mem_AddRef(objPtr);
+        le_mem_Release(objPtr);
+
+        if (heldPtr != NULL)
+        {
+            le_mem_Release(heldPtr);
+        }
+        heldPtr = objPtr;
+    }
+
+    le_mem_Release(heldPtr);
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tests a pool with per-thread caching enabled.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t TestThreadCache(void)
+{
+    pthread_t threads[NUM_CACHE_THREADS];
+    le_mem_PoolStats_t stats;
+    int i;
+
+    CachePool = le_mem_CreatePool("Cache Pool", sizeof(idObj_t));
+    le_mem_ExpandPool(CachePool, CACHE_POOL_SIZE);
+    le_mem_EnableThreadCache(CachePool, CACHE_SIZE);
+
+    for (i = 0; i < NUM_CACHE_THREADS; i++)
+    {
+        LE_ASSERT(pthread_create(&threads[i], NULL, CacheThreadMain, NULL) == 0);
+    }
+
+    for (i = 0; i < NUM_CACHE_THREADS; i++)
+    {
+        LE_ASSERT(pthread_join(threads[i], NULL) == 0);
+    }
+
+    // The threads' caches were returned to the pool when the threads died, so the stats must
+    // account for every allocation.
+    le_mem_GetStats(CachePool, &stats);
+
+    if ( (stats.numAllocs != NUM_CACHE_THREADS * NUM_CACHE_ALLOCS) ||
+         (stats.numBlocksInUse != 0) ||
+         (stats.numFree != le_mem_GetObjectCount(CachePool)) ||
+         (stats.numCached != 0) ||
+         (stats.numCacheHits + stats.numCacheMisses < stats.numAllocs) ||
+         (stats.numCacheHits == 0) )
+    {
+        printf("Thread cache stats are incorrect: %d", __LINE__);
+        return LE_FAULT;
+    }
+
+    printf("Thread cache hits: %" PRIu64 ", misses: %" PRIu64 ".\n",
+           stats.numCacheHits,
+           stats.numCacheMisses);
+
+    // Allocating and releasing from this thread should still work.
+    idObj_t* objPtr = le_mem_AssertAlloc(CachePool);
+    le_mem_Release(objPtr);
+
+    // That refilled this thread's cache from the pool.
+    le_mem_GetStats(CachePool, &stats);
+
+    if ( (stats.numCached == 0) || (stats.numCached > stats.numFree) )
+    {
+        printf("Thread cache count is incorrect: %d", __LINE__);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
 int main(int argc, char *argv[])
 {
     le_mem_PoolRef_t idPool, colourPool;
@@ -531,6 +631,16 @@ int main(int argc, char *argv[])
     printf("Successfully searched for pools by name.\n");
 
 
+    //
+    // Per-thread caches.
+    //
+    if (TestThreadCache() != LE_OK)
+    {
+        return LE_FAULT;
+    }
+    printf("Per-thread caches work correctly.\n");
+
+
     printf("*** Unit Test for le_mem module passed. ***\n");
     printf("\n");
     return LE_OK;
@@ -467,6 +467,9 @@ FuncImplTemplate = """
     // Pack the input parameters
     {{ func.parmListIn | printParmList("clientPack", sep="\n") | indent }}
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send a request to the server and get the response.
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
@@ -668,6 +671,9 @@ static void AsyncResponse_{{func.name}}
     // Pack the input parameters
     {{ handler.parmList | printParmList("clientPack", sep="\n") | indent }}
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Send the async response to the client
     LE_DEBUG("Sending message to client session %p : %ti bytes sent",
              serverDataPtr->clientSessionRef,
@@ -762,6 +768,9 @@ static void Handle_{{func.name}}
     // Pack any "out" parameters
     {{ func.parmListOut | printParmList("handlerPack", sep="\n") | indent }}
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)le_msg_GetPayloadPtr(_msgRef));
+
     // Return the response
     LE_DEBUG("Sending response to client session %p : %ti bytes sent",
              le_msg_GetSession(_msgRef),
@@ -795,6 +804,9 @@ AsyncFuncHandlerTemplate = """
     // Pack any "out" parameters
     {{ func.parmListOut | printParmList("asyncServerPack", sep="\n") | indent }}
 
+    // Only the packed part of the message buffer needs to be sent.
+    le_msg_SetPayloadSize(_msgRef, _msgBufPtr - (uint8_t*)_msgPtr);
+
     // Return the response
     LE_DEBUG("Sending response to client session %p", le_msg_GetSession(_msgRef));
     le_msg_Respond(_msgRef);
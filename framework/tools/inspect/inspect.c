@@ -1267,6 +1267,9 @@ static ColumnInfo_t MemPoolTableInfo[] =
     {"MAX USED",    "%*s",  NULL, "%*zu",       sizeof(size_t),              false, 0},
     {"OVERFLOWS",   "%*s",  NULL, "%*zu",       sizeof(size_t),              false, 0},
     {"ALLOCS",      "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),            false, 0},
+    {"CACHED",      "%*s",  NULL, "%*zu",       sizeof(size_t),              false, 0},
+    {"CACHE HITS",  "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),            false, 0},
+    {"CACHE MISS",  "%*s",  NULL, "%*"PRIu64"", sizeof(uint64_t),            false, 0},
     {"BLK BYTES",   "%*s",  NULL, "%*zu",       sizeof(size_t),              false, 0},
     {"USED BYTES",  "%*s",  NULL, "%*zu",       sizeof(size_t),              false, 0},
     {"MEMORY POOL", "%-*s", NULL, "%-*s",       LIMIT_MAX_MEM_POOL_NAME_LEN, true,  0},
@@ -1896,6 +1899,9 @@ static int PrintMemPoolInfo
         P(poolStats.maxNumBlocksUsed,           MemPoolTableInfo, MemPoolTableInfoSize); \
         P(poolStats.numOverflows,               MemPoolTableInfo, MemPoolTableInfoSize); \
         P(poolStats.numAllocs,                  MemPoolTableInfo, MemPoolTableInfoSize); \
+        P(poolStats.numCached,                  MemPoolTableInfo, MemPoolTableInfoSize); \
+        P(poolStats.numCacheHits,               MemPoolTableInfo, MemPoolTableInfoSize); \
+        P(poolStats.numCacheMisses,             MemPoolTableInfo, MemPoolTableInfoSize); \
         P(blockSize,                            MemPoolTableInfo, MemPoolTableInfoSize); \
         P(blockSize*(poolStats.numBlocksInUse), MemPoolTableInfo, MemPoolTableInfoSize); \
         P(name,                                 MemPoolTableInfo, MemPoolTableInfoSize); \
@@ -119,6 +119,7 @@ static void PrintHelpAndExit
         "    log trace KEYWORD_STR [DESTINATION]\n"
         "    log stoptrace KEYWORD_STR [DESTINATION]\n"
         "    log forget PROCESS_NAME\n"
+        "    log stats\n"
         "\n"
         "DESCRIPTION:\n"
         "    log list            Lists all processes/components registered with the\n"
@@ -146,6 +147,11 @@ static void PrintHelpAndExit
         "                        Future processes with that name will have default\n"
         "                        settings.\n"
         "\n"
+        "    log stats           Shows how much stdout/stderr output each app has\n"
+        "                        logged (in total and per second over the last\n"
+        "                        second) and how many lines were dropped because\n"
+        "                        the app was logging too fast.\n"
+        "\n"
         "The [DESTINATION] is optional and specifies the process and component to\n"
         "send the command to.  The [DESTINATION] must be in this format:\n"
         "\n"
@@ -529,6 +535,12 @@ static void CommandArgHandler
         // This command has only a process name (or pid) as a parameter.
         le_arg_AddPositionalCallback(ProcessIdArgHandler);
     }
+    else if (strcmp(command, "stats") == 0)
+    {
+        Command = LOG_CMD_GET_STATS;
+
+        // This command has no parameters and no destination.
+    }
     else
     {
         char errorMsg[100];
@@ -574,8 +586,9 @@ COMPONENT_INIT
             break;
 
         case LOG_CMD_LIST_COMPONENTS:
+        case LOG_CMD_GET_STATS:
 
-            // This one has no arguments.
+            // These have no arguments.
 
             break;
 